@@ -82,7 +82,8 @@ SAMPLER_ORDERING = [
     'stratified',
     'multijitter',
     'orthogonal',
-    'ldsampler'
+    'ldsampler',
+    'sobol'
 ]
 
 INTEGRATOR_ORDERING = [
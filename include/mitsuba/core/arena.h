@@ -0,0 +1,131 @@
+#pragma once
+
+#include <mitsuba/core/logger.h>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Monotonic memory arena for transient allocations with a common
+ * lifetime
+ *
+ * The arena hands out memory from geometrically growing blocks via simple
+ * pointer bumping. Individual allocations cannot be freed: all blocks are
+ * released wholesale by \ref release() or the destructor. This is a good fit
+ * for workloads like scene parsing that perform masses of small short-lived
+ * allocations, where per-allocation malloc/free bookkeeping becomes a
+ * measurable cost.
+ *
+ * Instances are not thread-safe; use one arena per thread.
+ */
+class MemoryArena {
+public:
+    /// Create an empty arena. Memory is only reserved upon the first allocation.
+    MemoryArena(size_t block_size = 64 * 1024)
+        : m_next_block_size(block_size) { }
+
+    /// Release all memory held by the arena
+    ~MemoryArena() { release(); }
+
+    MemoryArena(const MemoryArena &) = delete;
+    MemoryArena &operator=(const MemoryArena &) = delete;
+
+    /// Allocate ``size`` bytes with the given alignment (a power of two)
+    void *alloc(size_t size, size_t align = alignof(std::max_align_t)) {
+        uintptr_t ptr = (m_cur + align - 1) & ~(uintptr_t) (align - 1);
+        if (ptr + size > m_end) {
+            grow(size + align);
+            ptr = (m_cur + align - 1) & ~(uintptr_t) (align - 1);
+        }
+        m_cur = ptr + size;
+        return (void *) ptr;
+    }
+
+    /// Check whether the given pointer lies within one of the arena's blocks
+    bool owns(const void *ptr) const {
+        uintptr_t p = (uintptr_t) ptr;
+        for (const Block &block : m_blocks) {
+            if (p >= block.start && p < block.start + block.size)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief Rewind the arena without returning memory to the system
+     *
+     * Retains a single block large enough for all allocations made since the
+     * previous reset, so that steady-state cyclic use (e.g. per-sample
+     * scratch storage) eventually performs no heap allocation at all.
+     */
+    void reset() {
+        if (m_blocks.size() == 1) {
+            m_cur = m_blocks[0].start;
+            return;
+        }
+        size_t total = size();
+        release();
+        if (total > 0)
+            m_next_block_size = std::max(m_next_block_size, total);
+    }
+
+    /// Release all blocks at once
+    void release() {
+        for (const Block &block : m_blocks)
+            std::free((void *) block.start);
+        m_blocks.clear();
+        m_cur = m_end = 0;
+    }
+
+    /// Return the total number of bytes reserved by the arena
+    size_t size() const {
+        size_t result = 0;
+        for (const Block &block : m_blocks)
+            result += block.size;
+        return result;
+    }
+
+private:
+    struct Block {
+        uintptr_t start;
+        size_t size;
+    };
+
+    void grow(size_t required) {
+        size_t block_size = std::max(m_next_block_size, required);
+
+        /* Double the block size up to a limit so that large documents don't
+           pay for thousands of block transitions */
+        m_next_block_size =
+            std::min(m_next_block_size * 2, (size_t) 4 * 1024 * 1024);
+
+        void *ptr = std::malloc(block_size);
+        if (!ptr)
+            Throw("MemoryArena: could not allocate a block of %zu bytes!",
+                  block_size);
+
+        m_blocks.push_back(Block { (uintptr_t) ptr, block_size });
+        m_cur = (uintptr_t) ptr;
+        m_end = m_cur + block_size;
+    }
+
+    std::vector<Block> m_blocks;
+    uintptr_t m_cur = 0, m_end = 0;
+    size_t m_next_block_size;
+};
+
+/**
+ * \brief Return the calling thread's scratch arena
+ *
+ * The scratch arena provides fast bump-allocated storage for temporaries
+ * whose lifetime is bounded by the current unit of work. In scalar rendering
+ * modes, \ref SamplingIntegrator::render_sample() resets the arena before
+ * each sample, so plugins may use it for per-evaluation scratch without
+ * touching the system allocator in the hot loop. Pointers obtained from the
+ * arena must not be retained across a reset or handed to another thread.
+ */
+extern MI_EXPORT_LIB MemoryArena &scratch_arena();
+
+NAMESPACE_END(mitsuba)
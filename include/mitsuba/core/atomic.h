@@ -64,4 +64,27 @@ protected:
     std::atomic<Storage> m_bits;
 };
 
+/**
+ * \brief Atomically add \c value to the floating point number referenced by
+ * \c ptr
+ *
+ * In contrast to \ref AtomicFloat, this free function operates in place on
+ * plain (suitably aligned) buffers, e.g. to accumulate into shared image
+ * storage without a lock. Like AtomicFloat, it casts the value to an integer
+ * storage format and loops over atomic compare and exchange operations.
+ */
+template <typename Type> void atomic_add(Type *ptr, Type value) {
+    using Storage = std::conditional_t<sizeof(Type) == 4, uint32_t, uint64_t>;
+    static_assert(sizeof(Type) == 4 || sizeof(Type) == 8);
+
+    std::atomic<Storage> &bits = *(std::atomic<Storage> *) ptr;
+    Storage old_bits = bits.load(std::memory_order_relaxed), new_bits;
+    do {
+        new_bits =
+            dr::memcpy_cast<Storage>(dr::memcpy_cast<Type>(old_bits) + value);
+        if (new_bits == old_bits)
+            break;
+    } while (!bits.compare_exchange_weak(old_bits, new_bits));
+}
+
 NAMESPACE_END(mitsuba)
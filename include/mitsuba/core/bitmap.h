@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mitsuba/core/atomic.h>
 #include <mitsuba/core/struct.h>
 #include <mitsuba/core/vector.h>
 #include <mitsuba/core/properties.h>
@@ -241,6 +242,31 @@ public:
      */
     Bitmap(const fs::path &path, FileFormat = FileFormat::Auto);
 
+    /**
+     * \brief Load a bitmap from a file via a named shared-memory segment
+     *
+     * The decoded image is placed in a shared-memory segment keyed by a hash
+     * of the file contents (see \ref MemoryMappedFile::create_or_attach_shared),
+     * so that multiple renderer processes on the same machine loading the
+     * same assets keep a single resident copy of the pixel data. The first
+     * process decodes and publishes the image; subsequent ones attach without
+     * allocating further memory.
+     *
+     * The returned bitmap aliases the segment, which remains mapped for the
+     * rest of the process lifetime, and must be treated as read-only. Images
+     * with an arbitrary channel layout (\ref PixelFormat::MultiChannel) are
+     * not shareable, and the function falls back to a regular private load
+     * when sharing is not possible.
+     *
+     * \param path
+     *    Name of the file to be loaded
+     *
+     * \param format
+     *    File format to be read (PNG/EXR/Auto-detect ...)
+     */
+    static ref<Bitmap> load_shared(const fs::path &path,
+                                   FileFormat format = FileFormat::Auto);
+
     /// Copy constructor (copies the image contents)
     Bitmap(const Bitmap &bitmap);
 
@@ -654,6 +680,75 @@ public:
      Properties m_metadata;
 };
 
+/**
+ * \brief Incremental writer for OpenEXR images
+ *
+ * This helper encodes an OpenEXR image to a stream in successive horizontal
+ * bands of scanlines instead of writing a fully materialized bitmap in one
+ * call to \ref Bitmap::write(). Only the band that is currently being
+ * appended must be resident in memory, which bounds the peak footprint of
+ * writing very large images (e.g. high-resolution texture bakes) to a few
+ * rows of pixels.
+ *
+ * The image dimensions, channel layout, component format and metadata are
+ * fixed up front based on a prototype bitmap passed to the constructor
+ * (whose pixel contents and height are ignored). Bands must subsequently be
+ * appended in top-to-bottom order via \ref write() until all scanlines of
+ * the image have been produced.
+ */
+class MI_EXPORT_LIB StreamingEXRWriter : public Object {
+public:
+    using Float = float;
+    MI_IMPORT_CORE_TYPES()
+
+    /**
+     * \brief Create a new streaming OpenEXR writer
+     *
+     * \param stream
+     *    Target stream that will receive the encoded image
+     *
+     * \param size
+     *    Total size of the image to be written
+     *
+     * \param prototype
+     *    Bitmap whose pixel format, component format, channel layout and
+     *    metadata describe the bands that will subsequently be appended
+     *
+     * \param quality
+     *    Compression quality, following the OpenEXR convention of
+     *    \ref Bitmap::write()
+     */
+    StreamingEXRWriter(Stream *stream, const Vector2u &size,
+                       const Bitmap *prototype, int quality = -1);
+
+    /**
+     * \brief Append a band of scanlines to the image
+     *
+     * The band must match the width and channel layout of the prototype
+     * bitmap provided to the constructor; its height determines the number
+     * of scanlines that are encoded and flushed to the stream.
+     */
+    void write(const Bitmap *band);
+
+    /// Total size of the image being written
+    const Vector2u &size() const { return m_size; }
+
+    /// Number of scanlines written so far
+    uint32_t rows_written() const { return m_rows_written; }
+
+    MI_DECLARE_CLASS()
+protected:
+    /// Protected destructor
+    virtual ~StreamingEXRWriter();
+
+private:
+    struct WriterPrivate;
+    ref<Stream> m_stream;
+    ref<Struct> m_struct;
+    Vector2u m_size;
+    uint32_t m_rows_written;
+    std::unique_ptr<WriterPrivate> d;
+};
 
 /**
  * \brief Accumulate the contents of a source bitmap into a
@@ -664,8 +759,12 @@ public:
  *
  * The function supports `T` being a raw pointer or an arbitrary Dr.Jit array
  * that can potentially live on the GPU and/or be differentiable.
+ *
+ * When the \c Atomic template parameter is set (raw floating point pointers
+ * only), the additions into \c target are performed atomically so that
+ * concurrent accumulations into the same image are safe without a lock.
  */
-template <typename T, typename ConstT>
+template <typename T, typename ConstT, bool Atomic = false>
 void accumulate_2d(ConstT source,
                    Vector<int, 2> source_size,
                    T target,
@@ -697,10 +796,16 @@ void accumulate_2d(ConstT source,
 
         for (int y = 0; y < size.y(); ++y) {
             for (int i = 0; i < n; ++i) {
-                if constexpr (std::is_integral_v<Value>)
+                if constexpr (Atomic) {
+                    static_assert(
+                        std::is_floating_point_v<std::remove_pointer_t<T>>,
+                        "Atomic accumulation requires a float/double target!");
+                    atomic_add(target + i, (std::remove_pointer_t<T>) source[i]);
+                } else if constexpr (std::is_integral_v<Value>) {
                     target[i] = (Value) dr::maximum(maxval, source[i] + target[i]);
-                else
+                } else {
                     target[i] += source[i];
+                }
             }
 
             source += source_size.x() * channel_count;
@@ -202,6 +202,25 @@ public:                                             \
     MI_VARIANT const Class *Name<Float, Spectrum>::class_() const { return m_class; }
 
 
+#if defined(MI_STATIC_PLUGINS)
+
+#define MI_PLUGIN_STRINGIFY_2(x) #x
+#define MI_PLUGIN_STRINGIFY(x) MI_PLUGIN_STRINGIFY_2(x)
+
+/* Instantiate and export a Mitsuba plugin ("slim" builds)
+ *
+ * The plugin is linked directly into the Mitsuba library: instead of
+ * exporting name/description symbols for dlopen-based discovery, it announces
+ * itself to the \ref PluginManager during static initialization. The plugin's
+ * file name is provided by the build system via \c MI_PLUGIN_NAME.
+ */
+#define MI_EXPORT_PLUGIN(Name, Descr)                                                             \
+    static ::mitsuba::detail::StaticPluginRegistration                                             \
+        plugin_registration_(MI_PLUGIN_STRINGIFY(MI_PLUGIN_NAME), #Name, Descr);                  \
+    MI_INSTANTIATE_CLASS(Name)
+
+#else
+
 /// Instantiate and export a Mitsuba plugin
 #define MI_EXPORT_PLUGIN(Name, Descr)                                                             \
     extern "C" {                                                                                   \
@@ -210,7 +229,21 @@ public:                                             \
     }                                                                                              \
     MI_INSTANTIATE_CLASS(Name)
 
+#endif
+
 NAMESPACE_BEGIN(detail)
+/**
+ * \brief Registers a plugin that is linked directly into the Mitsuba library
+ * with the \ref PluginManager during static initialization
+ *
+ * Instantiated by \ref MI_EXPORT_PLUGIN when building with the
+ * \c MI_STATIC_PLUGINS build option.
+ */
+struct MI_EXPORT_LIB StaticPluginRegistration {
+    StaticPluginRegistration(const char *name, const char *class_name,
+                             const char *descr);
+};
+
 template <typename, typename Arg, typename = void>
 struct is_constructible : std::false_type { };
 
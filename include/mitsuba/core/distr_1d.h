@@ -16,17 +16,27 @@ NAMESPACE_BEGIN(mitsuba)
  * probability mass functions (PMFs) will automatically be normalized during
  * initialization. The associated scale factor can be retrieved using the
  * function \ref normalization().
+ *
+ * Small distributions are sampled by binary-searching the CDF. Above
+ * \ref AliasThreshold entries, initialization additionally builds an alias
+ * table (via Vose's O(n) method) so that samples can be drawn with two
+ * coherent gathers irrespective of the distribution size, which avoids the
+ * divergent O(log n) gather sequence of the binary search on vector backends.
  */
 template <typename Value> struct DiscreteDistribution {
     using Float = std::conditional_t<dr::is_static_array_v<Value>,
                                      dr::value_t<Value>, Value>;
     using FloatStorage   = DynamicBuffer<Float>;
     using Index          = dr::uint32_array_t<Value>;
+    using IndexStorage   = DynamicBuffer<dr::uint32_array_t<Float>>;
     using Mask           = dr::mask_t<Value>;
 
     using ScalarFloat    = dr::scalar_t<Float>;
     using ScalarVector2u = dr::Array<uint32_t, 2>;
 
+    /// Minimum entry count at which sampling switches to the alias method
+    static constexpr size_t AliasThreshold = 64;
+
 public:
     /// Create an uninitialized DiscreteDistribution instance
     DiscreteDistribution() { }
@@ -84,6 +94,9 @@ public:
     /// Is the distribution object empty/uninitialized?
     bool empty() const { return m_pmf.empty(); }
 
+    /// Is the O(1) alias method used to draw samples?
+    bool uses_alias_method() const { return !m_alias_prob.empty(); }
+
     /// Evaluate the unnormalized probability mass function (PMF) at index \c index
     Value eval_pmf(Index index, Mask active = true) const {
         return dr::gather<Value>(m_pmf, index, active);
@@ -117,6 +130,9 @@ public:
     Index sample(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        if (uses_alias_method())
+            return sample_alias(value, active).first;
+
         value *= m_sum;
 
         return dr::binary_search<Index>(
@@ -167,6 +183,9 @@ public:
     sample_reuse(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        if (uses_alias_method())
+            return sample_alias(value, active);
+
         Index index = sample(value, active);
 
         Value pmf = eval_pmf_normalized(index, active),
@@ -196,19 +215,43 @@ public:
     sample_reuse_pmf(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
-        auto [index, pdf] = sample_pmf(value, active);
-
-        Value pmf = eval_pmf_normalized(index, active),
-              cdf = eval_cdf_normalized(index - 1, active && index > 0);
+        auto [index, rescaled] = sample_reuse(value, active);
 
         return {
             index,
-            (value - cdf) / pmf,
-            pmf
+            rescaled,
+            eval_pmf_normalized(index, active)
         };
     }
 
 private:
+    /**
+     * \brief Draw a sample using the alias table
+     *
+     * The integer part of <tt>value * size</tt> selects a table cell, and the
+     * fractional part is tested against the cell's acceptance probability to
+     * choose between the cell's own index and its alias. The fractional part
+     * is subsequently re-scaled so that it can be reused as a uniform
+     * variate, mirroring \ref sample_reuse().
+     */
+    MI_INLINE std::pair<Index, Value>
+    sample_alias(Value value, Mask active) const {
+        value *= (ScalarFloat) size();
+
+        Index cell = dr::minimum(Index(value), (uint32_t) (size() - 1));
+        Value u = value - Value(cell);
+
+        Value prob  = dr::gather<Value>(m_alias_prob, cell, active);
+        Index alias = dr::gather<Index>(m_alias_idx,  cell, active);
+
+        Mask accept = u < prob;
+
+        return {
+            dr::select(accept, cell, alias),
+            dr::select(accept, u / prob, (u - prob) / (1.f - prob))
+        };
+    }
+
     void compute_cdf(const ScalarFloat *pmf, size_t size) {
         if (size == 0)
             Throw("DiscreteDistribution: empty distribution!");
@@ -216,6 +259,7 @@ private:
         std::vector<ScalarFloat> cdf(size);
         m_valid = (uint32_t) -1;
 
+        const ScalarFloat *pmf_start = pmf;
         double sum = 0.0;
         for (uint32_t i = 0; i < size; ++i) {
             double value = (double) *pmf++;
@@ -238,11 +282,59 @@ private:
         m_sum = dr::opaque<Float>(sum);
         m_normalization = dr::opaque<Float>(1.0 / sum);
         m_cdf = dr::load<FloatStorage>(cdf.data(), size);
+
+        if (size >= AliasThreshold)
+            compute_alias_table(pmf_start, size, sum);
+        else {
+            m_alias_idx = IndexStorage();
+            m_alias_prob = FloatStorage();
+        }
+    }
+
+    void compute_alias_table(const ScalarFloat *pmf, size_t size, double sum) {
+        /* Vose's O(n) construction: rescale the PMF so that the average
+           entry equals one, then repeatedly pair an underfull entry with an
+           overfull one. Each table cell stores the probability of keeping
+           its own index along with the alias index receiving the rest. */
+        std::vector<double> scaled(size);
+        std::vector<uint32_t> alias(size), small, large;
+        std::vector<ScalarFloat> prob(size);
+        small.reserve(size); large.reserve(size);
+
+        double scale = size / sum;
+        for (uint32_t i = 0; i < size; ++i) {
+            scaled[i] = (double) pmf[i] * scale;
+            (scaled[i] < 1.0 ? small : large).push_back(i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back(), l = large.back();
+            small.pop_back();
+
+            prob[s] = (ScalarFloat) scaled[s];
+            alias[s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        /* Entries remaining in either worklist have unit weight up to
+           round-off error and keep their own index */
+        for (uint32_t i : small) { prob[i] = 1.f; alias[i] = i; }
+        for (uint32_t i : large) { prob[i] = 1.f; alias[i] = i; }
+
+        m_alias_idx = dr::load<IndexStorage>(alias.data(), size);
+        m_alias_prob = dr::load<FloatStorage>(prob.data(), size);
     }
 
 private:
     FloatStorage m_pmf;
     FloatStorage m_cdf;
+    IndexStorage m_alias_idx;
+    FloatStorage m_alias_prob;
     Float m_sum = 0.f;
     Float m_normalization = 0.f;
     ScalarVector2u m_valid;
@@ -259,18 +351,32 @@ private:
  * probability density functions (PDFs) will automatically be normalized during
  * initialization. The associated scale factor can be retrieved using the
  * function \ref normalization().
+ *
+ * Small distributions are sampled by binary-searching the CDF. Above
+ * \ref GuideThreshold entries, initialization additionally builds an
+ * equal-probability guide table that locates the CDF interval of a sample
+ * with a single multiply and lookup plus a few binary refinement steps,
+ * irrespective of the distribution size.
  */
 template <typename Value> struct ContinuousDistribution {
     using Float = std::conditional_t<dr::is_static_array_v<Value>,
                                      dr::value_t<Value>, Value>;
     using FloatStorage = DynamicBuffer<Float>;
     using Index = dr::uint32_array_t<Value>;
+    using IndexStorage = DynamicBuffer<dr::uint32_array_t<Float>>;
     using Mask = dr::mask_t<Value>;
 
     using ScalarFloat = dr::scalar_t<Float>;
     using ScalarVector2f = Vector<ScalarFloat, 2>;
     using ScalarVector2u = Vector<uint32_t, 2>;
 
+    /**
+     * Distributions with at least this many entries additionally build an
+     * equal-probability guide table that accelerates \ref sample() (see
+     * \ref compute_guide_table())
+     */
+    static constexpr size_t GuideThreshold = 64;
+
 public:
     /// Create an uninitialized ContinuousDistribution instance
     ContinuousDistribution() { }
@@ -338,6 +444,9 @@ public:
     /// Is the distribution object empty/uninitialized?
     bool empty() const { return m_pdf.empty(); }
 
+    /// Is a guide table used to locate CDF intervals when sampling?
+    bool uses_guide_table() const { return !m_guide.empty(); }
+
     /// Evaluate the unnormalized probability mass function (PDF) at position \c x
     Value eval_pdf(Value x, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
@@ -401,14 +510,10 @@ public:
     Value sample(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        Value u = value;
         value *= m_integral;
 
-        Index index = dr::binary_search<Index>(
-            m_valid.x(), m_valid.y(),
-            [&](Index index) DRJIT_INLINE_LAMBDA {
-                return dr::gather<Value>(m_cdf, index, active) < value;
-            }
-        );
+        Index index = lookup_cdf(u, value, active);
 
         Value y0 = dr::gather<Value>(m_pdf, index,      active),
               y1 = dr::gather<Value>(m_pdf, index + 1u, active),
@@ -439,14 +544,10 @@ public:
     std::pair<Value, Value> sample_pdf(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        Value u = value;
         value *= m_integral;
 
-        Index index = dr::binary_search<Index>(
-            m_valid.x(), m_valid.y(),
-            [&](Index index) DRJIT_INLINE_LAMBDA {
-                return dr::gather<Value>(m_cdf, index, active) < value;
-            }
-        );
+        Index index = lookup_cdf(u, value, active);
 
         Value y0 = dr::gather<Value>(m_pdf, index,      active),
               y1 = dr::gather<Value>(m_pdf, index + 1u, active),
@@ -472,6 +573,77 @@ public:
     }
 
 private:
+    /**
+     * \brief Locate the CDF interval containing an unnormalized CDF
+     * position \c value (whose associated uniform variate is \c u)
+     *
+     * When a guide table is available, the integer part of <tt>u *
+     * resolution</tt> selects a precomputed bracket of candidate
+     * intervals, which is narrowed by a fixed (typically very small)
+     * number of binary steps. Otherwise, a full binary search over the
+     * CDF is performed. Both strategies return the same interval.
+     */
+    MI_INLINE Index lookup_cdf(Value u, Value value, Mask active) const {
+        if (!uses_guide_table()) {
+            return dr::binary_search<Index>(
+                m_valid.x(), m_valid.y(),
+                [&](Index index) DRJIT_INLINE_LAMBDA {
+                    return dr::gather<Value>(m_cdf, index, active) < value;
+                }
+            );
+        }
+
+        uint32_t res = (uint32_t) m_guide.size() - 1;
+
+        Index j = dr::minimum(Index(u * (ScalarFloat) res), res - 1);
+
+        Index lo = dr::gather<Index>(m_guide, j,      active),
+              hi = dr::gather<Index>(m_guide, j + 1u, active);
+
+        for (uint32_t k = 0; k < m_guide_steps; ++k) {
+            Index mid = (lo + hi) >> 1;
+            Mask go   = lo < hi,
+                 pred = dr::gather<Value>(m_cdf, mid, active) < value;
+            lo = dr::select(go &&  pred, mid + 1u, lo);
+            hi = dr::select(go && !pred, mid, hi);
+        }
+
+        return lo;
+    }
+
+    /**
+     * \brief Build the equal-probability guide table
+     *
+     * Entry \c j stores the first interval whose CDF value reaches
+     * <tt>j / res</tt> of the total mass, hence a sample with uniform
+     * variate \c u is guaranteed to land within the bracket
+     * <tt>[guide[j], guide[j+1]]</tt> for <tt>j = floor(u * res)</tt>.
+     * The number of binary refinement steps needed to resolve the
+     * worst-case bracket is determined here as well.
+     */
+    void compute_guide_table(const ScalarFloat *cdf, double integral) {
+        uint32_t res = (uint32_t) (m_valid.y() - m_valid.x() + 1) * 2;
+        std::vector<uint32_t> guide(res + 1);
+
+        uint32_t i = m_valid.x(), max_width = 0;
+        for (uint32_t j = 0; j <= res; ++j) {
+            double target = integral * ((double) j / res);
+            while (i < m_valid.y() && (double) cdf[i] < target)
+                ++i;
+            guide[j] = i;
+        }
+
+        for (uint32_t j = 0; j < res; ++j)
+            max_width = dr::maximum(max_width, guide[j + 1] - guide[j]);
+
+        uint32_t steps = 0;
+        while ((1u << steps) <= max_width)
+            ++steps;
+
+        m_guide = dr::load<IndexStorage>(guide.data(), res + 1);
+        m_guide_steps = steps;
+    }
+
     void compute_cdf(const ScalarFloat *pdf, size_t size) {
         if (size < 2)
             Throw("ContinuousDistribution: needs at least two entries!");
@@ -518,11 +690,20 @@ private:
         m_interval_size_scalar = (ScalarFloat) interval_size;
         m_inv_interval_size = dr::opaque<Float>(1. / interval_size);
         m_cdf = dr::load<FloatStorage>(cdf.data(), size - 1);
+
+        if (size >= GuideThreshold)
+            compute_guide_table(cdf.data(), integral);
+        else {
+            m_guide = IndexStorage();
+            m_guide_steps = 0;
+        }
     }
 
 private:
     FloatStorage m_pdf;
     FloatStorage m_cdf;
+    IndexStorage m_guide;
+    uint32_t m_guide_steps = 0;
     Float m_integral = 0.f;
     Float m_normalization = 0.f;
     Float m_interval_size = 0.f;
@@ -544,18 +725,32 @@ private:
  * probability density functions (PDFs) will automatically be normalized during
  * initialization. The associated scale factor can be retrieved using the
  * function \ref normalization().
+ *
+ * Small distributions are sampled by binary-searching the CDF. Above
+ * \ref GuideThreshold entries, initialization additionally builds an
+ * equal-probability guide table that locates the CDF interval of a sample
+ * with a single multiply and lookup plus a few binary refinement steps,
+ * irrespective of the distribution size.
  */
 template <typename Value> struct IrregularContinuousDistribution {
     using Float = std::conditional_t<dr::is_static_array_v<Value>,
                                      dr::value_t<Value>, Value>;
     using FloatStorage = DynamicBuffer<Float>;
     using Index = dr::uint32_array_t<Value>;
+    using IndexStorage = DynamicBuffer<dr::uint32_array_t<Float>>;
     using Mask = dr::mask_t<Value>;
 
     using ScalarFloat = dr::scalar_t<Float>;
     using ScalarVector2f = dr::Array<ScalarFloat, 2>;
     using ScalarVector2u = dr::Array<uint32_t, 2>;
 
+    /**
+     * Distributions with at least this many entries additionally build an
+     * equal-probability guide table that accelerates \ref sample() (see
+     * \ref compute_guide_table())
+     */
+    static constexpr size_t GuideThreshold = 64;
+
 public:
     /// Create an uninitialized IrregularContinuousDistribution instance
     IrregularContinuousDistribution() { }
@@ -627,6 +822,9 @@ public:
     /// Is the distribution object empty/uninitialized?
     bool empty() const { return m_pdf.empty(); }
 
+    /// Is a guide table used to locate CDF intervals when sampling?
+    bool uses_guide_table() const { return !m_guide.empty(); }
+
     /// Return the range of the distribution
     ScalarVector2f &range() { return m_range; }
 
@@ -711,14 +909,10 @@ public:
     Value sample(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        Value u = value;
         value *= m_integral;
 
-        Index index = dr::binary_search<Index>(
-            m_valid.x(), m_valid.y(),
-            [&](Index index) DRJIT_INLINE_LAMBDA {
-                return dr::gather<Value>(m_cdf, index, active) < value;
-            }
-        );
+        Index index = lookup_cdf(u, value, active);
 
         Value x0 = dr::gather<Value>(m_nodes, index,      active),
               x1 = dr::gather<Value>(m_nodes, index + 1u, active),
@@ -752,14 +946,10 @@ public:
     std::pair<Value, Value> sample_pdf(Value value, Mask active = true) const {
         MI_MASK_ARGUMENT(active);
 
+        Value u = value;
         value *= m_integral;
 
-        Index index = dr::binary_search<Index>(
-            m_valid.x(), m_valid.y(),
-            [&](Index index) DRJIT_INLINE_LAMBDA {
-                return dr::gather<Value>(m_cdf, index, active) < value;
-            }
-        );
+        Index index = lookup_cdf(u, value, active);
 
         Value x0 = dr::gather<Value>(m_nodes, index,      active),
               x1 = dr::gather<Value>(m_nodes, index + 1u, active),
@@ -790,6 +980,77 @@ public:
     }
 
 private:
+    /**
+     * \brief Locate the CDF interval containing an unnormalized CDF
+     * position \c value (whose associated uniform variate is \c u)
+     *
+     * When a guide table is available, the integer part of <tt>u *
+     * resolution</tt> selects a precomputed bracket of candidate
+     * intervals, which is narrowed by a fixed (typically very small)
+     * number of binary steps. Otherwise, a full binary search over the
+     * CDF is performed. Both strategies return the same interval.
+     */
+    MI_INLINE Index lookup_cdf(Value u, Value value, Mask active) const {
+        if (!uses_guide_table()) {
+            return dr::binary_search<Index>(
+                m_valid.x(), m_valid.y(),
+                [&](Index index) DRJIT_INLINE_LAMBDA {
+                    return dr::gather<Value>(m_cdf, index, active) < value;
+                }
+            );
+        }
+
+        uint32_t res = (uint32_t) m_guide.size() - 1;
+
+        Index j = dr::minimum(Index(u * (ScalarFloat) res), res - 1);
+
+        Index lo = dr::gather<Index>(m_guide, j,      active),
+              hi = dr::gather<Index>(m_guide, j + 1u, active);
+
+        for (uint32_t k = 0; k < m_guide_steps; ++k) {
+            Index mid = (lo + hi) >> 1;
+            Mask go   = lo < hi,
+                 pred = dr::gather<Value>(m_cdf, mid, active) < value;
+            lo = dr::select(go &&  pred, mid + 1u, lo);
+            hi = dr::select(go && !pred, mid, hi);
+        }
+
+        return lo;
+    }
+
+    /**
+     * \brief Build the equal-probability guide table
+     *
+     * Entry \c j stores the first interval whose CDF value reaches
+     * <tt>j / res</tt> of the total mass, hence a sample with uniform
+     * variate \c u is guaranteed to land within the bracket
+     * <tt>[guide[j], guide[j+1]]</tt> for <tt>j = floor(u * res)</tt>.
+     * The number of binary refinement steps needed to resolve the
+     * worst-case bracket is determined here as well.
+     */
+    void compute_guide_table(const ScalarFloat *cdf, double integral) {
+        uint32_t res = (uint32_t) (m_valid.y() - m_valid.x() + 1) * 2;
+        std::vector<uint32_t> guide(res + 1);
+
+        uint32_t i = m_valid.x(), max_width = 0;
+        for (uint32_t j = 0; j <= res; ++j) {
+            double target = integral * ((double) j / res);
+            while (i < m_valid.y() && (double) cdf[i] < target)
+                ++i;
+            guide[j] = i;
+        }
+
+        for (uint32_t j = 0; j < res; ++j)
+            max_width = dr::maximum(max_width, guide[j + 1] - guide[j]);
+
+        uint32_t steps = 0;
+        while ((1u << steps) <= max_width)
+            ++steps;
+
+        m_guide = dr::load<IndexStorage>(guide.data(), res + 1);
+        m_guide_steps = steps;
+    }
+
     void compute_cdf(const ScalarFloat *nodes, const ScalarFloat *pdf, size_t size) {
         if (size < 2)
             Throw("IrregularContinuousDistribution: needs at least two entries!");
@@ -842,12 +1103,21 @@ private:
         m_integral = dr::opaque<Float>(integral);
         m_normalization = dr::opaque<Float>(1. / integral);
         m_cdf = dr::load<FloatStorage>(cdf.data(), size - 1);
+
+        if (size >= GuideThreshold)
+            compute_guide_table(cdf.data(), integral);
+        else {
+            m_guide = IndexStorage();
+            m_guide_steps = 0;
+        }
     }
 
 private:
     FloatStorage m_nodes;
     FloatStorage m_pdf;
     FloatStorage m_cdf;
+    IndexStorage m_guide;
+    uint32_t m_guide_steps = 0;
     Float m_integral = 0.f;
     Float m_normalization = 0.f;
     ScalarVector2f m_range { 0.f, 0.f };
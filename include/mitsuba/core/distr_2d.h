@@ -12,6 +12,8 @@
 #include <mitsuba/core/warp.h>
 #include <mitsuba/core/util.h>
 #include <drjit/dynamic.h>
+#include <drjit/half.h>
+#include <nanothread/nanothread.h>
 #include <array>
 
 NAMESPACE_BEGIN(mitsuba)
@@ -19,7 +21,7 @@ NAMESPACE_BEGIN(mitsuba)
 /** =======================================================================
  * @{ \name Data-driven warping techniques for two dimensions
  *
- * This file provides three different approaches for importance sampling 2D
+ * This file provides several different approaches for importance sampling 2D
  * functions discretized on a regular grid. All functionality is written in a
  * generic fashion and works in scalar mode, packet mode, and the just-in-time
  * compiler (in particular, the complete sampling procedure is designed to be
@@ -32,6 +34,14 @@ NAMESPACE_BEGIN(mitsuba)
  * choose a column. This is a very simple ingredient that can be used to build
  * more advanced kinds of sampling schemes.
  *
+ * The class \c AliasTable2D also targets discretized 2D functions, but
+ * replaces the marginal/conditional binary searches with an alias table
+ * (Walker 1977), which draws a sample using a constant number of memory
+ * fetches. It produces a piecewise constant (rather than linearly
+ * interpolated) density and is mainly useful as a drop-in replacement for
+ * \c Hierarchical2D on very high-resolution input arrays, where the
+ * hierarchical traversal becomes a long chain of dependent gathers.
+ *
  * The other two classes \c Hierarchical2D and \c Marginal2D are significantly
  * more complex and target sampling of <em>linear interpolants</em>, which
  * means that the sampling procedure is a function with floating point inputs
@@ -203,6 +213,212 @@ protected:
     ScalarFloat m_normalization;
 };
 
+/**
+ * \brief Implements alias table-based sampling of a piecewise constant
+ * approximation of a 2D linear interpolant
+ *
+ * This class takes a rectangular floating point array as input and averages
+ * the four corners of every bilinear patch to obtain a piecewise constant
+ * density on the unit square, which it importance samples using an alias
+ * table built with Vose's O(n) variant of Walker's method.
+ *
+ * In contrast to \ref Hierarchical2D, drawing a sample requires a constant
+ * number of memory fetches independent of the input resolution, which makes
+ * this class preferable on the GPU for very high-resolution arrays (e.g. 8K
+ * environment maps) where the hierarchical traversal turns into a long chain
+ * of dependent gathers. The price is a piecewise constant (rather than
+ * linearly interpolated) density and a mapping that scrambles stratified
+ * sample patterns, since nearby uniform variates generally land in unrelated
+ * texels.
+ *
+ * The domain matches that of \ref Hierarchical2D: an input array of
+ * resolution \c size defines <tt>size-1</tt> patches per dimension on
+ * <tt>[0, 1]^2</tt>.
+ */
+template <typename Float_> class AliasTable2D {
+public:
+    using Float                       = Float_;
+    using UInt32                      = dr::uint32_array_t<Float>;
+    using Mask                        = dr::mask_t<Float>;
+    using Point2f                     = Point<Float, 2>;
+    using Point2u                     = Point<UInt32, 2>;
+    using ScalarFloat                 = dr::scalar_t<Float>;
+    using ScalarVector2f              = Vector<ScalarFloat, 2>;
+    using ScalarVector2u              = Vector<uint32_t, 2>;
+    using FloatStorage                = DynamicBuffer<Float>;
+    using UInt32Storage               = DynamicBuffer<UInt32>;
+
+    AliasTable2D() = default;
+
+    /**
+     * Construct an alias table for floating point data of resolution
+     * \c size.
+     */
+    AliasTable2D(const ScalarFloat *data, const ScalarVector2u &size) {
+        if (dr::any(size < 2))
+            Throw("AliasTable2D(): input array resolution must be >= 2!");
+
+        // The piecewise constant approximation has 'size-1' cells
+        m_size = size - 1;
+        m_patch_size = 1.f / ScalarVector2f(m_size);
+        m_inv_patch_size = ScalarVector2f(m_size);
+
+        uint32_t n = dr::prod(m_size);
+
+        std::unique_ptr<ScalarFloat[]> scaled(new ScalarFloat[n]),
+                                       prob(new ScalarFloat[n]),
+                                       density(new ScalarFloat[n]);
+        std::unique_ptr<uint32_t[]> alias(new uint32_t[n]),
+                                    partition(new uint32_t[n]);
+
+        // Average the four corners of each bilinear patch
+        double sum = 0.0;
+        for (uint32_t y = 0; y < m_size.y(); ++y) {
+            const ScalarFloat *in = data + y * size.x();
+            ScalarFloat *out = scaled.get() + y * m_size.x();
+            for (uint32_t x = 0; x < m_size.x(); ++x, ++in) {
+                ScalarFloat avg = .25f * (in[0] + in[1] + in[size.x()] +
+                                          in[size.x() + 1]);
+                out[x] = avg;
+                sum += (double) avg;
+            }
+        }
+
+        /* Rescale so that the average cell weight is 1; this value then
+           coincides with the normalized density on the unit square */
+        ScalarFloat scale = (ScalarFloat) (n / sum);
+        for (uint32_t i = 0; i < n; ++i) {
+            scaled[i] *= scale;
+            density[i] = scaled[i];
+        }
+
+        /* Build the alias table using Vose's method: repeatedly pair a cell
+           with weight < 1 ("small") with one of weight >= 1 ("large") so
+           that each table slot covers exactly a weight of 1. The two groups
+           grow from opposite ends of a shared scratch array. */
+        uint32_t n_small = 0, n_large = n;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (scaled[i] < 1.f)
+                partition[n_small++] = i;
+            else
+                partition[--n_large] = i;
+        }
+
+        while (n_small > 0 && n_large < n) {
+            uint32_t s = partition[--n_small],
+                     l = partition[n_large++];
+
+            prob[s] = scaled[s];
+            alias[s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.f;
+            if (scaled[l] < 1.f)
+                partition[n_small++] = l;
+            else
+                partition[--n_large] = l;
+        }
+
+        // Remaining slots have weight 1 up to round-off and alias to themselves
+        while (n_large < n) {
+            uint32_t l = partition[n_large++];
+            prob[l] = 1.f;
+            alias[l] = l;
+        }
+        while (n_small > 0) {
+            uint32_t s = partition[--n_small];
+            prob[s] = 1.f;
+            alias[s] = s;
+        }
+
+        m_prob = dr::load<FloatStorage>(prob.get(), n);
+        m_alias = dr::load<UInt32Storage>(alias.get(), n);
+        m_density = dr::load<FloatStorage>(density.get(), n);
+    }
+
+    /**
+     * \brief Given a uniformly distributed 2D sample, draw a sample from the
+     * distribution
+     *
+     * Returns the warped position on <tt>[0, 1]^2</tt> and the associated
+     * probability density.
+     */
+    std::pair<Point2f, Float> sample(const Point2f &sample_,
+                                     Mask active = true) const {
+        MI_MASK_ARGUMENT(active);
+        Point2f sample(sample_);
+
+        // Avoid degeneracies on the domain boundary
+        sample = dr::clamp(sample, dr::Smallest<Float>,
+                           dr::OneMinusEpsilon<Float>);
+
+        uint32_t n = dr::prod(m_size);
+
+        // Select a table slot and alias-test using the fractional part
+        Float u = sample.x() * (ScalarFloat) n;
+        UInt32 slot = dr::minimum(UInt32(u), n - 1);
+        Float frac = u - Float(slot);
+
+        Float prob = dr::gather<Float>(m_prob, slot, active);
+        Mask take_alias = frac >= prob;
+
+        UInt32 index = dr::select(
+            take_alias, dr::gather<UInt32>(m_alias, slot, active), slot);
+
+        // Re-uniformize the variate consumed by the alias test
+        frac = dr::select(take_alias, (frac - prob) / (1.f - prob),
+                          frac / prob);
+        frac = dr::clamp(frac, 0.f, dr::OneMinusEpsilon<Float>);
+
+        // Uniformly position the sample within the selected cell
+        Point2u cell(index % m_size.x(), index / m_size.x());
+        Point2f pos = (Point2f(cell) + Point2f(frac, sample.y())) *
+                      Point2f(m_patch_size);
+
+        return { pos, dr::gather<Float>(m_density, index, active) };
+    }
+
+    /// Evaluate the density at position \c pos on <tt>[0, 1]^2</tt>
+    Float eval(const Point2f &pos, Mask active = true) const {
+        MI_MASK_ARGUMENT(active);
+
+        Point2f p = pos * Point2f(m_inv_patch_size);
+        Point2u cell(dr::minimum(UInt32(p.x()), m_size.x() - 1),
+                     dr::minimum(UInt32(p.y()), m_size.y() - 1));
+
+        return dr::gather<Float>(m_density,
+                                 cell.x() + cell.y() * m_size.x(), active);
+    }
+
+    std::string to_string() const {
+        std::ostringstream oss;
+        oss << "AliasTable2D[" << std::endl
+            << "  size = " << m_size << "," << std::endl
+            << "  storage = { " << (dr::prod(m_size) * 3 * sizeof(ScalarFloat)) / 1024
+            << " KiB }" << std::endl
+            << "]";
+        return oss.str();
+    }
+
+protected:
+    /// Number of piecewise constant cells (input resolution - 1)
+    ScalarVector2u m_size;
+
+    /// Size of a cell in the unit square
+    ScalarVector2f m_patch_size;
+
+    /// Inverse of the above
+    ScalarVector2f m_inv_patch_size;
+
+    /// Per-cell acceptance probability of the alias test
+    FloatStorage m_prob;
+
+    /// Per-cell alias index
+    UInt32Storage m_alias;
+
+    /// Normalized per-cell density on the unit square
+    FloatStorage m_density;
+};
+
 /// Base class of Hierarchical2D and Marginal2D with common functionality
 template <typename Float_, size_t Dimension_ = 0> class Distribution2D {
 public:
@@ -393,23 +609,29 @@ public:
             m_levels.reserve(1);
             m_levels.emplace_back(size, m_slices);
 
-            for (uint32_t slice = 0; slice < m_slices; ++slice) {
-                ScalarFloat *p = m_levels[0].data.data();
-                uint32_t offset = m_levels[0].size * slice;
+            // Independent per-slice work, parallelize via nanothread
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, m_slices, 1),
+                [&](const dr::blocked_range<uint32_t> &slice_range) {
+                for (uint32_t slice = slice_range.begin();
+                     slice != slice_range.end(); ++slice) {
+                    ScalarFloat *p = m_levels[0].data.data();
+                    uint32_t offset = m_levels[0].size * slice;
+
+                    ScalarFloat scale = 1.f;
+                    if (normalize) {
+                        double sum = 0.0;
+                        for (uint32_t i = 0; i < m_levels[0].size; ++i)
+                            sum += (double) data[offset + i];
+                        scale = dr::prod(n_patches) / (ScalarFloat) sum;
+                    }
 
-                ScalarFloat scale = 1.f;
-                if (normalize) {
-                    double sum = 0.0;
                     for (uint32_t i = 0; i < m_levels[0].size; ++i)
-                        sum += (double) data[offset + i];
-                    scale = dr::prod(n_patches) / (ScalarFloat) sum;
+                        p[offset + i] = data[offset + i] * scale;
                 }
+            });
 
-                for (uint32_t i = 0; i < m_levels[0].size; ++i)
-                    p[offset + i] = data[offset + i] * scale;
-
-                m_levels[0].ready();
-            }
+            m_levels[0].ready();
 
             return;
         }
@@ -428,54 +650,87 @@ public:
         ScalarFloat *l0p = m_levels[0].data.data(),
                     *l1p = m_levels[1].data.data();
 
-        for (uint32_t slice = 0; slice < m_slices; ++slice) {
+        /* Slices are independent of each other, and the row-wise loops within
+           a slice are parallelized as well so that single-slice inputs (e.g.
+           high-resolution environment maps) also benefit. Nanothread permits
+           such nested use of parallel_for(). */
+        auto process_slice = [&](uint32_t slice) {
             uint32_t offset0 = m_levels[0].size * slice,
                      offset1 = m_levels[1].size * slice;
 
-            // Integrate linear interpolant
-            const ScalarFloat *in = data + offset0;
+            // Integrate linear interpolant, one partial sum per row
+            std::unique_ptr<double[]> row_sum(new double[n_patches.y()]);
 
-            double sum = 0.0;
-            for (uint32_t y = 0; y < n_patches.y(); ++y) {
-                for (uint32_t x = 0; x < n_patches.x(); ++x) {
-                    ScalarFloat avg = .25f * (in[0] + in[1] + in[size.x()] +
-                                              in[size.x() + 1]);
-                    sum += (double) avg;
-                    *(l1p + m_levels[1].index(ScalarVector2u(x, y)) + offset1) = avg;
-                    ++in;
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, n_patches.y(), 64),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                for (uint32_t y = range.begin(); y != range.end(); ++y) {
+                    const ScalarFloat *in = data + offset0 + y * size.x();
+
+                    double sum = 0.0;
+                    for (uint32_t x = 0; x < n_patches.x(); ++x) {
+                        ScalarFloat avg = .25f * (in[0] + in[1] + in[size.x()] +
+                                                  in[size.x() + 1]);
+                        sum += (double) avg;
+                        *(l1p + m_levels[1].index(ScalarVector2u(x, y)) + offset1) = avg;
+                        ++in;
+                    }
+                    row_sum[y] = sum;
                 }
-                ++in;
-            }
+            });
+
+            double sum = 0.0;
+            for (uint32_t y = 0; y < n_patches.y(); ++y)
+                sum += row_sum[y];
 
             // Copy and normalize fine resolution interpolant
             ScalarFloat scale = normalize ? (ScalarFloat) (dr::prod(n_patches) / sum) : 1.f;
-            for (uint32_t i = 0; i < m_levels[0].size; ++i)
-                l0p[offset0 + i] = data[offset0 + i] * scale;
-            for (uint32_t i = 0; i < m_levels[1].size; ++i)
-                l1p[offset1 + i] *= scale;
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, m_levels[0].size, 4096),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                for (uint32_t i = range.begin(); i != range.end(); ++i)
+                    l0p[offset0 + i] = data[offset0 + i] * scale;
+            });
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, m_levels[1].size, 4096),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                for (uint32_t i = range.begin(); i != range.end(); ++i)
+                    l1p[offset1 + i] *= scale;
+            });
 
             // Build a MIP hierarchy
-            level_size = n_patches;
+            ScalarVector2u level_size_ = n_patches;
             for (uint32_t level = 2; level <= max_level + 1; ++level) {
                 const Level &l0 = m_levels[level - 1];
                 Level &l1 = m_levels[level];
-                offset0 = l0.size * slice;
-                offset1 = l1.size * slice;
-                level_size = dr::sr<1>(level_size + 1u);
+                uint32_t offset0_ = l0.size * slice,
+                         offset1_ = l1.size * slice;
+                level_size_ = dr::sr<1>(level_size_ + 1u);
 
                 const ScalarFloat *l0p_ = l0.data.data();
                 ScalarFloat *l1p_ = l1.data.data();
 
                 // Downsample
-                for (uint32_t y = 0; y < level_size.y(); ++y) {
-                    for (uint32_t x = 0; x < level_size.x(); ++x) {
-                        ScalarFloat *d1 = l1p_ + l1.index(ScalarVector2u(x, y)) + offset1;
-                        const ScalarFloat *d0 = l0p_ + l0.index(ScalarVector2u(x*2, y*2)) + offset0;
-                        *d1 = d0[0] + d0[1] + d0[2] + d0[3];
+                dr::parallel_for(
+                    dr::blocked_range<uint32_t>(0, level_size_.y(), 64),
+                    [&](const dr::blocked_range<uint32_t> &range) {
+                    for (uint32_t y = range.begin(); y != range.end(); ++y) {
+                        for (uint32_t x = 0; x < level_size_.x(); ++x) {
+                            ScalarFloat *d1 = l1p_ + l1.index(ScalarVector2u(x, y)) + offset1_;
+                            const ScalarFloat *d0 = l0p_ + l0.index(ScalarVector2u(x*2, y*2)) + offset0_;
+                            *d1 = d0[0] + d0[1] + d0[2] + d0[3];
+                        }
                     }
-                }
+                });
             }
-        }
+        };
+
+        dr::parallel_for(
+            dr::blocked_range<uint32_t>(0, m_slices, 1),
+            [&](const dr::blocked_range<uint32_t> &range) {
+            for (uint32_t slice = range.begin(); slice != range.end(); ++slice)
+                process_slice(slice);
+        });
 
         for (auto& level : m_levels)
             level.ready();
@@ -849,6 +1104,8 @@ public:
         m_param_strides, m_param_values, m_slices, interpolate_weights
     )
 
+    using UInt32Storage = DynamicBuffer<UInt32>;
+
     Marginal2D() = default;
 
     /**
@@ -867,12 +1124,21 @@ public:
      * construct the cdf needed for sample warping, which saves memory in case
      * this functionality is not needed (e.g. if only the interpolation in
      * ``eval()`` is used).
+     *
+     * If \c half_precision is set to \c true, the density values are stored
+     * in a compact IEEE half precision representation that is expanded on the
+     * fly during lookups, which halves the storage cost of large tables (e.g.
+     * the measured BSDF data) at a slight loss in accuracy. The marginal and
+     * conditional CDFs are unaffected by this parameter and always use single
+     * precision, since the binary searches performed during sample warping
+     * are sensitive to quantization.
      */
     Marginal2D(const ScalarFloat *data,
                const ScalarVector2u &size,
                const std::array<uint32_t, Dimension> &param_res = { },
                const std::array<const ScalarFloat *, Dimension> &param_values = { },
-               bool normalize = true, bool enable_sampling = true)
+               bool normalize = true, bool enable_sampling = true,
+               bool half_precision = false)
         : Base(size, param_res, param_values), m_size(size), m_normalized(normalize) {
 
         uint32_t w      = m_size.x(),
@@ -884,35 +1150,59 @@ public:
         double scale_x = .5 / (w - 1),
                scale_y = .5 / (h - 1);
 
-        std::unique_ptr<ScalarFloat[]> data_out(new ScalarFloat[m_slices * n_data]);
+        size_t n_total = (size_t) m_slices * n_data;
+
+        /* In half precision mode, pairs of converted values are packed into
+           32-bit words after construction (see \ref fetch_data()) */
+        std::unique_ptr<ScalarFloat[]> data_out;
+        std::unique_ptr<uint16_t[]> data_half;
+        if (half_precision)
+            data_half.reset(new uint16_t[(n_total + 1) & ~(size_t) 1]);
+        else
+            data_out.reset(new ScalarFloat[n_total]);
+
+        auto store_value = [&](size_t index, ScalarFloat value) {
+            if (half_precision)
+                data_half[index] = dr::half::float32_to_float16((float) value);
+            else
+                data_out[index] = value;
+        };
 
         if (enable_sampling) {
             std::unique_ptr<ScalarFloat[]> marg_cdf(new ScalarFloat[m_slices * n_marg]);
             std::unique_ptr<ScalarFloat[]> cond_cdf(new ScalarFloat[m_slices * n_cond]);
 
-            ScalarFloat *marg_cdf_ptr = marg_cdf.get(),
-                        *cond_cdf_ptr = cond_cdf.get(),
-                        *data_out_ptr = data_out.get();
+            /* Each slice is processed independently; the conditional CDF rows
+               within a slice don't depend on each other either, so they are
+               parallelized as well for large single-slice inputs. Nanothread
+               permits such nested use of parallel_for(). */
+            auto process_slice = [&](uint32_t slice) {
+                const ScalarFloat *data_ptr = data + slice * (size_t) n_data;
+                ScalarFloat *marg_cdf_ptr = marg_cdf.get() + slice * (size_t) n_marg,
+                            *cond_cdf_ptr = cond_cdf.get() + slice * (size_t) n_cond;
 
-            std::unique_ptr<double[]> cond_cdf_sum(new double[h]);
+                std::unique_ptr<double[]> cond_cdf_sum(new double[h]);
 
-            for (uint32_t slice = 0; slice < m_slices; ++slice) {
                 ScalarFloat norm = 1.f;
 
                 /* The marginal/probability distribution computation
                    differs for the Continuous=false/true cases */
                 if constexpr (Continuous) {
                     // Construct conditional CDF
-                    for (uint32_t y = 0; y < h; ++y) {
-                        double accum = 0.0;
-                        uint32_t i = y * w, j = y * (w - 1);
-                        for (uint32_t x = 0; x < w - 1; ++x, ++i, ++j) {
-                            accum += scale_x * ((double) data[i] +
-                                                (double) data[i + 1]);
-                            cond_cdf_ptr[j] = (ScalarFloat) accum;
+                    dr::parallel_for(
+                        dr::blocked_range<uint32_t>(0, h, 64),
+                        [&](const dr::blocked_range<uint32_t> &range) {
+                        for (uint32_t y = range.begin(); y != range.end(); ++y) {
+                            double accum = 0.0;
+                            uint32_t i = y * w, j = y * (w - 1);
+                            for (uint32_t x = 0; x < w - 1; ++x, ++i, ++j) {
+                                accum += scale_x * ((double) data_ptr[i] +
+                                                    (double) data_ptr[i + 1]);
+                                cond_cdf_ptr[j] = (ScalarFloat) accum;
+                            }
+                            cond_cdf_sum[y] = accum;
                         }
-                        cond_cdf_sum[y] = accum;
-                    }
+                    });
 
                     // Construct marginal CDF
                     double accum = 0.0;
@@ -927,18 +1217,22 @@ public:
                     double scale = scale_x * scale_y;
 
                     // Construct conditional CDF
-                    for (uint32_t y = 0; y < h - 1; ++y) {
-                        double accum = 0.0;
-                        uint32_t i = y * w, j = y * (w - 1);
-                        for (uint32_t x = 0; x < w - 1; ++x, ++i, ++j) {
-                            accum += scale * ((double) data[i] +
-                                              (double) data[i + 1] +
-                                              (double) data[i + w] +
-                                              (double) data[i + w + 1]);
-                            cond_cdf_ptr[j] = (ScalarFloat) accum;
+                    dr::parallel_for(
+                        dr::blocked_range<uint32_t>(0, h - 1, 64),
+                        [&](const dr::blocked_range<uint32_t> &range) {
+                        for (uint32_t y = range.begin(); y != range.end(); ++y) {
+                            double accum = 0.0;
+                            uint32_t i = y * w, j = y * (w - 1);
+                            for (uint32_t x = 0; x < w - 1; ++x, ++i, ++j) {
+                                accum += scale * ((double) data_ptr[i] +
+                                                  (double) data_ptr[i + 1] +
+                                                  (double) data_ptr[i + w] +
+                                                  (double) data_ptr[i + w + 1]);
+                                cond_cdf_ptr[j] = (ScalarFloat) accum;
+                            }
+                            cond_cdf_sum[y] = accum;
                         }
-                        cond_cdf_sum[y] = accum;
-                    }
+                    });
 
                     // Construct marginal CDF
                     double accum = 0.0;
@@ -951,42 +1245,68 @@ public:
                         norm = ScalarFloat(1.0 / accum);
                 }
 
-                for (size_t i = 0; i < n_cond; ++i)
-                    *cond_cdf_ptr++ *= norm;
+                dr::parallel_for(
+                    dr::blocked_range<uint32_t>(0, n_cond, 4096),
+                    [&](const dr::blocked_range<uint32_t> &range) {
+                    for (uint32_t i = range.begin(); i != range.end(); ++i)
+                        cond_cdf_ptr[i] *= norm;
+                });
                 for (size_t i = 0; i < n_marg; ++i)
-                    *marg_cdf_ptr++ *= norm;
-                for (size_t i = 0; i < n_data; ++i)
-                    *data_out_ptr++ = *data++ * norm;
-            }
+                    marg_cdf_ptr[i] *= norm;
+                dr::parallel_for(
+                    dr::blocked_range<uint32_t>(0, n_data, 4096),
+                    [&](const dr::blocked_range<uint32_t> &range) {
+                    for (uint32_t i = range.begin(); i != range.end(); ++i)
+                        store_value(slice * (size_t) n_data + i, data_ptr[i] * norm);
+                });
+            };
+
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, m_slices, 1),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                for (uint32_t slice = range.begin(); slice != range.end(); ++slice)
+                    process_slice(slice);
+            });
 
             m_marg_cdf = dr::load<FloatStorage>(marg_cdf.get(), m_slices * n_marg);
             m_cond_cdf = dr::load<FloatStorage>(cond_cdf.get(), m_slices * n_cond);
         } else {
-            ScalarFloat *data_out_ptr = data_out.get();
-
-            for (uint32_t slice = 0; slice < m_slices; ++slice) {
-                ScalarFloat norm = 1.f;
-
-                if (normalize) {
-                    double sum = 0.0;
-                    for (uint32_t y = 0; y < h - 1; ++y) {
-                        size_t i = y * w;
-                        for (uint32_t x = 0; x < w - 1; ++x, ++i) {
-                            sum += (double) data[i] +
-                                   (double) data[i + 1] +
-                                   (double) data[i + w] +
-                                   (double) data[i + w + 1];
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, m_slices, 1),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                for (uint32_t slice = range.begin(); slice != range.end(); ++slice) {
+                    const ScalarFloat *data_ptr = data + slice * (size_t) n_data;
+
+                    ScalarFloat norm = 1.f;
+                    if (normalize) {
+                        double sum = 0.0;
+                        for (uint32_t y = 0; y < h - 1; ++y) {
+                            size_t i = y * w;
+                            for (uint32_t x = 0; x < w - 1; ++x, ++i) {
+                                sum += (double) data_ptr[i] +
+                                       (double) data_ptr[i + 1] +
+                                       (double) data_ptr[i + w] +
+                                       (double) data_ptr[i + w + 1];
+                            }
                         }
+                        norm = ScalarFloat(1.0 / (scale_x * scale_y * sum));
                     }
-                    norm = ScalarFloat(1.0 / (scale_x * scale_y * sum));
-                }
 
-                for (uint32_t k = 0; k < n_data; ++k)
-                    *data_out_ptr++ = *data++ * norm;
-            }
+                    for (uint32_t k = 0; k < n_data; ++k)
+                        store_value(slice * (size_t) n_data + k, data_ptr[k] * norm);
+                }
+            });
         }
 
-        m_data = dr::load<FloatStorage>(data_out.get(), m_slices * n_data);
+        if (half_precision) {
+            size_t n_padded = (n_total + 1) & ~(size_t) 1;
+            if (n_total != n_padded)
+                data_half[n_total] = 0;
+            m_data_half = dr::load<UInt32Storage>(
+                (const uint32_t *) data_half.get(), n_padded / 2);
+        } else {
+            m_data = dr::load<FloatStorage>(data_out.get(), n_total);
+        }
     }
 
     /**
@@ -1043,18 +1363,56 @@ public:
         if (Dimension != 0)
             index += slice_offset * size;
 
-        Float v00 = lookup(m_data, 0, index,
-                           size, param_weight, active),
-              v10 = lookup(m_data, 1, index,
-                           size, param_weight, active),
-              v01 = lookup(m_data, m_size.x(), index,
-                           size, param_weight, active),
-              v11 = lookup(m_data, m_size.x() + 1, index,
-                           size, param_weight, active);
+        Float v00 = lookup_data(0, index, size, param_weight, active),
+              v10 = lookup_data(1, index, size, param_weight, active),
+              v01 = lookup_data(m_size.x(), index, size, param_weight, active),
+              v11 = lookup_data(m_size.x() + 1, index, size, param_weight, active);
 
         return warp::square_to_bilinear_pdf(v00, v10, v01, v11, pos);
     }
 
+    /**
+     * \brief Evaluate the density at several positions that share a common
+     * parameter vector
+     *
+     * This is equivalent to calling \ref eval() once per entry of \c pos,
+     * except that the parameter-related indices and interpolation weights
+     * are computed only once and reused for all positions, which is
+     * considerably cheaper when the distribution is conditioned on several
+     * parameters.
+     */
+    void eval_multi(const Point2f *pos_, size_t count, Float *out,
+                    const Float *param = nullptr, Mask active = true) const {
+        MI_MASK_ARGUMENT(active);
+
+        Float param_weight[2 * DimensionInt];
+        UInt32 slice_offset = interpolate_weights(param, param_weight, active);
+
+        uint32_t size = dr::prod(m_size);
+
+        for (size_t k = 0; k < count; ++k) {
+            // Avoid issues with roundoff error
+            Point2f pos = dr::clamp(pos_[k], 0.f, 1.f);
+
+            // Compute linear interpolation weights
+            pos *= m_inv_patch_size;
+            Point2u offset = dr::minimum(Point2u(Point2i(pos)), m_size - 2u);
+            pos -= Point2f(Point2i(offset));
+
+            UInt32 index = offset.x() + offset.y() * m_size.x();
+
+            if (Dimension != 0)
+                index += slice_offset * size;
+
+            Float v00 = lookup_data(0, index, size, param_weight, active),
+                  v10 = lookup_data(1, index, size, param_weight, active),
+                  v01 = lookup_data(m_size.x(), index, size, param_weight, active),
+                  v11 = lookup_data(m_size.x() + 1, index, size, param_weight, active);
+
+            out[k] = warp::square_to_bilinear_pdf(v00, v10, v01, v11, pos);
+        }
+    }
+
     std::string to_string() const {
         std::ostringstream oss;
         oss << "Marginal2D" << Dimension << "[" << std::endl
@@ -1077,8 +1435,10 @@ public:
         }
         oss << "  storage = { " << m_slices << " slice" << (m_slices > 1 ? "s" : "")
             << ", ";
-        size_t size = m_slices * (dr::prod(m_size) * 2 + m_size.y());
-        oss << util::mem_string(size * sizeof(ScalarFloat)) << " }" << std::endl
+        size_t size = m_data.size() * sizeof(ScalarFloat) +
+                      m_data_half.size() * sizeof(uint32_t) +
+                      (m_marg_cdf.size() + m_cond_cdf.size()) * sizeof(ScalarFloat);
+        oss << util::mem_string(size) << " }" << std::endl
             << "]";
         return oss.str();
     }
@@ -1107,6 +1467,55 @@ protected:
         }
     }
 
+    /**
+     * \brief Fetch a single density value, expanding the packed half
+     * precision representation on the fly if it is in use
+     */
+    MI_INLINE Float fetch_data(const UInt32 &index, Mask active) const {
+        if (likely(m_data_half.empty()))
+            return dr::gather<Float>(m_data, index, active);
+
+        // Two half precision values are packed into each 32-bit word
+        UInt32 word = dr::gather<UInt32>(m_data_half, dr::sr<1>(index), active),
+               bits = dr::select(dr::eq(index & 1u, 0u),
+                                 word & 0xffffu, dr::sr<16>(word));
+
+        /* Shift the exponent/mantissa into binary32 position; the scale
+           factor of 2^112 then corrects the exponent bias from 15 to 127 and
+           also maps half precision denormals onto their correct values. The
+           density values are nonnegative and finite, so neither the sign bit
+           nor infinities/NaNs require any special treatment. */
+        using Float32 = dr::float32_array_t<Float>;
+        Float32 value =
+            dr::reinterpret_array<Float32, UInt32>(dr::sl<13>(bits)) *
+            Float32(0x1p+112f);
+
+        return Float(value);
+    }
+
+    /// Variant of \ref lookup() that reads from the (possibly compressed) density data
+    template <size_t Dim = Dimension>
+    MI_INLINE Float lookup_data(size_t offset,
+                                 UInt32 i0,
+                                 uint32_t size,
+                                 const Float *param_weight,
+                                 Mask active) const {
+        if constexpr (Dim != 0) {
+            UInt32 i1 = i0 + m_param_strides[Dim - 1] * size;
+
+            Float w0 = param_weight[2 * Dim - 2],
+                  w1 = param_weight[2 * Dim - 1],
+                  v0 = lookup_data<Dim - 1>(offset, i0, size, param_weight, active),
+                  v1 = lookup_data<Dim - 1>(offset, i1, size, param_weight, active);
+
+            return dr::fmadd(v0, w0, v1 * w1);
+        } else {
+            DRJIT_MARK_USED(param_weight);
+            DRJIT_MARK_USED(size);
+            return fetch_data(i0 + (uint32_t) offset, active);
+        }
+    }
+
     MI_INLINE
     std::pair<Point2f, Float> sample_discrete(Point2f sample,
                                               const Float *param,
@@ -1175,14 +1584,10 @@ protected:
 
         // Sample a position on the bilinear patch
         UInt32 offset_data = slice_offset * n_data + row * m_size.x() + col;
-        Float v00 = lookup(m_data, 0, offset_data, n_data,
-                           param_weight, active),
-              v10 = lookup(m_data, 1, offset_data, n_data,
-                           param_weight, active),
-              v01 = lookup(m_data, m_size.x(), offset_data,
-                           n_data, param_weight, active),
-              v11 = lookup(m_data, m_size.x() + 1, offset_data,
-                           n_data, param_weight, active);
+        Float v00 = lookup_data(0, offset_data, n_data, param_weight, active),
+              v10 = lookup_data(1, offset_data, n_data, param_weight, active),
+              v01 = lookup_data(m_size.x(), offset_data, n_data, param_weight, active),
+              v11 = lookup_data(m_size.x() + 1, offset_data, n_data, param_weight, active);
 
         Float pdf;
         std::tie(sample, pdf) =
@@ -1215,14 +1620,10 @@ protected:
         UInt32 index = offset.x() + offset.y() * m_size.x() + slice_offset * n_data;
         sample -= Point2f(Point2i(offset));
 
-        Float v00 = lookup(m_data, 0, index,
-                           n_data, param_weight, active),
-              v10 = lookup(m_data, 1, index,
-                           n_data, param_weight, active),
-              v01 = lookup(m_data, m_size.x(), index,
-                           n_data, param_weight, active),
-              v11 = lookup(m_data, m_size.x() + 1, index,
-                           n_data, param_weight, active);
+        Float v00 = lookup_data(0, index, n_data, param_weight, active),
+              v10 = lookup_data(1, index, n_data, param_weight, active),
+              v01 = lookup_data(m_size.x(), index, n_data, param_weight, active),
+              v11 = lookup_data(m_size.x() + 1, index, n_data, param_weight, active);
 
         Float pdf;
         std::tie(sample, pdf) = warp::bilinear_to_square(v00, v10, v01, v11, sample);
@@ -1329,14 +1730,10 @@ protected:
 
         UInt32 offset_data = slice_offset * n_data + row * m_size.x() + col;
 
-        Float v00 = lookup(m_data, 0, offset_data, n_data,
-                           param_weight, active),
-              v10 = lookup(m_data, 1, offset_data, n_data,
-                           param_weight, active),
-              v01 = lookup(m_data, m_size.x(), offset_data,
-                           n_data, param_weight, active),
-              v11 = lookup(m_data, m_size.x() + 1, offset_data,
-                           n_data, param_weight, active),
+        Float v00 = lookup_data(0, offset_data, n_data, param_weight, active),
+              v10 = lookup_data(1, offset_data, n_data, param_weight, active),
+              v01 = lookup_data(m_size.x(), offset_data, n_data, param_weight, active),
+              v11 = lookup_data(m_size.x() + 1, offset_data, n_data, param_weight, active),
               c0  = dr::lerp(v00, v01, sample.y()),
               c1  = dr::lerp(v10, v11, sample.y());
 
@@ -1375,14 +1772,10 @@ protected:
             slice_offset * n_data + pos.y() * m_size.x() + pos.x();
 
         // Invert the X component
-        Float v00 = lookup(m_data, 0, offset_data, n_data,
-                           param_weight, active),
-              v10 = lookup(m_data, 1, offset_data, n_data,
-                           param_weight, active),
-              v01 = lookup(m_data, m_size.x(), offset_data,
-                           n_data, param_weight, active),
-              v11 = lookup(m_data, m_size.x() + 1, offset_data,
-                           n_data, param_weight, active);
+        Float v00 = lookup_data(0, offset_data, n_data, param_weight, active),
+              v10 = lookup_data(1, offset_data, n_data, param_weight, active),
+              v01 = lookup_data(m_size.x(), offset_data, n_data, param_weight, active),
+              v11 = lookup_data(m_size.x() + 1, offset_data, n_data, param_weight, active);
 
         Float c0  = dr::lerp(v00, v01, sample.y()),
               c1  = dr::lerp(v10, v11, sample.y()),
@@ -1445,9 +1838,12 @@ protected:
     /// Resolution of the discretized density function
     ScalarVector2u m_size;
 
-    /// Density values
+    /// Density values (single precision storage, empty in half precision mode)
     FloatStorage m_data;
 
+    /// Density values (half precision storage, two values per 32-bit word)
+    UInt32Storage m_data_half;
+
     /// Marginal and conditional PDFs
     FloatStorage m_marg_cdf;
     FloatStorage m_cond_cdf;
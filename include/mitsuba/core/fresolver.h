@@ -3,6 +3,8 @@
 #include <mitsuba/core/filesystem.h>
 #include <mitsuba/core/object.h>
 #include <iosfwd>
+#include <mutex>
+#include <unordered_map>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -27,6 +29,20 @@ public:
     /// Walk through the list of search paths and try to resolve the input path
     fs::path resolve(const fs::path &path) const;
 
+    /**
+     * \brief Resolve a batch of paths in parallel and cache the results
+     *
+     * Subsequent \ref resolve() calls for these inputs are served from the
+     * cache. This is useful when loading scenes that reference thousands of
+     * files on a high-latency (e.g. network) filesystem: the per-file
+     * ``stat`` latency is overlapped instead of being paid serially by each
+     * plugin constructor.
+     */
+    void prefetch(const std::vector<fs::path> &paths);
+
+    /// Drop all cached lookups (done automatically when search paths change)
+    void flush_cache();
+
     /// Return the number of search paths
     size_t size() const { return m_paths.size(); }
 
@@ -46,19 +62,19 @@ public:
     bool contains(const fs::path &p) const;
 
     /// Erase the entry at the given iterator position
-    void erase(iterator it) { m_paths.erase(it); }
+    void erase(iterator it) { flush_cache(); m_paths.erase(it); }
 
     /// Erase the search path from the list
     void erase(const fs::path &p);
 
     /// Clear the list of search paths
-    void clear() { m_paths.clear(); }
+    void clear() { flush_cache(); m_paths.clear(); }
 
     /// Prepend an entry at the beginning of the list of search paths
-    void prepend(const fs::path &path) { m_paths.insert(m_paths.begin(), path); }
+    void prepend(const fs::path &path) { flush_cache(); m_paths.insert(m_paths.begin(), path); }
 
     /// Append an entry to the end of the list of search paths
-    void append(const fs::path &path) { m_paths.push_back(path); }
+    void append(const fs::path &path) { flush_cache(); m_paths.push_back(path); }
 
     /// Return an entry from the list of search paths
     fs::path &operator[](size_t index) { return m_paths[index]; }
@@ -71,7 +87,14 @@ public:
 
     MI_DECLARE_CLASS()
 private:
+    /// Walk the search paths without consulting the prefetch cache
+    fs::path resolve_uncached(const fs::path &path) const;
+
     std::vector<fs::path> m_paths;
+
+    /// Lookups warmed up via \ref prefetch()
+    mutable std::mutex m_cache_mutex;
+    std::unordered_map<std::string, fs::path> m_cache;
 };
 
 NAMESPACE_END(mitsuba)
@@ -24,6 +24,13 @@ private:
  *
  * The underlying file abstraction is ``std::fstream``, and so most
  * operations can be expected to behave similarly.
+ *
+ * Reads are served from an internal read-ahead buffer whenever possible, so
+ * that loaders issuing many small reads (e.g. header or dictionary parsing)
+ * do not pay the cost of a separate I/O operation each time. Seeks within
+ * the buffered window simply move the read cursor; other seeks and any
+ * write invalidate the buffer. The buffer size can be specified at
+ * construction time (a value of zero disables buffering altogether).
  */
 class MI_EXPORT_LIB FileStream : public Stream {
 public:
@@ -44,11 +51,14 @@ public:
     /** \brief Constructs a new FileStream by opening the file pointed by <tt>p</tt>.
      *
      * The file is opened in read-only or read/write mode as specified by \c mode.
+     * The optional \c buffer_size parameter controls the size of the internal
+     * read-ahead buffer; a value of zero disables read buffering.
      *
      * Throws if trying to open a non-existing file in with write disabled.
      * Throws an exception if the file cannot be opened / created.
      */
-    FileStream(const fs::path &p, EMode mode = ERead);
+    FileStream(const fs::path &p, EMode mode = ERead,
+               size_t buffer_size = 65536);
 
     /** \brief Closes the stream and the underlying file.
      * No further read or write operations are permitted.
@@ -65,7 +75,12 @@ public:
     virtual std::string read_line() override;
 
     /// Return the "native" std::fstream associated with this FileStream
-    std::fstream *native() { return m_file.get(); }
+    std::fstream *native() {
+        /* Hand over a stream whose position matches the logical read
+           position before any direct access takes place */
+        flush_read_buffer();
+        return m_file.get();
+    }
 
     /// Return the path descriptor associated with this FileStream
     const fs::path &path() const { return m_path; }
@@ -128,10 +143,27 @@ protected:
     /// Protected destructor
     virtual ~FileStream();
 
+    /**
+     * \brief Discard the contents of the read-ahead buffer and reposition
+     * the underlying file stream at the logical read position
+     */
+    void flush_read_buffer();
+
 private:
     EMode m_mode;
     fs::path m_path;
     mutable std::unique_ptr<std::fstream> m_file;
+
+    /// Read-ahead buffer (see the class documentation)
+    std::unique_ptr<char[]> m_buffer;
+    /// Buffer capacity in bytes (zero when read buffering is disabled)
+    size_t m_buffer_capacity;
+    /// File offset corresponding to the first byte of the buffer
+    size_t m_buffer_offset = 0;
+    /// Number of valid bytes currently stored in the buffer
+    size_t m_buffer_filled = 0;
+    /// Read cursor within the buffered window
+    size_t m_buffer_pos = 0;
 };
 
 NAMESPACE_END(mitsuba)
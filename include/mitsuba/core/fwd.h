@@ -290,8 +290,16 @@ template <typename Float_> struct CoreAliases {
     if constexpr (!dr::is_array_v<Float>)                                      \
         mask = true;
 
+/* Event counter registry (see mitsuba/core/statistics.h); the forward
+   declaration allows MI_MASKED_FUNCTION to count invocations of profiled
+   methods without forcing the header on every user of this macro */
+NAMESPACE_BEGIN(render_stats)
+extern MI_EXPORT_LIB void record_phase(int phase, size_t lanes);
+NAMESPACE_END(render_stats)
+
 #define MI_MASKED_FUNCTION(profiler_phase, mask)                               \
     ScopedPhase scope_phase(profiler_phase);                                   \
+    render_stats::record_phase((int) profiler_phase, dr::width(mask));         \
     (void) mask;                                                               \
     if constexpr (!dr::is_array_v<Float>)                                      \
         mask = true;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mitsuba/core/platform.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * The functions in this namespace implement a lightweight registry that
+ * tracks where time is spent while a scene is being loaded. In contrast to
+ * the sampling profiler in <tt>mitsuba/core/profiler.h</tt>, which targets
+ * rendering hot spots, this facility produces an exact hierarchical
+ * breakdown of the loading phase: XML parsing, per-plugin instantiation
+ * (aggregated by plugin class, so e.g. all \c ply meshes or \c bitmap
+ * textures appear as one line) and acceleration data structure
+ * construction.
+ *
+ * Timings are recorded via the RAII helper \ref ScopedLoadTimer, which
+ * measures *exclusive* durations: time spent constructing nested plugins
+ * is attributed to the nested plugin rather than its parent. The resulting
+ * report is logged at \c Info level after \ref xml::load_file() /
+ * \ref xml::load_string() and can be queried from Python via
+ * <tt>mitsuba.util.load_timings()</tt>.
+ */
+NAMESPACE_BEGIN(load_stats)
+
+/// Aggregated timing record for one (stage, class) combination
+struct StageTiming {
+    /// Top-level stage (e.g. "Parsing", "Plugin instantiation")
+    std::string stage;
+
+    /// Entry below the stage (e.g. a plugin class name), may be empty
+    std::string name;
+
+    /// Number of times this entry was recorded (e.g. plugin instances)
+    size_t count;
+
+    /// Accumulated exclusive time in seconds
+    double seconds;
+};
+
+/// Discard all recorded timings (invoked at the start of a scene load)
+extern MI_EXPORT_LIB void clear();
+
+/// Record \c seconds of exclusive time for the given stage and entry name
+extern MI_EXPORT_LIB void record(const std::string &stage,
+                                 const std::string &name, double seconds);
+
+/// Return all recorded timings, ordered by first occurrence
+extern MI_EXPORT_LIB std::vector<StageTiming> timings();
+
+/// Render the recorded timings into a human-readable hierarchical report
+extern MI_EXPORT_LIB std::string report();
+
+/**
+ * \brief RAII helper that measures the exclusive runtime of a load stage
+ *
+ * Instances may be nested (also across the parallel loading worker
+ * threads); time measured by a nested timer is subtracted from the
+ * enclosing one so that every recorded duration counts each wall-clock
+ * interval exactly once.
+ */
+class MI_EXPORT_LIB ScopedLoadTimer {
+public:
+    ScopedLoadTimer(std::string stage, std::string name = "");
+    ~ScopedLoadTimer();
+
+    ScopedLoadTimer(const ScopedLoadTimer &) = delete;
+    ScopedLoadTimer &operator=(const ScopedLoadTimer &) = delete;
+
+private:
+    std::string m_stage, m_name;
+    std::chrono::high_resolution_clock::time_point m_start;
+    double m_child_time = 0.0;
+    ScopedLoadTimer *m_parent;
+};
+
+NAMESPACE_END(load_stats)
+NAMESPACE_END(mitsuba)
@@ -57,6 +57,29 @@ public:
         const std::string &formatted, const std::string &eta,
         const void *ptr = nullptr);
 
+    /**
+     * \brief Enable or disable asynchronous log message delivery
+     *
+     * When enabled, \ref log() merely formats the message on the calling
+     * thread and deposits the resulting record in a bounded lock-free queue,
+     * which a dedicated thread drains into the registered appenders. This
+     * removes the appender mutex from the critical path of worker threads,
+     * which otherwise serialize on it when verbose (e.g. Debug-level) logging
+     * is active during rendering. When the queue is full, callers block until
+     * the drain thread catches up rather than dropping records.
+     *
+     * Messages at or above the error level (see \ref set_error_level()) are
+     * unaffected and continue to raise exceptions on the calling thread.
+     * Asynchronous delivery is disabled by default.
+     */
+    void set_async(bool enabled);
+
+    /// Is asynchronous log message delivery enabled? (see \ref set_async())
+    bool async() const;
+
+    /// Block until all queued log messages have reached the appenders
+    void flush();
+
     /// Set the log level (everything below will be ignored)
     void set_log_level(LogLevel level);
 
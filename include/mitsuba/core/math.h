@@ -207,7 +207,8 @@ template <typename T> T log2i_ceil(T value) {
  * is a user-specified predicate that monotonically decreases over this range
  * (i.e. max one \c true -> \c false transition).
  *
- * The predicate will be evaluated exactly <tt>floor(log2(size)) + 1<tt> times.
+ * The predicate will be evaluated exactly <tt>floor(log2(size)) + 1<tt> times
+ * (one time fewer when <tt>size - 1</tt> is a power of two, see below).
  * Note that the template parameter \c Index is automatically inferred from the
  * supplied predicate, which takes an index or an index vector of type \c Index
  * as input argument and can (optionally) take a mask argument as well. In the
@@ -215,6 +216,15 @@ template <typename T> T log2i_ceil(T value) {
  * When \c pred is \c false for all entries, the function returns \c 0, and
  * when it is \c true for all cases, it returns <tt>size-2<tt>.
  *
+ * The search is carried out with a fixed per-lane trip count and without any
+ * data-dependent branches, so instantiating \c Index with a packet or JIT
+ * array type turns it into an efficient multi-query search over a batch of
+ * lanes. When <tt>size - 1</tt> is a power of two -- which holds for most
+ * tables built from bitmaps and MIP hierarchies -- a specialized descent is
+ * used that maintains a single running index and needs exactly
+ * <tt>log2(size - 1)</tt> predicate evaluations with one select each, rather
+ * than the two index updates per step of the general bisection.
+ *
  * The main use case of this function is to locate an interval (i, i+1)
  * in an ordered list.
  *
@@ -232,6 +242,20 @@ template <typename T> T log2i_ceil(T value) {
 template <typename Index, typename Predicate>
 MI_INLINE Index find_interval(dr::scalar_t<Index> size,
                                const Predicate &pred) {
+    using ScalarIndex = dr::scalar_t<Index>;
+
+    ScalarIndex n = size - 1;
+    if (likely((n & (n - 1)) == 0)) {
+        /* The result is clamped to [0, size-2], i.e. n possible outcomes --
+           when n is a power of two, log2(n) probes therefore suffice. Each
+           step halves the remaining range and keeps a single running index,
+           which the compiler can unroll into branch-free selects. */
+        Index base = dr::zeros<Index>();
+        for (ScalarIndex half = n >> 1; half != 0; half >>= 1)
+            base = dr::select(pred(base + half), base + half, base);
+        return base;
+    }
+
     return dr::binary_search<Index>(1, size - 1, pred) - 1;
 }
 
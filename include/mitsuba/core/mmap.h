@@ -42,9 +42,61 @@ public:
     /// Return whether the mapped memory region can be modified
     bool can_write() const;
 
+    /// Return whether this instance refers to a named shared-memory segment
+    bool shared() const;
+
     /// Return a string representation
     std::string to_string() const override;
 
+    /**
+     * \brief Create or attach to a named shared-memory segment
+     *
+     * Establishes a memory mapping that is shared among all processes on the
+     * current machine that request a segment with the same name. The first
+     * caller creates the segment and is responsible for filling it with data
+     * and then publishing it via \ref mark_shared_ready(). Subsequent callers
+     * attach to the existing segment and block until the creator has done so.
+     * This allows e.g. multiple renderer processes on one node to keep a
+     * single resident copy of large scene assets.
+     *
+     * The segment persists after the processes that map it exit; use \ref
+     * unlink_shared() to remove it from the system.
+     *
+     * \param name
+     *    Name of the segment. Must not contain slashes and should be short
+     *    (some platforms limit names to ~30 characters).
+     *
+     * \param size
+     *    Size of the segment in bytes. Only used when creating; when
+     *    attaching, the size is read back from the existing segment.
+     *
+     * \param created
+     *    Optional: set to \c true if this call created the segment, and to
+     *    \c false if it attached to an existing one. Attached segments are
+     *    mapped read-only.
+     */
+    static ref<MemoryMappedFile> create_or_attach_shared(const std::string &name,
+                                                         size_t size,
+                                                         bool *created = nullptr);
+
+    /**
+     * \brief Publish a shared-memory segment created via
+     * \ref create_or_attach_shared()
+     *
+     * Unblocks processes that are waiting to attach to the segment. May only
+     * be called by the segment's creator, once its contents are complete.
+     */
+    void mark_shared_ready();
+
+    /**
+     * \brief Remove a named shared-memory segment from the system
+     *
+     * Existing mappings remain valid until they are released; new attach
+     * attempts will no longer find the segment. Does nothing if no segment
+     * with the given name exists.
+     */
+    static void unlink_shared(const std::string &name);
+
     /**
      * \brief Create a temporary memory-mapped file
      *
@@ -39,8 +39,19 @@ public:
     /// Return the current reference count
     int ref_count() const { return m_ref_count; };
 
-    /// Increase the object's reference count by one
-    void inc_ref() const { ++m_ref_count; }
+    /** \brief Increase the object's reference count by one
+     *
+     * The increment uses a relaxed memory ordering: acquiring a new
+     * reference never needs to synchronize with other threads, only the
+     * final decrement in \ref dec_ref() does. Performance-sensitive code
+     * (e.g. the shading loops of integrators) should avoid reference
+     * count traffic altogether and pass raw \c Object pointers while a
+     * \ref ref<..> instance further up the call stack keeps the object
+     * alive.
+     */
+    void inc_ref() const {
+        m_ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
 
     /** \brief Decrease the reference count of the object and possibly
      * deallocate it.
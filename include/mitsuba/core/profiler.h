@@ -84,8 +84,20 @@ extern MI_EXPORT_LIB __itt_string_handle *
     mitsuba_itt_phase[int(ProfilerPhase::ProfilerPhaseCount)];
 #endif
 
+/// Flag indicating whether timeline recording is active (see \ref Profiler)
+extern MI_EXPORT_LIB bool profiler_trace_enabled;
+
+/// Return a monotonic timestamp in nanoseconds (used by \ref ScopedPhase)
+extern MI_EXPORT_LIB uint64_t profiler_timestamp();
+
+/// Append a completed phase interval to the calling thread's trace buffer
+extern MI_EXPORT_LIB void profiler_record_interval(ProfilerPhase phase,
+                                                   uint64_t start,
+                                                   uint64_t end);
+
 struct ScopedPhase {
-    ScopedPhase(ProfilerPhase phase) {
+    ScopedPhase(ProfilerPhase phase)
+        : m_phase(phase), m_start(uint64_t(-1)) {
         /// Interface with various external visual profilers
 #if defined(MI_ENABLE_ITTNOTIFY)
         __itt_task_begin(mitsuba_itt_domain, __itt_null, __itt_null,
@@ -95,7 +107,9 @@ struct ScopedPhase {
 #if defined(MI_ENABLE_NVTX)
         nvtxRangePush(profiler_phase_id[(int) phase]);
 #endif
-        (void) phase;
+
+        if (unlikely(profiler_trace_enabled))
+            m_start = profiler_timestamp();
     }
 
     ~ScopedPhase() {
@@ -106,14 +120,46 @@ struct ScopedPhase {
 #if defined(MI_ENABLE_NVTX)
         nvtxRangePop();
 #endif
+
+        if (unlikely(m_start != uint64_t(-1)))
+            profiler_record_interval(m_phase, m_start, profiler_timestamp());
     }
 
     ScopedPhase(const ScopedPhase &) = delete;
     ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+    ProfilerPhase m_phase;
+    uint64_t m_start;
 };
 
+/**
+ * In addition to forwarding phases to external profilers (VTune, NSight),
+ * this class can record a timeline of the phases executed by each thread.
+ * When enabled via \ref set_trace_enabled(), every \ref ScopedPhase appends
+ * a begin/end timestamp pair to a per-thread ring buffer, which only costs a
+ * few nanoseconds and requires no synchronization. The recording can then be
+ * serialized into the JSON format understood by <tt>chrome://tracing</tt>
+ * and <tt>https://ui.perfetto.dev</tt>, which visualizes per-thread stalls
+ * and scheduling gaps that a flat phase histogram cannot reveal.
+ */
 class MI_EXPORT_LIB Profiler {
 public:
+    /// Start or stop timeline recording
+    static void set_trace_enabled(bool value);
+
+    /// Check whether timeline recording is active
+    static bool trace_enabled();
+
+    /// Discard all recorded timeline events
+    static void clear_trace();
+
+    /// Serialize the recorded timeline into chrome://tracing JSON
+    static std::string trace_json();
+
+    /// Write the recorded timeline to a chrome://tracing JSON file
+    static void write_trace(const fs::path &filename);
+
     static void static_initialization();
     static void static_shutdown();
 };
@@ -2,6 +2,10 @@
 
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/object.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -11,6 +15,14 @@ NAMESPACE_BEGIN(mitsuba)
  * This class is used to track the progress of various operations that might
  * take longer than a second or so. It provides interactive feedback when
  * Mitsuba is run on the console, via the OpenGL GUI, or in Jupyter Notebook.
+ *
+ * Two usage modes are supported: either the party performing the work calls
+ * \ref update() directly, in which case it also pays for the formatting and
+ * log I/O, or it calls \ref start_async() once and then reports finished
+ * work units via \ref advance(). The latter costs a single relaxed atomic
+ * addition per call regardless of the number of worker threads; a
+ * timer-driven thread owned by the reporter performs all formatting and I/O.
+ * The two modes should not be mixed.
  */
 class MI_EXPORT_LIB ProgressReporter : public Object {
 public:
@@ -26,10 +38,39 @@ public:
     /// Update the progress to \c progress (which should be in the range [0, 1])
     void update(float progress);
 
+    /**
+     * \brief Launch a thread that refreshes the progress display at regular
+     * intervals
+     *
+     * Worker threads subsequently record completed work via \ref advance().
+     *
+     * \param total_work
+     *     The number of work units that corresponds to 100% progress
+     * \param interval_ms
+     *     Interval (in milliseconds) between display refreshes
+     */
+    void start_async(size_t total_work, size_t interval_ms = 500);
+
+    /// Atomically record \c amount completed units of work
+    void advance(size_t amount = 1) {
+        m_work_done.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Stop the thread started by \ref start_async() after a final
+     * progress refresh
+     *
+     * This function is idempotent and also invoked by the destructor.
+     */
+    void finish();
+
     MI_DECLARE_CLASS()
 protected:
     ~ProgressReporter();
 
+    /// Format the progress line and forward it to the given logger
+    void refresh(float progress, Logger *logger);
+
 protected:
     Timer m_timer;
     std::string m_label;
@@ -39,6 +80,14 @@ protected:
     size_t m_last_update;
     float m_last_progress;
     void *m_payload;
+
+    /* Asynchronous reporting (see \ref start_async()) */
+    std::atomic<size_t> m_work_done { 0 };
+    size_t m_total_work = 0;
+    std::thread m_refresh_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stop = false;
 };
 
 NAMESPACE_END(mitsuba)
@@ -5,10 +5,24 @@
 #include <mitsuba/core/simd.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
+#include <array>
 #include <memory>
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Tileable 256x256 forced-random dither matrix
+ *
+ * The matrix contains a permutation of the integers <tt>0, .., 65535</tt>
+ * rescaled to the interval <tt>[-0.5, 0.5)</tt> and arranged so that its
+ * thresholds have a blue-noise spectral distribution (Purgathofer et al.,
+ * ICIP 1994). It is used to dither floating point images down to quantized
+ * integer representations and to spatially dither sample sequences across
+ * the image plane (see the \c blue_noise sampler parameter). Entry
+ * <tt>(x, y)</tt> is stored at index <tt>y * 256 + x</tt>.
+ */
+extern MI_EXPORT_LIB const float dither_matrix256[65536];
+
 /**
  * \brief Efficient implementation of a radical inverse function with prime
  * bases including scrambled versions.
@@ -184,56 +198,128 @@ private:
 };
 
 
-/// Van der Corput radical inverse in base 2
-template <typename UInt, typename Float = dr::float_array_t<UInt>>
-Float radical_inverse_2(UInt index, UInt scramble = 0) {
-    if constexpr (std::is_same_v<dr::scalar_t<Float>, double>) {
+/// Reverse the bits of a 32- or 64-bit unsigned integer
+template <typename UInt> UInt reverse_bits(UInt index) {
+    if constexpr (sizeof(dr::scalar_t<UInt>) == 8) {
         index = (index << 32) | (index >> 32);
         index = ((index & 0x0000ffff0000ffffULL) << 16) | ((index & 0xffff0000ffff0000ULL) >> 16);
         index = ((index & 0x00ff00ff00ff00ffULL) << 8)  | ((index & 0xff00ff00ff00ff00ULL) >> 8);
         index = ((index & 0x0f0f0f0f0f0f0f0fULL) << 4)  | ((index & 0xf0f0f0f0f0f0f0f0ULL) >> 4);
         index = ((index & 0x3333333333333333ULL) << 2)  | ((index & 0xccccccccccccccccULL) >> 2);
         index = ((index & 0x5555555555555555ULL) << 1)  | ((index & 0xaaaaaaaaaaaaaaaaULL) >> 1);
-
-        /* Generate an uniformly distributed double precision number in [1,2)
-         * from the scrambled index and subtract 1. */
-        return dr::reinterpret_array<Float>(dr::sr<12>(index ^ scramble) | 0x3ff0000000000000ull) - 1.0;
     } else {
         index = (index << 16) | (index >> 16);
         index = ((index & 0x00ff00ff) << 8) | ((index & 0xff00ff00) >> 8);
         index = ((index & 0x0f0f0f0f) << 4) | ((index & 0xf0f0f0f0) >> 4);
         index = ((index & 0x33333333) << 2) | ((index & 0xcccccccc) >> 2);
         index = ((index & 0x55555555) << 1) | ((index & 0xaaaaaaaa) >> 1);
+    }
+    return index;
+}
 
+/// Van der Corput radical inverse in base 2
+template <typename UInt, typename Float = dr::float_array_t<UInt>>
+Float radical_inverse_2(UInt index, UInt scramble = 0) {
+    index = reverse_bits(index);
+
+    if constexpr (std::is_same_v<dr::scalar_t<Float>, double>) {
+        /* Generate an uniformly distributed double precision number in [1,2)
+         * from the scrambled index and subtract 1. */
+        return dr::reinterpret_array<Float>(dr::sr<12>(index ^ scramble) | 0x3ff0000000000000ull) - 1.0;
+    } else {
         /* Generate an uniformly distributed single precision number in [1,2)
          * from the scrambled index and subtract 1. */
         return dr::reinterpret_array<Float>(dr::sr<9>(index ^ scramble) | 0x3f800000u) - 1.f;
     }
 }
 
+/**
+ * \brief Hash-based Owen scrambling of a base-2 sample value
+ *
+ * This function applies a random nested uniform digit permutation (i.e. an
+ * Owen scramble) to the bits of \c x, using the hash construction of Laine
+ * and Karras, "Stratified Sampling for Stochastic Transparency" (EGSR 2011)
+ * with the improved hash constants proposed by Burley, "Practical
+ * Hash-based Owen Scrambling" (JCGT 2020).
+ *
+ * The input is interpreted as a fixed-point sample value with the most
+ * significant digit first; applying the function to a sample index instead
+ * yields an Owen shuffle of the sequence order.
+ */
+template <typename UInt32> UInt32 nested_uniform_scramble(UInt32 x, UInt32 seed) {
+    x = reverse_bits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverse_bits(x);
+}
+
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Direction numbers of the second dimension of the Sobol' sequence
+ *
+ * Entry \c i stores the direction number that is XORed into the result when
+ * bit \c i of the sample index is set. The values follow the recurrence
+ * <tt>v ^= v >> 1</tt> and only depend on the bit position, hence the whole
+ * table can be precomputed at compile time.
+ */
+template <typename T, size_t N>
+constexpr std::array<T, N> sobol_2_directions(T v) {
+    std::array<T, N> result {};
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = v;
+        v ^= v >> 1;
+    }
+    return result;
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Raw sample bits of the second dimension of the Sobol' sequence
+ *
+ * Table-driven evaluation: XOR together the direction numbers of every set
+ * index bit. In contrast to the classic formulation, which shifts the index
+ * until it reaches zero, this involves neither a data-dependent loop nor a
+ * recorded loop in JIT modes. In the 32-bit case, the result is a
+ * fixed-point sample value with the most significant digit first; the
+ * 64-bit variant positions the digits for the mantissa trick used by
+ * \ref sobol_2().
+ */
+template <typename UInt> UInt sobol_2_bits(UInt index) {
+    using Scalar = dr::scalar_t<UInt>;
+    UInt result(0);
+
+    if constexpr (sizeof(Scalar) == 8) {
+        constexpr auto dirs =
+            detail::sobol_2_directions<uint64_t, 64>(1ull << 52);
+        for (size_t i = 0; i < dirs.size(); ++i)
+            result ^= dr::select(dr::neq(index & (Scalar(1) << i), Scalar(0)),
+                                 UInt(dirs[i]), UInt(0));
+    } else {
+        constexpr auto dirs =
+            detail::sobol_2_directions<uint32_t, 32>(1u << 31);
+        for (size_t i = 0; i < dirs.size(); ++i)
+            result ^= dr::select(dr::neq(index & (Scalar(1) << i), Scalar(0)),
+                                 UInt(dirs[i]), UInt(0));
+    }
+
+    return result;
+}
 
 /// Sobol' radical inverse in base 2
 template <typename UInt, typename Float = dr::float_array_t<UInt>>
 Float sobol_2(UInt index, UInt scramble = 0) {
-    if constexpr (std::is_same_v<dr::scalar_t<Float>, double>) {
-        UInt v = 1ULL << 52;
-        dr::Loop<dr::mask_t<UInt>> loop("sobol_2", v, scramble, index);
-        while(loop(dr::neq(index, 0U))) {
-            dr::masked(scramble, dr::eq(index & 1U, 1U)) ^= v;
-            index >>= 1;
-            v ^= v >> 1;
-        }
+    scramble ^= sobol_2_bits(index);
+
+    if constexpr (std::is_same_v<dr::scalar_t<Float>, double>)
         return dr::reinterpret_array<Float>(dr::sr<12>(scramble) | 0x3ff0000000000000ull) - 1.0;
-    } else {
-        UInt v = 1U << 31;
-        dr::Loop<dr::mask_t<UInt>> loop("sobol_2", v, scramble, index);
-        while(loop(dr::neq(index, 0U))) {
-            dr::masked(scramble, dr::eq(index & 1U, 1U)) ^= v;
-            index >>= 1;
-            v ^= v >> 1;
-        }
+    else
         return Float(scramble) / Float(1ULL << 32);
-    }
 }
 
 NAMESPACE_END(mitsuba)
@@ -291,6 +291,49 @@ template <typename Scalar_> struct Resampler {
         (this->*f)(source, source_stride, target, target_stride, channels);
     }
 
+    /**
+     * \brief Produce a single output scanline of a resampling operation
+     * along the orthogonal (vertical) axis
+     *
+     * For the vertical pass of a separable image resampling operation, it is
+     * considerably faster to compute one output row at a time: each filter
+     * tap then accumulates a contiguous span of the source image that the
+     * compiler can vectorize, rather than gathering samples with a stride of
+     * one scanline each, as would happen when invoking \ref resample() once
+     * per column.
+     *
+     * \param i
+     *     Index of the output scanline (in <tt>[0, target_res)</tt>)
+     * \param source
+     *     Pointer to the beginning of the source image
+     * \param target
+     *     Pointer to the beginning of output scanline \c i
+     * \param elements
+     *     Number of samples per scanline (i.e. width times channel count)
+     */
+    void resample_row(uint32_t i, const Scalar *source, Scalar *target,
+                      uint32_t elements) const {
+        using ResampleRowFunctor =
+            void (Resampler::*)(uint32_t, const Scalar *, Scalar *, uint32_t) const;
+
+        ResampleRowFunctor f;
+
+        if (m_clamp != std::make_pair(-std::numeric_limits<Scalar>::infinity(),
+                                       std::numeric_limits<Scalar>::infinity())) {
+            if (m_start)
+                f = &Resampler::resample_row_internal<true /* Clamp */, true /* Resample */>;
+            else
+                f = &Resampler::resample_row_internal<true /* Clamp */, false /* Resample */>;
+        } else {
+            if (m_start)
+                f = &Resampler::resample_row_internal<false /* Clamp */, true /* Resample */>;
+            else
+                f = &Resampler::resample_row_internal<false /* Clamp */, false /* Resample */>;
+        }
+
+        (this->*f)(i, source, target, elements);
+    }
+
 
     /// Return a human-readable summary
     std::string to_string() const {
@@ -374,6 +417,61 @@ private:
         }
     }
 
+    template <bool Clamp, bool Resample>
+    void resample_row_internal(uint32_t i, const Scalar *source, Scalar *target,
+                               uint32_t elements) const {
+        const uint32_t taps = m_taps, half_taps = m_taps / 2;
+        const Scalar *weights =
+            Resample ? m_weights.get() + (size_t) i * taps : m_weights.get();
+        const int32_t offset =
+            Resample ? m_start[i] : ((int32_t) i - (int32_t) half_taps);
+        const Scalar min = std::get<0>(m_clamp);
+        const Scalar max = std::get<1>(m_clamp);
+
+        for (uint32_t c = 0; c < elements; ++c)
+            target[c] = Scalar(0);
+
+        for (uint32_t j = 0; j < taps; ++j) {
+            const Scalar weight = weights[j];
+            int32_t pos = offset + (int32_t) j;
+
+            if (unlikely(pos < 0 || pos >= (int32_t) m_source_res)) {
+                switch (m_bc) {
+                    case FilterBoundaryCondition::Clamp:
+                        pos = dr::clamp(pos, 0, (int32_t) m_source_res - 1);
+                        break;
+
+                    case FilterBoundaryCondition::Repeat:
+                        pos = math::modulo(pos, (int32_t) m_source_res);
+                        break;
+
+                    case FilterBoundaryCondition::Mirror:
+                        pos = math::modulo(pos, 2 * (int32_t) m_source_res - 2);
+                        if (pos >= (int32_t) m_source_res - 1)
+                            pos = 2 * m_source_res - 2 - pos;
+                        break;
+
+                    case FilterBoundaryCondition::One:
+                        for (uint32_t c = 0; c < elements; ++c)
+                            target[c] += weight;
+                        continue;
+
+                    case FilterBoundaryCondition::Zero:
+                        continue;
+                }
+            }
+
+            const Scalar *row = source + (size_t) pos * elements;
+            for (uint32_t c = 0; c < elements; ++c)
+                target[c] += row[c] * weight;
+        }
+
+        if (Clamp) {
+            for (uint32_t c = 0; c < elements; ++c)
+                target[c] = dr::template clamp<Scalar>(target[c], min, max);
+        }
+    }
+
     Scalar lookup(const Scalar *source, int32_t pos, uint32_t stride, uint32_t ch) const {
         if (unlikely(pos < 0 || pos >= (int32_t) m_source_res)) {
             switch (m_bc) {
@@ -299,6 +299,141 @@ Value eval_1d(const Float *nodes, const Float *values,
         return eval_spline(f0, f1, d0, d1, t);
 }
 
+/**
+ * \brief Evaluate a cubic spline interpolant of a \a uniformly sampled 1D
+ * function at multiple positions at once
+ *
+ * This is a batch variant of \ref eval_1d() that factors out quantities shared
+ * by all queries (node spacing, bounds checks of the underlying array). It is
+ * mainly useful in scalar variants, where per-query calls to \ref eval_1d()
+ * from spectral upsampling and reconstruction filter code otherwise dominate
+ * the profile.
+ *
+ * \tparam Extrapolate
+ *      Extrapolate values when an entry of \c x is out of range?
+ *      (default: \c false)
+ * \param min
+ *      Position of the first node
+ * \param max
+ *      Position of the last node
+ * \param values
+ *      Array containing \c size regularly spaced evaluations in the range [\c
+ *      min, \c max] of the approximated function.
+ * \param size
+ *      Denotes the size of the \c values array
+ * \param x
+ *      Array of \c count evaluation points
+ * \param count
+ *      Denotes the size of the \c x and \c out arrays
+ * \param[out] out
+ *      Array receiving the \c count interpolated values
+ */
+template <bool Extrapolate = false, typename Value, typename Float>
+void eval_1d_batch(Float min, Float max, const Float *values, uint32_t size,
+                   const Value *x, uint32_t count, Value *out) {
+    using Mask = dr::mask_t<Value>;
+    using Index = dr::uint32_array_t<Value>;
+
+    const Float scale = Float(size - 1) / (max - min);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Mask mask_valid = (x[i] >= min) && (x[i] <= max);
+
+        /* Transform 'x' so that nodes lie at integer positions */
+        Value t = (x[i] - min) * scale;
+
+        /* Find the index of the left node in the queried subinterval */
+        Index idx = dr::maximum(Index(0), dr::minimum(Index(t), Index(size - 2)));
+
+        GET_SPLINE_UNIFORM(idx);
+
+        /* Compute the relative position within the interval */
+        t -= idx;
+
+        if (!Extrapolate)
+            out[i] = dr::select(mask_valid, eval_spline(f0, f1, d0, d1, t),
+                                dr::zeros<Value>());
+        else
+            out[i] = eval_spline(f0, f1, d0, d1, t);
+    }
+}
+
+/**
+ * \brief Evaluate a cubic spline interpolant of a \a non-uniformly sampled 1D
+ * function at multiple positions at once
+ *
+ * Batch variant of the non-uniform \ref eval_1d(). In scalar variants, the
+ * data-dependent binary search over \c nodes is replaced by a warm-started
+ * linear scan from the interval of the previous query, which is a large win
+ * when the evaluation points arrive in (approximately) sorted order -- e.g.
+ * wavelength sweeps over irregular spectra.
+ *
+ * \tparam Extrapolate
+ *      Extrapolate values when an entry of \c x is out of range?
+ *      (default: \c false)
+ * \param nodes
+ *      Array containing \c size non-uniformly spaced values denoting positions
+ *      the where the function to be interpolated was evaluated. They must be
+ *      provided in \a increasing order.
+ * \param values
+ *      Array containing function evaluations matched to the entries of \c
+ *      nodes.
+ * \param size
+ *      Denotes the size of the \c nodes and \c values array
+ * \param x
+ *      Array of \c count evaluation points
+ * \param count
+ *      Denotes the size of the \c x and \c out arrays
+ * \param[out] out
+ *      Array receiving the \c count interpolated values
+ * \param hint
+ *      Optional pointer to an interval index that seeds the search of the
+ *      first query and receives the interval of the last one, allowing the
+ *      warm start to persist across consecutive batches. Only used in scalar
+ *      variants.
+ */
+template <bool Extrapolate = false, typename Value, typename Float>
+void eval_1d_batch(const Float *nodes, const Float *values, uint32_t size,
+                   const Value *x, uint32_t count, Value *out,
+                   uint32_t *hint = nullptr) {
+    using Mask = dr::mask_t<Value>;
+    using Index = dr::uint32_array_t<Value>;
+
+    uint32_t last = hint ? dr::minimum(*hint, size - 2) : 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Mask mask_valid = (x[i] >= nodes[0]) && (x[i] <= nodes[size - 1]);
+
+        Index idx;
+        if constexpr (!dr::is_array_v<Value>) {
+            /* Warm-started linear scan from the previous query's interval */
+            idx = last;
+            while (idx > 0 && x[i] < nodes[idx])
+                --idx;
+            while (idx + 2 < size && x[i] >= nodes[idx + 1])
+                ++idx;
+            last = idx;
+        } else {
+            idx = math::find_interval<Index>(size,
+                [&](Index idx_) {
+                    return dr::gather<Value>(nodes, idx_, mask_valid) <= x[i];
+                }
+            );
+        }
+
+        GET_SPLINE_NONUNIFORM(idx);
+
+        /* Compute the relative position within the interval */
+        Value t = (x[i] - x0) / width;
+
+        if (!Extrapolate)
+            out[i] = dr::select(mask_valid, eval_spline(f0, f1, d0, d1, t),
+                                dr::zeros<Value>());
+        else
+            out[i] = eval_spline(f0, f1, d0, d1, t);
+    }
+}
+
 /**
  * \brief Computes a prefix sum of integrals over segments of a \a uniformly
  * sampled 1D Catmull-Rom spline interpolant
@@ -836,6 +971,66 @@ std::pair<Mask, Int32> eval_spline_weights(Float min, Float max, uint32_t size,
         return std::make_pair(Mask(true), offset);
 }
 
+/**
+ * \brief Evaluate multiple cubic spline interpolants sharing a \a uniform node
+ * layout at a single position
+ *
+ * The interval search and interpolation weights are computed once and applied
+ * to \c spline_count value arrays stored contiguously (one after another) in
+ * \c values. This is the access pattern of spectral upsampling code, which
+ * evaluates many per-pixel splines at a common wavelength.
+ *
+ * \tparam Extrapolate
+ *      Extrapolate values when \c x is out of range? (default: \c false)
+ * \param min
+ *      Position of the first node
+ * \param max
+ *      Position of the last node
+ * \param values
+ *      Array containing <tt>spline_count * size</tt> entries: the
+ *      concatenation of \c spline_count uniformly sampled functions with
+ *      \c size evaluations each
+ * \param size
+ *      Denotes the number of nodes of each spline
+ * \param spline_count
+ *      Denotes the number of splines stored in \c values
+ * \param x
+ *      Evaluation point
+ * \param[out] out
+ *      Array receiving the \c spline_count interpolated values
+ */
+template <bool Extrapolate = false, typename Value, typename Float>
+void eval_1d_multi(Float min, Float max, const Float *values, uint32_t size,
+                   uint32_t spline_count, Value x, Value *out) {
+    using Index = dr::uint32_array_t<Value>;
+
+    /* Compute the four interpolation weights once for all splines */
+    Value weights[4];
+    auto [mask_valid, offset] =
+        eval_spline_weights<Extrapolate>(min, max, size, x, weights);
+
+    if (unlikely(dr::none(mask_valid))) {
+        for (uint32_t s = 0; s < spline_count; ++s)
+            out[s] = dr::zeros<Value>();
+        return;
+    }
+
+    Index idx = Index(offset + 1);
+    dr::mask_t<Value> mask_low_idx = idx > 0,
+                      mask_up_idx  = idx + 2 < size;
+
+    for (uint32_t s = 0; s < spline_count; ++s) {
+        const Float *v = values + s * (size_t) size;
+
+        Value result = weights[1] * dr::gather<Value>(v, idx) +
+                       weights[2] * dr::gather<Value>(v, idx + 1);
+        result += weights[0] * dr::gather<Value>(v, idx - 1, mask_low_idx);
+        result += weights[3] * dr::gather<Value>(v, idx + 2, mask_up_idx);
+
+        out[s] = dr::select(mask_valid, result, dr::zeros<Value>());
+    }
+}
+
 /**
  * \brief Compute weights to perform a spline-interpolated lookup on a
  * \a non-uniformly sampled 1D function.
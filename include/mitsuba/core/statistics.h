@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mitsuba/core/platform.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * The functions in this namespace implement a lightweight registry of event
+ * counters that are accumulated while a scene is being rendered. They
+ * complement the phase histogram in <tt>mitsuba/core/profiler.h</tt>, which
+ * reports where time is spent but not how often an operation ran: the
+ * counters below make it possible to compute derived quantities such as rays
+ * per second or next event estimation efficiency for a particular scene.
+ *
+ * Counters are stored in per-thread blocks and incremented with relaxed
+ * memory ordering, so the overhead of an increment is a handful of cycles.
+ * The registry is cleared when \ref Integrator::render() starts and
+ * aggregated across threads when the counters are queried; a summary is
+ * logged at \c Info level once rendering finishes and can be retrieved from
+ * Python via <tt>mitsuba.util.render_statistics()</tt>.
+ *
+ * In JIT-compiled variants, counters are recorded while tracing: each
+ * increment accounts for the number of lanes of the traced operation. The
+ * reported values hence refer to the generated program rather than to the
+ * (potentially masked) lanes that execute at runtime.
+ */
+NAMESPACE_BEGIN(render_stats)
+
+/// List of event counters tracked by the registry
+enum class Counter : int {
+    RaysTraced = 0,           /* Scene::ray_intersect() */
+    ShadowRaysTraced,         /* Scene::ray_test() */
+    EmitterSamples,           /* Scene::sample_emitter_direction() */
+    EmitterRaySamples,        /* Scene::sample_emitter_ray() */
+    BSDFSamples,              /* BSDF::sample() */
+    BSDFEvaluations,          /* BSDF::eval() and BSDF::pdf() */
+    PhaseFunctionSamples,     /* PhaseFunction::sample() */
+    PhaseFunctionEvaluations, /* PhaseFunction::eval() and PhaseFunction::pdf() */
+
+    CounterCount
+};
+
+constexpr const char *counter_id[int(Counter::CounterCount)] = {
+    "Rays traced",
+    "Shadow rays traced",
+    "Emitter samples",
+    "Emitter rays sampled",
+    "BSDF samples",
+    "BSDF evaluations",
+    "Phase function samples",
+    "Phase function evaluations"
+};
+
+/// Add \c amount to the given counter of the calling thread
+extern MI_EXPORT_LIB void increment(Counter counter, uint64_t amount = 1);
+
+/// Reset all counters to zero (invoked at the start of a render job)
+extern MI_EXPORT_LIB void clear();
+
+/// Return the value of a counter, aggregated over all threads
+extern MI_EXPORT_LIB uint64_t value(Counter counter);
+
+/// Return all counters as (name, value) pairs, aggregated over all threads
+extern MI_EXPORT_LIB std::vector<std::pair<std::string, uint64_t>> counters();
+
+/// Render the recorded counters into a human-readable report
+extern MI_EXPORT_LIB std::string report();
+
+NAMESPACE_END(render_stats)
+NAMESPACE_END(mitsuba)
@@ -298,10 +298,18 @@ template <typename T, typename SFINAE> struct serialization_helper {
         if (likely(!swap)) {
             s.write(value, sizeof(T) * count);
         } else {
-            std::unique_ptr<T[]> v(new T[count]);
-            for (size_t i = 0; i < count; ++i)
-                v[i] = detail::swap(value[i]);
-            s.write(v.get(), sizeof(T) * count);
+            /* Convert the endianness in cache-friendly chunks rather than
+               allocating a temporary the size of the full array */
+            constexpr size_t chunk = std::max<size_t>(65536 / sizeof(T), 1);
+            std::unique_ptr<T[]> v(new T[std::min(count, chunk)]);
+            while (count > 0) {
+                size_t n = std::min(count, chunk);
+                for (size_t i = 0; i < n; ++i)
+                    v[i] = detail::swap(value[i]);
+                s.write(v.get(), sizeof(T) * n);
+                value += n;
+                count -= n;
+            }
         }
     }
 
@@ -428,6 +428,19 @@ protected:
     bool load(const uint8_t *src, const Struct::Field &f, Value &value) const;
     void linearize(Value &value) const;
     void save(uint8_t *dst, const Struct::Field &f, Value value, size_t x, size_t y) const;
+
+    /**
+     * \brief Attempt a vectorized bulk conversion
+     *
+     * Handles the common case where source and target are homogeneous
+     * structures whose fields correspond one-to-one without blending,
+     * weights, alpha handling, or dithering, so that the input degenerates
+     * into one flat array with a single element-wise transformation (e.g.
+     * double-valued PLY vertex data read into float mesh buffers, or
+     * normalized/gamma-corrected 8-bit pixels expanded to linear floats).
+     * Returns \c false when the conversion is not expressible this way.
+     */
+    bool convert_fast(size_t count, const uint8_t *src, uint8_t *dest) const;
 #endif
 
 protected:
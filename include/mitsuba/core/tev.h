@@ -0,0 +1,71 @@
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Client for the IPC protocol of the *tev* image viewer
+ *
+ * This class streams in-progress renders to a running instance of the *tev*
+ * image viewer (https://github.com/Tom94/tev) over a TCP socket. Packets are
+ * assembled on the calling thread and handed off to a background thread that
+ * performs the actual socket I/O, hence callers (e.g. rendering worker
+ * threads) never block on the network.
+ *
+ * If the viewer disappears mid-render or the connection fails, the client
+ * logs a single warning and silently discards subsequent updates---a lost
+ * preview must never abort a render.
+ */
+class MI_EXPORT_LIB TevClient : public Object {
+public:
+    /// Connect to a running *tev* instance
+    TevClient(const std::string &hostname = "localhost",
+              uint16_t port = 14158);
+
+    /// Create (or reset) an image with the given channel layout in the viewer
+    void create_image(const std::string &name, uint32_t width, uint32_t height,
+                      const std::vector<std::string> &channels);
+
+    /**
+     * \brief Update a rectangular region of a previously created image
+     *
+     * This method only enqueues the update and returns immediately; the
+     * transfer happens asynchronously on the internal I/O thread.
+     *
+     * \param data
+     *     Interleaved pixel data holding <tt>width * height *
+     *     channels.size()</tt> floats. The contents are copied, ownership
+     *     remains with the caller.
+     */
+    void update_image(const std::string &name, uint32_t x, uint32_t y,
+                      uint32_t width, uint32_t height,
+                      const std::vector<std::string> &channels,
+                      const float *data);
+
+    /// Close an image in the viewer
+    void close_image(const std::string &name);
+
+    /// Return whether the connection is (still) usable
+    bool connected() const;
+
+    /// Return a string representation
+    std::string to_string() const override;
+
+    MI_DECLARE_CLASS()
+protected:
+    /// Flush pending packets and disconnect
+    virtual ~TevClient();
+
+private:
+    /// Hand a fully assembled packet to the I/O thread
+    void enqueue(std::vector<uint8_t> &&packet);
+
+    struct TevClientPrivate;
+    std::unique_ptr<TevClientPrivate> d;
+};
+
+NAMESPACE_END(mitsuba)
@@ -153,6 +153,18 @@ public:
     /// Unregister a thread (e.g. Dr.Jit, Python) from Mitsuba's thread system.
     static bool unregister_external_thread();
 
+    /**
+     * \brief Pin the calling thread to a processor core
+     *
+     * Cores are handed out round-robin from a NUMA-interleaved enumeration of
+     * the machine's processors, so that successive callers spread evenly
+     * across its NUMA nodes. A thread is pinned at most once; subsequent
+     * calls from the same thread are no-ops. On platforms without topology
+     * information, cores are simply assigned in index order, and on macOS
+     * (which lacks an affinity API) the function does nothing.
+     */
+    static void pin_worker_core();
+
     /// Register nanothread Task to prevent internal resources leakage
     static void register_task(Task *task);
 
@@ -184,17 +196,25 @@ private:
 /**
  * \brief Captures a thread environment (logger and file resolver).
  * Used with \ref ScopedSetThreadEnvironment
+ *
+ * When \c pin_workers is specified, every thread that subsequently enters
+ * the environment additionally pins itself to a processor core via \ref
+ * Thread::pin_worker_core(). On multi-socket machines, this keeps pool
+ * workers resident on a fixed NUMA node, so that memory they allocate and
+ * first touch (e.g. per-worker image blocks) remains node-local for the
+ * duration of a render.
  */
 class MI_EXPORT_LIB ThreadEnvironment {
     friend class ScopedSetThreadEnvironment;
 public:
-    ThreadEnvironment();
+    ThreadEnvironment(bool pin_workers = false);
     ~ThreadEnvironment() = default;
     ThreadEnvironment(const ThreadEnvironment &) = default;
     ThreadEnvironment& operator=(const ThreadEnvironment &) = default;
 private:
     ref<Logger> m_logger;
     ref<FileResolver> m_file_resolver;
+    bool m_pin_workers;
 };
 
 /// RAII-style class to temporarily switch to another thread's logger/file resolver
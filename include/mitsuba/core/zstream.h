@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mitsuba/core/stream.h>
+#include <vector>
 
 extern "C" {
     struct z_stream_s;
@@ -12,6 +13,10 @@ NAMESPACE_BEGIN(mitsuba)
 NAMESPACE_BEGIN(detail)
 /// Buffer size used to communicate with zlib. The larger, the better.
 constexpr size_t kZStreamBufferSize = 32768;
+/// Amount of input compressed into each independent block (\ref EBlockStream)
+constexpr size_t kZStreamBlockSize = 1 << 20;
+/// Magic number identifying the framed block format ('MIZ1')
+constexpr uint32_t kZStreamBlockMagic = 0x315a494d;
 NAMESPACE_END(detail)
 
 /**
@@ -19,13 +24,27 @@ NAMESPACE_END(detail)
  *
  * This class transparently decompresses and compresses reads and writes
  * to a nested stream, respectively.
+ *
+ * In addition to ordinary (inherently sequential) deflate and gzip streams,
+ * the class supports a framed mode (\ref EBlockStream) in which the input is
+ * carved into independently compressed blocks. Such streams decompress in
+ * parallel across the worker threads, which is useful for bulk payloads like
+ * serialized mesh geometry. The format is identified by a magic number, and
+ * streams opened for reading in \ref EDeflateStream mode switch over
+ * automatically, so existing raw deflate files continue to load.
  */
 class MI_EXPORT_LIB ZStream : public Stream {
 public:
 
     enum EStreamType {
         EDeflateStream, /// A raw deflate stream
-        EGZipStream /// A gzip-compatible stream
+        EGZipStream, /// A gzip-compatible stream
+        /**
+         * A framed sequence of independently deflated blocks supporting
+         * parallel decompression (detected automatically when reading in
+         * \ref EDeflateStream mode)
+         */
+        EBlockStream
     };
 
     using Stream::read;
@@ -126,12 +145,27 @@ protected:
     /// Protected destructor
     virtual ~ZStream();
 
+private:
+    /// Compress and emit the pending block of a \ref EBlockStream
+    void write_block();
+
+    /// Read and decompress all blocks of a \ref EBlockStream in parallel
+    void read_blocks();
+
 private:
     ref<Stream> m_child_stream;
     std::unique_ptr<z_stream> m_deflate_stream, m_inflate_stream;
     uint8_t m_deflate_buffer[detail::kZStreamBufferSize];
     uint8_t m_inflate_buffer[detail::kZStreamBufferSize];
     bool m_did_write;
+
+    // Framed block mode (see EBlockStream)
+    EStreamType m_stream_type;
+    int m_level;
+    std::vector<uint8_t> m_block_input;
+    std::unique_ptr<uint8_t[]> m_block_output;
+    size_t m_block_output_size = 0, m_block_output_pos = 0;
+    bool m_wrote_block_magic = false;
 };
 
 NAMESPACE_END(mitsuba)
@@ -1258,6 +1258,28 @@ static const char *__doc_mitsuba_Bitmap_has_alpha = R"doc(Return whether this im
 
 static const char *__doc_mitsuba_Bitmap_height = R"doc(Return the bitmap's height in pixels)doc";
 
+static const char *__doc_mitsuba_Bitmap_load_shared =
+R"doc(Load a bitmap from a file via a named shared-memory segment
+
+The decoded image is placed in a shared-memory segment keyed by a hash
+of the file contents (see MemoryMappedFile::create_or_attach_shared),
+so that multiple renderer processes on the same machine loading the
+same assets keep a single resident copy of the pixel data. The first
+process decodes and publishes the image; subsequent ones attach
+without allocating further memory.
+
+The returned bitmap aliases the segment, which remains mapped for the
+rest of the process lifetime, and must be treated as read-only. Images
+with an arbitrary channel layout (PixelFormat::MultiChannel) are not
+shareable, and the function falls back to a regular private load when
+sharing is not possible.
+
+Parameter ``path``:
+    Name of the file to be loaded
+
+Parameter ``format``:
+    File format to be read (PNG/EXR/Auto-detect ...))doc";
+
 static const char *__doc_mitsuba_Bitmap_m_component_format = R"doc()doc";
 
 static const char *__doc_mitsuba_Bitmap_m_data = R"doc()doc";
@@ -2724,6 +2746,8 @@ static const char *__doc_mitsuba_FileResolver_end_2 = R"doc(Return an iterator a
 
 static const char *__doc_mitsuba_FileResolver_erase = R"doc(Erase the entry at the given iterator position)doc";
 
+static const char *__doc_mitsuba_FileResolver_flush_cache = R"doc(Drop all cached lookups (done automatically when search paths change))doc";
+
 static const char *__doc_mitsuba_FileResolver_erase_2 = R"doc(Erase the search path from the list)doc";
 
 static const char *__doc_mitsuba_FileResolver_m_paths = R"doc()doc";
@@ -2732,6 +2756,15 @@ static const char *__doc_mitsuba_FileResolver_operator_array = R"doc(Return an e
 
 static const char *__doc_mitsuba_FileResolver_operator_array_2 = R"doc(Return an entry from the list of search paths (const))doc";
 
+static const char *__doc_mitsuba_FileResolver_prefetch =
+R"doc(Resolve a batch of paths in parallel and cache the results
+
+Subsequent resolve() calls for these inputs are served from the cache.
+This is useful when loading scenes that reference thousands of files on
+a high-latency (e.g. network) filesystem: the per-file ``stat`` latency
+is overlapped instead of being paid serially by each plugin
+constructor.)doc";
+
 static const char *__doc_mitsuba_FileResolver_prepend = R"doc(Prepend an entry at the beginning of the list of search paths)doc";
 
 static const char *__doc_mitsuba_FileResolver_resolve =
@@ -2858,6 +2891,14 @@ static const char *__doc_mitsuba_Film_class = R"doc()doc";
 
 static const char *__doc_mitsuba_Film_clear = R"doc(Clear the film contents to zero.)doc";
 
+static const char *__doc_mitsuba_Film_clear_region =
+R"doc(Clear a rectangular sub-region of the film storage to zero
+
+The region is specified in crop window coordinates (excluding any
+filter border). This is primarily used by
+SamplingIntegrator::render_region() to discard stale samples before a
+region is re-rendered.)doc";
+
 static const char *__doc_mitsuba_Film_create_block =
 R"doc(Return an ImageBlock instance, whose internal representation is
 compatible with that of the film.
@@ -2883,6 +2924,63 @@ static const char *__doc_mitsuba_Film_crop_size = R"doc(Return the size of the c
 
 static const char *__doc_mitsuba_Film_develop = R"doc(Return a image buffer object storing the developed image)doc";
 
+static const char *__doc_mitsuba_Film_develop_fast =
+R"doc(Differentiation-free variant of develop() for interactive use
+
+In AD-enabled variants, develop() records the weight normalization on
+the differentiable computation graph so that image gradients can
+propagate into the film contents. Interactive viewports that merely
+want preview pixels pay for this bookkeeping on every progressive
+pass. This entry point detaches the film storage before developing it
+and launches the normalization eagerly as a fused kernel;
+implementations may additionally cache constant parts of the
+computation (e.g. gather index tables) across calls.
+
+The default implementation forwards to develop() with gradient
+tracking suspended.)doc";
+
+static const char *__doc_mitsuba_Film_develop_preview =
+R"doc(Develop the film into a display-ready 8-bit sRGB buffer
+
+This is a fused preview path intended for interactive viewports:
+weight normalization, exposure scaling and sRGB gamma encoding are
+performed in a single pass over the frame, writing interleaved RGBA8
+pixels into the caller-provided buffer ``buf``, which must hold
+``width * height * 4`` bytes of the film's crop region. The buffer can
+be reused across frames, avoiding per-frame allocations.
+
+Parameter ``buf``:
+    Destination buffer receiving interleaved RGBA8 pixels
+
+Parameter ``exposure``:
+    Exposure value; pixel values are scaled by ``2^exposure`` prior to
+    gamma encoding (default: 0))doc";
+
+static const char *__doc_mitsuba_Film_develop_region =
+R"doc(Extract a crop region and channel range of the developed image
+
+Returns a (height x width x channels) tensor holding only the
+requested slice of the output of develop(). In JIT variants, the slice
+is expressed as a lazy gather over the existing image storage: nothing
+is copied until the result is evaluated, and only the selected entries
+are ever materialized. This makes it cheap to export a few AOV
+channels from a film with a large channel stack.
+
+Parameter ``offset``:
+    Top-left corner of the region, relative to the crop window
+    (default: (0, 0))
+
+Parameter ``size``:
+    Size of the region in pixels; a zero-valued entry selects the
+    remainder of the image along that axis (default: full image)
+
+Parameter ``channel_offset``:
+    Index of the first channel to extract (default: 0)
+
+Parameter ``channel_count``:
+    Number of channels to extract; zero selects all remaining channels
+    (default: all))doc";
+
 static const char *__doc_mitsuba_Film_flags = R"doc(Flags for all properties combined.)doc";
 
 static const char *__doc_mitsuba_Film_m_crop_offset = R"doc()doc";
@@ -2983,12 +3081,78 @@ static const char *__doc_mitsuba_Film_size =
 R"doc(Ignoring the crop window, return the resolution of the underlying
 sensor)doc";
 
+static const char *__doc_mitsuba_Film_statistics =
+R"doc(Compute per-channel statistics of a region of the developed image
+
+For every channel of the developed image, this method reduces the
+pixels of the given region to their mean, maximum and variance. In JIT
+variants, the reductions run on the device and the result stays there;
+only the scalars that are actually accessed need to be transferred.
+This makes the method suitable for per-pass convergence tests (e.g.
+adaptive stopping criteria) that would otherwise fetch the entire
+image every pass.
+
+Parameter ``offset``:
+    Top-left corner of the region, relative to the crop window
+    (default: (0, 0))
+
+Parameter ``size``:
+    Size of the region in pixels; a zero-valued entry selects the
+    remainder of the image along that axis (default: full image)
+
+Returns:
+    A (channels x 3) tensor whose rows hold (mean, max, variance))doc";
+
 static const char *__doc_mitsuba_Film_to_string = R"doc(//! @})doc";
 
 static const char *__doc_mitsuba_Film_traverse = R"doc()doc";
 
 static const char *__doc_mitsuba_Film_write = R"doc(Write the developed contents of the film to a file on disk)doc";
 
+static const char *__doc_mitsuba_Film_write_async =
+R"doc(Write the developed contents of the film to a file on disk without
+blocking the caller
+
+Equivalent to write(), except that only a snapshot of the film storage
+is taken synchronously; development, format conversion and image
+encoding then run on the global thread pool. This is mainly useful in
+animation batches, where it allows the next frame's render to overlap
+the (potentially slow) encode and I/O of the previous one.
+
+The asynchronous task is registered with the Thread class; call
+Thread.wait_for_tasks() to join all pending writes (e.g. before
+reading the files back or shutting down). Exceptions raised by the
+background write are re-thrown from that call.
+
+The default implementation simply forwards to write() and returns once
+the file has been written.
+
+Parameter ``path``:
+    Target file path on disk)doc";
+
+static const char *__doc_mitsuba_Film_write_streaming =
+R"doc(Write the developed contents of the film to disk in fixed-size
+scanline bands
+
+Equivalent to write(), except that the film storage is developed,
+converted and encoded one horizontal band of scanlines at a time
+instead of materializing the full output image in memory first. For
+very large films (e.g. high-resolution texture bakes), this bounds the
+peak memory overhead of writing to a few rows of pixels on top of the
+film's accumulation buffer.
+
+The default implementation simply forwards to write(); implementations
+(and file formats) without an incremental encoding path behave
+likewise.
+
+Parameter ``path``:
+    Target file path on disk
+
+Parameter ``band_height``:
+    Number of scanlines developed and encoded per band; the default
+    value of zero selects a band height matching the image blocks used
+    during rendering)doc";
+
 static const char *__doc_mitsuba_FilterBoundaryCondition =
 R"doc(When resampling data to a different resolution using
 Resampler::resample(), this enumeration specifies how lookups
@@ -3484,12 +3648,77 @@ Parameter ``values``:
     the result of the read operation for each channel. In Python, the
     function returns these values as a list.)doc";
 
+static const char *__doc_mitsuba_ImageBlock_outlier_clamp = R"doc(Return the outlier clamping threshold (zero when disabled))doc";
+
+static const char *__doc_mitsuba_ImageBlock_reduce_slots =
+R"doc(Sum privatized accumulation slots back into a single image (see
+set_slot_count()))doc";
+
 static const char *__doc_mitsuba_ImageBlock_rfilter = R"doc(Return the image reconstruction filter underlying the ImageBlock)doc";
 
 static const char *__doc_mitsuba_ImageBlock_set_coalesce = R"doc(Try to coalesce reads/writes in JIT modes?)doc";
 
+static const char *__doc_mitsuba_ImageBlock_set_slot_count =
+R"doc(Privatize the accumulation buffer into ``slots`` independent copies
+
+In JIT modes, particle tracing-style methods accumulate all of their
+samples into a single shared image using atomic scatter-additions.
+When many lanes splat into the same set of pixels (e.g. a caustic),
+these atomics serialize and dominate the runtime. With a slot count
+larger than one, the block instead allocates ``slots`` copies of the
+image and routes each lane to the copy given by its index modulo
+``slots``, which reduces contention accordingly. The copies must be
+summed back into a single image by calling reduce_slots() before the
+block's contents can be accessed.
+
+Changing the slot count reallocates and clears the block. The value is
+ignored in scalar modes, where per-thread image blocks already provide
+this type of privatization.)doc";
+
+static const char *__doc_mitsuba_ImageBlock_slot_count =
+R"doc(Return the number of privatized accumulation slots (see
+set_slot_count()))doc";
+
+static const char *__doc_mitsuba_ImageBlock_set_outlier_clamp =
+R"doc(Configure outlier-robust accumulation ("firefly" clamping)
+
+When ``threshold`` is positive, each call to put() computes the
+maximum over the first ``value_channels`` entries of the sample value
+array and, if it exceeds ``threshold``, rescales those entries so that
+the maximum equals ``threshold``. Weight and alpha channels following
+the value channels are left untouched, hence the operation reduces the
+energy of outlier samples without biasing the filter normalization.
+
+The removed energy can optionally be retained in the channel with
+index ``excess_channel`` (e.g. an AOV reserved for this purpose),
+which preserves it for later redistribution or inspection. The
+incoming sample value of that channel is *replaced* by the removed
+energy, so the channel must not carry other data. Pass
+``excess_channel=(uint32_t) -1`` (the default) to simply discard it. A
+``threshold`` of zero (the default) disables clamping altogether.)doc";
+
 static const char *__doc_mitsuba_ImageBlock_set_compensate = R"doc(Use Kahan-style error-compensated floating point accumulation?)doc";
 
+static const char *__doc_mitsuba_ImageBlock_set_half_precision =
+R"doc(Store the image contents in half precision?
+
+When enabled, the block stores its contents as packed IEEE 754 half
+precision values, which halves the memory footprint. The block then
+only serves as a merge target: other (single precision) image blocks
+can be accumulated into it via put_block(), and tensor() transiently
+materializes a single precision copy on demand. Direct sample
+accumulation via put(), as well as read(), clear_region(), and
+slot-privatized or error-compensated accumulation are unsupported in
+this mode.
+
+Toggling the flag reallocates and clears the block. The feature is
+only available in JIT variants and is ignored (with a warning)
+elsewhere.)doc";
+
+static const char *__doc_mitsuba_ImageBlock_half_precision =
+R"doc(Store the image contents in half precision? (see
+set_half_precision()))doc";
+
 static const char *__doc_mitsuba_ImageBlock_set_normalize = R"doc(Re-normalize filter weights in put() and read())doc";
 
 static const char *__doc_mitsuba_ImageBlock_set_offset =
@@ -3838,6 +4067,8 @@ static const char *__doc_mitsuba_Logger_LoggerPrivate = R"doc()doc";
 
 static const char *__doc_mitsuba_Logger_add_appender = R"doc(Add an appender to this logger)doc";
 
+static const char *__doc_mitsuba_Logger_async = R"doc(Is asynchronous log message delivery enabled? (see set_async()))doc";
+
 static const char *__doc_mitsuba_Logger_appender = R"doc(Return one of the appenders)doc";
 
 static const char *__doc_mitsuba_Logger_appender_2 = R"doc(Return one of the appenders)doc";
@@ -3852,6 +4083,8 @@ static const char *__doc_mitsuba_Logger_d = R"doc()doc";
 
 static const char *__doc_mitsuba_Logger_error_level = R"doc(Return the current error level)doc";
 
+static const char *__doc_mitsuba_Logger_flush = R"doc(Block until all queued log messages have reached the appenders)doc";
+
 static const char *__doc_mitsuba_Logger_formatter = R"doc(Return the logger's formatter implementation)doc";
 
 static const char *__doc_mitsuba_Logger_formatter_2 = R"doc(Return the logger's formatter implementation (const))doc";
@@ -3908,6 +4141,21 @@ Throws a runtime exception upon failure)doc";
 
 static const char *__doc_mitsuba_Logger_remove_appender = R"doc(Remove an appender from this logger)doc";
 
+static const char *__doc_mitsuba_Logger_set_async =
+R"doc(Enable or disable asynchronous log message delivery
+
+When enabled, log() merely formats the message on the calling thread
+and deposits the resulting record in a bounded lock-free queue, which a
+dedicated thread drains into the registered appenders. This removes the
+appender mutex from the critical path of worker threads, which
+otherwise serialize on it when verbose (e.g. Debug-level) logging is
+active during rendering. When the queue is full, callers block until
+the drain thread catches up rather than dropping records.
+
+Messages at or above the error level (see set_error_level()) are
+unaffected and continue to raise exceptions on the calling thread.
+Asynchronous delivery is disabled by default.)doc";
+
 static const char *__doc_mitsuba_Logger_set_error_level =
 R"doc(Set the error log level (this level and anything above will throw
 exceptions).
@@ -4188,6 +4436,33 @@ static const char *__doc_mitsuba_MemoryMappedFile_can_write = R"doc(Return wheth
 
 static const char *__doc_mitsuba_MemoryMappedFile_class = R"doc()doc";
 
+static const char *__doc_mitsuba_MemoryMappedFile_create_or_attach_shared =
+R"doc(Create or attach to a named shared-memory segment
+
+Establishes a memory mapping that is shared among all processes on the
+current machine that request a segment with the same name. The first
+caller creates the segment and is responsible for filling it with data
+and then publishing it via mark_shared_ready(). Subsequent callers
+attach to the existing segment and block until the creator has done
+so. This allows e.g. multiple renderer processes on one node to keep a
+single resident copy of large scene assets.
+
+The segment persists after the processes that map it exit; use
+unlink_shared() to remove it from the system.
+
+Parameter ``name``:
+    Name of the segment. Must not contain slashes and should be short
+    (some platforms limit names to ~30 characters).
+
+Parameter ``size``:
+    Size of the segment in bytes. Only used when creating; when
+    attaching, the size is read back from the existing segment.
+
+Parameter ``created``:
+    Optional: set to ``True`` if this call created the segment, and to
+    ``False`` if it attached to an existing one. Attached segments are
+    mapped read-only.)doc";
+
 static const char *__doc_mitsuba_MemoryMappedFile_create_temporary =
 R"doc(Create a temporary memory-mapped file
 
@@ -4205,16 +4480,31 @@ static const char *__doc_mitsuba_MemoryMappedFile_data_2 = R"doc(Return a pointe
 
 static const char *__doc_mitsuba_MemoryMappedFile_filename = R"doc(Return the associated filename)doc";
 
+static const char *__doc_mitsuba_MemoryMappedFile_mark_shared_ready =
+R"doc(Publish a shared-memory segment created via create_or_attach_shared()
+
+Unblocks processes that are waiting to attach to the segment. May only
+be called by the segment's creator, once its contents are complete.)doc";
+
 static const char *__doc_mitsuba_MemoryMappedFile_resize =
 R"doc(Resize the memory-mapped file
 
 This involves remapping the file, which will generally change the
 pointer obtained via data())doc";
 
+static const char *__doc_mitsuba_MemoryMappedFile_shared = R"doc(Return whether this instance refers to a named shared-memory segment)doc";
+
 static const char *__doc_mitsuba_MemoryMappedFile_size = R"doc(Return the size of the mapped region)doc";
 
 static const char *__doc_mitsuba_MemoryMappedFile_to_string = R"doc(Return a string representation)doc";
 
+static const char *__doc_mitsuba_MemoryMappedFile_unlink_shared =
+R"doc(Remove a named shared-memory segment from the system
+
+Existing mappings remain valid until they are released; new attach
+attempts will no longer find the segment. Does nothing if no segment
+with the given name exists.)doc";
+
 static const char *__doc_mitsuba_MemoryStream =
 R"doc(Simple memory buffer-based stream with automatic memory management. It
 always has read & write capabilities.
@@ -4554,6 +4844,21 @@ R"doc(Write the mesh encoded in binary PLY format to a stream
 Parameter ``stream``:
     Target stream that will receive the encoded output)doc";
 
+static const char *__doc_mitsuba_Mesh_write_serialized =
+R"doc(Write the mesh as an uncompressed Serialized (V5) file
+
+Version 5 of the Serialized format stores the vertex and face buffers
+without zlib compression and aligns them to 64-byte file offsets.
+Files produced by this method can be loaded by the ``serialized``
+shape plugin without any decompression or copy: the plugin memory-maps
+the file and references the arrays in place. Vertex positions and
+normals are written in their current (i.e. object-space) form; mesh
+attributes are not supported by the format and are skipped with a
+warning.
+
+Parameter ``filename``:
+    Target file path on disk)doc";
+
 static const char *__doc_mitsuba_MicrofacetDistribution =
 R"doc(Implementation of the Beckman and GGX / Trowbridge-Reitz microfacet
 distributions and various useful sampling routines
@@ -6313,6 +6618,16 @@ the wavefront.)doc";
 
 static const char *__doc_mitsuba_Sampler_seeded = R"doc(Return whether the sampler was seeded)doc";
 
+static const char *__doc_mitsuba_Sampler_set_pixel_position =
+R"doc(Inform the sampler about the image plane position of the pixel (or
+wavefront of pixels) it is about to generate samples for.
+
+This is a no-op unless blue-noise dithered sampling was requested via
+the ``blue_noise`` plugin parameter, in which case the position
+selects the per-pixel toroidal shift from a tileable blue-noise mask.
+Rendering algorithms should invoke this function after seed() and
+before drawing samples.)doc";
+
 static const char *__doc_mitsuba_Sampler_set_sample_count = R"doc(Set the number of samples per pixel)doc";
 
 static const char *__doc_mitsuba_Sampler_set_samples_per_wavefront =
@@ -6498,6 +6813,19 @@ static const char *__doc_mitsuba_Scene_integrator = R"doc(Return the scene's int
 
 static const char *__doc_mitsuba_Scene_integrator_2 = R"doc(Return the scene's integrator)doc";
 
+static const char *__doc_mitsuba_Scene_minimal_ray_flags =
+R"doc(Return the smallest set of ray flags that suffices to shade the
+materials in this scene
+
+RayFlags::All unconditionally includes RayFlags::dPdUV, yet the
+resulting position partials only influence shading when a BSDF depends
+on the tangent frame orientation (BSDFFlags::Anisotropic) or requests
+texture-space differentials (BSDFFlags::NeedsDifferentials). Scenes
+without such materials can skip the partial derivative computation in
+Shape::compute_surface_interaction() entirely. Integrators that only
+use the intersection for shading should pass this value to
+ray_intersect() instead of RayFlags::All.)doc";
+
 static const char *__doc_mitsuba_Scene_m_accel = R"doc(Acceleration data structure (IAS) (type depends on implementation))doc";
 
 static const char *__doc_mitsuba_Scene_m_accel_handle = R"doc(Handle to the IAS used to ensure its lifetime in jit variants)doc";
@@ -6787,6 +7115,37 @@ Returns:
     (equal to the inverse PDF), and the transformed random sample for
     reuse.)doc";
 
+static const char *__doc_mitsuba_Scene_sample_emitter_tree =
+R"doc(Hierarchically sample one emitter proportional to its approximate
+contribution at the reference position ``p``.
+
+This is the light tree counterpart of sample_emitter(): instead of
+picking emitters uniformly, it traverses a binary tree built over the
+emitter bounding boxes and sampling weights, choosing children with
+probability proportional to ``weight / distance^2`` between ``p`` and
+the child cluster. Emitters at infinity (e.g. environment maps) cannot
+be bounded spatially and are instead sampled as a separate group in
+proportion to their sampling weights.
+
+The tree is only available when the scene was loaded with the
+``light_tree`` property set to ``True``; sample_emitter_direction()
+then uses this scheme internally.
+
+Parameter ``p``:
+    A 3D reference position within the scene (e.g. the shading point)
+
+Parameter ``sample``:
+    A uniformly distributed number in [0, 1).
+
+Returns:
+    The index of the chosen emitter along with the sampling weight
+    (equal to the inverse PMF), and the transformed random sample for
+    reuse.)doc";
+
+static const char *__doc_mitsuba_Scene_pdf_emitter_tree =
+R"doc(Evaluate the discrete probability of the sample_emitter_tree()
+technique for the given reference position and emitter index.)doc";
+
 static const char *__doc_mitsuba_Scene_sample_emitter_direction =
 R"doc(Direct illumination sampling routine
 
@@ -7646,6 +8005,45 @@ static const char *__doc_mitsuba_Spectrum_operator_assign = R"doc()doc";
 
 static const char *__doc_mitsuba_Spectrum_operator_assign_2 = R"doc()doc";
 
+static const char *__doc_mitsuba_BlockScheduler =
+R"doc(Work-stealing scheduler that distributes image blocks to render
+workers
+
+The blocks of every pass are enumerated in the inside-out order
+produced by Spiral and dealt round-robin into one deque per worker, so
+that each worker starts with a spatially spread subset that still
+renders roughly inside-out. Workers then fetch work exclusively from
+their own deque via next_block() and only synchronize with others when
+it runs empty: in that case, the worker steals the most recently
+queued block of another deque and, if the block spans more than one
+scanline, splits off the upper half of its row range and leaves the
+rest behind for the victim.
+
+This keeps all synchronization on per-deque mutexes that are
+uncontended in the steady state, and lets threads that finish early
+subdivide the remaining work at scanline granularity instead of idling
+behind a single expensive block.)doc";
+
+static const char *__doc_mitsuba_BlockScheduler_BlockScheduler =
+R"doc(Create a new scheduler for the given size, offset into a larger frame,
+block size, pass count, and number of render workers)doc";
+
+static const char *__doc_mitsuba_BlockScheduler_block_count = R"doc(Return the total number of blocks in one pass)doc";
+
+static const char *__doc_mitsuba_BlockScheduler_max_block_size = R"doc(Return the maximum block size)doc";
+
+static const char *__doc_mitsuba_BlockScheduler_next_block =
+R"doc(Fetch the next (possibly partial) block for the given worker.
+
+Pops from the worker's own deque, stealing and splitting the row range
+of another worker's block when it runs empty. Returns a tuple
+``(offset, size, block_id, row_begin, row_end)``, or ``None`` when no
+queued work remains.)doc";
+
+static const char *__doc_mitsuba_BlockScheduler_row_count = R"doc(Return the total number of assigned scanlines (across all passes))doc";
+
+static const char *__doc_mitsuba_BlockScheduler_worker_count = R"doc(Return the number of per-worker deques)doc";
+
 static const char *__doc_mitsuba_Spiral =
 R"doc(Generates a spiral of blocks to be rendered.
 
@@ -8987,6 +9385,15 @@ R"doc(Returns the resolution of the spectrum in nanometers (if discretized)
 Not every implementation necessarily provides this function. The
 default implementation throws an exception.)doc";
 
+static const char *__doc_mitsuba_Texture_uses_ray_differentials =
+R"doc(Does this texture use the UV partials of the queried surface
+interaction (``si.duv_dx`` / ``si.duv_dy``)?
+
+Footprint-aware lookups (e.g. trilinear mip-mapped filtering) return
+``True`` here; BSDFs holding such a texture should then advertise
+BSDFFlags::NeedsDifferentials so that SurfaceInteraction::bsdf()
+computes the partials.)doc";
+
 static const char *__doc_mitsuba_Texture_wavelength_range =
 R"doc(Returns the range of wavelengths covered by the spectrum
 
@@ -472,6 +472,26 @@ public:
     virtual Spectrum eval_null_transmission(const SurfaceInteraction3f &si,
                                             Mask active = true) const;
 
+    /**
+     * \brief Evaluate the opacity of the material at the given surface
+     * position
+     *
+     * This is a scalar counterpart of \ref eval_null_transmission() that the
+     * ray tracing backends use to perform a stochastic alpha test during
+     * traversal (see \ref Shape::eval_opacity()). A value of 1 denotes a
+     * fully opaque surface, which is what the default implementation
+     * returns.
+     *
+     * \param si
+     *     A surface interaction data structure describing the underlying
+     *     surface position.
+     */
+    virtual Float eval_opacity(const SurfaceInteraction3f &si,
+                               Mask active = true) const;
+
+    /// Does this BSDF provide a meaningful \ref eval_opacity() implementation?
+    virtual bool has_opacity_query() const { return false; }
+
 
     // -----------------------------------------------------------------------
     //! @{ \name BSDF property accessors (components, flags, etc)
@@ -596,6 +616,7 @@ DRJIT_VCALL_TEMPLATE_BEGIN(mitsuba::BSDF)
     DRJIT_VCALL_METHOD(sample)
     DRJIT_VCALL_METHOD(eval)
     DRJIT_VCALL_METHOD(eval_null_transmission)
+    DRJIT_VCALL_METHOD(eval_opacity)
     DRJIT_VCALL_METHOD(pdf)
     DRJIT_VCALL_METHOD(eval_pdf)
     DRJIT_VCALL_METHOD(eval_pdf_sample)
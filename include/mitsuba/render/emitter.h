@@ -64,6 +64,12 @@ public:
     /// The emitter's sampling weight.
     ScalarFloat sampling_weight() const { return m_sampling_weight; }
 
+    /// Return the emitter's position in the scene's emitter list
+    uint32_t scene_index() const { return m_scene_index; }
+
+    /// Used internally by \ref Scene to record the emitter's list position
+    void set_scene_index(uint32_t index) { m_scene_index = index; }
+
     /// Flags for all components combined.
     uint32_t flags(dr::mask_t<Float> /*active*/ = true) const { return m_flags; }
 
@@ -71,7 +77,8 @@ public:
 
     void parameters_changed(const std::vector<std::string> &keys = {}) override;
 
-    /// Return whether the emitter parameters have changed
+    /** \brief Return whether a parameter affecting the scene's emitter
+     * sampling distribution (e.g. the sampling weight) has changed */
     bool dirty() const { return m_dirty; }
 
     /// Modify the emitter's "dirty" flag
@@ -92,8 +99,11 @@ protected:
     /// Sampling weight
     ScalarFloat m_sampling_weight;
 
-    /// True if the emitters's parameters have changed
+    /// True if a parameter feeding the emitter sampling distribution changed
     bool m_dirty = false;
+
+    /// Position in the scene's emitter list (see \ref Scene)
+    uint32_t m_scene_index = (uint32_t) -1;
 };
 
 MI_EXTERN_CLASS(Emitter)
@@ -117,6 +127,7 @@ DRJIT_VCALL_TEMPLATE_BEGIN(mitsuba::Emitter)
     DRJIT_VCALL_GETTER(shape, const typename Class::Shape *)
     DRJIT_VCALL_GETTER(medium, const typename Class::Medium *)
     DRJIT_VCALL_GETTER(sampling_weight, float)
+    DRJIT_VCALL_GETTER(scene_index, uint32_t)
 DRJIT_VCALL_TEMPLATE_END(mitsuba::Emitter)
 
 //! @}
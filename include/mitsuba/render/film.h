@@ -63,15 +63,189 @@ public:
     /// Clear the film contents to zero.
     virtual void clear() = 0;
 
+    /**
+     * \brief Clear a rectangular sub-region of the film's accumulation
+     * buffer to zero
+     *
+     * The region is specified relative to the crop window. This is mainly
+     * useful in combination with \ref SamplingIntegrator::render_region(),
+     * which re-renders a sub-region into the existing film storage.
+     */
+    virtual void clear_region(const ScalarPoint2u &offset,
+                              const ScalarVector2u &size) = 0;
+
     /// Return a image buffer object storing the developed image
     virtual TensorXf develop(bool raw = false) const = 0;
 
+    /**
+     * \brief Differentiation-free variant of \ref develop() for interactive use
+     *
+     * In AD-enabled variants, \ref develop() records the weight
+     * normalization on the differentiable computation graph so that image
+     * gradients can propagate into the film contents. Interactive viewports
+     * that merely want preview pixels pay for this bookkeeping on every
+     * progressive pass. This entry point detaches the film storage before
+     * developing it and launches the normalization eagerly as a fused
+     * kernel; implementations may additionally cache constant parts of the
+     * computation (e.g. gather index tables) across calls.
+     *
+     * The default implementation forwards to \ref develop() with gradient
+     * tracking suspended.
+     */
+    virtual TensorXf develop_fast() const;
+
     /// Return a bitmap object storing the developed contents of the film
     virtual ref<Bitmap> bitmap(bool raw = false) const = 0;
 
+    /**
+     * \brief Develop the film into a display-ready 8-bit sRGB buffer
+     *
+     * This is a fused preview path intended for interactive viewports:
+     * weight normalization, exposure scaling and sRGB gamma encoding are
+     * performed in a single pass over the frame, writing interleaved RGBA8
+     * pixels into the caller-provided buffer \c buf, which must hold
+     * <tt>width * height * 4</tt> bytes of the film's crop region. The
+     * buffer can be reused across frames, avoiding per-frame allocations.
+     *
+     * \param buf
+     *     Destination buffer receiving interleaved RGBA8 pixels
+     * \param exposure
+     *     Exposure value; pixel values are scaled by \c 2^exposure prior
+     *     to gamma encoding (default: 0)
+     */
+    virtual void develop_preview(uint8_t *buf, ScalarFloat exposure = 0.f) const;
+
+    /**
+     * \brief Compute per-channel statistics of a region of the developed image
+     *
+     * For every channel of the developed image, this method reduces the
+     * pixels of the given region to their mean, maximum and variance. In JIT
+     * variants, the reductions run on the device and the result stays there;
+     * only the scalars that are actually accessed need to be transferred.
+     * This makes the method suitable for per-pass convergence tests (e.g.
+     * adaptive stopping criteria) that would otherwise fetch the entire
+     * image every pass.
+     *
+     * \param offset
+     *     Top-left corner of the region, relative to the crop window
+     *     (default: (0, 0))
+     *
+     * \param size
+     *     Size of the region in pixels; a zero-valued entry selects the
+     *     remainder of the image along that axis (default: full image)
+     *
+     * \return A (channels x 3) tensor whose rows hold (mean, max, variance)
+     */
+    TensorXf statistics(const ScalarPoint2u &offset = 0u,
+                        const ScalarVector2u &size = 0u) const;
+
+    /**
+     * \brief Extract a crop region and channel range of the developed image
+     *
+     * Returns a (height x width x channels) tensor holding only the
+     * requested slice of the output of \ref develop(). In JIT variants, the
+     * slice is expressed as a lazy gather over the existing image storage:
+     * nothing is copied until the result is evaluated, and only the
+     * selected entries are ever materialized. This makes it cheap to export
+     * a few AOV channels from a film with a large channel stack.
+     *
+     * \param offset
+     *     Top-left corner of the region, relative to the crop window
+     *     (default: (0, 0))
+     *
+     * \param size
+     *     Size of the region in pixels; a zero-valued entry selects the
+     *     remainder of the image along that axis (default: full image)
+     *
+     * \param channel_offset
+     *     Index of the first channel to extract (default: 0)
+     *
+     * \param channel_count
+     *     Number of channels to extract; zero selects all remaining
+     *     channels (default: all)
+     */
+    TensorXf develop_region(const ScalarPoint2u &offset = 0u,
+                            const ScalarVector2u &size = 0u,
+                            uint32_t channel_offset = 0,
+                            uint32_t channel_count = 0) const;
+
     /// Write the developed contents of the film to a file on disk
     virtual void write(const fs::path &path) const = 0;
 
+    /**
+     * \brief Write the developed contents of the film to disk in
+     * fixed-size scanline bands
+     *
+     * Equivalent to \ref write(), except that the film storage is
+     * developed, converted and encoded one horizontal band of scanlines at
+     * a time instead of materializing the full output image in memory
+     * first. For very large films (e.g. high-resolution texture bakes),
+     * this bounds the peak memory overhead of writing to a few rows of
+     * pixels on top of the film's accumulation buffer.
+     *
+     * The default implementation simply forwards to \ref write();
+     * implementations (and file formats) without an incremental encoding
+     * path behave likewise.
+     *
+     * \param path
+     *     Target file path on disk
+     *
+     * \param band_height
+     *     Number of scanlines developed and encoded per band; the default
+     *     value of zero selects a band height matching the image blocks
+     *     used during rendering
+     */
+    virtual void write_streaming(const fs::path &path,
+                                 uint32_t band_height = 0) const;
+
+    /**
+     * \brief Write the developed contents of the film to a file on disk
+     * without blocking the caller
+     *
+     * Equivalent to \ref write(), except that only a snapshot of the film
+     * storage is taken synchronously; development, format conversion and
+     * image encoding then run on the global thread pool. This is mainly
+     * useful in animation batches, where it allows the next frame's render
+     * to overlap the (potentially slow) encode and I/O of the previous one.
+     *
+     * The asynchronous task is registered with the \ref Thread class; call
+     * \ref Thread::wait_for_tasks() to join all pending writes (e.g. before
+     * reading the files back or shutting down). Exceptions raised by the
+     * background write are re-thrown from that call.
+     *
+     * The default implementation simply forwards to \ref write() and
+     * returns once the file has been written.
+     *
+     * \param path
+     *     Target file path on disk
+     */
+    virtual void write_async(const fs::path &path) const;
+
+    /**
+     * \brief Serialize the film's raw accumulation state to a stream
+     *
+     * In contrast to \ref write(), which stores the *developed* image, this
+     * method saves the undeveloped sample accumulation buffers (including
+     * filter weights), such that rendering can later resume from the exact
+     * same state via \ref load_state(). It is the film-side half of the
+     * render checkpointing feature (see the :paramtype:`checkpoint`
+     * parameter of sampling integrators).
+     *
+     * The default implementation throws; films without a resumable storage
+     * representation do not support checkpointing.
+     */
+    virtual void save_state(Stream *stream) const;
+
+    /**
+     * \brief Restore the film's accumulation state from a stream
+     *
+     * Counterpart of \ref save_state(). The film must already have been
+     * configured via \ref prepare() with a matching channel setup; an
+     * exception is thrown when the serialized state disagrees with the
+     * film's current configuration.
+     */
+    virtual void load_state(Stream *stream);
+
     /// dr::schedule() variables that represent the internal film storage
     virtual void schedule_storage() = 0;
 
@@ -155,8 +155,39 @@ public:
                bool warn_negative = std::is_scalar_v<Float>,
                bool warn_invalid = std::is_scalar_v<Float>);
 
-    /// Accumulate another image block into this one
-    void put_block(const ImageBlock *block);
+    /**
+     * \brief Construct an image block by reading a serialized representation
+     * created by \ref write()
+     *
+     * The resulting block carries no reconstruction filter and uses default
+     * flags; it is primarily meant to be merged into a film or another block
+     * via \ref put_block().
+     */
+    ImageBlock(Stream *stream);
+
+    /**
+     * \brief Serialize the image block to a binary stream
+     *
+     * This writes a compact representation consisting of a small header
+     * (offset, size, channel count, border size) followed by the raw
+     * single-precision channel data, including the filter border region.
+     * Since the border is preserved, merging a deserialized block via
+     * \ref put_block() reconstructs filter footprints that straddle block
+     * boundaries exactly. This is the wire format used to transfer
+     * partially accumulated blocks between machines when distributing a
+     * rendering job (see <tt>mitsuba.util.render_shard()</tt>).
+     */
+    void write(Stream *stream) const;
+
+    /**
+     * \brief Accumulate another image block into this one
+     *
+     * When \c atomic is set (scalar variants only), the accumulation uses
+     * per-channel atomic additions so that concurrent \c put_block() calls
+     * targeting the same storage (which overlap in the reconstruction
+     * filter border of neighboring blocks) need no lock.
+     */
+    void put_block(const ImageBlock *block, bool atomic = false);
 
     /**
      * \brief Accumulate a single sample or a wavefront of samples into the
@@ -245,6 +276,14 @@ public:
     /// Clear the image block contents to zero.
     void clear();
 
+    /**
+     * \brief Clear a rectangular sub-region of the block to zero
+     *
+     * The \c offset parameter is specified in coordinates of the underlying
+     * tensor, i.e. including the border region (if any).
+     */
+    void clear_region(const ScalarPoint2u &offset, const ScalarVector2u &size);
+
     // =============================================================
     //! @{ \name Accessors
     // =============================================================
@@ -301,6 +340,83 @@ public:
     /// Use Kahan-style error-compensated floating point accumulation?
     bool compensate() const { return m_compensate; }
 
+    /**
+     * \brief Store the image contents in half precision (JIT variants)
+     *
+     * When enabled, the block stores its channels as packed IEEE 754
+     * half-precision values, halving its memory footprint. This matters for
+     * large films with many AOVs, whose accumulation buffers otherwise
+     * dominate device memory.
+     *
+     * Half-precision blocks only serve as *merge targets*: samples are
+     * still accumulated into ordinary single precision blocks via \ref
+     * put(), whose contents are then folded into the packed representation
+     * through \ref put_block() (full-frame merges only). \ref put(), \ref
+     * read(), \ref clear_region(), and slot privatization are unsupported
+     * in this mode, and \ref tensor() transiently materializes a single
+     * precision copy. Calls are ignored with a warning in scalar variants.
+     *
+     * Toggling this flag reallocates and clears the block.
+     */
+    void set_half_precision(bool value);
+
+    /// Store the image contents in half precision? (see \ref set_half_precision)
+    bool half_precision() const { return m_half_precision; }
+
+    /**
+     * \brief Configure outlier-robust accumulation ("firefly" clamping)
+     *
+     * When \c threshold is positive, each call to \ref put() computes the
+     * maximum over the first \c value_channels entries of the sample value
+     * array and, if it exceeds \c threshold, rescales those entries so that
+     * the maximum equals \c threshold. Weight and alpha channels following
+     * the value channels are left untouched, hence the operation reduces the
+     * energy of outlier samples without biasing the filter normalization.
+     *
+     * The removed energy can optionally be retained in the channel with index
+     * \c excess_channel (e.g. an AOV reserved for this purpose), which
+     * preserves it for later redistribution or inspection. The incoming
+     * sample value of that channel is *replaced* by the removed energy, so
+     * the channel must not carry other data. Pass
+     * <tt>excess_channel=(uint32_t) -1</tt> (the default) to simply discard
+     * it. A \c threshold of zero (the default) disables clamping altogether.
+     */
+    void set_outlier_clamp(ScalarFloat threshold, uint32_t value_channels,
+                           uint32_t excess_channel = (uint32_t) -1) {
+        m_clamp_threshold = threshold;
+        m_clamp_channels = value_channels;
+        m_clamp_excess = excess_channel;
+    }
+
+    /// Return the outlier clamping threshold (zero when disabled)
+    ScalarFloat outlier_clamp() const { return m_clamp_threshold; }
+
+    /**
+     * \brief Privatize the accumulation buffer into \c slots independent
+     * copies
+     *
+     * In JIT modes, particle tracing-style methods accumulate all of their
+     * samples into a single shared image using atomic scatter-additions. When
+     * many lanes splat into the same set of pixels (e.g. a caustic), these
+     * atomics serialize and dominate the runtime. With a slot count larger
+     * than one, the block instead allocates \c slots copies of the image and
+     * routes each lane to the copy given by its index modulo \c slots, which
+     * reduces contention accordingly. The copies must be summed back into a
+     * single image by calling \ref reduce_slots() before the block's
+     * contents can be accessed.
+     *
+     * Changing the slot count reallocates and clears the block. The value is
+     * ignored in scalar modes, where per-thread image blocks already provide
+     * this type of privatization.
+     */
+    void set_slot_count(uint32_t slots);
+
+    /// Return the number of privatized accumulation slots (see \ref set_slot_count)
+    uint32_t slot_count() const { return m_slot_count; }
+
+    /// Sum privatized accumulation slots back into a single image (see \ref set_slot_count)
+    void reduce_slots();
+
     /// Return the number of channels stored by the image block
     uint32_t channel_count() const { return m_channel_count; }
 
@@ -331,6 +447,12 @@ protected:
 
     // Implementation detail to atomically accumulate a value into the image block
     void accum(Float value, UInt32 index, Bool active);
+
+    // Implements \ref put() after any configured outlier clamping was applied
+    void put_impl(const Point2f &pos, const Float *values, Mask active);
+
+    // Fold single precision data into the packed half-precision storage
+    void accum_half(const Float &values);
 protected:
     ScalarPoint2i m_offset;
     ScalarVector2u m_size;
@@ -338,12 +460,19 @@ protected:
     uint32_t m_border_size;
     TensorXf m_tensor;
     mutable TensorXf m_tensor_compensation;
+    /// Packed pairs of half-precision channel values (see \ref set_half_precision)
+    UInt32 m_data_half;
     ref<const ReconstructionFilter> m_rfilter;
     bool m_normalize;
     bool m_coalesce;
     bool m_compensate;
     bool m_warn_negative;
     bool m_warn_invalid;
+    bool m_half_precision = false;
+    ScalarFloat m_clamp_threshold = 0;
+    uint32_t m_clamp_channels = 0;
+    uint32_t m_clamp_excess = (uint32_t) -1;
+    uint32_t m_slot_count = 1;
 };
 
 MI_EXTERN_CLASS(ImageBlock)
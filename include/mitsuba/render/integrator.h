@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <tuple>
 #include <mitsuba/core/fwd.h>
 #include <mitsuba/core/object.h>
 #include <mitsuba/core/properties.h>
@@ -92,6 +95,66 @@ public:
                     bool develop = true,
                     bool evaluate = true);
 
+    /**
+     * \brief Render the scene from multiple viewpoints at once
+     *
+     * Applications that must render many sensors observing the same scene
+     * (e.g. camera arrays or turntable captures) can use this entry point to
+     * amortize per-render overheads over all viewpoints. Every sensor
+     * renders into its own film; the returned vector holds one image per
+     * entry of \c sensors (in order) when <tt>develop=true</tt> and empty
+     * tensors otherwise. The remaining parameters match \ref render().
+     *
+     * The default implementation simply invokes \ref render() once per
+     * sensor with decorrelated seeds; subclasses may override it with a
+     * fused rendering strategy (see \ref SamplingIntegrator).
+     */
+    virtual std::vector<TensorXf>
+    render_batch(Scene *scene,
+                 const std::vector<Sensor *> &sensors,
+                 uint32_t seed = 0,
+                 uint32_t spp = 0,
+                 bool develop = true,
+                 bool evaluate = true);
+
+    /**
+     * \brief Render the scene while reusing previously compiled kernels
+     * ("frozen" rendering)
+     *
+     * Iterative applications (e.g. lightmap baking or texture optimization
+     * loops) repeatedly render the same scene after tweaking parameters via
+     * \ref traverse() / \ref parameters_changed(). A freshly assigned
+     * parameter is usually a literal constant from the JIT compiler's point
+     * of view, so each iteration traces a *different* program and pays for
+     * a full kernel compilation even though the computation is structurally
+     * unchanged.
+     *
+     * This entry point first walks the scene graph and makes every exposed
+     * parameter opaque (via <tt>dr::make_opaque()</tt>, the same mechanism
+     * that plugins like the heterogeneous medium already apply to selected
+     * members), which turns the parameters into kernel inputs. The render
+     * is then re-traced as usual, but the resulting program is identical
+     * across iterations and replays the machine code cached by the JIT
+     * backend, reducing the per-iteration cost to tracing plus pure kernel
+     * time. Plain scalar parameters (e.g. <tt>float</tt> members) cannot be
+     * made opaque and still trigger a recompilation when changed. Scalar
+     * variants simply forward to \ref render().
+     */
+    TensorXf render_frozen(Scene *scene,
+                           Sensor *sensor,
+                           uint32_t seed = 0,
+                           uint32_t spp = 0,
+                           bool develop = true,
+                           bool evaluate = true);
+
+    /// Variant of \ref render_frozen() that accepts a sensor index
+    TensorXf render_frozen(Scene *scene,
+                           uint32_t sensor_index = 0,
+                           uint32_t seed = 0,
+                           uint32_t spp = 0,
+                           bool develop = true,
+                           bool evaluate = true);
+
     /// \brief Cancel a running render job (e.g. after receiving Ctrl-C)
     virtual void cancel();
 
@@ -134,6 +197,18 @@ protected:
      */
     float m_timeout;
 
+    /**
+     * \brief Target wall-clock completion time (in seconds)
+     *
+     * In contrast to \ref m_timeout, which aborts rendering the moment the
+     * limit is exceeded, the deadline is enforced predictively: the
+     * integrator measures its throughput while rendering and stops issuing
+     * further work once the next unit is expected to overshoot the limit.
+     * Completed passes are always accumulated with their full weight. A
+     * negative value disables the deadline (default).
+     */
+    float m_deadline;
+
     /// Timer used to enforce the timeout.
     Timer m_render_timer;
 
@@ -154,8 +229,8 @@ protected:
 template <typename Float, typename Spectrum>
 class MI_EXPORT_LIB SamplingIntegrator : public Integrator<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(Integrator, should_stop, aov_names,
-                    m_stop, m_timeout, m_render_timer, m_hide_emitters)
+    MI_IMPORT_BASE(Integrator, should_stop, aov_names, m_stop, m_timeout,
+                    m_deadline, m_render_timer, m_hide_emitters)
     MI_IMPORT_TYPES(Scene, Sensor, Film, ImageBlock, Medium, Sampler)
 
     /**
@@ -204,6 +279,51 @@ public:
                                              Float *aovs = nullptr,
                                              Mask active = true) const;
 
+    /**
+     * \brief Variant of \ref sample() that reuses an already computed
+     * primary intersection
+     *
+     * Wrapper plugins such as the :monosp:`aov` integrator evaluate several
+     * sub-integrators for the same sensor sample. When each of them begins
+     * by intersecting the primary ray, the scene is traversed once per
+     * sub-integrator. The wrapper instead calls this method with the
+     * intersection it already computed (using <tt>RayFlags::All |
+     * RayFlags::BoundaryTest</tt>); integrators can override it to consume
+     * \c si instead of re-tracing the ray.
+     *
+     * The default implementation ignores the provided interaction and
+     * forwards to \ref sample(), which is always correct, merely slower.
+     *
+     * \param si
+     *    Surface interaction of the primary ray \c ray with the scene
+     *
+     * \param si_valid
+     *    Mask indicating the lanes of \c si that hit a surface
+     *
+     * The remaining parameters match those of \ref sample().
+     */
+    virtual std::pair<Spectrum, Mask> sample_with_interaction(
+        const Scene *scene,
+        Sampler *sampler,
+        const RayDifferential3f &ray,
+        const SurfaceInteraction3f &si,
+        Mask si_valid,
+        const Medium *medium = nullptr,
+        Float *aovs = nullptr,
+        Mask active = true) const;
+
+    /**
+     * \brief Does \ref sample_with_interaction() actually consume the
+     * provided primary interaction?
+     *
+     * The default implementation of that method ignores the interaction and
+     * re-traces the camera ray, in which case pre-computing it is wasted
+     * work. \ref render_block() queries this flag before enabling the
+     * batched primary visibility pass (see \ref m_batch_primary_rays);
+     * wrapper plugins forward the query to their nested integrators.
+     */
+    virtual bool reuses_primary_interaction() const { return false; }
+
     // =========================================================================
     //! @{ \name Integrator interface implementation
     // =========================================================================
@@ -215,6 +335,119 @@ public:
                     bool develop = true,
                     bool evaluate = true) override;
 
+    /**
+     * \brief Render multiple sensors in a single fused wavefront
+     *
+     * JIT variants trace one combined wavefront covering all sensors: lanes
+     * are partitioned among the viewpoints, camera ray generation dispatches
+     * each lane to its owning sensor (analogous to the :monosp:`batch`
+     * sensor plugin), and a single invocation of \ref sample() integrates
+     * all of them. Kernel compilation, launch overheads, and the rendering
+     * warm-up (BVH upload, texture transfers) are hence paid once rather
+     * than once per viewpoint. In contrast to the :monosp:`batch` plugin,
+     * every sensor keeps its own film instead of sharing a horizontal strip
+     * of a single one.
+     *
+     * The fused path requires all sensor films to agree on crop size,
+     * border settings, and channel configuration, and all sensors to share
+     * the same medium; the first sensor's sampler then supplies the random
+     * number stream for the entire wavefront. Configurations violating
+     * these constraints, renders using the :monosp:`pass_time_budget` or
+     * :monosp:`deadline` features, and scalar variants (which share no
+     * per-launch costs between sensors) fall back to sequential per-sensor
+     * rendering via the base class implementation.
+     */
+    std::vector<TensorXf>
+    render_batch(Scene *scene,
+                 const std::vector<Sensor *> &sensors,
+                 uint32_t seed = 0,
+                 uint32_t spp = 0,
+                 bool develop = true,
+                 bool evaluate = true) override;
+
+    /**
+     * \brief Re-render a rectangular sub-region of the film
+     *
+     * This entry point is intended for interactive applications that must
+     * refresh a small damaged region (e.g. after a material edit) without
+     * paying for a full frame: it only schedules work covering the region
+     * and merges the result into the film's existing storage, leaving all
+     * other pixels untouched. In particular, \ref Film::prepare() is *not*
+     * invoked, hence a prior call to \ref render() must have taken place.
+     *
+     * Internally, the region is expanded by the radius of the film's
+     * reconstruction filter (clamped to the crop window), cleared via \ref
+     * Film::clear_region(), and re-rendered, so that filter taps crossing
+     * the region boundary are regenerated consistently.
+     *
+     * \param offset
+     *     Top-left corner of the region, relative to the crop window
+     *
+     * \param size
+     *     Size of the region in pixels (must be nonzero)
+     *
+     * \param seed
+     *     Seed value for the sampler
+     *
+     * \param spp
+     *     Optional parameter to override the number of samples per pixel
+     *     (a value of zero uses the sampler's sample count)
+     *
+     * \return The developed image of the re-rendered region (excluding the
+     *     internally added filter margin)
+     */
+    TensorXf render_region(Scene *scene,
+                           Sensor *sensor,
+                           const ScalarPoint2u &offset,
+                           const ScalarVector2u &size,
+                           uint32_t seed = 0,
+                           uint32_t spp = 0);
+
+    /**
+     * \brief Signature of progressive preview callbacks registered via \ref
+     * set_block_callback()
+     *
+     * The arguments specify the offset and size of the updated region
+     * relative to the crop window, followed by the developed pixel data of
+     * that region (a <tt>height x width x channels</tt> tensor).
+     */
+    using BlockCallback = std::function<void(const ScalarPoint2u &,
+                                             const ScalarVector2u &,
+                                             const TensorXf &)>;
+
+    /**
+     * \brief Register a callback that receives progressively developed
+     * image regions while \ref render() runs
+     *
+     * In scalar variants, rendering proceeds in parallel over small square
+     * image blocks. Whenever a block has been merged into the film, its
+     * extents are added to a pending dirty region; at most once every
+     * \c min_interval seconds, this region is developed via \ref
+     * Film::develop_region() (i.e. without re-developing the remainder of
+     * the film) and handed to the callback. A final flush at the end of the
+     * render delivers any remaining blocks, hence the union of all reported
+     * regions covers the entire crop window. This enables interactive
+     * preview displays that refresh at block granularity.
+     *
+     * The callback runs on a rendering worker thread; its invocations are
+     * serialized, but it must not access other application state without
+     * synchronization, and it should return quickly to avoid stalling the
+     * render.
+     *
+     * JIT variants compute the image in monolithic passes that only touch
+     * the film once at the very end, hence no intermediate regions exist
+     * and the callback is not invoked there.
+     *
+     * \param callback
+     *     The callback to install, or \c nullptr to remove a previously
+     *     registered one
+     *
+     * \param min_interval
+     *     Minimum time between two callback invocations (in seconds)
+     */
+    void set_block_callback(BlockCallback callback,
+                            ScalarFloat min_interval = 0.5f);
+
     //! @}
     // =========================================================================
 
@@ -223,6 +456,14 @@ protected:
     SamplingIntegrator(const Properties &props);
     virtual ~SamplingIntegrator();
 
+    /**
+     * \brief Render the pixels of \c block (scalar variants)
+     *
+     * The optional row range <tt>[row_begin, row_end)</tt> restricts
+     * rendering to a subset of the block's scanlines without affecting the
+     * per-pixel RNG seeding, so that the work-stealing scheduler can split
+     * one block among several threads (see \ref BlockScheduler).
+     */
     virtual void render_block(const Scene *scene,
                               const Sensor *sensor,
                               Sampler *sampler,
@@ -231,8 +472,36 @@ protected:
                               uint32_t sample_count,
                               uint32_t seed,
                               uint32_t block_id,
-                              uint32_t block_size) const;
+                              uint32_t block_size,
+                              uint32_t row_begin = 0,
+                              uint32_t row_end = (uint32_t) -1) const;
 
+    /**
+     * \brief Generate a sensor sample and the corresponding camera ray
+     *
+     * Draws the sample position, aperture, time and wavelength values from
+     * \c sampler and turns them into a camera ray. Factored out of \ref
+     * render_sample() so that the batched primary visibility pass in \ref
+     * render_block() can generate identical rays ahead of time by
+     * re-seeding the sampler.
+     *
+     * \return The generated ray differential, its importance weight, and
+     *         the sample position on the film
+     */
+    std::tuple<RayDifferential3f, Spectrum, Vector2f>
+    sample_camera_ray(const Sensor *sensor, Sampler *sampler,
+                      const Vector2f &pos, ScalarFloat diff_scale_factor,
+                      Mask active = true) const;
+
+    /**
+     * \brief Render one sample at the given film position
+     *
+     * When \c pre_si is provided (scalar variants only), it must hold the
+     * primary intersection of the camera ray that this call will generate
+     * (computed with <tt>RayFlags::All | RayFlags::BoundaryTest</tt>), and
+     * the integrator is invoked through \ref sample_with_interaction()
+     * instead of \ref sample().
+     */
     void render_sample(const Scene *scene,
                        const Sensor *sensor,
                        Sampler *sampler,
@@ -240,7 +509,93 @@ protected:
                        Float *aovs,
                        const Vector2f &pos,
                        ScalarFloat diff_scale_factor,
-                       Mask active = true) const;
+                       Mask active = true,
+                       const SurfaceInteraction3f *pre_si = nullptr) const;
+
+    /**
+     * \brief Fused multi-sensor variant of \ref render_sample() (JIT modes)
+     *
+     * Renders one sample per lane of a combined wavefront, where \c
+     * sensor_idx identifies the sensor owning each lane and \c blocks holds
+     * one image block per sensor. See \ref render_batch().
+     */
+    void render_sample_batch(const Scene *scene,
+                             const std::vector<Sensor *> &sensors,
+                             Sampler *sampler,
+                             const std::vector<ref<ImageBlock>> &blocks,
+                             Float *aovs,
+                             const Vector2u &pos,
+                             const UInt32 &sensor_idx,
+                             ScalarFloat diff_scale_factor) const;
+
+    /**
+     * \brief Deferred next-event-estimation shadow rays (scalar modes)
+     *
+     * When the \c batch_shadow_rays parameter is set, scalar renders do not
+     * trace NEE shadow rays one at a time: \ref render_block() installs a
+     * per-thread batch, integrators queue candidate rays via \ref
+     * defer_shadow_ray() together with the radiance they would contribute if
+     * unoccluded, and \ref resolve_shadow_rays() tests the whole batch at
+     * the end of the block through the backend's occlusion stream (see \ref
+     * Scene::ray_test_many()) after sorting it by direction octant and
+     * quantized origin. Unoccluded contributions are then splatted into the
+     * block with zero sample weight, attributing them to the sample that
+     * queued them without perturbing the reconstruction filter
+     * normalization.
+     */
+    struct ShadowRayBatch {
+        struct Sample {
+            Spectrum weight;        ///< Importance weight of the camera ray
+            Wavelength wavelengths; ///< Sampled wavelengths (spectral modes)
+            Vector2f pos;           ///< Position passed to ImageBlock::put()
+        };
+        struct Candidate {
+            Ray3f ray;       ///< Shadow ray towards the sampled emitter
+            Spectrum value;  ///< Contribution if unoccluded (without camera weight)
+            uint32_t sample; ///< Index of the originating sample
+        };
+        std::vector<Sample> samples;
+        std::vector<Candidate> candidates;
+    };
+
+    /// Is deferred shadow-ray batching active on the calling thread?
+    bool shadow_batching_active() const;
+
+    /**
+     * \brief Queue a NEE shadow ray for deferred batched testing
+     *
+     * Returns \c false when batching is inactive, in which case the caller
+     * must test the ray immediately and accumulate the contribution itself.
+     */
+    bool defer_shadow_ray(const Ray3f &ray, const Spectrum &value) const;
+
+    /// Occlusion-test all queued shadow rays and splat unoccluded contributions
+    void resolve_shadow_rays(const Scene *scene, const Sensor *sensor,
+                             ImageBlock *block, ShadowRayBatch &batch) const;
+
+    /**
+     * \brief Atomically write a render checkpoint file (see \ref m_checkpoint)
+     *
+     * Serializes a small header identifying the render configuration
+     * followed by the film's accumulation state (see \ref Film::save_state()).
+     * The file is written to a temporary path and renamed into place, so
+     * that a preemption during the write never corrupts an earlier
+     * checkpoint. Failures are reported as warnings; rendering continues.
+     */
+    void write_checkpoint(const Film *film, uint32_t seed, uint32_t spp,
+                          uint32_t spp_per_pass, uint32_t passes_done) const;
+
+    /**
+     * \brief Attempt to resume from the checkpoint file (see \ref m_checkpoint)
+     *
+     * Returns the number of render passes covered by the checkpoint after
+     * restoring the film state, or zero when no usable checkpoint exists.
+     * A checkpoint whose header disagrees with the current render
+     * configuration (seed, sample count, pass layout, or film setup) is
+     * ignored with a warning, and the render starts from scratch.
+     */
+    uint32_t resume_checkpoint(Film *film, uint32_t seed, uint32_t spp,
+                               uint32_t spp_per_pass) const;
 
 protected:
 
@@ -254,6 +609,136 @@ protected:
      * If set to (uint32_t) -1, all the work is done in a single pass (default).
      */
     uint32_t m_samples_per_pass;
+
+    /**
+     * \brief Target wall-clock time per kernel launch (in seconds) in JIT
+     * variants.
+     *
+     * When positive, the wavefront is split into sample chunks whose size is
+     * continuously adjusted so that each launch stays close to this budget,
+     * and \ref m_stop is checked in between. This bounds the latency of \ref
+     * cancel(), which otherwise cannot interrupt a fused megakernel spanning
+     * the entire sample budget. If set to -1, renders are not chunked
+     * (default).
+     */
+    ScalarFloat m_pass_time_budget;
+
+    /**
+     * \brief Pin pool workers to processor cores during scalar renders?
+     *
+     * When set, each worker participating in the block-based render loop pins
+     * itself to a core chosen round-robin from a NUMA-interleaved enumeration
+     * of the machine's processors (see \ref Thread::pin_worker_core()). This
+     * keeps per-worker image blocks on the worker's local NUMA node on
+     * multi-socket machines. Disabled by default.
+     */
+    bool m_pin_threads;
+
+    /**
+     * \brief Defer and batch NEE shadow rays in scalar renders?
+     *
+     * See \ref ShadowRayBatch for details. Only affects integrators that
+     * cooperate via \ref defer_shadow_ray(). Disabled by default.
+     */
+    bool m_batch_shadow_rays;
+
+    /**
+     * \brief Trace primary camera rays as one coherent batch in scalar
+     * renders? ('batch_primary_rays' parameter)
+     *
+     * When set, \ref render_block() first generates the camera rays of a
+     * chunk of pixels, intersects them all through the backend's
+     * intersection stream (see \ref Scene::ray_intersect_many()), and then
+     * hands each pre-computed interaction to the integrator via \ref
+     * sample_with_interaction(). Only affects integrators that report \ref
+     * reuses_primary_interaction(). Disabled by default.
+     */
+    bool m_batch_primary_rays;
+
+    /**
+     * \brief Relative error threshold of the adaptive sampling mode
+     * ('adaptive_threshold' parameter)
+     *
+     * When positive, scalar renders track the per-pixel mean and variance
+     * of the sample luminance and stop drawing samples for a pixel once the
+     * 95% confidence interval of its estimate drops below this fraction of
+     * its mean (but never before \ref m_adaptive_min_samples samples have
+     * been taken). Converged pixels are skipped when the spiral scheduler
+     * passes over their block again, so the remaining sample budget
+     * concentrates on hard regions; the per-pixel weight channel of the
+     * film keeps the varying sample counts unbiased. Disabled by
+     * default (0).
+     */
+    ScalarFloat m_adaptive_threshold;
+
+    /**
+     * \brief Number of samples to draw per pixel before the first
+     * convergence test ('adaptive_min_samples' parameter, default: 16)
+     */
+    uint32_t m_adaptive_min_samples;
+
+    /**
+     * \brief Per-pixel <tt>[mean, M2, count]</tt> luminance statistics of
+     * the adaptive render in progress (see \ref m_adaptive_threshold),
+     * covering the (bordered) crop window row by row. Shared by all
+     * workers without synchronization, which is safe because image blocks
+     * do not overlap. Null while adaptive sampling is inactive.
+     */
+    std::unique_ptr<double[]> m_adaptive_stats;
+
+    /// Top-left pixel covered by \ref m_adaptive_stats
+    ScalarPoint2i m_adaptive_offset;
+
+    /// Row stride (in pixels) of \ref m_adaptive_stats
+    uint32_t m_adaptive_stride;
+
+    /**
+     * \brief Split the rendering megakernel into wavefront-style stages?
+     * ('wavefront' parameter)
+     *
+     * By default, JIT variants record the integrator's sampling loop into
+     * a single fused megakernel. On deep-bounce scenes, the combined
+     * register footprint of ray generation, scene traversal, material
+     * evaluation and next-event estimation can tank occupancy on CUDA
+     * backends. When this flag is set, \ref render() disables Dr.Jit's
+     * loop recording (JitFlag::LoopRecord) for its duration, so that each
+     * of these stages runs as a separate queued kernel launch over
+     * evaluated lane buffers instead. This also unlocks the wavefront-only
+     * compaction and reordering passes (see \ref
+     * MonteCarloIntegrator::reordered_ray_intersect() and the
+     * :monosp:`reorder_rays` / :monosp:`reorder_shading` parameters of
+     * cooperating integrators).
+     *
+     * Equivalent to the ``-W`` command line flag, but scoped to renders
+     * performed by this integrator. Disabled by default.
+     */
+    bool m_wavefront;
+
+    /**
+     * \brief Path of the render checkpoint file ('checkpoint' parameter)
+     *
+     * When non-empty, \ref render() periodically saves the film's
+     * accumulation state together with the number of completed passes to
+     * this file, and resumes from it (continuing the sample seed sequence
+     * deterministically) when it already exists at the start of a render.
+     * This allows long renders to survive machine preemptions, e.g. on
+     * spot instances. The file is removed once the render completes its
+     * full sample budget. Empty (i.e. disabled) by default.
+     *
+     * Checkpoints are only written at pass boundaries: JIT renders are
+     * chunked into per-sample passes as with \ref m_pass_time_budget, and
+     * scalar renders schedule their image blocks one pass at a time.
+     */
+    std::string m_checkpoint;
+
+    /// Minimum time between two checkpoint writes (in seconds)
+    ScalarFloat m_checkpoint_interval;
+
+    /// Progressive preview callback (see \ref set_block_callback())
+    BlockCallback m_block_callback;
+
+    /// Minimum time between two preview callback invocations (in seconds)
+    ScalarFloat m_block_callback_interval;
 };
 
 /** \brief Abstract integrator that performs *recursive* Monte Carlo sampling
@@ -269,6 +754,7 @@ class MI_EXPORT_LIB MonteCarloIntegrator
     : public SamplingIntegrator<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(SamplingIntegrator)
+    MI_IMPORT_TYPES(Scene)
 
 protected:
     /// Create an integrator
@@ -277,10 +763,42 @@ protected:
     /// Virtual destructor
     virtual ~MonteCarloIntegrator();
 
+    /**
+     * \brief Trace a batch of rays against the scene, optionally reordering
+     * them beforehand to improve traversal coherence
+     *
+     * When ray reordering is enabled (see the ``reorder_rays`` plugin
+     * parameter) and the integrator runs in wavefront mode, incoherent
+     * secondary rays are grouped by a quantized direction/origin key before
+     * being handed to \ref Scene::ray_intersect(), and the resulting
+     * intersections are scattered back into the original lane order
+     * afterwards. In wavefront mode, lanes whose paths have already
+     * terminated are additionally compacted out of the batch once a
+     * significant fraction of the wavefront has died, so that the traversal
+     * kernel is launched over active lanes only. Secondary bounces
+     * otherwise traverse the acceleration data
+     * structure in an essentially random memory access pattern.
+     *
+     * Megakernel (recorded loop) execution and scalar variants perform a
+     * plain intersection call -- reordering requires evaluated arrays.
+     *
+     * \param coherent
+     *    Mask that marks rays as spatially coherent (e.g. camera rays);
+     *    reordering is skipped when any lane is flagged as coherent.
+     */
+    SurfaceInteraction3f reordered_ray_intersect(const Scene *scene,
+                                                 const Ray3f &ray,
+                                                 uint32_t ray_flags,
+                                                 Mask coherent,
+                                                 Mask active) const;
+
     MI_DECLARE_CLASS()
 protected:
     uint32_t m_max_depth;
     uint32_t m_rr_depth;
+
+    /// Reorder incoherent rays before intersection in wavefront mode?
+    bool m_reorder_rays;
 };
 
 /** \brief Abstract adjoint integrator that performs Monte Carlo sampling
@@ -368,9 +886,69 @@ protected:
 
     /// Depth to begin using russian roulette
     int m_rr_depth;
+
+    /**
+     * \brief Number of privatized film accumulation slots in JIT modes
+     *
+     * Particle splats are distributed over this many copies of the image,
+     * which are summed once the render is finished. This reduces atomic
+     * contention when many samples land in the same pixels (e.g. caustics).
+     * A value of zero (default) selects a backend-specific heuristic, a
+     * value of one accumulates directly into the film storage. Ignored in
+     * scalar modes. See \ref ImageBlock::set_slot_count() for details.
+     */
+    uint32_t m_accum_slots;
 };
 
 
+// -----------------------------------------------------------------------------
+//! @{ \name Loop-state packing utilities for megakernel integrators
+// -----------------------------------------------------------------------------
+
+/*
+ * Every variable registered with dr::Loop occupies registers for the entire
+ * lifetime of a recorded megakernel, and integrators with rich per-vertex
+ * state (path throughput, MIS bookkeeping, flags, counters) can become
+ * occupancy-limited on CUDA backends as a result. The helpers below allow
+ * integrators to declare a packed representation for part of their loop
+ * state:
+ *
+ * - pack_bf16x2() / unpack_bf16x2() store a pair of floating point values in
+ *   a single 32-bit word using a bfloat16 representation (8 bit mantissa,
+ *   full float32 exponent range). This is appropriate for radiance
+ *   throughput-style quantities, where dynamic range matters more than
+ *   mantissa precision.
+ *
+ * - Boolean flags and small counters (e.g. path depth) should share a single
+ *   32-bit word via ordinary bit manipulation.
+ *
+ * The packed representation only needs to exist *across* loop iterations:
+ * integrators unpack at the top of the loop body and repack at the bottom, so
+ * all intermediate shading computation runs at full precision. See the path
+ * tracer (src/integrators/path.cpp, MI_PATH_PACKED_LOOP_STATE) for a
+ * reference conversion.
+ */
+
+/// Pack two floating point values into one 32-bit word (bfloat16 rounding)
+template <typename Float, typename UInt32 = dr::uint32_array_t<Float>>
+UInt32 pack_bf16x2(const Float &a, const Float &b) {
+    UInt32 ua = dr::reinterpret_array<UInt32>(a),
+           ub = dr::reinterpret_array<UInt32>(b);
+
+    // Round to nearest by adding half of the discarded mantissa range
+    return ((ua + 0x8000u) >> 16) | ((ub + 0x8000u) & 0xffff0000u);
+}
+
+/// Recover the two floating point values packed by \ref pack_bf16x2()
+template <typename Float, typename UInt32 = dr::uint32_array_t<Float>>
+std::pair<Float, Float> unpack_bf16x2(const UInt32 &packed) {
+    return { dr::reinterpret_array<Float>(packed << 16),
+             dr::reinterpret_array<Float>(packed & 0xffff0000u) };
+}
+
+//! @}
+// -----------------------------------------------------------------------------
+
 MI_EXTERN_CLASS(Integrator)
 MI_EXTERN_CLASS(SamplingIntegrator)
 MI_EXTERN_CLASS(MonteCarloIntegrator)
@@ -1883,8 +1883,13 @@ protected:
                 util::mem_string(prim_count * sizeof(Index)).c_str());
 
             IndexVector indices(prim_count);
-            for (size_t i = 0; i < prim_count; ++i)
-                indices[i] = (Index) i;
+            dr::parallel_for(
+                dr::blocked_range<Size>(0u, prim_count, MI_KD_GRAIN_SIZE),
+                [&](const dr::blocked_range<Size> &range) {
+                    for (Size i = range.begin(); i != range.end(); ++i)
+                        indices[i] = (Index) i;
+                }
+            );
 
             BuildTask task = BuildTask(ctx, 0, std::move(indices), m_bbox,
                                        m_bbox, 0, 0, &final_cost);
@@ -2197,6 +2202,14 @@ public:
     template <bool ShadowRay>
     MI_INLINE PreliminaryIntersection<ScalarFloat, Shape>
     ray_intersect_scalar(ScalarRay3f ray) const {
+        if (unlikely(!m_qbvh_nodes.empty()))
+            return ray_intersect_qbvh<ShadowRay>(ray);
+        return ray_intersect_kdtree<ShadowRay>(ray);
+    }
+
+    template <bool ShadowRay>
+    MI_INLINE PreliminaryIntersection<ScalarFloat, Shape>
+    ray_intersect_kdtree(ScalarRay3f ray) const {
         /// Ray traversal stack entry
         struct KDStackEntry {
             // Ray distance associated with the node entry and exit point
@@ -2268,8 +2281,13 @@ public:
                         intersect_prim<ShadowRay>(prim_index, ray);
 
                     if (unlikely(prim_pi.is_valid())) {
-                        if constexpr (ShadowRay)
+                        if constexpr (ShadowRay) {
+                            /* For shadow rays, report the *global* kd-tree
+                               primitive index so that callers can re-test the
+                               occluder directly (see \ref ray_test_prim()) */
+                            prim_pi.prim_index = prim_index;
                             return prim_pi;
+                        }
 
                         Assert(prim_pi.t >= 0.f && prim_pi.t <= ray.maxt);
                         pi = prim_pi;
@@ -2292,16 +2310,52 @@ public:
         return pi;
     }
 
-#if 0
-    template <bool ShadowRay>
-    MI_INLINE PreliminaryIntersection3f ray_intersect_packet(Ray3f ray,
-                                                              Mask active) const {
+    /**
+     * \brief Intersect a packet of \c Width rays against the kd-tree
+     *
+     * The rays share a single traversal: split-plane distances and interval
+     * tests are evaluated for all lanes at once using packet arithmetic, and
+     * each node is fetched only once per packet instead of once per ray.
+     * When lanes disagree on the traversal order, they vote; sub-trees that
+     * no lane overlaps are culled wholesale, which amounts to a frustum-style
+     * rejection test for coherent (e.g. camera) ray bundles. Primitive tests
+     * at the leaves run per lane.
+     *
+     * Results are written to \c pis, whose entries must be default
+     * initialized by the caller. For shadow rays (\c ShadowRay = true), a
+     * lane's entry is valid iff the corresponding ray is occluded.
+     */
+    template <bool ShadowRay, size_t Width>
+    void ray_intersect_packet(const Ray<Point<dr::Packet<ScalarFloat, Width>, 3>, Spectrum> &ray,
+                              PreliminaryIntersection<ScalarFloat, Shape> *pis) const {
+        using FloatP    = dr::Packet<ScalarFloat, Width>;
+        using MaskP     = dr::mask_t<FloatP>;
+
+        const auto &o = ray.o;
+        const auto &d = ray.d;
+
+        /// Extract a single lane of the packet as a scalar ray
+        auto lane_ray = [&](size_t l, ScalarFloat maxt_l) {
+            return ScalarRay3f(
+                ScalarPoint3f(o.x()[l], o.y()[l], o.z()[l]),
+                ScalarVector3f(d.x()[l], d.y()[l], d.z()[l]),
+                maxt_l, ray.time[l], wavelength_t<Spectrum>());
+        };
+
+        /* The optional 8-wide BVH already uses packet arithmetic internally;
+           prefer it when built (see \ref ray_intersect_qbvh()) */
+        if (unlikely(!m_qbvh_nodes.empty())) {
+            for (size_t l = 0; l < Width; ++l)
+                pis[l] = ray_intersect_qbvh<ShadowRay>(lane_ray(l, ray.maxt[l]));
+            return;
+        }
+
         /// Ray traversal stack entry
         struct KDStackEntry {
-            // Ray distance associated with the node entry and exit point
-            Float mint, maxt;
-            // Is the corresponding SIMD lane enabled?
-            Mask active;
+            // Per-lane ray distance associated with the node entry and exit point
+            FloatP mint, maxt;
+            // Which SIMD lanes overlap the node?
+            MaskP active;
             // Pointer to the far child
             const KDNode *node;
         };
@@ -2310,67 +2364,75 @@ public:
         KDStackEntry stack[MI_KD_MAXDEPTH];
         int32_t stack_index = 0;
 
-        // Resulting intersection struct
-        PreliminaryIntersection3f pi = dr::zeros<PreliminaryIntersection3f>();
+        Vector<FloatP, 3> d_rcp = dr::rcp(d);
 
-        const KDNode *node = m_nodes.get();
+        /* Per-lane length of the unoccluded ray segment. Closest-hit queries
+           shorten it as hits are found; shadow lanes are switched off by
+           setting it to -infinity, so a single interval test handles both. */
+        ScalarFloat t_cur[Width];
+        for (size_t i = 0; i < Width; ++i)
+            t_cur[i] = ray.maxt[i];
 
-        /* Intersect against the scene bounding box */
-        auto bbox_result = m_bbox.ray_intersect(ray);
-        Float mint = dr::maximum(ray.mint, std::get<1>(bbox_result));
-        Float maxt = dr::minimum(ray.maxt, std::get<2>(bbox_result));
+        // Intersect against the scene bounding box
+        FloatP mint(0.f), maxt = dr::load<FloatP>(t_cur);
+        for (size_t k = 0; k < 3; ++k) {
+            FloatP t0 = (ScalarFloat(m_bbox.min[k]) - o[k]) * d_rcp[k],
+                   t1 = (ScalarFloat(m_bbox.max[k]) - o[k]) * d_rcp[k];
+            mint = dr::maximum(mint, dr::minimum(t0, t1));
+            maxt = dr::minimum(maxt, dr::maximum(t0, t1));
+        }
 
+        MaskP active(true);
+        const KDNode *node = m_nodes.get();
         while (true) {
-            active = active && (maxt >= mint);
-            if (ShadowRay)
-                active = active && !pi.is_valid();
-
+            active = active && (mint <= maxt);
             if (likely(dr::any(active))) {
                 if (likely(!node->leaf())) { // Inner node
-                    const dr::scalar_t<Float> split = node->split();
-                    const uint32_t axis = node->axis();
+                    const ScalarFloat split = node->split();
+                    const uint32_t axis     = node->axis();
 
                     // Compute parametric distance along the rays to the split plane
-                    Float t_plane          = (split - ray.o[axis]) * ray.d_rcp[axis];
-                    Mask left_first        = (ray.o[axis] < split) ||
-                                              (dr::eq(ray.o[axis], split) && ray.d[axis] >= 0.f),
-                         start_after       = t_plane < mint,
-                         end_before        = t_plane > maxt || t_plane < 0.f || !dr::isfinite(t_plane),
-                         single_node       = start_after || end_before,
-                         visit_left        = dr::eq(end_before, left_first),
-                         visit_only_left   = single_node &&  visit_left,
-                         visit_only_right  = single_node && !visit_left;
+                    FloatP t_plane        = (split - o[axis]) * d_rcp[axis];
+                    MaskP left_first      = (o[axis] < split) ||
+                                            (dr::eq(o[axis], split) && d[axis] >= 0.f),
+                          start_after     = t_plane < mint,
+                          end_before      = t_plane > maxt || t_plane < 0.f ||
+                                            !dr::isfinite(t_plane),
+                          single_node     = start_after || end_before,
+                          visit_left      = dr::eq(end_before, left_first),
+                          visit_only_left = single_node &&  visit_left,
+                          visit_only_right = single_node && !visit_left;
 
                     bool all_visit_only_left  = dr::all(visit_only_left || !active),
-                         all_visit_only_right = dr::all(visit_only_right || !active),
-                         all_visit_same_node  = all_visit_only_left || all_visit_only_right;
+                         all_visit_only_right = dr::all(visit_only_right || !active);
 
-                    /* If we only need to visit one node, just pick the correct one and continue */
-                    if (all_visit_same_node) {
+                    /* If every lane only needs to visit one (and the same)
+                       child, just pick the correct one and continue */
+                    if (all_visit_only_left || all_visit_only_right) {
                         node = node->left() + (all_visit_only_left ? 0 : 1);
                         continue;
                     }
 
-                    size_t left_votes  = count(left_first && active),
-                           right_votes = count(!left_first && active);
+                    size_t left_votes  = dr::count(left_first && active),
+                           right_votes = dr::count(!left_first && active);
 
                     bool go_left = left_votes >= right_votes;
 
-                    Mask go_left_bcast = Mask(go_left),
-                         correct_order = dr::eq(left_first, go_left_bcast),
-                         visit_both    = !single_node,
-                         visit_cur     = visit_both || eq (visit_left, go_left_bcast),
-                         visit_next    = visit_both || dr::neq(visit_left, go_left_bcast);
+                    MaskP go_left_bcast = MaskP(go_left),
+                          correct_order = dr::eq(left_first, go_left_bcast),
+                          visit_both    = !single_node,
+                          visit_cur     = visit_both || dr::eq(visit_left, go_left_bcast),
+                          visit_next    = visit_both || dr::neq(visit_left, go_left_bcast);
 
-                    /* Visit both child nodes in the right order */
+                    /* Visit both child nodes in the voted order */
                     Index node_offset = go_left ? 0 : 1;
                     const KDNode *left   = node->left(),
                                  *n_cur  = left + node_offset,
                                  *n_next = left + (1 - node_offset);
 
                     /* Postpone visit to 'n_next' */
-                    Mask sel0 =  correct_order && visit_both,
-                         sel1 = !correct_order && visit_both;
+                    MaskP sel0 =  correct_order && visit_both,
+                          sel1 = !correct_order && visit_both;
                     KDStackEntry& entry = stack[stack_index++];
                     entry.mint = dr::select(sel0, t_plane, mint);
                     entry.maxt = dr::select(sel1, t_plane, maxt);
@@ -2386,19 +2448,32 @@ public:
                 } else if (node->primitive_count() > 0) { // Arrived at a leaf node
                     Index prim_start = node->primitive_offset();
                     Index prim_end = prim_start + node->primitive_count();
-                    for (Index i = prim_start; i < prim_end; i++) {
-                        Index prim_index = m_indices[i];
+                    for (size_t l = 0; l < Width; ++l) {
+                        if (!active[l])
+                            continue;
+
+                        ScalarRay3f ray_l = lane_ray(l, t_cur[l]);
 
-                        PreliminaryIntersection3f prim_pi =
-                            intersect_prim<ShadowRay>(prim_index, ray, active);
+                        for (Index i = prim_start; i < prim_end; i++) {
+                            Index prim_index = m_indices[i];
 
-                        dr::masked(pi, prim_pi.is_valid()) = prim_pi;
+                            PreliminaryIntersection<ScalarFloat, Shape> prim_pi =
+                                intersect_prim<ShadowRay>(prim_index, ray_l);
 
-                        if constexpr (!ShadowRay) {
-                            Assert(dr::all(!prim_pi.is_valid() ||
-                                       (prim_pi.t >= ray.mint &&
-                                        prim_pi.t <= ray.maxt)));
-                            dr::masked(ray.maxt, prim_pi.is_valid()) = prim_pi.t;
+                            if (unlikely(prim_pi.is_valid())) {
+                                if constexpr (ShadowRay) {
+                                    /* Global index, see ray_test_prim() */
+                                    prim_pi.prim_index = prim_index;
+                                    pis[l] = prim_pi;
+                                    t_cur[l] = -dr::Infinity<ScalarFloat>;
+                                    break;
+                                }
+
+                                Assert(prim_pi.t >= 0.f && prim_pi.t <= ray_l.maxt);
+                                pis[l] = prim_pi;
+                                ray_l.maxt = prim_pi.t;
+                                t_cur[l] = prim_pi.t;
+                            }
                         }
                     }
                 }
@@ -2408,17 +2483,14 @@ public:
                 --stack_index;
                 KDStackEntry& entry = stack[stack_index];
                 mint = entry.mint;
-                maxt = dr::minimum(entry.maxt, ray.maxt);
+                maxt = dr::minimum(entry.maxt, dr::load<FloatP>(t_cur));
                 active = entry.active;
                 node = entry.node;
             } else {
                 break;
             }
         }
-
-        return pi;
     }
-#endif
 
     /// Brute force intersection routine for debugging purposes
     template <bool ShadowRay>
@@ -2433,6 +2505,8 @@ public:
                 if constexpr (dr::is_array_v<Float>) {
                     dr::masked(pi, prim_pi.is_valid()) = prim_pi;
                 } else if (prim_pi.is_valid()) {
+                    if constexpr (ShadowRay)
+                        prim_pi.prim_index = i; // global index, see ray_test_prim()
                     pi = prim_pi;
                     ray.maxt = prim_pi.t;
                 }
@@ -2447,6 +2521,124 @@ public:
         }
     }
 
+    /**
+     * \brief Test a single primitive (identified by its global kd-tree
+     * primitive index) for occlusion, without traversing the tree.
+     *
+     * This is useful to cheaply re-test the occluder reported by a previous
+     * shadow ray query before paying for a full traversal.
+     */
+    MI_INLINE bool ray_test_prim(Index prim_index, const ScalarRay3f &ray) const {
+        return intersect_prim<true>(prim_index, ray).is_valid();
+    }
+
+    /**
+     * \brief Node of the optional 8-wide BVH (see the \c qbvh scene property)
+     *
+     * The bounding boxes of up to 8 children are stored in SoA layout so
+     * that a single packet of arithmetic tests all of them at once. Each
+     * child slot holds either the index of another QBVH node (> 0), an
+     * encoded leaf referencing a range of \ref m_qbvh_indices (< 0), or the
+     * value 0 to mark an empty slot (the root node can never be a child).
+     * Empty slots carry inverted bounding boxes so that the packet test
+     * rejects them without a special case.
+     */
+    struct QBVH8Node {
+        ScalarFloat min_x[8], min_y[8], min_z[8];
+        ScalarFloat max_x[8], max_y[8], max_z[8];
+        int32_t child[8];
+    };
+
+    /// Maximum number of primitives referenced by a QBVH leaf
+    static constexpr Size QBVHLeafSize = 4;
+
+    /// Traverse the 8-wide BVH (built when the \c qbvh property is set)
+    template <bool ShadowRay>
+    PreliminaryIntersection<ScalarFloat, Shape>
+    ray_intersect_qbvh(ScalarRay3f ray) const {
+        using FloatP = dr::Array<ScalarFloat, 8>;
+        using MaskP  = dr::mask_t<FloatP>;
+
+        PreliminaryIntersection<ScalarFloat, Shape> pi;
+
+        int32_t stack[256];
+        int32_t stack_index = 0, node_index = 0;
+
+        ScalarVector3f d_rcp = dr::rcp(ray.d);
+
+        while (true) {
+            const QBVH8Node &node = m_qbvh_nodes[node_index];
+
+            /* 8-wide ray/AABB slab test */
+            FloatP t0x = (dr::load<FloatP>(node.min_x) - ray.o.x()) * d_rcp.x(),
+                   t1x = (dr::load<FloatP>(node.max_x) - ray.o.x()) * d_rcp.x(),
+                   t0y = (dr::load<FloatP>(node.min_y) - ray.o.y()) * d_rcp.y(),
+                   t1y = (dr::load<FloatP>(node.max_y) - ray.o.y()) * d_rcp.y(),
+                   t0z = (dr::load<FloatP>(node.min_z) - ray.o.z()) * d_rcp.z(),
+                   t1z = (dr::load<FloatP>(node.max_z) - ray.o.z()) * d_rcp.z();
+
+            FloatP t_near = dr::maximum(dr::maximum(dr::minimum(t0x, t1x),
+                                                    dr::minimum(t0y, t1y)),
+                                        dr::maximum(dr::minimum(t0z, t1z),
+                                                    FloatP(0.f))),
+                   t_far  = dr::minimum(dr::minimum(dr::maximum(t0x, t1x),
+                                                    dr::maximum(t0y, t1y)),
+                                        dr::minimum(dr::maximum(t0z, t1z),
+                                                    FloatP(ray.maxt)));
+
+            MaskP hit = t_near <= t_far;
+
+            for (int i = 0; i < 8; ++i) {
+                if (!hit[i])
+                    continue;
+
+                int32_t child = node.child[i];
+                if (child > 0) {
+                    Assert(stack_index < 256);
+                    stack[stack_index++] = child;
+                } else if (child < 0) {
+                    uint32_t bits   = (uint32_t) (-child - 1);
+                    Size     offset = bits >> 4,
+                             count  = bits & 0xfu;
+
+                    for (Size j = 0; j < count; ++j) {
+                        Index prim_index = m_qbvh_indices[offset + j];
+
+                        PreliminaryIntersection<ScalarFloat, Shape> prim_pi =
+                            intersect_prim<ShadowRay>(prim_index, ray);
+
+                        if (unlikely(prim_pi.is_valid())) {
+                            if constexpr (ShadowRay) {
+                                // Global index, see ray_test_prim()
+                                prim_pi.prim_index = prim_index;
+                                return prim_pi;
+                            }
+
+                            Assert(prim_pi.t >= 0.f && prim_pi.t <= ray.maxt);
+                            pi = prim_pi;
+                            ray.maxt = pi.t;
+                        }
+                    }
+                }
+            }
+
+            if (stack_index == 0)
+                break;
+            node_index = stack[--stack_index];
+        }
+
+        return pi;
+    }
+
+    /**
+     * \brief Build the optional 8-wide BVH over all scene primitives
+     *
+     * Invoked by \ref build() when the \c qbvh property was set. The
+     * structure complements the kd-tree: scalar traversal entry points
+     * prefer it when present.
+     */
+    void build_qbvh();
+
     /// Return a human-readable string representation of the scene contents.
     virtual std::string to_string() const override;
 
@@ -2522,6 +2714,11 @@ protected:
 protected:
     std::vector<ref<Shape>> m_shapes;
     std::vector<Size> m_primitive_map;
+
+    /// 8-wide BVH (only present when the \c qbvh property was set)
+    std::vector<QBVH8Node> m_qbvh_nodes;
+    std::vector<Index> m_qbvh_indices;
+    bool m_use_qbvh = false;
 };
 
 MI_EXTERN_CLASS(ShapeKDTree)
@@ -22,6 +22,26 @@ public:
     get_majorant(const MediumInteraction3f &mi,
                  Mask active = true) const = 0;
 
+    /**
+     * \brief Returns the majorant along a ray segment together with the
+     * distance at which it expires
+     *
+     * Media that maintain local majorants (see the
+     * :paramtype:`majorant_resolution_factor` parameter of the
+     * :ref:`heterogeneous <medium-heterogeneous>` plugin) return the
+     * majorant of the cell containing <tt>ray(mint)</tt> and the ray
+     * distance at which that cell is exited. \ref sample_interaction()
+     * turns tentative collisions beyond the expiry distance into forced
+     * null collisions at the cell boundary, from which the next iteration
+     * of the integrator's null-scattering loop resumes -- effectively a DDA
+     * over the majorant cells. The default implementation returns the
+     * global majorant of \ref get_majorant() and an infinite expiry
+     * distance.
+     */
+    virtual std::pair<UnpolarizedSpectrum, Float>
+    get_majorant_segment(const Ray3f &ray, Float mint, Float maxt,
+                         Mask active = true) const;
+
     /// Returns the medium coefficients Sigma_s, Sigma_n and Sigma_t evaluated
     /// at a given MediumInteraction mi
     virtual std::tuple<UnpolarizedSpectrum, UnpolarizedSpectrum,
@@ -29,6 +49,23 @@ public:
     get_scattering_coefficients(const MediumInteraction3f &mi,
                                 Mask active = true) const = 0;
 
+    /**
+     * \brief Transmittance-only variant of \ref get_scattering_coefficients()
+     *
+     * Integrators invoke this method when estimating the transmittance along
+     * shadow rays, where only the null component Sigma_n and the majorant
+     * enter the estimator. Media may override it to answer the query from a
+     * coarser representation of the underlying density (see the
+     * :paramtype:`shadow_mip_level` parameter of the
+     * :ref:`heterogeneous <medium-heterogeneous>` plugin) and are free to
+     * return a zero-valued Sigma_s. The default implementation forwards to
+     * \ref get_scattering_coefficients().
+     */
+    virtual std::tuple<UnpolarizedSpectrum, UnpolarizedSpectrum,
+                       UnpolarizedSpectrum>
+    get_scattering_coefficients_tr(const MediumInteraction3f &mi,
+                                   Mask active = true) const;
+
     /**
      * \brief Sample a free-flight distance in the medium.
      *
@@ -50,6 +87,19 @@ public:
     MediumInteraction3f sample_interaction(const Ray3f &ray, Float sample,
                                            UInt32 channel, Mask active) const;
 
+    /**
+     * \brief Variant of \ref sample_interaction() for transmittance-only
+     * queries (e.g. shadow rays)
+     *
+     * This method is identical to \ref sample_interaction() except that the
+     * scattering coefficients of the returned interaction are obtained via
+     * \ref get_scattering_coefficients_tr(), which media may answer from a
+     * coarser density representation. The \c sigma_s field of the returned
+     * interaction should not be relied upon in this mode.
+     */
+    MediumInteraction3f sample_interaction_tr(const Ray3f &ray, Float sample,
+                                              UInt32 channel, Mask active) const;
+
     /**
      * \brief Compute the transmittance and PDF
      *
@@ -69,11 +119,39 @@ public:
     eval_tr_and_pdf(const MediumInteraction3f &mi,
                     const SurfaceInteraction3f &si, Mask active) const;
 
+    /**
+     * \brief Evaluate the emission coefficient of the medium
+     *
+     * Returns the emitted radiance per unit length at the given interaction
+     * (i.e. the product of the absorption coefficient and the emitted
+     * radiance). The default implementation returns zero.
+     */
+    virtual UnpolarizedSpectrum get_emission(const MediumInteraction3f &mi,
+                                             Mask active = true) const;
+
+    /**
+     * \brief Importance sample a position inside the emissive region
+     *
+     * Draws a world-space point proportional to the medium's emission (see
+     * the importance table of the :ref:`heterogeneous <medium-heterogeneous>`
+     * plugin) and returns it along with its sample density per unit volume.
+     * A zero density indicates failure (e.g. a medium without emission).
+     */
+    virtual std::pair<Point3f, Float>
+    sample_emission_point(const Point3f &sample, Mask active = true) const;
+
+    /// Evaluate the density of \ref sample_emission_point() per unit volume
+    virtual Float pdf_emission_point(const Point3f &p,
+                                     Mask active = true) const;
+
     /// Return the phase function of this medium
     MI_INLINE const PhaseFunction *phase_function() const {
         return m_phase_function.get();
     }
 
+    /// Returns whether this medium emits radiance (see \ref get_emission())
+    MI_INLINE bool is_emitter() const { return m_is_emitter; }
+
     /// Returns whether this specific medium instance uses emitter sampling
     MI_INLINE bool use_emitter_sampling() const { return m_sample_emitters; }
 
@@ -104,9 +182,15 @@ protected:
     Medium(const Properties &props);
     virtual ~Medium();
 
+    /// Shared implementation of \ref sample_interaction() and \ref sample_interaction_tr()
+    MediumInteraction3f sample_interaction_impl(const Ray3f &ray, Float sample,
+                                                UInt32 channel, Mask active,
+                                                bool tr_only) const;
+
 protected:
     ref<PhaseFunction> m_phase_function;
     bool m_sample_emitters, m_is_homogeneous, m_has_spectral_extinction;
+    bool m_is_emitter = false;
 
     /// Identifier (if available)
     std::string m_id;
@@ -124,11 +208,17 @@ DRJIT_VCALL_TEMPLATE_BEGIN(mitsuba::Medium)
     DRJIT_VCALL_GETTER(use_emitter_sampling, bool)
     DRJIT_VCALL_GETTER(is_homogeneous, bool)
     DRJIT_VCALL_GETTER(has_spectral_extinction, bool)
+    DRJIT_VCALL_GETTER(is_emitter, bool)
+    DRJIT_VCALL_METHOD(get_emission)
+    DRJIT_VCALL_METHOD(sample_emission_point)
+    DRJIT_VCALL_METHOD(pdf_emission_point)
     DRJIT_VCALL_METHOD(get_majorant)
     DRJIT_VCALL_METHOD(intersect_aabb)
     DRJIT_VCALL_METHOD(sample_interaction)
+    DRJIT_VCALL_METHOD(sample_interaction_tr)
     DRJIT_VCALL_METHOD(eval_tr_and_pdf)
     DRJIT_VCALL_METHOD(get_scattering_coefficients)
+    DRJIT_VCALL_METHOD(get_scattering_coefficients_tr)
 DRJIT_VCALL_TEMPLATE_END(mitsuba::Medium)
 
 //! @}
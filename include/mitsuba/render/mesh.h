@@ -102,6 +102,11 @@ public:
     MI_INLINE auto vertex_normal(Index index,
                                  dr::mask_t<Index> active = true) const {
         using Result = Normal<dr::replace_scalar_t<Index, InputFloat>, 3>;
+        if (unlikely(dr::width(m_vertex_normals_packed) != 0)) {
+            auto packed = dr::gather<dr::uint32_array_t<Index>>(
+                m_vertex_normals_packed, index, active);
+            return oct_decode<Result>(packed);
+        }
         return dr::gather<Result>(m_vertex_normals, index, active);
     }
 
@@ -110,14 +115,25 @@ public:
     MI_INLINE auto vertex_texcoord(Index index,
                                    dr::mask_t<Index> active = true) const {
         using Result = Point<dr::replace_scalar_t<Index, InputFloat>, 2>;
+        if (unlikely(dr::width(m_vertex_texcoords_packed) != 0)) {
+            auto packed = dr::gather<dr::uint32_array_t<Index>>(
+                m_vertex_texcoords_packed, index, active);
+            return half2_decode<Result>(packed);
+        }
         return dr::gather<Result>(m_vertex_texcoords, index, active);
     }
 
     /// Does this mesh have per-vertex normals?
-    bool has_vertex_normals() const { return dr::width(m_vertex_normals) != 0; }
+    bool has_vertex_normals() const {
+        return dr::width(m_vertex_normals) != 0 ||
+               dr::width(m_vertex_normals_packed) != 0;
+    }
 
     /// Does this mesh have per-vertex texture coordinates?
-    bool has_vertex_texcoords() const { return dr::width(m_vertex_texcoords) != 0; }
+    bool has_vertex_texcoords() const {
+        return dr::width(m_vertex_texcoords) != 0 ||
+               dr::width(m_vertex_texcoords_packed) != 0;
+    }
 
     /// Does this mesh have additional mesh attributes?
     bool has_mesh_attributes() const { return m_mesh_attributes.size() > 0; }
@@ -144,12 +160,160 @@ public:
      */
     void write_ply(Stream *stream) const;
 
+    /**
+     * \brief Write the mesh as an uncompressed Serialized (V5) file
+     *
+     * Version 5 of the Serialized format stores the vertex and face buffers
+     * without zlib compression and aligns them to 64-byte file offsets.
+     * Files produced by this method can be loaded by the
+     * <tt>serialized</tt> shape plugin without any decompression or copy:
+     * the plugin memory-maps the file and references the arrays in place.
+     * Vertex positions and normals are written in their current (i.e.
+     * object-space) form; mesh attributes are not supported by the format
+     * and are skipped with a warning.
+     *
+     * \param filename
+     *    Target file path on disk
+     */
+    void write_serialized(const std::string &filename) const;
+
+    /**
+     * \brief Write a binary snapshot of the mesh geometry that
+     * \ref read_cache() can later restore
+     *
+     * The snapshot stores the raw vertex and face buffers as produced by the
+     * loader together with \c hash, which should combine a content hash of
+     * the source file with any loader parameters that affect the generated
+     * buffers (see \ref content_hash()). Text-based loaders use this to
+     * bypass repeated parsing of large input files. The file is written to a
+     * temporary name and atomically renamed into place, so that concurrent
+     * loads of the same source never observe a partially written snapshot.
+     * Mesh attributes are not covered -- callers should skip the cache when
+     * attributes are present.
+     */
+    void write_cache(const fs::path &filename, uint64_t hash) const;
+
+    /**
+     * \brief Attempt to restore the mesh geometry from a binary snapshot
+     * (see \ref write_cache())
+     *
+     * Returns \c false without reporting an error when the file does not
+     * exist, is malformed, or records a hash other than \c hash (e.g.
+     * because the source file changed after the snapshot was written).
+     */
+    bool read_cache(const fs::path &filename, uint64_t hash);
+
+    /// Chainable FNV-1a hash, used to validate geometry snapshots
+    static uint64_t content_hash(const void *data, size_t size,
+                                 uint64_t hash = 0xcbf29ce484222325ull);
+
     /// Merge two meshes into one
     ref<Mesh> merge(const Mesh *other) const;
 
-    /// Compute smooth vertex normals and replace the current normal values
+    /**
+     * \brief Merge a whole set of compatible meshes into one
+     *
+     * In contrast to repeated pairwise \ref merge() calls, which copy the
+     * accumulated buffers once per input, this entry point precomputes the
+     * per-input offsets, allocates the output a single time, and blits the
+     * input buffers concurrently over the thread pool. A single input is
+     * returned as-is without any copy. When \c weld is set, vertices with
+     * bit-identical position/normal/texcoord records are additionally
+     * collapsed into one.
+     */
+    static ref<Mesh> merge_many(const std::vector<const Mesh *> &meshes,
+                                bool weld = false);
+
+    /**
+     * \brief Compute smooth vertex normals and replace the current normal
+     * values
+     *
+     * In scalar modes, this doubles as a fused post-processing pass: the
+     * bounding box is refreshed and, for emitter/sensor meshes, the
+     * surface-area sampling table (see \ref build_pmf()) is built as a
+     * by-product of the same traversal of the index buffer.
+     */
     void recompute_vertex_normals();
 
+    /**
+     * \brief Reorder the mesh buffers for cache-coherent hit shading
+     *
+     * Sorts the faces along a Morton curve over their centroids and remaps
+     * the vertices to first-use order, so that spatially adjacent triangles
+     * (which tend to be intersected by nearby rays) also end up adjacent in
+     * memory. Invoked from \ref initialize() when the \c reorder mesh
+     * parameter is set.
+     */
+    void reorder_morton();
+
+    /**
+     * \brief Tessellate and displace the mesh along its vertex normals
+     *
+     * When the \c displacement mesh parameter references a texture, this
+     * function first subdivides every face \c displacement_levels times (each
+     * level splits a triangle into four at its edge midpoints) and then
+     * offsets every vertex along its shading normal by the texture value at
+     * the vertex UV coordinates, scaled by \c displacement_scale. Invoked
+     * once from \ref initialize() after the loader has filled the mesh
+     * buffers; vertex normals and the bounding box are recomputed afterwards
+     * to match the displaced geometry.
+     */
+    void displace();
+
+    /**
+     * \brief Convert the vertex normal and texture coordinate buffers into a
+     * compact representation
+     *
+     * Normals are mapped onto the octahedron and stored with 16 bits per
+     * component; texture coordinates are stored as half precision floats.
+     * Either is packed into a single 32-bit word per vertex and decoded on
+     * the fly by \ref vertex_normal() and \ref vertex_texcoord(), halving
+     * the memory footprint of these two buffers with no visually relevant
+     * loss of precision. Invoked from \ref initialize() when the
+     * \c compress_attributes mesh parameter is set. Calling the function on
+     * already-compressed buffers is a no-op.
+     */
+    void compress_vertex_attributes();
+
+    /**
+     * \brief Return the vertex normals as a plain float buffer, decoding the
+     * compressed representation when necessary (see
+     * \ref compress_vertex_attributes())
+     */
+    FloatStorage decoded_vertex_normals() const;
+
+    /// Analogous to \ref decoded_vertex_normals() for texture coordinates
+    FloatStorage decoded_vertex_texcoords() const;
+
+    /// Decode an octahedral-mapped unit vector stored as 2x16 bits
+    template <typename Result, typename UInt>
+    MI_INLINE static Result oct_decode(const UInt &p) {
+        using Value = dr::value_t<Result>;
+        Value u = dr::fmsub(Value(p & 0xFFFFu), InputFloat(2.f / 65535.f), 1.f),
+              v = dr::fmsub(Value(p >> 16),     InputFloat(2.f / 65535.f), 1.f);
+        Value z = 1.f - dr::abs(u) - dr::abs(v);
+        auto neg = z < 0.f;
+        Value x = dr::select(neg, (1.f - dr::abs(v)) * dr::copysign(Value(1.f), u), u),
+              y = dr::select(neg, (1.f - dr::abs(u)) * dr::copysign(Value(1.f), v), v);
+        return dr::normalize(Result(x, y, z));
+    }
+
+    /// Decode a pair of half precision values packed into a 32-bit word
+    template <typename Result, typename UInt>
+    MI_INLINE static Result half2_decode(const UInt &p) {
+        using Value = dr::value_t<Result>;
+        auto decode = [](const UInt &h) -> Value {
+            /* Shift exponent and mantissa into single precision position and
+               rebias the exponent; magnitudes below the smallest normalized
+               half value (including signed zeros) flush to zero */
+            UInt em = h & 0x7FFFu;
+            Value mag = dr::reinterpret_array<Value>((em << 13) + 0x38000000u);
+            mag = dr::select(em >= 0x0400u, mag, Value(0.f));
+            return dr::select(dr::neq(h & 0x8000u, 0u), -mag, mag);
+        };
+        return Result(decode(p & 0xFFFFu), decode(p >> 16));
+    }
+
     /// Recompute the bounding box (e.g. after modifying the vertex positions)
     void recompute_bbox();
 
@@ -284,6 +448,9 @@ public:
 #if defined(MI_ENABLE_EMBREE)
     /// Return the Embree version of this shape
     virtual RTCGeometry embree_geometry(RTCDevice device) override;
+
+    /// Push updated vertex data into an attached geometry and refit its BVH
+    virtual bool embree_refit(RTCGeometry geom) const override;
 #endif
 
 #if defined(MI_ENABLE_CUDA)
@@ -327,12 +494,30 @@ protected:
      */
     void build_parameterization();
 
+    /**
+     * \brief Build the packed per-triangle cache used by \ref
+     * sample_position()
+     *
+     * Copies the data of each triangle (first vertex and edge vectors,
+     * optionally vertex normals and texture coordinates) into contiguous
+     * per-face SoA arrays so that position sampling performs a single
+     * indirection per attribute rather than chasing the face index buffer
+     * into scattered vertex data. Thread-safe, since it uses a mutex.
+     */
+    void build_sample_cache();
+
     // Ensures that the sampling table are ready.
     DRJIT_INLINE void ensure_pmf_built() const {
         if (unlikely(m_area_pmf.empty()))
             const_cast<Mesh *>(this)->build_pmf();
     }
 
+    // Ensures that the position sampling cache is ready.
+    DRJIT_INLINE void ensure_sample_cache_built() const {
+        if (unlikely(!m_sample_cache.valid))
+            const_cast<Mesh *>(this)->build_sample_cache();
+    }
+
     /** \brief Moeller and Trumbore algorithm for computing ray-triangle
      * intersection
      *
@@ -381,7 +566,7 @@ protected:
 
     MI_DECLARE_CLASS()
 
-protected:
+public:
     enum MeshAttributeType {
         Vertex, Face
     };
@@ -396,6 +581,36 @@ protected:
         }
     };
 
+    /**
+     * \brief Resolve a named attribute to its storage record
+     *
+     * The returned handle stays valid for the lifetime of the mesh and can
+     * be passed to the handle-based \ref eval_attribute() overloads below,
+     * which skip the string-based lookup performed by the name-based
+     * interface on every call. Returns \c nullptr if no attribute with the
+     * given name exists.
+     */
+    const MeshAttribute *find_attribute(const std::string &name) const {
+        auto it = m_mesh_attributes.find(name);
+        return it != m_mesh_attributes.end() ? &it->second : nullptr;
+    }
+
+    /// Evaluate an attribute resolved via \ref find_attribute()
+    UnpolarizedSpectrum eval_attribute(const MeshAttribute &attr,
+                                       const SurfaceInteraction3f &si,
+                                       Mask active = true) const;
+
+    /// Monochromatic evaluation of an attribute resolved via \ref find_attribute()
+    Float eval_attribute_1(const MeshAttribute &attr,
+                           const SurfaceInteraction3f &si,
+                           Mask active = true) const;
+
+    /// Trichromatic evaluation of an attribute resolved via \ref find_attribute()
+    Color3f eval_attribute_3(const MeshAttribute &attr,
+                             const SurfaceInteraction3f &si,
+                             Mask active = true) const;
+
+protected:
     template <uint32_t Size, bool Raw>
     auto interpolate_attribute(MeshAttributeType type,
                                const FloatStorage &buf,
@@ -451,6 +666,14 @@ protected:
     mutable FloatStorage m_vertex_normals;
     mutable FloatStorage m_vertex_texcoords;
 
+    /* Optional compact storage for normals (octahedral, 2x16 bit) and
+       texture coordinates (2x half precision). When non-empty, the matching
+       float buffer above is released and the \ref vertex_normal() /
+       \ref vertex_texcoord() accessors decode on the fly
+       (see \ref compress_vertex_attributes()) */
+    mutable DynamicBuffer<UInt32> m_vertex_normals_packed;
+    mutable DynamicBuffer<UInt32> m_vertex_texcoords_packed;
+
     mutable DynamicBuffer<UInt32> m_faces;
 
 #if defined(MI_ENABLE_LLVM) && !defined(MI_ENABLE_EMBREE)
@@ -470,11 +693,35 @@ protected:
     bool m_face_normals = false;
     bool m_flip_normals = false;
 
+    /// Sort faces/vertices into Morton order (see \ref reorder_morton())
+    bool m_reorder = false;
+
+    /// Compress normals/UVs after loading (see \ref compress_vertex_attributes())
+    bool m_compress_attributes = false;
+
+    /// Optional displacement map applied after loading (see \ref displace())
+    ref<Texture> m_displacement;
+    ScalarFloat m_displacement_scale = 1.f;
+    uint32_t m_displacement_levels = 0;
+    bool m_displacement_applied = false;
+
     /* Surface area distribution -- generated on demand when \ref
        prepare_area_pmf() is first called. */
     DiscreteDistribution<Float> m_area_pmf;
     std::mutex m_mutex;
 
+    /* Packed per-triangle data in SoA layout -- generated on demand when
+       \ref sample_position() is first called (e.g. for area emitters),
+       see \ref build_sample_cache(). The normal and texture coordinate
+       arrays remain empty when the mesh lacks the respective attribute. */
+    struct PositionSampleCache {
+        FloatStorage p0, e0, e1;    ///< First vertex and edges (3 entries/face)
+        FloatStorage n0, n1, n2;    ///< Vertex normals (3 entries/face)
+        FloatStorage uv0, uv1, uv2; ///< Texture coordinates (2 entries/face)
+        bool valid = false;
+    };
+    PositionSampleCache m_sample_cache;
+
     /// Optional: used in eval_parameterization()
     ref<Scene<Float, Spectrum>> m_parameterization;
 
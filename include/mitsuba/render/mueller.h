@@ -171,6 +171,44 @@ MuellerMatrix<Float> rotator(Float theta) {
     );
 }
 
+/**
+  * \brief Computes rotator(theta_out) * M * transpose(rotator(theta_in))
+  *
+  * This product arises whenever a Mueller matrix is re-expressed with
+  * respect to rotated input/output Stokes bases. Rotators are the identity
+  * except for a central 2x2 rotation block, so the two matrix products are
+  * expanded analytically here: this touches only rows/columns 1 and 2 of
+  * \c M instead of performing two dense 4x4 multiplications. In particular,
+  * matrices with depolarizer structure (as returned by all unpolarized
+  * scattering models) pass through unchanged up to constant folding, which
+  * keeps them cheap in JIT-compiled variants.
+  */
+template <typename Float>
+MuellerMatrix<Float> rotated_mueller(Float theta_out,
+                                     const MuellerMatrix<Float> &M,
+                                     Float theta_in) {
+    auto [s_i, c_i] = dr::sincos(2.f * theta_in);
+    auto [s_o, c_o] = dr::sincos(2.f * theta_out);
+
+    // M * transpose(rotator(theta_in)) only mixes columns 1 and 2
+    MuellerMatrix<Float> B = M;
+    for (size_t i = 0; i < 4; ++i) {
+        Float m1 = M(i, 1), m2 = M(i, 2);
+        B(i, 1) = dr::fmadd(c_i, m1, s_i * m2);
+        B(i, 2) = dr::fnmadd(s_i, m1, c_i * m2);
+    }
+
+    // rotator(theta_out) * B only mixes rows 1 and 2
+    MuellerMatrix<Float> result = B;
+    for (size_t j = 0; j < 4; ++j) {
+        Float b1 = B(1, j), b2 = B(2, j);
+        result(1, j) = dr::fmadd(c_o, b1, s_o * b2);
+        result(2, j) = dr::fnmadd(s_o, b1, c_o * b2);
+    }
+
+    return result;
+}
+
 /**
   * \brief Applies a counter-clockwise rotation to the mueller matrix
   * of a given element.
@@ -178,8 +216,7 @@ MuellerMatrix<Float> rotator(Float theta) {
 template <typename Float>
 MuellerMatrix<Float> rotated_element(Float theta,
                                      const MuellerMatrix<Float> &M) {
-    MuellerMatrix<Float> R = rotator(theta), Rt = transpose(R);
-    return Rt * M * R;
+    return rotated_mueller(-theta, M, -theta);
 }
 
 /**
@@ -286,6 +323,37 @@ Vector3 stokes_basis(const Vector3 &forward) {
     return coordinate_system(forward).first;
 }
 
+/**
+ * \brief Gives the rotation angle that aligns the reference frames (defined by
+ * their respective basis vectors) of two collinear stokes vectors.
+ *
+ * This is the angle underlying \ref rotate_stokes_basis(); passing it to
+ * \ref rotated_mueller() avoids materializing the rotator matrices.
+ *
+ * \param forward
+ *      Direction of travel for Stokes vector (normalized)
+ *
+ * \param basis_current
+ *      Current (normalized) Stokes basis. Must be orthogonal to \c forward.
+ *
+ * \param basis_target
+ *      Target (normalized) Stokes basis. Must be orthogonal to \c forward.
+ *
+ * \return
+ *      Counter-clockwise rotation angle (as seen from the sensor side).
+ */
+template <typename Vector3,
+          typename Float = dr::value_t<Vector3>>
+Float stokes_basis_angle(const Vector3 &forward,
+                         const Vector3 &basis_current,
+                         const Vector3 &basis_target) {
+    Float theta = unit_angle(dr::normalize(basis_current),
+                             dr::normalize(basis_target));
+
+    dr::masked(theta, dr::dot(forward, dr::cross(basis_current, basis_target)) < 0) *= -1.f;
+    return theta;
+}
+
 /**
  * \brief Gives the Mueller matrix that aligns the reference frames (defined by
  * their respective basis vectors) of two collinear stokes vectors.
@@ -315,11 +383,7 @@ template <typename Vector3,
 MuellerMatrix rotate_stokes_basis(const Vector3 &forward,
                                   const Vector3 &basis_current,
                                   const Vector3 &basis_target) {
-    Float theta = unit_angle(dr::normalize(basis_current),
-                             dr::normalize(basis_target));
-
-    dr::masked(theta, dr::dot(forward, dr::cross(basis_current, basis_target)) < 0) *= -1.f;
-    return rotator(theta);
+    return rotator(stokes_basis_angle(forward, basis_current, basis_target));
 }
 
 /**
@@ -365,9 +429,9 @@ MuellerMatrix rotate_mueller_basis(const MuellerMatrix &M,
                                    const Vector3 &out_forward,
                                    const Vector3 &out_basis_current,
                                    const Vector3 &out_basis_target) {
-    MuellerMatrix R_in  = rotate_stokes_basis(in_forward, in_basis_current, in_basis_target);
-    MuellerMatrix R_out = rotate_stokes_basis(out_forward, out_basis_current, out_basis_target);
-    return R_out * M * transpose(R_in);
+    Float theta_in  = stokes_basis_angle(in_forward, in_basis_current, in_basis_target),
+          theta_out = stokes_basis_angle(out_forward, out_basis_current, out_basis_target);
+    return rotated_mueller(theta_out, M, theta_in);
 }
 
 /**
@@ -401,8 +465,8 @@ MuellerMatrix rotate_mueller_basis_collinear(const MuellerMatrix &M,
                                              const Vector3 &forward,
                                              const Vector3 &basis_current,
                                              const Vector3 &basis_target) {
-    MuellerMatrix R = rotate_stokes_basis(forward, basis_current, basis_target);
-    return R * M * transpose(R);
+    Float theta = stokes_basis_angle(forward, basis_current, basis_target);
+    return rotated_mueller(theta, M, theta);
 }
 
 NAMESPACE_END(mueller)
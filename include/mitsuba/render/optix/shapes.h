@@ -12,10 +12,13 @@
 #include "linearcurve.cuh"
 #else
 
+#include <cstring>
 #include <unordered_map>
 
 #include <drjit-core/optix.h>
 
+#include <mitsuba/core/filesystem.h>
+#include <mitsuba/core/fstream.h>
 #include <mitsuba/render/optix/common.h>
 #include <mitsuba/render/optix_api.h>
 #include <mitsuba/render/shape.h>
@@ -78,7 +81,7 @@ size_t get_shape_descr_idx(Shape *shape) {
 struct OptixAccelData {
     struct HandleData {
         OptixTraversableHandle handle = 0ull;
-        void* buffer = nullptr;
+        void* buffer = nullptr; /// Points into the shared arena below
         uint32_t count = 0u;
     };
     HandleData meshes;
@@ -86,14 +89,151 @@ struct OptixAccelData {
     HandleData linear_curves;
     HandleData custom_shapes;
 
+    /// Single arena allocation backing the compacted GAS of all handles above
+    void* buffer = nullptr;
+
     ~OptixAccelData() {
-        if (meshes.buffer) jit_free(meshes.buffer);
-        if (bspline_curves.buffer) jit_free(bspline_curves.buffer);
-        if (linear_curves.buffer) jit_free(linear_curves.buffer);
-        if (custom_shapes.buffer) jit_free(custom_shapes.buffer);
+        if (buffer) jit_free(buffer);
     }
 };
 
+/// Round a GAS size up to the alignment required by OptiX accel buffers
+inline size_t optix_accel_align(size_t size) {
+    return (size + (OPTIX_ACCEL_BUFFER_BYTE_ALIGNMENT - 1)) &
+           ~(OPTIX_ACCEL_BUFFER_BYTE_ALIGNMENT - 1);
+}
+
+/// Magic bytes and version number identifying a serialized GAS cache file
+static const char gas_cache_magic[4] = { 'M', 'G', 'A', 'S' };
+static const uint32_t gas_cache_version = 1;
+
+/**
+ * \brief Attempt to restore a previously serialized set of compacted GAS
+ * (see \ref build_gas)
+ *
+ * The file holds one record per geometry type containing the compacted GAS
+ * bytes together with the opaque OptiX relocation token of the device and
+ * driver that built it. Records are uploaded into a fresh arena allocation
+ * and patched in place via \c optixAccelRelocate. Returns \c false (leaving
+ * \c out_accel empty) when the file is unreadable, was written by an
+ * incompatible device/driver, or disagrees with the current shape partition;
+ * the caller then falls back to a full build.
+ */
+inline bool load_gas_cache(const OptixDeviceContext &context,
+                           const std::string &cache_file,
+                           const uint32_t expected_counts[4],
+                           OptixAccelData &out_accel) {
+    OptixAccelData::HandleData *handles[4] = {
+        &out_accel.meshes, &out_accel.bspline_curves,
+        &out_accel.linear_curves, &out_accel.custom_shapes
+    };
+
+    try {
+        ref<FileStream> stream = new FileStream(cache_file, FileStream::ERead);
+
+        char magic[4];
+        stream->read_array(magic, 4);
+        if (memcmp(magic, gas_cache_magic, 4) != 0)
+            Throw("not a GAS cache file");
+
+        uint32_t version, record_count;
+        stream->read(version);
+        if (version != gas_cache_version)
+            Throw("unsupported version %u", version);
+        stream->read(record_count);
+
+        uint32_t expected_records = 0;
+        for (uint32_t slot = 0; slot < 4; ++slot)
+            expected_records += expected_counts[slot] > 0 ? 1 : 0;
+        if (record_count != expected_records)
+            Throw("the cached geometry partition does not match the scene");
+
+        struct Record {
+            uint32_t slot, count;
+            size_t size;
+            OptixAccelRelocationInfo reloc;
+            std::unique_ptr<uint8_t[]> data;
+        };
+        std::vector<Record> records(record_count);
+
+        for (Record &rec : records) {
+            uint64_t size;
+            stream->read(rec.slot);
+            stream->read(rec.count);
+            stream->read(size);
+            stream->read_array(rec.reloc.info, 4);
+
+            if (rec.slot >= 4 || rec.count != expected_counts[rec.slot])
+                Throw("the cached geometry partition does not match the scene");
+
+            /* GAS built on another device generation or driver cannot be
+               relocated; this is an expected cache miss, not corruption */
+            int compatible = 0;
+            jit_optix_check(optixAccelCheckRelocationCompatibility(
+                context, &rec.reloc, &compatible));
+            if (!compatible) {
+                Log(Info, "GAS cache \"%s\" was built by an incompatible "
+                          "device or driver; rebuilding.", cache_file);
+                return false;
+            }
+
+            rec.size = (size_t) size;
+            rec.data.reset(new uint8_t[rec.size]);
+            stream->read_array(rec.data.get(), rec.size);
+        }
+
+        size_t arena_size = 0;
+        for (const Record &rec : records)
+            arena_size += optix_accel_align(rec.size);
+
+        uint8_t *arena = (uint8_t *) jit_malloc(AllocType::Device, arena_size);
+        out_accel.buffer = arena;
+
+        scoped_optix_context guard;
+
+        // Upload every GAS into its slice of the arena and patch it in place
+        size_t arena_offset = 0;
+        for (const Record &rec : records) {
+            void *target = arena + arena_offset;
+            jit_memcpy(JitBackend::CUDA, target, rec.data.get(), rec.size);
+
+            OptixAccelData::HandleData *handle = handles[rec.slot];
+            jit_optix_check(optixAccelRelocate(
+                context,
+                (CUstream) jit_cuda_stream(),
+                &rec.reloc,
+                0, 0, // no instance traversable handles (GAS only)
+                (CUdeviceptr) target,
+                rec.size,
+                &handle->handle
+            ));
+
+            handle->buffer = target;
+            handle->count = rec.count;
+            arena_offset += optix_accel_align(rec.size);
+        }
+
+        Log(Info, "Reused OptiX GAS cache \"%s\" (%zu KiB).", cache_file,
+            arena_size / 1024);
+        return true;
+    } catch (const std::exception &e) {
+        Log(Warn, "Failed to load GAS cache \"%s\": %s; rebuilding.",
+            cache_file, e.what());
+
+        // Roll back any partially restored state
+        for (OptixAccelData::HandleData *handle : handles) {
+            handle->handle = 0ull;
+            handle->buffer = nullptr;
+            handle->count = 0;
+        }
+        if (out_accel.buffer) {
+            jit_free(out_accel.buffer);
+            out_accel.buffer = nullptr;
+        }
+        return false;
+    }
+}
+
 /// Creates and appends the HitGroupSbtRecord for a given list of shapes
 template <typename Shape>
 void fill_hitgroup_records(std::vector<ref<Shape>> &shapes,
@@ -130,11 +270,24 @@ void fill_hitgroup_records(std::vector<ref<Shape>> &shapes,
  *
  * Two different GAS will be created for the meshes and the custom shapes. Optix
  * handles to those GAS will be stored in an \ref OptixAccelData.
+ *
+ * The individual builds are batched: a single temporary buffer (sized for the
+ * largest build) is reused by all of them, the compacted sizes are read back
+ * in one synchronous transfer, and the compacted GAS are packed into a single
+ * arena allocation. Compared to one allocation per GAS, this avoids
+ * fragmenting the device allocator in scenes with many shape groups and
+ * removes repeated build/readback synchronization points.
+ *
+ * When \c cache_file is non-empty, the compacted GAS are additionally
+ * serialized to that file after a successful build, and subsequent calls
+ * with matching geometry restore them via \ref load_gas_cache() instead of
+ * rebuilding (see the 'accel_cache' scene property).
  */
 template <typename Shape>
 void build_gas(const OptixDeviceContext &context,
                const std::vector<ref<Shape>> &shapes,
-               OptixAccelData& out_accel) {
+               OptixAccelData& out_accel,
+               const std::string &cache_file = "") {
 
     // Separate geometry types
     std::vector<ref<Shape>> meshes, bspline_curves,
@@ -150,101 +303,210 @@ void build_gas(const OptixDeviceContext &context,
             custom_shapes.push_back(shape);
     }
 
-    // Build a GAS given a subset of shape pointers
-    auto build_single_gas = [&context](const std::vector<ref<Shape>> &shape_subset,
-                                       OptixAccelData::HandleData &handle) {
-
-        OptixAccelBuildOptions accel_options = {};
-        accel_options.buildFlags = OPTIX_BUILD_FLAG_ALLOW_COMPACTION |
-                                   OPTIX_BUILD_FLAG_PREFER_FAST_TRACE;
-
-        accel_options.operation  = OPTIX_BUILD_OPERATION_BUILD;
-        accel_options.motionOptions.numKeys = 0;
-        if (handle.buffer) {
-            jit_free(handle.buffer);
-            handle.handle = 0ull;
-            handle.buffer = nullptr;
-            handle.count = 0;
-        }
+    // Release the result of a previous build, if any
+    for (OptixAccelData::HandleData *handle :
+         { &out_accel.meshes, &out_accel.bspline_curves,
+           &out_accel.linear_curves, &out_accel.custom_shapes }) {
+        handle->handle = 0ull;
+        handle->buffer = nullptr;
+        handle->count = 0;
+    }
+    if (out_accel.buffer) {
+        jit_free(out_accel.buffer);
+        out_accel.buffer = nullptr;
+    }
 
+    // Attempt to restore a previously serialized build (keyed by the caller)
+    uint32_t expected_counts[4] = { (uint32_t) meshes.size(),
+                                    (uint32_t) bspline_curves.size(),
+                                    (uint32_t) linear_curves.size(),
+                                    (uint32_t) custom_shapes.size() };
+    if (!cache_file.empty() && fs::exists(fs::path(cache_file)) &&
+        load_gas_cache(context, cache_file, expected_counts, out_accel))
+        return;
+
+    OptixAccelBuildOptions accel_options = {};
+    accel_options.buildFlags = OPTIX_BUILD_FLAG_ALLOW_COMPACTION |
+                               OPTIX_BUILD_FLAG_PREFER_FAST_TRACE;
+    accel_options.operation  = OPTIX_BUILD_OPERATION_BUILD;
+    accel_options.motionOptions.numKeys = 0;
+
+    /* Bookkeeping for a GAS build in flight: its uncompacted result lives in
+       'output_buffer' until the batched compaction pass below has moved it
+       into the shared arena */
+    struct PendingBuild {
+        OptixAccelData::HandleData *out;
+        std::vector<OptixBuildInput> build_inputs;
+        OptixAccelBufferSizes buffer_sizes;
+        OptixTraversableHandle handle = 0ull;
+        void *output_buffer = nullptr;
+    };
+    std::vector<PendingBuild> builds;
+
+    auto declare_gas = [&builds](const std::vector<ref<Shape>> &shape_subset,
+                                 OptixAccelData::HandleData &handle) {
         size_t shapes_count = shape_subset.size();
         if (shapes_count == 0)
             return;
 
-        std::vector<OptixBuildInput> build_inputs(shapes_count);
+        PendingBuild pb;
+        pb.out = &handle;
+        pb.build_inputs.resize(shapes_count);
         for (size_t i = 0; i < shapes_count; i++)
-            shape_subset[i]->optix_build_input(build_inputs[i]);
+            shape_subset[i]->optix_build_input(pb.build_inputs[i]);
 
-        // Ensure shape data pointers are fully evaluated before building the BVH
-        dr::sync_thread();
+        handle.count = (uint32_t) shapes_count;
+        builds.push_back(std::move(pb));
+    };
 
-        OptixAccelBufferSizes buffer_sizes;
+    // Order: meshes, b-spline curves, linear curves, other
+    declare_gas(custom_shapes, out_accel.custom_shapes);
+    declare_gas(meshes, out_accel.meshes);
+    declare_gas(bspline_curves, out_accel.bspline_curves);
+    declare_gas(linear_curves, out_accel.linear_curves);
+
+    if (builds.empty())
+        return;
+
+    // Ensure shape data pointers are fully evaluated before building the BVH
+    dr::sync_thread();
+
+    scoped_optix_context guard;
+
+    /* Determine the memory requirements of every GAS upfront so that one
+       temporary buffer can serve all of the builds */
+    size_t temp_size = 0;
+    for (PendingBuild &pb : builds) {
         jit_optix_check(optixAccelComputeMemoryUsage(
             context,
             &accel_options,
-            build_inputs.data(),
-            (unsigned int) shapes_count,
-            &buffer_sizes
+            pb.build_inputs.data(),
+            (unsigned int) pb.build_inputs.size(),
+            &pb.buffer_sizes
         ));
+        temp_size = std::max(temp_size, pb.buffer_sizes.tempSizeInBytes);
+    }
 
-        void* d_temp_buffer = jit_malloc(AllocType::Device, buffer_sizes.tempSizeInBytes);
-        void* output_buffer = jit_malloc(AllocType::Device, buffer_sizes.outputSizeInBytes);
-        void* compact_size_buffer = jit_malloc(AllocType::Device, 8);
+    void* d_temp_buffer = jit_malloc(AllocType::Device, temp_size);
+    void* compact_size_buffer =
+        jit_malloc(AllocType::Device, 8 * builds.size());
+
+    // Build every GAS, emitting its compacted size as a side effect
+    for (size_t i = 0; i < builds.size(); i++) {
+        PendingBuild &pb = builds[i];
+        pb.output_buffer =
+            jit_malloc(AllocType::Device, pb.buffer_sizes.outputSizeInBytes);
 
         OptixAccelEmitDesc emit_property = {};
         emit_property.type   = OPTIX_PROPERTY_TYPE_COMPACTED_SIZE;
-        emit_property.result = (CUdeviceptr) compact_size_buffer; // needs to be aligned
+        emit_property.result =
+            (CUdeviceptr) compact_size_buffer + 8 * i; // needs to be aligned
 
-        OptixTraversableHandle accel;
         jit_optix_check(optixAccelBuild(
             context,
             (CUstream) jit_cuda_stream(),
             &accel_options,
-            build_inputs.data(),
-            (unsigned int) shapes_count,
+            pb.build_inputs.data(),
+            (unsigned int) pb.build_inputs.size(),
             (CUdeviceptr) d_temp_buffer,
-            buffer_sizes.tempSizeInBytes,
-            (CUdeviceptr) output_buffer,
-            buffer_sizes.outputSizeInBytes,
-            &accel,
+            pb.buffer_sizes.tempSizeInBytes,
+            (CUdeviceptr) pb.output_buffer,
+            pb.buffer_sizes.outputSizeInBytes,
+            &pb.handle,
             &emit_property,  // emitted property list
             1                // num emitted properties
         ));
+    }
 
-        jit_free(d_temp_buffer);
-
-        size_t compact_size;
-        jit_memcpy(JitBackend::CUDA,
-                   &compact_size,
-                   (void*)emit_property.result,
-                   sizeof(size_t));
-        if (compact_size < buffer_sizes.outputSizeInBytes) {
-            void* compact_buffer = jit_malloc(AllocType::Device, compact_size);
-            // Use handle as input and output
-            jit_optix_check(optixAccelCompact(
-                context,
-                (CUstream) jit_cuda_stream(),
-                accel,
-                (CUdeviceptr) compact_buffer,
-                compact_size,
-                &accel
-            ));
-            jit_free(output_buffer);
-            output_buffer = compact_buffer;
-        }
+    jit_free(d_temp_buffer);
 
-        handle.handle = accel;
-        handle.buffer = output_buffer;
-        handle.count = (uint32_t) shapes_count;
-    };
+    // A single synchronous transfer reads back all of the compacted sizes
+    std::vector<size_t> compact_sizes(builds.size());
+    jit_memcpy(JitBackend::CUDA,
+               compact_sizes.data(),
+               compact_size_buffer,
+               8 * builds.size());
+    jit_free(compact_size_buffer);
 
-    scoped_optix_context guard;
+    size_t arena_size = 0;
+    for (size_t compact_size : compact_sizes)
+        arena_size += optix_accel_align(compact_size);
 
-    // Order: meshes, b-spline curves, linear curves, other
-    build_single_gas(custom_shapes, out_accel.custom_shapes);
-    build_single_gas(meshes, out_accel.meshes);
-    build_single_gas(bspline_curves, out_accel.bspline_curves);
-    build_single_gas(linear_curves, out_accel.linear_curves);
+    uint8_t* arena = (uint8_t *) jit_malloc(AllocType::Device, arena_size);
+    out_accel.buffer = arena;
+
+    // Compact every GAS into its slice of the arena
+    size_t arena_offset = 0;
+    for (size_t i = 0; i < builds.size(); i++) {
+        PendingBuild &pb = builds[i];
+        void* target = arena + arena_offset;
+
+        jit_optix_check(optixAccelCompact(
+            context,
+            (CUstream) jit_cuda_stream(),
+            pb.handle,
+            (CUdeviceptr) target,
+            compact_sizes[i],
+            &pb.out->handle
+        ));
+        jit_free(pb.output_buffer);
+
+        pb.out->buffer = target;
+        arena_offset += optix_accel_align(compact_sizes[i]);
+    }
+
+    if (cache_file.empty())
+        return;
+
+    /* Serialize the compacted GAS for future runs. Each record stores the
+       relocation token of the current device/driver so that the loader can
+       reject stale caches. The file is written to a temporary path and
+       renamed into place to tolerate concurrent renders of the same scene. */
+    try {
+        std::string path_tmp_str = cache_file + ".tmp";
+        ref<FileStream> stream =
+            new FileStream(path_tmp_str, FileStream::ETruncReadWrite);
+
+        stream->write_array(gas_cache_magic, 4);
+        stream->write(gas_cache_version);
+        stream->write((uint32_t) builds.size());
+
+        auto slot_of = [&out_accel](OptixAccelData::HandleData *handle) {
+            if (handle == &out_accel.meshes)         return 0u;
+            if (handle == &out_accel.bspline_curves) return 1u;
+            if (handle == &out_accel.linear_curves)  return 2u;
+            return 3u;
+        };
+
+        for (size_t i = 0; i < builds.size(); i++) {
+            PendingBuild &pb = builds[i];
+
+            OptixAccelRelocationInfo reloc;
+            jit_optix_check(optixAccelGetRelocationInfo(
+                context, pb.out->handle, &reloc));
+
+            std::unique_ptr<uint8_t[]> data(new uint8_t[compact_sizes[i]]);
+            jit_memcpy(JitBackend::CUDA, data.get(), pb.out->buffer,
+                       compact_sizes[i]);
+
+            stream->write(slot_of(pb.out));
+            stream->write(pb.out->count);
+            stream->write((uint64_t) compact_sizes[i]);
+            stream->write_array(reloc.info, 4);
+            stream->write_array(data.get(), compact_sizes[i]);
+        }
+        stream->close();
+
+        fs::path path(cache_file), path_tmp(path_tmp_str);
+        if (!fs::rename(path_tmp, path))
+            Throw("could not rename \"%s\"", path_tmp_str);
+
+        Log(Info, "Wrote OptiX GAS cache \"%s\" (%zu KiB).", cache_file,
+            arena_size / 1024);
+    } catch (const std::exception &e) {
+        Log(Warn, "Failed to write GAS cache \"%s\": %s", cache_file,
+            e.what());
+    }
 }
 
 /// Prepares and fills the \ref OptixInstance array associated with a given list of shapes.
@@ -44,6 +44,7 @@ using OptixDenoiserStructPtr = void*;
 #define OPTIX_INDICES_FORMAT_UNSIGNED_INT3 0x2103
 #define OPTIX_VERTEX_FORMAT_FLOAT3         0x2121
 #define OPTIX_SBT_RECORD_ALIGNMENT         16ull
+#define OPTIX_ACCEL_BUFFER_BYTE_ALIGNMENT  128ull
 #define OPTIX_SBT_RECORD_HEADER_SIZE       32
 
 #define OPTIX_COMPILE_DEFAULT_MAX_REGISTER_COUNT 0
@@ -290,6 +291,11 @@ struct OptixImage2D {
     OptixPixelFormat format;
 };
 
+/// Opaque compatibility token describing the device/driver that built an accel
+struct OptixAccelRelocationInfo {
+    unsigned long long info[4];
+};
+
 enum OptixDenoiserModelKind {
     OPTIX_DENOISER_MODEL_KIND_HDR = 0x2323,
     OPTIX_DENOISER_MODEL_KIND_TEMPORAL = 0x2325
@@ -356,6 +362,13 @@ D(optixProgramGroupCreate, OptixDeviceContext, const OptixProgramGroupDesc *,
 D(optixSbtRecordPackHeader, OptixProgramGroup, void *);
 D(optixAccelCompact, OptixDeviceContext, CUstream, OptixTraversableHandle,
   CUdeviceptr, size_t, OptixTraversableHandle *);
+D(optixAccelGetRelocationInfo, OptixDeviceContext, OptixTraversableHandle,
+  OptixAccelRelocationInfo *);
+D(optixAccelCheckRelocationCompatibility, OptixDeviceContext,
+  const OptixAccelRelocationInfo *, int *);
+D(optixAccelRelocate, OptixDeviceContext, CUstream,
+  const OptixAccelRelocationInfo *, CUdeviceptr, size_t, CUdeviceptr, size_t,
+  OptixTraversableHandle *);
 D(optixDenoiserCreate, OptixDeviceContext, OptixDenoiserModelKind,
   const OptixDenoiserOptions *, OptixDenoiserStructPtr *);
 D(optixDenoiserDestroy, OptixDenoiserStructPtr);
@@ -8,6 +8,8 @@
 #include <mitsuba/render/optix_api.h>
 #include <drjit/tensor.h>
 
+extern "C" { struct Task; };
+
 NAMESPACE_BEGIN(mitsuba)
 
 /**
@@ -177,6 +179,39 @@ public:
                            const std::string &previous_denoised_ch = "",
                            const std::string &noisy_ch = "<root>") const;
 
+    /**
+     * \brief Asynchronous variant of the \ref Bitmap denoising operator.
+     *
+     * The denoise is submitted to a thread pool worker, which carries its own
+     * JIT thread state and CUDA stream. Denoising frame N can therefore
+     * overlap with the rendering of frame N + 1 on the caller's stream, which
+     * is particularly useful for animation previews in combination with the
+     * temporal denoising model.
+     *
+     * The parameters match those of the synchronous \ref Bitmap operator.
+     * Only a single frame may be in flight at any time: a subsequent call
+     * implicitly waits for the previous one, as the denoiser state and
+     * scratch buffers are shared across invocations. Use \ref wait() to
+     * retrieve the result.
+     */
+    void denoise_async(const ref<Bitmap> &noisy,
+                       bool denoise_alpha = true,
+                       const std::string &albedo_ch = "",
+                       const std::string &normals_ch = "",
+                       const Transform4f &to_sensor = Transform4f(),
+                       const std::string &flow_ch = "",
+                       const std::string &previous_denoised_ch = "",
+                       const std::string &noisy_ch = "<root>");
+
+    /**
+     * \brief Block until the denoise submitted via \ref denoise_async() has
+     * finished and return its result
+     *
+     * Returns \c nullptr if no asynchronous denoise was ever submitted.
+     * Exceptions raised by the background task are rethrown here.
+     */
+    ref<Bitmap> wait();
+
     virtual std::string to_string() const override;
 
     MI_DECLARE_CLASS()
@@ -197,6 +232,10 @@ private:
     bool m_temporal;
     OptixDenoiserStructPtr m_denoiser;
     CUdeviceptr m_hdr_intensity;
+
+    /// Pending asynchronous denoise task and its result (see \ref denoise_async)
+    Task *m_task = nullptr;
+    ref<Bitmap> m_async_output;
 };
 
 MI_EXTERN_CLASS(OptixDenoiser)
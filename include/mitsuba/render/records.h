@@ -179,6 +179,24 @@ struct DirectionSample : public PositionSample<Float_, Spectrum_> {
         emitter = si.emitter(scene);
     }
 
+    /**
+     * \brief Create a direct sampling record from a ray and the surface
+     * interaction that it produced
+     *
+     * This is equivalent to the reference position-based constructor above
+     * when \c ref denotes the ray origin, but reuses the unit direction and
+     * distance that ray tracing already computed instead of re-deriving them
+     * from the two positions. Integrators use this variant to evaluate the
+     * hypothetical emitter sampling density of a BSDF-sampled ray for MIS.
+     */
+    DirectionSample(const Scene<Float, Spectrum> *scene,
+                    const SurfaceInteraction3f &si,
+                    const Ray3f &ray) : Base(si) {
+        d = ray.d;
+        dist = si.t;
+        emitter = si.emitter(scene);
+    }
+
     /// Element-by-element constructor
     DirectionSample(const Point3f &p, const Normal3f &n, const Point2f &uv,
                     const Float &time, const Float &pdf, const Mask &delta,
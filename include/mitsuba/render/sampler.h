@@ -125,6 +125,18 @@ public:
     /// Set the number of samples per pixel per pass in wavefront modes (default is 1)
     void set_samples_per_wavefront(uint32_t samples_per_wavefront);
 
+    /**
+     * \brief Inform the sampler about the image plane position of the pixel
+     * (or wavefront of pixels) it is about to generate samples for.
+     *
+     * This is a no-op unless blue-noise dithered sampling was requested via
+     * the \c blue_noise plugin parameter, in which case the position selects
+     * the per-pixel toroidal shift from a tileable blue-noise mask.
+     * Rendering algorithms should invoke this function after \ref seed()
+     * and before drawing samples.
+     */
+    void set_pixel_position(const Point2u &pos);
+
     /// dr::schedule() variables that represent the internal sampler state
     virtual void schedule_state();
 
@@ -143,6 +155,11 @@ protected:
     /// Return the index of the current sample
     UInt32 current_sample_index() const;
 
+    /// Apply the blue-noise dither shift of the current pixel to a sample value
+    Float dither(const Float &sample) const;
+    /// Apply the blue-noise dither shift of the current pixel to a 2D sample value
+    Point2f dither(const Point2f &sample) const;
+
 protected:
     /// Base seed value
     uint32_t m_base_seed;
@@ -156,13 +173,17 @@ protected:
     UInt32 m_dimension_index;
     /// Index of the current sample in the sequence
     UInt32 m_sample_index;
+    /// Spatially dither the sample sequences using a blue-noise mask?
+    bool m_blue_noise;
+    /// Per-pixel toroidal shift in blue-noise mode (in [0, 1), see \ref set_pixel_position())
+    Float m_dither_shift;
 };
 
 /// Interface for sampler plugins based on the PCG32 random number generator
 template <typename Float, typename Spectrum>
 class MI_EXPORT_LIB PCG32Sampler : public Sampler<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(Sampler, m_base_seed, m_wavefront_size)
+    MI_IMPORT_BASE(Sampler, m_base_seed, m_wavefront_size, m_blue_noise)
     MI_IMPORT_TYPES()
     using PCG32 = mitsuba::PCG32<UInt32>;
 
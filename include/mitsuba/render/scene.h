@@ -206,6 +206,44 @@ public:
      */
     Mask ray_test(const Ray3f &ray, Mask coherent, Mask active) const;
 
+    /**
+     * \brief Test many shadow rays for occlusion in one batch
+     *
+     * Writes \c true to <tt>occluded[i]</tt> when <tt>rays[i]</tt> intersects
+     * any scene geometry. On Embree, the whole batch is handed to the
+     * occlusion stream API (\c rtcOccluded1M), which amortizes traversal
+     * setup and improves BVH cache locality compared to issuing the rays one
+     * at a time; the kd-tree backend falls back to a loop of \ref ray_test()
+     * calls. Sorting the batch by direction/origin beforehand (see
+     * \ref SamplingIntegrator's deferred shadow rays) further helps.
+     *
+     * Only available in scalar variants; JIT variants express the same
+     * batching through wide \ref ray_test() calls.
+     */
+    void ray_test_many(const Ray3f *rays, Mask *occluded, size_t count) const;
+
+    /**
+     * \brief Find the first intersection of many rays in one batch
+     *
+     * Writes the surface interaction of <tt>rays[i]</tt> to <tt>si[i]</tt>
+     * (an invalid interaction when the ray escapes the scene). On Embree,
+     * the whole batch is handed to the intersection stream API
+     * (\c rtcIntersect1M), which amortizes traversal setup and improves BVH
+     * cache locality compared to issuing the rays one at a time; the
+     * kd-tree backend falls back to a loop of \ref ray_intersect() calls.
+     *
+     * \param coherent
+     *    Hint specifying that the batch traverses essentially the same
+     *    region of space (e.g. primary camera rays), which selects Embree's
+     *    coherent stream traversal order.
+     *
+     * Only available in scalar variants; JIT variants express the same
+     * batching through wide \ref ray_intersect() calls.
+     */
+    void ray_intersect_many(const Ray3f *rays, SurfaceInteraction3f *si,
+                            size_t count, uint32_t ray_flags = +RayFlags::All,
+                            bool coherent = true) const;
+
     /**
      * \brief Intersect a ray with the shapes comprising the scene and return
      * preliminary information, if one is found
@@ -298,6 +336,45 @@ public:
      */
     Float pdf_emitter(UInt32 index, Mask active = true) const;
 
+    /**
+     * \brief Hierarchically sample one emitter proportional to its
+     * approximate contribution at the reference position \c p.
+     *
+     * This is the light tree counterpart of \ref sample_emitter(): instead
+     * of picking emitters uniformly, it traverses a binary tree built over
+     * the emitter bounding boxes and sampling weights, choosing children
+     * with probability proportional to <tt>weight / distance^2</tt> between
+     * \c p and the child cluster. Emitters at infinity (e.g. environment
+     * maps) cannot be bounded spatially and are instead sampled as a
+     * separate group in proportion to their sampling weights.
+     *
+     * The tree is only available when the scene was loaded with the
+     * <tt>light_tree</tt> property set to \c true; \ref
+     * sample_emitter_direction() then uses this scheme internally.
+     *
+     * \param p
+     *    A 3D reference position within the scene (e.g. the shading point)
+     *
+     * \param index_sample
+     *    A uniformly distributed number in [0, 1).
+     *
+     * \return
+     *    The index of the chosen emitter along with the sampling weight
+     *    (equal to the inverse PMF), and the transformed random sample for
+     *    reuse.
+     */
+    std::tuple<UInt32, Float, Float>
+    sample_emitter_tree(const Point3f &p, Float index_sample,
+                        Mask active = true) const;
+
+    /**
+     * \brief Evaluate the discrete probability of the \ref
+     * sample_emitter_tree() technique for the given reference position and
+     * emitter index.
+     */
+    Float pdf_emitter_tree(const Point3f &p, UInt32 index,
+                           Mask active = true) const;
+
     /**
      * \brief Sample a ray according to the emission profile of scene emitters
      *
@@ -476,6 +553,12 @@ public:
     /// Return the scene's integrator
     const Integrator* integrator() const { return m_integrator; }
 
+    /// Return the list of emissive participating media (see \ref Medium::is_emitter())
+    const std::vector<ref<Medium>> &emissive_media() const { return m_emissive_media; }
+
+    /// Return the list of emissive participating media as an Dr.Jit array
+    const DynamicBuffer<MediumPtr> &emissive_media_dr() const { return m_emissive_media_dr; }
+
     /// Return the list of emitters as an Dr.Jit array
     const DynamicBuffer<EmitterPtr> &emitters_dr() const { return m_emitters_dr; }
 
@@ -504,6 +587,34 @@ public:
      */
     bool shapes_grad_enabled() const { return m_shapes_grad_enabled; };
 
+    /**
+     * \brief If every shape in the scene references the same BSDF instance,
+     * return it; otherwise, return \c nullptr
+     *
+     * Integrators can use this to monomorphize their material queries: with
+     * a uniform instance, the vcall dispatch machinery can be bypassed in
+     * favor of direct calls, which removes indirect-call overhead from
+     * utility passes (AOVs, shadows) that use a single BSDF scene-wide.
+     * Scenes containing shape groups conservatively report \c nullptr.
+     */
+    const BSDF *unique_bsdf() const { return m_unique_bsdf; }
+
+    /**
+     * \brief Return the smallest set of ray flags that suffices to shade
+     * the materials in this scene
+     *
+     * \ref RayFlags::All unconditionally includes \ref RayFlags::dPdUV, yet
+     * the resulting position partials only influence shading when a BSDF
+     * depends on the tangent frame orientation (\ref BSDFFlags::Anisotropic)
+     * or requests texture-space differentials
+     * (\ref BSDFFlags::NeedsDifferentials). Scenes without such materials can
+     * skip the partial derivative computation in
+     * \ref Shape::compute_surface_interaction() entirely. Integrators that
+     * only use the intersection for shading should pass this value to
+     * \ref ray_intersect() instead of \ref RayFlags::All.
+     */
+    uint32_t minimal_ray_flags() const { return m_minimal_ray_flags; }
+
     /// Return a human-readable string representation of the scene contents.
     virtual std::string to_string() const override;
 
@@ -546,11 +657,13 @@ protected:
 
     /// Trace a ray
     MI_INLINE SurfaceInteraction3f ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags, Mask coherent, Mask active) const;
+    MI_INLINE void ray_intersect_many_cpu(const Ray3f *rays, SurfaceInteraction3f *si, size_t count, uint32_t ray_flags, bool coherent) const;
     MI_INLINE SurfaceInteraction3f ray_intersect_gpu(const Ray3f &ray, uint32_t ray_flags, Mask active) const;
     MI_INLINE SurfaceInteraction3f ray_intersect_naive_cpu(const Ray3f &ray, Mask active) const;
 
     /// Trace a shadow ray
     MI_INLINE Mask ray_test_cpu(const Ray3f &ray, Mask coherent, Mask active) const;
+    MI_INLINE void ray_test_many_cpu(const Ray3f *rays, Mask *occluded, size_t count) const;
     MI_INLINE Mask ray_test_gpu(const Ray3f &ray, Mask active) const;
 
     using ShapeKDTree = mitsuba::ShapeKDTree<Float, Spectrum>;
@@ -558,6 +671,19 @@ protected:
     /// Updates the discrete distribution used to select an emitter
     void update_emitter_sampling_distribution();
 
+    /// Recomputes the value returned by \ref minimal_ray_flags()
+    void update_minimal_ray_flags();
+
+    /// Build the light tree used by \ref sample_emitter_tree()
+    void build_light_tree();
+
+    /**
+     * \brief Approximate contribution of the light tree node \c node at the
+     * reference position \c p (cluster weight over clamped squared distance)
+     */
+    Float light_tree_importance(const Point3f &p, const UInt32 &node,
+                                const Mask &active) const;
+
 protected:
     /// Acceleration data structure (IAS) (type depends on implementation)
     void *m_accel = nullptr;
@@ -570,6 +696,8 @@ protected:
     DynamicBuffer<EmitterPtr> m_emitters_dr;
     std::vector<ref<Shape>> m_shapes;
     DynamicBuffer<ShapePtr> m_shapes_dr;
+    std::vector<ref<Medium>> m_emissive_media;
+    DynamicBuffer<MediumPtr> m_emissive_media_dr;
     std::vector<ref<ShapeGroup>> m_shapegroups;
     std::vector<ref<Sensor>> m_sensors;
     std::vector<ref<Object>> m_children;
@@ -578,7 +706,28 @@ protected:
     ScalarFloat m_emitter_pmf;
     std::unique_ptr<DiscreteDistribution<Float>> m_emitter_distr = nullptr;
 
+    /* Light tree for hierarchical emitter sampling (see \ref
+       build_light_tree). Nodes are stored flat: 'm_light_tree_data' packs
+       (center xyz, squared cluster radius, weight) per node, and
+       'm_light_tree_child' holds the left child index (the right child
+       follows at the next slot) or, for leaves, the emitter index with the
+       uppermost bit set. */
+    bool m_use_light_tree = false;
+    DynamicBuffer<Float> m_light_tree_data;
+    DynamicBuffer<UInt32> m_light_tree_child;
+    DynamicBuffer<UInt32> m_light_tree_parent;
+    /// Maps emitter indices to their leaf node (or a sentinel if unbounded)
+    DynamicBuffer<UInt32> m_light_tree_leaf;
+    /// Fixed selection PMF of emitters sampled outside of the tree
+    DynamicBuffer<Float> m_light_tree_const_pmf;
+    /// Probability of choosing the group of emitters at infinity
+    ScalarFloat m_light_tree_p_inf = 0.f;
+    std::unique_ptr<DiscreteDistribution<Float>> m_light_tree_inf_distr;
+    DynamicBuffer<UInt32> m_light_tree_inf_indices;
+
     bool m_shapes_grad_enabled;
+    const BSDF *m_unique_bsdf = nullptr;
+    uint32_t m_minimal_ray_flags = (uint32_t) RayFlags::All;
 };
 
 /// Dummy function which can be called to ensure that the librender shared library is loaded
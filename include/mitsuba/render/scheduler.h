@@ -0,0 +1,87 @@
+#pragma once
+
+#include <mitsuba/render/spiral.h>
+#include <deque>
+#include <memory>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Work-stealing scheduler that distributes image blocks to render
+ * workers
+ *
+ * The blocks of every pass are enumerated in the inside-out order produced
+ * by \ref Spiral and dealt round-robin into one deque per worker, so that
+ * each worker starts with a spatially spread subset that still renders
+ * roughly inside-out. Workers then fetch work exclusively from their own
+ * deque via \ref next_block() and only synchronize with others when it runs
+ * empty: in that case, the worker steals the most recently queued block of
+ * another deque and, if the block spans more than one scanline, splits off
+ * the upper half of its row range and leaves the rest behind for the victim.
+ *
+ * This keeps all synchronization on per-deque mutexes that are uncontended
+ * in the steady state, and lets threads that finish early subdivide the
+ * remaining work at scanline granularity instead of idling behind a single
+ * expensive block.
+ *
+ * \ingroup librender
+ */
+class MI_EXPORT_LIB BlockScheduler : public Object {
+public:
+    using Vector2i = Vector<int32_t, 2>;
+    using Vector2u = Vector<uint32_t, 2>;
+
+    /// Descriptor of a (possibly partial) image block to be rendered
+    struct BlockDescriptor {
+        Vector2i offset;    //< Offset of the block into the frame (in pixels)
+        Vector2u size;      //< Size of the full block (in pixels)
+        uint32_t block_id;  //< Unique identifier (drives the RNG seeding)
+        uint32_t row_begin; //< First assigned scanline within the block
+        uint32_t row_end;   //< One past the last assigned scanline
+    };
+
+    /**
+     * \brief Create a new scheduler for the given size, offset into a larger
+     * frame, block size, pass count, and number of render workers
+     */
+    BlockScheduler(const Vector2u &size, const Vector2u &offset,
+                   uint32_t block_size, uint32_t passes,
+                   uint32_t worker_count);
+
+    /// Return the maximum block size
+    uint32_t max_block_size() const { return m_block_size; }
+
+    /// Return the total number of blocks in one pass
+    uint32_t block_count() const { return m_block_count; }
+
+    /// Return the number of per-worker deques
+    uint32_t worker_count() const { return m_worker_count; }
+
+    /// Return the total number of assigned scanlines (across all passes)
+    uint64_t row_count() const { return m_row_count; }
+
+    /**
+     * \brief Fetch the next (possibly partial) block for the given worker.
+     *
+     * Pops from the worker's own deque, stealing and splitting the row range
+     * of another worker's block when it runs empty.
+     *
+     * \return \c false when no queued work remains.
+     */
+    bool next_block(uint32_t worker, BlockDescriptor &block);
+
+    MI_DECLARE_CLASS()
+protected:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<BlockDescriptor> blocks;
+    };
+
+    uint32_t m_block_size;   //< Size of the (square) blocks (in pixels)
+    uint32_t m_block_count;  //< Number of blocks in one pass
+    uint32_t m_worker_count; //< Number of per-worker deques
+    uint64_t m_row_count;    //< Total number of assigned scanlines
+    std::unique_ptr<Queue[]> m_queues;
+};
+
+NAMESPACE_END(mitsuba)
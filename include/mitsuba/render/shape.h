@@ -406,6 +406,20 @@ public:
     /// Return the shape's BSDF
     BSDF *bsdf(Mask /*unused*/ = true) { return m_bsdf.get(); }
 
+    /**
+     * \brief Evaluate the opacity of the shape at the given surface position
+     *
+     * Ray tracing backends use this hook to resolve opacity-masked geometry
+     * (see the \c mask plugin) directly during traversal via a stochastic
+     * alpha test, so that shadow rays through such geometry cost a single
+     * traversal instead of a chain of null BSDF samples. Returns 1 (fully
+     * opaque) for shapes without an opacity mask.
+     */
+    Float eval_opacity(const SurfaceInteraction3f &si, Mask active = true) const;
+
+    /// Does this shape carry an opacity mask that traversal may test stochastically?
+    bool has_opacity_query() const;
+
     /// Is this shape also an area emitter?
     bool is_emitter() const { return (bool) m_emitter; }
 
@@ -444,6 +458,19 @@ public:
 #if defined(MI_ENABLE_EMBREE)
     /// Return the Embree version of this shape
     virtual RTCGeometry embree_geometry(RTCDevice device);
+
+    /**
+     * \brief Update an already attached Embree geometry in place
+     *
+     * When BVH refitting is enabled (see the <tt>accel_refit</tt> scene
+     * property), the scene invokes this method on every dirty shape with
+     * the geometry that was previously created by \ref embree_geometry().
+     * Implementations should push the shape's updated buffers or transform
+     * into \c geom, commit it, and return \c true. The default
+     * implementation returns \c false, which indicates that the shape
+     * cannot be updated in place and triggers a full rebuild.
+     */
+    virtual bool embree_refit(RTCGeometry geom) const;
 #endif
 
 #if defined(MI_ENABLE_CUDA)
@@ -533,6 +560,16 @@ public:
     void traverse(TraversalCallback *callback) override;
     void parameters_changed(const std::vector<std::string> &/*keys*/ = {}) override;
 
+    /**
+     * \brief Return the BVH build quality requested for this shape
+     *
+     * The returned value matches the \c RTCBuildQuality enumeration
+     * (0: low, 1: medium, 2: high); -1 means that the shape inherits the
+     * scene-wide default specified via the ``accel_build_quality`` scene
+     * property.
+     */
+    int bvh_build_quality() const { return m_bvh_build_quality; }
+
     /// Return whether the shape's geometry has changed
     bool dirty() const { return m_dirty; }
 
@@ -578,6 +615,9 @@ protected:
     /// True if the shape is used in a \c ShapeGroup
     bool m_is_instance = false;
 
+    /// Per-shape BVH build quality override, see \ref bvh_build_quality()
+    int m_bvh_build_quality = -1;
+
 #if defined(MI_ENABLE_CUDA)
     /// OptiX hitgroup data buffer
     void* m_optix_data_ptr = nullptr;
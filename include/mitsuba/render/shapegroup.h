@@ -32,6 +32,16 @@ public:
     std::tuple<ScalarFloat, ScalarPoint2f, ScalarUInt32, ScalarUInt32>
     ray_intersect_preliminary_scalar(const ScalarRay3f &ray) const override;
     bool ray_test_scalar(const ScalarRay3f &ray) const override;
+
+    /**
+     * \brief Rebuild the shared kd-tree following a geometry update
+     *
+     * Invoked by \ref Scene::accel_parameters_changed_cpu() before the
+     * top-level kd-tree is rebuilt, so that instances referencing this group
+     * report up-to-date bounding boxes. Does nothing when no contained shape
+     * was modified.
+     */
+    void accel_parameters_changed();
 #endif
 
     SurfaceInteraction3f compute_surface_interaction(const Ray3f &ray,
@@ -40,6 +40,31 @@ public:
     virtual UnpolarizedSpectrum eval(const SurfaceInteraction3f &si,
                                      Mask active = true) const;
 
+    /**
+     * \brief Evaluate the texture at an array of surface interactions
+     *
+     * This entry point exists for the benefit of scalar variants, where \ref
+     * eval() processes a single lookup at a time: given a coherent batch of
+     * lookups, implementations can amortize addressing computations and
+     * perform the underlying texel fetches using SIMD instructions. In JIT
+     * variants, a batch is already expressed through the width of the \c
+     * Float type, hence the default implementation (which simply invokes
+     * \ref eval() once per entry) is adequate there.
+     *
+     * \param si
+     *     An array of \c count interaction records describing the associated
+     *     surface positions
+     *
+     * \param out
+     *     Output array receiving one evaluation per interaction record
+     *
+     * \param count
+     *     Number of lookups to perform
+     */
+    virtual void eval_batch(const SurfaceInteraction3f *si,
+                            UnpolarizedSpectrum *out, size_t count,
+                            Mask active = true) const;
+
     /**
      * \brief Importance sample a set of wavelengths proportional to the
      * spectrum defined at the given surface position
@@ -213,6 +238,17 @@ public:
     /// Does this texture evaluation depend on the UV coordinates
     virtual bool is_spatially_varying() const { return false; }
 
+    /**
+     * \brief Does this texture use the UV partials of the queried surface
+     * interaction (\c si.duv_dx / \c si.duv_dy)?
+     *
+     * Footprint-aware lookups (e.g. trilinear mip-mapped filtering) return
+     * \c true here; BSDFs holding such a texture should then advertise
+     * \ref BSDFFlags::NeedsDifferentials so that
+     * \ref SurfaceInteraction::bsdf() computes the partials.
+     */
+    virtual bool uses_ray_differentials() const { return false; }
+
     /// Convenience function returning the standard D65 illuminant
     static ref<Texture> D65(ScalarFloat scale = 1.f);
 
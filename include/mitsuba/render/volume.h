@@ -49,6 +49,23 @@ public:
     virtual std::pair<UnpolarizedSpectrum, Vector3f> eval_gradient(const Interaction3f &it,
                                                                    Mask active = true) const;
 
+    /**
+     * \brief Evaluate the volume at a reduced level of detail
+     *
+     * Volumes that maintain a mip hierarchy (see the :paramtype:`mip_levels`
+     * parameter of the :ref:`gridvolume <volume-gridvolume>` plugin) answer
+     * this query from a box-filtered copy of the data, where level 0
+     * corresponds to the full-resolution grid and each successive level
+     * halves the resolution along every axis. The level is clamped to the
+     * range of available levels. The default implementation ignores
+     * \c level and forwards to \ref eval().
+     */
+    virtual UnpolarizedSpectrum eval_lod(const Interaction3f &it, uint32_t level,
+                                         Mask active = true) const;
+
+    /// Number of levels of detail accessible via \ref eval_lod() (1 if no mip hierarchy exists)
+    virtual uint32_t mip_level_count() const;
+
     /// Returns the maximum value of the volume over all dimensions.
     virtual ScalarFloat max() const;
 
@@ -60,6 +77,22 @@ public:
      */
     virtual void max_per_channel(ScalarFloat *out) const;
 
+    /**
+     * \brief Compute conservative local maxima over a coarse grid
+     *
+     * Fills \c out (of size <tt>prod(res)</tt>, with x varying fastest) with
+     * an upper bound of the volume's values over each cell of a regular grid
+     * with resolution \c res laid over \ref bbox(). Media use this to build
+     * super-grids of local majorants for free-flight sampling (see the
+     * :paramtype:`majorant_resolution_factor` parameter of the
+     * :ref:`heterogeneous <medium-heterogeneous>` plugin). The bounds must
+     * hold for every point of a cell, including interpolation. The default
+     * implementation returns the global maximum for every cell.
+     *
+     * Pointer allocation/deallocation must be performed by the caller.
+     */
+    virtual void max_per_cell(const ScalarVector3u &res, ScalarFloat *out) const;
+
     /// Returns the bounding box of the volume
     ScalarBoundingBox3f bbox() const { return m_bbox; }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mitsuba/core/bbox.h>
+#include <mitsuba/core/mmap.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/transform.h>
@@ -30,6 +31,12 @@ public:
     /**
      * \brief Load a VolumeGrid from a given filename
      *
+     * When possible (single precision variants on little-endian hosts), the
+     * file is mapped into memory and the voxel data is aliased in place
+     * rather than copied, so that even multi-gigabyte grids load quickly.
+     * Grids backed by a memory mapping are read-only; modifying the storage
+     * returned by \ref data() is not permitted in this case.
+     *
      * \param path
      *    Name of the file to be loaded
      */
@@ -108,10 +115,23 @@ public:
     MI_DECLARE_CLASS()
 
 protected:
+    /// Virtual destructor
+    virtual ~VolumeGrid();
+
     void read(Stream *stream);
 
+    /**
+     * \brief Attempt to memory-map \c path and alias its voxel data in place
+     *
+     * Returns \c false when the fast path does not apply (double precision
+     * variants or big-endian hosts), in which case the caller should fall
+     * back to \ref read().
+     */
+    bool read_mmap(const fs::path &path);
+
 protected:
     std::unique_ptr<ScalarFloat[]> m_data;
+    ref<MemoryMappedFile> m_mmap;
 
     ScalarVector3u m_size;
     ScalarUInt32 m_channel_count;
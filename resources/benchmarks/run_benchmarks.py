@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+End-to-end render benchmark suite.
+
+Runs a curated set of scenes (surface path tracing and volumetric path
+tracing) across the requested Mitsuba variants and reports per-run wall
+times, primary rays per second, and time-to-develop in machine-readable
+JSON. Intended to be invoked via the ``benchmark`` build target, e.g.
+
+    ninja benchmark
+    python resources/benchmarks/run_benchmarks.py --variants scalar_rgb,llvm_rgb
+
+The ray-tracing backend (Embree or the native kd-tree on the CPU) is a
+compile-time choice; the active backend is recorded in the report metadata
+so that results from differently configured builds can be told apart.
+"""
+
+import argparse
+import json
+import platform
+import statistics
+import sys
+import time
+
+
+def scene_cornell_path(res, spp):
+    """Cornell box with the surface path tracer."""
+    import mitsuba as mi
+    scene = mi.cornell_box()
+    scene['integrator'] = {'type': 'path', 'max_depth': 8}
+    scene['sensor']['film']['width'] = res
+    scene['sensor']['film']['height'] = res
+    scene['sensor']['sampler']['sample_count'] = spp
+    return scene
+
+
+def scene_cornell_volpath(res, spp):
+    """Cornell box filled with a scattering medium, volumetric path tracer."""
+    import mitsuba as mi
+    scene = scene_cornell_path(res, spp)
+    scene['integrator'] = {'type': 'volpath', 'max_depth': 16}
+    scene['medium'] = {
+        'type': 'cube',
+        'to_world': mi.ScalarTransform4f.translate([0, 0, 0.2]).scale(0.6),
+        'bsdf': {'type': 'null'},
+        'interior': {
+            'type': 'homogeneous',
+            'sigma_t': {'type': 'rgb', 'value': [1.0, 1.2, 1.5]},
+            'albedo': {'type': 'rgb', 'value': [0.8, 0.7, 0.6]},
+        }
+    }
+    return scene
+
+
+SCENES = {
+    'cornell_path': scene_cornell_path,
+    'cornell_volpath': scene_cornell_volpath,
+}
+
+
+def default_variants():
+    """Benchmark each available CPU backend once (scalar and LLVM)."""
+    import mitsuba as mi
+    selected = []
+    for prefix in ('scalar_', 'llvm_'):
+        for v in mi.variants():
+            if v.startswith(prefix) and v.endswith('rgb'):
+                selected.append(v)
+                break
+    return selected
+
+
+def run_one(scene_name, variant, res, spp, warmup, repeat):
+    import drjit as dr
+    import mitsuba as mi
+
+    mi.set_variant(variant)
+    scene = mi.load_dict(SCENES[scene_name](res, spp))
+
+    def render(seed):
+        image = mi.render(scene, spp=spp, seed=seed)
+        dr.eval(image)
+        if dr.is_jit_v(mi.Float):
+            dr.sync_thread()
+
+    # Warm-up runs trigger JIT tracing/compilation and fault in assets
+    for i in range(warmup):
+        render(seed=i)
+
+    times = []
+    for i in range(repeat):
+        t0 = time.perf_counter()
+        render(seed=warmup + i)
+        times.append(time.perf_counter() - t0)
+
+    # Time the develop step separately (film -> final tensor)
+    film = scene.sensors()[0].film()
+    develop_times = []
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        image = film.develop()
+        dr.eval(image)
+        if dr.is_jit_v(mi.Float):
+            dr.sync_thread()
+        develop_times.append(time.perf_counter() - t0)
+
+    t_median = statistics.median(times)
+    primary_rays = res * res * spp
+
+    return {
+        'scene': scene_name,
+        'variant': variant,
+        'resolution': [res, res],
+        'spp': spp,
+        'warmup': warmup,
+        'repeat': repeat,
+        'render_times': times,
+        'render_time_median': t_median,
+        'render_time_min': min(times),
+        'primary_rays_per_second': primary_rays / t_median,
+        'develop_times': develop_times,
+        'develop_time_median': statistics.median(develop_times),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--variants', type=str, default=None,
+                        help='Comma-separated list of variants (default: one '
+                             'scalar and one LLVM RGB variant, if enabled)')
+    parser.add_argument('--scenes', type=str, default=','.join(SCENES),
+                        help='Comma-separated list of scenes (default: all)')
+    parser.add_argument('--resolution', type=int, default=256,
+                        help='Image width/height in pixels (default: 256)')
+    parser.add_argument('--spp', type=int, default=64,
+                        help='Samples per pixel (default: 64)')
+    parser.add_argument('--warmup', type=int, default=1,
+                        help='Untimed warm-up renders per configuration (default: 1)')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='Timed renders per configuration (default: 3)')
+    parser.add_argument('--output', type=str, default='benchmark.json',
+                        help='Path of the JSON report (default: benchmark.json)')
+    parser.add_argument('--list', action='store_true',
+                        help='List available scenes and variants, then exit')
+    args = parser.parse_args()
+
+    import mitsuba as mi
+
+    if args.list:
+        print('Scenes:   ' + ', '.join(SCENES))
+        print('Variants: ' + ', '.join(mi.variants()))
+        return 0
+
+    variants = args.variants.split(',') if args.variants else default_variants()
+    scenes = args.scenes.split(',')
+
+    for v in variants:
+        if v not in mi.variants():
+            raise SystemExit(f'Variant "{v}" is not enabled in this build '
+                             f'(available: {", ".join(mi.variants())})')
+    for s in scenes:
+        if s not in SCENES:
+            raise SystemExit(f'Unknown scene "{s}" (available: {", ".join(SCENES)})')
+
+    results = []
+    for scene_name in scenes:
+        for variant in variants:
+            print(f'[{scene_name} / {variant}] ...', end='', flush=True)
+            entry = run_one(scene_name, variant, args.resolution, args.spp,
+                            args.warmup, args.repeat)
+            results.append(entry)
+            print(f' {entry["render_time_median"]:.3f} s/frame, '
+                  f'{entry["primary_rays_per_second"] / 1e6:.2f} Mray/s, '
+                  f'develop {entry["develop_time_median"] * 1e3:.2f} ms')
+
+    report = {
+        'meta': {
+            'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S'),
+            'mitsuba_version': mi.MI_VERSION,
+            'embree': bool(mi.MI_ENABLE_EMBREE),
+            'cuda': bool(mi.MI_ENABLE_CUDA),
+            'platform': platform.platform(),
+            'processor': platform.processor(),
+        },
+        'results': results,
+    }
+
+    with open(args.output, 'w') as f:
+        json.dump(report, f, indent=2)
+    print(f'Wrote {args.output}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
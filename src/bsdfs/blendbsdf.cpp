@@ -213,6 +213,62 @@ public:
                  pdf_0 * (1 - weight) + pdf_1 * weight };
     }
 
+    std::tuple<Spectrum, Float, BSDFSample3f, Spectrum>
+    eval_pdf_sample(const BSDFContext &ctx,
+                    const SurfaceInteraction3f &si,
+                    const Vector3f &wo,
+                    Float sample1,
+                    const Point2f &sample2,
+                    Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        /* The default implementation in the base class would call eval_pdf()
+           and sample() separately, evaluating the blend weight texture twice.
+           Evaluate it once and share it between both halves of the query. */
+        Float weight = eval_weight(si, active);
+
+        if (unlikely(ctx.component != (uint32_t) -1)) {
+            bool sample_first = ctx.component < m_nested_bsdf[0]->component_count();
+            BSDFContext ctx2(ctx);
+            if (!sample_first)
+                ctx2.component -= (uint32_t) m_nested_bsdf[0]->component_count();
+            else
+                weight = 1.f - weight;
+
+            auto [val, pdf, bs, bs_weight] =
+                m_nested_bsdf[sample_first ? 0 : 1]->eval_pdf_sample(
+                    ctx2, si, wo, sample1, sample2, active);
+            return { weight * val, pdf, bs, weight * bs_weight };
+        }
+
+        auto [val_0, pdf_0] = m_nested_bsdf[0]->eval_pdf(ctx, si, wo, active);
+        auto [val_1, pdf_1] = m_nested_bsdf[1]->eval_pdf(ctx, si, wo, active);
+
+        BSDFSample3f bs = dr::zeros<BSDFSample3f>();
+        Spectrum bs_weight(0.f);
+
+        Mask m0 = active && sample1 >  weight,
+             m1 = active && sample1 <= weight;
+
+        if (dr::any_or<true>(m0)) {
+            auto [bs0, result0] = m_nested_bsdf[0]->sample(
+                ctx, si, (sample1 - weight) / (1 - weight), sample2, m0);
+            dr::masked(bs, m0) = bs0;
+            dr::masked(bs_weight, m0) = result0;
+        }
+
+        if (dr::any_or<true>(m1)) {
+            auto [bs1, result1] = m_nested_bsdf[1]->sample(
+                ctx, si, sample1 / weight, sample2, m1);
+            dr::masked(bs, m1) = bs1;
+            dr::masked(bs_weight, m1) = result1;
+        }
+
+        return { val_0 * (1 - weight) + val_1 * weight,
+                 pdf_0 * (1 - weight) + pdf_1 * weight,
+                 bs, bs_weight };
+    }
+
     MI_INLINE Float eval_weight(const SurfaceInteraction3f &si, const Mask &active) const {
         return dr::clamp(m_weight->eval_1(si, active), 0.f, 1.f);
     }
@@ -3,6 +3,8 @@
 #include <mitsuba/core/string.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/texture.h>
+#include <drjit/dynamic.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -29,6 +31,19 @@ Bump map BSDF adapter (:monosp:`bumpmap`)
    - Bump map gradient multiplier. (Default: 1.0)
    - |exposed|
 
+ * - antialias
+   - |bool|
+   - Replace the point-sampled bump gradient by a footprint-filtered lookup
+     in the style of LEAN mapping: at load time, the plugin builds a mip
+     pyramid of averaged height field gradients and selects a level based on
+     the ray differentials of each shading point. Distant bump detail is
+     then smoothly averaged away instead of aliasing into noise. Note that
+     detail filtered out by minification is removed rather than converted
+     into microfacet roughness (the BSDF interface offers no way to inject
+     a per-sample roughness increment into the nested model), and that the
+     precomputed pyramid is detached from the automatic differentiation
+     graph. (Default: false)
+
 Bump mapping is a simple technique for cheaply adding surface detail to a rendering. This is done
 by perturbing the shading coordinate frame based on a displacement height field provided as a
 texture. This method can lend objects a highly realistic and detailed appearance (e.g. wrinkled
@@ -107,11 +122,23 @@ public:
 
         m_scale = props.get<ScalarFloat>("scale", 1.f);
 
+        m_antialias = props.get<bool>("antialias", false);
+        if (m_antialias)
+            build_gradient_pyramid();
+
         // Add all nested components
         m_components.clear();
         for (size_t i = 0; i < m_nested_bsdf->component_count(); ++i)
             m_components.push_back(m_nested_bsdf->flags(i));
-        m_flags = m_nested_bsdf->flags();
+        /* The frame perturbation evaluates a texture and depends on the UV
+           tangent directions (see \ref frame()) */
+        m_flags = m_nested_bsdf->flags() | BSDFFlags::SpatiallyVarying |
+                  BSDFFlags::Anisotropic;
+        /* The footprint-filtered lookup selects its pyramid level from the
+           UV partials, which \ref SurfaceInteraction::bsdf() only computes
+           for BSDFs that advertise this flag */
+        if (m_antialias)
+            m_flags = m_flags | BSDFFlags::NeedsDifferentials;
         dr::set_attr(this, "flags", m_flags);
     }
 
@@ -121,6 +148,12 @@ public:
         callback->put_parameter("scale",        m_scale,                +ParamFlags::NonDifferentiable);
     }
 
+    void parameters_changed(const std::vector<std::string> &keys = {}) override {
+        if (m_antialias &&
+            (keys.empty() || string::contains(keys, "nested_texture")))
+            build_gradient_pyramid();
+    }
+
     std::pair<BSDFSample3f, Spectrum> sample(const BSDFContext &ctx,
                                              const SurfaceInteraction3f &si,
                                              Float sample1,
@@ -196,9 +229,152 @@ public:
         return { value & active, dr::select(active, pdf, 0.f) };
     }
 
+    /**
+     * \brief Precompute a mip pyramid of height field gradients
+     *
+     * The nested texture is point-sampled at texel centers, and central
+     * differences of progressively downsampled copies of this height field
+     * yield footprint-averaged UV-space gradients for each level. The
+     * pyramid is stored as a single flat buffer of interleaved (gx, gy)
+     * pairs together with per-level start offsets, and is intentionally
+     * detached from the AD graph.
+     */
+    void build_gradient_pyramid() {
+        ScalarVector2i res = m_nested_texture->resolution();
+        if (res.x() <= 1 || res.y() <= 1) {
+            Log(Warn, "bumpmap: the nested texture does not expose a discrete "
+                      "resolution, disabling the \"antialias\" gradient pyramid.");
+            m_antialias = false;
+            return;
+        }
+        m_res = res;
+        uint32_t w = (uint32_t) res.x(), h = (uint32_t) res.y();
+
+        // Sample the height field at texel centers
+        std::vector<ScalarFloat> height(w * (size_t) h);
+        if constexpr (dr::is_jit_v<Float>) {
+            UInt32 index = dr::arange<UInt32>(w * (size_t) h);
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            si.uv = Point2f((Float(index % w) + .5f) / (ScalarFloat) w,
+                            (Float(index / w) + .5f) / (ScalarFloat) h);
+            Float values = dr::detach(m_nested_texture->eval_1(si, true));
+            values = dr::migrate(values, AllocType::Host);
+            dr::sync_thread();
+            std::memcpy(height.data(), values.data(),
+                        height.size() * sizeof(ScalarFloat));
+        } else {
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            for (uint32_t y = 0; y < h; ++y) {
+                for (uint32_t x = 0; x < w; ++x) {
+                    si.uv = Point2f((x + .5f) / (ScalarFloat) w,
+                                    (y + .5f) / (ScalarFloat) h);
+                    height[y * (size_t) w + x] =
+                        dr::detach(m_nested_texture->eval_1(si, true));
+                }
+            }
+        }
+
+        std::vector<ScalarFloat> grad;   // Interleaved (gx, gy) pairs
+        std::vector<uint32_t> offsets;   // Start of each level, in pairs
+        std::vector<ScalarFloat> level = std::move(height);
+        uint32_t lw = w, lh = h;
+
+        while (true) {
+            offsets.push_back((uint32_t) (grad.size() / 2));
+
+            // Central differences in UV units, one-sided at the borders
+            for (uint32_t y = 0; y < lh; ++y) {
+                for (uint32_t x = 0; x < lw; ++x) {
+                    uint32_t x0 = x > 0 ? x - 1 : 0,
+                             x1 = x + 1 < lw ? x + 1 : lw - 1,
+                             y0 = y > 0 ? y - 1 : 0,
+                             y1 = y + 1 < lh ? y + 1 : lh - 1;
+                    ScalarFloat gx = x1 > x0
+                        ? (level[y * lw + x1] - level[y * lw + x0]) *
+                          (ScalarFloat) lw / (ScalarFloat) (x1 - x0) : 0.f;
+                    ScalarFloat gy = y1 > y0
+                        ? (level[y1 * lw + x] - level[y0 * lw + x]) *
+                          (ScalarFloat) lh / (ScalarFloat) (y1 - y0) : 0.f;
+                    grad.push_back(gx);
+                    grad.push_back(gy);
+                }
+            }
+
+            if (lw == 1 && lh == 1)
+                break;
+
+            // Downsample the height field by averaging 2x2 neighborhoods
+            uint32_t nw = lw > 1 ? lw / 2 : 1, nh = lh > 1 ? lh / 2 : 1;
+            std::vector<ScalarFloat> next(nw * (size_t) nh);
+            for (uint32_t y = 0; y < nh; ++y) {
+                for (uint32_t x = 0; x < nw; ++x) {
+                    uint32_t x0 = dr::minimum(2 * x,     lw - 1),
+                             x1 = dr::minimum(2 * x + 1, lw - 1),
+                             y0 = dr::minimum(2 * y,     lh - 1),
+                             y1 = dr::minimum(2 * y + 1, lh - 1);
+                    next[y * (size_t) nw + x] =
+                        .25f * (level[y0 * lw + x0] + level[y0 * lw + x1] +
+                                level[y1 * lw + x0] + level[y1 * lw + x1]);
+                }
+            }
+            level = std::move(next);
+            lw = nw; lh = nh;
+        }
+
+        m_level_count = (uint32_t) offsets.size();
+        m_pyramid = dr::load<DynamicBuffer<Float>>(grad.data(), grad.size());
+        m_level_offsets =
+            dr::load<DynamicBuffer<UInt32>>(offsets.data(), offsets.size());
+    }
+
+    /// Bilinearly interpolated gradient lookup at a footprint-matched level
+    Vector2f filtered_grad(const SurfaceInteraction3f &si, Mask active) const {
+        ScalarFloat w = (ScalarFloat) m_res.x(), h = (ScalarFloat) m_res.y();
+
+        /* Footprint extent in texels of the finest level. A lower bound of
+           one texel ensures that shading points without valid UV partials
+           fall back to the unfiltered gradients of level zero. */
+        Float footprint = dr::maximum(
+            dr::maximum(dr::abs(si.duv_dx.x()), dr::abs(si.duv_dy.x())) * w,
+            dr::maximum(dr::abs(si.duv_dx.y()), dr::abs(si.duv_dy.y())) * h);
+        footprint = dr::maximum(footprint, 1.f);
+
+        UInt32 level  = dr::minimum(UInt32(dr::log2(footprint)),
+                                    m_level_count - 1),
+               lw     = dr::maximum(UInt32(m_res.x()) >> level, 1u),
+               lh     = dr::maximum(UInt32(m_res.y()) >> level, 1u),
+               offset = dr::gather<UInt32>(m_level_offsets, level, active);
+
+        // Wrap UV coordinates and set up bilinear interpolation weights
+        Point2f uv(si.uv.x() - dr::floor(si.uv.x()),
+                   si.uv.y() - dr::floor(si.uv.y()));
+        Float fx = dr::clamp(dr::fmadd(uv.x(), Float(lw), -.5f), 0.f, Float(lw - 1)),
+              fy = dr::clamp(dr::fmadd(uv.y(), Float(lh), -.5f), 0.f, Float(lh - 1));
+        UInt32 x0 = UInt32(fx), y0 = UInt32(fy),
+               x1 = dr::minimum(x0 + 1, lw - 1),
+               y1 = dr::minimum(y0 + 1, lh - 1);
+        Float wx = fx - Float(x0), wy = fy - Float(y0);
+
+        auto fetch = [&](const UInt32 &x, const UInt32 &y) {
+            UInt32 index = (offset + y * lw + x) * 2u;
+            return Vector2f(dr::gather<Float>(m_pyramid, index, active),
+                            dr::gather<Float>(m_pyramid, index + 1u, active));
+        };
+
+        Vector2f v00 = fetch(x0, y0), v10 = fetch(x1, y0),
+                 v01 = fetch(x0, y1), v11 = fetch(x1, y1);
+
+        return dr::lerp(dr::lerp(v00, v10, wx),
+                        dr::lerp(v01, v11, wx), wy);
+    }
+
     Frame3f frame(const SurfaceInteraction3f &si, Mask active) const {
         // Evaluate texture gradient
-        Vector2f grad_uv = m_scale * m_nested_texture->eval_1_grad(si, active);
+        Vector2f grad_uv;
+        if (m_antialias)
+            grad_uv = m_scale * filtered_grad(si, active);
+        else
+            grad_uv = m_scale * m_nested_texture->eval_1_grad(si, active);
 
         // Compute perturbed differential geometry
         Vector3f dp_du = dr::fmadd(si.sh_frame.n, grad_uv.x() - dr::dot(si.sh_frame.n, si.dp_du), si.dp_du);
@@ -241,6 +417,13 @@ protected:
     ScalarFloat m_scale;
     ref<Texture> m_nested_texture;
     ref<Base> m_nested_bsdf;
+
+    /// Footprint-filtered gradient pyramid (see \ref build_gradient_pyramid)
+    bool m_antialias;
+    ScalarVector2i m_res;
+    uint32_t m_level_count = 0;
+    DynamicBuffer<Float> m_pyramid;
+    DynamicBuffer<UInt32> m_level_offsets;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(BumpMap, BSDF)
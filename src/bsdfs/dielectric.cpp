@@ -83,6 +83,11 @@ meaningful and mutually compatible indices of refraction changes---see the
 section about :ref:`correctness considerations <bsdf-correctness>` for a
 description of what this entails.
 
+Note that the index of refraction is constant over the visible range, i.e.
+the model is *non-dispersive*. In spectral variants, all wavelengths of a
+sample batch therefore refract into the same direction and continue to be
+traced together at full throughput.
+
 In many cases, we will want to additionally describe the *medium* within a
 dielectric material. This requires the use of a rendering technique that is
 aware of media (e.g. the :ref:`volumetric path tracer <integrator-volpath>`).
@@ -90,8 +90,12 @@ public:
     SmoothDiffuse(const Properties &props) : Base(props) {
         m_reflectance = props.texture<Texture>("reflectance", .5f);
         m_flags = BSDFFlags::DiffuseReflection | BSDFFlags::FrontSide;
-        dr::set_attr(this, "flags", m_flags);
         m_components.push_back(m_flags);
+        /* Footprint-aware textures (e.g. trilinear filtering) need the UV
+           partials of the incident ray */
+        if (m_reflectance->uses_ray_differentials())
+            m_flags = m_flags | BSDFFlags::NeedsDifferentials;
+        dr::set_attr(this, "flags", m_flags);
     }
 
     void traverse(TraversalCallback *callback) override {
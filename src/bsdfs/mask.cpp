@@ -216,10 +216,12 @@ public:
         return 1 - opacity * (1 - m_nested_bsdf->eval_null_transmission(si, active));
     }
 
-    MI_INLINE Float eval_opacity(const SurfaceInteraction3f &si, Mask active) const {
+    Float eval_opacity(const SurfaceInteraction3f &si, Mask active) const override {
         return dr::clamp(m_opacity->eval_1(si, active), 0.f, 1.f);
     }
 
+    bool has_opacity_query() const override { return true; }
+
     Spectrum eval_diffuse_reflectance(const SurfaceInteraction3f &si,
                                       Mask active) const override {
         return m_nested_bsdf->eval_diffuse_reflectance(si, active);
@@ -186,6 +186,11 @@ public:
             { }, { }, false, false
         );
 
+        /* The per-direction tables below dominate the memory footprint of a
+           scene with many measured materials -- store their density data in
+           half precision. (The CDF tables used for sample warping always
+           remain in single precision, see the Marginal2D constructor.) */
+
         // Construct VNDF warp data structure
         m_vndf = Warp2D2(
             (ScalarFloat *) vndf.data,
@@ -193,7 +198,8 @@ public:
             {{ (uint32_t) phi_i.shape[0],
                (uint32_t) theta_i.shape[0] }},
             {{ (const ScalarFloat *) phi_i.data,
-               (const ScalarFloat *) theta_i.data }}
+               (const ScalarFloat *) theta_i.data }},
+            true, true, true
         );
 
         // Construct Luminance warp data structure
@@ -203,7 +209,8 @@ public:
             {{ (uint32_t) phi_i.shape[0],
                (uint32_t) theta_i.shape[0] }},
             {{ (const ScalarFloat *) phi_i.data,
-               (const ScalarFloat *) theta_i.data }}
+               (const ScalarFloat *) theta_i.data }},
+            true, true, true
         );
 
         // Construct spectral interpolant
@@ -216,7 +223,7 @@ public:
             {{ (const ScalarFloat *) phi_i.data,
                (const ScalarFloat *) theta_i.data,
                (const ScalarFloat *) wavelengths.data }},
-            false, false
+            false, false, true
         );
 
         std::string description_str(
@@ -252,30 +252,36 @@ public:
                      yi_std = dr::normalize(dr::cross(ti_std, zi_std)),
                      xi_std = dr::cross(yi_std, zi_std);
 
+            /* The 16 Mueller matrix entries form the innermost 4x4 grid of
+               the underlying tensor, so they can be fetched in one fused
+               interpolation pass that reuses the angular/wavelength indices
+               and weights across all entries. */
+            Point2f nodes[16];
+            for (int i = 0; i < 4; ++i)
+                for (int j = 0; j < 4; ++j)
+                    nodes[4 * i + j] = Point2f(j / 3.f, i / 3.f);
+
+            Float entries[16];
             if (m_wavelength == -1.f) {
-                for (int i = 0; i < 4; ++i) {
-                    for (int j = 0; j < 4; ++j) {
-                        UnpolarizedSpectrum tmp(0.f);
-                        for (size_t k = 0; k < dr::array_size_v<UnpolarizedSpectrum>; ++k) {
-                            Float params[4] = {
-                                phi_d, theta_d, theta_h,
-                                si.wavelengths[k]
-                            };
-                            tmp[k] = m_interpolator.eval(Point2f(Float(j)/3.f, Float(i)/3.f), params, active);
-                        }
-                        value(i, j) = tmp;
-                    }
+                for (size_t k = 0; k < dr::array_size_v<UnpolarizedSpectrum>; ++k) {
+                    Float params[4] = {
+                        phi_d, theta_d, theta_h,
+                        si.wavelengths[k]
+                    };
+                    m_interpolator.eval_multi(nodes, 16, entries, params, active);
+                    for (int i = 0; i < 4; ++i)
+                        for (int j = 0; j < 4; ++j)
+                            value(i, j)[k] = entries[4 * i + j];
                 }
             } else {
-                for (int i = 0; i < 4; ++i) {
-                    for (int j = 0; j < 4; ++j) {
-                        Float params[4] = {
-                            phi_d, theta_d, theta_h,
-                            Float(m_wavelength)
-                        };
-                        value(i, j) = m_interpolator.eval(Point2f(Float(j)/3.f, Float(i)/3.f), params, active);
-                    }
-                }
+                Float params[4] = {
+                    phi_d, theta_d, theta_h,
+                    Float(m_wavelength)
+                };
+                m_interpolator.eval_multi(nodes, 16, entries, params, active);
+                for (int i = 0; i < 4; ++i)
+                    for (int j = 0; j < 4; ++j)
+                        value(i, j) = entries[4 * i + j];
             }
 
             /* Invalid configurations such as transmission directions are encoded as NaNs.
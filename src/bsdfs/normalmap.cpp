@@ -104,6 +104,10 @@ public:
             m_components.push_back((m_nested_bsdf->flags(i)));
             m_flags |= m_components.back();
         }
+
+        /* The frame perturbation evaluates a texture and depends on the UV
+           tangent directions (see \ref frame()) */
+        m_flags |= BSDFFlags::SpatiallyVarying | BSDFFlags::Anisotropic;
         dr::set_attr(this, "flags", m_flags);
     }
 
@@ -185,6 +189,43 @@ public:
         return { value & active, dr::select(active, pdf, 0.f) };
     }
 
+    std::tuple<Spectrum, Float, BSDFSample3f, Spectrum>
+    eval_pdf_sample(const BSDFContext &ctx,
+                    const SurfaceInteraction3f &si,
+                    const Vector3f &wo,
+                    Float sample1,
+                    const Point2f &sample2,
+                    Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        /* Fetch the normal map and construct the perturbed shading frame
+           only once for the combined evaluation/sampling query */
+        SurfaceInteraction3f perturbed_si(si);
+        perturbed_si.sh_frame = frame(si, active);
+        perturbed_si.wi       = perturbed_si.to_local(si.wi);
+        Vector3f perturbed_wo = perturbed_si.to_local(wo);
+
+        Mask active_e = active && Frame3f::cos_theta(wo) *
+                                  Frame3f::cos_theta(perturbed_wo) > 0.f;
+
+        auto [value, pdf] =
+            m_nested_bsdf->eval_pdf(ctx, perturbed_si, perturbed_wo, active_e);
+
+        auto [bs, weight] = m_nested_bsdf->sample(ctx, perturbed_si,
+                                                  sample1, sample2, active);
+        Mask active_s = active &&
+            dr::any(dr::neq(unpolarized_spectrum(weight), 0.f));
+
+        // Transform sampled 'wo' back to original frame and check orientation
+        Vector3f sampled_wo = perturbed_si.to_world(bs.wo);
+        active_s &= Frame3f::cos_theta(bs.wo) *
+                    Frame3f::cos_theta(sampled_wo) > 0.f;
+        bs.wo = sampled_wo;
+
+        return { value & active_e, dr::select(active_e, pdf, 0.f),
+                 bs, weight & active_s };
+    }
+
     Frame3f frame(const SurfaceInteraction3f &si, Mask active) const {
         Normal3f n = dr::fmadd(m_normalmap->eval_3(si, active), 2, -1.f);
 
@@ -1,5 +1,6 @@
 #include <mitsuba/core/fwd.h>
 #include <mitsuba/core/plugin.h>
+#include <mitsuba/core/quad.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/string.h>
 #include <mitsuba/render/bsdf.h>
@@ -8,9 +9,89 @@
 #include <mitsuba/render/microfacet.h>
 #include <mitsuba/render/sampler.h>
 #include <mitsuba/render/texture.h>
+#include <drjit/dynamic.h>
+#include <map>
+#include <mutex>
 #include "principledhelpers.h"
 
+#define MI_PRINCIPLED_LOBE_COS_RES   64
+#define MI_PRINCIPLED_LOBE_ROUGH_RES 16
+
 NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Precomputed average Fresnel reflectance of the main specular lobe
+ *
+ * The lobe selection probabilities of the principled BSDF depend on the
+ * dielectric Fresnel term evaluated at a microfacet normal. Rather than
+ * evaluating it per sample, this table stores its expectation over the
+ * visible normal distribution on a regular (cos_theta, roughness) grid,
+ * where the cosine axis covers [-1, 1] to account for rays arriving from
+ * inside the material. The result only depends on the relative index of
+ * refraction, hence one table is computed per unique IOR and shared across
+ * all plugin instances through a global cache.
+ */
+template <typename ScalarFloat, typename Spectrum>
+const dr::DynamicArray<ScalarFloat> &
+principled_fresnel_table(ScalarFloat eta) {
+    using FloatX    = dr::DynamicArray<ScalarFloat>;
+    using Vector3f  = Vector<ScalarFloat, 3>;
+    using Normal3f  = Normal<ScalarFloat, 3>;
+    using Point2f   = Point<ScalarFloat, 2>;
+
+    static std::mutex cache_mutex;
+    static std::map<ScalarFloat, FloatX> cache;
+
+    /* Entries are never modified or evicted once inserted, and references
+       into a std::map remain stable, so the lock only needs to cover the
+       lookup and (possibly) the table construction */
+    std::lock_guard<std::mutex> guard(cache_mutex);
+
+    auto it = cache.find(eta);
+    if (it != cache.end())
+        return it->second;
+
+    auto [nodes, weights] = quad::gauss_legendre<FloatX>(16);
+    auto [nodes_x, nodes_y]     = dr::meshgrid(nodes, nodes);
+    auto [weights_x, weights_y] = dr::meshgrid(weights, weights);
+
+    FloatX table = dr::zeros<FloatX>(MI_PRINCIPLED_LOBE_ROUGH_RES *
+                                     MI_PRINCIPLED_LOBE_COS_RES);
+
+    for (size_t r = 0; r < MI_PRINCIPLED_LOBE_ROUGH_RES; ++r) {
+        ScalarFloat roughness = r / ScalarFloat(MI_PRINCIPLED_LOBE_ROUGH_RES - 1),
+                    alpha = dr::maximum(0.001f, dr::sqr(roughness));
+
+        mitsuba::MicrofacetDistribution<ScalarFloat, Spectrum> distr(
+            MicrofacetType::GGX, alpha);
+
+        for (size_t c = 0; c < MI_PRINCIPLED_LOBE_COS_RES; ++c) {
+            ScalarFloat cos_theta = dr::fmadd(
+                            c / ScalarFloat(MI_PRINCIPLED_LOBE_COS_RES - 1),
+                            2.f, -1.f),
+                        mu = dr::maximum(1e-6f, dr::abs(cos_theta)),
+                        sign = cos_theta < 0.f ? -1.f : 1.f;
+
+            // Incident direction, flipped into the upper hemisphere
+            Vector3f wi(dr::safe_sqrt(1.f - mu * mu), 0.f, mu);
+
+            ScalarFloat accum = 0.f;
+            for (size_t j = 0; j < dr::width(nodes_x); ++j) {
+                Point2f node(nodes_x[j], nodes_y[j]);
+                node = dr::fmadd(node, 0.5f, 0.5f);
+
+                Normal3f m = std::get<0>(distr.sample(wi, node));
+                ScalarFloat f = std::get<0>(
+                    fresnel(sign * dr::dot(wi, m), eta));
+                accum += f * weights_x[j] * weights_y[j] * 0.25f;
+            }
+
+            table.data()[r * MI_PRINCIPLED_LOBE_COS_RES + c] = accum;
+        }
+    }
+
+    return cache.emplace(eta, std::move(table)).first->second;
+}
 /**!
 .. _bsdf-principled:
 
@@ -230,12 +311,20 @@ public:
         }
 
         initialize_lobes();
+        update_lobe_table();
 
         dr::make_opaque(m_eta);
         if (!m_eta_specular)
             dr::make_opaque(m_specular);
     }
 
+    void update_lobe_table() {
+        const auto &table =
+            principled_fresnel_table<ScalarFloat, Spectrum>(dr::slice(m_eta));
+        m_lobe_fresnel =
+            dr::load<DynamicBuffer<Float>>(table.data(), dr::width(table));
+    }
+
     void initialize_lobes() {
         // Diffuse reflection lobe
         m_components.push_back(BSDFFlags::DiffuseReflection |
@@ -265,6 +354,20 @@ public:
 
         for (auto c : m_components)
             m_flags |= c;
+
+        /* Footprint-aware textures (e.g. trilinear filtering) need the UV
+           partials of the incident ray */
+        for (const Texture *t :
+             { m_base_color.get(), m_roughness.get(), m_anisotropic.get(),
+               m_spec_trans.get(), m_sheen.get(), m_sheen_tint.get(),
+               m_flatness.get(), m_spec_tint.get(), m_metallic.get(),
+               m_clearcoat.get(), m_clearcoat_gloss.get() }) {
+            if (t->uses_ray_differentials()) {
+                m_flags |= (uint32_t) BSDFFlags::NeedsDifferentials;
+                break;
+            }
+        }
+
         dr::set_attr(this, "flags", m_flags);
     }
 
@@ -323,6 +426,10 @@ public:
             dr::masked(m_eta, m_eta == 1.0f) = 1.001f;
         }
 
+        if (keys.empty() || string::contains(keys, "eta") ||
+            string::contains(keys, "specular"))
+            update_lobe_table();
+
         initialize_lobes();
 
         dr::make_opaque(m_eta);
@@ -372,18 +479,25 @@ public:
         // case.
         active &= (front_side || (bsdf > 0.0f));
 
+        /* Average Fresnel reflectance of the main specular lobe, fetched
+           from a precomputed table. Using the expectation over microfacet
+           normals instead of the per-sample term makes the lobe selection
+           probabilities a deterministic function of (cos_theta_i, roughness),
+           which \ref pdf() reproduces exactly. */
+        Float F_spec_avg = lobe_fresnel(cos_theta_i, roughness, active);
+
         // Probability definitions
         /* Inside  the material, just microfacet Reflection and
            microfacet Transmission is sampled. */
         Float prob_spec_reflect = dr::select(
                 front_side,
-                m_spec_srate * (1.0f - bsdf * (1.0f - F_spec_dielectric)),
-                F_spec_dielectric);
+                m_spec_srate * (1.0f - bsdf * (1.0f - F_spec_avg)),
+                F_spec_avg);
         Float prob_spec_trans =
                 m_has_spec_trans
                 ? dr::select(front_side,
-                             m_spec_srate * bsdf * (1.0f - F_spec_dielectric),
-                             (1.0f - F_spec_dielectric))
+                             m_spec_srate * bsdf * (1.0f - F_spec_avg),
+                             (1.0f - F_spec_avg))
                              : 0.0f;
         // Clearcoat has 1/4 of the main specular reflection energy.
         Float prob_clearcoat =
@@ -755,20 +869,22 @@ public:
         auto [ax, ay] = calc_dist_params(anisotropic, roughness,m_has_anisotropic);
         MicrofacetDistribution spec_distr(MicrofacetType::GGX, ax, ay);
 
-        // Dielectric Fresnel calculation
-        auto [F_spec_dielectric, cos_theta_t, eta_it, eta_ti] =
-                fresnel(dr::dot(si.wi, wh), m_eta);
+        /* Average Fresnel reflectance of the main specular lobe. Must match
+           the probabilities used during sampling, see \ref sample(). This
+           replaces the exact Fresnel evaluation that the remainder of this
+           method does not need. */
+        Float F_spec_avg = lobe_fresnel(cos_theta_i, roughness, active);
 
         // Defining the probabilities
         Float prob_spec_reflect = dr::select(
                 front_side,
-                m_spec_srate * (1.0f - bsdf * (1.0f - F_spec_dielectric)),
-                F_spec_dielectric);
+                m_spec_srate * (1.0f - bsdf * (1.0f - F_spec_avg)),
+                F_spec_avg);
         Float prob_spec_trans =
                 m_has_spec_trans
                 ? dr::select(front_side,
-                             m_spec_srate * bsdf * (1.0f - F_spec_dielectric),
-                             (1.0f - F_spec_dielectric))
+                             m_spec_srate * bsdf * (1.0f - F_spec_avg),
+                             (1.0f - F_spec_avg))
                              : 0.0f;
         Float prob_clearcoat =
                 m_has_clearcoat
@@ -842,6 +958,37 @@ public:
         return m_base_color->eval(si, active);
     }
 
+    /// Bilinearly interpolated fetch from the average Fresnel table
+    Float lobe_fresnel(Float cos_theta_i, Float roughness,
+                       Mask active = true) const {
+        using UInt32 = dr::uint32_array_t<Float>;
+
+        Float x = dr::clamp(dr::fmadd(cos_theta_i, 0.5f, 0.5f), 0.0f, 1.0f) *
+                  ScalarFloat(MI_PRINCIPLED_LOBE_COS_RES - 1),
+              y = dr::clamp(roughness, 0.0f, 1.0f) *
+                  ScalarFloat(MI_PRINCIPLED_LOBE_ROUGH_RES - 1);
+
+        UInt32 xi = dr::minimum(UInt32(x),
+                                uint32_t(MI_PRINCIPLED_LOBE_COS_RES - 2)),
+               yi = dr::minimum(UInt32(y),
+                                uint32_t(MI_PRINCIPLED_LOBE_ROUGH_RES - 2));
+
+        UInt32 index = yi * uint32_t(MI_PRINCIPLED_LOBE_COS_RES) + xi;
+
+        Float v00 = dr::gather<Float>(m_lobe_fresnel, index, active),
+              v01 = dr::gather<Float>(m_lobe_fresnel, index + 1u, active),
+              v10 = dr::gather<Float>(m_lobe_fresnel,
+                                      index + uint32_t(MI_PRINCIPLED_LOBE_COS_RES),
+                                      active),
+              v11 = dr::gather<Float>(m_lobe_fresnel,
+                                      index + uint32_t(MI_PRINCIPLED_LOBE_COS_RES) + 1u,
+                                      active);
+
+        return dr::lerp(dr::lerp(v00, v01, x - Float(xi)),
+                        dr::lerp(v10, v11, x - Float(xi)),
+                        y - Float(yi));
+    }
+
     std::string to_string() const override {
         std::ostringstream oss;
         oss << "Principled BSDF :" << std::endl
@@ -881,6 +1028,9 @@ private:
     Float m_specular;
     bool m_eta_specular;
 
+    /// Tabulated average Fresnel term driving the lobe selection
+    DynamicBuffer<Float> m_lobe_fresnel;
+
     /// Sampling rates
     ScalarFloat m_diff_refl_srate;
     ScalarFloat m_spec_srate;
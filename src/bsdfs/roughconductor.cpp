@@ -5,9 +5,99 @@
 #include <mitsuba/render/ior.h>
 #include <mitsuba/render/microfacet.h>
 #include <mitsuba/render/texture.h>
+#include <drjit/dynamic.h>
+#include <map>
+#include <mutex>
+
+#define MI_MICROFACET_ALBEDO_RES 32
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Precomputed directional albedo of the microfacet reflection lobe
+ *
+ * The tables store the hemispherical reflectance of the single-scattering
+ * microfacet model *excluding* the Fresnel factor, discretized over incident
+ * cosine and roughness. They only depend on the distribution type, hence a
+ * single pair of tables is computed per type and shared across all plugin
+ * instances through a global cache.
+ */
+template <typename ScalarFloat> struct MicrofacetAlbedoTables {
+    /// Directional albedo E(cos_theta, alpha), with cos_theta varying fastest
+    dr::DynamicArray<ScalarFloat> directional_albedo;
+
+    /// Cosine-weighted average albedo E_avg(alpha)
+    dr::DynamicArray<ScalarFloat> average_albedo;
+};
+
+template <typename ScalarFloat, typename Spectrum>
+const MicrofacetAlbedoTables<ScalarFloat> &
+microfacet_albedo_tables(MicrofacetType type) {
+    using Tables = MicrofacetAlbedoTables<ScalarFloat>;
+
+    static std::mutex cache_mutex;
+    static std::map<MicrofacetType, Tables> cache;
+
+    /* Entries are never modified or evicted once inserted, and references
+       into a std::map remain stable, so the lock only needs to cover the
+       lookup and (possibly) the table construction */
+    std::lock_guard<std::mutex> guard(cache_mutex);
+
+    auto it = cache.find(type);
+    if (it != cache.end())
+        return it->second;
+
+    constexpr uint32_t res = MI_MICROFACET_ALBEDO_RES;
+
+    using FloatX    = dr::DynamicArray<ScalarFloat>;
+    using FloatP    = dr::Packet<ScalarFloat>;
+    using Normal3fP = Normal<FloatP, 3>;
+    using Vector3fP = Vector<FloatP, 3>;
+
+    auto [nodes, weights] = quad::gauss_legendre<FloatX>(32);
+    auto [nodes_x, nodes_y]     = dr::meshgrid(nodes, nodes);
+    auto [weights_x, weights_y] = dr::meshgrid(weights, weights);
+
+    FloatX mu    = dr::maximum(1e-6f, dr::linspace<FloatX>(0, 1, res)),
+           alpha = dr::linspace<FloatX>(0, 1, res);
+
+    Tables tables;
+    tables.directional_albedo = dr::zeros<FloatX>(res * res);
+    tables.average_albedo     = dr::zeros<FloatX>(res);
+
+    for (uint32_t j = 0; j < res; ++j) {
+        mitsuba::MicrofacetDistribution<FloatP, Spectrum> distr(type, alpha[j]);
+
+        ScalarFloat e_avg = 0.f;
+        for (uint32_t i = 0; i < res; i += FloatP::Size) {
+            Vector3fP wi_p;
+            wi_p.z() = dr::load<FloatP>(mu.data() + i);
+            wi_p.x() = dr::sqrt(dr::fnmadd(wi_p.z(), wi_p.z(), 1.f));
+            wi_p.y() = 0.f;
+
+            FloatP result_p = 0.f;
+            for (size_t k = 0; k < dr::width(nodes_x); ++k) {
+                Vector<ScalarFloat, 2> node   = { nodes_x[k], nodes_y[k] },
+                                       weight = { weights_x[k], weights_y[k] };
+                node = dr::fmadd(node, 0.5f, 0.5f);
+
+                Normal3fP m = std::get<0>(distr.sample(wi_p, node));
+                Vector3fP wo = reflect(wi_p, m);
+                FloatP smith = distr.smith_g1(wo, m);
+                dr::masked(smith, wo.z() <= 0.f || wi_p.z() <= 0.f) = 0.f;
+                result_p += smith * dr::prod(weight) * 0.25f;
+            }
+
+            dr::store(tables.directional_albedo.data() + j * res + i, result_p);
+            e_avg += dr::sum(result_p * wi_p.z());
+        }
+
+        tables.average_albedo[j] = 2.f * e_avg / ScalarFloat(res);
+    }
+
+    return cache.emplace(type, std::move(tables)).first->second;
+}
+
 /**!
 .. _bsdf-roughconductor:
 
@@ -56,6 +146,12 @@ Rough conductor material (:monosp:`roughconductor`)
      focuses computation on the visible parts of the microfacet normal distribution, considerably
      reducing variance in some cases. (Default: |true|, i.e. use visible normal sampling)
 
+ * - energy_compensation
+   - |bool|
+   - Compensates for the energy lost by the single-scattering microfacet model at high
+     roughness values by adding an approximate multiple-scattering component based on
+     precomputed directional albedo tables. (Default: |false|)
+
 This plugin implements a realistic microfacet scattering model for rendering
 rough conducting materials, such as metals.
 
@@ -142,6 +238,14 @@ approach of sampling all normals is still available and can be enabled
 by setting :monosp:`sample_visible` to :monosp:`false`. However this will lead
 to significantly slower convergence.
 
+The single-scattering microfacet model ignores light paths that bounce between
+several microfacets before leaving the surface, which causes rough metals to
+appear noticeably too dark. Setting :monosp:`energy_compensation` to |true|
+re-injects the missing energy using a diffuse-like lobe that is derived from
+precomputed directional albedo tables of the microfacet distribution. The
+tables are computed once per distribution type and shared across all plugin
+instances, and the evaluation cost amounts to a few bilinear table lookups.
+
 When using this plugin, you should ideally compile Mitsuba with support for
 spectral rendering to get the most accurate results. While it also works
 in RGB mode, the computations will be more approximate in nature.
@@ -186,6 +290,21 @@ public:
 
         m_sample_visible = props.get<bool>("sample_visible", true);
 
+        m_energy_compensation = props.get<bool>("energy_compensation", false);
+        if (m_energy_compensation) {
+            // Fetch the directional albedo tables (shared across instances)
+            const auto &tables =
+                microfacet_albedo_tables<ScalarFloat, Spectrum>(m_type);
+
+            m_directional_albedo = dr::load<DynamicBuffer<Float>>(
+                tables.directional_albedo.data(),
+                dr::width(tables.directional_albedo));
+
+            m_average_albedo = dr::load<DynamicBuffer<Float>>(
+                tables.average_albedo.data(),
+                dr::width(tables.average_albedo));
+        }
+
         if (props.has_property("alpha_u") || props.has_property("alpha_v")) {
             if (!props.has_property("alpha_u") || !props.has_property("alpha_v"))
                 Throw("Microfacet model: both 'alpha_u' and 'alpha_v' must be specified.");
@@ -297,6 +416,14 @@ public:
             F = fresnel_conductor(UnpolarizedSpectrum(dr::dot(si.wi, m)), eta_c);
         }
 
+        /* Account for the energy lost to multiple scattering between the
+           microfacets. The sampling density is left untouched -- the extra
+           lobe is smooth, so it is simply folded into the sample weight. */
+        if (unlikely(m_energy_compensation))
+            weight += eval_multiple_scatter(distr, cos_theta_i,
+                                            Frame3f::cos_theta(bs.wo),
+                                            active) / bs.pdf;
+
         /* If requested, include the specular reflectance component */
         if (m_specular_reflectance)
             weight *= m_specular_reflectance->eval(si, active);
@@ -337,6 +464,10 @@ public:
         // Evaluate the full microfacet model (except Fresnel)
         UnpolarizedSpectrum result = D * G / (4.f * Frame3f::cos_theta(si.wi));
 
+        // Account for the energy lost to multiple scattering between the microfacets
+        if (unlikely(m_energy_compensation))
+            result += eval_multiple_scatter(distr, cos_theta_i, cos_theta_o, active);
+
         // Evaluate the Fresnel factor
         dr::Complex<UnpolarizedSpectrum> eta_c(m_eta->eval(si, active),
                                            m_k->eval(si, active));
@@ -452,6 +583,10 @@ public:
         // Evaluate the full microfacet model (except Fresnel)
         UnpolarizedSpectrum value = D * G / (4.f * Frame3f::cos_theta(si.wi));
 
+        // Account for the energy lost to multiple scattering between the microfacets
+        if (unlikely(m_energy_compensation))
+            value += eval_multiple_scatter(distr, cos_theta_i, cos_theta_o, active);
+
         // Evaluate the Fresnel factor
         dr::Complex<UnpolarizedSpectrum> eta_c(m_eta->eval(si, active),
                                            m_k->eval(si, active));
@@ -495,11 +630,73 @@ public:
         return { F * value & active, dr::select(active, pdf, 0.f) };
     }
 
+    /// Bilinear lookup into the directional albedo table E(cos_theta, alpha)
+    Float directional_albedo(Float cos_theta, Float alpha, Mask active) const {
+        uint32_t res = MI_MICROFACET_ALBEDO_RES;
+
+        Float x = dr::clamp(cos_theta, 0.f, 1.f) * Float(res - 1),
+              y = dr::clamp(alpha,     0.f, 1.f) * Float(res - 1);
+
+        UInt32 xi = dr::minimum(UInt32(x), res - 2),
+               yi = dr::minimum(UInt32(y), res - 2),
+               index = yi * res + xi;
+
+        Float v00 = dr::gather<Float>(m_directional_albedo, index,           active),
+              v10 = dr::gather<Float>(m_directional_albedo, index + 1,       active),
+              v01 = dr::gather<Float>(m_directional_albedo, index + res,     active),
+              v11 = dr::gather<Float>(m_directional_albedo, index + res + 1, active);
+
+        Float fx = x - Float(xi), fy = y - Float(yi);
+        return dr::lerp(dr::lerp(v00, v10, fx), dr::lerp(v01, v11, fx), fy);
+    }
+
+    /// Linear lookup into the average albedo table E_avg(alpha)
+    Float average_albedo(Float alpha, Mask active) const {
+        uint32_t res = MI_MICROFACET_ALBEDO_RES;
+
+        Float x = dr::clamp(alpha, 0.f, 1.f) * Float(res - 1);
+        UInt32 index = dr::minimum(UInt32(x), res - 2);
+
+        Float v0 = dr::gather<Float>(m_average_albedo, index,     active),
+              v1 = dr::gather<Float>(m_average_albedo, index + 1, active);
+
+        return dr::lerp(v0, v1, x - Float(index));
+    }
+
+    /**
+     * \brief Evaluate the approximate multiple-scattering component
+     *
+     * Following the reciprocal formulation of Kulla and Conty, the energy
+     * that the single-scattering model loses to inter-facet bounces is
+     * re-injected as a separate lobe proportional to
+     * (1 - E(cos_theta_i)) (1 - E(cos_theta_o)) / (pi (1 - E_avg)),
+     * where E denotes the Fresnel-free directional albedo of the microfacet
+     * model. The caller is expected to multiply by the Fresnel factor, which
+     * approximates the attenuation of the additional bounces without
+     * requiring tabulated spectral averages of the conductor Fresnel curve.
+     *
+     * The returned value is premultiplied by \c cos_theta_o to match the
+     * convention of \ref eval().
+     */
+    Float eval_multiple_scatter(const MicrofacetDistribution &distr,
+                                Float cos_theta_i, Float cos_theta_o,
+                                Mask active) const {
+        Float alpha = dr::sqrt(distr.alpha_u() * distr.alpha_v());
+
+        Float e_i   = directional_albedo(cos_theta_i, alpha, active),
+              e_o   = directional_albedo(cos_theta_o, alpha, active),
+              e_avg = average_albedo(alpha, active);
+
+        return (1.f - e_i) * (1.f - e_o) * cos_theta_o /
+               dr::maximum(dr::Pi<Float> * (1.f - e_avg), 1e-4f);
+    }
+
     std::string to_string() const override {
         std::ostringstream oss;
         oss << "RoughConductor[" << std::endl
             << "  distribution = " << m_type << "," << std::endl
             << "  sample_visible = " << m_sample_visible << "," << std::endl
+            << "  energy_compensation = " << m_energy_compensation << "," << std::endl
             << "  alpha_u = " << string::indent(m_alpha_u) << "," << std::endl
             << "  alpha_v = " << string::indent(m_alpha_v) << "," << std::endl;
         if (m_specular_reflectance)
@@ -518,6 +715,10 @@ private:
     ref<Texture> m_alpha_u, m_alpha_v;
     /// Importance sample the distribution of visible normals?
     bool m_sample_visible;
+    /// Compensate for the energy lost to multiple scattering?
+    bool m_energy_compensation;
+    /// Directional albedo tables used for energy compensation
+    DynamicBuffer<Float> m_directional_albedo, m_average_albedo;
     /// Relative refractive index (real component)
     ref<Texture> m_eta;
     /// Relative refractive index (imaginary component).
@@ -8,9 +8,69 @@
 #include <mitsuba/render/fresnel.h>
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/sampler.h>
+#include <drjit/dynamic.h>
+#include <map>
+#include <mutex>
+
+#define MI_DIELECTRIC_ALBEDO_RES 32
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Precomputed directional albedo of a rough dielectric interface
+ *
+ * The table stores the combined hemispherical reflectance and transmittance
+ * of the single-scattering microfacet model (including Fresnel), discretized
+ * over incident cosine and roughness. It only depends on the distribution
+ * type and the relative index of refraction, hence tables are computed once
+ * per unique parameter set and shared across all plugin instances through a
+ * global cache.
+ */
+template <typename ScalarFloat, typename Spectrum>
+const dr::DynamicArray<ScalarFloat> &
+rough_dielectric_albedo_table(MicrofacetType type, ScalarFloat eta) {
+    using FloatX = dr::DynamicArray<ScalarFloat>;
+    using Key    = std::pair<MicrofacetType, ScalarFloat>;
+
+    static std::mutex cache_mutex;
+    static std::map<Key, FloatX> cache;
+
+    Key key(type, eta);
+
+    /* Entries are never modified or evicted once inserted, and references
+       into a std::map remain stable, so the lock only needs to cover the
+       lookup and (possibly) the table construction */
+    std::lock_guard<std::mutex> guard(cache_mutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return it->second;
+
+    constexpr uint32_t res = MI_DIELECTRIC_ALBEDO_RES;
+
+    using Vector3fX = Vector<FloatX, 3>;
+    using FloatP    = dr::Packet<ScalarFloat>;
+
+    FloatX mu = dr::maximum(1e-6f, dr::linspace<FloatX>(0, 1, res)),
+           alpha = dr::linspace<FloatX>(0, 1, res),
+           zero = dr::zeros<FloatX>(res);
+
+    Vector3fX wi = Vector3fX(dr::sqrt(1 - mu * mu), zero, mu);
+
+    FloatX table = dr::zeros<FloatX>(res * res);
+    for (uint32_t j = 0; j < res; ++j) {
+        mitsuba::MicrofacetDistribution<FloatP, Spectrum> distr(type, alpha[j]);
+
+        FloatX row = eval_reflectance(distr, wi, eta) +
+                     eval_transmittance(distr, wi, eta);
+
+        for (uint32_t i = 0; i < res; ++i)
+            table[j * res + i] = row[i];
+    }
+
+    return cache.emplace(key, std::move(table)).first->second;
+}
+
 /**!
 
 .. _bsdf-roughdielectric:
@@ -60,6 +120,12 @@ Rough dielectric material (:monosp:`roughdielectric`)
      focuses computation on the visible parts of the microfacet normal distribution, considerably
      reducing variance in some cases. (Default: |true|, i.e. use visible normal sampling)
 
+ * - energy_compensation
+   - |bool|
+   - Compensates for the energy lost by the single-scattering microfacet model at high
+     roughness values by rescaling the model based on precomputed directional albedo
+     tables. (Default: |false|)
+
  * - eta
    - |float|
    - Relative index of refraction from the exterior to the interior
@@ -151,6 +217,14 @@ approach of sampling all normals is still available and can be enabled
 by setting :monosp:`sample_visible` to |false|. However this will lead
 to significantly slower convergence.
 
+The single-scattering microfacet model ignores light paths that bounce between
+several microfacets before leaving the surface, which causes rough glass to
+appear noticeably too dark. Setting :monosp:`energy_compensation` to |true|
+rescales the model by the reciprocal of its directional albedo, which is
+fetched from precomputed tables covering both sides of the interface. Note
+that this scaling only depends on the incident direction and therefore
+breaks reciprocity slightly.
+
  */
 
 template <typename Float, typename Spectrum>
@@ -194,6 +268,8 @@ public:
 
         m_sample_visible = props.get<bool>("sample_visible", true);
 
+        m_energy_compensation = props.get<bool>("energy_compensation", false);
+
         if (props.has_property("alpha_u") || props.has_property("alpha_v")) {
             if (!props.has_property("alpha_u") || !props.has_property("alpha_v"))
                 Throw("Microfacet model: both 'alpha_u' and 'alpha_v' must be specified.");
@@ -232,8 +308,25 @@ public:
             callback->put_object("specular_transmittance", m_specular_transmittance.get(), +ParamFlags::Differentiable);
     }
 
-    void parameters_changed(const std::vector<std::string> &/*keys*/ = {}) override {
+    void parameters_changed(const std::vector<std::string> &keys = {}) override {
         m_inv_eta = dr::rcp(m_eta);
+
+        // Fetch the directional albedo tables (shared across instances)
+        if (m_energy_compensation &&
+            (keys.empty() || string::contains(keys, "eta"))) {
+            ScalarFloat eta = dr::slice(m_eta);
+
+            const auto &external = rough_dielectric_albedo_table<ScalarFloat, Spectrum>(
+                m_type, eta);
+            const auto &internal = rough_dielectric_albedo_table<ScalarFloat, Spectrum>(
+                m_type, ScalarFloat(1) / eta);
+
+            m_external_albedo = dr::load<DynamicBuffer<Float>>(
+                external.data(), dr::width(external));
+            m_internal_albedo = dr::load<DynamicBuffer<Float>>(
+                internal.data(), dr::width(internal));
+        }
+
         dr::make_opaque(m_eta, m_inv_eta);
     }
 
@@ -348,6 +441,11 @@ public:
             weight *= distr.G(si.wi, bs.wo, m) * dr::dot(si.wi, m) /
                       (cos_theta_i * Frame3f::cos_theta(m));
 
+        // Account for the energy lost to multiple scattering between the microfacets
+        if (unlikely(m_energy_compensation))
+            weight *= energy_compensation_factor(
+                cos_theta_i, dr::sqrt(distr.alpha_u() * distr.alpha_v()), active);
+
         bs.pdf *= dr::abs(dwh_dwo);
 
         return { bs, depolarizer<Spectrum>(weight) & active };
@@ -426,6 +524,11 @@ public:
             result[eval_t] = value;
         }
 
+        // Account for the energy lost to multiple scattering between the microfacets
+        if (unlikely(m_energy_compensation))
+            result *= energy_compensation_factor(
+                cos_theta_i, dr::sqrt(distr.alpha_u() * distr.alpha_v()), active);
+
         return depolarizer<Spectrum>(result);
     }
 
@@ -582,6 +685,11 @@ public:
             result[eval_t] = value;
         }
 
+        // Account for the energy lost to multiple scattering between the microfacets
+        if (unlikely(m_energy_compensation))
+            result *= energy_compensation_factor(
+                cos_theta_i, dr::sqrt(distr.alpha_u() * distr.alpha_v()), active);
+
         /* Trick by Walter et al.: slightly scale the roughness values to
            reduce importance sampling weights. Not needed for the
            Heitz and D'Eon sampling technique. */
@@ -603,11 +711,55 @@ public:
                  dr::select(active, pdf * dr::abs(dwh_dwo), 0.f) };
     }
 
+    /// Bilinear lookup into a directional albedo table E(cos_theta, alpha)
+    Float bilinear_albedo(const DynamicBuffer<Float> &data, Float cos_theta,
+                          Float alpha, Mask active) const {
+        uint32_t res = MI_DIELECTRIC_ALBEDO_RES;
+
+        Float x = dr::clamp(cos_theta, 0.f, 1.f) * Float(res - 1),
+              y = dr::clamp(alpha,     0.f, 1.f) * Float(res - 1);
+
+        UInt32 xi = dr::minimum(UInt32(x), res - 2),
+               yi = dr::minimum(UInt32(y), res - 2),
+               index = yi * res + xi;
+
+        Float v00 = dr::gather<Float>(data, index,           active),
+              v10 = dr::gather<Float>(data, index + 1,       active),
+              v01 = dr::gather<Float>(data, index + res,     active),
+              v11 = dr::gather<Float>(data, index + res + 1, active);
+
+        Float fx = x - Float(xi), fy = y - Float(yi);
+        return dr::lerp(dr::lerp(v00, v10, fx), dr::lerp(v01, v11, fx), fy);
+    }
+
+    /**
+     * \brief Multiple-scattering compensation factor
+     *
+     * Rescales the single-scattering model by the reciprocal of its
+     * directional albedo so that the energy lost to inter-facet bounces is
+     * re-injected into the two lobes proportionally. The factor is clamped
+     * to avoid amplifying quadrature noise in the precomputed tables.
+     */
+    Float energy_compensation_factor(Float cos_theta_i, Float alpha,
+                                     Mask active) const {
+        Mask front = cos_theta_i > 0.f;
+
+        Float e_ext = bilinear_albedo(m_external_albedo, dr::abs(cos_theta_i),
+                                      alpha, active && front),
+              e_int = bilinear_albedo(m_internal_albedo, dr::abs(cos_theta_i),
+                                      alpha, active && !front);
+
+        Float albedo = dr::select(front, e_ext, e_int);
+
+        return dr::clamp(dr::rcp(dr::maximum(albedo, 1e-3f)), 1.f, 10.f);
+    }
+
     std::string to_string() const override {
         std::ostringstream oss;
         oss << "RoughDielectric[" << std::endl
             << "  distribution = "           << m_type           << "," << std::endl
-            << "  sample_visible = "         << (int) m_sample_visible << "," << std::endl;
+            << "  sample_visible = "         << (int) m_sample_visible << "," << std::endl
+            << "  energy_compensation = "    << (int) m_energy_compensation << "," << std::endl;
 
         if (!has_flag(m_flags, BSDFFlags::Anisotropic)) {
             oss << "  alpha = "                  << string::indent(m_alpha_v) << "," << std::endl;
@@ -635,6 +787,10 @@ private:
     ref<Texture> m_alpha_u, m_alpha_v;
     Float m_eta, m_inv_eta;
     bool m_sample_visible;
+    /// Compensate for the energy lost to multiple scattering?
+    bool m_energy_compensation;
+    /// Directional albedo tables for both sides of the interface
+    DynamicBuffer<Float> m_external_albedo, m_internal_albedo;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(RoughDielectric, BSDF)
@@ -9,11 +9,70 @@
 #include <mitsuba/render/microfacet.h>
 #include <mitsuba/render/texture.h>
 #include <drjit/dynamic.h>
+#include <map>
+#include <mutex>
 
 #define MI_ROUGH_TRANSMITTANCE_RES 64
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Precomputed internal-scattering profiles of a rough
+ * dielectric-coated material
+ *
+ * These tables only depend on the microfacet distribution type, the surface
+ * roughness, and the relative index of refraction. Scenes often instantiate
+ * many plastic materials that share this configuration while only varying
+ * textures, hence the tables are computed once per unique parameter set and
+ * shared across all plugin instances through a global cache.
+ */
+template <typename ScalarFloat> struct RoughTransmittanceTables {
+    /// Directional Fresnel transmittance, discretized over \c cos_theta
+    dr::DynamicArray<ScalarFloat> external_transmittance;
+
+    /// Average reflectance of light that scatters back towards the interface
+    ScalarFloat internal_reflectance;
+};
+
+template <typename ScalarFloat, typename Spectrum>
+const RoughTransmittanceTables<ScalarFloat> &
+rough_transmittance_tables(MicrofacetType type, ScalarFloat alpha,
+                           ScalarFloat eta) {
+    using Tables = RoughTransmittanceTables<ScalarFloat>;
+    using Key    = std::tuple<MicrofacetType, ScalarFloat, ScalarFloat>;
+
+    static std::mutex cache_mutex;
+    static std::map<Key, Tables> cache;
+
+    Key key(type, alpha, eta);
+
+    /* Entries are never modified or evicted once inserted, and references
+       into a std::map remain stable, so the lock only needs to cover the
+       lookup and (possibly) the table construction */
+    std::lock_guard<std::mutex> guard(cache_mutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return it->second;
+
+    using FloatX    = dr::DynamicArray<ScalarFloat>;
+    using Vector3fX = Vector<FloatX, 3>;
+    using FloatP    = dr::Packet<ScalarFloat>;
+
+    mitsuba::MicrofacetDistribution<FloatP, Spectrum> distr(type, alpha);
+    FloatX mu = dr::maximum(1e-6f, dr::linspace<FloatX>(0, 1, MI_ROUGH_TRANSMITTANCE_RES));
+    FloatX zero = dr::zeros<FloatX>(MI_ROUGH_TRANSMITTANCE_RES);
+
+    Vector3fX wi = Vector3fX(dr::sqrt(1 - mu * mu), zero, mu);
+
+    Tables tables;
+    tables.external_transmittance = eval_transmittance(distr, wi, eta);
+    tables.internal_reflectance =
+        dr::mean(eval_reflectance(distr, wi, ScalarFloat(1) / eta) * wi.z()) * 2.f;
+
+    return cache.emplace(key, std::move(tables)).first->second;
+}
+
 /**!
 .. _bsdf-roughplastic:
 
@@ -228,27 +287,18 @@ public:
 
         m_specular_sampling_weight = s_mean / (d_mean + s_mean);
 
-        // Precompute rough reflectance (vectorized)
+        // Fetch the rough reflectance tables (shared across instances)
         if (keys.empty() || string::contains(keys, "alpha") || string::contains(keys, "eta")) {
-            using FloatX = DynamicBuffer<ScalarFloat>;
-            using Vector3fX = Vector<FloatX, 3>;
             ScalarFloat eta = dr::slice(m_eta), alpha = dr::slice(m_alpha);
 
-            using FloatP = dr::Packet<dr::scalar_t<Float>>;
-            mitsuba::MicrofacetDistribution<FloatP, Spectrum> distr(m_type, alpha);
-            FloatX mu = dr::maximum(1e-6f, dr::linspace<FloatX>(0, 1, MI_ROUGH_TRANSMITTANCE_RES));
-            FloatX zero = dr::zeros<FloatX>(MI_ROUGH_TRANSMITTANCE_RES);
-
-            Vector3fX wi = Vector3fX(dr::sqrt(1 - mu * mu), zero, mu);
-
-            auto external_transmittance = eval_transmittance(distr, wi, eta);
+            const auto &tables =
+                rough_transmittance_tables<ScalarFloat, Spectrum>(m_type, alpha, eta);
 
             m_external_transmittance = dr::load<DynamicBuffer<Float>>(
-                external_transmittance.data(),
-                dr::width(external_transmittance));
+                tables.external_transmittance.data(),
+                dr::width(tables.external_transmittance));
 
-            m_internal_reflectance =
-                dr::mean(eval_reflectance(distr, wi, 1.f / eta) * wi.z()) * 2.f;
+            m_internal_reflectance = tables.internal_reflectance;
         }
         dr::make_opaque(m_eta, m_inv_eta_2, m_alpha, m_specular_sampling_weight,
                         m_internal_reflectance);
@@ -184,3 +184,44 @@ def test05_sample_components(variant_scalar_rgb):
     expected_b = weight*1.0    # InvPi will cancel out with sampling pdf, but still need to apply weight
     bs_b, weight_b = bsdf.sample(ctx, si, 0.3, [0.5, 0.5])
     assert dr.allclose(weight_b, expected_b)
+
+
+def test06_eval_pdf_sample(variant_scalar_rgb):
+    weight = 0.2
+
+    bsdf = mi.load_string(f"""<bsdf version="3.0.0" type="blendbsdf">
+        <float name="weight" value="{weight}"/>
+        <bsdf type="diffuse">
+            <rgb name="reflectance" value="0.0"/>
+        </bsdf>
+        <bsdf type="diffuse">
+            <rgb name="reflectance" value="1.0"/>
+        </bsdf>
+    </bsdf>""")
+
+    si = mi.SurfaceInteraction3f()
+    si.t = 0.1
+    si.p = [0, 0, 0]
+    si.n = [0, 0, 1]
+    si.sh_frame = mi.Frame3f(si.n)
+    si.wi = [0, 0, 1]
+
+    ctx = mi.BSDFContext()
+    wo = [0, 0, 1]
+
+    # The fused query must agree with separate eval_pdf() and sample() calls,
+    # both when sampling all components and a single one
+    for component in [None, 0, 1]:
+        if component is not None:
+            ctx.component = component
+
+        for sample1 in [0.1, 0.3]:
+            value, pdf, bs, bs_weight = bsdf.eval_pdf_sample(ctx, si, wo, sample1, [0.5, 0.5])
+            value_ref, pdf_ref = bsdf.eval_pdf(ctx, si, wo)
+            bs_ref, bs_weight_ref = bsdf.sample(ctx, si, sample1, [0.5, 0.5])
+
+            assert dr.allclose(value, value_ref)
+            assert dr.allclose(pdf, pdf_ref)
+            assert dr.allclose(bs.wo, bs_ref.wo)
+            assert dr.allclose(bs.pdf, bs_ref.pdf)
+            assert dr.allclose(bs_weight, bs_weight_ref)
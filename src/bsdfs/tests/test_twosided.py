@@ -134,3 +134,37 @@ def test03_eval_diffuse_reflectance(variants_vec_rgb):
 
             assert dr.allclose(dr.select(up, value - value_front, 0), 0.0)
             assert dr.allclose(dr.select(up, 0, value - value_back), 0.0)
+
+
+def test04_eval_pdf_sample(variant_scalar_rgb):
+    bsdf = mi.load_string("""<bsdf version="3.0.0" type="twosided">
+        <bsdf type="diffuse">
+            <rgb name="reflectance" value="0.1, 0.1, 0.1"/>
+        </bsdf>
+        <bsdf type="diffuse">
+            <rgb name="reflectance" value="0.9, 0.9, 0.9"/>
+        </bsdf>
+    </bsdf>""")
+
+    si = mi.SurfaceInteraction3f()
+    si.t = 0.1
+    si.p = [0, 0, 0]
+    si.n = [0, 0, 1]
+    si.sh_frame = mi.Frame3f(si.n)
+    ctx = mi.BSDFContext()
+
+    # The fused query must agree with separate eval_pdf() and sample() calls
+    # on both sides of the surface
+    for wi_z in [1, -1]:
+        si.wi = [0, 0, wi_z]
+        wo = [0, 0, wi_z]
+
+        value, pdf, bs, weight = bsdf.eval_pdf_sample(ctx, si, wo, 0.4, [0.5, 0.5])
+        value_ref, pdf_ref = bsdf.eval_pdf(ctx, si, wo)
+        bs_ref, weight_ref = bsdf.sample(ctx, si, 0.4, [0.5, 0.5])
+
+        assert dr.allclose(value, value_ref)
+        assert dr.allclose(pdf, pdf_ref)
+        assert dr.allclose(bs.wo, bs_ref.wo)
+        assert dr.allclose(bs.pdf, bs_ref.pdf)
+        assert dr.allclose(weight, weight_ref)
@@ -257,6 +257,57 @@ public:
         return { value, pdf };
     }
 
+    std::tuple<Spectrum, Float, BSDFSample3f, Spectrum>
+    eval_pdf_sample(const BSDFContext &ctx_,
+                    const SurfaceInteraction3f &si_,
+                    const Vector3f &wo_,
+                    Float sample1,
+                    const Point2f &sample2,
+                    Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+
+        using Result = std::tuple<Spectrum, Float, BSDFSample3f, Spectrum>;
+
+        SurfaceInteraction3f si(si_);
+        BSDFContext ctx(ctx_);
+        Vector3f wo(wo_);
+        Result result = dr::zeros<Result>();
+
+        /* The default implementation in the base class would call eval_pdf()
+           and sample() separately, flipping the frame and dispatching to the
+           nested BRDF twice. Forward the combined call instead so that the
+           adapter adds only a single frame flip. */
+        if (m_brdf[0] == m_brdf[1]) {
+            wo.z() = dr::mulsign(wo.z(), si.wi.z());
+            si.wi.z() = dr::abs(si.wi.z());
+            result = m_brdf[0]->eval_pdf_sample(ctx, si, wo, sample1,
+                                                sample2, active);
+            std::get<2>(result).wo.z() =
+                dr::mulsign(std::get<2>(result).wo.z(), si_.wi.z());
+        } else {
+            Mask front_side = Frame3f::cos_theta(si.wi) > 0.f && active,
+                 back_side  = Frame3f::cos_theta(si.wi) < 0.f && active;
+
+            if (dr::any_or<true>(front_side))
+                dr::masked(result, front_side) = m_brdf[0]->eval_pdf_sample(
+                    ctx, si, wo, sample1, sample2, front_side);
+
+            if (dr::any_or<true>(back_side)) {
+                if (ctx.component != (uint32_t) -1)
+                    ctx.component -= (uint32_t) m_brdf[0]->component_count();
+
+                si.wi.z() *= -1.f;
+                wo.z() *= -1.f;
+
+                dr::masked(result, back_side) = m_brdf[1]->eval_pdf_sample(
+                    ctx, si, wo, sample1, sample2, back_side);
+                dr::masked(std::get<2>(result).wo.z(), back_side) *= -1.f;
+            }
+        }
+
+        return result;
+    }
+
     Spectrum eval_diffuse_reflectance(const SurfaceInteraction3f &si_,
                                       Mask active) const override {
         SurfaceInteraction3f si(si_);
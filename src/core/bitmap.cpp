@@ -6,7 +6,9 @@
 #include <mitsuba/core/rfilter.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/fstream.h>
+#include <mitsuba/core/mmap.h>
 #include <mitsuba/core/profiler.h>
+#include <mutex>
 #include <unordered_map>
 
 #include <nanothread/nanothread.h>
@@ -115,6 +117,105 @@ Bitmap::Bitmap(const fs::path &filename, FileFormat format) {
     read(fs, format);
 }
 
+/* Fixed-size description stored at the front of shared bitmap segments,
+   followed directly by the pixel data. Only images whose channel layout is
+   implied by the pixel format can be described this way -- arbitrary
+   multi-channel images are loaded privately instead. */
+struct SharedBitmapLayout {
+    uint32_t pixel_format;
+    uint32_t component_format;
+    uint32_t width, height;
+    uint32_t channel_count;
+    uint8_t srgb_gamma;
+    uint8_t premultiplied_alpha;
+    uint8_t pad[2];
+};
+
+ref<Bitmap> Bitmap::load_shared(const fs::path &path, FileFormat format) {
+    /* Key the segment by the file contents so that identical assets resolve
+       to the same segment irrespective of their location (FNV-1a) */
+    uint64_t content_hash = 0xcbf29ce484222325ull;
+    {
+        ref<MemoryMappedFile> file = new MemoryMappedFile(path);
+        const uint8_t *ptr = (const uint8_t *) file->data();
+        for (size_t i = 0, n = file->size(); i < n; ++i)
+            content_hash = (content_hash ^ ptr[i]) * 0x100000001b3ull;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "mi_%016llx",
+             (unsigned long long) content_hash);
+
+    /* Attached segments intentionally outlive the bitmaps viewing them: the
+       point of sharing is that assets stay resident for the process lifetime.
+       A function-local registry also lets repeated loads of the same asset
+       within one process reuse the existing mapping. */
+    static std::mutex mutex;
+    static std::unordered_map<std::string, ref<MemoryMappedFile>> segments;
+
+    std::lock_guard<std::mutex> guard(mutex);
+
+    ref<MemoryMappedFile> mmap;
+    auto it = segments.find(name);
+    if (it != segments.end()) {
+        mmap = it->second;
+    } else {
+        /* Decode locally first: the segment size must be known up front, and
+           the decoded copy is needed anyway if this process turns out to be
+           the one creating the segment */
+        ref<Bitmap> bitmap = new Bitmap(path, format);
+        if (bitmap->pixel_format() == PixelFormat::MultiChannel)
+            return bitmap;
+
+        bool created = false;
+        try {
+            mmap = MemoryMappedFile::create_or_attach_shared(
+                name, sizeof(SharedBitmapLayout) + bitmap->buffer_size(),
+                &created);
+        } catch (const std::exception &e) {
+            Log(Warn, "load_shared(): unable to share \"%s\" (%s), falling "
+                "back to a private copy.", path.string(), e.what());
+            return bitmap;
+        }
+
+        if (created) {
+            SharedBitmapLayout layout;
+            memset(&layout, 0, sizeof(SharedBitmapLayout));
+            layout.pixel_format        = (uint32_t) bitmap->pixel_format();
+            layout.component_format    = (uint32_t) bitmap->component_format();
+            layout.width               = bitmap->width();
+            layout.height              = bitmap->height();
+            layout.channel_count       = (uint32_t) bitmap->channel_count();
+            layout.srgb_gamma          = bitmap->srgb_gamma() ? 1 : 0;
+            layout.premultiplied_alpha = bitmap->premultiplied_alpha() ? 1 : 0;
+
+            memcpy(mmap->data(), &layout, sizeof(SharedBitmapLayout));
+            memcpy((uint8_t *) mmap->data() + sizeof(SharedBitmapLayout),
+                   bitmap->data(), bitmap->buffer_size());
+            mmap->mark_shared_ready();
+        }
+
+        segments[name] = mmap;
+    }
+
+    SharedBitmapLayout layout;
+    memcpy(&layout, mmap->data(), sizeof(SharedBitmapLayout));
+
+    ref<Bitmap> result = new Bitmap(
+        (PixelFormat) layout.pixel_format, (Struct::Type) layout.component_format,
+        Vector2u(layout.width, layout.height), layout.channel_count, {},
+        (uint8_t *) mmap->data() + sizeof(SharedBitmapLayout));
+
+    if (sizeof(SharedBitmapLayout) + result->buffer_size() != mmap->size())
+        Throw("load_shared(): shared segment for \"%s\" has an unexpected "
+              "size -- possibly a hash collision or a corrupted segment!",
+              path.string());
+
+    result->set_srgb_gamma(layout.srgb_gamma != 0);
+    result->set_premultiplied_alpha(layout.premultiplied_alpha != 0);
+    return result;
+}
+
 Bitmap::~Bitmap() {
     if (!m_owns_data)
         m_data.release();
@@ -308,20 +409,23 @@ resample(Bitmap *target, const Bitmap *source,
     }
 
     if (source->height() != target->height() || Filter) {
-        // Re-sample vertically
+        /* Re-sample vertically. This pass computes whole output scanlines at
+           a time: each filter tap then accumulates a contiguous span of the
+           source image, which vectorizes well, instead of gathering each
+           column with a stride of one scanline per sample. */
         Resampler<Scalar> r(rfilter, source->height(), target->height());
         r.set_boundary_condition(bc.second);
         r.set_clamp(clamp);
 
+        uint32_t elements = (uint32_t) (target->width() * channels);
         dr::parallel_for(
-            dr::blocked_range<size_t>(0, source->width(), 100),
+            dr::blocked_range<size_t>(0, target->height(), 100),
             [&](const dr::blocked_range<size_t> &range) {
-                for (auto x = range.begin(); x != range.end(); ++x) {
-                    const Scalar *s = (const Scalar *) source->uint8_data() +
-                                      x * channels;
+                for (auto y = range.begin(); y != range.end(); ++y) {
+                    const Scalar *s = (const Scalar *) source->uint8_data();
                     Scalar *t       = (Scalar *) target->uint8_data() +
-                                      x * channels;
-                    r.resample(s, source->width(), t, target->width(), (uint32_t) channels);
+                                      y * (size_t) elements;
+                    r.resample_row((uint32_t) y, s, t, elements);
                 }
             }
         );
@@ -1288,20 +1392,30 @@ void Bitmap::read_exr(Stream *stream) {
     }
 }
 
-void Bitmap::write_exr(Stream *stream, int quality) const {
-    ScopedPhase phase(ProfilerPhase::BitmapWrite);
-
-    PixelFormat pixel_format = m_pixel_format;
+/// Map a \ref Struct field type to the matching OpenEXR component type
+static Imf::PixelType exr_pixel_type(Struct::Type type) {
+    switch (type) {
+        case Struct::Type::Float32: return Imf::FLOAT;
+        case Struct::Type::Float16: return Imf::HALF;
+        case Struct::Type::UInt32: return Imf::UINT;
+        default: Throw("Unexpected field type!");
+    }
+}
 
-    Properties metadata(m_metadata);
+/// Construct an OpenEXR header (shared by \ref Bitmap::write_exr() and \ref StreamingEXRWriter)
+static Imf::Header build_exr_header(const Bitmap::Vector2u &size,
+                                    const Properties &metadata_,
+                                    Bitmap::PixelFormat pixel_format,
+                                    int quality) {
+    Properties metadata(metadata_);
     if (!metadata.has_property("generatedBy"))
         metadata.set_string("generatedBy", "Mitsuba version " MI_VERSION);
 
     std::vector<std::string> keys = metadata.property_names();
 
     Imf::Header header(
-        (int) m_size.x(),  // width
-        (int) m_size.y(),  // height,
+        (int) size.x(),    // width
+        (int) size.y(),    // height,
         1.f,               // pixelAspectRatio
         Imath::V2f(0, 0),  // screenWindowCenter,
         1.f,               // screenWindowWidth
@@ -1355,7 +1469,8 @@ void Bitmap::write_exr(Stream *stream, int quality) const {
         }
     }
 
-    if (pixel_format == PixelFormat::XYZ || pixel_format == PixelFormat::XYZA) {
+    if (pixel_format == Bitmap::PixelFormat::XYZ ||
+        pixel_format == Bitmap::PixelFormat::XYZA) {
         Imf::addChromaticities(header, Imf::Chromaticities(
             Imath::V2f(1.f, 0.f),
             Imath::V2f(0.f, 1.f),
@@ -1363,6 +1478,15 @@ void Bitmap::write_exr(Stream *stream, int quality) const {
             Imath::V2f(1.f / 3.f, 1.f / 3.f)));
     }
 
+    return header;
+}
+
+void Bitmap::write_exr(Stream *stream, int quality) const {
+    ScopedPhase phase(ProfilerPhase::BitmapWrite);
+
+    Imf::Header header =
+        build_exr_header(m_size, m_metadata, m_pixel_format, quality);
+
     size_t pixel_stride = m_struct->size(),
            row_stride = pixel_stride * m_size.x();
 
@@ -1370,14 +1494,7 @@ void Bitmap::write_exr(Stream *stream, int quality) const {
     Imf::FrameBuffer framebuffer;
     const uint8_t *ptr = uint8_data();
     for (auto field : *m_struct) {
-        Imf::PixelType comp_type;
-        switch (field.type) {
-            case Struct::Type::Float32: comp_type = Imf::FLOAT; break;
-            case Struct::Type::Float16: comp_type = Imf::HALF; break;
-            case Struct::Type::UInt32: comp_type = Imf::UINT; break;
-            default: Throw("Unexpected field type!");
-        }
-
+        Imf::PixelType comp_type = exr_pixel_type(field.type);
         Imf::Slice slice(comp_type, (char *) (ptr + field.offset), pixel_stride, row_stride);
         channels.insert(field.name, Imf::Channel(comp_type));
         framebuffer.insert(field.name, slice);
@@ -1389,6 +1506,74 @@ void Bitmap::write_exr(Stream *stream, int quality) const {
     file.writePixels((int) m_size.y());
 }
 
+/// Holds the OpenEXR state of \ref StreamingEXRWriter out of the public header
+struct StreamingEXRWriter::WriterPrivate {
+    EXROStream ostr;
+    Imf::OutputFile file;
+
+    WriterPrivate(Stream *stream, const Imf::Header &header)
+        : ostr(stream), file(ostr, header) { }
+};
+
+StreamingEXRWriter::StreamingEXRWriter(Stream *stream, const Vector2u &size,
+                                       const Bitmap *prototype, int quality)
+    : m_stream(stream), m_struct(new Struct(*prototype->struct_())),
+      m_size(size), m_rows_written(0) {
+    Imf::Header header = build_exr_header(size, prototype->metadata(),
+                                          prototype->pixel_format(), quality);
+
+    Imf::ChannelList &channels = header.channels();
+    for (auto field : *m_struct)
+        channels.insert(field.name, Imf::Channel(exr_pixel_type(field.type)));
+
+    d.reset(new WriterPrivate(stream, header));
+}
+
+StreamingEXRWriter::~StreamingEXRWriter() {
+    if (m_rows_written != m_size.y())
+        Log(Warn, "StreamingEXRWriter: only %u of %u scanlines were written, "
+                  "the resulting image will be incomplete!",
+            m_rows_written, m_size.y());
+}
+
+void StreamingEXRWriter::write(const Bitmap *band) {
+    ScopedPhase phase(ProfilerPhase::BitmapWrite);
+
+    if (band->width() != m_size.x())
+        Throw("StreamingEXRWriter::write(): band width (%u) does not match "
+              "the image width (%u)!", band->width(), m_size.x());
+
+    if (*band->struct_() != *m_struct)
+        Throw("StreamingEXRWriter::write(): band channel layout %s does not "
+              "match the prototype %s!", band->struct_()->to_string(),
+              m_struct->to_string());
+
+    if (m_rows_written + band->height() > m_size.y())
+        Throw("StreamingEXRWriter::write(): attempted to write past the end "
+              "of the image (%u + %u > %u scanlines)!", m_rows_written,
+              band->height(), m_size.y());
+
+    size_t pixel_stride = m_struct->size(),
+           row_stride   = pixel_stride * m_size.x();
+
+    /* OpenEXR framebuffer coordinates reference scanline 0 of the full
+       image; shift the base pointer so that the band's first row maps to
+       the scanlines being written */
+    const uint8_t *ptr =
+        band->uint8_data() - (size_t) m_rows_written * row_stride;
+
+    Imf::FrameBuffer framebuffer;
+    for (auto field : *m_struct)
+        framebuffer.insert(field.name,
+                           Imf::Slice(exr_pixel_type(field.type),
+                                      (char *) (ptr + field.offset),
+                                      pixel_stride, row_stride));
+
+    d->file.setFrameBuffer(framebuffer);
+    d->file.writePixels((int) band->height());
+    m_rows_written += band->height();
+}
+
 // -----------------------------------------------------------------------------
 //   JPEG bitmap I/O
 // -----------------------------------------------------------------------------
@@ -2504,5 +2689,6 @@ void Bitmap::static_initialization() {
 void Bitmap::static_shutdown() { }
 
 MI_IMPLEMENT_CLASS(Bitmap, Object)
+MI_IMPLEMENT_CLASS(StreamingEXRWriter, Object)
 
 NAMESPACE_END(mitsuba)
@@ -16,7 +16,7 @@
     BSD-style license that can be found in the LICENSE.txt file.
 */
 
-#include <mitsuba/mitsuba.h>
+#include <mitsuba/core/qmc.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -1,4 +1,5 @@
 #include <mitsuba/core/fresolver.h>
+#include <nanothread/nanothread.h>
 #include <sstream>
 #include <algorithm>
 
@@ -12,6 +13,7 @@ FileResolver::FileResolver(const FileResolver &fr)
   : Object(), m_paths(fr.m_paths) { }
 
 void FileResolver::erase(const fs::path &p) {
+    flush_cache();
     m_paths.erase(std::remove(m_paths.begin(), m_paths.end(), p), m_paths.end());
 }
 
@@ -20,6 +22,18 @@ bool FileResolver::contains(const fs::path &p) const {
 }
 
 fs::path FileResolver::resolve(const fs::path &path) const {
+    // Serve lookups that were warmed up via prefetch() from the cache
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        auto it = m_cache.find(path.string());
+        if (it != m_cache.end())
+            return it->second;
+    }
+
+    return resolve_uncached(path);
+}
+
+fs::path FileResolver::resolve_uncached(const fs::path &path) const {
     if (!path.is_absolute()) {
         for (auto const &base : m_paths) {
             fs::path combined = base / path;
@@ -30,6 +44,33 @@ fs::path FileResolver::resolve(const fs::path &path) const {
     return path;
 }
 
+void FileResolver::prefetch(const std::vector<fs::path> &paths) {
+    if (paths.empty())
+        return;
+
+    std::vector<fs::path> resolved(paths.size());
+
+    /* Walk the search paths for all entries in parallel: on network
+       filesystems, the latency of the underlying 'stat' calls dominates,
+       and overlapping them is worth far more than the threading overhead. */
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, paths.size(), 1),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                resolved[i] = resolve_uncached(paths[i]);
+        }
+    );
+
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    for (size_t i = 0; i < paths.size(); ++i)
+        m_cache.emplace(paths[i].string(), resolved[i]);
+}
+
+void FileResolver::flush_cache() {
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    m_cache.clear();
+}
+
 std::string FileResolver::to_string() const {
     std::ostringstream oss;
     oss << "FileResolver[" << std::endl;
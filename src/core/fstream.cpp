@@ -24,14 +24,18 @@ inline std::ios::openmode ios_flag(FileStream::EMode mode) {
 
 NAMESPACE_END(detail)
 
-FileStream::FileStream(const fs::path &p, EMode mode)
-    : Stream(), m_mode(mode), m_path(p), m_file(new std::fstream) {
+FileStream::FileStream(const fs::path &p, EMode mode, size_t buffer_size)
+    : Stream(), m_mode(mode), m_path(p), m_file(new std::fstream),
+      m_buffer_capacity(buffer_size) {
 
     m_file->open(p.string(), detail::ios_flag(mode));
 
     if (!m_file->good())
         Throw("\"%s\": I/O error while attempting to open file: %s",
               m_path.string(), strerror(errno));
+
+    if (m_buffer_capacity > 0)
+        m_buffer = std::unique_ptr<char[]>(new char[m_buffer_capacity]);
 }
 
 FileStream::~FileStream() {
@@ -47,22 +51,81 @@ bool FileStream::is_closed() const {
 };
 
 void FileStream::read(void *p, size_t size) {
-    m_file->read((char *) p, size);
+    char *out = (char *) p;
+    size_t remaining = size;
+
+    // Serve as much as possible from the read-ahead buffer
+    size_t avail = m_buffer_filled - m_buffer_pos;
+    if (avail > 0) {
+        size_t n = std::min(avail, remaining);
+        memcpy(out, m_buffer.get() + m_buffer_pos, n);
+        m_buffer_pos += n;
+        out += n;
+        remaining -= n;
+        if (remaining == 0)
+            return;
+    }
+
+    /* The buffer is exhausted; the underlying stream position now matches
+       the logical read position. Large requests bypass the buffer, small
+       ones trigger a refill. */
+    m_buffer_offset += m_buffer_filled;
+    m_buffer_filled = m_buffer_pos = 0;
+
+    bool buffered = remaining < m_buffer_capacity;
+    m_file->read(buffered ? m_buffer.get() : out,
+                 buffered ? m_buffer_capacity : remaining);
 
     if (unlikely(!m_file->good())) {
         bool eof = m_file->eof();
         size_t gcount = m_file->gcount();
         m_file->clear();
-        if (eof)
-            throw EOFException(tfm::format("\"%s\": read %zu out of %zu bytes",
-                                           m_path.string(), gcount, size), gcount);
-        else
+
+        if (!eof)
             Throw("\"%s\": I/O error while attempting to read %zu bytes: %s",
                   m_path.string(), size, strerror(errno));
+
+        if (buffered)
+            m_buffer_filled = gcount;
+
+        if (!buffered || gcount < remaining) {
+            size_t served = size - remaining + gcount;
+            if (buffered) {
+                memcpy(out, m_buffer.get(), gcount);
+                m_buffer_pos = m_buffer_filled;
+            }
+            throw EOFException(tfm::format("\"%s\": read %zu out of %zu bytes",
+                                           m_path.string(), served, size),
+                               served);
+        }
+    } else if (buffered) {
+        m_buffer_filled = m_buffer_capacity;
+    }
+
+    if (buffered) {
+        memcpy(out, m_buffer.get(), remaining);
+        m_buffer_pos = remaining;
     }
 }
 
+void FileStream::flush_read_buffer() {
+    if (m_buffer_filled == 0)
+        return;
+
+    size_t pos = m_buffer_offset + m_buffer_pos;
+    m_buffer_offset = pos;
+    m_buffer_filled = m_buffer_pos = 0;
+
+    m_file->seekg(static_cast<std::ios::pos_type>(pos));
+    if (unlikely(!m_file->good()))
+        Throw("\"%s\": I/O error while attempting to seek to offset %zu: %s",
+              m_path.string(), pos, strerror(errno));
+}
+
 void FileStream::write(const void *p, size_t size) {
+    // Writes invalidate the read-ahead buffer
+    flush_read_buffer();
+
     m_file->write((char *) p, size);
 
     if (unlikely(!m_file->good())) {
@@ -78,6 +141,7 @@ void FileStream::truncate(size_t size) {
               m_path.string());
     }
 
+    flush_read_buffer();
     flush();
     const size_t old_pos = tell();
 #if defined(_WIN32)
@@ -100,6 +164,16 @@ void FileStream::truncate(size_t size) {
 }
 
 void FileStream::seek(size_t pos) {
+    // Seeks within the buffered window only move the read cursor
+    if (m_buffer_filled > 0 && pos >= m_buffer_offset &&
+        pos <= m_buffer_offset + m_buffer_filled) {
+        m_buffer_pos = pos - m_buffer_offset;
+        return;
+    }
+
+    m_buffer_filled = m_buffer_pos = 0;
+    m_buffer_offset = pos;
+
     m_file->seekg(static_cast<std::ios::pos_type>(pos));
 
     if (unlikely(!m_file->good()))
@@ -112,7 +186,9 @@ size_t FileStream::tell() const {
     if (unlikely(pos == std::ios::pos_type(-1)))
         Throw("\"%s\": I/O error while attempting to determine "
               "position in file", m_path.string());
-    return static_cast<size_t>(pos);
+
+    // Account for data that was read ahead but not yet consumed
+    return static_cast<size_t>(pos) - (m_buffer_filled - m_buffer_pos);
 }
 
 void FileStream::flush() {
@@ -129,6 +205,8 @@ size_t FileStream::size() const {
 }
 
 std::string FileStream::read_line() {
+    flush_read_buffer();
+
     std::string result;
     if (!std::getline(*m_file, result))
         Log(Error, "\"%s\": I/O error while attempting to read a line of text: %s", m_path.string(),
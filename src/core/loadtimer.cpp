@@ -0,0 +1,108 @@
+#include <mitsuba/core/loadtimer.h>
+#include <mitsuba/core/util.h>
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+NAMESPACE_BEGIN(mitsuba)
+NAMESPACE_BEGIN(load_stats)
+
+/* The registry is tiny and only touched on the loading path, hence a plain
+   mutex-protected vector (kept in first-occurrence order for reporting)
+   is preferable to anything fancier. */
+static std::mutex registry_mutex;
+static std::vector<StageTiming> registry;
+
+/* Innermost active timer of the current thread, used to compute
+   exclusive durations for nested plugin construction */
+static thread_local ScopedLoadTimer *current_timer = nullptr;
+
+void clear() {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    registry.clear();
+}
+
+void record(const std::string &stage, const std::string &name,
+            double seconds) {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    for (StageTiming &t : registry) {
+        if (t.stage == stage && t.name == name) {
+            t.count++;
+            t.seconds += seconds;
+            return;
+        }
+    }
+    registry.push_back({ stage, name, 1, seconds });
+}
+
+std::vector<StageTiming> timings() {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    return registry;
+}
+
+std::string report() {
+    std::vector<StageTiming> entries = timings();
+
+    // Stage totals, in first-occurrence order
+    std::vector<std::pair<std::string, double>> stages;
+    for (const StageTiming &t : entries) {
+        auto it = std::find_if(stages.begin(), stages.end(),
+                               [&](const auto &s) { return s.first == t.stage; });
+        if (it == stages.end())
+            stages.emplace_back(t.stage, t.seconds);
+        else
+            it->second += t.seconds;
+    }
+
+    auto format_line = [](std::ostringstream &oss, size_t indent,
+                          const std::string &label, double seconds,
+                          size_t count) {
+        oss << std::endl << std::string(indent, ' ') << label << ' ';
+        for (size_t i = indent + label.length(); i < 40; ++i)
+            oss << '.';
+        oss << ' ' << util::time_string((float) (seconds * 1e3));
+        if (count > 1)
+            oss << " (" << count << "x)";
+    };
+
+    // Within a stage, list classes by decreasing time
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const StageTiming &a, const StageTiming &b) {
+                         return a.seconds > b.seconds;
+                     });
+
+    std::ostringstream oss;
+    oss << "Scene loading breakdown:";
+    for (const auto &[stage, total] : stages) {
+        format_line(oss, 2, stage, total, 1);
+        for (const StageTiming &t : entries) {
+            if (t.stage != stage || t.name.empty())
+                continue;
+            format_line(oss, 4, t.name, t.seconds, t.count);
+        }
+    }
+    return oss.str();
+}
+
+ScopedLoadTimer::ScopedLoadTimer(std::string stage, std::string name)
+    : m_stage(std::move(stage)), m_name(std::move(name)),
+      m_start(std::chrono::high_resolution_clock::now()),
+      m_parent(current_timer) {
+    current_timer = this;
+}
+
+ScopedLoadTimer::~ScopedLoadTimer() {
+    double elapsed =
+        std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - m_start)
+            .count();
+
+    current_timer = m_parent;
+    if (m_parent)
+        m_parent->m_child_time += elapsed;
+
+    record(m_stage, m_name, elapsed - m_child_time);
+}
+
+NAMESPACE_END(load_stats)
+NAMESPACE_END(mitsuba)
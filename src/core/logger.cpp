@@ -7,21 +7,182 @@
 #include <thread>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Bounded multi-producer queue of preformatted log records
+ *
+ * This follows Dmitry Vyukov's classic array-based design: every cell carries
+ * a sequence number that producers use to claim cells with a single
+ * compare-exchange, so worker threads never serialize on a mutex when
+ * submitting a message. The implementation below additionally assumes a
+ * single consumer (the drain thread of \ref Logger::set_async()).
+ */
+struct AsyncLogQueue {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        std::string text;
+    };
+
+    /// Queue capacity, must be a power of two
+    static constexpr size_t Size = 1024;
+
+    AsyncLogQueue() : cells(new Cell[Size]) {
+        for (size_t i = 0; i < Size; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// Append a record, returns \c false when the queue is full
+    bool try_push(LogLevel level, std::string &text) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell &cell = cells[pos & (Size - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.level = level;
+                    cell.text = std::move(text);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Remove a record (single consumer), returns \c false when empty
+    bool try_pop(LogLevel &level, std::string &text) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Cell &cell = cells[pos & (Size - 1)];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+        if ((intptr_t) seq - (intptr_t) (pos + 1) < 0)
+            return false;
+
+        level = cell.level;
+        text = std::move(cell.text);
+        dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+        cell.sequence.store(pos + Size, std::memory_order_release);
+        return true;
+    }
+
+    std::atomic<size_t> enqueue_pos { 0 };
+    std::atomic<size_t> dequeue_pos { 0 };
+    std::unique_ptr<Cell[]> cells;
+};
+
 struct Logger::LoggerPrivate {
     std::mutex mutex;
     LogLevel error_level = Error;
     std::vector<ref<Appender>> appenders;
     ref<Formatter> formatter;
+
+    // Asynchronous delivery machinery (see \ref Logger::set_async())
+    std::unique_ptr<AsyncLogQueue> queue;
+    std::thread worker;
+    std::mutex queue_mutex;           //< Guards the two condition variables
+    std::condition_variable queue_cv; //< Signals the drain thread
+    std::condition_variable flush_cv; //< Signals \ref Logger::flush() callers
+    std::atomic<bool> async { false };
+    std::atomic<bool> exit_worker { false };
+    std::atomic<size_t> enqueued { 0 };
+    std::atomic<size_t> appended { 0 };
+
+    /// Forward a record to all registered appenders
+    void append(LogLevel level, const std::string &text) {
+        std::lock_guard<std::mutex> guard(mutex);
+        for (auto entry : appenders)
+            entry->append(level, text);
+    }
 };
 
 Logger::Logger(LogLevel log_level)
     : m_log_level(log_level), d(new LoggerPrivate()) { }
 
-Logger::~Logger() { }
+Logger::~Logger() {
+    set_async(false);
+}
+
+void Logger::set_async(bool enabled) {
+    if (enabled == d->worker.joinable())
+        return;
+
+    if (enabled) {
+        d->queue.reset(new AsyncLogQueue());
+        d->exit_worker.store(false, std::memory_order_relaxed);
+        d->async.store(true, std::memory_order_release);
+
+        d->worker = std::thread([this]() {
+            LogLevel level;
+            std::string text;
+
+            while (true) {
+                bool did_work = false;
+                while (d->queue->try_pop(level, text)) {
+                    d->append(level, text);
+                    d->appended.fetch_add(1, std::memory_order_release);
+                    did_work = true;
+                }
+
+                if (did_work)
+                    d->flush_cv.notify_all();
+
+                if (d->exit_worker.load(std::memory_order_acquire))
+                    break;
+
+                /* Producers notify without holding the lock, hence a wakeup
+                   may occasionally be missed -- the timeout below bounds the
+                   resulting delivery latency */
+                std::unique_lock<std::mutex> lock(d->queue_mutex);
+                d->queue_cv.wait_for(lock, std::chrono::milliseconds(50));
+            }
+        });
+    } else {
+        d->async.store(false, std::memory_order_release);
+        d->exit_worker.store(true, std::memory_order_release);
+        d->queue_cv.notify_one();
+        d->worker.join();
+
+        /* Deliver records that raced with the shutdown of the drain thread */
+        LogLevel level;
+        std::string text;
+        while (d->queue->try_pop(level, text)) {
+            d->append(level, text);
+            d->appended.fetch_add(1, std::memory_order_release);
+        }
+
+        d->queue.reset();
+    }
+}
+
+bool Logger::async() const {
+    return d->async.load(std::memory_order_acquire);
+}
+
+void Logger::flush() {
+    if (!d->worker.joinable())
+        return;
+
+    size_t target = d->enqueued.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(d->queue_mutex);
+    while (d->appended.load(std::memory_order_acquire) < target) {
+        d->queue_cv.notify_one();
+        d->flush_cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
 
 void Logger::set_formatter(Formatter *formatter) {
     std::lock_guard<std::mutex> guard(d->mutex);
@@ -68,9 +229,21 @@ void Logger::log(LogLevel level, const Class *class_, const char *file,
     std::string text = d->formatter->format(level, class_,
         Thread::thread(), file, line, msg);
 
-    std::lock_guard<std::mutex> guard(d->mutex);
-    for (auto entry : d->appenders)
-        entry->append(level, text);
+    if (d->async.load(std::memory_order_acquire)) {
+        /* Hand the preformatted record to the drain thread. Apply
+           back-pressure rather than dropping records when the queue is
+           full. */
+        while (unlikely(!d->queue->try_push(level, text))) {
+            d->queue_cv.notify_one();
+            std::this_thread::yield();
+        }
+
+        d->enqueued.fetch_add(1, std::memory_order_release);
+        d->queue_cv.notify_one();
+        return;
+    }
+
+    d->append(level, text);
 }
 
 void Logger::log_progress(float progress, const std::string &name,
@@ -92,6 +265,7 @@ void Logger::remove_appender(Appender *appender) {
 }
 
 std::string Logger::read_log() {
+    flush();
     std::lock_guard<std::mutex> guard(d->mutex);
     for (auto appender: d->appenders) {
         if (appender->class_()->derives_from(MI_CLASS(StreamAppender))) {
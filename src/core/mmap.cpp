@@ -1,8 +1,13 @@
 #include <mitsuba/core/mmap.h>
 #include <mitsuba/core/util.h>
+#include <mitsuba/core/timer.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #if defined(__linux__) || defined(__APPLE__)
 # include <sys/mman.h>
+# include <sys/stat.h>
 # include <fcntl.h>
 # include <unistd.h>
 #elif defined(_WIN32)
@@ -11,6 +16,21 @@
 
 NAMESPACE_BEGIN(mitsuba)
 
+/* Prefixed to named shared-memory segments; lets attaching processes discover
+   the payload size and wait until the creator has published the contents. The
+   payload offset is padded to a multiple of 64 bytes so that it retains a
+   usable alignment. */
+struct SharedMemoryHeader {
+    uint32_t magic;
+    uint32_t pad;
+    uint64_t payload_size;
+    std::atomic<uint32_t> ready;
+};
+
+static constexpr uint32_t shared_memory_magic  = 0x4d695348u /* 'MiSH' */;
+static constexpr size_t   shared_header_size   = 64;
+static constexpr size_t   shared_timeout_ms    = 60000;
+
 struct MemoryMappedFile::MemoryMappedFilePrivate {
     fs::path filename;
 #if defined(_WIN32)
@@ -21,9 +41,15 @@ struct MemoryMappedFile::MemoryMappedFilePrivate {
     void *data;
     bool can_write;
     bool temp;
+    bool shared;
+    /* Full mapping of a shared segment, including the header that precedes
+       the payload exposed via 'data' */
+    void *base;
+    size_t full_size;
 
     MemoryMappedFilePrivate(const fs::path &f = "", size_t s = 0)
-        : filename(f), size(s), data(nullptr), can_write(false), temp(false) { }
+        : filename(f), size(s), data(nullptr), can_write(false), temp(false),
+          shared(false), base(nullptr), full_size(0) { }
 
     void create() {
         #if defined(__linux__) || defined(__APPLE__)
@@ -171,7 +197,160 @@ struct MemoryMappedFile::MemoryMappedFilePrivate {
         #endif
     }
 
+    /// Returns \c true if this call created the segment, \c false if it attached
+    bool create_or_attach_shared(const std::string &name) {
+        if (name.empty() || name.find('/') != std::string::npos)
+            Throw("create_or_attach_shared(): \"%s\" is not a valid segment "
+                  "name!", name);
+
+        filename = fs::path(name);
+        shared = true;
+        bool created;
+
+        #if defined(__linux__) || defined(__APPLE__)
+            std::string shm_name = "/" + name;
+
+            int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0664);
+            created = fd != -1;
+
+            if (created) {
+                full_size = shared_header_size + size;
+
+                if (ftruncate(fd, (off_t) full_size) == -1) {
+                    close(fd);
+                    shm_unlink(shm_name.c_str());
+                    Throw("Could not set size of shared memory segment \"%s\": %s",
+                          name, strerror(errno));
+                }
+
+                base = mmap(nullptr, full_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, 0);
+                close(fd);
+                if (base == MAP_FAILED) {
+                    base = nullptr;
+                    shm_unlink(shm_name.c_str());
+                    Throw("Could not map shared memory segment \"%s\"!", name);
+                }
+
+                SharedMemoryHeader *header = (SharedMemoryHeader *) base;
+                header->magic = shared_memory_magic;
+                header->payload_size = size;
+                header->ready.store(0, std::memory_order_release);
+                can_write = true;
+            } else {
+                if (errno != EEXIST)
+                    Throw("Could not create shared memory segment \"%s\": %s",
+                          name, strerror(errno));
+
+                fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+                if (fd == -1)
+                    Throw("Could not open shared memory segment \"%s\": %s",
+                          name, strerror(errno));
+
+                /* The creator may not have sized the segment yet */
+                Timer timer;
+                struct stat sb { };
+                while (true) {
+                    if (fstat(fd, &sb) == -1) {
+                        close(fd);
+                        Throw("Could not query shared memory segment \"%s\": %s",
+                              name, strerror(errno));
+                    }
+                    if ((size_t) sb.st_size >= shared_header_size)
+                        break;
+                    if (timer.value() > shared_timeout_ms) {
+                        close(fd);
+                        Throw("Timed out while waiting for shared memory "
+                              "segment \"%s\" to be initialized!", name);
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+
+                full_size = (size_t) sb.st_size;
+                base = mmap(nullptr, full_size, PROT_READ, MAP_SHARED, fd, 0);
+                close(fd);
+                if (base == MAP_FAILED) {
+                    base = nullptr;
+                    Throw("Could not map shared memory segment \"%s\"!", name);
+                }
+                can_write = false;
+            }
+        #elif defined(_WIN32)
+            file = INVALID_HANDLE_VALUE;
+            full_size = shared_header_size + size;
+            std::wstring shm_name(name.begin(), name.end());
+
+            file_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr,
+                PAGE_READWRITE, (DWORD) ((uint64_t) full_size >> 32),
+                (DWORD) full_size, shm_name.c_str());
+            if (file_mapping == nullptr)
+                Throw("CreateFileMapping: Could not create shared memory "
+                      "segment \"%s\": %s", name, util::last_error());
+            created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+            base = (void *) MapViewOfFile(file_mapping, FILE_MAP_WRITE, 0, 0, 0);
+            if (base == nullptr)
+                Throw("MapViewOfFile: Could not map shared memory segment "
+                      "\"%s\": %s", name, util::last_error());
+
+            if (created) {
+                SharedMemoryHeader *header = (SharedMemoryHeader *) base;
+                header->magic = shared_memory_magic;
+                header->payload_size = size;
+                header->ready.store(0, std::memory_order_release);
+                can_write = true;
+            } else {
+                can_write = false;
+            }
+        #endif
+
+        if (!created) {
+            /* Block until the creator has published the segment contents */
+            SharedMemoryHeader *header = (SharedMemoryHeader *) base;
+            Timer timer;
+            while (header->ready.load(std::memory_order_acquire) == 0) {
+                if (timer.value() > shared_timeout_ms)
+                    Throw("Timed out while waiting for shared memory segment "
+                          "\"%s\" to be published!", name);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            if (header->magic != shared_memory_magic ||
+                shared_header_size + header->payload_size > full_size)
+                Throw("Shared memory segment \"%s\" is corrupted!", name);
+            size = (size_t) header->payload_size;
+        }
+
+        data = (uint8_t *) base + shared_header_size;
+        return created;
+    }
+
     void unmap() {
+        if (shared) {
+            Log(Trace, "Unmapping shared memory segment \"%s\"",
+                filename.string());
+
+            /* Note: the segment itself is intentionally left in place so that
+               other processes (incl. future ones) can still attach to it --
+               see unlink_shared() */
+            #if defined(__linux__) || defined(__APPLE__)
+                if (munmap(base, full_size) != 0)
+                    Throw("munmap(): unable to unmap memory: %s", strerror(errno));
+            #elif defined(_WIN32)
+                if (!UnmapViewOfFile(base))
+                    Throw("UnmapViewOfFile(): unable to unmap memory: %s",
+                          util::last_error());
+                if (!CloseHandle(file_mapping))
+                    Throw("CloseHandle(): unable to close file mapping: %s",
+                          util::last_error());
+            #endif
+
+            base = nullptr;
+            data = nullptr;
+            size = full_size = 0;
+            return;
+        }
+
         Log(Trace, "Unmapping \"%s\" from memory", filename.string());
 
         #if defined(__linux__) || defined(__APPLE__)
@@ -240,6 +419,9 @@ MemoryMappedFile::~MemoryMappedFile() {
 void MemoryMappedFile::resize(size_t size) {
     if (!d->data)
         Throw("Internal error in MemoryMappedFile::resize()!");
+    if (d->shared)
+        Throw("MemoryMappedFile::resize(): shared memory segments cannot be "
+              "resized!");
     bool temp = d->temp;
     d->temp = false;
     d->unmap();
@@ -269,6 +451,43 @@ const fs::path &MemoryMappedFile::filename() const {
     return d->filename;
 }
 
+bool MemoryMappedFile::shared() const {
+    return d->shared;
+}
+
+ref<MemoryMappedFile> MemoryMappedFile::create_or_attach_shared(
+    const std::string &name, size_t size, bool *created) {
+    ref<MemoryMappedFile> result = new MemoryMappedFile();
+    result->d->size = size;
+    bool created_ = result->d->create_or_attach_shared(name);
+    Log(Trace, "%s shared memory segment \"%s\" (%s)..",
+        created_ ? "Created" : "Attached to", name,
+        util::mem_string(result->d->size));
+    if (created)
+        *created = created_;
+    return result;
+}
+
+void MemoryMappedFile::mark_shared_ready() {
+    if (!d->shared || !d->can_write)
+        Throw("MemoryMappedFile::mark_shared_ready(): only applicable to "
+              "shared memory segments created by this process!");
+    ((SharedMemoryHeader *) d->base)->ready.store(1, std::memory_order_release);
+}
+
+void MemoryMappedFile::unlink_shared(const std::string &name) {
+    #if defined(__linux__) || defined(__APPLE__)
+        std::string shm_name = "/" + name;
+        if (shm_unlink(shm_name.c_str()) != 0 && errno != ENOENT)
+            Throw("Could not unlink shared memory segment \"%s\": %s", name,
+                  strerror(errno));
+    #else
+        /* Windows named mappings disappear with the last handle referencing
+           them -- there is nothing to unlink */
+        (void) name;
+    #endif
+}
+
 ref<MemoryMappedFile> MemoryMappedFile::create_temporary(size_t size) {
     ref<MemoryMappedFile> result = new MemoryMappedFile();
     result->d->size = size;
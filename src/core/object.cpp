@@ -6,11 +6,17 @@
 NAMESPACE_BEGIN(mitsuba)
 
 void Object::dec_ref(bool dealloc) const noexcept {
-    uint32_t ref_count = m_ref_count.fetch_sub(1);
+    /* A release ordering on the decrement suffices: it ensures that all
+       prior accesses to the object happen before the count drops. The
+       thread that observes the final decrement issues a matching acquire
+       fence before deallocating, so it sees those accesses. This avoids
+       two full barriers per decrement on weakly ordered architectures. */
+    int ref_count = m_ref_count.fetch_sub(1, std::memory_order_release);
     if (ref_count <= 0) {
         fprintf(stderr, "Internal error: Object reference count < 0!\n");
         abort();
     } else if (ref_count == 1 && dealloc) {
+        std::atomic_thread_fence(std::memory_order_acquire);
         delete this;
     }
 }
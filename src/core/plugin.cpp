@@ -1,3 +1,4 @@
+#include <mitsuba/core/loadtimer.h>
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/logger.h>
@@ -16,6 +17,26 @@
 
 NAMESPACE_BEGIN(mitsuba)
 
+/* Plugins may be linked directly into the Mitsuba library ("slim" builds,
+   see the MI_STATIC_PLUGINS build option), in which case they announce
+   themselves through the registry below during static initialization instead
+   of being discovered via dlopen(). The registry is a function-local static
+   to sidestep initialization order issues with the PluginManager singleton. */
+struct StaticPlugin {
+    std::string class_name;
+    std::string descr;
+};
+
+static std::unordered_map<std::string, StaticPlugin> &static_plugin_registry() {
+    static std::unordered_map<std::string, StaticPlugin> registry;
+    return registry;
+}
+
+detail::StaticPluginRegistration::StaticPluginRegistration(
+    const char *name, const char *class_name, const char *descr) {
+    static_plugin_registry()[name] = StaticPlugin { class_name, descr };
+}
+
 class Plugin {
 public:
     Plugin(const fs::path &path) : m_path(path) {
@@ -138,6 +159,9 @@ PluginManager::~PluginManager() {
 }
 
 void PluginManager::ensure_plugin_loaded(const std::string &name) {
+    // Plugins linked into the library itself are always available
+    if (static_plugin_registry().count(name))
+        return;
     (void) d->plugin(name);
 }
 
@@ -151,8 +175,15 @@ const Class *PluginManager::get_plugin_class(const std::string &name,
     if (it != d->m_python_plugins.end()) {
         plugin_class = Class::for_name(name, variant);
     } else {
-        const Plugin *plugin = d->plugin(name);
-        plugin_class = Class::for_name(plugin->plugin_name, variant);
+        auto &static_plugins = static_plugin_registry();
+        auto it_static = static_plugins.find(name);
+        if (it_static != static_plugins.end()) {
+            plugin_class =
+                Class::for_name(it_static->second.class_name, variant);
+        } else {
+            const Plugin *plugin = d->plugin(name);
+            plugin_class = Class::for_name(plugin->plugin_name, variant);
+        }
     }
 
     return plugin_class;
@@ -160,6 +191,8 @@ const Class *PluginManager::get_plugin_class(const std::string &name,
 
 std::vector<std::string> PluginManager::loaded_plugins() const {
     std::vector<std::string> list;
+    for (auto const &pair: static_plugin_registry())
+        list.push_back(pair.first);
     std::lock_guard<std::mutex> guard(d->m_mutex);
     for (auto const &pair: d->m_plugins)
         list.push_back(pair.first);
@@ -175,8 +208,11 @@ void PluginManager::register_python_plugin(const std::string &plugin_name,
 ref<Object> PluginManager::create_object(const Properties &props,
                                          const Class *class_) {
     Assert(class_ != nullptr);
-    if (class_->name() == "Scene")
+    if (class_->name() == "Scene") {
+       load_stats::ScopedLoadTimer lt("Plugin instantiation",
+                                      props.plugin_name());
        return class_->construct(props);
+    }
 
     std::string variant = class_->variant();
 
@@ -186,6 +222,7 @@ ref<Object> PluginManager::create_object(const Properties &props,
      * This is important when plugins are created in parallel. */
 
     Assert(plugin_class != nullptr);
+    load_stats::ScopedLoadTimer lt("Plugin instantiation", props.plugin_name());
     ref<Object> object = plugin_class->construct(props);
 
 #if defined(MI_ENABLE_LLVM) || defined(MI_ENABLE_CUDA)
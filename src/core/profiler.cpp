@@ -1,6 +1,13 @@
 #include <mitsuba/core/profiler.h>
+#include <mitsuba/core/fstream.h>
 #include <mitsuba/core/logger.h>
+#include <mitsuba/core/thread.h>
 #include <mitsuba/core/util.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -10,6 +17,148 @@ __itt_string_handle *
     mitsuba_itt_phase[int(ProfilerPhase::ProfilerPhaseCount)] { };
 #endif
 
+bool profiler_trace_enabled = false;
+
+/// A completed phase interval (timestamps in nanoseconds, see \ref profiler_timestamp())
+struct TraceEvent {
+    uint64_t start;
+    uint64_t end;
+    ProfilerPhase phase;
+};
+
+/* Timeline events of one thread. Only the owning thread appends, hence no
+   synchronization is needed on the hot path; the buffer wraps around once
+   full so that the most recent events are retained. */
+struct alignas(64) TraceBuffer {
+    /// 2^18 events (6 MiB) per thread -- several seconds of dense phases
+    static constexpr uint64_t Size = 1 << 18;
+
+    std::unique_ptr<TraceEvent[]> events { new TraceEvent[Size] };
+
+    /// Total number of events ever appended (monotonically increasing)
+    std::atomic<uint64_t> count { 0 };
+
+    std::string thread_name;
+};
+
+/* Buffers are registered once per thread and intentionally kept alive in the
+   registry afterwards -- serialization may run after a worker has exited */
+static std::mutex trace_mutex;
+static std::vector<std::unique_ptr<TraceBuffer>> trace_registry;
+static thread_local TraceBuffer *tl_trace_buffer = nullptr;
+
+static TraceBuffer *trace_buffer() {
+    TraceBuffer *result = tl_trace_buffer;
+    if (unlikely(!result)) {
+        auto b = std::make_unique<TraceBuffer>();
+        result = b.get();
+        Thread *thread = Thread::thread();
+        result->thread_name = thread ? thread->name() : "unregistered";
+        std::lock_guard<std::mutex> guard(trace_mutex);
+        trace_registry.push_back(std::move(b));
+        tl_trace_buffer = result;
+    }
+    return result;
+}
+
+uint64_t profiler_timestamp() {
+    using namespace std::chrono;
+    static const steady_clock::time_point epoch = steady_clock::now();
+    return (uint64_t) duration_cast<nanoseconds>(steady_clock::now() - epoch)
+        .count();
+}
+
+void profiler_record_interval(ProfilerPhase phase, uint64_t start,
+                              uint64_t end) {
+    TraceBuffer *buf = trace_buffer();
+    uint64_t count = buf->count.load(std::memory_order_relaxed);
+    buf->events[count % TraceBuffer::Size] = { start, end, phase };
+    /* Publish with release ordering so that a concurrent serialization
+       observes fully written events */
+    buf->count.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::set_trace_enabled(bool value) {
+    /* Pin the clock epoch before the first event so that timestamps
+       are small positive offsets */
+    profiler_timestamp();
+    profiler_trace_enabled = value;
+}
+
+bool Profiler::trace_enabled() { return profiler_trace_enabled; }
+
+void Profiler::clear_trace() {
+    std::lock_guard<std::mutex> guard(trace_mutex);
+    for (auto &buf : trace_registry)
+        buf->count.store(0, std::memory_order_relaxed);
+}
+
+std::string Profiler::trace_json() {
+    /* Serialization is expected to run at a quiescent point (e.g. after
+       rendering). It tolerates threads that are still recording: events are
+       published with release ordering, though slots recycled by a concurrent
+       ring buffer wrap-around may be read in a torn state. */
+    std::lock_guard<std::mutex> guard(trace_mutex);
+
+    // chrome://tracing expects microseconds; emit ns ticks as 'us.nnn'
+    auto put_time = [](std::ostringstream &oss, uint64_t ns) {
+        oss << ns / 1000 << '.';
+        oss.fill('0');
+        oss.width(3);
+        oss << ns % 1000;
+    };
+
+    std::ostringstream oss;
+    oss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    uint64_t dropped = 0;
+    bool first = true;
+    uint32_t tid = 0;
+    for (auto &buf : trace_registry) {
+        if (!first)
+            oss << ',';
+        first = false;
+
+        oss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+            << tid << ",\"args\":{\"name\":\"" << buf->thread_name << "\"}}";
+
+        uint64_t count = buf->count.load(std::memory_order_acquire),
+                 n     = std::min(count, TraceBuffer::Size);
+        dropped += count - n;
+
+        for (uint64_t i = count - n; i != count; ++i) {
+            const TraceEvent &ev = buf->events[i % TraceBuffer::Size];
+            oss << ",{\"name\":\"" << profiler_phase_id[(int) ev.phase]
+                << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid << ",\"ts\":";
+            put_time(oss, ev.start);
+            oss << ",\"dur\":";
+            put_time(oss, ev.end - ev.start);
+            oss << '}';
+        }
+
+        tid++;
+    }
+
+    oss << "]}";
+
+    if (dropped > 0)
+        Log(Warn, "Profiler::trace_json(): the ring buffer of one or more "
+                  "threads overflowed, the oldest %llu event(s) were dropped.",
+            (unsigned long long) dropped);
+
+    return oss.str();
+}
+
+void Profiler::write_trace(const fs::path &filename) {
+    std::string json = trace_json();
+    ref<FileStream> stream =
+        new FileStream(filename, FileStream::ETruncReadWrite);
+    stream->write(json.data(), json.size());
+    stream->close();
+    Log(Info, "Wrote timeline trace (%s) to \"%s\".",
+        util::mem_string(json.size()), filename);
+}
+
 void Profiler::static_initialization() {
 #if defined(MI_ENABLE_ITTNOTIFY)
     mitsuba_itt_domain = __itt_domain_create("mitsuba");
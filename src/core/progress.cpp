@@ -1,6 +1,7 @@
 #include <drjit/math.h>
 #include <mitsuba/core/progress.h>
 #include <mitsuba/core/logger.h>
+#include <chrono>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -25,9 +26,59 @@ ProgressReporter::ProgressReporter(const std::string &label, void *payload)
     m_last_progress = -1.f;
 }
 
-ProgressReporter::~ProgressReporter() { }
+ProgressReporter::~ProgressReporter() {
+    finish();
+}
 
 void ProgressReporter::update(float progress) {
+    refresh(progress, Thread::thread()->logger());
+}
+
+void ProgressReporter::start_async(size_t total_work, size_t interval_ms) {
+    finish();
+
+    m_total_work = total_work;
+    m_work_done.store(0, std::memory_order_relaxed);
+    m_stop = false;
+
+    /* The refresh thread performs all formatting and I/O so that worker
+       threads only pay for a relaxed atomic addition per work unit. The
+       logger is captured here since the refresh thread is not registered
+       with the Thread machinery. */
+    Logger *logger = Thread::thread()->logger();
+
+    m_refresh_thread = std::thread([this, logger, interval_ms]() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cond.wait_for(lock, std::chrono::milliseconds(interval_ms),
+                            [this] { return m_stop; });
+
+            size_t done = m_work_done.load(std::memory_order_relaxed);
+            refresh(m_total_work > 0 ? done / (float) m_total_work : 1.f,
+                    logger);
+
+            if (m_stop)
+                break;
+        }
+    });
+}
+
+void ProgressReporter::finish() {
+    if (!m_refresh_thread.joinable())
+        return;
+
+    /* locked */ {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    m_refresh_thread.join();
+}
+
+void ProgressReporter::refresh(float progress, Logger *logger) {
+    if (!logger)
+        return;
+
     progress = dr::minimum(dr::maximum(progress, 0.f), 1.f);
 
     if (progress == m_last_progress)
@@ -52,8 +103,7 @@ void ProgressReporter::update(float progress) {
         memcpy((char *) m_line.data() + eta_pos, eta.data(), eta.length());
     }
 
-    Thread::thread()->logger()->log_progress(progress, m_label, m_line,
-                                             eta, m_payload);
+    logger->log_progress(progress, m_label, m_line, eta, m_payload);
     m_last_update = elapsed;
 }
 
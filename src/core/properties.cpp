@@ -1,14 +1,16 @@
 #if defined(_MSC_VER)
-#  pragma warning (disable: 4324) // warning C4324: 'std::pair<const std::string,mitsuba::Entry>': structure was padded due to alignment specifier
+#  pragma warning (disable: 4324) // warning C4324: 'mitsuba::Entry': structure was padded due to alignment specifier
 #  define _ENABLE_EXTENDED_ALIGNED_STORAGE
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
-#include <map>
 #include <sstream>
 #include <cstring>
+#include <vector>
 
+#include <mitsuba/core/hash.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/transform.h>
@@ -36,7 +38,9 @@ using VariantType = variant<
 
 struct alignas(32) Entry {
     VariantType data;
-    bool queried;
+    std::string name;
+    size_t hash = 0;
+    bool queried = false;
 };
 
 struct SortKey {
@@ -64,109 +68,144 @@ struct SortKey {
     }
 };
 
+/* The property table is a flat vector kept in \ref SortKey order (matching
+   the iteration order of the std::map that it replaces). Plugin constructors
+   query a few dozen keys at most, hence a linear scan that rejects mismatches
+   via a precomputed string hash beats a node-based map both in lookup time
+   and in allocation churn. */
 struct Properties::PropertiesPrivate {
-    std::map<std::string, Entry, SortKey> entries;
+    std::vector<Entry> entries;
     std::string id, plugin_name;
-};
 
-using Iterator = typename std::map<std::string, Entry, SortKey>::iterator;
+    Entry *find(const std::string &name) {
+        size_t hash = mitsuba::hash(name);
+        for (Entry &e : entries) {
+            if (e.hash == hash && e.name == name)
+                return &e;
+        }
+        return nullptr;
+    }
+
+    const Entry *find(const std::string &name) const {
+        return const_cast<PropertiesPrivate *>(this)->find(name);
+    }
+
+    /// Return the entry with the given name, inserting it if needed
+    Entry &insert(const std::string &name) {
+        Entry *entry = find(name);
+        if (entry)
+            return *entry;
+
+        auto it = std::lower_bound(
+            entries.begin(), entries.end(), name,
+            [](const Entry &e, const std::string &n) {
+                return SortKey()(e.name, n);
+            });
+
+        it = entries.insert(it, Entry());
+        it->name = name;
+        it->hash = mitsuba::hash(name);
+        return *it;
+    }
+};
 
 template <typename T, typename T2 = T>
-T get_impl(const Iterator &it) {
-    if (!it->second.data.template is<T>() && !it->second.data.template is<T2>())
+T get_impl(Entry *entry) {
+    if (!entry->data.template is<T>() && !entry->data.template is<T2>())
         Throw("The property \"%s\" has the wrong type (expected <%s> or <%s>, is <%s>)",
-              it->first, typeid(T).name(), typeid(T2).name(), it->second.data.type().name());
-    it->second.queried = true;
-    if (it->second.data.template is<T2>())
-        return (T const &) (T2 const &) it->second.data;
-    return (T const &) it->second.data;
+              entry->name, typeid(T).name(), typeid(T2).name(), entry->data.type().name());
+    entry->queried = true;
+    if (entry->data.template is<T2>())
+        return (T const &) (T2 const &) entry->data;
+    return (T const &) entry->data;
 }
 
 template <typename T>
-T get_routing(const Iterator &it) {
+T get_routing(Entry *entry) {
     if constexpr (dr::is_static_array_v<T>) {
         Assert(T::Size == 3);
         if constexpr (std::is_same_v<T, Color<float, 3>> ||
                       std::is_same_v<T, Color<double, 3>>)
-            return (T) get_impl<Color3f, Array3f>(it);
+            return (T) get_impl<Color3f, Array3f>(entry);
         else
-            return (T) get_impl<Array3f>(it);
+            return (T) get_impl<Array3f>(entry);
     }
 
     if constexpr (std::is_same_v<T, Transform<Point<float, 4>>> ||
                   std::is_same_v<T, Transform<Point<double, 4>>>)
-        return (T) get_impl<Transform4f>(it);
+        return (T) get_impl<Transform4f>(entry);
 
     if constexpr (std::is_floating_point_v<T>)
-        return (T) get_impl<Float, int64_t>(it);
+        return (T) get_impl<Float, int64_t>(entry);
 
     if constexpr (std::is_same_v<T, ref<Object>>)
-        return get_impl<ref<Object>>(it);
+        return get_impl<ref<Object>>(entry);
 
     if constexpr (std::is_same_v<T, bool>)
-        return get_impl<T>(it);
+        return get_impl<T>(entry);
 
     if constexpr (std::is_integral_v<T> && !std::is_pointer_v<T>) {
-        int64_t v = get_impl<int64_t>(it);
+        int64_t v = get_impl<int64_t>(entry);
         if constexpr (std::is_unsigned_v<T>) {
             if (v < 0) {
                 Throw("Property \"%s\" has negative value %i, but was queried as a"
-                    " size_t (unsigned).", it->first, v);
+                    " size_t (unsigned).", entry->name, v);
             }
         }
         return (T) v;
     }
 
     if constexpr (std::is_same_v<T, std::string>)
-        return get_impl<T>(it);
+        return get_impl<T>(entry);
 
     Throw("Unsupported type: <%s>.", typeid(T).name());
 }
 
 template <typename T>
 T Properties::get(const std::string &name) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    Entry *entry = d->find(name);
+    if (!entry)
         Throw("Property \"%s\" has not been specified!", name);
-    return get_routing<T>(it);
+    return get_routing<T>(entry);
 }
 
 template <typename T>
 T Properties::get(const std::string &name, const T &def_val) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    Entry *entry = d->find(name);
+    if (!entry)
         return def_val;
-    return get_routing<T>(it);
+    return get_routing<T>(entry);
 }
 #define DEFINE_PROPERTY_SETTER(Type, SetterName) \
     void Properties::SetterName(const std::string &name, Type const &value, bool error_duplicates) { \
         if (has_property(name) && error_duplicates) \
             Log(Error, "Property \"%s\" was specified multiple times!", name); \
-        d->entries[name].data = (Type) value; \
-        d->entries[name].queried = false; \
+        Entry &entry = d->insert(name); \
+        entry.data = (Type) value; \
+        entry.queried = false; \
     }
 
 #define DEFINE_PROPERTY_ACCESSOR(Type, TagName, SetterName, GetterName) \
     DEFINE_PROPERTY_SETTER(Type, SetterName) \
     \
     Type const & Properties::GetterName(const std::string &name) const { \
-        const auto it = d->entries.find(name); \
-        if (it == d->entries.end()) \
+        Entry *entry = d->find(name); \
+        if (!entry) \
             Throw("Property \"%s\" has not been specified!", name); \
-        if (!it->second.data.is<Type>()) \
+        if (!entry->data.is<Type>()) \
             Throw("The property \"%s\" has the wrong type (expected <" #TagName ">).", name); \
-        it->second.queried = true; \
-        return (Type const &) it->second.data; \
+        entry->queried = true; \
+        return (Type const &) entry->data; \
     } \
     \
     Type const & Properties::GetterName(const std::string &name, Type const &def_val) const { \
-        const auto it = d->entries.find(name); \
-        if (it == d->entries.end()) \
+        Entry *entry = d->find(name); \
+        if (!entry) \
             return def_val; \
-        if (!it->second.data.is<Type>()) \
+        if (!entry->data.is<Type>()) \
             Throw("The property \"%s\" has the wrong type (expected <" #TagName ">).", name); \
-        it->second.queried = true; \
-        return (Type const &) it->second.data; \
+        entry->queried = true; \
+        return (Type const &) entry->data; \
     }
 
 DEFINE_PROPERTY_SETTER(bool,         set_bool)
@@ -198,7 +237,7 @@ void Properties::operator=(const Properties &props) {
 }
 
 bool Properties::has_property(const std::string &name) const {
-    return d->entries.find(name) != d->entries.end();
+    return d->find(name) != nullptr;
 }
 
 namespace {
@@ -235,34 +274,37 @@ namespace {
 }
 
 Properties::Type Properties::type(const std::string &name) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    const Entry *entry = d->find(name);
+    if (!entry)
         Throw("type(): Could not find property named \"%s\"!", name);
 
-    return it->second.data.visit(PropertyTypeVisitor());
+    return entry->data.visit(PropertyTypeVisitor());
 }
 
 bool Properties::mark_queried(const std::string &name) const {
-    auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    Entry *entry = d->find(name);
+    if (!entry)
         return false;
-    it->second.queried = true;
+    entry->queried = true;
     return true;
 }
 
 bool Properties::was_queried(const std::string &name) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    const Entry *entry = d->find(name);
+    if (!entry)
         Throw("Could not find property named \"%s\"!", name);
-    return it->second.queried;
+    return entry->queried;
 }
 
 bool Properties::remove_property(const std::string &name) {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
-        return false;
-    d->entries.erase(it);
-    return true;
+    size_t hash = mitsuba::hash(name);
+    for (auto it = d->entries.begin(); it != d->entries.end(); ++it) {
+        if (it->hash == hash && it->name == name) {
+            d->entries.erase(it);
+            return true;
+        }
+    }
+    return false;
 }
 
 const std::string &Properties::plugin_name() const {
@@ -284,16 +326,19 @@ void Properties::set_id(const std::string &id) {
 void Properties::copy_attribute(const Properties &properties,
                                 const std::string &source_name,
                                 const std::string &target_name) {
-    const auto it = properties.d->entries.find(source_name);
-    if (it == properties.d->entries.end())
+    const Entry *source = properties.d->find(source_name);
+    if (!source)
         Throw("copy_attribute(): Could not find parameter \"%s\"!", source_name);
-    d->entries[target_name] = it->second;
+    Entry &target = d->insert(target_name);
+    target.data = source->data;
+    target.queried = source->queried;
 }
 
 std::vector<std::string> Properties::property_names() const {
     std::vector<std::string> result;
+    result.reserve(d->entries.size());
     for (const auto &e : d->entries)
-        result.push_back(e.first);
+        result.push_back(e.name);
     return result;
 }
 
@@ -301,12 +346,12 @@ std::vector<std::pair<std::string, NamedReference>> Properties::named_references
     std::vector<std::pair<std::string, NamedReference>> result;
     result.reserve(d->entries.size());
     for (auto &e : d->entries) {
-        auto type = e.second.data.visit(PropertyTypeVisitor());
+        auto type = e.data.visit(PropertyTypeVisitor());
         if (type != Type::NamedReference)
             continue;
-        auto const &value = (const NamedReference &) e.second.data;
-        result.push_back(std::make_pair(e.first, value));
-        e.second.queried = true;
+        auto const &value = (const NamedReference &) e.data;
+        result.push_back(std::make_pair(e.name, value));
+        e.queried = true;
     }
     return result;
 }
@@ -315,12 +360,12 @@ std::vector<std::pair<std::string, ref<Object>>> Properties::objects(bool mark_q
     std::vector<std::pair<std::string, ref<Object>>> result;
     result.reserve(d->entries.size());
     for (auto &e : d->entries) {
-        auto type = e.second.data.visit(PropertyTypeVisitor());
+        auto type = e.data.visit(PropertyTypeVisitor());
         if (type != Type::Object)
             continue;
-        result.push_back(std::make_pair(e.first, (const ref<Object> &) e.second));
+        result.push_back(std::make_pair(e.name, (const ref<Object> &) e.data));
         if (mark_queried)
-            e.second.queried = true;
+            e.queried = true;
     }
     return result;
 }
@@ -328,15 +373,18 @@ std::vector<std::pair<std::string, ref<Object>>> Properties::objects(bool mark_q
 std::vector<std::string> Properties::unqueried() const {
     std::vector<std::string> result;
     for (const auto &e : d->entries) {
-        if (!e.second.queried)
-            result.push_back(e.first);
+        if (!e.queried)
+            result.push_back(e.name);
     }
     return result;
 }
 
 void Properties::merge(const Properties &p) {
-    for (const auto &e : p.d->entries)
-        d->entries[e.first] = e.second;
+    for (const auto &e : p.d->entries) {
+        Entry &target = d->insert(e.name);
+        target.data = e.data;
+        target.queried = e.queried;
+    }
 }
 
 bool Properties::operator==(const Properties &p) const {
@@ -346,10 +394,10 @@ bool Properties::operator==(const Properties &p) const {
         return false;
 
     for (const auto &e : d->entries) {
-        auto it = p.d->entries.find(e.first);
-        if (it == p.d->entries.end())
+        const Entry *other = p.d->find(e.name);
+        if (!other)
             return false;
-        if (e.second.data != it->second.data)
+        if (e.data != other->data)
             return false;
     }
 
@@ -357,32 +405,20 @@ bool Properties::operator==(const Properties &p) const {
 }
 
 std::string Properties::as_string(const std::string &name) const {
+    const Entry *entry = d->find(name);
+    if (!entry)
+        Throw("Property \"%s\" has not been specified!", name);
     std::ostringstream oss;
-    bool found = false;
-    for (auto &e : d->entries) {
-        if (e.first != name)
-            continue;
-        e.second.data.visit(StreamVisitor(oss));
-        found = true;
-        break;
-    }
-    if (!found)
-        Throw("Property \"%s\" has not been specified!", name); \
+    entry->data.visit(StreamVisitor(oss));
     return oss.str();
 }
 
 std::string Properties::as_string(const std::string &name, const std::string &def_val) const {
-    std::ostringstream oss;
-    bool found = false;
-    for (auto &e : d->entries) {
-        if (e.first != name)
-            continue;
-        e.second.data.visit(StreamVisitor(oss));
-        found = true;
-        break;
-    }
-    if (!found)
+    const Entry *entry = d->find(name);
+    if (!entry)
         return def_val;
+    std::ostringstream oss;
+    entry->data.visit(StreamVisitor(oss));
     return oss.str();
 }
 
@@ -394,8 +430,8 @@ std::ostream &operator<<(std::ostream &os, const Properties &p) {
        << "  id = \"" << p.d->id << "\"," << std::endl
        << "  elements = {" << std::endl;
     while (it != p.d->entries.end()) {
-        os << "    \"" << it->first << "\" -> ";
-        it->second.data.visit(StreamVisitor(os));
+        os << "    \"" << it->name << "\" -> ";
+        it->data.visit(StreamVisitor(os));
         if (++it != p.d->entries.end()) os << ",";
         os << std::endl;
     }
@@ -413,16 +449,18 @@ std::ostream &operator<<(std::ostream &os, const Properties &p) {
 void Properties::set_float(const std::string &name, const Float &value, bool error_duplicates) {
     if (has_property(name) && error_duplicates)
         Log(Error, "Property \"%s\" was specified multiple times!", name);
-    d->entries[name].data = (Float) value;
-    d->entries[name].queried = false;
+    Entry &entry = d->insert(name);
+    entry.data = (Float) value;
+    entry.queried = false;
 }
 
 /// Array3f setter
 void Properties::set_array3f(const std::string &name, const Array3f &value, bool error_duplicates) {
     if (has_property(name) && error_duplicates)
         Log(Error, "Property \"%s\" was specified multiple times!", name);
-    d->entries[name].data = (Array3f) value;
-    d->entries[name].queried = false;
+    Entry &entry = d->insert(name);
+    entry.data = (Array3f) value;
+    entry.queried = false;
 }
 
 #if 0
@@ -432,8 +470,9 @@ void Properties::set_animated_transform(const std::string &name,
                                         bool error_duplicates) {
     if (has_property(name) && error_duplicates)
         Log(Error, "Property \"%s\" was specified multiple times!", name);
-    d->entries[name].data = ref<Object>(value.get());
-    d->entries[name].queried = false;
+    Entry &entry = d->insert(name);
+    entry.data = ref<Object>(value.get());
+    entry.queried = false;
 }
 
 /// AnimatedTransform setter (from a simple Transform).
@@ -446,50 +485,50 @@ void Properties::set_animated_transform(const std::string &name,
 
 /// AnimatedTransform getter (without default value).
 ref<AnimatedTransform> Properties::animated_transform(const std::string &name) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    Entry *entry = d->find(name);
+    if (!entry)
         Throw("Property \"%s\" has not been specified!", name);
-    if (it->second.data.is<Transform4f>()) {
+    if (entry->data.is<Transform4f>()) {
         // Also accept simple transforms, from which we can build
         // an AnimatedTransform.
-        it->second.queried = true;
+        entry->queried = true;
         return new AnimatedTransform(
-            static_cast<const Transform4f &>(it->second.data));
+            static_cast<const Transform4f &>(entry->data));
     }
-    if (!it->second.data.is<ref<Object>>()) {
+    if (!entry->data.is<ref<Object>>()) {
         Throw("The property \"%s\" has the wrong type (expected "
               " <animated_transform> or <transform>).", name);
     }
-    ref<Object> o = it->second.data;
+    ref<Object> o = entry->data;
     if (!o->class_()->derives_from(MI_CLASS(AnimatedTransform)))
         Throw("The property \"%s\" has the wrong type (expected "
               " <animated_transform> or <transform>).", name);
-    it->second.queried = true;
+    entry->queried = true;
     return (AnimatedTransform *) o.get();
 }
 
 /// AnimatedTransform getter (with default value).
 ref<AnimatedTransform> Properties::animated_transform(
         const std::string &name, ref<AnimatedTransform> def_val) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    Entry *entry = d->find(name);
+    if (!entry)
         return def_val;
-    if (it->second.data.is<Transform4f>()) {
+    if (entry->data.is<Transform4f>()) {
         // Also accept simple transforms, from which we can build
         // an AnimatedTransform.
-        it->second.queried = true;
+        entry->queried = true;
         return new AnimatedTransform(
-            static_cast<const Transform4f &>(it->second.data));
+            static_cast<const Transform4f &>(entry->data));
     }
-    if (!it->second.data.is<ref<Object>>()) {
+    if (!entry->data.is<ref<Object>>()) {
         Throw("The property \"%s\" has the wrong type (expected "
               " <animated_transform> or <transform>).", name);
     }
-    ref<Object> o = it->second.data;
+    ref<Object> o = entry->data;
     if (!o->class_()->derives_from(MI_CLASS(AnimatedTransform)))
         Throw("The property \"%s\" has the wrong type (expected "
               " <animated_transform> or <transform>).", name);
-    it->second.queried = true;
+    entry->queried = true;
     return (AnimatedTransform *) o.get();
 }
 
@@ -501,14 +540,14 @@ ref<AnimatedTransform> Properties::animated_transform(
 #endif
 
 ref<Object> Properties::find_object(const std::string &name) const {
-    const auto it = d->entries.find(name);
-    if (it == d->entries.end())
+    const Entry *entry = d->find(name);
+    if (!entry)
         return ref<Object>();
 
-    if (!it->second.data.is<ref<Object>>())
+    if (!entry->data.is<ref<Object>>())
         Throw("The property \"%s\" has the wrong type.", name);
 
-    return it->second.data;
+    return entry->data;
 }
 
 #define EXPORT_PROPERTY_ACCESSOR(T) \
@@ -165,6 +165,9 @@ MI_PY_EXPORT(Bitmap) {
             "path"_a, "format"_a = Bitmap::FileFormat::Auto, "quality"_a = -1,
             D(Bitmap, write_async))
         .def("split", &Bitmap::split, D(Bitmap, split))
+        .def_static("load_shared", &Bitmap::load_shared,
+            "path"_a, "format"_a = Bitmap::FileFormat::Auto,
+            D(Bitmap, load_shared), py::call_guard<py::gil_scoped_release>())
         .def_static("detect_file_format", &Bitmap::detect_file_format, D(Bitmap, detect_file_format))
         .def_property_readonly("__array_interface__", [](Bitmap &bitmap) -> py::object {
             if (bitmap.struct_()->size() == 0)
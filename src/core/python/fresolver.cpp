@@ -21,9 +21,12 @@ MI_PY_EXPORT(FileResolver) {
         .def("__setitem__", [](FileResolver &fr, size_t i, const fs::path &value) {
             if (i >= fr.size())
                 throw pybind11::index_error();
+            fr.flush_cache();
             fr[i] = value;
         })
         .def_method(FileResolver, resolve)
+        .def_method(FileResolver, prefetch, "paths"_a)
+        .def_method(FileResolver, flush_cache)
         .def_method(FileResolver, clear)
         .def_method(FileResolver, prepend)
         .def_method(FileResolver, append);
@@ -39,6 +39,8 @@ MI_PY_EXPORT(Logger) {
         .def(py::init<mitsuba::LogLevel>(), D(Logger, Logger))
         .def_method(Logger, log_progress, "progress"_a, "name"_a,
             "formatted"_a, "eta"_a, "ptr"_a = py::none())
+        .def_method(Logger, set_async)
+        .def_method(Logger, flush)
         .def_method(Logger, set_log_level)
         .def_method(Logger, log_level)
         .def_method(Logger, set_error_level)
@@ -20,6 +20,16 @@ MI_PY_EXPORT(MemoryMappedFile) {
         .def("resize", &MemoryMappedFile::resize, D(MemoryMappedFile, resize))
         .def("filename", &MemoryMappedFile::filename, D(MemoryMappedFile, filename))
         .def("can_write", &MemoryMappedFile::can_write, D(MemoryMappedFile, can_write))
+        .def("shared", &MemoryMappedFile::shared, D(MemoryMappedFile, shared))
+        .def_static("create_or_attach_shared",
+            [](const std::string &name, size_t size) {
+                bool created = false;
+                ref<MemoryMappedFile> result =
+                    MemoryMappedFile::create_or_attach_shared(name, size, &created);
+                return std::make_pair(result, created);
+            }, "name"_a, "size"_a, D(MemoryMappedFile, create_or_attach_shared))
+        .def("mark_shared_ready", &MemoryMappedFile::mark_shared_ready, D(MemoryMappedFile, mark_shared_ready))
+        .def_static("unlink_shared", &MemoryMappedFile::unlink_shared, "name"_a, D(MemoryMappedFile, unlink_shared))
         .def_static("create_temporary", &MemoryMappedFile::create_temporary, D(MemoryMappedFile, create_temporary))
         .def_buffer([](MemoryMappedFile &m) -> py::buffer_info {
             return py::buffer_info(
@@ -106,6 +106,7 @@ MI_PY_EXPORT(ZStream) {
     py::enum_<ZStream::EStreamType>(c, "EStreamType", D(ZStream, EStreamType))
         .value("EDeflateStream", ZStream::EDeflateStream, D(ZStream, EStreamType, EDeflateStream))
         .value("EGZipStream", ZStream::EGZipStream, D(ZStream, EStreamType, EGZipStream))
+        .value("EBlockStream", ZStream::EBlockStream, D(ZStream, EStreamType, EBlockStream))
         .export_values();
 
 
@@ -0,0 +1,32 @@
+#include <mitsuba/core/tev.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <mitsuba/python/python.h>
+
+MI_PY_EXPORT(TevClient) {
+    MI_PY_CLASS(TevClient, Object)
+        .def(py::init<const std::string &, uint16_t>(),
+             D(TevClient, TevClient), "hostname"_a = "localhost",
+             "port"_a = 14158)
+        .def("create_image", &TevClient::create_image,
+             D(TevClient, create_image), "name"_a, "width"_a, "height"_a,
+             "channels"_a)
+        .def("update_image",
+             [](TevClient &client, const std::string &name, uint32_t x,
+                uint32_t y, const std::vector<std::string> &channels,
+                py::array_t<float, py::array::c_style | py::array::forcecast> data) {
+                 if (data.ndim() != 3 ||
+                     (size_t) data.shape(2) != channels.size())
+                     throw std::runtime_error(
+                         "update_image(): expected an array of shape (height, "
+                         "width, len(channels))!");
+                 client.update_image(name, x, y, (uint32_t) data.shape(1),
+                                     (uint32_t) data.shape(0), channels,
+                                     data.data());
+             },
+             D(TevClient, update_image), "name"_a, "x"_a, "y"_a, "channels"_a,
+             "data"_a)
+        .def("close_image", &TevClient::close_image,
+             D(TevClient, close_image), "name"_a)
+        .def("connected", &TevClient::connected, D(TevClient, connected));
+}
@@ -101,7 +101,7 @@ MI_PY_EXPORT(Thread) {
        .def_static_method(Thread, wait_for_tasks);
 
     py::class_<ThreadEnvironment>(m, "ThreadEnvironment", D(ThreadEnvironment))
-        .def(py::init<>());
+        .def(py::init<bool>(), "pin_workers"_a = false);
 
     py::class_<PyScopedSetThreadEnvironment>(m, "ScopedSetThreadEnvironment",
                                             D(ScopedSetThreadEnvironment))
@@ -1,3 +1,6 @@
+#include <mitsuba/core/loadtimer.h>
+#include <mitsuba/core/profiler.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/python/python.h>
 
@@ -8,4 +11,51 @@ MI_PY_EXPORT(util) {
         .def_method(util, time_string, "time"_a, "precise"_a = false)
         .def_method(util, mem_string, "size"_a, "precise"_a = false)
         .def_method(util, trap_debugger);
+
+    util.def("load_timings", []() {
+            py::list result;
+            for (const auto &t : load_stats::timings())
+                result.append(py::make_tuple(t.stage, t.name, t.count, t.seconds));
+            return result;
+        },
+        "Return the stage timings recorded during the most recent scene "
+        "load as a list of ``(stage, name, count, seconds)`` tuples");
+
+    util.def("load_timings_report", &load_stats::report,
+             "Return a human-readable breakdown of the most recent scene load");
+
+    util.def("clear_load_timings", &load_stats::clear,
+             "Discard the timings recorded during the most recent scene load");
+
+    util.def("render_statistics", []() {
+            py::dict result;
+            for (const auto &[name, value] : render_stats::counters())
+                result[name.c_str()] = value;
+            return result;
+        },
+        "Return the event counters recorded during the most recent render "
+        "(rays traced, BSDF/emitter samples, ...) as a dict");
+
+    util.def("render_statistics_report", &render_stats::report,
+             "Return a human-readable summary of the most recent render's "
+             "event counters");
+
+    util.def("clear_render_statistics", &render_stats::clear,
+             "Reset the event counters recorded during the most recent render");
+
+    util.def("set_trace_enabled", &Profiler::set_trace_enabled, "value"_a,
+             "Start or stop recording a per-thread timeline of profiler "
+             "phases");
+
+    util.def("trace_enabled", &Profiler::trace_enabled,
+             "Check whether timeline recording is active");
+
+    util.def("clear_trace", &Profiler::clear_trace,
+             "Discard all recorded timeline events");
+
+    util.def("trace_json", &Profiler::trace_json,
+             "Serialize the recorded timeline into chrome://tracing JSON");
+
+    util.def("write_trace", &Profiler::write_trace, "filename"_a,
+             "Write the recorded timeline to a chrome://tracing JSON file");
 }
@@ -0,0 +1,121 @@
+#include <mitsuba/core/statistics.h>
+#include <mitsuba/core/profiler.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+NAMESPACE_BEGIN(mitsuba)
+NAMESPACE_BEGIN(render_stats)
+
+/* Counters of one thread, padded to a cache line so that the render worker
+   threads never contend for the same line */
+struct alignas(64) CounterBlock {
+    std::atomic<uint64_t> values[int(Counter::CounterCount)] = {};
+};
+
+/* Blocks are registered once per thread and intentionally kept alive in the
+   registry afterwards -- aggregation may run after a worker has exited */
+static std::mutex registry_mutex;
+static std::vector<std::unique_ptr<CounterBlock>> registry;
+static thread_local CounterBlock *tl_block = nullptr;
+
+static CounterBlock *block() {
+    CounterBlock *result = tl_block;
+    if (unlikely(!result)) {
+        auto b = std::make_unique<CounterBlock>();
+        result = b.get();
+        std::lock_guard<std::mutex> guard(registry_mutex);
+        registry.push_back(std::move(b));
+        tl_block = result;
+    }
+    return result;
+}
+
+void increment(Counter counter, uint64_t amount) {
+    /* Only the owning thread writes to its block, so a load/store pair with
+       relaxed ordering suffices (cheaper than an atomic read-modify-write) */
+    std::atomic<uint64_t> &v = block()->values[(int) counter];
+    v.store(v.load(std::memory_order_relaxed) + amount,
+            std::memory_order_relaxed);
+}
+
+/// Invoked by MI_MASKED_FUNCTION (see fwd.h) with the lane count of the mask
+void record_phase(int phase, size_t lanes) {
+    switch ((ProfilerPhase) phase) {
+        case ProfilerPhase::BSDFSample:
+            increment(Counter::BSDFSamples, lanes);
+            break;
+        case ProfilerPhase::BSDFEvaluate:
+            increment(Counter::BSDFEvaluations, lanes);
+            break;
+        case ProfilerPhase::PhaseFunctionSample:
+            increment(Counter::PhaseFunctionSamples, lanes);
+            break;
+        case ProfilerPhase::PhaseFunctionEvaluate:
+            increment(Counter::PhaseFunctionEvaluations, lanes);
+            break;
+        default:
+            /* The remaining phases either have no counter or are counted
+               at the call site with a more accurate width (e.g. the ray
+               count in Scene::ray_intersect()) */
+            break;
+    }
+}
+
+void clear() {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    for (auto &block : registry)
+        for (auto &value : block->values)
+            value.store(0, std::memory_order_relaxed);
+}
+
+uint64_t value(Counter counter) {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    uint64_t result = 0;
+    for (auto &block : registry)
+        result += block->values[(int) counter].load(std::memory_order_relaxed);
+    return result;
+}
+
+std::vector<std::pair<std::string, uint64_t>> counters() {
+    std::lock_guard<std::mutex> guard(registry_mutex);
+    std::vector<std::pair<std::string, uint64_t>> result;
+    result.reserve((size_t) Counter::CounterCount);
+    for (int i = 0; i < (int) Counter::CounterCount; ++i) {
+        uint64_t total = 0;
+        for (auto &block : registry)
+            total += block->values[i].load(std::memory_order_relaxed);
+        result.emplace_back(counter_id[i], total);
+    }
+    return result;
+}
+
+std::string report() {
+    // Group the digits of a counter value for readability (e.g. 12,345,678)
+    auto format_count = [](uint64_t value) {
+        std::string digits = std::to_string(value);
+        for (size_t i = digits.length(); i > 3; i -= 3)
+            digits.insert(i - 3, 1, ',');
+        return digits;
+    };
+
+    std::ostringstream oss;
+    oss << "Render statistics:";
+    bool empty = true;
+    for (const auto &[name, value] : counters()) {
+        if (value == 0)
+            continue;
+        empty = false;
+        oss << std::endl << "  " << name << ' ';
+        for (size_t i = 2 + name.length(); i < 32; ++i)
+            oss << '.';
+        oss << ' ' << format_count(value);
+    }
+    if (empty)
+        oss << " no events were recorded";
+    return oss.str();
+}
+
+NAMESPACE_END(render_stats)
+NAMESPACE_END(mitsuba)
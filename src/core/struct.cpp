@@ -4,7 +4,9 @@
 #include <mitsuba/core/stream.h>
 #include <mitsuba/core/hash.h>
 #include <mitsuba/core/jit.h>
+#include <nanothread/nanothread.h>
 #include <drjit/array.h>
+#include <drjit/packet.h>
 #include <drjit/half.h>
 #include <drjit/color.h>
 #include <unordered_map>
@@ -29,6 +31,18 @@ NAMESPACE_BEGIN(detail)
 #  define Float float
 #endif
 
+/* Exact sRGB -> linear lookup table for normalized 8-bit sources. Reading
+   gamma-corrected textures is by far the most common conversion, and a table
+   lookup is both faster and more accurate than the rational polynomial fit
+   that handles wider source types below. */
+static const struct SRGBToLinearLUT {
+    SRGBToLinearLUT() {
+        for (int i = 0; i < 256; ++i)
+            values[i] = (Float) dr::srgb_to_linear(i * (1.0 / 255.0));
+    }
+    Float values[256];
+} srgb_to_linear_lut;
+
 #if MI_STRUCTCONVERTER_USE_JIT == 1
 
 using namespace asmjit;
@@ -711,6 +725,29 @@ public:
         if (it != cache.end())
             return *it;
 
+        if (int_to_float &&
+            input.first.type == Struct::Type::UInt8 &&
+            has_flag(input.first.flags, Struct::Flags::Normalized) && inv_gamma) {
+            /* Normalized 8-bit sRGB source: a single table lookup replaces
+               the int->float conversion, scaling and polynomial gamma
+               evaluation */
+            #if MI_JIT_LOG_ASSEMBLY == 1
+                cc.comment("# sRGB -> linear table lookup");
+            #endif
+
+            x86::Gp table = cc.newIntPtr("srgb_lut");
+            cc.mov(table, imm((void *) srgb_to_linear_lut.values));
+            vr.xmm = cc.newXmm();
+            #if !defined(DOUBLE_PRECISION)
+                movs(vr.xmm, x86::dword_ptr(table, vr.gp.r64(), 2));
+            #else
+                movs(vr.xmm, x86::qword_ptr(table, vr.gp.r64(), 3));
+            #endif
+
+            int_to_float = false;
+            inv_gamma = false;
+        }
+
         if (int_to_float) {
             auto range = Struct::range(input.first.type);
 
@@ -1609,6 +1646,16 @@ bool StructConverter::load(const uint8_t *src, const Struct::Field &f, Value &va
 }
 
 void StructConverter::linearize(Value &value) const {
+    if (value.type == Struct::Type::UInt8 &&
+        has_flag(value.flags, Struct::Flags::Normalized) &&
+        has_flag(value.flags, Struct::Flags::Gamma)) {
+        // Normalized 8-bit sRGB value: exact table lookup
+        value.f = detail::srgb_to_linear_lut.values[value.u];
+        value.flags = value.flags & ~Struct::Flags::Gamma;
+        value.type = struct_type_v<Float>;
+        return;
+    }
+
     if (Struct::is_integer(value.type)) {
         if (Struct::is_unsigned(value.type))
             value.f = (Float) value.u;
@@ -1752,9 +1799,185 @@ void StructConverter::save(uint8_t *dst, const Struct::Field &f, Value value, si
     }
 }
 
+bool StructConverter::convert_fast(size_t count, const uint8_t *src,
+                                   uint8_t *dest) const {
+    using namespace mitsuba::detail;
+
+    if (m_source->byte_order() != Struct::host_byte_order() ||
+        m_target->byte_order() != Struct::host_byte_order())
+        return false;
+
+    size_t n_fields = m_source->field_count();
+    if (n_fields == 0 || n_fields != m_target->field_count())
+        return false;
+
+    const Struct::Field &sf0 = (*m_source)[0], &tf0 = (*m_target)[0];
+
+    /* Only normalization/gamma semantics are expressible as a flat
+       element-wise transformation */
+    uint32_t allowed = Struct::Flags::Normalized | Struct::Flags::Gamma |
+                       Struct::Flags::PremultipliedAlpha;
+    if ((sf0.flags & ~allowed) || (tf0.flags & ~allowed) ||
+        (sf0.flags & +Struct::Flags::PremultipliedAlpha) !=
+        (tf0.flags & +Struct::Flags::PremultipliedAlpha))
+        return false;
+
+    /* All fields must agree in type and flags, correspond one-to-one, and
+       tile both structures without padding */
+    for (size_t i = 0; i < n_fields; ++i) {
+        const Struct::Field &sf = (*m_source)[i], &tf = (*m_target)[i];
+        if (sf.name != tf.name || !tf.blend.empty() ||
+            sf.type != sf0.type || tf.type != tf0.type ||
+            sf.flags != sf0.flags || tf.flags != tf0.flags ||
+            sf.offset != i * sf0.size || tf.offset != i * tf0.size)
+            return false;
+    }
+    if (m_source->size() != n_fields * sf0.size ||
+        m_target->size() != n_fields * tf0.size)
+        return false;
+
+    enum class FlatOp {
+        Copy,          // bit-identical records
+        F32ToF64,
+        F64ToF32,
+        U8ToF32,       // normalized 8-bit -> [0, 1] float
+        U8SRGBToF32,   // normalized gamma-corrected 8-bit -> linear float
+        U16ToF32       // normalized 16-bit -> [0, 1] float
+    };
+
+    uint32_t flag_mask   = Struct::Flags::Normalized | Struct::Flags::Gamma;
+    bool flags_match     = (sf0.flags & flag_mask) == (tf0.flags & flag_mask),
+         plain_f32_dst   = tf0.type == Struct::Type::Float32 &&
+                           (tf0.flags & flag_mask) == 0,
+         norm_src        = (sf0.flags & flag_mask) == +Struct::Flags::Normalized,
+         srgb_src        = (sf0.flags & flag_mask) ==
+                           (Struct::Flags::Normalized | Struct::Flags::Gamma);
+
+    FlatOp op;
+    if (sf0.type == tf0.type && flags_match)
+        op = FlatOp::Copy;
+    else if (sf0.type == Struct::Type::Float32 &&
+             tf0.type == Struct::Type::Float64 && flags_match)
+        op = FlatOp::F32ToF64;
+    else if (sf0.type == Struct::Type::Float64 &&
+             tf0.type == Struct::Type::Float32 && flags_match)
+        op = FlatOp::F64ToF32;
+    else if (sf0.type == Struct::Type::UInt8 && norm_src && plain_f32_dst)
+        op = FlatOp::U8ToF32;
+    else if (sf0.type == Struct::Type::UInt8 && srgb_src && plain_f32_dst)
+        op = FlatOp::U8SRGBToF32;
+    else if (sf0.type == Struct::Type::UInt16 && norm_src && plain_f32_dst)
+        op = FlatOp::U16ToF32;
+    else
+        return false;
+
+    size_t n_elems = count * n_fields;
+    if (n_elems == 0)
+        return true;
+
+    /* Large conversions (e.g. the vertex data of a big mesh) additionally
+       run in parallel over the thread pool */
+    auto run = [n_elems](auto &&kernel) {
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, n_elems, 1024 * 1024),
+            [&](const dr::blocked_range<size_t> &range) {
+                kernel(range.begin(), range.end());
+            });
+    };
+
+    switch (op) {
+        case FlatOp::Copy:
+            memcpy(dest, src, n_elems * sf0.size);
+            break;
+
+        case FlatOp::F32ToF64: {
+                using FloatP  = dr::Packet<float>;
+                using DoubleP = dr::Packet<double, FloatP::Size>;
+                const float *s = (const float *) src;
+                double *d = (double *) dest;
+                run([s, d](size_t i, size_t end) {
+                    for (; i + FloatP::Size <= end; i += FloatP::Size)
+                        dr::store(d + i, DoubleP(dr::load<FloatP>(s + i)));
+                    for (; i < end; ++i)
+                        d[i] = (double) s[i];
+                });
+            }
+            break;
+
+        case FlatOp::F64ToF32: {
+                using DoubleP = dr::Packet<double>;
+                using FloatP  = dr::Packet<float, DoubleP::Size>;
+                const double *s = (const double *) src;
+                float *d = (float *) dest;
+                run([s, d](size_t i, size_t end) {
+                    for (; i + DoubleP::Size <= end; i += DoubleP::Size)
+                        dr::store(d + i, FloatP(dr::load<DoubleP>(s + i)));
+                    for (; i < end; ++i)
+                        d[i] = (float) s[i];
+                });
+            }
+            break;
+
+        case FlatOp::U8ToF32: {
+                using FloatP  = dr::Packet<float>;
+                using UInt32P = dr::Packet<uint32_t, FloatP::Size>;
+                const uint8_t *s = src;
+                float *d = (float *) dest;
+                run([s, d](size_t i, size_t end) {
+                    for (; i + FloatP::Size <= end; i += FloatP::Size) {
+                        UInt32P v;
+                        for (size_t k = 0; k < FloatP::Size; ++k)
+                            v[k] = s[i + k];
+                        dr::store(d + i, FloatP(v) * (1.f / 255.f));
+                    }
+                    for (; i < end; ++i)
+                        d[i] = s[i] * (1.f / 255.f);
+                });
+            }
+            break;
+
+        case FlatOp::U8SRGBToF32: {
+                // Dominated by the table lookup; left as a scalar loop
+                const uint8_t *s = src;
+                float *d = (float *) dest;
+                run([s, d](size_t i, size_t end) {
+                    for (; i < end; ++i)
+                        d[i] = (float) srgb_to_linear_lut.values[s[i]];
+                });
+            }
+            break;
+
+        case FlatOp::U16ToF32: {
+                using FloatP  = dr::Packet<float>;
+                using UInt32P = dr::Packet<uint32_t, FloatP::Size>;
+                const uint16_t *s = (const uint16_t *) src;
+                float *d = (float *) dest;
+                run([s, d](size_t i, size_t end) {
+                    for (; i + FloatP::Size <= end; i += FloatP::Size) {
+                        UInt32P v;
+                        for (size_t k = 0; k < FloatP::Size; ++k)
+                            v[k] = s[i + k];
+                        dr::store(d + i, FloatP(v) * (1.f / 65535.f));
+                    }
+                    for (; i < end; ++i)
+                        d[i] = s[i] * (1.f / 65535.f);
+                });
+            }
+            break;
+    }
+
+    return true;
+}
+
 bool StructConverter::convert_2d(size_t width, size_t height, const void *src_, void *dest_) const {
     using namespace mitsuba::detail;
 
+    /* Bulk path: homogeneous records that correspond one-to-one reduce to a
+       flat element-wise conversion (see \ref convert_fast()) */
+    if (convert_fast(width * height, (const uint8_t *) src_,
+                     (uint8_t *) dest_))
+        return true;
+
     size_t source_size = m_source->size();
     size_t target_size = m_target->size();
     Struct::Field weight_field, alpha_field;
@@ -268,3 +268,46 @@ def test18_irrcont_simple_function(variants_vec_backends_once):
                 0.48734, 0.654313, 0.786607, 0.899653, 1.])
          * d.normalization())
     )
+
+
+def test19_discr_alias(variants_vec_backends_once):
+    # Distributions large enough to use the alias method must still follow
+    # the stored PMF (and never return zero-probability entries)
+    rng = mi.PCG32(initseq=dr.arange(mi.UInt64, 100))
+    density = mi.Float(rng.next_uint32_bounded(100))
+    density[3] = 0
+    density[77] = 0
+
+    x = mi.DiscreteDistribution(density)
+
+    samples = dr.linspace(mi.Float, 0, 1, 100000, endpoint=False)
+    index, rescaled, pmf = x.sample_reuse_pmf(samples)
+
+    hist = dr.zeros(mi.Float, 100)
+    dr.scatter_reduce(dr.ReduceOp.Add, hist, mi.Float(1), index)
+    assert dr.allclose(hist / dr.width(samples),
+                       density * x.normalization(), atol=1e-3)
+
+    assert hist[3] == 0 and hist[77] == 0
+    assert dr.all((rescaled >= 0) & (rescaled <= 1))
+    assert dr.allclose(pmf, x.eval_pmf_normalized(index))
+
+
+def test20_cont_guide_table(variants_vec_backends_once):
+    # Distributions large enough to use the guide table must still invert
+    # the CDF exactly
+    rng = mi.PCG32(initseq=dr.arange(mi.UInt64, 100))
+    density = mi.Float(rng.next_float32()) + 0.01
+
+    d = mi.ContinuousDistribution([100, 200], density)
+    u = dr.linspace(mi.Float, 0, 1, 10000)
+    x, pdf = d.sample_pdf(u)
+    assert dr.allclose(d.eval_cdf_normalized(x), u, atol=1e-4)
+    assert dr.allclose(d.eval_pdf_normalized(x), pdf, rtol=1e-3)
+
+    nodes = dr.linspace(mi.Float, 100, 200, 100) + \
+        0.4 * mi.Float(rng.next_float32())
+    d = mi.IrregularContinuousDistribution(nodes, density)
+    x, pdf = d.sample_pdf(u)
+    assert dr.allclose(d.eval_cdf_normalized(x), u, atol=1e-4)
+    assert dr.allclose(d.eval_pdf_normalized(x), pdf, rtol=1e-3)
@@ -95,3 +95,15 @@ def test09_morton3(variant_scalar_rgb):
     v1 = mi.math.morton_encode3(v0)
     v2 = mi.math.morton_decode3(v1)
     assert dr.all(v0 == v2)
+
+
+def test10_find_interval(variant_scalar_rgb):
+    # Exercises both the power-of-two descent and the generic bisection
+    for size in [2, 3, 5, 9, 16, 17, 33, 65]:
+        values = list(range(size))
+        queries = [-1.0, 0.0, 0.5, 1.5, size / 2, size - 1.5,
+                   size - 1.0, size + 1.0]
+        for x in queries:
+            count = sum(1 for j in range(1, size) if values[j] < x)
+            ref = min(count, size - 2)
+            assert mi.math.find_interval(size, lambda i: values[i] < x) == ref
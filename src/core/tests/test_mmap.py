@@ -64,3 +64,31 @@ def test04_create_temp(variant_scalar_rgb):
     assert mmap.can_write()
     del mmap
     assert not os.path.exists(fname)
+
+
+def test05_shared(variant_scalar_rgb):
+    import uuid
+    name = "mi_test_" + uuid.uuid4().hex[:8]
+    try:
+        mmap, created = mi.MemoryMappedFile.create_or_attach_shared(name, 64)
+        assert created
+        assert mmap.shared()
+        assert mmap.size() == 64
+        assert mmap.can_write()
+        array_view = np.array(mmap, copy=False)
+        array_view[:] = np.arange(64, dtype=np.uint8)
+        mmap.mark_shared_ready()
+
+        other, created = mi.MemoryMappedFile.create_or_attach_shared(name, 64)
+        assert not created
+        assert other.shared()
+        assert other.size() == 64
+        assert not other.can_write()
+        assert np.all(np.array(other, copy=False) == np.arange(64, dtype=np.uint8))
+        del array_view
+        del mmap
+        del other
+    finally:
+        mi.MemoryMappedFile.unlink_shared(name)
+    # Unlinking a nonexistent segment is a no-op
+    mi.MemoryMappedFile.unlink_shared(name)
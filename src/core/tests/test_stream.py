@@ -187,6 +187,28 @@ def test05_read_back_through_zstream(class_, args, request, tmpdir_factory):
             del zstream
 
 
+def test05b_read_back_through_block_zstream():
+    stream = MemoryStream(64)
+
+    # Write in the framed block mode supporting parallel decompression
+    zstream = ZStream(stream, ZStream.EBlockStream)
+    write_contents(zstream)
+
+    # Exceed the block size so that multiple independent blocks are emitted
+    n_strings = 3000
+    for i in range(n_strings):
+        zstream.write_string('block contents %i' % i + 'x' * 500)
+    del zstream
+
+    # Old-style construction detects the block format from its magic number
+    stream.seek(0)
+    zstream = ZStream(stream)
+    check_contents(zstream)
+    for i in range(n_strings):
+        assert zstream.read_string() == 'block contents %i' % i + 'x' * 500
+    del zstream
+
+
 def test06_dummy_stream():
     s = DummyStream()
     assert s.can_write()
@@ -283,3 +305,45 @@ def test08_fstream(rw, tmpfile):
     else:
         with pytest.raises(RuntimeError):
             FileStream(new_name)
+
+
+def test09_fstream_buffered_reads(tmpfile):
+    # Exercise the read-ahead buffer: many small reads, seeks within and
+    # outside the buffered window, and interleaved reads/writes
+    s = FileStream(tmpfile, FileStream.ETruncReadWrite)
+    payload = bytes(range(256)) * 64  # 16 KiB
+    s.write(payload)
+    s.flush()
+    s.seek(0)
+
+    # Small sequential reads crossing refill boundaries
+    pos = 0
+    for n in (1, 3, 7, 64, 1000, 4096):
+        assert bytes(s.read(n)) == payload[pos:pos + n]
+        pos += n
+        assert s.tell() == pos
+
+    # Seek backwards within the buffered window, then re-read
+    s.seek(pos - 100)
+    assert bytes(s.read(100)) == payload[pos - 100:pos]
+
+    # Seek far outside the window
+    s.seek(10)
+    assert bytes(s.read(4)) == payload[10:14]
+    assert s.tell() == 14
+
+    # Writes must invalidate the read-ahead buffer
+    s.seek(0)
+    s.read(16)
+    s.seek(4)
+    s.write(b'\xff\xff')
+    s.seek(0)
+    data = bytes(s.read(8))
+    assert data == payload[:4] + b'\xff\xff' + payload[6:8]
+
+    # Reading past the end raises and reports the number of bytes served
+    s.seek(len(payload) - 4)
+    with pytest.raises(RuntimeError, match='read 4 out of 8 bytes'):
+        s.read(8)
+
+    s.close()
@@ -443,3 +443,38 @@ def test19_alpha_4():
     dst_data = (src_data_float[0], src_data_float[1], src_data[2])
     check_conversion(s, '@BBB', '@BBB',
                      src_data, dst_data)
+
+
+def test20_bulk_float64_to_float32():
+    # Homogeneous multi-field records (the layout produced by PLY
+    # double-valued vertex data) must convert like the generic path
+    n = 4096
+    s1, s2 = Struct(), Struct()
+    for name in ('x', 'y', 'z'):
+        s1.append(name, Struct.Type.Float64)
+        s2.append(name, Struct.Type.Float32)
+    conv = StructConverter(s1, s2)
+
+    values = np.random.RandomState(0).standard_normal(3 * n)
+    src = struct.pack('@%dd' % (3 * n), *values)
+    dst = np.array(struct.unpack('@%df' % (3 * n), conv.convert(src)))
+    assert np.allclose(dst, values, atol=1e-6)
+
+
+def test21_bulk_u8_normalized_and_srgb():
+    raw = np.arange(256, dtype=np.uint8)
+
+    s_f32 = Struct().append('r', Struct.Type.Float32)
+
+    s_u8 = Struct().append('r', Struct.Type.UInt8, Struct.Flags.Normalized)
+    conv = StructConverter(s_u8, s_f32)
+    dst = np.array(struct.unpack('@256f', conv.convert(raw.tobytes())))
+    assert np.allclose(dst, raw / 255.0)
+
+    s_u8g = Struct().append('r', Struct.Type.UInt8,
+                            Struct.Flags.Normalized | Struct.Flags.Gamma)
+    conv = StructConverter(s_u8g, s_f32)
+    dst = np.array(struct.unpack('@256f', conv.convert(raw.tobytes())))
+    x = raw / 255.0
+    ref = np.where(x <= 0.04045, x / 12.92, ((x + 0.055) / 1.055) ** 2.4)
+    assert np.allclose(dst, ref, atol=1e-5)
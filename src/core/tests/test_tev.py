@@ -0,0 +1,85 @@
+import numpy as np
+import socket
+import struct
+import threading
+import pytest
+import mitsuba as mi
+
+
+def _split_packets(buf):
+    """Split a raw byte stream into tev IPC packet payloads"""
+    packets, offset = [], 0
+    while offset < len(buf):
+        (length,) = struct.unpack_from('<I', buf, offset)
+        packets.append(bytes(buf[offset + 4:offset + length]))
+        offset += length
+    return packets
+
+
+def test01_protocol(variant_scalar_rgb):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.bind(('127.0.0.1', 0))
+    server.listen(1)
+    port = server.getsockname()[1]
+
+    received = bytearray()
+
+    def serve():
+        conn, _ = server.accept()
+        while True:
+            chunk = conn.recv(65536)
+            if not chunk:
+                break
+            received.extend(chunk)
+        conn.close()
+
+    thread = threading.Thread(target=serve)
+    thread.start()
+
+    client = mi.TevClient('127.0.0.1', port)
+    assert client.connected()
+
+    client.create_image('img', 2, 1, ['R', 'G', 'B'])
+    data = np.arange(6, dtype=np.float32).reshape(1, 2, 3)
+    client.update_image('img', 0, 0, ['R', 'G', 'B'], data)
+    client.close_image('img')
+
+    # Destruction flushes all pending packets and closes the connection
+    del client
+    thread.join(timeout=10)
+    server.close()
+
+    packets = _split_packets(received)
+    assert [p[0] for p in packets] == [4, 3, 3, 3, 2]
+
+    # CreateImage: grab focus, name, width, height, channel count and names
+    create = packets[0]
+    assert create[1] == 1
+    assert create[2:6] == b'img\x00'
+    assert struct.unpack_from('<iii', create, 6) == (2, 1, 3)
+    assert create[18:] == b'R\x00G\x00B\x00'
+
+    # UpdateImage: one packet per channel with de-interleaved scanlines
+    for i, (channel, values) in enumerate([(b'R', [0, 3]),
+                                           (b'G', [1, 4]),
+                                           (b'B', [2, 5])]):
+        update = packets[1 + i]
+        assert update[1] == 0
+        assert update[2:6] == b'img\x00'
+        assert update[6:8] == channel + b'\x00'
+        assert struct.unpack_from('<iiii', update, 8) == (0, 0, 2, 1)
+        assert list(struct.unpack_from('<2f', update, 24)) == values
+
+    # CloseImage carries only the name
+    assert packets[4][1:] == b'img\x00'
+
+
+def test02_connection_refused(variant_scalar_rgb):
+    # Reserve a port and close it again so that nobody is listening
+    probe = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    probe.bind(('127.0.0.1', 0))
+    port = probe.getsockname()[1]
+    probe.close()
+
+    with pytest.raises(RuntimeError, match='unable to connect'):
+        mi.TevClient('127.0.0.1', port)
@@ -425,3 +425,107 @@ def test31_python_plugins_parallel(variants_vec_backends_once_rgb):
         <bsdf type='dummy'/>
     </scene>
     """, parallel=True)
+
+
+def test32_load_timings(variant_scalar_rgb):
+    mi.load_string("""<scene version="3.0.0">
+                          <shape type="sphere"/>
+                          <bsdf type="diffuse"/>
+                      </scene>""")
+
+    timings = mi.util.load_timings()
+    stages = set(t[0] for t in timings)
+    assert 'Parsing' in stages
+    assert 'Plugin instantiation' in stages
+    assert 'Acceleration structure build' in stages
+
+    classes = set(t[1] for t in timings if t[0] == 'Plugin instantiation')
+    assert {'sphere', 'diffuse', 'scene'}.issubset(classes)
+    for _, _, count, seconds in timings:
+        assert count >= 1 and seconds >= 0
+
+    assert 'Plugin instantiation' in mi.util.load_timings_report()
+
+    mi.util.clear_load_timings()
+    assert len(mi.util.load_timings()) == 0
+
+
+def test33_include_cache(variant_scalar_rgb, tmp_path):
+    lib = tmp_path / "matlib.xml"
+    lib.write_text("""<scene version="3.0.0">
+                          <bsdf type="conductor" id="shared_metal"/>
+                          <bsdf type="dielectric" id="shared_glass"/>
+                      </scene>""")
+
+    scene_xml = """<scene version="3.0.0">
+                       <include filename="%s" cache="true"/>
+                       <shape type="sphere">
+                           <ref id="%%s"/>
+                       </shape>
+                   </scene>""" % lib
+
+    mi.load_string(scene_xml % 'shared_metal')
+    instantiated = set(t[1] for t in mi.util.load_timings()
+                       if t[0] == 'Plugin instantiation')
+    assert 'conductor' in instantiated
+
+    # The second load grafts the cached subgraph instead of re-instantiating
+    # it -- including objects the first scene never referenced
+    scene = mi.load_string(scene_xml % 'shared_glass')
+    assert scene is not None
+    instantiated = set(t[1] for t in mi.util.load_timings()
+                       if t[0] == 'Plugin instantiation')
+    assert 'conductor' not in instantiated and 'dielectric' not in instantiated
+
+    # Modifying the included file invalidates the cache
+    lib.write_text(lib.read_text().replace('conductor', 'roughconductor'))
+    mi.load_string(scene_xml % 'shared_metal')
+    instantiated = set(t[1] for t in mi.util.load_timings()
+                       if t[0] == 'Plugin instantiation')
+    assert 'roughconductor' in instantiated
+
+    # An in-place edit that preserves the file size is caught via the
+    # modification time ('shared_glass' and 'shared_glas2' have equal length)
+    import os
+    lib.write_text(lib.read_text().replace('shared_glass', 'shared_glas2'))
+    st = os.stat(lib)
+    os.utime(lib, (st.st_atime, st.st_mtime + 1))  # Coarse mtime granularity
+    mi.load_string(scene_xml % 'shared_glas2')
+    instantiated = set(t[1] for t in mi.util.load_timings()
+                       if t[0] == 'Plugin instantiation')
+    assert 'dielectric' in instantiated
+
+
+def test34_dedup(variant_scalar_rgb):
+    scene = mi.load_string("""<scene version="3.0.0">
+        <shape type="sphere">
+            <bsdf type="diffuse">
+                <rgb name="reflectance" value="0.5, 0.5, 0.5"/>
+            </bsdf>
+        </shape>
+        <shape type="sphere">
+            <bsdf type="diffuse">
+                <rgb name="reflectance" value="0.5, 0.5, 0.5"/>
+            </bsdf>
+        </shape>
+        <shape type="sphere">
+            <bsdf type="diffuse">
+                <rgb name="reflectance" value="0.7, 0.5, 0.5"/>
+            </bsdf>
+        </shape>
+        <shape type="sphere">
+            <bsdf type="diffuse">
+                <boolean name="dedup" value="false"/>
+                <rgb name="reflectance" value="0.5, 0.5, 0.5"/>
+            </bsdf>
+        </shape>
+    </scene>""")
+
+    shapes = scene.shapes()
+
+    # Identical definitions collapse onto a single shared instance ..
+    assert shapes[0].bsdf() is shapes[1].bsdf()
+
+    # .. while differing parameters or an explicit opt-out keep them distinct
+    assert shapes[0].bsdf() is not shapes[2].bsdf()
+    assert shapes[0].bsdf() is not shapes[3].bsdf()
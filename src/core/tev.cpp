@@ -0,0 +1,272 @@
+#include <mitsuba/core/tev.h>
+#include <mitsuba/core/logger.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <netdb.h>
+#  include <sys/socket.h>
+#  include <unistd.h>
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+
+#if defined(_WIN32)
+using socket_t = SOCKET;
+#  define MI_INVALID_SOCKET INVALID_SOCKET
+#else
+using socket_t = int;
+#  define MI_INVALID_SOCKET (-1)
+#endif
+
+namespace {
+
+/// Packet identifiers of the tev IPC protocol
+enum class TevPacket : uint8_t {
+    CloseImage  = 2,
+    UpdateImage = 3,
+    CreateImage = 4
+};
+
+/* The protocol mandates little-endian encoding; the helpers below
+   serialize explicitly so that the client also works on big-endian hosts. */
+void put_u32(std::vector<uint8_t> &p, uint32_t value) {
+    p.push_back((uint8_t) (value & 0xff));
+    p.push_back((uint8_t) ((value >> 8) & 0xff));
+    p.push_back((uint8_t) ((value >> 16) & 0xff));
+    p.push_back((uint8_t) ((value >> 24) & 0xff));
+}
+
+void put_f32(std::vector<uint8_t> &p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+    put_u32(p, bits);
+}
+
+void put_string(std::vector<uint8_t> &p, const std::string &value) {
+    p.insert(p.end(), value.begin(), value.end());
+    p.push_back(0);
+}
+
+/// Start a packet: reserve space for the length prefix, write the type
+std::vector<uint8_t> begin_packet(TevPacket type) {
+    std::vector<uint8_t> p;
+    put_u32(p, 0); // patched in end_packet()
+    p.push_back((uint8_t) type);
+    return p;
+}
+
+/// Patch the total packet length (which includes the prefix itself)
+void end_packet(std::vector<uint8_t> &p) {
+    uint32_t length = (uint32_t) p.size();
+    p[0] = (uint8_t) (length & 0xff);
+    p[1] = (uint8_t) ((length >> 8) & 0xff);
+    p[2] = (uint8_t) ((length >> 16) & 0xff);
+    p[3] = (uint8_t) ((length >> 24) & 0xff);
+}
+
+} // namespace
+
+struct TevClient::TevClientPrivate {
+    std::string hostname;
+    uint16_t port;
+    socket_t socket = MI_INVALID_SOCKET;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::vector<uint8_t>> queue;
+    bool stop = false;
+    bool failed = false;
+
+    void close_socket() {
+        if (socket == MI_INVALID_SOCKET)
+            return;
+#if defined(_WIN32)
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+        socket = MI_INVALID_SOCKET;
+    }
+
+    bool send_packet(const std::vector<uint8_t> &packet) {
+        size_t offset = 0;
+        while (offset < packet.size()) {
+#if defined(MSG_NOSIGNAL)
+            int flags = MSG_NOSIGNAL;
+#else
+            int flags = 0;
+#endif
+            auto sent = send(socket, (const char *) packet.data() + offset,
+                             (int) (packet.size() - offset), flags);
+            if (sent <= 0)
+                return false;
+            offset += (size_t) sent;
+        }
+        return true;
+    }
+};
+
+TevClient::TevClient(const std::string &hostname, uint16_t port)
+    : d(new TevClientPrivate()) {
+    d->hostname = hostname;
+    d->port = port;
+
+#if defined(_WIN32)
+    static std::once_flag wsa_flag;
+    std::call_once(wsa_flag, []() {
+        WSADATA wsa_data;
+        WSAStartup(MAKEWORD(2, 2), &wsa_data);
+    });
+#endif
+
+    struct addrinfo hints, *info = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    int rv = getaddrinfo(hostname.c_str(), std::to_string(port).c_str(),
+                         &hints, &info);
+    if (rv != 0)
+        Throw("TevClient: unable to resolve \"%s\": %s", hostname,
+              gai_strerror(rv));
+
+    for (struct addrinfo *it = info; it != nullptr; it = it->ai_next) {
+        d->socket = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+        if (d->socket == MI_INVALID_SOCKET)
+            continue;
+        if (connect(d->socket, it->ai_addr, (int) it->ai_addrlen) == 0)
+            break;
+        d->close_socket();
+    }
+    freeaddrinfo(info);
+
+    if (d->socket == MI_INVALID_SOCKET)
+        Throw("TevClient: unable to connect to %s:%i! Is tev running with "
+              "its IPC interface enabled?", hostname, (int) port);
+
+    Log(Info, "TevClient: connected to %s:%i", hostname, (int) port);
+
+    d->worker = std::thread([p = d.get()]() {
+        for (;;) {
+            std::vector<uint8_t> packet;
+            /* locked */ {
+                std::unique_lock<std::mutex> lock(p->mutex);
+                p->cv.wait(lock,
+                           [p]() { return p->stop || !p->queue.empty(); });
+                if (p->queue.empty())
+                    break; // only reachable when stopping
+                packet = std::move(p->queue.front());
+                p->queue.pop_front();
+            }
+
+            if (!p->send_packet(packet)) {
+                std::lock_guard<std::mutex> lock(p->mutex);
+                p->failed = true;
+                p->queue.clear();
+                Log(Warn, "TevClient: connection to %s:%i was lost, "
+                    "discarding further updates.", p->hostname, (int) p->port);
+                break;
+            }
+        }
+    });
+}
+
+TevClient::~TevClient() {
+    /* locked */ {
+        std::lock_guard<std::mutex> lock(d->mutex);
+        d->stop = true;
+    }
+    d->cv.notify_all();
+    if (d->worker.joinable())
+        d->worker.join();
+    d->close_socket();
+}
+
+void TevClient::enqueue(std::vector<uint8_t> &&packet) {
+    /* locked */ {
+        std::lock_guard<std::mutex> lock(d->mutex);
+        if (d->failed || d->stop)
+            return;
+
+        /* Bound the queue so that a stalled viewer cannot make the render
+           process accumulate stale preview tiles without limit */
+        if (d->queue.size() >= 1024)
+            d->queue.pop_front();
+
+        d->queue.push_back(std::move(packet));
+    }
+    d->cv.notify_one();
+}
+
+void TevClient::create_image(const std::string &name, uint32_t width,
+                             uint32_t height,
+                             const std::vector<std::string> &channels) {
+    std::vector<uint8_t> p = begin_packet(TevPacket::CreateImage);
+    p.push_back(1); // grab focus
+    put_string(p, name);
+    put_u32(p, width);
+    put_u32(p, height);
+    put_u32(p, (uint32_t) channels.size());
+    for (const std::string &channel : channels)
+        put_string(p, channel);
+    end_packet(p);
+    enqueue(std::move(p));
+}
+
+void TevClient::update_image(const std::string &name, uint32_t x, uint32_t y,
+                             uint32_t width, uint32_t height,
+                             const std::vector<std::string> &channels,
+                             const float *data) {
+    // The update packet carries a single channel; send one per channel
+    size_t stride = channels.size();
+    for (size_t c = 0; c < stride; ++c) {
+        std::vector<uint8_t> p = begin_packet(TevPacket::UpdateImage);
+        p.reserve(p.size() + (size_t) width * height * sizeof(float) + 64);
+        p.push_back(0); // don't grab focus
+        put_string(p, name);
+        put_string(p, channels[c]);
+        put_u32(p, x);
+        put_u32(p, y);
+        put_u32(p, width);
+        put_u32(p, height);
+        for (size_t i = 0; i < (size_t) width * height; ++i)
+            put_f32(p, data[i * stride + c]);
+        end_packet(p);
+        enqueue(std::move(p));
+    }
+}
+
+void TevClient::close_image(const std::string &name) {
+    std::vector<uint8_t> p = begin_packet(TevPacket::CloseImage);
+    put_string(p, name);
+    end_packet(p);
+    enqueue(std::move(p));
+}
+
+bool TevClient::connected() const {
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->socket != MI_INVALID_SOCKET && !d->failed;
+}
+
+std::string TevClient::to_string() const {
+    std::ostringstream oss;
+    oss << "TevClient[" << std::endl
+        << "  hostname = " << d->hostname << "," << std::endl
+        << "  port = " << d->port << "," << std::endl
+        << "  connected = " << (connected() ? "true" : "false") << std::endl
+        << "]";
+    return oss.str();
+}
+
+MI_IMPLEMENT_CLASS(TevClient, Object)
+NAMESPACE_END(mitsuba)
@@ -2,13 +2,16 @@
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/arena.h>
 #include <nanothread/nanothread.h>
 #include <thread>
 #include <mutex>
 #include <vector>
 #include <sstream>
+#include <fstream>
 #include <chrono>
 #include <cstring>
+#include <cstdlib>
 
 // Required for native thread functions
 #if defined(__linux__)
@@ -497,6 +500,80 @@ bool Thread::unregister_external_thread() {
     return true;
 }
 
+#if !defined(__APPLE__)
+/* Enumerate the machine's processor cores in an order that interleaves its
+   NUMA nodes (node 0 core, node 1 core, node 0 core, ...). On Linux, the
+   topology is read from sysfs; when this information is unavailable (e.g. on
+   Windows, or a kernel without NUMA support), the cores are simply listed in
+   index order. */
+static std::vector<int> enumerate_cores_numa_interleaved() {
+    std::vector<std::vector<int>> nodes;
+
+#if defined(__linux__)
+    for (int node = 0; ; ++node) {
+        std::ifstream is(tfm::format(
+            "/sys/devices/system/node/node%i/cpulist", node));
+        if (!is.good())
+            break;
+
+        /* Parse a comma-separated list of core ranges (e.g. "0-63,128-191") */
+        std::vector<int> cpus;
+        std::string range;
+        while (std::getline(is, range, ',')) {
+            size_t dash = range.find('-');
+            int lo = atoi(range.c_str()), hi = lo;
+            if (dash != std::string::npos)
+                hi = atoi(range.c_str() + dash + 1);
+            for (int i = lo; i <= hi; ++i)
+                cpus.push_back(i);
+        }
+
+        if (!cpus.empty())
+            nodes.push_back(std::move(cpus));
+    }
+#endif
+
+    if (nodes.empty()) {
+        std::vector<int> cpus((size_t) util::core_count());
+        for (size_t i = 0; i < cpus.size(); ++i)
+            cpus[i] = (int) i;
+        nodes.push_back(std::move(cpus));
+    }
+
+    std::vector<int> result;
+    for (size_t i = 0; ; ++i) {
+        bool done = true;
+        for (std::vector<int> &node : nodes) {
+            if (i < node.size()) {
+                result.push_back(node[i]);
+                done = false;
+            }
+        }
+        if (done)
+            break;
+    }
+
+    return result;
+}
+#endif
+
+void Thread::pin_worker_core() {
+#if defined(__APPLE__)
+    /* CPU affinity not supported on OSX */
+#else
+    static thread_local bool pinned = false;
+    if (pinned)
+        return;
+    pinned = true;
+
+    static std::vector<int> core_order = enumerate_cores_numa_interleaved();
+    static std::atomic<uint32_t> core_ctr { 0 };
+
+    thread()->set_core_affinity(
+        core_order[core_ctr++ % (uint32_t) core_order.size()]);
+#endif
+}
+
 void Thread::register_task(Task *task) {
     std::lock_guard guard(task_mutex);
     registered_tasks.push_back(task);
@@ -546,7 +623,8 @@ void Thread::set_thread_count(size_t count) {
     pool_set_size(nullptr, (uint32_t) (count - 1));
 }
 
-ThreadEnvironment::ThreadEnvironment() {
+ThreadEnvironment::ThreadEnvironment(bool pin_workers)
+    : m_pin_workers(pin_workers) {
     Thread *thread = Thread::thread();
     Assert(thread);
     m_logger = thread->logger();
@@ -560,6 +638,8 @@ ScopedSetThreadEnvironment::ScopedSetThreadEnvironment(ThreadEnvironment &env) {
     m_file_resolver = thread->file_resolver();
     thread->set_logger(env.m_logger);
     thread->set_file_resolver(env.m_file_resolver);
+    if (env.m_pin_workers)
+        Thread::pin_worker_core();
 }
 
 ScopedSetThreadEnvironment::~ScopedSetThreadEnvironment() {
@@ -568,6 +648,11 @@ ScopedSetThreadEnvironment::~ScopedSetThreadEnvironment() {
     thread->set_file_resolver(m_file_resolver);
 }
 
+MemoryArena &scratch_arena() {
+    static thread_local MemoryArena arena;
+    return arena;
+}
+
 MI_IMPLEMENT_CLASS(Thread, Object)
 MI_IMPLEMENT_CLASS(MainThread, Thread)
 MI_IMPLEMENT_CLASS(WorkerThread, Thread)
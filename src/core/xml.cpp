@@ -9,6 +9,7 @@
 #include <mitsuba/core/config.h>
 #include <mitsuba/core/filesystem.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/loadtimer.h>
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
 #include <mitsuba/core/object.h>
@@ -20,6 +21,7 @@
 #include <mitsuba/core/vector.h>
 #include <mitsuba/core/xml.h>
 #include <mitsuba/core/timer.h>
+#include <mitsuba/core/arena.h>
 #include <pugixml.hpp>
 #include <nanothread/nanothread.h>
 
@@ -35,6 +37,54 @@
 NAMESPACE_BEGIN(mitsuba)
 NAMESPACE_BEGIN(xml)
 
+/* Parse-scoped arenas for XML document storage
+ *
+ * pugixml acquires all of its node and string storage in larger pages via
+ * the global allocation hooks below. Directing those pages at a monotonic
+ * arena that shares its scope with the document turns document teardown into
+ * a handful of wholesale block releases and keeps parsing (in particular
+ * parallel <include> expansion) away from the malloc lock. Scopes nest: an
+ * included document parsed while an enclosing document is live simply pushes
+ * another arena onto the thread-local chain below. Arena-backed pages that
+ * pugixml frees individually (e.g. when upgrade_tree() rewrites nodes) are
+ * simply retired with their arena.
+ *
+ * Code outside of an \ref ScopedDocumentArena (e.g. other threads) falls
+ * back to the regular system allocator. */
+struct ScopedDocumentArena {
+    MemoryArena arena;
+    ScopedDocumentArena *prev;
+
+    ScopedDocumentArena() : prev(current) { current = this; }
+    ~ScopedDocumentArena() { current = prev; }
+
+    static thread_local ScopedDocumentArena *current;
+};
+
+thread_local ScopedDocumentArena *ScopedDocumentArena::current = nullptr;
+
+static void *document_arena_alloc(size_t size) {
+    if (ScopedDocumentArena *scope = ScopedDocumentArena::current)
+        return scope->arena.alloc(size);
+    return std::malloc(size);
+}
+
+static void document_arena_free(void *ptr) {
+    for (ScopedDocumentArena *scope = ScopedDocumentArena::current;
+         scope != nullptr; scope = scope->prev) {
+        if (scope->arena.owns(ptr))
+            return;
+    }
+    std::free(ptr);
+}
+
+/// Install the pugixml allocation hooks during static initialization
+[[maybe_unused]] static int install_document_arena_hooks = []() {
+    pugi::set_memory_management_functions(document_arena_alloc,
+                                          document_arena_free);
+    return 0;
+}();
+
 // Set of supported XML tags
 enum class Tag {
     Boolean, Integer, Float, String, Point, Vector, Spectrum, RGB,
@@ -246,11 +296,74 @@ ColorMode variant_to_color_mode() {
         static_assert(false_v<Float, Spectrum>, "This should never happen!");
 }
 
+/**
+ * Process-wide cache for <tt>&lt;include cache="true"&gt;</tt> fragments.
+ * Large shared includes (e.g. a studio material library used by every shot)
+ * are parsed and instantiated only once; subsequent scene loads graft the
+ * resulting read-only, reference-counted object graph directly into their
+ * object hierarchy, skipping both XML parsing and plugin instantiation.
+ *
+ * Cached includes must be self-contained: they may not reference ids
+ * declared by the including document and may not depend on <default>
+ * parameter substitutions, since the cached expansion is shared by all
+ * later loads. Entries are keyed by resolved filename and variant and
+ * invalidated when the file size or modification time changes.
+ */
+struct CachedInclude {
+    struct Instance {
+        std::string id;
+        ref<Object> object;
+        std::string alias;
+    };
+
+    size_t file_size = 0;
+    int64_t file_mtime = 0;
+    bool scene_rooted = false;
+    bool ready = false;
+
+    /// Named references contributed to the including document
+    std::vector<std::pair<std::string, std::string>> refs;
+
+    /// Instantiated objects (and aliases) declared by the fragment
+    std::vector<Instance> instances;
+};
+
+static std::mutex include_cache_mutex;
+static std::unordered_map<std::string, CachedInclude> include_cache;
+
 struct XMLParseContext {
     std::string variant;
     bool parallel;
 
+    /// Cacheable <include> fragments encountered while parsing this
+    /// document, committed by \ref commit_include_cache() after the load
+    struct PendingInclude {
+        std::string key;
+        size_t file_size = 0;
+        int64_t file_mtime = 0;
+        bool scene_rooted = false;
+        std::vector<std::pair<std::string, std::string>> refs;
+        std::vector<std::string> ids;
+    };
+    std::vector<PendingInclude> pending_includes;
+
+    /* File references ("filename" properties) encountered while parsing;
+       handed to FileResolver::prefetch() before instantiation so that the
+       resolution of thousands of paths overlaps rather than being paid
+       serially by each plugin constructor */
+    std::vector<fs::path> file_references;
+
     std::unordered_map<std::string, XMLObject> instances;
+
+    /* Content-based deduplication of identical plugin objects, bucketed by
+       class and plugin name. Entries are compared via Properties::operator==
+       (ignoring the id), so child objects must already be deduplicated for
+       parents to match -- which holds, since children are instantiated
+       first. */
+    std::mutex dedup_mutex;
+    std::unordered_map<std::string,
+                       std::vector<std::pair<Properties, ref<Object>>>> dedup_cache;
+
     Transform4f transform;
     ColorMode color_mode;
     uint32_t id_counter = 0;
@@ -663,14 +776,73 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                 break;
 
             case Tag::Include: {
-                    check_attributes(src, node, { "filename" });
+                    check_attributes(src, node, { "filename", "cache" }, false);
                     ref<FileResolver> fs = Thread::thread()->file_resolver();
                     fs::path filename = fs->resolve(node.attribute("filename").value());
                     if (!fs::exists(filename))
                         src.throw_error(node, "included file \"%s\" not found", filename);
 
+                    /* Optionally expand the included fragment only once per
+                       process, see the CachedInclude documentation above */
+                    bool cache = node.attribute("cache").as_bool(false);
+                    std::string cache_key = filename.string() + "|" + ctx.variant;
+                    size_t cache_file_size = cache ? fs::file_size(filename) : 0;
+                    int64_t cache_file_mtime =
+                        cache ? fs::last_write_time(filename) : 0;
+
+                    if (cache) {
+                        std::lock_guard<std::mutex> guard(include_cache_mutex);
+                        auto it_cache = include_cache.find(cache_key);
+                        if (it_cache != include_cache.end() &&
+                            it_cache->second.ready &&
+                            it_cache->second.file_size == cache_file_size &&
+                            it_cache->second.file_mtime == cache_file_mtime) {
+                            Log(Info, "Grafting cached XML include \"%s\" ..",
+                                filename);
+                            const CachedInclude &entry = it_cache->second;
+
+                            for (const auto &c : entry.instances) {
+                                if (ctx.instances.find(c.id) != ctx.instances.end())
+                                    src.throw_error(node, "cached include \"%s\" "
+                                        "declares duplicate id \"%s\"",
+                                        filename.string(), c.id);
+                                XMLObject &inst = ctx.instances[c.id];
+                                inst.object = c.object;
+                                inst.alias  = c.alias;
+                                inst.src_id = filename.string();
+                                inst.offset = [](ptrdiff_t) -> std::string { return "?"; };
+                            }
+
+                            // Re-number automatically assigned argument names
+                            auto renumber = [&arg_counter](const std::string &name) {
+                                return string::starts_with(name, "_arg_")
+                                    ? tfm::format("_arg_%i", arg_counter++) : name;
+                            };
+
+                            if (!entry.scene_rooted && entry.refs.size() == 1)
+                                return std::make_pair(renumber(entry.refs[0].first),
+                                                      entry.refs[0].second);
+
+                            for (const auto &[ref_name, ref_id] : entry.refs)
+                                props.set_named_reference(renumber(ref_name), ref_id);
+
+                            return std::make_pair("", "");
+                        }
+                    }
+
+                    XMLParseContext::PendingInclude pending;
+                    std::set<std::string> ids_before;
+                    if (cache) {
+                        pending.key = cache_key;
+                        pending.file_size = cache_file_size;
+                        pending.file_mtime = cache_file_mtime;
+                        for (const auto &kv : ctx.instances)
+                            ids_before.insert(kv.first);
+                    }
+
                     Log(Info, "Loading included XML file \"%s\" ..", filename);
 
+                    ScopedDocumentArena doc_arena;
                     pugi::xml_document doc;
                     pugi::xml_parse_result result = doc.load_file(filename.native().c_str());
 
@@ -706,12 +878,33 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
                             for (pugi::xml_node &ch: doc.begin()->children()) {
                                 auto [arg_name, nested_id] = parse_xml(nested_src, ctx, ch, parent_tag,
                                           props, param, arg_counter, 1);
-                                if (!nested_id.empty())
+                                if (!nested_id.empty()) {
                                     props.set_named_reference(arg_name, nested_id);
+                                    if (cache)
+                                        pending.refs.emplace_back(arg_name, nested_id);
+                                }
+                            }
+
+                            if (cache) {
+                                pending.scene_rooted = true;
+                                for (const auto &kv : ctx.instances)
+                                    if (ids_before.find(kv.first) == ids_before.end())
+                                        pending.ids.push_back(kv.first);
+                                ctx.pending_includes.push_back(std::move(pending));
                             }
                         } else {
-                            return parse_xml(nested_src, ctx, *doc.begin(), parent_tag,
-                                             props, param, arg_counter, 0);
+                            auto result = parse_xml(nested_src, ctx, *doc.begin(), parent_tag,
+                                                    props, param, arg_counter, 0);
+
+                            if (cache) {
+                                pending.refs.emplace_back(result);
+                                for (const auto &kv : ctx.instances)
+                                    if (ids_before.find(kv.first) == ids_before.end())
+                                        pending.ids.push_back(kv.first);
+                                ctx.pending_includes.push_back(std::move(pending));
+                            }
+
+                            return result;
                         }
                     } catch (const std::exception &e) {
                         src.throw_error(node, "%s", e.what());
@@ -721,7 +914,14 @@ static std::pair<std::string, std::string> parse_xml(XMLSource &src, XMLParseCon
 
             case Tag::String: {
                     check_attributes(src, node, { "name", "value" });
-                    props.set_string(node.attribute("name").value(), node.attribute("value").value());
+                    std::string name  = node.attribute("name").value(),
+                                value = node.attribute("value").value();
+
+                    // Record file references for the post-parse prefetch pass
+                    if (name == "filename")
+                        ctx.file_references.push_back(value);
+
+                    props.set_string(name, value);
                 }
                 break;
 
@@ -991,6 +1191,7 @@ static std::string init_xml_parse_context_from_file(XMLParseContext &ctx,
                                                     bool write_update) {
     fs::path filename = filename_;
 
+    ScopedDocumentArena doc_arena;
     pugi::xml_document doc;
     pugi::xml_parse_result result = doc.load_file(filename.native().c_str(),
         pugi::parse_default |
@@ -1060,6 +1261,10 @@ static Task *instantiate_node(XMLParseContext &ctx,
     if (!inst.alias.empty())
         return instantiate_node(ctx, inst.alias, env, task_map, top_node);
 
+    // Already constructed, e.g. grafted from the include cache
+    if (inst.object)
+        return nullptr;
+
     Properties &props = inst.props;
     const auto &named_references = props.named_references();
     uint32_t scope = inst.scope;
@@ -1109,6 +1314,36 @@ static Task *instantiate_node(XMLParseContext &ctx,
             }
         }
 
+        /* Exporters commonly emit large numbers of textually identical
+           BSDF/texture definitions. Instantiating each separately multiplies
+           memory use and the number of dispatch targets in JIT variants, so
+           identical definitions collapse onto a single shared instance.
+           Objects that hold back-references to their parents (shapes,
+           emitters, sensors, ...) are not eligible. Specify
+           'dedup = false' on an object to opt out. */
+        std::string cls_name = inst.class_->name();
+        bool dedup = (cls_name == "BSDF" || cls_name == "Texture") &&
+                     props.get<bool>("dedup", true);
+
+        Properties key;
+        std::string bucket_id;
+        if (dedup) {
+            key = props;
+            key.set_id("");
+            key.remove_property("dedup");
+            bucket_id = cls_name + "|" + props.plugin_name();
+
+            std::lock_guard<std::mutex> guard(ctx.dedup_mutex);
+            for (auto &entry : ctx.dedup_cache[bucket_id]) {
+                if (entry.first == key) {
+                    inst.object = entry.second;
+                    for (auto &name : props.property_names())
+                        props.mark_queried(name);
+                    return;
+                }
+            }
+        }
+
         try {
             inst.object = PluginManager::instance()->create_object(props, inst.class_);
         } catch (const std::exception &e) {
@@ -1139,6 +1374,19 @@ static Task *instantiate_node(XMLParseContext &ctx,
                   unqueried.size() > 1 ? "properties" : "property", unqueried,
                   string::to_lower(inst.class_->name()), props.plugin_name());
         }
+
+        if (dedup) {
+            std::lock_guard<std::mutex> guard(ctx.dedup_mutex);
+            auto &bucket = ctx.dedup_cache[bucket_id];
+            for (auto &entry : bucket) {
+                if (entry.first == key) {
+                    // Another thread instantiated the same definition first
+                    inst.object = entry.second;
+                    return;
+                }
+            }
+            bucket.emplace_back(std::move(key), inst.object);
+        }
     };
 
     if (top_node) {
@@ -1169,6 +1417,73 @@ static Task *instantiate_node(XMLParseContext &ctx,
     }
 }
 
+/**
+ * Populate the process-wide include cache with the object graphs of all
+ * <include cache="true"> fragments encountered by this load. Objects of a
+ * fragment that were not referenced by the current scene are instantiated
+ * here, so that later scenes may reference any part of the fragment.
+ */
+static void commit_include_cache(XMLParseContext &ctx) {
+    for (auto &pending : ctx.pending_includes) {
+        CachedInclude entry;
+        entry.file_size    = pending.file_size;
+        entry.file_mtime   = pending.file_mtime;
+        entry.scene_rooted = pending.scene_rooted;
+        entry.refs         = std::move(pending.refs);
+
+        /* Objects of the fragment that were not referenced by the current
+           scene are submitted as independent tasks, so that large cached
+           fragments are constructed in parallel just like the dependency
+           DAG of the main scene */
+        ThreadEnvironment env;
+        std::unordered_map<std::string, Task *> task_map;
+        std::vector<Task *> tasks;
+        for (const std::string &id : pending.ids) {
+            auto it = ctx.instances.find(id);
+            if (it == ctx.instances.end())
+                continue;
+
+            XMLObject &inst = it->second;
+            if (!inst.object && inst.alias.empty()) {
+                if (task_map.find(id) == task_map.end())
+                    task_map.insert(
+                        { id, instantiate_node(ctx, id, env, task_map, false) });
+                tasks.push_back(task_map.find(id)->second);
+            }
+        }
+
+        std::exception_ptr eptr;
+        for (Task *task : tasks) {
+            try {
+                task_wait(task);
+            } catch (...) {
+                if (!eptr)
+                    eptr = std::current_exception();
+            }
+        }
+        for (auto &kv : task_map)
+            task_release(kv.second);
+        if (eptr)
+            std::rethrow_exception(eptr);
+
+        for (const std::string &id : pending.ids) {
+            auto it = ctx.instances.find(id);
+            if (it == ctx.instances.end())
+                continue;
+
+            XMLObject &inst = it->second;
+            entry.instances.push_back({ id, inst.object, inst.alias });
+        }
+
+        entry.ready = true;
+
+        std::lock_guard<std::mutex> guard(include_cache_mutex);
+        include_cache[pending.key] = std::move(entry);
+    }
+
+    ctx.pending_includes.clear();
+}
+
 static ref<Object> instantiate_top_node(XMLParseContext &ctx, const std::string &id) {
     ThreadEnvironment env;
     std::unordered_map<std::string, Task*> task_map;
@@ -1361,6 +1676,7 @@ std::vector<ref<Object>> load_string(const std::string &string,
                                      ParameterList param,
                                      bool parallel) {
     ScopedPhase sp(ProfilerPhase::InitScene);
+    ScopedDocumentArena doc_arena;
     pugi::xml_document doc;
     pugi::xml_parse_result result = doc.load_buffer(string.c_str(), string.length(),
                                                     pugi::parse_default |
@@ -1379,19 +1695,31 @@ std::vector<ref<Object>> load_string(const std::string &string,
     Thread::thread()->set_file_resolver(new FileResolver(*fs_backup));
 
     try {
+        load_stats::clear();
+
         pugi::xml_node root = doc.document_element();
         detail::XMLParseContext ctx(variant, parallel);
         Properties props;
         size_t arg_counter = 0; // Unused
-        auto scene_id = detail::parse_xml(src, ctx, root, Tag::Invalid, props,
-                                          param, arg_counter, 0).second;
+        std::string scene_id;
+        {
+            load_stats::ScopedLoadTimer lt("Parsing");
+            scene_id = detail::parse_xml(src, ctx, root, Tag::Invalid, props,
+                                         param, arg_counter, 0).second;
+        }
 
         for (const auto& p : param) {
             if (!std::get<2>(p))
                 Throw("Unused parameter \"%s\"!", std::get<0>(p));
         }
 
+        if (!ctx.file_references.empty()) {
+            load_stats::ScopedLoadTimer lt("File prefetch");
+            Thread::thread()->file_resolver()->prefetch(ctx.file_references);
+        }
+
         ref<Object> top_node = detail::instantiate_top_node(ctx, scene_id);
+        detail::commit_include_cache(ctx);
         std::vector<ref<Object>> objects = detail::expand_node(top_node);
 
         Thread::thread()->set_file_resolver(fs_backup.get());
@@ -1422,16 +1750,30 @@ std::vector<ref<Object>> load_file(const fs::path &filename,
     Thread::thread()->set_file_resolver(fs.get());
 
     try {
+        load_stats::clear();
+
         detail::XMLParseContext ctx(variant, parallel);
-        auto scene_id = detail::init_xml_parse_context_from_file(ctx, filename, param, write_update);
+        std::string scene_id;
+        {
+            load_stats::ScopedLoadTimer lt("Parsing");
+            scene_id = detail::init_xml_parse_context_from_file(
+                ctx, filename, param, write_update);
+        }
+
+        if (!ctx.file_references.empty()) {
+            load_stats::ScopedLoadTimer lt("File prefetch");
+            Thread::thread()->file_resolver()->prefetch(ctx.file_references);
+        }
 
         ref<Object> top_node = detail::instantiate_top_node(ctx, scene_id);
+        detail::commit_include_cache(ctx);
         std::vector<ref<Object>> objects = detail::expand_node(top_node);
 
         Thread::thread()->set_file_resolver(fs_backup.get());
 
         Log(Info, "Done loading XML file \"%s\" (took %s).",
             filename, util::time_string((float) timer.value(), true));
+        Log(Info, "%s", load_stats::report());
 
         return objects;
     } catch (...) {
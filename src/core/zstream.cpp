@@ -1,5 +1,7 @@
 #include <mitsuba/core/zstream.h>
+#include <nanothread/nanothread.h>
 #include <zlib.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -7,7 +9,9 @@ ZStream::ZStream(Stream *child_stream, EStreamType stream_type, int level)
     : m_child_stream(child_stream),
       m_deflate_stream(new z_stream()),
       m_inflate_stream(new z_stream()),
-      m_did_write(false) {
+      m_did_write(false),
+      m_stream_type(stream_type),
+      m_level(level) {
     m_deflate_stream->zalloc = Z_NULL;
     m_deflate_stream->zfree = Z_NULL;
     m_deflate_stream->opaque = Z_NULL;
@@ -29,11 +33,42 @@ ZStream::ZStream(Stream *child_stream, EStreamType stream_type, int level)
     retval = inflateInit2(m_inflate_stream.get(), window_bits);
     if (retval != Z_OK)
         Throw("Could not initialize ZLIB: error code %i", retval);
+
+    /* Detect the framed block format (see EBlockStream) by its magic number
+       so that both stream variants load transparently */
+    if (stream_type == EDeflateStream && child_stream->can_read() &&
+        child_stream->size() - child_stream->tell() >= sizeof(uint32_t)) {
+        size_t pos = child_stream->tell();
+        uint32_t magic;
+        child_stream->read(magic);
+        if (magic == detail::kZStreamBlockMagic)
+            m_stream_type = EBlockStream;
+        else
+            child_stream->seek(pos);
+    }
 }
 
 void ZStream::write(const void *ptr, size_t size) {
     Assert(m_child_stream != nullptr);
 
+    if (m_stream_type == EBlockStream) {
+        /* Gather the input into blocks of 'kZStreamBlockSize' bytes that are
+           compressed independently of each other */
+        const uint8_t *source = (const uint8_t *) ptr;
+        while (size > 0) {
+            size_t n = std::min(
+                size, detail::kZStreamBlockSize - m_block_input.size());
+            m_block_input.insert(m_block_input.end(), source, source + n);
+            source += n;
+            size -= n;
+
+            if (m_block_input.size() == detail::kZStreamBlockSize)
+                write_block();
+        }
+        m_did_write = true;
+        return;
+    }
+
     m_deflate_stream->avail_in = (uInt) size;
     m_deflate_stream->next_in = (uint8_t *) ptr;
 
@@ -56,9 +91,101 @@ void ZStream::write(const void *ptr, size_t size) {
     m_did_write = true;
 }
 
+void ZStream::write_block() {
+    if (!m_wrote_block_magic) {
+        m_child_stream->write(detail::kZStreamBlockMagic);
+        m_wrote_block_magic = true;
+    }
+
+    if (m_block_input.empty())
+        return;
+
+    uLongf bound = compressBound((uLong) m_block_input.size());
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[bound]);
+
+    int retval = compress2(buf.get(), &bound, m_block_input.data(),
+                           (uLong) m_block_input.size(), m_level);
+    if (retval != Z_OK)
+        Throw("compress2(): error code %i!", retval);
+
+    m_child_stream->write((uint32_t) bound);
+    m_child_stream->write((uint32_t) m_block_input.size());
+    m_child_stream->write(buf.get(), bound);
+
+    m_block_input.clear();
+}
+
+void ZStream::read_blocks() {
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t compressed_size, size, offset;
+    };
+
+    /* Slurp in the compressed blocks sequentially (they are typically backed
+       by a memory-mapped or buffered stream) ... */
+    std::vector<Block> blocks;
+    size_t total = 0;
+
+    while (true) {
+        size_t remaining = m_child_stream->size() - m_child_stream->tell();
+        if (remaining < 2 * sizeof(uint32_t))
+            break;
+
+        uint32_t compressed_size, size;
+        m_child_stream->read(compressed_size);
+        if (compressed_size == 0) // terminator written by close()
+            break;
+        m_child_stream->read(size);
+
+        Block block;
+        block.data = std::unique_ptr<uint8_t[]>(new uint8_t[compressed_size]);
+        block.compressed_size = compressed_size;
+        block.size = size;
+        block.offset = total;
+        m_child_stream->read(block.data.get(), compressed_size);
+
+        total += size;
+        blocks.push_back(std::move(block));
+    }
+
+    m_block_output = std::unique_ptr<uint8_t[]>(new uint8_t[total]);
+    m_block_output_size = total;
+    m_block_output_pos = 0;
+
+    // ... and decompress them in parallel across the worker threads
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, blocks.size(), 1),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                const Block &block = blocks[i];
+                uLongf size = (uLongf) block.size;
+
+                int retval = uncompress(m_block_output.get() + block.offset,
+                                        &size, block.data.get(),
+                                        (uLong) block.compressed_size);
+                if (retval != Z_OK || size != block.size)
+                    Throw("uncompress(): error code %i!", retval);
+            }
+        }
+    );
+}
+
 void ZStream::read(void *ptr, size_t size) {
     Assert(m_child_stream != nullptr);
 
+    if (m_stream_type == EBlockStream) {
+        if (!m_block_output)
+            read_blocks();
+
+        if (size > m_block_output_size - m_block_output_pos)
+            Throw("Read less data than expected (%i more bytes required)",
+                  size - (m_block_output_size - m_block_output_pos));
+
+        memcpy(ptr, m_block_output.get() + m_block_output_pos, size);
+        m_block_output_pos += size;
+        return;
+    }
+
     uint8_t *targetPtr = (uint8_t *) ptr;
     while (size > 0) {
         if (m_inflate_stream->avail_in == 0) {
@@ -102,6 +229,13 @@ void ZStream::flush() {
     Assert(m_child_stream != nullptr);
 
     if (m_did_write) {
+        if (m_stream_type == EBlockStream) {
+            // Compress the pending (partial) block
+            write_block();
+            m_child_stream->flush();
+            return;
+        }
+
         m_deflate_stream->avail_in = 0;
         m_deflate_stream->next_in = NULL;
         int output_size = 0;
@@ -128,22 +262,27 @@ void ZStream::close() {
         return;
 
     if (m_did_write) {
-        m_deflate_stream->avail_in = 0;
-        m_deflate_stream->next_in = NULL;
-        int output_size = 0;
-
-        do {
-            m_deflate_stream->avail_out = sizeof(m_deflate_buffer);
-            m_deflate_stream->next_out = m_deflate_buffer;
-
-            int retval = deflate(m_deflate_stream.get(), Z_FINISH);
-            if (retval == Z_STREAM_ERROR)
-                Throw("deflate(): stream error!");
-
-            output_size = sizeof(m_deflate_buffer) - m_deflate_stream->avail_out;
-
-            m_child_stream->write(m_deflate_buffer, output_size);
-        } while (output_size != 0);
+        if (m_stream_type == EBlockStream) {
+            write_block();
+            m_child_stream->write((uint32_t) 0); // terminating block header
+        } else {
+            m_deflate_stream->avail_in = 0;
+            m_deflate_stream->next_in = NULL;
+            int output_size = 0;
+
+            do {
+                m_deflate_stream->avail_out = sizeof(m_deflate_buffer);
+                m_deflate_stream->next_out = m_deflate_buffer;
+
+                int retval = deflate(m_deflate_stream.get(), Z_FINISH);
+                if (retval == Z_STREAM_ERROR)
+                    Throw("deflate(): stream error!");
+
+                output_size = sizeof(m_deflate_buffer) - m_deflate_stream->avail_out;
+
+                m_child_stream->write(m_deflate_buffer, output_size);
+            } while (output_size != 0);
+        }
     }
 
     deflateEnd(m_deflate_stream.get());
@@ -5,6 +5,7 @@
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/scene.h>
+#include <mitsuba/render/shape.h>
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/srgb.h>
 #include <drjit/tensor.h>
@@ -49,6 +50,29 @@ Environment emitter (:monosp:`envmap`)
      will be combined using multiple importance sampling (MIS)? This is
      extremely cheap to do and can slightly reduce variance. (Default: false)
 
+ * - alias_table
+   - |bool|
+   - Importance sample the environment map using an alias table instead of
+     hierarchical sample warping. Drawing a sample then requires a constant
+     number of memory fetches independent of the image resolution, which is
+     considerably faster on the GPU for high-resolution (e.g. 8K) input
+     images. The alias table produces a piecewise constant rather than
+     bilinearly interpolated sampling density and does not preserve
+     stratification of the input sample pattern. (Default: false)
+
+ * - portal
+   - |shape|
+   - Optional shape (typically a rectangle covering a window or door opening)
+     that restricts direct illumination sampling of this emitter to the solid
+     angle subtended by the shape. This greatly improves convergence in
+     interior scenes that only see the environment through small openings,
+     where uniformly chosen directions are almost always occluded. The portal
+     shape only guides sampling: it is not part of the scene geometry and
+     casts neither shadows nor intersections. Light paths that reach the
+     environment without passing through the portal are no longer found by
+     emitter sampling, so the portal must cover all relevant openings.
+     (Default: none)
+
  * - data
    - |tensor|
    - Tensor array containing the radiance-valued data.
@@ -101,6 +125,7 @@ public:
     MI_IMPORT_TYPES(Scene, Shape, Texture)
 
     using Warp = Hierarchical2D<Float, 0>;
+    using AliasWarp = AliasTable2D<Float>;
 
     /* In RGB variants: 3-channel array for R, G, and B components
        In spectral variants: 4-channel array for polynomial coefficients & scale */
@@ -230,8 +255,21 @@ public:
         m_data = TensorXf(bitmap_2->data(), 3, shape);
 
         m_scale = props.get<ScalarFloat>("scale", 1.f);
-        m_warp = Warp(luminance.get(), res);
+        m_alias = props.get<bool>("alias_table", false);
+        if (m_alias)
+            m_alias_warp = AliasWarp(luminance.get(), res);
+        else
+            m_warp = Warp(luminance.get(), res);
         m_d65 = Texture::D65(1.f);
+
+        if (props.has_property("portal")) {
+            ref<Object> obj = props.object("portal");
+            m_portal = dynamic_cast<Shape *>(obj.get());
+            if (!m_portal)
+                Throw("Property \"portal\" must be a Shape instance, e.g. a "
+                      "rectangle covering the opening through which the "
+                      "environment is visible.");
+        }
         m_flags = EmitterFlags::Infinite | EmitterFlags::SpatiallyVarying;
         dr::set_attr(this, "flags", m_flags);
     }
@@ -303,7 +341,10 @@ public:
                 }
             }
 
-            m_warp = Warp(luminance.get(), res);
+            if (m_alias)
+                m_alias_warp = AliasWarp(luminance.get(), res);
+            else
+                m_warp = Warp(luminance.get(), res);
         }
         Base::parameters_changed(keys);
     }
@@ -342,7 +383,7 @@ public:
         Point2f offset = warp::square_to_uniform_disk_concentric(sample2);
 
         // 2. Sample directional component
-        auto [uv, pdf] = m_warp.sample(sample3, nullptr, active);
+        auto [uv, pdf] = warp_sample(sample3, active);
         uv.x() += .5f / (m_data.shape(1) - 1);
 
         active &= pdf > 0.f;
@@ -386,7 +427,10 @@ public:
                      Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleDirection, active);
 
-        auto [uv, pdf] = m_warp.sample(sample, nullptr, active);
+        if (unlikely(m_portal != nullptr))
+            return sample_direction_portal(it, sample, active);
+
+        auto [uv, pdf] = warp_sample(sample, active);
         uv.x() += .5f / (m_data.shape(1) - 1);
         active &= pdf > 0.f;
 
@@ -427,10 +471,13 @@ public:
         return { ds, weight & active };
     }
 
-    Float pdf_direction(const Interaction3f & /*it*/, const DirectionSample3f &ds,
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
                         Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointEvaluate, active);
 
+        if (unlikely(m_portal != nullptr))
+            return pdf_direction_portal(it, ds, active);
+
         Vector3f d = m_to_world.value().inverse().transform_affine(ds.d);
 
         // Convert to latitude-longitude texture coordinates
@@ -442,7 +489,10 @@ public:
         Float inv_sin_theta = dr::safe_rsqrt(dr::maximum(
             dr::sqr(d.x()) + dr::sqr(d.z()), dr::sqr(dr::Epsilon<Float>)));
 
-        return m_warp.eval(uv) * inv_sin_theta * (1.f / (2.f * dr::sqr(dr::Pi<Float>)));
+        Float density = m_alias ? m_alias_warp.eval(uv, active)
+                                : m_warp.eval(uv, nullptr, active);
+
+        return density * inv_sin_theta * (1.f / (2.f * dr::sqr(dr::Pi<Float>)));
     }
 
     Spectrum eval_direction(const Interaction3f &it,
@@ -489,12 +539,88 @@ public:
         if (!m_filename.empty())
             oss << "  filename = \"" << m_filename << "\"," << std::endl;
         oss << "  res = \"" << res << "\"," << std::endl
-            << "  bsphere = " << string::indent(m_bsphere) << std::endl
-            << "]";
+            << "  bsphere = " << string::indent(m_bsphere) << std::endl;
+        if (m_portal)
+            oss << "  portal = " << string::indent(m_portal) << std::endl;
+        oss << "]";
         return oss.str();
     }
 
 protected:
+    /**
+     * \brief Portal-guided variant of \ref sample_direction()
+     *
+     * Instead of importance sampling the luminance of the environment map
+     * over the entire sphere, this variant samples a position on the
+     * user-provided portal shape and converts it to a direction. In interior
+     * scenes, this concentrates all emitter samples on the solid angle that
+     * can actually reach the environment.
+     */
+    std::pair<DirectionSample3f, Spectrum>
+    sample_direction_portal(const Interaction3f &it, const Point2f &sample,
+                            Mask active) const {
+        DirectionSample3f ds = m_portal->sample_direction(it, sample, active);
+        active &= ds.pdf > 0.f;
+
+        // Convert the sampled direction to latitude-longitude coordinates
+        Vector3f v = m_to_world.value().inverse().transform_affine(ds.d);
+        Point2f uv = Point2f(dr::atan2(v.x(), -v.z()) * dr::InvTwoPi<Float>,
+                             dr::safe_acos(v.y()) * dr::InvPi<Float>);
+
+        /* Move the endpoint of the record from the portal onto the emitter
+           at infinity; the density remains that of the portal solid angle */
+        Float radius = dr::maximum(m_bsphere.radius,
+                                   dr::norm(it.p - m_bsphere.center)),
+              dist   = 2.f * radius;
+
+        ds.p       = it.p + ds.d * dist;
+        ds.n       = -ds.d;
+        ds.uv      = uv;
+        ds.dist    = dist;
+        ds.delta   = false;
+        ds.emitter = this;
+        ds.pdf     = dr::select(active, ds.pdf, 0.f);
+
+        Spectrum weight =
+            depolarizer<Spectrum>(eval_spectrum(uv, it.wavelengths, active)) /
+            ds.pdf;
+
+        return { ds, weight & active };
+    }
+
+    /**
+     * \brief Portal-guided variant of \ref pdf_direction()
+     *
+     * A hypothetical emitter sample along direction <tt>ds.d</tt> must pass
+     * through the portal, so the direction is re-projected onto the portal
+     * shape to query its solid angle density. Directions that miss the portal
+     * cannot be generated by \ref sample_direction() and have density zero.
+     */
+    Float pdf_direction_portal(const Interaction3f &it,
+                               const DirectionSample3f &ds,
+                               Mask active) const {
+        Ray3f ray(it.p, ds.d, it.time, it.wavelengths);
+        SurfaceInteraction3f si =
+            m_portal->ray_intersect(ray, +RayFlags::All, active);
+        active &= si.is_valid();
+
+        DirectionSample3f ds_portal(PositionSample3f(si));
+        ds_portal.d    = ds.d;
+        ds_portal.dist = si.t;
+
+        Float pdf = m_portal->pdf_direction(it, ds_portal, active);
+        return dr::select(active, pdf, 0.f);
+    }
+
+    /// Importance sample the luminance using the active warping scheme
+    std::pair<Point2f, Float> warp_sample(const Point2f &sample,
+                                          Mask active) const {
+        if (m_alias)
+            return m_alias_warp.sample(sample, active);
+        else
+            return m_warp.sample(sample, nullptr, active);
+    }
+
     UnpolarizedSpectrum eval_spectrum(Point2f uv, const Wavelength &wavelengths,
                                       Mask active, bool include_whitepoint = true) const {
         ScalarVector2u res = { m_data.shape(1), m_data.shape(0) };
@@ -561,8 +687,13 @@ protected:
     ScalarBoundingSphere3f m_bsphere;
     TensorXf m_data;
     Warp m_warp;
+    AliasWarp m_alias_warp;
+    bool m_alias;
     ref<Texture> m_d65;
     Float m_scale;
+
+    /// Optional shape restricting emitter sampling to an opening (e.g. a window)
+    ref<Shape> m_portal;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(EnvironmentMapEmitter, Emitter)
@@ -1,3 +1,4 @@
+#include <mitsuba/core/distr_2d.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/string.h>
 #include <mitsuba/render/emitter.h>
@@ -120,6 +121,8 @@ public:
     MI_IMPORT_BASE(Emitter, m_flags, m_to_world, m_needs_sample_3)
     MI_IMPORT_TYPES(Texture)
 
+    using Warp = Hierarchical2D<Float, 0>;
+
     Projector(const Properties &props) : Base(props) {
         m_intensity_scale = dr::opaque<Float>(props.get<ScalarFloat>("scale", 1.f));
 
@@ -159,6 +162,39 @@ public:
 
             dr::make_opaque(m_camera_to_sample, m_sample_to_camera,
                             m_intensity_scale, m_sensor_area);
+
+            /* Tabulate a luminance proxy of the irradiance texture on a
+               regular grid and build a hierarchical warp over it, so that
+               \ref sample_ray() lands on bright texels proportionally. This
+               works with arbitrary nested texture types (a constant texture
+               simply yields a uniform warp). */
+            ScalarVector2u res(dr::maximum(size.x(), 2),
+                               dr::maximum(size.y(), 2));
+            size_t n = (size_t) res.x() * (size_t) res.y();
+            std::unique_ptr<ScalarFloat[]> luminance(new ScalarFloat[n]);
+
+            if constexpr (!dr::is_jit_v<Float>) {
+                ScalarFloat *ptr = luminance.get();
+                SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+                for (uint32_t y = 0; y < res.y(); ++y) {
+                    for (uint32_t x = 0; x < res.x(); ++x) {
+                        si.uv = Point2f(x / ScalarFloat(res.x() - 1),
+                                        y / ScalarFloat(res.y() - 1));
+                        *ptr++ = luminance_proxy(si);
+                    }
+                }
+            } else {
+                UInt32 idx = dr::arange<UInt32>((uint32_t) n);
+                SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+                si.uv = Point2f(Float(idx % res.x()) / ScalarFloat(res.x() - 1),
+                                Float(idx / res.x()) / ScalarFloat(res.y() - 1));
+                Float lum = luminance_proxy(si);
+                lum = dr::migrate(lum, AllocType::Host);
+                dr::sync_thread();
+                memcpy(luminance.get(), lum.data(), n * sizeof(ScalarFloat));
+            }
+
+            m_warp = Warp(luminance.get(), res);
         }
         dr::make_opaque(m_intensity_scale);
 
@@ -172,8 +208,9 @@ public:
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleRay, active);
 
 
-        // 1. Sample position on film
-        auto [uv, pdf] = m_irradiance->sample_position(direction_sample, active);
+        // 1. Sample position on film using the hierarchical luminance warp
+        auto [uv, pdf] = m_warp.sample(direction_sample, nullptr, active);
+        active &= pdf > 0.f;
 
         // 2. Sample spectrum (weight includes irradiance eval)
         SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
@@ -295,8 +332,29 @@ public:
 
     MI_DECLARE_CLASS()
 
+protected:
+    /**
+     * \brief Luminance proxy of the irradiance texture used to build the
+     * sample warp
+     *
+     * In spectral modes, the spectral irradiance is averaged over a few
+     * evenly spaced wavelengths; any texel with nonzero irradiance
+     * contributes a positive value, which keeps the warp unbiased.
+     */
+    Float luminance_proxy(const SurfaceInteraction3f &si) const {
+        if constexpr (is_spectral_v<Spectrum>) {
+            SurfaceInteraction3f si2(si);
+            si2.wavelengths = MI_CIE_MIN + (MI_CIE_MAX - MI_CIE_MIN) *
+                              math::sample_shifted<Wavelength>(.5f);
+            return dr::mean(m_irradiance->eval(si2, true));
+        } else {
+            return m_irradiance->eval_1(si, true);
+        }
+    }
+
 protected:
     ref<Texture> m_irradiance;
+    Warp m_warp;
     Float m_intensity_scale;
     Transform4f m_camera_to_sample;
     Transform4f m_sample_to_camera;
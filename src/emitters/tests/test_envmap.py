@@ -116,3 +116,73 @@ def test03_load_bitmap(variants_all_rgb):
     w2 = emitter_2.eval(si)
 
     assert dr.allclose(w1, w2, rtol=1e-3)
+
+
+def test04_portal(variants_vec_backends_once_rgb):
+    rng = mi.PCG32(size=10240)
+    sample = mi.Point2f(
+        rng.next_float32(),
+        rng.next_float32())
+
+    # Uniform environment with a portal rectangle at z = 5
+    img = dr.full(mi.TensorXf, 1.0, [10, 20])
+    emitter = mi.load_dict({
+        "type" : "envmap",
+        "bitmap" : mi.Bitmap(img),
+        "portal" : {
+            "type" : "rectangle",
+            "to_world" : mi.ScalarTransform4f.translate([0, 0, 5])
+        }
+    })
+
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    ds, w = emitter.sample_direction(si, sample)
+
+    # All samples point through the portal, with matching density
+    assert dr.all(ds.d.z > 0)
+    t = 5.0 / ds.d.z
+    p = ds.d * t
+    assert dr.all((dr.abs(p.x) <= 1) & (dr.abs(p.y) <= 1))
+    assert dr.allclose(emitter.pdf_direction(si, ds), ds.pdf, rtol=1e-4)
+
+    # The sampling weight remains radiance / pdf
+    si.wi = -ds.d
+    assert dr.allclose(w, emitter.eval(si) / ds.pdf, rtol=1e-3)
+
+    # Directions that miss the portal have density zero
+    ds_miss = dr.zeros(mi.DirectionSample3f)
+    ds_miss.d = mi.Vector3f(0, 0, -1)
+    assert dr.all(emitter.pdf_direction(si, ds_miss) == 0)
+
+
+@pytest.mark.parametrize("iteration", [0, 1, 2])
+def test05_chi2_alias(variants_vec_backends_once_rgb, iteration):
+    tempdir = tempfile.TemporaryDirectory()
+    fname = os.path.join(tempdir.name, 'out.exr')
+
+    if iteration == 0:
+        # Sparse image with 1 pixel turned on
+        img = dr.zeros(mi.TensorXf, [100, 10])
+        img[40, 5] = 1
+    elif iteration == 1:
+        # High res constant image
+        img = dr.full(mi.TensorXf, 1, [100, 100])
+    elif iteration == 2:
+        # Low res constant image
+        img = dr.full(mi.TensorXf, 1, [3, 2])
+
+    mi.Bitmap(img).write(fname)
+
+    xml = f'<string name="filename" value="{fname}"/>' \
+           '<boolean name="alias_table" value="true"/>'
+    sample_func, pdf_func = mi.chi2.EmitterAdapter("envmap", xml)
+
+    chi2 = mi.chi2.ChiSquareTest(
+        domain=mi.chi2.SphericalDomain(),
+        sample_func=sample_func,
+        pdf_func=pdf_func,
+        sample_dim=2,
+        ires=32
+    )
+
+    assert chi2.run()
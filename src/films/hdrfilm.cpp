@@ -3,10 +3,15 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/string.h>
+#include <mitsuba/core/tev.h>
+#include <mitsuba/core/thread.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/fwd.h>
 #include <mitsuba/render/imageblock.h>
+#include <mitsuba/render/spiral.h>
+#include <nanothread/nanothread.h>
 
+#include <atomic>
 #include <mutex>
 
 NAMESPACE_BEGIN(mitsuba)
@@ -64,6 +69,45 @@ High dynamic range film (:monosp:`hdrfilm`)
      in JIT variants and can make sample accumulation quite a bit more expensive.
      (Default: |false|, i.e. disabled)
 
+ * - storage_format
+   - |string|
+   - Specifies the in-memory representation of the film's sample accumulation
+     buffer. The default is :monosp:`float32`. Specify :monosp:`float16` to
+     store accumulated channel values as half precision, which halves film
+     memory---useful for large outputs with many AOV channels. Sample
+     accumulation itself still happens in single precision image blocks that
+     are merged into the film with a round-to-nearest conversion, so the
+     accuracy loss is limited to the final rounding step. This feature is only
+     supported in JIT variants and is incompatible with the
+     :monosp:`compensate` parameter and with :monosp:`render_region`-style
+     partial film updates.
+
+ * - firefly_clamp
+   - |float|
+   - If set to a positive value, samples whose largest RGB component exceeds
+     this threshold are scaled down so that it equals the threshold before
+     being accumulated. This suppresses "fireflies" (rare high-energy outlier
+     samples, e.g. from difficult caustic paths) at the cost of a small amount
+     of energy loss, which is often far cheaper than rendering at a higher
+     sample count and filtering outliers in post. (Default: 0, i.e. disabled)
+
+ * - firefly_aov
+   - |bool|
+   - If set to |true| (and :monosp:`firefly_clamp` is positive), the energy
+     removed by the clamp is accumulated into an extra output channel named
+     :monosp:`clamped` instead of being discarded, so that it remains
+     available for inspection or redistribution in post-processing.
+     (Default: |false|, i.e. discard the removed energy)
+
+ * - display_server
+   - |string|
+   - Hostname (or ``host:port``) of a running `tev <https://github.com/Tom94/tev>`_
+     image viewer. When specified, the film streams updated tiles to the
+     viewer as they are accumulated, so that in-progress renders can be
+     watched live. All network I/O happens on a dedicated background
+     thread---rendering worker threads never wait on the socket. The port
+     defaults to tev's standard port 14158. (Default: disabled)
+
  * - (Nested plugin)
    - :paramtype:`rfilter`
    - Reconstruction filter that should be used by the film. (Default: :monosp:`gaussian`, a windowed
@@ -226,6 +270,56 @@ public:
 
         m_compensate = props.get<bool>("compensate", false);
 
+        std::string storage_format = string::to_lower(
+            props.string("storage_format", "float32"));
+        if (storage_format == "float16")
+            m_half_storage = true;
+        else if (storage_format == "float32")
+            m_half_storage = false;
+        else
+            Throw("The \"storage_format\" parameter must either be "
+                  "equal to \"float16\" or \"float32\"."
+                  " Found %s instead.", storage_format);
+
+        if (m_half_storage && !dr::is_jit_v<Float>) {
+            Log(Warn, "Half-precision film storage is only supported in JIT "
+                      "variants. Overriding..");
+            m_half_storage = false;
+        }
+        if (m_half_storage && m_compensate)
+            Throw("storage_format=\"float16\" cannot be combined with "
+                  "error-compensated accumulation (compensate=true)!");
+        if (m_half_storage && m_sample_border)
+            Throw("storage_format=\"float16\" cannot be combined with "
+                  "sample_border=true, since the film storage then only "
+                  "accepts full-frame merges!");
+
+        m_firefly_clamp = props.get<ScalarFloat>("firefly_clamp", 0.f);
+        if (m_firefly_clamp < 0.f)
+            Throw("firefly_clamp must be non-negative!");
+        m_firefly_aov = props.get<bool>("firefly_aov", false);
+        if (m_firefly_aov && m_firefly_clamp == 0.f)
+            Throw("firefly_aov requires a positive firefly_clamp value!");
+
+        std::string display_server = props.string("display_server", "");
+        if (!display_server.empty()) {
+            std::string hostname = display_server;
+            uint16_t port = 14158;
+
+            size_t split = display_server.rfind(':');
+            if (split != std::string::npos) {
+                hostname = display_server.substr(0, split);
+                port = (uint16_t) std::stoul(display_server.substr(split + 1));
+            }
+
+            m_tev = new TevClient(hostname, port);
+
+            // Distinguish multiple films/processes streaming to one viewer
+            static std::atomic<uint32_t> display_counter { 0 };
+            m_display_name =
+                "Mitsuba [" + std::to_string(display_counter++) + "]";
+        }
+
         props.mark_queried("banner"); // no banner in Mitsuba 3
     }
 
@@ -244,10 +338,16 @@ public:
         for (size_t i = 0; i < aovs.size(); ++i)
             channels[base_channels + i] = aovs[i];
 
+        // Extra channel holding the energy removed by the firefly clamp
+        if (m_firefly_aov)
+            channels.push_back("clamped");
+
         /* locked */ {
             std::lock_guard<std::mutex> lock(m_mutex);
             m_storage = new ImageBlock(m_crop_size, m_crop_offset,
                                        (uint32_t) channels.size());
+            if (m_half_storage)
+                m_storage->set_half_precision(true);
             m_channels = channels;
         }
 
@@ -256,6 +356,18 @@ public:
         if (it != channels.end())
             Throw("Film::prepare(): duplicate channel name \"%s\"", *it);
 
+        if (m_tev) {
+            // Stream every channel except the sample weight accumulator
+            uint32_t weight_idx = (uint32_t) base_channels - 1;
+            m_display_channels.clear();
+            for (uint32_t i = 0; i < (uint32_t) m_channels.size(); ++i) {
+                if (i != weight_idx)
+                    m_display_channels.push_back(m_channels[i]);
+            }
+            m_tev->create_image(m_display_name, m_crop_size.x(),
+                                m_crop_size.y(), m_display_channels);
+        }
+
         return m_channels.size();
     }
 
@@ -266,21 +378,108 @@ public:
 
         bool default_config = size == ScalarVector2u(0);
 
-        return new ImageBlock(default_config ? m_crop_size : size,
-                              default_config ? m_crop_offset : ScalarPoint2u(0),
-                              (uint32_t) m_channels.size(), m_filter.get(),
-                              border /* border */,
-                              normalize /* normalize */,
-                              dr::is_jit_v<Float> /* coalesce */,
-                              m_compensate /* compensate */,
-                              warn /* warn_negative */,
-                              warn /* warn_invalid */);
+        ref<ImageBlock> block =
+            new ImageBlock(default_config ? m_crop_size : size,
+                           default_config ? m_crop_offset : ScalarPoint2u(0),
+                           (uint32_t) m_channels.size(), m_filter.get(),
+                           border /* border */,
+                           normalize /* normalize */,
+                           dr::is_jit_v<Float> /* coalesce */,
+                           m_compensate /* compensate */,
+                           warn /* warn_negative */,
+                           warn /* warn_invalid */);
+
+        if (m_firefly_clamp > 0.f)
+            block->set_outlier_clamp(
+                m_firefly_clamp, 3 /* RGB */,
+                m_firefly_aov ? (uint32_t) m_channels.size() - 1
+                              : (uint32_t) -1);
+
+        return block;
     }
 
     void put_block(const ImageBlock *block) override {
         Assert(m_storage != nullptr);
+
+        if constexpr (!dr::is_jit_v<Float>) {
+            /* Scalar parallel rendering: merge lock-free via per-channel
+               atomic additions. Concurrent blocks only overlap within the
+               reconstruction filter border of their neighbors, but full
+               serialization on m_mutex was a visible bottleneck at high
+               thread counts and small block sizes. */
+            m_storage->put_block(block, /* atomic = */ true);
+
+            if (m_tev && m_tev->connected()) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                send_display_update(block);
+            }
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_storage->put_block(block);
+
+            if (m_tev && m_tev->connected())
+                send_display_update(block);
+        }
+    }
+
+    /**
+     * Stream the film region covered by \c block (which was just merged
+     * into \c m_storage) to the connected tev instance. The caller must
+     * hold \c m_mutex. Only a weight-normalized copy of the touched tile
+     * is made here; the socket I/O happens on the client's own thread.
+     */
+    void send_display_update(const ImageBlock *block) {
+        // Intersect the block (border excluded) with the crop window
+        ScalarPoint2i lo = dr::maximum(
+            block->offset() - ScalarPoint2i(m_crop_offset), 0);
+        ScalarPoint2i hi = dr::minimum(
+            block->offset() + ScalarVector2i(block->size()) -
+                ScalarPoint2i(m_crop_offset),
+            ScalarPoint2i(m_crop_size));
+
+        if (dr::any(hi <= lo))
+            return;
+
+        auto &&data = dr::migrate(m_storage->tensor().array(), AllocType::Host);
+
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        const ScalarFloat *ptr = data.data();
+
+        uint32_t width      = (uint32_t) (hi.x() - lo.x()),
+                 height     = (uint32_t) (hi.y() - lo.y()),
+                 ch         = (uint32_t) m_channels.size(),
+                 weight_idx = has_flag(m_flags, FilmFlags::Alpha) ? 4u : 3u;
+
+        std::unique_ptr<float[]> buf(
+            new float[(size_t) width * height * (ch - 1)]);
+        float *dst = buf.get();
+
+        for (uint32_t y = 0; y < height; ++y) {
+            const ScalarFloat *p =
+                ptr + (((size_t) y + lo.y()) * m_crop_size.x() + lo.x()) * ch;
+            for (uint32_t x = 0; x < width; ++x) {
+                ScalarFloat weight = p[weight_idx],
+                            scale  = weight == 0.f ? 1.f : 1.f / weight;
+                for (uint32_t c = 0; c < ch; ++c) {
+                    if (c != weight_idx)
+                        *dst++ = (float) (p[c] * scale);
+                }
+                p += ch;
+            }
+        }
+
+        m_tev->update_image(m_display_name, (uint32_t) lo.x(),
+                            (uint32_t) lo.y(), width, height,
+                            m_display_channels, buf.get());
+    }
+
+    void clear_region(const ScalarPoint2u &offset,
+                      const ScalarVector2u &size) override {
+        Assert(m_storage != nullptr);
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_storage->put_block(block);
+        m_storage->clear_region(offset, size);
     }
 
     void clear() override {
@@ -288,6 +487,59 @@ public:
             m_storage->clear();
     }
 
+    void save_state(Stream *stream) const override {
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+        if (m_storage->half_precision())
+            Throw("save_state(): unsupported in combination with "
+                  "half-precision film storage.");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &&data = dr::migrate(m_storage->tensor().array(), AllocType::Host);
+
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        uint64_t count = (uint64_t) data.size();
+        stream->write((uint32_t) m_crop_size.x());
+        stream->write((uint32_t) m_crop_size.y());
+        stream->write((uint32_t) m_channels.size());
+        stream->write(count);
+        stream->write_array(data.data(), (size_t) count);
+    }
+
+    void load_state(Stream *stream) override {
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+        if (m_storage->half_precision())
+            Throw("load_state(): unsupported in combination with "
+                  "half-precision film storage.");
+
+        uint32_t size_x, size_y, channels;
+        uint64_t count;
+        stream->read(size_x);
+        stream->read(size_y);
+        stream->read(channels);
+        stream->read(count);
+
+        if (size_x != m_crop_size.x() || size_y != m_crop_size.y() ||
+            channels != (uint32_t) m_channels.size() ||
+            count != (uint64_t) size_x * size_y * channels)
+            Throw("load_state(): the serialized film state (%ux%u pixels, %u "
+                  "channels) is incompatible with the current film "
+                  "configuration (%ux%u pixels, %zu channels)!",
+                  size_x, size_y, channels, m_crop_size.x(), m_crop_size.y(),
+                  m_channels.size());
+
+        std::unique_ptr<ScalarFloat[]> data(new ScalarFloat[count]);
+        stream->read_array(data.get(), (size_t) count);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_storage->tensor().array() =
+            dr::load<DynamicBuffer<Float>>(data.get(), (size_t) count);
+    }
+
     TensorXf develop(bool raw = false) const override {
         if (!m_storage)
             Throw("No storage allocated, was prepare() called first?");
@@ -321,44 +573,12 @@ public:
             bool to_y      = m_pixel_format == Bitmap::PixelFormat::Y ||
                              m_pixel_format == Bitmap::PixelFormat::YA;
 
-            // Number of arbitrary output variables (AOVs)
-            bool alpha = has_flag(m_flags, FilmFlags::Alpha);
-            uint32_t base_ch = alpha ? 5 : 4,
-                     aovs    = source_ch - base_ch;
-
-            /// Number of desired color components
-            uint32_t color_ch = to_y ? 1 : 3;
-
-            // Number of channels of the target tensor
-            uint32_t target_ch = color_ch + aovs + (uint32_t) alpha;
-
             // Index vectors referencing pixels & channels of the output image
-            UInt32 idx         = dr::arange<UInt32>(pixel_count * target_ch),
-                   pixel_idx   = idx / target_ch,
-                   channel_idx = dr::fmadd(pixel_idx, uint32_t(-(int) target_ch), idx);
-
-            /* Index vectors referencing source pixels/weights as follows:
-                 values_idx = R1, G1, B1, R2, G2, B2 (for RGB output)
-                 weight_idx = W1, W1, W1, W2, W2, W2 */
-            UInt32 values_idx = dr::fmadd(pixel_idx, source_ch, channel_idx),
-                   weight_idx = dr::fmadd(pixel_idx, source_ch, base_ch - 1);
-
-            // If AOVs are desired, their indices in 'values_idx' must be shifted
-            if (aovs) {
-                // Index of first AOV channel in output image
-                uint32_t first_aov = color_ch + (uint32_t) alpha;
-                values_idx[channel_idx >= first_aov] += base_ch - first_aov;
-            }
-
-            // If luminance + alpha, shift alpha channel to skip the GB channels
-            if (alpha && to_y)
-                values_idx[dr::eq(channel_idx, color_ch /* alpha */)] += 2;
-
-            Mask value_mask = true;
-
-            // XYZ/Y mode: don't gather color, will be computed below
-            if (to_xyz || to_y)
-                value_mask = channel_idx >= color_ch;
+            UInt32 values_idx, weight_idx;
+            Mask value_mask;
+            uint32_t target_ch = develop_indices(pixel_count, source_ch,
+                                                 values_idx, weight_idx,
+                                                 value_mask);
 
             // Gather the pixel values from the image data buffer
             Float weight = dr::gather<Float>(data, weight_idx),
@@ -404,6 +624,168 @@ public:
         }
     }
 
+    TensorXf develop_fast() const override {
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+
+        if constexpr (dr::is_jit_v<Float>) {
+            Float data;
+            uint32_t source_ch, pixel_count, target_ch;
+            ScalarVector2i size;
+            UInt32 values_idx, weight_idx;
+            Mask value_mask;
+
+            /* locked */ {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                /* The preview never needs derivatives: drop the AD graph
+                   of the film storage before developing it */
+                data        = dr::detach(m_storage->tensor().array());
+                size        = m_storage->size();
+                source_ch   = (uint32_t) m_storage->channel_count();
+                pixel_count = dr::prod(m_storage->size());
+
+                /* The gather tables only depend on the film configuration;
+                   build and evaluate them once, then reuse them across
+                   progressive passes */
+                if (m_fast_pixel_count != pixel_count ||
+                    m_fast_source_ch != source_ch) {
+                    m_fast_target_ch = develop_indices(
+                        pixel_count, source_ch, m_fast_values_idx,
+                        m_fast_weight_idx, m_fast_value_mask);
+                    dr::eval(m_fast_values_idx, m_fast_weight_idx,
+                             m_fast_value_mask);
+                    m_fast_pixel_count = pixel_count;
+                    m_fast_source_ch   = source_ch;
+                }
+
+                target_ch  = m_fast_target_ch;
+                values_idx = m_fast_values_idx;
+                weight_idx = m_fast_weight_idx;
+                value_mask = m_fast_value_mask;
+            }
+
+            // Gather the pixel values from the image data buffer
+            Float weight = dr::gather<Float>(data, weight_idx),
+                  values = dr::gather<Float>(data, values_idx, value_mask);
+
+            bool to_xyz = m_pixel_format == Bitmap::PixelFormat::XYZ ||
+                          m_pixel_format == Bitmap::PixelFormat::XYZA;
+            bool to_y   = m_pixel_format == Bitmap::PixelFormat::Y ||
+                          m_pixel_format == Bitmap::PixelFormat::YA;
+
+            // Fill color channels with XYZ/Y data if requested
+            if (to_xyz || to_y) {
+                UInt32 in_idx  = dr::arange<UInt32>(pixel_count) * source_ch,
+                       out_idx = dr::arange<UInt32>(pixel_count) * target_ch;
+
+                Color3f rgb = Color3f(dr::gather<Float>(data, in_idx),
+                                      dr::gather<Float>(data, in_idx + 1),
+                                      dr::gather<Float>(data, in_idx + 2));
+
+                if (to_y) {
+                    dr::scatter(values, luminance(rgb), out_idx);
+                } else {
+                    Color3f xyz = srgb_to_xyz(rgb);
+                    dr::scatter(values, xyz[0], out_idx);
+                    dr::scatter(values, xyz[1], out_idx + 1);
+                    dr::scatter(values, xyz[2], out_idx + 2);
+                }
+            }
+
+            // Perform the weight division unless the weight is zero
+            values /= dr::select(dr::eq(weight, 0.f), 1.f, weight);
+
+            // Launch the fused normalization kernel right away
+            dr::eval(values);
+
+            size_t shape[3] = { (size_t) size.y(), (size_t) size.x(),
+                                target_ch };
+
+            return TensorXf(values, 3, shape);
+        } else {
+            // The scalar storage carries no AD graph to begin with
+            return develop();
+        }
+    }
+
+    void develop_preview(uint8_t *buf, ScalarFloat exposure = 0.f) const override {
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+
+        bool alpha = has_flag(m_flags, FilmFlags::Alpha);
+        uint32_t base_ch = alpha ? 5u : 4u;
+        ScalarFloat scale = dr::exp2(exposure);
+
+        if constexpr (dr::is_jit_v<Float>) {
+            Float data;
+            uint32_t source_ch, pixel_count;
+
+            /* locked */ {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                data        = m_storage->tensor().array();
+                source_ch   = (uint32_t) m_storage->channel_count();
+                pixel_count = dr::prod(m_storage->size());
+            }
+
+            /* Weight division, exposure and sRGB encoding all fuse into a
+               single kernel that directly produces packed RGBA8 pixels */
+            UInt32 base   = dr::arange<UInt32>(pixel_count) * source_ch;
+            Float  weight = dr::gather<Float>(data, base + (base_ch - 1)),
+                   rcp_w  = dr::select(dr::eq(weight, 0.f), 1.f, dr::rcp(weight)),
+                   factor = rcp_w * scale;
+
+            auto encode = [](Float value) {
+                return UInt32(dr::clamp(
+                    dr::linear_to_srgb(value) * 255.f + .5f, 0.f, 255.f));
+            };
+
+            UInt32 packed =
+                encode(dr::gather<Float>(data, base) * factor) |
+                (encode(dr::gather<Float>(data, base + 1) * factor) << 8) |
+                (encode(dr::gather<Float>(data, base + 2) * factor) << 16);
+
+            if (alpha) {
+                Float a = dr::gather<Float>(data, base + 3) * rcp_w;
+                packed |= UInt32(dr::clamp(a * 255.f + .5f, 0.f, 255.f)) << 24;
+            } else {
+                packed |= 0xff000000u;
+            }
+
+            auto &&result = dr::migrate(packed, AllocType::Host);
+            dr::sync_thread();
+            memcpy(buf, result.data(), pixel_count * sizeof(uint32_t));
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const ScalarFloat *data = m_storage->tensor().array().data();
+            uint32_t source_ch   = (uint32_t) m_storage->channel_count(),
+                     pixel_count = dr::prod(m_storage->size());
+
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, pixel_count, 4096),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                    for (uint32_t i = range.begin(); i != range.end(); ++i) {
+                        const ScalarFloat *p = data + (size_t) i * source_ch;
+                        ScalarFloat weight = p[base_ch - 1],
+                                    rcp_w  = weight == 0.f ? 1.f : 1.f / weight,
+                                    factor = rcp_w * scale;
+
+                        uint8_t *dst = buf + (size_t) i * 4;
+                        for (uint32_t c = 0; c < 3; ++c)
+                            dst[c] = (uint8_t) dr::clamp(
+                                dr::linear_to_srgb(p[c] * factor) * 255.f + .5f,
+                                0.f, 255.f);
+                        dst[3] = alpha
+                            ? (uint8_t) dr::clamp(p[3] * rcp_w * 255.f + .5f,
+                                                  0.f, 255.f)
+                            : (uint8_t) 255;
+                    }
+                }
+            );
+        }
+    }
+
     ref<Bitmap> bitmap(bool raw = false) const override {
         if (!m_storage)
             Throw("No storage allocated, was prepare() called first?");
@@ -430,6 +812,22 @@ public:
         if (raw)
             return source;
 
+        return convert_storage(source);
+    }
+
+    /**
+     * \brief Develop a raw view of the film storage into the configured
+     * output pixel format
+     *
+     * This hosts the conversion step shared by \ref bitmap() and \ref
+     * write_streaming(): \c source may reference the full film storage or
+     * only a band of its scanlines.
+     */
+    ref<Bitmap> convert_storage(Bitmap *source) const {
+        bool alpha = has_flag(m_flags, FilmFlags::Alpha);
+        uint32_t base_ch = alpha ? 5 : 4;
+        bool has_aovs  = m_channels.size() != base_ch;
+
         bool to_rgb    = m_pixel_format == Bitmap::PixelFormat::RGB ||
                          m_pixel_format == Bitmap::PixelFormat::RGBA;
         bool to_xyz    = m_pixel_format == Bitmap::PixelFormat::XYZ ||
@@ -440,11 +838,11 @@ public:
         uint32_t img_ch = to_y ? 1 : 3;
         uint32_t aovs_channel = has_aovs ? (img_ch + (uint32_t) alpha) : 0;
         uint32_t target_ch =
-            (uint32_t) m_storage->channel_count() - base_ch + aovs_channel;
+            (uint32_t) source->channel_count() - base_ch + aovs_channel;
 
         ref<Bitmap> target = new Bitmap(
             has_aovs ? Bitmap::PixelFormat::MultiChannel : m_pixel_format,
-            struct_type_v<ScalarFloat>, m_storage->size(),
+            struct_type_v<ScalarFloat>, source->size(),
             has_aovs ? target_ch : 0);
 
         if (has_aovs) {
@@ -571,6 +969,169 @@ public:
         }
     }
 
+    void write_async(const fs::path &path) const override {
+        fs::path filename = path;
+        std::string proper_extension;
+        if (m_file_format == Bitmap::FileFormat::OpenEXR)
+            proper_extension = ".exr";
+        else if (m_file_format == Bitmap::FileFormat::RGBE)
+            proper_extension = ".rgbe";
+        else
+            proper_extension = ".pfm";
+
+        std::string extension = string::to_lower(filename.extension().string());
+        if (extension != proper_extension)
+            filename.replace_extension(proper_extension);
+
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+
+        #if !defined(_WIN32)
+            Log(Info, "\U00002714  Developing \"%s\" (async) ..", filename.string());
+        #else
+            Log(Info, "Developing \"%s\" (async) ..", filename.string());
+        #endif
+
+        /* Snapshot the film storage into a bitmap that owns its pixel
+           buffer. This is the only synchronous part: subsequent render
+           passes may freely overwrite m_storage while the background task
+           develops and encodes the copy. */
+        ref<Bitmap> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto &&storage = dr::migrate(m_storage->tensor().array(),
+                                         AllocType::Host);
+
+            if constexpr (dr::is_jit_v<Float>)
+                dr::sync_thread();
+
+            bool alpha = has_flag(m_flags, FilmFlags::Alpha);
+            uint32_t base_ch = alpha ? 5 : 4;
+            bool has_aovs  = m_channels.size() != base_ch;
+
+            Bitmap::PixelFormat source_fmt = !has_aovs
+                                         ? (alpha ? Bitmap::PixelFormat::RGBAW
+                                                  : Bitmap::PixelFormat::RGBW)
+                                         : Bitmap::PixelFormat::MultiChannel;
+
+            snapshot = new Bitmap(source_fmt, struct_type_v<ScalarFloat>,
+                                  m_storage->size(),
+                                  m_storage->channel_count(), m_channels);
+            memcpy(snapshot->data(), storage.data(), snapshot->buffer_size());
+        }
+
+        /* Development, conversion and encoding run on the thread pool;
+           Thread::wait_for_tasks() joins all pending writes. */
+        this->inc_ref();
+        Task *task = dr::do_async([this, snapshot, filename,
+                                   env = ThreadEnvironment()]() {
+            ScopedSetThreadEnvironment set_env(env);
+            ref<Bitmap> source = convert_storage(snapshot);
+            if (m_component_format != struct_type_v<ScalarFloat>) {
+                std::vector<std::string> channel_names;
+                for (size_t i = 0; i < source->channel_count(); i++)
+                    channel_names.push_back(source->struct_()->operator[](i).name);
+                ref<Bitmap> target = new Bitmap(
+                    source->pixel_format(),
+                    m_component_format,
+                    source->size(),
+                    source->channel_count(),
+                    channel_names);
+                source->convert(target);
+
+                target->write(filename, m_file_format);
+            } else {
+                source->write(filename, m_file_format);
+            }
+            this->dec_ref();
+        });
+        Thread::register_task(task);
+    }
+
+    void write_streaming(const fs::path &path,
+                         uint32_t band_height = 0) const override {
+        if (m_file_format != Bitmap::FileFormat::OpenEXR) {
+            Log(Warn, "write_streaming(): only the OpenEXR format supports "
+                      "incremental encoding, falling back to write().");
+            write(path);
+            return;
+        }
+
+        if (!m_storage)
+            Throw("No storage allocated, was prepare() called first?");
+
+        fs::path filename = path;
+        std::string extension = string::to_lower(filename.extension().string());
+        if (extension != ".exr")
+            filename.replace_extension(".exr");
+
+        #if !defined(_WIN32)
+            Log(Info, "\U00002714  Developing \"%s\" (streaming) ..",
+                filename.string());
+        #else
+            Log(Info, "Developing \"%s\" (streaming) ..", filename.string());
+        #endif
+
+        /* Process bands matching the granularity of the image blocks used
+           during rendering unless the caller requested otherwise */
+        if (band_height == 0)
+            band_height = MI_BLOCK_SIZE;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto &&storage = dr::migrate(m_storage->tensor().array(), AllocType::Host);
+
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        bool alpha = has_flag(m_flags, FilmFlags::Alpha);
+        uint32_t base_ch = alpha ? 5 : 4;
+        bool has_aovs  = m_channels.size() != base_ch;
+
+        Bitmap::PixelFormat source_fmt = !has_aovs
+                                     ? (alpha ? Bitmap::PixelFormat::RGBAW
+                                              : Bitmap::PixelFormat::RGBW)
+                                     : Bitmap::PixelFormat::MultiChannel;
+
+        ScalarVector2u size = m_storage->size();
+        uint32_t ch = (uint32_t) m_storage->channel_count();
+        const ScalarFloat *ptr = storage.data();
+
+        ref<FileStream> stream =
+            new FileStream(filename, FileStream::ETruncReadWrite);
+        ref<StreamingEXRWriter> writer;
+
+        for (uint32_t y = 0; y < size.y(); y += band_height) {
+            uint32_t rows = std::min(band_height, size.y() - y);
+
+            /* Wrap the scanlines of this band without copying them */
+            ref<Bitmap> source = new Bitmap(
+                source_fmt, struct_type_v<ScalarFloat>,
+                ScalarVector2u(size.x(), rows), ch, m_channels,
+                (uint8_t *) (ptr + (size_t) y * size.x() * ch));
+
+            ref<Bitmap> band = convert_storage(source);
+
+            if (m_component_format != struct_type_v<ScalarFloat>) {
+                std::vector<std::string> channel_names;
+                for (size_t i = 0; i < band->channel_count(); i++)
+                    channel_names.push_back(band->struct_()->operator[](i).name);
+                ref<Bitmap> converted = new Bitmap(
+                    band->pixel_format(),
+                    m_component_format,
+                    band->size(),
+                    band->channel_count(),
+                    channel_names);
+                band->convert(converted);
+                band = converted;
+            }
+
+            if (!writer)
+                writer = new StreamingEXRWriter(stream, size, band);
+
+            writer->write(band);
+        }
+    }
+
     void schedule_storage() override {
         dr::schedule(m_storage->tensor());
     };
@@ -583,6 +1144,7 @@ public:
             << "  crop_offset = " << m_crop_offset << "," << std::endl
             << "  sample_border = " << m_sample_border << "," << std::endl
             << "  compensate = " << m_compensate << "," << std::endl
+            << "  firefly_clamp = " << m_firefly_clamp << "," << std::endl
             << "  filter = " << m_filter << "," << std::endl
             << "  file_format = " << m_file_format << "," << std::endl
             << "  pixel_format = " << m_pixel_format << "," << std::endl
@@ -593,13 +1155,84 @@ public:
 
     MI_DECLARE_CLASS()
 protected:
+    /**
+     * \brief Build the index vectors used to gather weighted image block
+     * data into the channel layout produced by \ref develop()
+     *
+     * The resulting vectors reference source pixels/weights as follows:
+     * <tt>values_idx = R1, G1, B1, R2, G2, B2</tt> (for RGB output) and
+     * <tt>weight_idx = W1, W1, W1, W2, W2, W2</tt>. In XYZ/Y mode,
+     * \c value_mask disables the color gathers, whose entries are instead
+     * computed from the RGB data by the caller. Returns the channel count
+     * of the target tensor.
+     */
+    uint32_t develop_indices(uint32_t pixel_count, uint32_t source_ch,
+                             UInt32 &values_idx, UInt32 &weight_idx,
+                             Mask &value_mask) const {
+        // Determine what channels are needed
+        bool to_xyz    = m_pixel_format == Bitmap::PixelFormat::XYZ ||
+                         m_pixel_format == Bitmap::PixelFormat::XYZA;
+        bool to_y      = m_pixel_format == Bitmap::PixelFormat::Y ||
+                         m_pixel_format == Bitmap::PixelFormat::YA;
+
+        // Number of arbitrary output variables (AOVs)
+        bool alpha = has_flag(m_flags, FilmFlags::Alpha);
+        uint32_t base_ch = alpha ? 5 : 4,
+                 aovs    = source_ch - base_ch;
+
+        /// Number of desired color components
+        uint32_t color_ch = to_y ? 1 : 3;
+
+        // Number of channels of the target tensor
+        uint32_t target_ch = color_ch + aovs + (uint32_t) alpha;
+
+        // Index vectors referencing pixels & channels of the output image
+        UInt32 idx         = dr::arange<UInt32>(pixel_count * target_ch),
+               pixel_idx   = idx / target_ch,
+               channel_idx = dr::fmadd(pixel_idx, uint32_t(-(int) target_ch), idx);
+
+        values_idx = dr::fmadd(pixel_idx, source_ch, channel_idx);
+        weight_idx = dr::fmadd(pixel_idx, source_ch, base_ch - 1);
+
+        // If AOVs are desired, their indices in 'values_idx' must be shifted
+        if (aovs) {
+            // Index of first AOV channel in output image
+            uint32_t first_aov = color_ch + (uint32_t) alpha;
+            values_idx[channel_idx >= first_aov] += base_ch - first_aov;
+        }
+
+        // If luminance + alpha, shift alpha channel to skip the GB channels
+        if (alpha && to_y)
+            values_idx[dr::eq(channel_idx, color_ch /* alpha */)] += 2;
+
+        value_mask = true;
+
+        // XYZ/Y mode: don't gather color, will be computed below
+        if (to_xyz || to_y)
+            value_mask = channel_idx >= color_ch;
+
+        return target_ch;
+    }
+
     Bitmap::FileFormat m_file_format;
     Bitmap::PixelFormat m_pixel_format;
     Struct::Type m_component_format;
     bool m_compensate;
+    bool m_half_storage;
+    ScalarFloat m_firefly_clamp;
+    bool m_firefly_aov;
     ref<ImageBlock> m_storage;
     mutable std::mutex m_mutex;
     std::vector<std::string> m_channels;
+    ref<TevClient> m_tev;
+    std::string m_display_name;
+    std::vector<std::string> m_display_channels;
+
+    /// Gather tables reused by develop_fast() across progressive passes
+    mutable UInt32 m_fast_values_idx, m_fast_weight_idx;
+    mutable Mask m_fast_value_mask;
+    mutable uint32_t m_fast_target_ch = 0, m_fast_pixel_count = 0,
+                     m_fast_source_ch = 0;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(HDRFilm, Film)
@@ -215,13 +215,37 @@ public:
         SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
         si.wavelengths = mis_wavelengths;
 
+        /* Tabulate every response function on the shared regular grid while
+           computing the sampling distribution. prepare_sample() later bins
+           samples with a lookup into these tables instead of evaluating each
+           response texture per channel. */
+        m_srf_table.clear();
+        m_srf_table.reserve(m_srfs.size());
+
         for (auto srf : m_srfs) {
-            UnpolarizedSpectrum values = srf->eval(si);
-            // Each wavelength is duplicated with the size of the Spectrum
-            // (default constructor while initialized with only a number)
-            mis_data += values.x();
+            FloatStorage response;
+            if constexpr (dr::is_jit_v<Float>) {
+                // Each wavelength is duplicated with the size of the Spectrum
+                // (default constructor while initialized with only a number)
+                response = srf->eval(si).x();
+            } else {
+                std::unique_ptr<ScalarFloat[]> buf(new ScalarFloat[n_points]);
+                for (size_t i = 0; i < n_points; ++i) {
+                    si.wavelengths = dr::lerp(m_range.x(), m_range.y(),
+                                              i / ScalarFloat(n_points - 1));
+                    buf[i] = srf->eval(si).x();
+                }
+                response = dr::load<FloatStorage>(buf.get(), n_points);
+            }
+            mis_data += response;
+            m_srf_table.push_back(response);
         }
 
+        m_table_size  = (uint32_t) n_points;
+        m_table_scale = ScalarFloat(n_points - 1) / (m_range.y() - m_range.x());
+        for (auto &entry : m_srf_table)
+            dr::make_opaque(entry);
+
         // Conversion needed because Properties::Float is always double
         using DoubleStorage = dr::float64_array_t<FloatStorage>;
         DoubleStorage mis_data_dbl = DoubleStorage(mis_data);
@@ -288,12 +312,30 @@ public:
         inv_spec = dr::select(dr::neq(inv_spec, 0.f), dr::rcp(inv_spec), 1.f);
         UnpolarizedSpectrum values = spec * inv_spec;
 
+        /* All response functions are tabulated on a shared regular grid (see
+           compute_srf_sampling()), so binning reduces to a gather + fmadd
+           per channel instead of a texture evaluation */
+        using UInt32W = dr::uint32_array_t<Wavelength>;
+
+        Wavelength t = (wavelengths - m_range.x()) * m_table_scale;
+        auto valid   = t >= 0.f && t <= ScalarFloat(m_table_size - 1);
+        t = dr::clamp(t, 0.f, ScalarFloat(m_table_size - 1));
+
+        Wavelength t0   = dr::floor(t),
+                   frac = t - t0;
+        UInt32W idx0 = UInt32W(t0),
+                idx1 = dr::minimum(idx0 + 1u, m_table_size - 1);
+
         for (size_t j = 0; j < m_srfs.size(); ++j) {
-            UnpolarizedSpectrum weights = m_srfs[j]->eval(si);
+            const FloatStorage &table = m_srf_table[j];
             aovs[j] = dr::zeros<Float>();
 
-            for (size_t i = 0; i<Spectrum::Size; ++i)
-                aovs[j] = dr::fmadd(weights[i], values[i], aovs[j]);
+            for (size_t i = 0; i < Spectrum::Size; ++i) {
+                Float w0 = dr::gather<Float>(table, idx0[i], valid[i]),
+                      w1 = dr::gather<Float>(table, idx1[i], valid[i]),
+                      w  = dr::fmadd(w1 - w0, frac[i], w0);
+                aovs[j] = dr::fmadd(w, values[i], aovs[j]);
+            }
 
             aovs[j] *= 1.f / Spectrum::Size;
         }
@@ -301,10 +343,23 @@ public:
 
     void put_block(const ImageBlock *block) override {
         Assert(m_storage != nullptr);
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_storage->put_block(block);
+
+        if constexpr (!dr::is_jit_v<Float>) {
+            // Lock-free merge via atomic additions (see hdrfilm)
+            m_storage->put_block(block, /* atomic = */ true);
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_storage->put_block(block);
+        }
     }
     
+    void clear_region(const ScalarPoint2u &offset,
+                      const ScalarVector2u &size) override {
+        Assert(m_storage != nullptr);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_storage->clear_region(offset, size);
+    }
+
     void clear() override {
         if (m_storage)
             m_storage->clear();
@@ -478,6 +533,11 @@ protected:
     std::vector<ref<Texture>> m_srfs;
     std::vector<std::string> m_names;
     ScalarVector2f m_range { dr::Infinity<ScalarFloat>, -dr::Infinity<ScalarFloat> };
+
+    /// Responses tabulated on a regular grid over \ref m_range (one per SRF)
+    std::vector<FloatStorage> m_srf_table;
+    uint32_t m_table_size = 0;
+    ScalarFloat m_table_scale = 0.f;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(SpecFilm, Film)
@@ -237,3 +237,272 @@ def test07_luminance_alpha_mono(variants_all):
     image = mi.TensorXf(film.bitmap())
 
     assert image.shape[2] == 2
+
+
+def test08_develop_preview(variants_all_rgb):
+    import numpy as np
+
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 2,
+        'height': 1,
+        'rfilter': {'type': 'box'}
+    })
+    film.prepare([])
+
+    block = film.create_block()
+    block.put([0.5, 0.5], [1.0, 1.0, 1.0, 1.0])  # pos, (R, G, B, weight)
+    block.put([1.5, 0.5], [0.0, 0.0, 0.0, 1.0])
+    film.put_block(block)
+
+    image = film.develop_preview()
+    assert image.shape == (1, 2, 4)
+
+    # White/black pixels map to the ends of the 8-bit range, alpha is opaque
+    assert np.all(image[0, 0] == [255, 255, 255, 255])
+    assert np.all(image[0, 1] == [0, 0, 0, 255])
+
+    # A positive exposure brightens mid grays
+    mid = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 1,
+        'height': 1,
+        'rfilter': {'type': 'box'}
+    })
+    mid.prepare([])
+    block = mid.create_block()
+    block.put([0.5, 0.5], [0.25, 0.25, 0.25, 1.0])
+    mid.put_block(block)
+
+    assert np.all(mid.develop_preview(exposure=1.0)[0, 0, :3] >
+                  mid.develop_preview()[0, 0, :3])
+
+
+def test09_statistics(variants_all_rgb):
+    import numpy as np
+
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 2,
+        'height': 2,
+        'rfilter': {'type': 'box'}
+    })
+    film.prepare([])
+
+    block = film.create_block()
+    block.put([0.5, 0.5], [0.2, 0.0, 0.0, 1.0])  # pos, (R, G, B, weight)
+    block.put([1.5, 0.5], [0.4, 0.0, 0.0, 1.0])
+    block.put([0.5, 1.5], [0.6, 0.0, 0.0, 1.0])
+    block.put([1.5, 1.5], [0.8, 0.0, 0.0, 1.0])
+    film.put_block(block)
+
+    stats = np.array(film.statistics())
+    assert stats.shape == (3, 3)
+
+    r = np.array([0.2, 0.4, 0.6, 0.8])
+    assert np.allclose(stats[0], [r.mean(), r.max(), r.var()], atol=1e-6)
+    assert np.allclose(stats[1], 0, atol=1e-6)
+
+    # Restrict the reduction to the second row of pixels
+    stats = np.array(film.statistics(offset=[0, 1]))
+    r = np.array([0.6, 0.8])
+    assert np.allclose(stats[0], [r.mean(), r.max(), r.var()], atol=1e-6)
+
+    with pytest.raises(RuntimeError, match='statistics'):
+        film.statistics(offset=[2, 0], size=[1, 1])
+
+
+def test10_develop_region(variants_all_rgb):
+    import numpy as np
+
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 2,
+        'height': 2,
+        'rfilter': {'type': 'box'}
+    })
+    film.prepare([])
+
+    block = film.create_block()
+    block.put([0.5, 0.5], [0.2, 0.1, 0.0, 1.0])  # pos, (R, G, B, weight)
+    block.put([1.5, 0.5], [0.4, 0.3, 0.0, 1.0])
+    block.put([0.5, 1.5], [0.6, 0.5, 0.0, 1.0])
+    block.put([1.5, 1.5], [0.8, 0.7, 0.0, 1.0])
+    film.put_block(block)
+
+    image = np.array(film.develop())
+
+    # Defaults return the full developed image
+    full = np.array(film.develop_region())
+    assert np.allclose(full, image, atol=1e-6)
+
+    # Crop rectangle
+    region = np.array(film.develop_region(offset=[1, 0], size=[1, 2]))
+    assert region.shape == (2, 1, 3)
+    assert np.allclose(region, image[:, 1:, :], atol=1e-6)
+
+    # Channel range
+    green = np.array(film.develop_region(channel_offset=1, channel_count=1))
+    assert green.shape == (2, 2, 1)
+    assert np.allclose(green, image[:, :, 1:2], atol=1e-6)
+
+    with pytest.raises(RuntimeError, match='develop_region'):
+        film.develop_region(channel_offset=2, channel_count=2)
+
+
+def test11_clear_region(variants_all_rgb):
+    import numpy as np
+
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 2,
+        'height': 2,
+        'rfilter': {'type': 'box'}
+    })
+    film.prepare([])
+
+    block = film.create_block()
+    block.put([0.5, 0.5], [0.2, 0.1, 0.0, 1.0])  # pos, (R, G, B, weight)
+    block.put([1.5, 0.5], [0.4, 0.3, 0.0, 1.0])
+    block.put([0.5, 1.5], [0.6, 0.5, 0.0, 1.0])
+    block.put([1.5, 1.5], [0.8, 0.7, 0.0, 1.0])
+    film.put_block(block)
+
+    image = np.array(film.develop())
+
+    # Zero out the first column of pixels, keeping the second one intact
+    film.clear_region([0, 0], [1, 2])
+
+    cleared = np.array(film.develop())
+    assert np.allclose(cleared[:, 0, :], 0, atol=1e-6)
+    assert np.allclose(cleared[:, 1, :], image[:, 1, :], atol=1e-6)
+
+    # The cleared pixels can accumulate fresh samples afterwards
+    block.clear()
+    block.put([0.5, 0.5], [0.9, 0.9, 0.9, 1.0])
+    film.put_block(block)
+
+    updated = np.array(film.develop())
+    assert np.allclose(updated[0, 0], [0.9, 0.9, 0.9], atol=1e-6)
+    assert np.allclose(updated[:, 1, :], image[:, 1, :], atol=1e-6)
+
+
+@pytest.mark.parametrize('pixel_format', ['rgb', 'luminance_alpha'])
+@pytest.mark.parametrize('has_aovs', [False, True])
+def test12_write_streaming(variants_all_rgb, pixel_format, has_aovs, tmpdir):
+    """
+    The streaming write path must produce the same OpenEXR image as the
+    regular one, including when the band height does not divide the image
+    height evenly.
+    """
+    import numpy as np
+
+    aovs_channels = ['aov.r', 'aov.g', 'aov.b'] if has_aovs else []
+
+    rng = np.random.default_rng(seed=12345)
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 17,
+        'height': 23,
+        'pixel_format': pixel_format,
+        'component_format': 'float16',
+        'filter': {'type': 'box'}
+    })
+
+    source_ch = 5 + len(aovs_channels)
+    contents = rng.uniform(size=(film.size()[1], film.size()[0], source_ch))
+    contents[:, :, 4] = 1.0  # Unit weights
+
+    block = mi.ImageBlock(film.size(), [0, 0], source_ch, film.rfilter())
+    for x in range(film.size()[1]):
+        for y in range(film.size()[0]):
+            block.put([y + 0.5, x + 0.5], contents[x, y, :])
+
+    film.prepare(aovs_channels)
+    film.put_block(block)
+
+    fname_ref = str(tmpdir.join('reference.exr'))
+    fname_streamed = str(tmpdir.join('streamed.exr'))
+    film.write(fname_ref)
+    film.write_streaming(fname_streamed, band_height=4)
+
+    ref = mi.Bitmap(fname_ref)
+    streamed = mi.Bitmap(fname_streamed)
+    assert dr.all(ref.size() == streamed.size())
+    assert ref.channel_count() == streamed.channel_count()
+    assert np.allclose(np.array(ref, copy=False),
+                       np.array(streamed, copy=False))
+
+
+def test13_half_storage(variants_vec_rgb):
+    import numpy as np
+
+    def render(storage_format):
+        scene_dict = mi.cornell_box()
+        scene_dict['sensor']['film'] = {
+            'type': 'hdrfilm',
+            'width': 16,
+            'height': 16,
+            'rfilter': {'type': 'box'},
+            'storage_format': storage_format
+        }
+        scene = mi.load_dict(scene_dict)
+        return np.array(mi.render(scene, seed=0, spp=16))
+
+    ref = render('float32')
+    half = render('float16')
+
+    # Identical up to the final round-to-half of the accumulated image
+    assert half.shape == ref.shape
+    assert dr.allclose(half, ref, rtol=1e-3, atol=1e-3)
+
+    # Invalid values and incompatible combinations are rejected
+    with pytest.raises(RuntimeError):
+        mi.load_dict({'type': 'hdrfilm', 'storage_format': 'uint8'})
+    with pytest.raises(RuntimeError):
+        mi.load_dict({'type': 'hdrfilm', 'storage_format': 'float16',
+                      'compensate': True})
+
+
+def test14_write_async(variants_all_rgb, tmpdir):
+    """
+    The asynchronous write path must produce the same OpenEXR image as the
+    regular one, even when the film storage is modified right after the
+    call returns.
+    """
+    import numpy as np
+
+    rng = np.random.default_rng(seed=54321)
+    film = mi.load_dict({
+        'type': 'hdrfilm',
+        'width': 13,
+        'height': 9,
+        'pixel_format': 'rgba',
+        'filter': {'type': 'box'}
+    })
+
+    contents = rng.uniform(size=(film.size()[1], film.size()[0], 5))
+    contents[:, :, 4] = 1.0  # Unit weights
+
+    block = mi.ImageBlock(film.size(), [0, 0], 5, film.rfilter())
+    for x in range(film.size()[1]):
+        for y in range(film.size()[0]):
+            block.put([y + 0.5, x + 0.5], contents[x, y, :])
+
+    film.prepare([])
+    film.put_block(block)
+
+    fname_ref = str(tmpdir.join('reference.exr'))
+    fname_async = str(tmpdir.join('async.exr'))
+    film.write(fname_ref)
+    film.write_async(fname_async)
+
+    # The snapshot must be unaffected by subsequent film updates
+    film.clear()
+    mi.Thread.wait_for_tasks()
+
+    ref = mi.Bitmap(fname_ref)
+    result = mi.Bitmap(fname_async)
+    assert dr.all(ref.size() == result.size())
+    assert np.allclose(np.array(ref, copy=False),
+                       np.array(result, copy=False))
@@ -21,7 +21,9 @@ Arbitrary Output Variables integrator (:monosp:`aov`)
  * - (Nested plugin)
    - :paramtype:`integrator`
    - Sub-integrators (can have more than one) which will be sampled along the AOV integrator. Their
-     respective output will be put into distinct images.
+     respective output will be put into distinct images. Sub-integrators are handed the primary ray
+     intersection that the AOV integrator already computed, so stacking e.g. a beauty, a depth and a
+     normal pass performs a single camera-ray scene traversal per sample rather than one per pass.
 
 
 This integrator returns one or more AOVs (Arbitrary Output Variables) describing the visible
@@ -203,9 +205,14 @@ public:
 
         std::pair<Spectrum, Mask> result { 0.f, false };
 
-        SurfaceInteraction3f si = scene->ray_intersect(
+        /* The single scene traversal below is shared with all nested
+           integrators via \ref sample_with_interaction() */
+        SurfaceInteraction3f si_raw = scene->ray_intersect(
             ray, RayFlags::All | RayFlags::BoundaryTest, true, active);
-        dr::masked(si, !si.is_valid()) = dr::zeros<SurfaceInteraction3f>();
+        Mask si_valid = active && si_raw.is_valid();
+
+        SurfaceInteraction3f si = si_raw;
+        dr::masked(si, !si_raw.is_valid()) = dr::zeros<SurfaceInteraction3f>();
         size_t ctr = 0;
 
         auto spectrum_to_color3f = [](const Spectrum& spec, const Ray3f& ray, Mask active) {
@@ -307,7 +314,9 @@ public:
 
                 case Type::IntegratorRGBA: {
                         std::pair<Spectrum, Mask> result_sub =
-                            m_integrators[ctr].first->sample(scene, sampler, ray, medium, aovs, active);
+                            m_integrators[ctr].first->sample_with_interaction(
+                                scene, sampler, ray, si_raw, si_valid, medium,
+                                aovs, active);
                         aovs += m_integrators[ctr].second;
                         Color3f rgb =
                             spectrum_to_color3f(result_sub.first, ray, active);
@@ -51,6 +51,22 @@ public:
         };
     }
 
+    std::pair<Spectrum, Mask> sample_with_interaction(
+            const Scene * /* scene */, Sampler * /* sampler */,
+            const RayDifferential3f & /* ray */,
+            const SurfaceInteraction3f &si, Mask si_valid,
+            const Medium * /* medium */, Float * /* aovs */,
+            Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
+
+        return {
+            dr::select(si_valid, si.t, 0.f),
+            si_valid
+        };
+    }
+
+    bool reuses_primary_interaction() const override { return true; }
+
     MI_DECLARE_CLASS()
 };
 
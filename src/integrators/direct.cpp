@@ -120,7 +120,30 @@ public:
         MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
 
         SurfaceInteraction3f si = scene->ray_intersect(
-            ray, +RayFlags::All, /* coherent = */ true, active);
+            ray, scene->minimal_ray_flags(), /* coherent = */ true, active);
+
+        return sample_impl(scene, sampler, ray, si, active);
+    }
+
+    std::pair<Spectrum, Mask> sample_with_interaction(
+            const Scene *scene, Sampler *sampler,
+            const RayDifferential3f &ray,
+            const SurfaceInteraction3f &si, Mask /* si_valid */,
+            const Medium * /* medium */, Float * /* aovs */,
+            Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
+
+        // Reuse the primary intersection computed by a wrapper integrator
+        return sample_impl(scene, sampler, ray, si, active);
+    }
+
+    bool reuses_primary_interaction() const override { return true; }
+
+    std::pair<Spectrum, Mask> sample_impl(const Scene *scene,
+                                          Sampler *sampler,
+                                          const RayDifferential3f &ray,
+                                          const SurfaceInteraction3f &si,
+                                          Mask active) const {
         Mask valid_ray = active && si.is_valid();
 
         Spectrum result(0.f);
@@ -179,8 +202,9 @@ public:
             Mask active_b = active && dr::any(dr::neq(unpolarized_spectrum(bsdf_val), 0.f));
 
             // Trace the ray in the sampled direction and intersect against the scene
+            Ray3f bsdf_ray = si.spawn_ray(si.to_world(bs.wo));
             SurfaceInteraction3f si_bsdf =
-                scene->ray_intersect(si.spawn_ray(si.to_world(bs.wo)), active_b);
+                scene->ray_intersect(bsdf_ray, active_b);
 
             // Retain only rays that hit an emitter
             EmitterPtr emitter = si_bsdf.emitter(scene, active_b);
@@ -191,8 +215,10 @@ public:
                 Mask delta = has_flag(bs.sampled_type, BSDFFlags::Delta);
 
                 /* Determine probability of having sampled that same
-                   direction using Emitter sampling. */
-                DirectionSample3f ds(scene, si_bsdf, si);
+                   direction using Emitter sampling. The ray-based record
+                   constructor reuses the direction and distance that the
+                   intersection above already computed. */
+                DirectionSample3f ds(scene, si_bsdf, bsdf_ray);
 
                 Float emitter_pdf =
                     dr::select(delta, 0.f, scene->pdf_emitter_direction(si, ds, active_b));
@@ -0,0 +1,582 @@
+#include <cstring>
+
+#include <mitsuba/core/math.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/ray.h>
+#include <mitsuba/core/warp.h>
+#include <mitsuba/render/bsdf.h>
+#include <mitsuba/render/emitter.h>
+#include <mitsuba/render/integrator.h>
+#include <mitsuba/render/records.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _integrator-guided:
+
+Guided path tracer (:monosp:`guided`)
+-------------------------------------
+
+.. pluginparameters::
+
+ * - max_depth
+   - |int|
+   - Specifies the longest path depth in the generated output image (where -1
+     corresponds to :math:`\infty`). (Default: -1)
+
+ * - rr_depth
+   - |int|
+   - Specifies the path depth, at which the implementation will begin to use
+     the *russian roulette* path termination criterion. (Default: 5)
+
+ * - hide_emitters
+   - |bool|
+   - Hide directly visible emitters. (Default: no, i.e. |false|)
+
+ * - training_spp
+   - |int|
+   - Number of samples per pixel spent on learning the guiding distribution
+     before the final rendering pass. The training budget is split into
+     passes of geometrically increasing size, and the distribution is
+     rebuilt after each pass so that later training passes are themselves
+     guided. Training samples do not contribute to the output image.
+     (Default: 32)
+
+ * - guide_fraction
+   - |float|
+   - Probability of drawing a scattering direction from the learned
+     distribution rather than from the BSDF at vertices where guiding
+     applies. The two strategies are combined with multiple importance
+     sampling, so any value in :math:`(0, 1)` is unbiased. (Default: 0.5)
+
+ * - guide_resolution
+   - |int|
+   - Number of spatial guiding cells along the largest extent of the scene
+     bounding box. (Default: 64)
+
+ * - guide_size
+   - |int|
+   - Number of entries in the guiding hash table, rounded up to the next
+     power of two. Collisions blend the distributions of unrelated cells,
+     so this should be generous relative to the occupied cell count.
+     (Default: 32768)
+
+This integrator implements a path tracer with *path guiding*: it learns an
+approximation of the incident illumination while rendering and uses it to
+importance sample scattering directions in combination with BSDF sampling.
+This is a separate plugin rather than an option of the :ref:`path
+<integrator-path>` integrator because guiding changes the sampling logic at
+every path vertex.
+
+The guiding structure is a hash grid over quantized world-space positions
+(mirroring the radiance cache of the path tracer), where each cell stores a
+directional histogram with 64 equal solid angle bins over the sphere. During
+the training passes, the histogram is populated online from the Monte Carlo
+estimates that the path tracer computes anyway: the contribution of every
+emitter sample and of every emitter found by a scattering ray is
+scatter-added into the bin containing its direction. Afterwards, each cell's
+histogram is normalized into a sampling distribution.
+
+At render time, vertices with a smooth BSDF and a trained cell draw their
+scattering direction from the BSDF with probability ``1 - guide_fraction``
+and from the cell's distribution otherwise; the one-sample estimator divides
+by the corresponding mixture density, which also enters the multiple
+importance sampling weights against emitter sampling. Untrained cells and
+delta BSDFs fall back to plain BSDF sampling, so the integrator degrades
+gracefully to the regular path tracer.
+
+The histogram is trained from *direct* illumination estimates (next-event
+estimation and emitters hit by scattering rays). This captures the dominant
+guiding signal in interiors lit through small openings, but unlike a full
+spatio-directional radiance field it does not learn purely indirect
+illumination; scenes dominated by multi-bounce transport benefit less.
+
+.. tabs::
+    .. code-tab:: xml
+        :name: guided-integrator
+
+        <integrator type="guided">
+            <integer name="max_depth" value="8"/>
+            <integer name="training_spp" value="64"/>
+        </integrator>
+
+    .. code-tab:: python
+
+        'type': 'guided',
+        'max_depth': 8,
+        'training_spp': 64
+
+ */
+
+template <typename Float, typename Spectrum>
+class GuidedPathIntegrator final : public MonteCarloIntegrator<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(MonteCarloIntegrator, should_stop, m_max_depth, m_rr_depth,
+                    m_hide_emitters)
+    MI_IMPORT_TYPES(Scene, Sensor, Sampler, Medium, Emitter, EmitterPtr, BSDF,
+                     BSDFPtr)
+
+    /// Directional resolution of each cell (equal solid angle bins)
+    static constexpr uint32_t GuideDirRes  = 8;
+    static constexpr uint32_t GuideDirBins = GuideDirRes * GuideDirRes;
+
+    GuidedPathIntegrator(const Properties &props) : Base(props) {
+        m_training_spp = props.get<uint32_t>("training_spp", 32);
+        m_guide_fraction = props.get<ScalarFloat>("guide_fraction", 0.5f);
+        if (m_guide_fraction <= 0.f || m_guide_fraction >= 1.f)
+            Throw("The 'guide_fraction' parameter must lie in (0, 1)!");
+
+        m_guide_size = math::round_to_power_of_two(
+            props.get<uint32_t>("guide_size", 1u << 15));
+        m_guide_resolution = props.get<uint32_t>("guide_resolution", 64);
+
+        size_t n = (size_t) m_guide_size * GuideDirBins;
+        m_guide_train = dr::zeros<DynamicBuffer<Float>>(n);
+        m_guide_pmf   = dr::zeros<DynamicBuffer<Float>>(n);
+        m_guide_cdf   = dr::zeros<DynamicBuffer<Float>>(n);
+        m_guide_total = dr::zeros<DynamicBuffer<Float>>(m_guide_size);
+    }
+
+    TensorXf render(Scene *scene,
+                    Sensor *sensor,
+                    uint32_t seed,
+                    uint32_t spp,
+                    bool develop,
+                    bool evaluate) override {
+        /* Training phase: render a geometrically growing sequence of passes
+           whose image is discarded, rebuilding the guiding distribution in
+           between so that later (larger) passes already benefit from the
+           earlier ones. The final pass below renders with a frozen
+           distribution and training disabled. */
+        if (m_training_spp > 0) {
+            m_guide_train = dr::zeros<DynamicBuffer<Float>>(
+                (size_t) m_guide_size * GuideDirBins);
+            m_guide_ready = false;
+            m_training = true;
+
+            uint32_t done = 0, pass_spp = 1, pass = 0;
+            while (done < m_training_spp && !should_stop()) {
+                pass_spp = std::min(pass_spp, m_training_spp - done);
+                Log(Debug, "Guiding: training pass %u (%u spp)", pass, pass_spp);
+
+                Base::render(scene, sensor, seed + pass + 1, pass_spp,
+                             /* develop = */ false, /* evaluate = */ true);
+                rebuild_distribution();
+
+                done += pass_spp;
+                pass_spp *= 2;
+                pass++;
+            }
+
+            m_training = false;
+        }
+
+        return Base::render(scene, sensor, seed, spp, develop, evaluate);
+    }
+
+    std::pair<Spectrum, Bool> sample(const Scene *scene,
+                                     Sampler *sampler,
+                                     const RayDifferential3f &ray_,
+                                     const Medium * /* medium */,
+                                     Float * /* aovs */,
+                                     Bool active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
+
+        if (unlikely(m_max_depth == 0))
+            return { 0.f, false };
+
+        // --------------------- Configure loop state ----------------------
+
+        Ray3f ray                     = Ray3f(ray_);
+        Spectrum throughput           = 1.f;
+        Spectrum result               = 0.f;
+        Float eta                     = 1.f;
+        UInt32 depth                  = 0;
+
+        // If m_hide_emitters == false, the environment emitter will be visible
+        Mask valid_ray                = !m_hide_emitters && dr::neq(scene->environment(), nullptr);
+
+        // Variables caching information from the previous bounce
+        Interaction3f prev_si         = dr::zeros<Interaction3f>();
+        Float         prev_bsdf_pdf   = 1.f;
+        Bool          prev_bsdf_delta = true;
+        BSDFContext   bsdf_ctx;
+
+        ScalarFloat alpha = m_guide_fraction;
+
+        dr::Loop<Bool> loop("Guided Path Tracer");
+        loop.put(sampler, ray, throughput, result, eta, depth, valid_ray,
+                 prev_si, prev_bsdf_pdf, prev_bsdf_delta, active);
+        loop.init();
+        loop.set_max_iterations(m_max_depth);
+
+        while (loop(active)) {
+            SurfaceInteraction3f si =
+                scene->ray_intersect(ray,
+                                     scene->minimal_ray_flags(),
+                                     /* coherent = */ dr::eq(depth, 0u));
+
+            // ---------------------- Direct emission ----------------------
+
+            if (dr::any_or<true>(dr::neq(si.emitter(scene), nullptr))) {
+                DirectionSample3f ds(scene, si, ray);
+                Float em_pdf = 0.f;
+
+                if (dr::any_or<true>(!prev_bsdf_delta))
+                    em_pdf = scene->pdf_emitter_direction(prev_si, ds,
+                                                          !prev_bsdf_delta);
+
+                // Compute MIS weight for emitter sample from previous bounce
+                Float mis_bsdf = mis_weight(prev_bsdf_pdf, em_pdf);
+
+                Spectrum emitted = ds.emitter->eval(si, prev_bsdf_pdf > 0.f);
+
+                /* Training: the emitter found along 'ray' is an estimate of
+                   the incident radiance at the previous vertex from this
+                   direction */
+                if (unlikely(m_training)) {
+                    Mask record = active && prev_si.is_valid() &&
+                                  dr::neq(ds.emitter, nullptr) &&
+                                  prev_bsdf_pdf > 0.f;
+                    guide_record(scene, prev_si.p, ray.d,
+                                 dr::mean(unpolarized_spectrum(emitted)) /
+                                     prev_bsdf_pdf, record);
+                }
+
+                // Accumulate, being careful with polarization (see spec_fma)
+                result = spec_fma(throughput, emitted * mis_bsdf, result);
+            }
+
+            // Continue tracing the path at this point?
+            Bool active_next = (depth + 1 < m_max_depth) && si.is_valid();
+
+            if (dr::none_or<false>(active_next))
+                break; // early exit for scalar mode
+
+            BSDFPtr bsdf = si.bsdf(ray);
+            Mask smooth = has_flag(bsdf->flags(), BSDFFlags::Smooth);
+
+            // Cell of the guiding structure containing the current vertex
+            UInt32 cell = guide_cell(scene, si.p);
+            Mask guided = false;
+            if (m_guide_ready)
+                guided = active_next && smooth &&
+                         dr::gather<Float>(m_guide_total, cell, active_next) > 0.f;
+
+            // ---------------------- Emitter sampling ----------------------
+
+            Mask active_em = active_next && smooth;
+
+            DirectionSample3f ds = dr::zeros<DirectionSample3f>();
+            Spectrum em_weight = dr::zeros<Spectrum>();
+            Vector3f wo = dr::zeros<Vector3f>();
+
+            if (dr::any_or<true>(active_em)) {
+                // Sample the emitter
+                std::tie(ds, em_weight) = scene->sample_emitter_direction(
+                    si, sampler->next_2d(), true, active_em);
+                active_em &= dr::neq(ds.pdf, 0.f);
+
+                /* Given the detached emitter sample, recompute its contribution
+                   with AD to enable light source optimization. */
+                if (dr::grad_enabled(si.p)) {
+                    ds.d = dr::normalize(ds.p - si.p);
+                    Spectrum em_val = scene->eval_emitter_direction(si, ds, active_em);
+                    em_weight = dr::select(dr::neq(ds.pdf, 0), em_val / ds.pdf, 0);
+                }
+
+                wo = si.to_local(ds.d);
+            }
+
+            // ------ Evaluate BSDF * cos(theta) and sample direction -------
+
+            Float sample_1 = sampler->next_1d();
+            Point2f sample_2 = sampler->next_2d();
+
+            auto [bsdf_val, bsdf_pdf, bsdf_sample, bsdf_weight]
+                = bsdf->eval_pdf_sample(bsdf_ctx, si, wo, sample_1, sample_2);
+
+            // --------------- Emitter sampling contribution ----------------
+
+            if (dr::any_or<true>(active_em)) {
+                bsdf_val = si.to_world_mueller(bsdf_val, -wo, si.wi);
+
+                /* Training: the emitter sample is an estimate of the incident
+                   radiance at the current vertex from direction 'ds.d' */
+                if (unlikely(m_training))
+                    guide_record(scene, si.p, ds.d,
+                                 dr::mean(unpolarized_spectrum(em_weight)),
+                                 active_em);
+
+                /* The density of the scattering strategy for the sampled
+                   emitter direction is the guiding mixture where it applies */
+                Float strategy_pdf = dr::select(
+                    guided,
+                    dr::lerp(bsdf_pdf, guide_pdf(cell, ds.d, active_em), alpha),
+                    bsdf_pdf);
+
+                // Compute the MIS weight
+                Float mis_em =
+                    dr::select(ds.delta, 1.f, mis_weight(ds.pdf, strategy_pdf));
+
+                // Accumulate, being careful with polarization (see spec_fma)
+                result[active_em] = spec_fma(
+                    throughput, bsdf_val * em_weight * mis_em, result);
+            }
+
+            // --------------- Guided / BSDF direction sampling -------------
+
+            /* One-sample MIS between the learned distribution and the BSDF:
+               guided lanes pick one of the two techniques and divide the
+               sampled value by the mixture density. */
+            Mask use_guide = guided && sampler->next_1d() < alpha;
+            auto [d_guide, guide_pdf_g] =
+                guide_sample(cell, sampler->next_2d(), use_guide);
+
+            Vector3f wo_final = dr::select(use_guide,
+                                           si.to_local(d_guide),
+                                           bsdf_sample.wo);
+
+            Spectrum value;
+            Float pdf_final;
+            if (dr::any_or<true>(use_guide)) {
+                auto [g_val, g_pdf] =
+                    bsdf->eval_pdf(bsdf_ctx, si, wo_final, use_guide);
+
+                Float pdf_b = dr::select(use_guide, g_pdf, bsdf_sample.pdf),
+                      pdf_g = dr::select(use_guide, guide_pdf_g,
+                                         guide_pdf(cell, si.to_world(bsdf_sample.wo),
+                                                   guided && !use_guide));
+
+                value     = dr::select(use_guide, g_val,
+                                       bsdf_weight * bsdf_sample.pdf);
+                pdf_final = dr::select(guided, dr::lerp(pdf_b, pdf_g, alpha),
+                                       bsdf_sample.pdf);
+            } else {
+                value     = bsdf_weight * bsdf_sample.pdf;
+                pdf_final = bsdf_sample.pdf;
+            }
+
+            Spectrum weight = dr::select(pdf_final > 0.f,
+                                         value / pdf_final, 0.f);
+
+            // ---------------------- BSDF sampling ----------------------
+
+            weight = si.to_world_mueller(weight, -wo_final, si.wi);
+
+            ray = si.spawn_ray(si.to_world(wo_final));
+
+            if (dr::grad_enabled(ray)) {
+                ray = dr::detach<true>(ray);
+
+                // Recompute 'wo' to propagate derivatives to cosine term
+                Vector3f wo_2 = si.to_local(ray.d);
+                auto [bsdf_val_2, bsdf_pdf_2] =
+                    bsdf->eval_pdf(bsdf_ctx, si, wo_2, active);
+                weight[bsdf_pdf_2 > 0.f] = bsdf_val_2 / dr::detach(bsdf_pdf_2);
+            }
+
+            // ------ Update loop variables based on current interaction ------
+
+            throughput *= weight;
+            eta *= dr::select(use_guide, 1.f, bsdf_sample.eta);
+            valid_ray |= active && si.is_valid() &&
+                         (use_guide ||
+                          !has_flag(bsdf_sample.sampled_type, BSDFFlags::Null));
+
+            // Information about the current vertex needed by the next iteration
+            prev_si = si;
+            prev_bsdf_pdf = pdf_final;
+            prev_bsdf_delta = !use_guide &&
+                has_flag(bsdf_sample.sampled_type, BSDFFlags::Delta);
+
+            // -------------------- Stopping criterion ---------------------
+
+            dr::masked(depth, si.is_valid()) += 1;
+
+            Float throughput_max = dr::max(unpolarized_spectrum(throughput));
+
+            Float rr_prob = dr::minimum(throughput_max * dr::sqr(eta), .95f);
+            Mask rr_active = depth >= m_rr_depth,
+                 rr_continue = sampler->next_1d() < rr_prob;
+
+            /* Differentiable variants of the renderer require the the russian
+               roulette sampling weight to be detached to avoid bias. This is a
+               no-op in non-differentiable variants. */
+            throughput[rr_active] *= dr::rcp(dr::detach(rr_prob));
+
+            active = active_next && (!rr_active || rr_continue) &&
+                     dr::neq(throughput_max, 0.f);
+        }
+
+        return {
+            /* spec  = */ dr::select(valid_ray, result, 0.f),
+            /* valid = */ valid_ray
+        };
+    }
+
+    std::string to_string() const override {
+        return tfm::format("GuidedPathIntegrator[\n"
+            "  max_depth = %u,\n"
+            "  rr_depth = %u,\n"
+            "  training_spp = %u,\n"
+            "  guide_fraction = %f,\n"
+            "  guide_resolution = %u,\n"
+            "  guide_size = %u\n"
+            "]", m_max_depth, m_rr_depth, m_training_spp, m_guide_fraction,
+            m_guide_resolution, m_guide_size);
+    }
+
+    /**
+     * \brief Map a path vertex to its guiding hash table cell
+     *
+     * The position is quantized on a regular grid with \c m_guide_resolution
+     * cells along the largest scene extent and hashed into the table, like
+     * the radiance cache of the path tracer.
+     */
+    UInt32 guide_cell(const Scene *scene, const Point3f &p) const {
+        const ScalarBoundingBox3f &bbox = scene->bbox();
+        ScalarFloat inv_cell = (ScalarFloat) m_guide_resolution /
+            dr::maximum(dr::max(bbox.extents()), dr::Epsilon<ScalarFloat>);
+
+        Vector3f rel = (p - bbox.min) * inv_cell;
+        UInt32 cx = UInt32(dr::maximum(dr::floor(rel.x()), 0.f)),
+               cy = UInt32(dr::maximum(dr::floor(rel.y()), 0.f)),
+               cz = UInt32(dr::maximum(dr::floor(rel.z()), 0.f));
+
+        UInt32 hash = cx * 0x9E3779B1u ^ cy * 0x85EBCA77u ^ cz * 0xC2B2AE3Du;
+        return hash & (m_guide_size - 1u);
+    }
+
+    /// Directional histogram bin containing the world-space direction \c d
+    UInt32 guide_bin(const Vector3f &d) const {
+        Point2f uv = warp::uniform_sphere_to_square(d);
+        UInt32 x = dr::minimum(UInt32(uv.x() * GuideDirRes), GuideDirRes - 1u),
+               y = dr::minimum(UInt32(uv.y() * GuideDirRes), GuideDirRes - 1u);
+        return y * GuideDirRes + x;
+    }
+
+    /**
+     * \brief Deposit a radiance estimate into the training histogram
+     *
+     * The scatter-adds compile to atomics in JIT variants; scalar variants
+     * may rarely lose an update to a race, which merely drops a sample from
+     * the affected bin.
+     */
+    void guide_record(const Scene *scene, const Point3f &p, const Vector3f &d,
+                      Float value, Mask active) const {
+        active &= dr::isfinite(value) && value > 0.f;
+        if (dr::none_or<false>(active))
+            return;
+        UInt32 index = guide_cell(scene, p) * GuideDirBins + guide_bin(d);
+        dr::scatter_reduce(ReduceOp::Add, m_guide_train, value, index, active);
+    }
+
+    /// Density of \ref guide_sample() per unit solid angle
+    Float guide_pdf(const UInt32 &cell, const Vector3f &d, Mask active) const {
+        UInt32 index = cell * GuideDirBins + guide_bin(d);
+        return dr::gather<Float>(m_guide_pmf, index, active) *
+               (GuideDirBins * dr::InvFourPi<Float>);
+    }
+
+    /// Sample a direction from the distribution of the given cell
+    std::pair<Vector3f, Float>
+    guide_sample(const UInt32 &cell, const Point2f &sample, Mask active) const {
+        UInt32 base = cell * GuideDirBins;
+        Float u = sample.x();
+
+        UInt32 bin = math::find_interval<UInt32>(
+            GuideDirBins + 1,
+            [&](UInt32 index) {
+                return dr::gather<Float>(m_guide_cdf, base + index - 1u,
+                                         active) < u;
+            });
+
+        Float pmf = dr::gather<Float>(m_guide_pmf, base + bin, active),
+              cdf = dr::select(
+                  bin > 0u,
+                  dr::gather<Float>(m_guide_cdf, base + bin - 1u,
+                                    active && bin > 0u),
+                  0.f);
+
+        // Reuse the stratification of 'u' for the position within the bin
+        Float u_re = dr::clamp((u - cdf) / pmf, 0.f, dr::OneMinusEpsilon<Float>);
+
+        Point2f uv((Float(bin % GuideDirRes) + u_re) * (1.f / GuideDirRes),
+                   (Float(bin / GuideDirRes) + sample.y()) * (1.f / GuideDirRes));
+
+        return { warp::square_to_uniform_sphere(uv),
+                 pmf * (GuideDirBins * dr::InvFourPi<Float>) };
+    }
+
+    /// Normalize the training histogram into per-cell sampling distributions
+    void rebuild_distribution() {
+        auto &&data = dr::migrate(m_guide_train, AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        const ScalarFloat *train = data.data();
+        size_t n = (size_t) m_guide_size * GuideDirBins;
+
+        std::unique_ptr<ScalarFloat[]> pmf(new ScalarFloat[n]),
+                                       cdf(new ScalarFloat[n]),
+                                       total(new ScalarFloat[m_guide_size]);
+
+        for (size_t c = 0; c < m_guide_size; ++c) {
+            const ScalarFloat *src = train + c * GuideDirBins;
+
+            double sum = 0.0;
+            for (uint32_t i = 0; i < GuideDirBins; ++i)
+                sum += (double) src[i];
+            total[c] = (ScalarFloat) sum;
+
+            ScalarFloat *pmf_c = pmf.get() + c * GuideDirBins,
+                        *cdf_c = cdf.get() + c * GuideDirBins;
+
+            if (sum > 0.0) {
+                double scale = 1.0 / sum, accum = 0.0;
+                for (uint32_t i = 0; i < GuideDirBins; ++i) {
+                    pmf_c[i] = (ScalarFloat) (src[i] * scale);
+                    accum += src[i] * scale;
+                    cdf_c[i] = (ScalarFloat) accum;
+                }
+            } else {
+                memset(pmf_c, 0, GuideDirBins * sizeof(ScalarFloat));
+                memset(cdf_c, 0, GuideDirBins * sizeof(ScalarFloat));
+            }
+        }
+
+        m_guide_pmf   = dr::load<DynamicBuffer<Float>>(pmf.get(), n);
+        m_guide_cdf   = dr::load<DynamicBuffer<Float>>(cdf.get(), n);
+        m_guide_total = dr::load<DynamicBuffer<Float>>(total.get(), m_guide_size);
+        m_guide_ready = true;
+    }
+
+    /// Compute a multiple importance sampling weight using the power heuristic
+    Float mis_weight(Float pdf_a, Float pdf_b) const {
+        pdf_a *= pdf_a;
+        pdf_b *= pdf_b;
+        Float w = pdf_a / (pdf_a + pdf_b);
+        return dr::select(dr::isfinite(w), w, 0.f);
+    }
+
+    MI_DECLARE_CLASS()
+private:
+    uint32_t m_training_spp, m_guide_size, m_guide_resolution;
+    ScalarFloat m_guide_fraction;
+
+    /// True while a training pass populates the histogram
+    bool m_training = false;
+
+    /// True once \ref rebuild_distribution() ran at least once
+    bool m_guide_ready = false;
+
+    /// Raw training histogram and the distributions built from it
+    mutable DynamicBuffer<Float> m_guide_train, m_guide_pmf, m_guide_cdf,
+                                 m_guide_total;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(GuidedPathIntegrator, MonteCarloIntegrator)
+MI_EXPORT_PLUGIN(GuidedPathIntegrator, "Guided path tracer integrator");
+NAMESPACE_END(mitsuba)
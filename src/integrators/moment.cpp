@@ -1,5 +1,9 @@
+#include <mitsuba/render/film.h>
+#include <mitsuba/render/imageblock.h>
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/records.h>
+#include <mitsuba/render/sampler.h>
+#include <mitsuba/render/sensor.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -21,6 +25,16 @@ Moment integrator (:monosp:`moment`)
 This integrator returns one AOVs recording the second moment of the samples of the nested
 integrator.
 
+In addition to the raw second moment channels (prefix ``m2_``), the integrator
+develops per-pixel variance AOVs (prefix ``var_``) directly. Rendering proceeds
+in passes of one sample per pixel whose images are combined with Welford's
+numerically stable online mean/M2 recurrence in double precision, so the result
+does not suffer from the catastrophic cancellation that plagues raw moment
+accumulation in single precision at high sample counts. The ``var_`` channels
+contain the unbiased per-sample variance; divide by the sample count to obtain
+the variance of the pixel estimate (e.g. for adaptive sampling or denoiser
+weighting).
+
 .. tabs::
     .. code-tab:: xml
 
@@ -40,8 +54,8 @@ integrator.
 template <typename Float, typename Spectrum>
 class MomentIntegrator final : public SamplingIntegrator<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(SamplingIntegrator)
-    MI_IMPORT_TYPES(Scene, Sampler, Medium)
+    MI_IMPORT_BASE(SamplingIntegrator, should_stop)
+    MI_IMPORT_TYPES(Scene, Sensor, Film, Sampler, ImageBlock, Medium)
 
     MomentIntegrator(const Properties &props) : Base(props) {
         // Get the nested integrators and their AOVs
@@ -59,10 +73,125 @@ public:
             m_aov_names.push_back(kv.first + ".Z");
         }
 
-        // For every AOV, add a corresponding "m2_" AOV
+        // For every AOV, add a raw second moment ("m2_") and variance ("var_") AOV
         size_t aov_count = m_aov_names.size();
         for (size_t i = 0; i < aov_count; i++)
             m_aov_names.push_back("m2_" + m_aov_names[i]);
+        for (size_t i = 0; i < aov_count; i++)
+            m_aov_names.push_back("var_" + m_aov_names[i]);
+    }
+
+    TensorXf render(Scene *scene,
+                    Sensor *sensor,
+                    uint32_t seed,
+                    uint32_t spp,
+                    bool develop,
+                    bool evaluate) override {
+        // Resolve the pixel sample count
+        Sampler *sampler = sensor->sampler();
+        if (spp == 0)
+            spp = sampler->sample_count();
+
+        Film *film = sensor->film();
+
+        /* A single sample provides no variance information, and films with
+           sample borders store a larger image than they develop, which the
+           channel surgery below does not support */
+        if (spp <= 1 || film->sample_border())
+            return Base::render(scene, sensor, seed, spp, develop, evaluate);
+
+        using Array   = typename TensorXf::Array;
+        using Array64 = dr::float64_array_t<Array>;
+        using Index   = dr::uint32_array_t<Array>;
+
+        /* Welford's online recurrence over per-sample passes. The double
+           precision accumulators sidestep the cancellation that makes raw
+           fp32 second moments useless at high sample counts. */
+        uint32_t n = 0;
+        Array64 mean, m2;
+        size_t shape[3] = { 0, 0, 0 };
+
+        for (uint32_t i = 0; i < spp && !should_stop(); ++i) {
+            TensorXf img = Base::render(scene, sensor, seed + i, 1,
+                                        /* develop = */ true, evaluate);
+
+            Array64 x(img.array());
+            if (n == 0) {
+                mean = dr::zeros<Array64>(dr::width(x));
+                m2   = dr::zeros<Array64>(dr::width(x));
+                for (int j = 0; j < 3; ++j)
+                    shape[j] = img.shape(j);
+            }
+
+            n++;
+            Array64 delta = x - mean;
+            mean += delta / (double) n;
+            m2 = dr::fmadd(delta, x - mean, m2);
+
+            if constexpr (dr::is_jit_v<Float>)
+                dr::eval(mean, m2);
+        }
+
+        // Restore the sample count modified by the per-pass renders
+        sampler->set_sample_count(spp);
+
+        if (n == 0)
+            return TensorXf();
+
+        size_t n_aovs  = m_aov_names.size(),
+               third   = n_aovs / 3,
+               ch      = shape[2],
+               px      = shape[0] * shape[1],
+               base_ch = ch - n_aovs;
+
+        Array combined(mean);
+
+        if (n > 1) {
+            /* Unbiased per-sample variance; overwrite the 'var_' channels,
+               whose accumulated mean is zero by construction */
+            Array64 variance = m2 / (double) (n - 1);
+
+            Index idx = dr::arange<Index>(px) * (uint32_t) ch +
+                        (uint32_t) (base_ch + third); // first 'm2_' channel
+            for (size_t j = 0; j < third; ++j) {
+                Array64 v = dr::gather<Array64>(
+                    variance, idx - (uint32_t) third + (uint32_t) j);
+                dr::scatter(combined, Array(v),
+                            idx + (uint32_t) (third + j));
+            }
+        }
+
+        /* Rebuild the film storage from the combined image so that a
+           subsequent film->develop() matches the returned tensor. Films
+           store weighted channel values followed by a weight channel ahead
+           of the AOVs; setting the weight to one makes the development an
+           identity transform. */
+        size_t film_ch   = film->prepare(m_aov_names),
+               weight_ch = film_ch - n_aovs - 1;
+
+        Array storage = dr::zeros<Array>(px * film_ch);
+        Index pix = dr::arange<Index>(px);
+        for (size_t j = 0; j < ch; ++j) {
+            size_t dst = j < weight_ch ? j : j + 1;
+            Array v = dr::gather<Array>(combined,
+                                        pix * (uint32_t) ch + (uint32_t) j);
+            dr::scatter(storage, v, pix * (uint32_t) film_ch + (uint32_t) dst);
+        }
+        dr::scatter(storage, dr::full<Array>(1.f, px),
+                    pix * (uint32_t) film_ch + (uint32_t) weight_ch);
+
+        size_t storage_shape[3] = { shape[0], shape[1], film_ch };
+        TensorXf storage_t(storage, 3, storage_shape);
+        ImageBlock block(storage_t, film->crop_offset());
+        film->put_block(&block);
+
+        if (develop) {
+            TensorXf result(combined, 3, shape);
+            return result;
+        } else {
+            film->schedule_storage();
+            return TensorXf();
+        }
     }
 
     std::pair<Spectrum, Mask> sample(const Scene *scene,
@@ -71,15 +200,50 @@ public:
                                      const Medium *medium,
                                      Float *aovs,
                                      Mask active) const override {
+        return sample_impl(scene, sampler, ray, nullptr, true, medium, aovs,
+                           active);
+    }
+
+    std::pair<Spectrum, Mask> sample_with_interaction(
+            const Scene *scene, Sampler *sampler,
+            const RayDifferential3f &ray,
+            const SurfaceInteraction3f &si, Mask si_valid,
+            const Medium *medium, Float *aovs,
+            Mask active) const override {
+        // Forward the shared primary intersection to the nested integrators
+        return sample_impl(scene, sampler, ray, &si, si_valid, medium, aovs,
+                           active);
+    }
+
+    bool reuses_primary_interaction() const override {
+        for (size_t i = 0; i < m_integrators.size(); i++) {
+            if (m_integrators[i].first->reuses_primary_interaction())
+                return true;
+        }
+        return false;
+    }
+
+    std::pair<Spectrum, Mask> sample_impl(const Scene *scene,
+                                          Sampler *sampler,
+                                          const RayDifferential3f &ray,
+                                          const SurfaceInteraction3f *si,
+                                          Mask si_valid,
+                                          const Medium *medium,
+                                          Float *aovs,
+                                          Mask active) const {
         MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
 
         std::pair<Spectrum, Mask> result { 0.f, false };
 
-        size_t offset = m_aov_names.size() / 2;
+        size_t offset = m_aov_names.size() / 3;
 
         for (size_t i = 0; i < m_integrators.size(); i++) {
             std::pair<Spectrum, Mask> result_sub =
-                m_integrators[i].first->sample(scene, sampler, ray, medium, aovs, active);
+                si ? m_integrators[i].first->sample_with_interaction(
+                         scene, sampler, ray, *si, si_valid, medium, aovs,
+                         active)
+                   : m_integrators[i].first->sample(scene, sampler, ray,
+                                                    medium, aovs, active);
             aovs += m_integrators[i].second;
 
             UnpolarizedSpectrum spec_u = unpolarized_spectrum(result_sub.first);
@@ -99,9 +263,12 @@ public:
 
             *aovs++ = xyz.x(); *aovs++ = xyz.y(); *aovs++ = xyz.z();
 
-            // Write second moment AOVs
-            for (size_t j = 0; j < m_integrators[i].second + 3; j++)
-                *(aovs - j + offset - 1) = dr::sqr(*(aovs - j - 1));
+            /* Write raw second moment AOVs; the variance channels are
+               filled in at develop time by \ref render() */
+            for (size_t j = 0; j < m_integrators[i].second + 3; j++) {
+                *(aovs - j + offset - 1)     = dr::sqr(*(aovs - j - 1));
+                *(aovs - j + 2 * offset - 1) = 0.f;
+            }
 
             if (i == 0)
                 result = result_sub;
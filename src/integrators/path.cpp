@@ -1,4 +1,5 @@
 #include <tuple>
+#include <mitsuba/core/math.h>
 #include <mitsuba/core/ray.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/render/bsdf.h>
@@ -6,6 +7,17 @@
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/records.h>
 
+/* When set to 1, the recorded (megakernel) loop carries its path state in a
+   packed representation: throughput and eta are stored as bfloat16 pairs, and
+   the depth counter shares a 32-bit word with the boolean path flags (see the
+   loop-state packing utilities in mitsuba/render/integrator.h). This reduces
+   per-lane register pressure -- and thereby improves occupancy on CUDA
+   backends for deep-bounce scenes -- at the cost of a small amount of
+   throughput precision. Disabled by default to keep images bit-identical. */
+#if !defined(MI_PATH_PACKED_LOOP_STATE)
+#  define MI_PATH_PACKED_LOOP_STATE 0
+#endif
+
 NAMESPACE_BEGIN(mitsuba)
 
 /**!
@@ -31,10 +43,78 @@ Path tracer (:monosp:`path`)
      1, then path generation many randomly cease after encountering directly
      visible surfaces. (Default: 5)
 
+ * - rr_adjoint
+   - |bool|
+   - Use an adjoint-driven russian roulette heuristic: instead of surviving
+     in proportion to the path throughput, paths survive in proportion to
+     their expected remaining contribution (the cached reflected radiance at
+     the current vertex) relative to the running pixel estimate. This
+     shortens paths in regions that contribute little to the image (e.g.
+     dark interiors) without introducing bias. Requires the radiance cache
+     (:monosp:`cache`) as the source of the radiance estimates; vertices
+     whose cache cell is still empty fall back to the throughput heuristic.
+     (Default: no, i.e. |false|)
+
  * - hide_emitters
    - |bool|
    - Hide directly visible emitters. (Default: no, i.e. |false|)
 
+ * - reorder_rays
+   - |bool|
+   - Reorder incoherent secondary rays by a quantized direction/origin key
+     before intersecting them against the scene. Only effective in wavefront
+     mode (``-W`` or the :monosp:`wavefront` parameter), where it improves
+     the memory coherence of the BVH
+     traversal on diffuse interreflection at the cost of two extra
+     permutation passes per bounce. (Default: no, i.e. |false|)
+
+ * - reorder_shading
+   - |bool|
+   - Partition surviving lanes by BSDF instance before the material
+     evaluation/sampling call so that each kernel segment runs coherent
+     shading code. Only effective in wavefront mode (``-W`` or the :monosp:`wavefront` parameter) and in scenes
+     with many distinct materials; it is skipped automatically when the scene
+     contains a single BSDF. (Default: no, i.e. |false|)
+
+ * - batch_shadow_rays
+   - |bool|
+   - Defer next-event-estimation shadow rays and occlusion-test them per
+     image block as one sorted batch through the ray tracing backend's
+     stream interface. Only effective in scalar variants; ignored when the
+     radiance cache is enabled. (Default: no, i.e. |false|)
+
+ * - guide_buffers
+   - |bool|
+   - Record denoiser guide buffers (first-hit albedo and shading normal) as
+     AOV channels alongside the beauty image. (Default: no, i.e. |false|)
+
+ * - cache
+   - |bool|
+   - Enable the online radiance cache described below. This feature is only
+     available in monochromatic and RGB variants. (Default: no, i.e. |false|)
+
+ * - cache_depth
+   - |int|
+   - Minimum path depth at which the radiance cache may be queried or
+     refined. Lower values are faster but make caching artifacts directly
+     visible. (Default: 2)
+
+ * - cache_threshold
+   - |int|
+   - Number of radiance samples that a cache cell must accumulate before its
+     estimate is trusted by queries. (Default: 64)
+
+ * - cache_resolution
+   - |int|
+   - Number of spatial cache cells along the largest extent of the scene
+     bounding box. (Default: 256)
+
+ * - cache_size
+   - |int|
+   - Number of entries in the cache hash table, rounded up to the next power
+     of two. Collisions blend unrelated cells together, so this should be
+     generous relative to the occupied cell count. (Default: 1048576)
+
 This integrator implements a basic path tracer and is a **good default choice**
 when there is no strong reason to prefer another method.
 
@@ -69,6 +149,38 @@ paths of arbitrary length to compute both direct and indirect illumination.
 
 .. note:: This integrator does not handle participating media
 
+When :monosp:`guide_buffers` is enabled, the integrator additionally writes
+the albedo and shading normal of the first path vertex into the AOV channels
+``albedo.{R,G,B}`` and ``normals.{X,Y,Z}``. Both quantities are computed by
+the path tracing loop anyway, so this is considerably cheaper than a separate
+rendering pass with the :ref:`aov <integrator-aov>` plugin. The channel names
+match the layer names expected by :py:class:`mitsuba.OptixDenoiser`, hence the
+developed film can be denoised directly:
+
+.. code-block:: python
+
+    denoiser = mi.OptixDenoiser(size, albedo=True, normals=True)
+    denoised = denoiser(film.bitmap(), albedo_ch="albedo",
+                        normals_ch="normals", to_sensor=to_sensor)
+
+Note that the normals are stored in world coordinates; the ``to_sensor``
+argument of the denoiser takes care of the required change to the sensor frame.
+
+When :monosp:`cache` is enabled, the integrator maintains a radiance cache in
+the form of a hash grid keyed on quantized position and the dominant shading
+normal direction. The cache is populated online while rendering: whenever a
+path encounters a diffuse vertex at depth :monosp:`cache_depth` or beyond, the
+radiance gathered by the remainder of that path is scatter-added into the
+corresponding cell. Once a cell has collected :monosp:`cache_threshold`
+samples, subsequent paths that reach it are terminated immediately using the
+cached estimate of the reflected radiance instead of continuing the random
+walk. This can shorten average path lengths considerably in interiors
+dominated by diffuse interreflection, at the cost of some bias: cached
+radiance is averaged over a cell's spatial extent and assumed to leave the
+surface isotropically, so the technique is unsuitable for glossy transport.
+The :monosp:`cache_depth`, :monosp:`cache_threshold` and
+:monosp:`cache_resolution` parameters control this speed/bias trade-off.
+
 .. tabs::
     .. code-tab::  xml
         :name: path-integrator
@@ -87,17 +199,83 @@ paths of arbitrary length to compute both direct and indirect illumination.
 template <typename Float, typename Spectrum>
 class PathIntegrator : public MonteCarloIntegrator<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(MonteCarloIntegrator, m_max_depth, m_rr_depth, m_hide_emitters)
+    MI_IMPORT_BASE(MonteCarloIntegrator, m_max_depth, m_rr_depth, m_hide_emitters,
+                   reordered_ray_intersect, shadow_batching_active,
+                   defer_shadow_ray)
     MI_IMPORT_TYPES(Scene, Sampler, Medium, Emitter, EmitterPtr, BSDF, BSDFPtr)
 
-    PathIntegrator(const Properties &props) : Base(props) { }
+    /* The radiance cache stores plain sample arithmetic means per cell,
+       which requires a Spectrum with a fixed channel semantic. Spectral
+       variants sample different wavelengths in every path, and polarized
+       variants would additionally need a reference Stokes frame. */
+    static constexpr bool CacheSupported =
+        !is_polarized_v<Spectrum> && !is_spectral_v<Spectrum>;
+    static constexpr uint32_t CacheChannels =
+        is_monochromatic_v<Spectrum> ? 1 : 3;
+
+    PathIntegrator(const Properties &props) : Base(props) {
+        m_guide_buffers = props.get<bool>("guide_buffers", false);
+        m_reorder_shading = props.get<bool>("reorder_shading", false);
+
+        m_cache = props.get<bool>("cache", false);
+        if (m_cache) {
+            if constexpr (!CacheSupported)
+                Throw("The radiance cache is currently limited to "
+                      "monochromatic and RGB variants!");
+
+            m_cache_size = math::round_to_power_of_two(
+                props.get<uint32_t>("cache_size", 1u << 20));
+            m_cache_resolution = props.get<uint32_t>("cache_resolution", 256);
+            m_cache_depth      = props.get<uint32_t>("cache_depth", 2);
+            m_cache_threshold  = props.get<uint32_t>("cache_threshold", 64);
+
+            m_cache_value = dr::zeros<DynamicBuffer<Float>>(
+                (size_t) m_cache_size * CacheChannels);
+            m_cache_count = dr::zeros<DynamicBuffer<Float>>(m_cache_size);
+        }
+
+        m_rr_adjoint = props.get<bool>("rr_adjoint", false);
+        if (m_rr_adjoint && !m_cache)
+            Throw("The adjoint russian roulette heuristic sources its "
+                  "radiance estimates from the radiance cache; please also "
+                  "set 'cache' to true!");
+    }
+
+    std::vector<std::string> aov_names() const override {
+        if (!m_guide_buffers)
+            return { };
+        return { "albedo.R",  "albedo.G",  "albedo.B",
+                 "normals.X", "normals.Y", "normals.Z" };
+    }
 
     std::pair<Spectrum, Bool> sample(const Scene *scene,
                                      Sampler *sampler,
                                      const RayDifferential3f &ray_,
                                      const Medium * /* medium */,
-                                     Float * /* aovs */,
+                                     Float *aovs,
                                      Bool active) const override {
+        return sample_impl(scene, sampler, ray_, nullptr, aovs, active);
+    }
+
+    std::pair<Spectrum, Bool> sample_with_interaction(
+            const Scene *scene, Sampler *sampler,
+            const RayDifferential3f &ray,
+            const SurfaceInteraction3f &si, Bool /* si_valid */,
+            const Medium * /* medium */, Float *aovs,
+            Bool active) const override {
+        /* A wrapper integrator (e.g. 'aov') already intersected the camera
+           ray; skip the corresponding traversal in the first loop iteration */
+        return sample_impl(scene, sampler, ray, &si, aovs, active);
+    }
+
+    bool reuses_primary_interaction() const override { return true; }
+
+    std::pair<Spectrum, Bool> sample_impl(const Scene *scene,
+                                          Sampler *sampler,
+                                          const RayDifferential3f &ray_,
+                                          const SurfaceInteraction3f *cached_si,
+                                          Float *aovs,
+                                          Bool active) const {
         MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
 
         if (unlikely(m_max_depth == 0))
@@ -120,6 +298,28 @@ public:
         Bool          prev_bsdf_delta = true;
         BSDFContext   bsdf_ctx;
 
+        /* Scene monomorphization: when every shape references the same BSDF
+           instance, the material queries below bypass the vcall dispatch
+           machinery in favor of direct calls (and a scalar flag word). Only
+           worthwhile when vcalls would be inlined anyway. */
+        const BSDF *unique_bsdf = scene->unique_bsdf();
+        if constexpr (dr::is_jit_v<Float>) {
+            if (!jit_flag(JitFlag::VCallInline))
+                unique_bsdf = nullptr;
+        }
+
+        // Denoiser guide buffers, recorded at the first path vertex
+        Color3f  aov_albedo = dr::zeros<Color3f>();
+        Normal3f aov_normal = dr::zeros<Normal3f>();
+
+        /* Radiance cache bookkeeping: each path refines at most one cell,
+           remembering its hash slot along with the throughput and the
+           radiance accumulated when the recorded vertex was reached. */
+        UInt32   cache_index      = 0;
+        Bool     cache_record     = false;
+        Spectrum cache_throughput = 0.f;
+        Spectrum cache_result     = 0.f;
+
         /* Set up a Dr.Jit loop. This optimizes away to a normal loop in scalar
            mode, and it generates either a a megakernel (default) or
            wavefront-style renderer in JIT variants. This can be controlled by
@@ -130,9 +330,38 @@ public:
            debugging. The subsequent list registers all variables that encode
            the loop state variables. This is crucial: omitting a variable may
            lead to undefined behavior. */
-        dr::Loop<Bool> loop("Path Tracer", sampler, ray, throughput, result,
-                            eta, depth, valid_ray, prev_si, prev_bsdf_pdf,
-                            prev_bsdf_delta, active);
+#if !MI_PATH_PACKED_LOOP_STATE
+        dr::Loop<Bool> loop("Path Tracer");
+        loop.put(sampler, ray, throughput, result, eta, depth, valid_ray,
+                 prev_si, prev_bsdf_pdf, prev_bsdf_delta, active);
+#else
+        static_assert(is_rgb_v<Spectrum>,
+                      "MI_PATH_PACKED_LOOP_STATE requires an RGB variant");
+
+        /* Packed loop state: 'tp_0'/'tp_1' hold throughput and eta as
+           bfloat16 pairs, 'state' holds the depth counter (bits 0..29), the
+           'valid_ray' flag (bit 30) and the 'prev_bsdf_delta' flag (bit 31).
+           The state is unpacked at the top of the loop body and repacked at
+           the bottom; see the loop-state packing notes in integrator.h. */
+        UInt32 tp_0  = pack_bf16x2(throughput[0], throughput[1]),
+               tp_1  = pack_bf16x2(throughput[2], eta),
+               state = dr::select(valid_ray, UInt32(1u << 30), UInt32(0)) |
+                       UInt32(1u << 31);
+
+        dr::Loop<Bool> loop("Path Tracer");
+        loop.put(sampler, ray, tp_0, tp_1, result, state, prev_si,
+                 prev_bsdf_pdf, active);
+#endif
+
+        /* The guide buffers and cache state are only registered as loop
+           state when they are actually in use to avoid growing the recorded
+           kernels otherwise */
+        if (unlikely(m_guide_buffers))
+            loop.put(aov_albedo, aov_normal);
+        if (unlikely(m_cache))
+            loop.put(cache_index, cache_record, cache_throughput, cache_result);
+
+        loop.init();
 
         /* Inform the loop about the maximum number of loop iterations.
            This accelerates wavefront-style rendering by avoiding costly
@@ -143,10 +372,49 @@ public:
             /* dr::Loop implicitly masks all code in the loop using the 'active'
                flag, so there is no need to pass it to every function */
 
-            SurfaceInteraction3f si =
-                scene->ray_intersect(ray,
-                                     /* ray_flags = */ +RayFlags::All,
-                                     /* coherent = */ dr::eq(depth, 0u));
+#if MI_PATH_PACKED_LOOP_STATE
+            // Unpack the loop state; shading below runs at full precision
+            std::tie(throughput[0], throughput[1]) = unpack_bf16x2<Float>(tp_0);
+            std::tie(throughput[2], eta)           = unpack_bf16x2<Float>(tp_1);
+            depth           = state & 0x3fffffffu;
+            valid_ray       = dr::neq(state & (1u << 30), 0u);
+            prev_bsdf_delta = dr::neq(state & (1u << 31), 0u);
+#endif
+
+            SurfaceInteraction3f si;
+            if (unlikely(cached_si != nullptr)) {
+                /* Reuse the wrapper-provided primary intersection in the
+                   first loop iteration; only the masked-off traversal
+                   remains, which inactive lanes skip at runtime */
+                Mask use_cache = dr::eq(depth, 0u);
+                si = reordered_ray_intersect(scene, ray,
+                                             scene->minimal_ray_flags(),
+                                             /* coherent = */ use_cache,
+                                             active && !use_cache);
+                dr::masked(si, use_cache) = *cached_si;
+            } else {
+                si = reordered_ray_intersect(scene, ray,
+                                             scene->minimal_ray_flags(),
+                                             /* coherent = */ dr::eq(depth, 0u),
+                                             active);
+            }
+
+            // ------------------- Denoiser guide buffers -------------------
+
+            if (unlikely(m_guide_buffers)) {
+                /* The first intersection and its BSDF are needed below anyway,
+                   so recording the guide buffers only adds an albedo query */
+                Mask first_hit = active && si.is_valid() && dr::eq(depth, 0u);
+                if (dr::any_or<true>(first_hit)) {
+                    Spectrum albedo =
+                        unique_bsdf
+                            ? unique_bsdf->eval_diffuse_reflectance(si, first_hit)
+                            : si.bsdf(ray)->eval_diffuse_reflectance(si, first_hit);
+                    dr::masked(aov_albedo, first_hit) =
+                        spec_to_rgb(albedo, ray_, first_hit);
+                    dr::masked(aov_normal, first_hit) = si.sh_frame.n;
+                }
+            }
 
             // ---------------------- Direct emission ----------------------
 
@@ -156,7 +424,10 @@ public:
                dr::any_or<..>() returns the template argument (true) which means
                that the 'if' statement is always conservatively taken. */
             if (dr::any_or<true>(dr::neq(si.emitter(scene), nullptr))) {
-                DirectionSample3f ds(scene, si, prev_si);
+                /* The ray-based record constructor reuses the direction and
+                   distance already computed by the intersection above instead
+                   of re-deriving them from 'si' and 'prev_si'. */
+                DirectionSample3f ds(scene, si, ray);
                 Float em_pdf = 0.f;
 
                 if (dr::any_or<true>(!prev_bsdf_delta))
@@ -179,21 +450,86 @@ public:
             if (dr::none_or<false>(active_next))
                 break; // early exit for scalar mode
 
-            BSDFPtr bsdf = si.bsdf(ray);
+            BSDFPtr bsdf;
+            UInt32 bsdf_flags;
+            if (unique_bsdf) {
+                bsdf       = BSDFPtr(unique_bsdf);
+                bsdf_flags = (uint32_t) unique_bsdf->flags();
+
+                /* Mirror \ref SurfaceInteraction::bsdf(): compute texture
+                   coordinate partials if the BSDF requires them */
+                if constexpr (!dr::is_diff_v<Float>) {
+                    if (!si.has_uv_partials() && unique_bsdf->needs_differentials())
+                        si.compute_uv_partials(ray);
+                }
+            } else {
+                bsdf       = si.bsdf(ray);
+                bsdf_flags = bsdf->flags();
+            }
+
+            // ---------------------- Radiance cache ------------------------
+
+            if constexpr (CacheSupported) {
+                if (unlikely(m_cache)) {
+                    Mask candidate =
+                        active_next && !cache_record &&
+                        depth >= m_cache_depth &&
+                        has_flag(bsdf_flags, BSDFFlags::DiffuseReflection);
+
+                    if (dr::any_or<true>(candidate)) {
+                        UInt32 slot = cache_cell(scene, si);
+                        Float count =
+                            dr::gather<Float>(m_cache_count, slot, candidate);
+
+                        /* Mature cells terminate the path using the cached
+                           reflected radiance. The direct emission of the
+                           current vertex was already accounted for above. */
+                        Mask hit = candidate &&
+                                   count >= (ScalarFloat) m_cache_threshold;
+                        if (dr::any_or<true>(hit)) {
+                            Spectrum value = dr::zeros<Spectrum>();
+                            for (uint32_t c = 0; c < CacheChannels; ++c)
+                                value[c] = dr::gather<Float>(
+                                    m_cache_value, slot * CacheChannels + c, hit);
+                            result[hit] =
+                                spec_fma(throughput, value / count, result);
+                            active_next &= !hit;
+                        }
+
+                        /* Immature cells are refined by the current path: the
+                           radiance gathered by the rest of the random walk is
+                           scattered into the cell once the loop finishes. */
+                        Mask record = candidate && !hit;
+                        dr::masked(cache_index, record)      = slot;
+                        dr::masked(cache_throughput, record) = throughput;
+                        dr::masked(cache_result, record)     = result;
+                        cache_record |= record;
+                    }
+                }
+            }
 
             // ---------------------- Emitter sampling ----------------------
 
             // Perform emitter sampling?
-            Mask active_em = active_next && has_flag(bsdf->flags(), BSDFFlags::Smooth);
+            Mask active_em = active_next && has_flag(bsdf_flags, BSDFFlags::Smooth);
 
             DirectionSample3f ds = dr::zeros<DirectionSample3f>();
             Spectrum em_weight = dr::zeros<Spectrum>();
             Vector3f wo = dr::zeros<Vector3f>();
 
+            /* With deferred shadow-ray batching (see the 'batch_shadow_rays'
+               parameter of SamplingIntegrator), skip the visibility test here
+               and queue the shadow ray below instead. Disabled when the
+               radiance cache is active, which requires resolved contributions
+               within the loop. */
+            bool defer_nee = false;
+            if constexpr (!dr::is_jit_v<Float>)
+                defer_nee = !m_cache && shadow_batching_active();
+
             if (dr::any_or<true>(active_em)) {
                 // Sample the emitter
                 std::tie(ds, em_weight) = scene->sample_emitter_direction(
-                    si, sampler->next_2d(), true, active_em);
+                    si, sampler->next_2d(), !defer_nee, active_em);
                 active_em &= dr::neq(ds.pdf, 0.f);
 
                 /* Given the detached emitter sample, recompute its contribution
@@ -212,8 +548,48 @@ public:
             Float sample_1 = sampler->next_1d();
             Point2f sample_2 = sampler->next_2d();
 
-            auto [bsdf_val, bsdf_pdf, bsdf_sample, bsdf_weight]
-                = bsdf->eval_pdf_sample(bsdf_ctx, si, wo, sample_1, sample_2);
+            Spectrum bsdf_val, bsdf_weight;
+            Float bsdf_pdf;
+            BSDFSample3f bsdf_sample;
+            bool shading_reordered = false;
+
+            if constexpr (dr::is_jit_v<Float>) {
+                /* Shade sorting (see the 'reorder_shading' parameter): group
+                   the lanes by BSDF instance so that each segment of the
+                   dispatched material evaluation below runs coherent code.
+                   Like ray reordering, this requires evaluated arrays and is
+                   therefore limited to wavefront mode. */
+                if (m_reorder_shading && !unique_bsdf &&
+                    !jit_flag(JitFlag::LoopRecord) &&
+                    dr::width(si.p) >= 1024) {
+                    auto [order, inverse] = shading_sort_permutation(bsdf);
+
+                    SurfaceInteraction3f si_s =
+                        dr::gather<SurfaceInteraction3f>(si, order);
+                    BSDFPtr  bsdf_s   = dr::gather<BSDFPtr>(bsdf, order);
+                    Vector3f wo_s     = dr::gather<Vector3f>(wo, order);
+                    Float    s1_s     = dr::gather<Float>(sample_1, order);
+                    Point2f  s2_s     = dr::gather<Point2f>(sample_2, order);
+                    Mask     active_s = dr::gather<Mask>(active_next, order);
+
+                    auto [val_s, pdf_s, bs_s, weight_s] =
+                        bsdf_s->eval_pdf_sample(bsdf_ctx, si_s, wo_s, s1_s,
+                                                s2_s, active_s);
+
+                    bsdf_val    = dr::gather<Spectrum>(val_s, inverse);
+                    bsdf_pdf    = dr::gather<Float>(pdf_s, inverse);
+                    bsdf_sample = dr::gather<BSDFSample3f>(bs_s, inverse);
+                    bsdf_weight = dr::gather<Spectrum>(weight_s, inverse);
+                    shading_reordered = true;
+                }
+            }
+
+            if (!shading_reordered)
+                std::tie(bsdf_val, bsdf_pdf, bsdf_sample, bsdf_weight)
+                    = unique_bsdf
+                        ? unique_bsdf->eval_pdf_sample(bsdf_ctx, si, wo, sample_1,
+                                                       sample_2, active_next)
+                        : bsdf->eval_pdf_sample(bsdf_ctx, si, wo, sample_1, sample_2);
 
             // --------------- Emitter sampling contribution ----------------
 
@@ -225,8 +601,19 @@ public:
                     dr::select(ds.delta, 1.f, mis_weight(ds.pdf, bsdf_pdf));
 
                 // Accumulate, being careful with polarization (see spec_fma)
-                result[active_em] = spec_fma(
-                    throughput, bsdf_val * em_weight * mis_em, result);
+                if (defer_nee) {
+                    /* Visibility is still untested: hand the contribution and
+                       its shadow ray to the per-block batch for later
+                       resolution */
+                    Spectrum contrib = spec_fma(
+                        throughput, bsdf_val * em_weight * mis_em,
+                        dr::zeros<Spectrum>());
+                    if (dr::any(unpolarized_spectrum(contrib) != 0.f))
+                        defer_shadow_ray(si.spawn_ray_to(ds.p), contrib);
+                } else {
+                    result[active_em] = spec_fma(
+                        throughput, bsdf_val * em_weight * mis_em, result);
+                }
             }
 
             // ---------------------- BSDF sampling ----------------------
@@ -245,7 +632,9 @@ public:
 
                 // Recompute 'wo' to propagate derivatives to cosine term
                 Vector3f wo_2 = si.to_local(ray.d);
-                auto [bsdf_val_2, bsdf_pdf_2] = bsdf->eval_pdf(bsdf_ctx, si, wo_2, active);
+                auto [bsdf_val_2, bsdf_pdf_2] =
+                    unique_bsdf ? unique_bsdf->eval_pdf(bsdf_ctx, si, wo_2, active)
+                                : bsdf->eval_pdf(bsdf_ctx, si, wo_2, active);
                 bsdf_weight[bsdf_pdf_2 > 0.f] = bsdf_val_2 / dr::detach(bsdf_pdf_2);
             }
 
@@ -268,6 +657,44 @@ public:
             Float throughput_max = dr::max(unpolarized_spectrum(throughput));
 
             Float rr_prob = dr::minimum(throughput_max * dr::sqr(eta), .95f);
+
+            if constexpr (CacheSupported) {
+                if (unlikely(m_rr_adjoint)) {
+                    /* Adjoint heuristic: survive in proportion to the expected
+                       remaining contribution -- the cached reflected radiance
+                       at the current vertex, weighted by the path throughput --
+                       relative to the running pixel estimate. Since the
+                       throughput is later divided by the (detached) survival
+                       probability, any positive probability is unbiased;
+                       vertices whose cell has not collected a sample yet fall
+                       back to the throughput heuristic above. */
+                    UInt32 slot  = cache_cell(scene, si);
+                    Float  count = dr::gather<Float>(m_cache_count, slot,
+                                                     active_next);
+
+                    auto lum = [](const Spectrum &s) {
+                        if constexpr (is_monochromatic_v<Spectrum>)
+                            return s[0];
+                        else
+                            return luminance(unpolarized_spectrum(s));
+                    };
+
+                    Spectrum psi = dr::zeros<Spectrum>();
+                    for (uint32_t c = 0; c < CacheChannels; ++c)
+                        psi[c] = dr::gather<Float>(
+                            m_cache_value, slot * CacheChannels + c, active_next);
+
+                    Mask have_est = active_next && count > 0.f;
+                    Float expected  = lum(throughput * psi) /
+                                      dr::maximum(count, 1.f),
+                          pixel_est = lum(result) + expected;
+
+                    Float p_adj = dr::select(
+                        pixel_est > 0.f, expected / pixel_est, 1.f);
+                    rr_prob[have_est] = dr::clamp(p_adj, .05f, .95f);
+                }
+            }
+
             Mask rr_active = depth >= m_rr_depth,
                  rr_continue = sampler->next_1d() < rr_prob;
 
@@ -278,6 +705,51 @@ public:
 
             active = active_next && (!rr_active || rr_continue) &&
                      dr::neq(throughput_max, 0.f);
+
+#if MI_PATH_PACKED_LOOP_STATE
+            // Repack the loop state for the next iteration
+            tp_0  = pack_bf16x2(throughput[0], throughput[1]);
+            tp_1  = pack_bf16x2(throughput[2], eta);
+            state = (depth & 0x3fffffffu) |
+                    dr::select(valid_ray, UInt32(1u << 30), UInt32(0)) |
+                    dr::select(prev_bsdf_delta, UInt32(1u << 31), UInt32(0));
+#endif
+        }
+
+#if MI_PATH_PACKED_LOOP_STATE
+        valid_ray = dr::neq(state & (1u << 30), 0u);
+#endif
+
+        if constexpr (CacheSupported) {
+            if (unlikely(m_cache) && dr::any_or<true>(cache_record)) {
+                /* The radiance accumulated after the recorded vertex, relative
+                   to the throughput at that vertex, is an unbiased estimate of
+                   the radiance it reflected. The scatter-adds below compile to
+                   atomics in JIT variants, making concurrent refinement of the
+                   shared table lock-free; scalar variants may rarely lose an
+                   update to a race, which merely drops a sample from the
+                   running mean of the affected cell. */
+                Spectrum suffix = result - cache_result;
+                for (uint32_t c = 0; c < CacheChannels; ++c) {
+                    Float tp = cache_throughput[c],
+                          value = dr::select(dr::neq(tp, 0.f),
+                                             suffix[c] / tp, 0.f);
+                    dr::scatter_reduce(ReduceOp::Add, m_cache_value, value,
+                                       cache_index * CacheChannels + c,
+                                       cache_record);
+                }
+                dr::scatter_reduce(ReduceOp::Add, m_cache_count, Float(1.f),
+                                   cache_index, cache_record);
+            }
+        }
+
+        if (unlikely(m_guide_buffers)) {
+            *aovs++ = aov_albedo.r();
+            *aovs++ = aov_albedo.g();
+            *aovs++ = aov_albedo.b();
+            *aovs++ = aov_normal.x();
+            *aovs++ = aov_normal.y();
+            *aovs++ = aov_normal.z();
         }
 
         return {
@@ -296,6 +768,80 @@ public:
             "]", m_max_depth, m_rr_depth);
     }
 
+    /**
+     * \brief Map a path vertex to its radiance cache hash table slot
+     *
+     * The cell key combines the position, quantized on a regular grid with
+     * \c m_cache_resolution cells along the largest scene extent, with one of
+     * six buckets for the dominant shading normal direction so that opposite
+     * sides of thin geometry do not share radiance estimates.
+     */
+    UInt32 cache_cell(const Scene *scene,
+                      const SurfaceInteraction3f &si) const {
+        const ScalarBoundingBox3f &bbox = scene->bbox();
+        ScalarFloat inv_cell = (ScalarFloat) m_cache_resolution /
+            dr::maximum(dr::max(bbox.extents()), dr::Epsilon<ScalarFloat>);
+
+        Vector3f rel = (si.p - bbox.min) * inv_cell;
+        UInt32 cx = UInt32(dr::maximum(dr::floor(rel.x()), 0.f)),
+               cy = UInt32(dr::maximum(dr::floor(rel.y()), 0.f)),
+               cz = UInt32(dr::maximum(dr::floor(rel.z()), 0.f));
+
+        Vector3f n = si.sh_frame.n, an = dr::abs(n);
+        UInt32 axis  = dr::select(an.x() > an.y() && an.x() > an.z(), 0u,
+                                  dr::select(an.y() > an.z(), 1u, 2u));
+        Float   comp = dr::select(dr::eq(axis, 0u), n.x(),
+                                  dr::select(dr::eq(axis, 1u), n.y(), n.z()));
+        UInt32 key = axis * 2u + dr::select(comp < 0.f, 1u, 0u);
+
+        UInt32 hash = cx * 0x9E3779B1u ^ cy * 0x85EBCA77u ^
+                      cz * 0xC2B2AE3Du ^ key * 0x27D4EB2Fu;
+        return hash & (m_cache_size - 1u);
+    }
+
+    /**
+     * \brief Compute a permutation that groups lanes by BSDF instance
+     *
+     * Returns a pair of index arrays: the first gathers the wavefront into
+     * sorted order, the second scatters sorted results back to their original
+     * lanes. The sort is a stable LSD radix pass over the reinterpreted
+     * instance IDs, built from per-bit \c dr::compress() stream compactions
+     * since Dr.Jit exposes no device-side radix sort.
+     */
+    std::pair<UInt32, UInt32>
+    shading_sort_permutation(const BSDFPtr &bsdf) const {
+        uint32_t n = (uint32_t) dr::width(bsdf);
+        UInt32 key = dr::reinterpret_array<UInt32>(bsdf);
+
+        uint32_t max_id = dr::slice(dr::max(key)), bits = 0;
+        while ((1u << bits) <= max_id && bits < 32)
+            ++bits;
+
+        UInt32 order = dr::arange<UInt32>(n), key_cur = key;
+        for (uint32_t b = 0; b < bits; ++b) {
+            Mask bit = dr::neq(key_cur & (1u << b), 0u);
+            UInt32 idx0 = dr::compress(!bit),
+                   idx1 = dr::compress(bit);
+            uint32_t c0 = (uint32_t) dr::width(idx0);
+
+            UInt32 next = dr::zeros<UInt32>(n);
+            if (c0 > 0)
+                dr::scatter(next, dr::gather<UInt32>(order, idx0),
+                            dr::arange<UInt32>(c0));
+            if (c0 < n)
+                dr::scatter(next, dr::gather<UInt32>(order, idx1),
+                            dr::arange<UInt32>(n - c0) + c0);
+
+            order = next;
+            key_cur = dr::gather<UInt32>(key, order);
+        }
+
+        UInt32 inverse = dr::zeros<UInt32>(n);
+        dr::scatter(inverse, dr::arange<UInt32>(n), order);
+
+        return { order, inverse };
+    }
+
     /// Compute a multiple importance sampling weight using the power heuristic
     Float mis_weight(Float pdf_a, Float pdf_b) const {
         pdf_a *= pdf_a;
@@ -304,6 +850,25 @@ public:
         return dr::detach<true>(dr::select(dr::isfinite(w), w, 0.f));
     }
 
+    /// Convert a reflectance value into sRGB for the albedo guide buffer
+    Color3f spec_to_rgb(const Spectrum &spec, const Ray3f &ray,
+                        Mask active) const {
+        UnpolarizedSpectrum spec_u = unpolarized_spectrum(spec);
+        if constexpr (is_monochromatic_v<Spectrum>) {
+            DRJIT_MARK_USED(ray); DRJIT_MARK_USED(active);
+            return spec_u.x();
+        } else if constexpr (is_rgb_v<Spectrum>) {
+            DRJIT_MARK_USED(ray); DRJIT_MARK_USED(active);
+            return spec_u;
+        } else {
+            static_assert(is_spectral_v<Spectrum>);
+            /// Note: this assumes that sensor used sample_rgb_spectrum() to generate 'ray.wavelengths'
+            auto pdf = pdf_rgb_spectrum(ray.wavelengths);
+            spec_u *= dr::select(dr::neq(pdf, 0.f), dr::rcp(pdf), 0.f);
+            return spectrum_to_srgb(spec_u, ray.wavelengths, active);
+        }
+    }
+
     /**
      * \brief Perform a Mueller matrix multiplication in polarized modes, and a
      * fused multiply-add otherwise.
@@ -317,6 +882,22 @@ public:
     }
 
     MI_DECLARE_CLASS()
+
+protected:
+    /// Record first-hit albedo/normal AOVs for denoising?
+    bool m_guide_buffers;
+
+    /// Sort surviving lanes by BSDF instance before shading in wavefront mode?
+    bool m_reorder_shading;
+
+    /// Online radiance cache (see the plugin documentation)
+    bool m_cache;
+    uint32_t m_cache_size, m_cache_resolution,
+             m_cache_depth, m_cache_threshold;
+    mutable DynamicBuffer<Float> m_cache_value, m_cache_count;
+
+    /// Use the adjoint (expected contribution) russian roulette heuristic?
+    bool m_rr_adjoint;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(PathIntegrator, MonteCarloIntegrator)
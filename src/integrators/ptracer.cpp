@@ -37,6 +37,14 @@ Particle tracer (:monosp:`ptracer`)
    - If specified, divides the workload in successive passes with :paramtype:`samples_per_pass`
      samples per pixel.
 
+ * - accumulation_slots
+   - |int|
+   - Number of privatized film copies used to accumulate particle splats in
+     JIT variants. Larger values reduce atomic memory contention when many
+     particles land in the same pixels (e.g. caustics) at the cost of
+     additional memory. The value 0 (default) selects a backend-specific
+     heuristic, 1 accumulates directly into the film.
+
 This integrator traces rays starting from light sources and attempts to connect them
 to the sensor at each bounce.
 It does not support media (volumes).
@@ -0,0 +1,86 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+from mitsuba.scalar_rgb.test.util import fresolver_append_path
+
+
+@fresolver_append_path
+def make_scene(integrator, spp):
+    return mi.load_dict({
+        'type': 'scene',
+        'integrator': integrator,
+        'sensor': {
+            'type': 'perspective',
+            'fov': 39.3,
+            'to_world': mi.ScalarTransform4f.look_at(
+                origin=[0, 0, 3.9],
+                target=[0, 0, 0],
+                up=[0, 1, 0]),
+            'sampler': {'type': 'independent', 'sample_count': spp},
+            'film': {
+                'type': 'hdrfilm',
+                'width': 8, 'height': 8,
+                'rfilter': {'type': 'box'}
+            },
+        },
+        'light': {
+            'type': 'rectangle',
+            'to_world': mi.ScalarTransform4f.translate([0, 0.99, 0]) \
+                        @ mi.ScalarTransform4f.rotate([1, 0, 0], 90),
+            'scale_emitter': {
+                'type': 'area',
+                'radiance': {'type': 'rgb', 'value': 10.0}
+            }
+        },
+        'box': {
+            'type': 'cube',
+            'to_world': mi.ScalarTransform4f.scale(1.0),
+            'flip_normals': True,
+            'bsdf': {
+                'type': 'diffuse',
+                'reflectance': {'type': 'rgb', 'value': 0.5}
+            }
+        }
+    })
+
+
+def render_mean(integrator, spp, seed=0):
+    scene = make_scene(integrator, spp)
+    img = mi.render(scene, spp=spp, seed=seed)
+    import numpy as np
+    return float(np.mean(np.array(img)))
+
+
+def test01_construct(variant_scalar_rgb):
+    integrator = mi.load_dict({
+        'type': 'guided',
+        'max_depth': 4,
+        'training_spp': 8,
+        'guide_fraction': 0.75
+    })
+    assert 'GuidedPathIntegrator' in str(integrator)
+    assert 'training_spp = 8' in str(integrator)
+
+    with pytest.raises(RuntimeError, match='guide_fraction'):
+        mi.load_dict({'type': 'guided', 'guide_fraction': 1.5})
+
+
+def test02_matches_path(variants_all_rgb):
+    # The guided estimator must remain unbiased: a simple enclosed scene
+    # renders to the same mean intensity as the plain path tracer
+    mean_path = render_mean({'type': 'path', 'max_depth': 4}, spp=64)
+    mean_guided = render_mean(
+        {'type': 'guided', 'max_depth': 4, 'training_spp': 8}, spp=64)
+
+    assert mean_path > 0
+    assert dr.allclose(mean_guided, mean_path, rtol=0.2)
+
+
+def test03_zero_training(variant_scalar_rgb):
+    # With no training budget the integrator degrades to pure BSDF sampling
+    mean_path = render_mean({'type': 'path', 'max_depth': 3}, spp=32)
+    mean_guided = render_mean(
+        {'type': 'guided', 'max_depth': 3, 'training_spp': 0}, spp=32)
+
+    assert dr.allclose(mean_guided, mean_path, rtol=0.2)
@@ -0,0 +1,125 @@
+import drjit as dr
+import mitsuba as mi
+
+
+def test01_reorder_rays(variants_vec_rgb):
+    # Ray reordering must not change the rendered image
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 32
+    d['sensor']['film']['height'] = 32
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=4, seed=0)
+
+    d['integrator']['reorder_rays'] = True
+    scene_reorder = mi.load_dict(d)
+
+    # Reordering is only active in wavefront mode
+    loop_record = dr.flag(dr.JitFlag.LoopRecord)
+    try:
+        dr.set_flag(dr.JitFlag.LoopRecord, False)
+        img = mi.render(scene_reorder, spp=4, seed=0)
+    finally:
+        dr.set_flag(dr.JitFlag.LoopRecord, loop_record)
+
+    assert dr.allclose(img, img_ref, atol=1e-3)
+
+
+def test02_reorder_shading(variants_vec_rgb):
+    # Shade sorting must not change the rendered image
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 32
+    d['sensor']['film']['height'] = 32
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=4, seed=0)
+
+    d['integrator']['reorder_shading'] = True
+    scene_reorder = mi.load_dict(d)
+
+    # Shade sorting is only active in wavefront mode
+    loop_record = dr.flag(dr.JitFlag.LoopRecord)
+    try:
+        dr.set_flag(dr.JitFlag.LoopRecord, False)
+        img = mi.render(scene_reorder, spp=4, seed=0)
+    finally:
+        dr.set_flag(dr.JitFlag.LoopRecord, loop_record)
+
+    assert dr.allclose(img, img_ref, atol=1e-3)
+
+
+def test03_batch_shadow_rays(variant_scalar_rgb):
+    # Deferred shadow-ray batching must not change the rendered image
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 16
+    d['sensor']['film']['height'] = 16
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=4, seed=0)
+
+    d['integrator']['batch_shadow_rays'] = True
+    scene_batch = mi.load_dict(d)
+    img = mi.render(scene_batch, spp=4, seed=0)
+
+    assert dr.allclose(img, img_ref, atol=1e-3)
+
+
+def test04_batch_primary_rays(variant_scalar_rgb):
+    # Batched primary visibility must not change the rendered image
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 16
+    d['sensor']['film']['height'] = 16
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=4, seed=0)
+
+    d['integrator']['batch_primary_rays'] = True
+    scene_batch = mi.load_dict(d)
+    img = mi.render(scene_batch, spp=4, seed=0)
+
+    assert dr.allclose(img, img_ref, atol=1e-3)
+
+
+def test05_adaptive_sampling(variant_scalar_rgb):
+    # Adaptive sampling spends fewer samples on converged pixels but must
+    # remain unbiased
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 16
+    d['sensor']['film']['height'] = 16
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=64, seed=0)
+
+    d['integrator']['adaptive_threshold'] = 0.1
+    d['integrator']['adaptive_min_samples'] = 8
+    scene_adaptive = mi.load_dict(d)
+    img = mi.render(scene_adaptive, spp=64, seed=0)
+
+    assert dr.allclose(dr.mean(img), dr.mean(img_ref), rtol=0.05)
+
+
+def test06_wavefront_mode(variants_vec_rgb):
+    # The per-integrator wavefront mode must not change the rendered image,
+    # and must restore the global loop recording flag afterwards
+    d = mi.cornell_box()
+    d['integrator'] = {'type': 'path', 'max_depth': 4}
+    d['sensor']['film']['width'] = 32
+    d['sensor']['film']['height'] = 32
+
+    scene = mi.load_dict(d)
+    img_ref = mi.render(scene, spp=4, seed=0)
+
+    d['integrator']['wavefront'] = True
+    d['integrator']['reorder_rays'] = True
+    scene_wf = mi.load_dict(d)
+
+    loop_record = dr.flag(dr.JitFlag.LoopRecord)
+    img = mi.render(scene_wf, spp=4, seed=0)
+    assert dr.flag(dr.JitFlag.LoopRecord) == loop_record
+
+    assert dr.allclose(img, img_ref, atol=1e-3)
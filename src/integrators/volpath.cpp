@@ -35,11 +35,30 @@ Volumetric path tracer (:monosp:`volpath`)
    - |bool|
    - Hide directly visible emitters. (Default: no, i.e. |false|)
 
+ * - equiangular
+   - |bool|
+   - If set to |true| and the scene contains point or spot lights, the
+     integrator complements its transmittance-proportional distance sampling
+     with *equiangular sampling* towards these emitters, and combines the two
+     strategies via multiple importance sampling. This greatly reduces
+     variance in media lit by nearby delta-position lights (e.g. fog around
+     practical light fixtures). (Default: |false|)
+
 This plugin provides a volumetric path tracer that can be used to compute approximate solutions
 of the radiative transfer equation. Its implementation makes use of multiple importance sampling
 to combine BSDF and phase function sampling with direct illumination sampling strategies. On
 surfaces, it behaves exactly like the standard path tracer.
 
+Emissive participating media (see the :paramtype:`emission` parameter of the
+:ref:`heterogeneous <medium-heterogeneous>` plugin) are importance sampled
+directly: at every scattering vertex, the integrator additionally connects to
+a point drawn from the medium's emission importance table, which renders
+e.g. fire and explosion grids with far fewer samples than collecting their
+emission along the random walk alone. Emission encountered at sampled
+collisions is only counted where no such connection was possible (directly
+visible media and specular chains), so each emission path contributes exactly
+once.
+
 This integrator has special support for index-matched transmission events (i.e. surface scattering
 events that do not change the direction of light). As a consequence, participating media enclosed by
 a stencil shape are rendered considerably more efficiently when this shape
@@ -77,6 +96,7 @@ public:
                      Medium, MediumPtr, PhaseFunctionContext)
 
     VolumetricPathIntegrator(const Properties &props) : Base(props) {
+        m_equiangular = props.get<bool>("equiangular", false);
     }
 
     MI_INLINE
@@ -121,6 +141,43 @@ public:
             channel = (UInt32) dr::minimum(sampler->next_1d(active) * n_channels, n_channels - 1);
         }
 
+        // Does the scene contain media that can be sampled as light sources?
+        bool have_emissive = !scene->emissive_media().empty();
+
+        /* Collect the delta-position emitters (point/spot lights) targeted by
+           the equiangular sampling strategy, along with their position in the
+           scene's emitter array (needed to evaluate the emitter selection
+           probability when computing MIS weights). */
+        std::vector<const Emitter *> delta_emitters;
+        std::vector<uint32_t> delta_emitter_idx;
+        if (m_equiangular) {
+            const auto &emitters = scene->emitters();
+            for (uint32_t i = 0; i < (uint32_t) emitters.size(); ++i) {
+                if (has_flag(emitters[i]->flags(), EmitterFlags::DeltaPosition)) {
+                    delta_emitters.push_back(emitters[i].get());
+                    delta_emitter_idx.push_back(i);
+                }
+            }
+        }
+        bool use_equiangular = !delta_emitters.empty();
+        uint32_t n_delta = (uint32_t) delta_emitters.size();
+        DynamicBuffer<EmitterPtr> delta_emitters_dr;
+        DynamicBuffer<UInt32> delta_emitter_idx_dr;
+        if (n_delta > 1) {
+            delta_emitters_dr = dr::load<DynamicBuffer<EmitterPtr>>(
+                delta_emitters.data(), n_delta);
+            delta_emitter_idx_dr = dr::load<DynamicBuffer<UInt32>>(
+                delta_emitter_idx.data(), n_delta);
+        }
+
+        /* Per-segment state of the equiangular strategy: whether the current
+           straight-line medium segment still needs an equiangular sample, the
+           distance already travelled along it (null scattering advances the
+           ray origin without changing its direction), and the segment bounds
+           in the parametrization of the segment's first iteration. */
+        Mask equi_pending = active && use_equiangular;
+        Float equi_offset = 0.f, equi_mint = 0.f, equi_maxt = 0.f;
+
         SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
         Mask needs_intersection = true;
         Interaction3f last_scatter_event = dr::zeros<Interaction3f>();
@@ -133,7 +190,8 @@ public:
                             /* loop state: */ active, depth, ray, throughput,
                             result, si, mei, medium, eta, last_scatter_event,
                             last_scatter_direction_pdf, needs_intersection,
-                            specular_chain, valid_ray, sampler);
+                            specular_chain, valid_ray, equi_pending,
+                            equi_offset, equi_mint, equi_maxt, sampler);
 
         while (loop(active)) {
             // ----------------- Handle termination of paths ------------------
@@ -166,7 +224,15 @@ public:
             }
 
             if (dr::any_or<true>(active_medium)) {
-                mei = medium->sample_interaction(ray, sampler->next_1d(active_medium), channel, active_medium);
+                /* On null-scattering iterations, the surface hit found by the
+                   previous accel traversal still bounds the medium segment.
+                   Forward it through ``maxt`` so that lanes whose remaining
+                   overlap with the medium's bounds is empty are culled before
+                   any majorant or density grid lookups take place. */
+                Ray3f medium_ray = ray;
+                dr::masked(medium_ray.maxt, active_medium && !needs_intersection &&
+                                            si.is_valid()) = si.t;
+                mei = medium->sample_interaction(medium_ray, sampler->next_1d(active_medium), channel, active_medium);
                 dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = mei.t;
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
@@ -174,6 +240,127 @@ public:
                 needs_intersection &= !active_medium;
 
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
+
+                /* ------------------ Equiangular sampling ------------------
+
+                   Once per straight-line medium segment, draw one additional
+                   scattering vertex with density proportional to the inverse
+                   squared distance to a randomly chosen point/spot emitter
+                   (equiangular sampling) and connect it to that emitter.
+                   Distance sampling proportional to transmittance is nearly
+                   blind to the 1/r^2 singularity of such lights; the two
+                   strategies are combined via MIS (see the emitter sampling
+                   block below for the weight applied on the distance sampling
+                   side). The surviving ``equi_*`` state lets later
+                   null-scattering iterations of the same segment evaluate
+                   this strategy's density at their own collisions. */
+                if (use_equiangular) {
+                    Mask fired = active_medium && equi_pending;
+                    dr::masked(equi_pending, fired) = false;
+                    dr::masked(equi_offset, fired)  = 0.f;
+                    /* A zeroed segment makes pdf_equiangular() vanish, which
+                       disables the competing MIS weight on the distance
+                       sampling side for segments this strategy cannot cover */
+                    dr::masked(equi_mint, fired) = 0.f;
+                    dr::masked(equi_maxt, fired) = 0.f;
+
+                    Mask active_eq = fired && medium->use_emitter_sampling() &&
+                                     (depth + 1 < (uint32_t) m_max_depth);
+                    if (dr::any_or<true>(active_eq)) {
+                        auto [aabb_its, seg_mint, seg_maxt] =
+                            medium->intersect_aabb(ray);
+                        seg_mint = dr::maximum(seg_mint, 0.f);
+                        seg_maxt = dr::minimum(dr::minimum(seg_maxt, si.t), ray.maxt);
+                        active_eq &= aabb_its && seg_mint < seg_maxt;
+                        dr::masked(equi_mint, active_eq) = seg_mint;
+                        dr::masked(equi_maxt, active_eq) = seg_maxt;
+
+                        // Pick one of the delta-position emitters uniformly
+                        EmitterPtr light;
+                        UInt32 light_index;
+                        if (n_delta == 1) {
+                            light       = EmitterPtr(delta_emitters[0]);
+                            light_index = delta_emitter_idx[0];
+                        } else {
+                            UInt32 index = dr::minimum(
+                                UInt32(sampler->next_1d(active_eq) *
+                                       (ScalarFloat) n_delta), n_delta - 1);
+                            light = dr::gather<EmitterPtr>(delta_emitters_dr,
+                                                           index, active_eq);
+                            light_index = dr::gather<UInt32>(
+                                delta_emitter_idx_dr, index, active_eq);
+                        }
+
+                        /* Locate the emitter -- the sampled position of a
+                           delta emitter does not depend on the reference */
+                        Interaction3f probe = dr::zeros<Interaction3f>();
+                        probe.p           = ray(.5f * (seg_mint + seg_maxt));
+                        probe.time        = ray.time;
+                        probe.wavelengths = ray.wavelengths;
+                        Point3f light_p =
+                            light->sample_direction(probe, Point2f(.5f),
+                                                    active_eq).first.p;
+
+                        auto [t_eq, pdf_eq] = sample_equiangular(
+                            ray.o, ray.d, seg_mint, seg_maxt, light_p,
+                            sampler->next_1d(active_eq));
+                        active_eq &= pdf_eq > 0.f;
+
+                        // Populate a medium interaction at the sampled vertex
+                        MediumInteraction3f mei_eq = dr::zeros<MediumInteraction3f>();
+                        mei_eq.p           = ray(t_eq);
+                        mei_eq.t           = t_eq;
+                        mei_eq.wi          = -ray.d;
+                        mei_eq.sh_frame    = Frame3f(mei_eq.wi);
+                        mei_eq.time        = ray.time;
+                        mei_eq.wavelengths = ray.wavelengths;
+                        mei_eq.medium      = medium;
+                        mei_eq.mint        = seg_mint;
+                        std::tie(mei_eq.sigma_s, mei_eq.sigma_n, mei_eq.sigma_t) =
+                            medium->get_scattering_coefficients(mei_eq, active_eq);
+                        mei_eq.combined_extinction =
+                            medium->get_majorant(mei_eq, active_eq);
+                        active_eq &= dr::any(dr::neq(mei_eq.sigma_s, 0.f));
+
+                        if (dr::any_or<true>(active_eq)) {
+                            auto [ds_eq, em_weight] = light->sample_direction(
+                                mei_eq, sampler->next_2d(active_eq), active_eq);
+                            active_eq &= dr::neq(ds_eq.pdf, 0.f);
+
+                            // Transmittance to the vertex and to the emitter
+                            Ray3f seg_ray = ray;
+                            seg_ray.o     = ray(seg_mint);
+                            Spectrum tr_vertex = estimate_transmittance(
+                                seg_ray, t_eq - seg_mint, medium, scene,
+                                sampler, channel, active_eq);
+                            Spectrum tr_light = estimate_transmittance(
+                                mei_eq.spawn_ray(ds_eq.d), ds_eq.dist, medium,
+                                scene, sampler, channel, active_eq);
+
+                            PhaseFunctionContext phase_ctx_eq(sampler);
+                            Float phase_val = medium->phase_function()->eval(
+                                phase_ctx_eq, mei_eq, ds_eq.d, active_eq);
+
+                            /* MIS against distance sampling. Both sides score
+                               the competing strategy with the same surrogate
+                               density pair -- a single majorant flight from
+                               the segment start vs. the equiangular pdf -- so
+                               the weights sum to one and the combination
+                               remains unbiased. */
+                            Float m_maj = index_spectrum(mei_eq.combined_extinction, channel);
+                            Float pdf_dist = m_maj * dr::exp(-m_maj * (t_eq - seg_mint)) *
+                                             scene->pdf_emitter(light_index, active_eq) *
+                                             ds_eq.pdf;
+                            Float pdf_this = pdf_eq / (ScalarFloat) n_delta;
+
+                            dr::masked(result, active_eq) +=
+                                throughput * tr_vertex * mei_eq.sigma_s *
+                                phase_val * tr_light * em_weight *
+                                mis_weight(pdf_this, pdf_dist) / pdf_this;
+                        }
+                    }
+                }
+
                 if (dr::any_or<true>(is_spectral)) {
                     auto [tr, free_flight_pdf] = medium->eval_tr_and_pdf(mei, si, is_spectral);
                     Float tr_pdf = index_spectrum(free_flight_pdf, channel);
@@ -203,11 +390,37 @@ public:
             act_medium_scatter &= active;
 
             if (dr::any_or<true>(act_null_scatter)) {
+                if (use_equiangular)
+                    dr::masked(equi_offset, act_null_scatter) += mei.t;
                 dr::masked(ray.o, act_null_scatter) = mei.p;
                 dr::masked(si.t, act_null_scatter) = si.t - mei.t;
             }
 
             if (dr::any_or<true>(act_medium_scatter)) {
+                /* ------------------- Volumetric emission -------------------
+
+                   Emission of the medium itself, gathered at the sampled
+                   collision. Only counted when the previous vertex had no
+                   opportunity to connect to emissive media via next event
+                   estimation (see \ref sample_emissive_media()), mirroring
+                   how surface emitter hits are treated along specular
+                   chains -- each emission path is thus counted exactly
+                   once. */
+                if (have_emissive) {
+                    Mask count_emission = act_medium_scatter && specular_chain &&
+                                          medium->is_emitter();
+                    if (dr::any_or<true>(count_emission)) {
+                        UnpolarizedSpectrum emission =
+                            medium->get_emission(mei, count_emission);
+                        dr::masked(result, count_emission && is_spectral) +=
+                            throughput * emission *
+                            index_spectrum(mei.combined_extinction, channel) /
+                            index_spectrum(mei.sigma_t, channel);
+                        dr::masked(result, count_emission && not_spectral) +=
+                            throughput * emission / mei.sigma_t;
+                    }
+                }
+
                 if (dr::any_or<true>(is_spectral))
                     dr::masked(throughput, is_spectral && act_medium_scatter) *=
                         mei.sigma_s * index_spectrum(mei.combined_extinction, channel) / index_spectrum(mei.sigma_t, channel);
@@ -227,8 +440,34 @@ public:
                 if (dr::any_or<true>(active_e)) {
                     auto [emitted, ds] = sample_emitter(mei, scene, sampler, medium, channel, active_e);
                     Float phase_val = phase->eval(phase_ctx, mei, ds.d, active_e);
-                    dr::masked(result, active_e) += throughput * phase_val * emitted *
-                                                    mis_weight(ds.pdf, dr::select(ds.delta, 0.f, phase_val));
+                    Float em_mis = mis_weight(ds.pdf, dr::select(ds.delta, 0.f, phase_val));
+                    if (use_equiangular) {
+                        /* Connections to a point/spot emitter compete with
+                           the equiangular sample drawn at the start of this
+                           segment; evaluate the same surrogate density pair
+                           used there (in the segment's parametrization) */
+                        Mask delta_pos = active_e && dr::neq(ds.emitter, nullptr) &&
+                                         has_flag(ds.emitter->flags(),
+                                                  EmitterFlags::DeltaPosition);
+                        Float t_seg = equi_offset + mei.t;
+                        Float m_maj = index_spectrum(mei.combined_extinction, channel);
+                        Float pdf_dist = m_maj * dr::exp(-m_maj * (t_seg - equi_mint)) * ds.pdf;
+                        Float pdf_eq = pdf_equiangular(
+                            Point3f(ray.o - equi_offset * ray.d), ray.d,
+                            equi_mint, equi_maxt, ds.p, t_seg) / (ScalarFloat) n_delta;
+                        dr::masked(em_mis, delta_pos) *= mis_weight(pdf_dist, pdf_eq);
+                    }
+                    dr::masked(result, active_e) += throughput * phase_val * emitted * em_mis;
+
+                    // Connect to a point sampled inside an emissive medium
+                    if (have_emissive) {
+                        auto [vol_emitted, vol_d] = sample_emissive_media(
+                            mei, scene, sampler, medium, channel, active_e);
+                        Float phase_val_em =
+                            phase->eval(phase_ctx, mei, vol_d, active_e);
+                        dr::masked(result, active_e) +=
+                            throughput * phase_val_em * vol_emitted;
+                    }
                 }
 
                 // ------------------ Phase function sampling -----------------
@@ -241,6 +480,9 @@ public:
                 Ray3f new_ray  = mei.spawn_ray(wo);
                 dr::masked(ray, act_medium_scatter) = new_ray;
                 needs_intersection |= act_medium_scatter;
+                // The scattered ray starts a fresh segment
+                if (use_equiangular)
+                    dr::masked(equi_pending, act_medium_scatter) = true;
                 dr::masked(last_scatter_direction_pdf, act_medium_scatter) = phase_pdf;
             }
 
@@ -289,6 +531,16 @@ public:
                     // direction using BSDF sampling.
                     Float bsdf_pdf = bsdf->pdf(ctx, si, wo, active_e);
                     result[active_e] += throughput * bsdf_val * mis_weight(ds.pdf, dr::select(ds.delta, 0.f, bsdf_pdf)) * emitted;
+
+                    // Connect to a point sampled inside an emissive medium
+                    if (have_emissive) {
+                        auto [vol_emitted, vol_d] = sample_emissive_media(
+                            si, scene, sampler, medium, channel, active_e);
+                        Vector3f wo_em        = si.to_local(vol_d);
+                        Spectrum bsdf_val_em  = bsdf->eval(ctx, si, wo_em, active_e);
+                        bsdf_val_em = si.to_world_mueller(bsdf_val_em, -wo_em, si.wi);
+                        result[active_e] += throughput * bsdf_val_em * vol_emitted;
+                    }
                 }
 
                 // ----------------------- BSDF sampling ----------------------
@@ -302,6 +554,9 @@ public:
                 Ray3f bsdf_ray                  = si.spawn_ray(si.to_world(bs.wo));
                 dr::masked(ray, active_surface) = bsdf_ray;
                 needs_intersection |= active_surface;
+                // Any surface interaction (even a null one) starts a fresh segment
+                if (use_equiangular)
+                    dr::masked(equi_pending, active_surface) = true;
 
                 Mask non_null_bsdf = active_surface && !has_flag(bs.sampled_type, BSDFFlags::Null);
                 dr::masked(depth, non_null_bsdf) += 1;
@@ -329,8 +584,6 @@ public:
     sample_emitter(const Interaction &ref_interaction, const Scene *scene,
                    Sampler *sampler, MediumPtr medium,
                    UInt32 channel, Mask active) const {
-        Spectrum transmittance(1.0f);
-
         auto [ds, emitter_val] = scene->sample_emitter_direction(ref_interaction, sampler->next_2d(active), false, active);
         dr::masked(emitter_val, dr::eq(ds.pdf, 0.f)) = 0.f;
         active &= dr::neq(ds.pdf, 0.f);
@@ -346,6 +599,21 @@ public:
             dr::masked(medium, ref_interaction.is_medium_transition()) =
                 ref_interaction.target_medium(ray.d);
 
+        Spectrum transmittance = estimate_transmittance(
+            ray, ds.dist, medium, scene, sampler, channel, active);
+        return { transmittance * emitter_val, ds };
+    }
+
+    /**
+     * \brief Estimate the transmittance along the segment <tt>[ray.o,
+     * ray(dist)]</tt>, following medium transitions and passing through
+     * null-transmission surfaces
+     */
+    Spectrum estimate_transmittance(Ray3f ray, Float dist, MediumPtr medium,
+                                    const Scene *scene, Sampler *sampler,
+                                    UInt32 channel, Mask active) const {
+        Spectrum transmittance(1.0f);
+
         Float total_dist = 0.f;
         SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
         Mask needs_intersection = true;
@@ -356,7 +624,7 @@ public:
         sampler->loop_put(loop);
         loop.init();
         while (loop(dr::detach(active))) {
-            Float remaining_dist = ds.dist * (1.f - math::ShadowEpsilon<Float>) - total_dist;
+            Float remaining_dist = dist * (1.f - math::ShadowEpsilon<Float>) - total_dist;
             ray.maxt = remaining_dist;
             active &= remaining_dist > 0.f;
             if (dr::none_or<false>(active))
@@ -367,8 +635,9 @@ public:
             Mask active_surface = active && !active_medium;
 
             if (dr::any_or<true>(active_medium)) {
-                auto mei = medium->sample_interaction(ray, sampler->next_1d(active_medium), channel, active_medium);
-                dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = dr::minimum(mei.t, remaining_dist);
+                // Transmittance-only query: media may answer from a coarser density representation
+                auto mei = medium->sample_interaction_tr(ray, sampler->next_1d(active_medium), channel, active_medium);
+                Mask active_homogeneous = active_medium && medium->is_homogeneous();
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
                     dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
@@ -376,8 +645,22 @@ public:
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
                 needs_intersection &= !active_medium;
 
-                Mask is_spectral = medium->has_spectral_extinction() && active_medium;
-                Mask not_spectral = !is_spectral && active_medium;
+                /* Homogeneous media admit an analytic answer: attenuate by a
+                   single exp() over the entire segment and advance directly to
+                   the next surface (or the end of the shadow ray). Chains of
+                   nested homogeneous dielectrics then cost one transmittance
+                   evaluation per boundary rather than a random walk of sampled
+                   collisions. */
+                if (dr::any_or<true>(active_homogeneous)) {
+                    dr::masked(mei.t, active_homogeneous) = dr::minimum(remaining_dist, si.t);
+                    UnpolarizedSpectrum tr_hom =
+                        medium->eval_tr_and_pdf(mei, si, active_homogeneous).first;
+                    dr::masked(transmittance, active_homogeneous) *= tr_hom;
+                    dr::masked(mei.t, active_homogeneous) = dr::Infinity<Float>;
+                }
+
+                Mask is_spectral = medium->has_spectral_extinction() && active_medium && !active_homogeneous;
+                Mask not_spectral = !is_spectral && active_medium && !active_homogeneous;
                 if (dr::any_or<true>(is_spectral)) {
                     Float t      = dr::minimum(remaining_dist, dr::minimum(mei.t, si.t)) - mei.mint;
                     UnpolarizedSpectrum tr  = dr::exp(-t * mei.combined_extinction);
@@ -387,7 +670,7 @@ public:
                 }
 
                 // Handle exceeding the maximum distance by medium sampling
-                dr::masked(total_dist, active_medium && (mei.t > remaining_dist) && mei.is_valid()) = ds.dist;
+                dr::masked(total_dist, active_medium && (mei.t > remaining_dist) && mei.is_valid()) = dist;
                 dr::masked(mei.t, active_medium && (mei.t > remaining_dist)) = dr::Infinity<Float>;
 
                 escaped_medium = active_medium && !mei.is_valid();
@@ -438,7 +721,109 @@ public:
                 dr::masked(medium, has_medium_trans) = si.target_medium(ray.d);
             }
         }
-        return { transmittance * emitter_val, ds };
+        return transmittance;
+    }
+
+    /**
+     * \brief Sample a distance along the segment <tt>[mint, maxt]</tt> of the
+     * ray <tt>(o, d)</tt> with density proportional to the inverse squared
+     * distance to the position \c light_p
+     *
+     * Implements Kulla and Fajardo's equiangular sampling, which cancels the
+     * 1/r^2 falloff of a nearby point light exactly. Returns the sampled
+     * distance and the associated density per unit length (zero if the
+     * segment is degenerate).
+     */
+    std::pair<Float, Float>
+    sample_equiangular(const Point3f &o, const Vector3f &d, Float mint,
+                       Float maxt, const Point3f &light_p, Float u) const {
+        Vector3f rel = light_p - o;
+        Float t_p = dr::dot(rel, d);
+        // Clamp the perpendicular distance to keep lights on the ray finite
+        Float h = dr::sqrt(dr::maximum(dr::squared_norm(rel) - dr::sqr(t_p), 1e-7f));
+        Float theta_a = dr::atan2(mint - t_p, h),
+              theta_b = dr::atan2(maxt - t_p, h);
+        Float t = dr::clamp(t_p + h * dr::tan(dr::lerp(theta_a, theta_b, u)),
+                            mint, maxt);
+        Float pdf = h / ((theta_b - theta_a) * (dr::sqr(h) + dr::sqr(t - t_p)));
+        return { t, dr::select(maxt > mint && dr::isfinite(pdf), pdf, 0.f) };
+    }
+
+    /// Density of \ref sample_equiangular() at the distance \c t
+    Float pdf_equiangular(const Point3f &o, const Vector3f &d, Float mint,
+                          Float maxt, const Point3f &light_p, Float t) const {
+        Vector3f rel = light_p - o;
+        Float t_p = dr::dot(rel, d);
+        Float h = dr::sqrt(dr::maximum(dr::squared_norm(rel) - dr::sqr(t_p), 1e-7f));
+        Float theta_a = dr::atan2(mint - t_p, h),
+              theta_b = dr::atan2(maxt - t_p, h);
+        Float pdf = h / ((theta_b - theta_a) * (dr::sqr(h) + dr::sqr(t - t_p)));
+        Mask valid = maxt > mint && t >= mint && t <= maxt;
+        return dr::select(valid && dr::isfinite(pdf), pdf, 0.f);
+    }
+
+    /**
+     * \brief Sample a point inside an emissive medium and evaluate its
+     * attenuated contribution
+     *
+     * Draws one of the scene's emissive media uniformly, importance samples a
+     * position inside it proportional to its emission (see \ref
+     * Medium::sample_emission_point()) and estimates the transmittance along
+     * the connection segment. Returns the contribution -- emission times
+     * transmittance, divided by the sample density and the squared distance
+     * -- along with the direction towards the sampled point, so that the
+     * caller can apply the phase function or BSDF value.
+     */
+    template <typename Interaction>
+    std::pair<Spectrum, Vector3f>
+    sample_emissive_media(const Interaction &ref_interaction, const Scene *scene,
+                          Sampler *sampler, MediumPtr medium,
+                          UInt32 channel, Mask active) const {
+        const auto &media = scene->emissive_media();
+        uint32_t n = (uint32_t) media.size();
+
+        MediumPtr target;
+        if (n == 1) {
+            target = MediumPtr(media[0].get());
+        } else {
+            UInt32 index = dr::minimum(
+                UInt32(sampler->next_1d(active) * (ScalarFloat) n), n - 1);
+            target = dr::gather<MediumPtr>(scene->emissive_media_dr(), index,
+                                           active);
+        }
+
+        Point2f sample_2 = sampler->next_2d(active);
+        Point3f sample_3(sample_2.x(), sample_2.y(), sampler->next_1d(active));
+        auto [p_em, pdf_pos] = target->sample_emission_point(sample_3, active);
+        pdf_pos /= (ScalarFloat) n; // Uniform selection among emissive media
+        active &= pdf_pos > 0.f;
+
+        Vector3f d = p_em - ref_interaction.p;
+        Float dist2 = dr::squared_norm(d),
+              dist  = dr::sqrt(dist2);
+        d /= dist;
+
+        MediumInteraction3f mei_em = dr::zeros<MediumInteraction3f>();
+        mei_em.p           = p_em;
+        mei_em.wavelengths = ref_interaction.wavelengths;
+        UnpolarizedSpectrum emission = target->get_emission(mei_em, active);
+        active &= dr::any(dr::neq(emission, 0.f));
+
+        if (dr::none_or<false>(active))
+            return { Spectrum(0.f), d };
+
+        Ray3f ray = ref_interaction.spawn_ray(d);
+
+        // Potentially escaping the medium if this is the current medium's boundary
+        if constexpr (std::is_convertible_v<Interaction, SurfaceInteraction3f>)
+            dr::masked(medium, ref_interaction.is_medium_transition()) =
+                ref_interaction.target_medium(ray.d);
+
+        Spectrum transmittance = estimate_transmittance(
+            ray, dist, medium, scene, sampler, channel, active);
+
+        Spectrum contrib = transmittance * emission / (pdf_pos * dist2);
+        return { dr::select(active, contrib, 0.f), d };
     }
 
     //! @}
@@ -460,6 +845,10 @@ public:
     };
 
     MI_DECLARE_CLASS()
+
+private:
+    /// Combine distance sampling with equiangular sampling towards point/spot lights?
+    bool m_equiangular;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(VolumetricPathIntegrator, MonteCarloIntegrator);
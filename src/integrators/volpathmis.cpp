@@ -187,7 +187,10 @@ public:
             last_event_was_null = false;
 
             active &= depth < (uint32_t) m_max_depth;
-            active &= dr::any(dr::neq(unpolarized_spectrum(mis_weight(p_over_f)), 0.f));
+            /* Reuse the MIS throughput computed for Russian roulette above:
+               the roulette reweighting only rescales nonzero entries, so it
+               cannot change the outcome of this test. */
+            active &= dr::any(dr::neq(unpolarized_spectrum(mis_throughput), 0.f));
             if (dr::none_or<false>(active))
                 break;
 
@@ -331,19 +334,38 @@ public:
                 BSDFContext ctx;
                 BSDFPtr bsdf  = si.bsdf(ray);
                 Mask active_e = active_surface && has_flag(bsdf->flags(), BSDFFlags::Smooth) && (depth + 1 < (uint32_t) m_max_depth);
+
+                WeightMatrix p_over_f_nee_end = dr::full<WeightMatrix>(1.f),
+                             p_over_f_end     = dr::full<WeightMatrix>(1.f);
+                Spectrum emitted        = dr::zeros<Spectrum>();
+                DirectionSample3f ds    = dr::zeros<DirectionSample3f>();
+                Vector3f wo_local       = dr::zeros<Vector3f>();
+
+                if (likely(dr::any_or<true>(active_e))) {
+                    std::tie(p_over_f_nee_end, p_over_f_end, emitted, ds) =
+                        sample_emitter(si, scene, sampler, medium, p_over_f,
+                                       channel, active_e);
+                    wo_local = si.to_local(ds.d);
+                }
+
+                /* Fused BSDF evaluation for the NEE direction and BSDF
+                   sampling: internal quantities (e.g. the microfacet
+                   distribution evaluation) are shared between the value, the
+                   pdf and the sampled direction, and only a single vcall is
+                   dispatched per vertex. */
+                auto [bsdf_val, bsdf_pdf, bs, bsdf_weight] =
+                    bsdf->eval_pdf_sample(ctx, si, wo_local,
+                                          sampler->next_1d(active_surface),
+                                          sampler->next_2d(active_surface),
+                                          active_surface);
+
                 if (likely(dr::any_or<true>(active_e))) {
-                    auto [p_over_f_nee_end, p_over_f_end, emitted, ds] = sample_emitter(si, scene, sampler, medium, p_over_f, channel, active_e);
-                    Vector3f wo_local       = si.to_local(ds.d);
-                    Spectrum bsdf_val = bsdf->eval(ctx, si, wo_local, active_e);
-                    Float bsdf_pdf =  bsdf->pdf(ctx, si, wo_local, active_e);
                     update_weights(p_over_f_nee_end, 1.0f, unpolarized_spectrum(bsdf_val), channel, active_e);
                     update_weights(p_over_f_end, dr::select(ds.delta, 0.f, bsdf_pdf), unpolarized_spectrum(bsdf_val), channel, active_e);
                     dr::masked(result, active_e) += mis_weight(p_over_f_nee_end, p_over_f_end) * emitted;
                 }
 
                 // ----------------------- BSDF sampling ----------------------
-                auto [bs, bsdf_weight] = bsdf->sample(ctx, si, sampler->next_1d(active_surface),
-                                                   sampler->next_2d(active_surface), active_surface);
                 Mask invalid_bsdf_sample = active_surface && dr::eq(bs.pdf, 0.f);
                 active_surface &= bs.pdf > 0.f;
                 dr::masked(eta, active_surface) *= bs.eta;
@@ -420,16 +442,30 @@ public:
             Mask active_surface = active && !active_medium;
 
             if (dr::any_or<true>(active_medium)) {
-                auto mei = medium->sample_interaction(ray, sampler->next_1d(active_medium), channel, active_medium);
-                dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = dr::minimum(mei.t, remaining_dist);
+                // Transmittance-only query: media may answer from a coarser density representation
+                auto mei = medium->sample_interaction_tr(ray, sampler->next_1d(active_medium), channel, active_medium);
+                Mask active_homogeneous = active_medium && medium->is_homogeneous();
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
                     dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
                 needs_intersection &= !active_medium;
 
-                Mask is_spectral = medium->has_spectral_extinction() && active_medium;
-                Mask not_spectral = !is_spectral && active_medium;
+                /* Homogeneous media admit an analytic answer: attenuate by a
+                   single exp() over the entire segment and advance directly to
+                   the next surface (or the end of the shadow ray). See the
+                   corresponding fast path in the volpath integrator. */
+                if (dr::any_or<true>(active_homogeneous)) {
+                    dr::masked(mei.t, active_homogeneous) = dr::minimum(remaining_dist, si.t);
+                    UnpolarizedSpectrum tr_hom =
+                        medium->eval_tr_and_pdf(mei, si, active_homogeneous).first;
+                    update_weights(p_over_f_nee, 1.f, tr_hom, channel, active_homogeneous);
+                    update_weights(p_over_f_uni, 1.f, tr_hom, channel, active_homogeneous);
+                    dr::masked(mei.t, active_homogeneous) = dr::Infinity<Float>;
+                }
+
+                Mask is_spectral = medium->has_spectral_extinction() && active_medium && !active_homogeneous;
+                Mask not_spectral = !is_spectral && active_medium && !active_homogeneous;
                 if (dr::any_or<true>(is_spectral)) {
                     Float t      = dr::minimum(remaining_dist, dr::minimum(mei.t, si.t)) - mei.mint;
                     UnpolarizedSpectrum tr  = dr::exp(-t * mei.combined_extinction);
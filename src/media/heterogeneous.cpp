@@ -1,3 +1,4 @@
+#include <mitsuba/core/distr_1d.h>
 #include <mitsuba/core/frame.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/spectrum.h>
@@ -38,6 +39,45 @@ Heterogeneous medium (:monosp:`heterogeneous`)
      units, or to simply tweak the density of the medium. (Default: 1)
    - |exposed|
 
+ * - majorant_resolution_factor
+   - |int|
+   - When nonzero, the plugin builds a coarse super-grid of local majorants
+     whose resolution equals the extinction grid's resolution divided by this
+     factor. Free-flight sampling then steps through this grid (in the manner
+     of a DDA) instead of relying on a single global majorant, which greatly
+     reduces the number of null collisions -- and hence density evaluations --
+     in sparse media such as clouds, where local densities can be orders of
+     magnitude below the global maximum. A factor of 8 is a reasonable
+     starting point. (Default: 0, i.e. a single global majorant)
+
+ * - shadow_mip_level
+   - |int|
+   - Mip level of the extinction volume that is used to answer
+     transmittance-only (shadow ray) queries. This requires the nested
+     :paramtype:`sigma_t` volume to provide a mip hierarchy (see the
+     :paramtype:`mip_levels` parameter of the :ref:`gridvolume
+     <volume-gridvolume>` plugin). Each level halves the grid resolution,
+     which makes ratio tracking along shadow connections substantially
+     cheaper at the cost of a small amount of bias that is usually invisible
+     for dense media such as clouds or smoke. Radiance-carrying (camera path)
+     queries always use the full-resolution data. (Default: 0, i.e. exact
+     shadow transmittance)
+
+ * - emission
+   - |float|, |spectrum| or |volume|
+   - Emission coefficient of the medium: the emitted radiance per unit
+     length, i.e. the product of the absorption coefficient and the emitted
+     radiance (Default: no emission). When specified, the plugin additionally
+     builds a discrete importance table over the emission grid at load time
+     so that integrators can sample points inside the emissive region
+     directly (see :ref:`volpath <integrator-volpath>`).
+   - |exposed|
+
+ * - emission_scale
+   - |float|
+   - Optional scale factor applied to the emission coefficient. (Default: 1)
+   - |exposed|
+
  * - sample_emitters
    - |bool|
    - Flag to specify whether shadow rays should be cast from inside the volume (Default: |true|)
@@ -149,7 +189,7 @@ template <typename Float, typename Spectrum>
 class HeterogeneousMedium final : public Medium<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(Medium, m_is_homogeneous, m_has_spectral_extinction,
-                    m_phase_function)
+                    m_phase_function, m_is_emitter)
     MI_IMPORT_TYPES(Scene, Sampler, Texture, Volume)
 
     HeterogeneousMedium(const Properties &props) : Base(props) {
@@ -159,29 +199,164 @@ public:
 
         m_scale = props.get<ScalarFloat>("scale", 1.0f);
         m_has_spectral_extinction = props.get<bool>("has_spectral_extinction", true);
+        m_shadow_mip_level = props.get<uint32_t>("shadow_mip_level", 0);
+        if (m_shadow_mip_level > 0 && m_sigmat->mip_level_count() == 1)
+            Log(Warn, "\"shadow_mip_level\" was specified, but the extinction "
+                      "volume does not provide a mip hierarchy (see the "
+                      "\"mip_levels\" parameter of the \"gridvolume\" "
+                      "plugin). Shadow transmittance queries will use the "
+                      "full-resolution data.");
 
         m_max_density = dr::opaque<Float>(m_scale * m_sigmat->max());
 
+        m_majorant_factor =
+            props.get<uint32_t>("majorant_resolution_factor", 0);
+        update_majorant_supergrid();
+
+        if (props.has_property("emission")) {
+            m_emission = props.volume<Volume>("emission", 0.f);
+            m_emission_scale = props.get<ScalarFloat>("emission_scale", 1.f);
+            update_emission_distribution();
+        }
+
         dr::set_attr(this, "is_homogeneous", m_is_homogeneous);
         dr::set_attr(this, "has_spectral_extinction", m_has_spectral_extinction);
+        dr::set_attr(this, "is_emitter", m_is_emitter);
+    }
+
+    /**
+     * \brief Rebuild the discrete emission importance table
+     *
+     * The table stores the mean emission of every cell of a regular grid with
+     * the emission volume's native resolution, laid over its world-space
+     * bounding box. \ref sample_emission_point() first draws a cell
+     * proportional to this table and then a uniform position within it.
+     */
+    void update_emission_distribution() {
+        ScalarVector3i res = m_emission->resolution();
+        m_emission_res = ScalarVector3u(res.x(), res.y(), res.z());
+        m_emission_bbox = m_emission->bbox();
+
+        uint32_t n = m_emission_res.x() * m_emission_res.y() *
+                     m_emission_res.z();
+        ScalarVector3f extents = m_emission_bbox.extents();
+        m_voxel_volume = dr::prod(extents) / (ScalarFloat) n;
+
+        FloatStorage pmf;
+        if constexpr (dr::is_jit_v<Float>) {
+            UInt32 index = dr::arange<UInt32>(n);
+            pmf = eval_emission_cell(index, true);
+        } else {
+            std::unique_ptr<ScalarFloat[]> values(new ScalarFloat[n]);
+            for (uint32_t i = 0; i < n; ++i)
+                values[i] = eval_emission_cell(i, true);
+            pmf = dr::load<FloatStorage>(values.get(), n);
+        }
+
+        if (dr::slice(dr::sum(pmf)) == 0.f) {
+            Log(Warn, "The \"emission\" volume is everywhere zero; direct "
+                      "sampling of this medium's emission is disabled.");
+            m_is_emitter = false;
+            return;
+        }
+
+        m_emission_distr = DiscreteDistribution<Float>(pmf);
+        m_is_emitter = true;
+    }
+
+    /**
+     * \brief Rebuild the super-grid of local majorants
+     *
+     * Each cell stores a conservative bound of the scaled extinction over
+     * the cell, obtained via \ref Volume::max_per_cell(). Cells are floored
+     * at a small fraction of the global majorant: a zero-valued majorant
+     * would produce zero-valued sampling densities (terminating paths
+     * prematurely), whereas the floor lets free-flight sampling cross fully
+     * empty regions in a single step per cell.
+     */
+    void update_majorant_supergrid() {
+        if (m_majorant_factor == 0)
+            return;
+
+        ScalarVector3i res =
+            dr::maximum(m_sigmat->resolution() / (int) m_majorant_factor, 1);
+        m_majorant_res = ScalarVector3u(res.x(), res.y(), res.z());
+        m_majorant_bbox = m_sigmat->bbox();
+
+        size_t n = (size_t) m_majorant_res.x() * m_majorant_res.y() *
+                   m_majorant_res.z();
+        std::unique_ptr<ScalarFloat[]> values(new ScalarFloat[n]);
+        m_sigmat->max_per_cell(m_majorant_res, values.get());
+
+        ScalarFloat lower_bound = 1e-4f * m_scale * m_sigmat->max();
+        for (size_t i = 0; i < n; ++i)
+            values[i] = dr::maximum(m_scale * values[i], lower_bound);
+
+        m_majorant_grid = dr::load<FloatStorage>(values.get(), n);
     }
 
     void traverse(TraversalCallback *callback) override {
         callback->put_parameter("scale", m_scale,        +ParamFlags::NonDifferentiable);
         callback->put_object("albedo",   m_albedo.get(), +ParamFlags::Differentiable);
         callback->put_object("sigma_t",  m_sigmat.get(), +ParamFlags::Differentiable);
+        if (m_emission) {
+            callback->put_parameter("emission_scale", m_emission_scale, +ParamFlags::NonDifferentiable);
+            callback->put_object("emission", m_emission.get(), +ParamFlags::NonDifferentiable);
+        }
         Base::traverse(callback);
     }
 
     void parameters_changed(const std::vector<std::string> &/*keys*/ = {}) override {
         m_max_density = dr::opaque<Float>(m_scale * m_sigmat->max());
+        update_majorant_supergrid();
+        if (m_emission)
+            update_emission_distribution();
     }
 
     UnpolarizedSpectrum
-    get_majorant(const MediumInteraction3f & /* mi */,
+    get_majorant(const MediumInteraction3f &mi,
                  Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::MediumEvaluate, active);
-        return m_max_density;
+        if (m_majorant_factor == 0)
+            return m_max_density;
+        return UnpolarizedSpectrum(local_majorant(mi.p, active));
+    }
+
+    std::pair<UnpolarizedSpectrum, Float>
+    get_majorant_segment(const Ray3f &ray, Float mint, Float maxt,
+                         Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::MediumEvaluate, active);
+        DRJIT_MARK_USED(maxt);
+
+        if (m_majorant_factor == 0)
+            return { m_max_density, dr::Infinity<Float> };
+
+        ScalarVector3f extents = m_majorant_bbox.extents();
+        Point3f rel = (ray(mint) - m_majorant_bbox.min) / Vector3f(extents);
+        Point3f cell = dr::clamp(dr::floor(rel * majorant_res_f()), 0.f,
+                                 majorant_res_f() - 1.f);
+
+        UInt32 ix = UInt32(cell.x()), iy = UInt32(cell.y()),
+               iz = UInt32(cell.z());
+        UInt32 index = (iz * m_majorant_res.y() + iy) * m_majorant_res.x() + ix;
+        Float majorant = dr::gather<Float>(m_majorant_grid, index, active);
+
+        // Ray distance at which the current cell is exited
+        ScalarVector3f cell_extent = extents / ScalarVector3f(
+            (ScalarFloat) m_majorant_res.x(), (ScalarFloat) m_majorant_res.y(),
+            (ScalarFloat) m_majorant_res.z());
+        Point3f cell_min = m_majorant_bbox.min + Vector3f(cell) * cell_extent;
+        BoundingBox3f cell_bbox(cell_min, cell_min + cell_extent);
+        Float t_exit = dr::maximum(std::get<2>(cell_bbox.ray_intersect(ray)),
+                                   mint);
+
+        /* Nudge the expiry distance past the boundary so that the next
+           query lands in the adjacent cell. The node dilation performed in
+           \ref Volume::max_per_cell() keeps the bound valid across this
+           overshoot. */
+        t_exit = dr::fmadd(dr::abs(t_exit), math::RayEpsilon<Float>,
+                           t_exit + math::RayEpsilon<Float>);
+        return { UnpolarizedSpectrum(majorant), t_exit };
     }
 
     std::tuple<UnpolarizedSpectrum, UnpolarizedSpectrum, UnpolarizedSpectrum>
@@ -194,10 +369,97 @@ public:
             sigmat *= m_phase_function->projected_area(mi, active);
 
         auto sigmas = sigmat * m_albedo->eval(mi, active);
-        auto sigman = m_max_density - sigmat;
+
+        /* The null component must complement sigma_t w.r.t. the same
+           majorant that get_majorant() reports at this position */
+        auto sigman = (m_majorant_factor == 0)
+                          ? m_max_density - sigmat
+                          : local_majorant(mi.p, active) - sigmat;
         return { sigmas, sigman, sigmat };
     }
 
+    std::tuple<UnpolarizedSpectrum, UnpolarizedSpectrum, UnpolarizedSpectrum>
+    get_scattering_coefficients_tr(const MediumInteraction3f &mi,
+                                   Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::MediumEvaluate, active);
+
+        if (m_shadow_mip_level == 0)
+            return get_scattering_coefficients(mi, active);
+
+        /* Shadow connections only use the null component and the majorant.
+           Answer the density query from a coarser mip level and skip the
+           albedo lookup entirely. Mip levels are box-filtered, so the
+           majorant of the full-resolution grid remains valid here. */
+        auto sigmat =
+            m_scale * m_sigmat->eval_lod(mi, m_shadow_mip_level, active);
+        if (has_flag(m_phase_function->flags(), PhaseFunctionFlags::Microflake))
+            sigmat *= m_phase_function->projected_area(mi, active);
+
+        if (m_majorant_factor == 0)
+            return { dr::zeros<UnpolarizedSpectrum>(), m_max_density - sigmat,
+                     sigmat };
+
+        /* Box-filtered mip values may locally exceed a cell's majorant near
+           sharp density boundaries; clamp to keep the null component
+           non-negative (consistent with the bias already accepted in this
+           mode). */
+        UnpolarizedSpectrum majorant(local_majorant(mi.p, active));
+        sigmat = dr::minimum(sigmat, majorant);
+        return { dr::zeros<UnpolarizedSpectrum>(), majorant - sigmat, sigmat };
+    }
+
+    UnpolarizedSpectrum get_emission(const MediumInteraction3f &mi,
+                                     Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::MediumEvaluate, active);
+        if (!m_emission)
+            return dr::zeros<UnpolarizedSpectrum>();
+        return m_emission_scale * m_emission->eval(mi, active);
+    }
+
+    std::pair<Point3f, Float>
+    sample_emission_point(const Point3f &sample, Mask active) const override {
+        if (!m_is_emitter)
+            return { dr::zeros<Point3f>(), 0.f };
+
+        auto [index, rescaled] = m_emission_distr.sample_reuse(sample.x(), active);
+
+        UInt32 nx = m_emission_res.x(),
+               ny = m_emission_res.y();
+        UInt32 iz  = index / (nx * ny),
+               rem = index - iz * nx * ny,
+               iy  = rem / nx,
+               ix  = rem - iy * nx;
+
+        // Uniform position within the sampled cell
+        Point3f rel = (Point3f(Float(ix), Float(iy), Float(iz)) +
+                       Point3f(rescaled, sample.y(), sample.z())) *
+                      dr::rcp(emission_res_f());
+        Point3f p = m_emission_bbox.min +
+                    rel * Vector3f(m_emission_bbox.extents());
+
+        Float pdf = m_emission_distr.eval_pmf_normalized(index, active) /
+                    m_voxel_volume;
+        return { p, dr::select(active, pdf, 0.f) };
+    }
+
+    Float pdf_emission_point(const Point3f &p, Mask active) const override {
+        if (!m_is_emitter)
+            return 0.f;
+
+        Point3f rel = (p - m_emission_bbox.min) /
+                      Vector3f(m_emission_bbox.extents());
+        active &= dr::all(rel >= 0.f && rel < 1.f);
+
+        Point3f cell = dr::floor(rel * emission_res_f());
+        UInt32 ix = UInt32(cell.x()), iy = UInt32(cell.y()),
+               iz = UInt32(cell.z());
+        UInt32 index = (iz * m_emission_res.y() + iy) * m_emission_res.x() + ix;
+
+        Float pdf = m_emission_distr.eval_pmf_normalized(index, active) /
+                    m_voxel_volume;
+        return dr::select(active, pdf, 0.f);
+    }
+
     std::tuple<Mask, Float, Float>
     intersect_aabb(const Ray3f &ray) const override {
         return m_sigmat->bbox().ray_intersect(ray);
@@ -208,17 +470,84 @@ public:
         oss << "HeterogeneousMedium[" << std::endl
             << "  albedo  = " << string::indent(m_albedo) << std::endl
             << "  sigma_t = " << string::indent(m_sigmat) << std::endl
-            << "  scale   = " << string::indent(m_scale) << std::endl
-            << "]";
+            << "  scale   = " << string::indent(m_scale) << std::endl;
+        if (m_emission)
+            oss << "  emission = " << string::indent(m_emission) << std::endl;
+        oss << "]";
         return oss.str();
     }
 
     MI_DECLARE_CLASS()
+private:
+    using FloatStorage = DynamicBuffer<Float>;
+
+    /// Mean emission over the channels of one cell of the importance grid
+    Float eval_emission_cell(const UInt32 &index, Mask active) const {
+        UInt32 nx = m_emission_res.x(),
+               ny = m_emission_res.y();
+        UInt32 iz  = index / (nx * ny),
+               rem = index - iz * nx * ny,
+               iy  = rem / nx,
+               ix  = rem - iy * nx;
+
+        MediumInteraction3f mei = dr::zeros<MediumInteraction3f>();
+        mei.p = m_emission_bbox.min +
+                (Point3f(Float(ix), Float(iy), Float(iz)) + 0.5f) *
+                    dr::rcp(emission_res_f()) *
+                    Vector3f(m_emission_bbox.extents());
+
+        if (m_emission->channel_count() == 1)
+            return m_emission->eval_1(mei, active);
+        else
+            return dr::mean(m_emission->eval(mei, active));
+    }
+
+    /// Resolution of the emission importance grid as a floating point vector
+    Point3f emission_res_f() const {
+        return Point3f((ScalarFloat) m_emission_res.x(),
+                       (ScalarFloat) m_emission_res.y(),
+                       (ScalarFloat) m_emission_res.z());
+    }
+
+    /// Local majorant of the super-grid cell containing the given position
+    Float local_majorant(const Point3f &p, Mask active) const {
+        Point3f rel = (p - m_majorant_bbox.min) /
+                      Vector3f(m_majorant_bbox.extents());
+        Point3f cell = dr::clamp(dr::floor(rel * majorant_res_f()), 0.f,
+                                 majorant_res_f() - 1.f);
+        UInt32 ix = UInt32(cell.x()), iy = UInt32(cell.y()),
+               iz = UInt32(cell.z());
+        UInt32 index = (iz * m_majorant_res.y() + iy) * m_majorant_res.x() + ix;
+        return dr::gather<Float>(m_majorant_grid, index, active);
+    }
+
+    /// Resolution of the majorant super-grid as a floating point vector
+    Point3f majorant_res_f() const {
+        return Point3f((ScalarFloat) m_majorant_res.x(),
+                       (ScalarFloat) m_majorant_res.y(),
+                       (ScalarFloat) m_majorant_res.z());
+    }
+
 private:
     ref<Volume> m_sigmat, m_albedo;
     ScalarFloat m_scale;
+    uint32_t m_shadow_mip_level;
 
     Float m_max_density;
+
+    /// Super-grid of local majorants (see the plugin documentation)
+    uint32_t m_majorant_factor;
+    ScalarVector3u m_majorant_res = 1;
+    ScalarBoundingBox3f m_majorant_bbox;
+    FloatStorage m_majorant_grid;
+
+    /// Optional volumetric emission (see the plugin documentation)
+    ref<Volume> m_emission;
+    ScalarFloat m_emission_scale = 1.f;
+    ScalarVector3u m_emission_res = 1;
+    ScalarBoundingBox3f m_emission_bbox;
+    ScalarFloat m_voxel_volume = 0.f;
+    DiscreteDistribution<Float> m_emission_distr;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(HeterogeneousMedium, Medium)
@@ -14,6 +14,9 @@
 #include <mitsuba/render/records.h>
 #include <mitsuba/render/scene.h>
 
+#include <fstream>
+#include <iostream>
+
 #if !defined(_WIN32)
 #  include <signal.h>
 #else
@@ -65,6 +68,27 @@ Options:
     -o <filename>, --output <filename>
         Write the output image to the file "filename".
 
+    -b <jobfile>, --batch <jobfile>
+        Batch mode for rendering many frames of the same scene (e.g.
+        animations with per-frame camera changes): the scene is loaded
+        once, then one frame is rendered per line of "jobfile" (or of
+        the standard input when "-" is specified), reusing the scene,
+        acceleration data structures and compiled kernels across frames.
+        Each line consists of whitespace-separated key=value entries:
+
+            output=<filename>     output image of this frame (required)
+            seed=<integer>        sample generator seed (default: 0)
+            to_world=<m00>,<m01>,...,<m33>
+                                  sensor transform as 16 comma-separated
+                                  row-major matrix entries (optional)
+
+        Empty lines and lines starting with '#' are ignored.
+
+    -T <filename>, --trace <filename>
+        Record a timeline of the profiler phases executed by each thread
+        and write it to "filename" in the JSON format understood by the
+        chrome://tracing page and https://ui.perfetto.dev.
+
  === The following options are only relevant for JIT (CUDA/LLVM) modes ===
 
     -O [0-5]
@@ -138,6 +162,121 @@ void render(Object *scene_, size_t sensor_i, fs::path filename) {
     film->write(filename);
 }
 
+/* Render a sequence of frames of an already-loaded scene, one per line of the
+   provided job stream. Scene, acceleration data structures and compiled
+   kernels persist across frames, so only the per-frame updates (sensor
+   transform, seed) are re-evaluated. */
+template <typename Float, typename Spectrum>
+void render_batch(Object *scene_, size_t sensor_i, std::istream &jobs) {
+    MI_IMPORT_CORE_TYPES()
+
+    auto *scene = dynamic_cast<Scene<Float, Spectrum> *>(scene_);
+    if (!scene)
+        Throw("Root element of the input file must be a <scene> tag!");
+    if (scene->sensors().empty())
+        Throw("No sensor specified for scene: %s", scene);
+    if (sensor_i >= scene->sensors().size())
+        Throw("Specified sensor index is out of bounds!");
+    auto sensor = scene->sensors()[sensor_i];
+    auto film = sensor->film();
+
+    auto integrator = scene->integrator();
+    if (!integrator)
+        Throw("No integrator specified for scene: %s", scene);
+
+    /* Minimal traversal callback that overwrites the sensor's 'to_world'
+       parameter in place; all other parameters are left untouched */
+    struct TransformSetter final : public TraversalCallback {
+        Transform4f value;
+        bool applied = false;
+
+        void put_object(const std::string &, Object *, uint32_t) override { }
+
+    protected:
+        void put_parameter_impl(const std::string &name, void *ptr,
+                                uint32_t /* flags */,
+                                const std::type_info &type) override {
+            if (name == "to_world" && type == typeid(Transform4f)) {
+                *((Transform4f *) ptr) = value;
+                applied = true;
+            }
+        }
+    };
+
+    size_t frame = 0;
+    std::string line;
+    while (std::getline(jobs, line)) {
+        line = string::trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        fs::path filename;
+        uint32_t seed = 0;
+        bool has_transform = false;
+        ScalarMatrix4f matrix;
+
+        for (const std::string &token : string::tokenize(line, " \t")) {
+            auto sep = token.find('=');
+            if (sep == std::string::npos)
+                Throw("Batch mode: expected key=value pair, got \"%s\"!", token);
+            std::string key   = token.substr(0, sep),
+                        value = token.substr(sep + 1);
+
+            if (key == "output") {
+                filename = value;
+            } else if (key == "seed") {
+                seed = (uint32_t) std::strtoul(value.c_str(), nullptr, 10);
+            } else if (key == "to_world") {
+                std::vector<std::string> entries = string::tokenize(value, ",");
+                if (entries.size() != 16)
+                    Throw("Batch mode: 'to_world' requires 16 comma-separated "
+                          "matrix entries, got %zu!", entries.size());
+                for (size_t i = 0; i < 16; ++i)
+                    matrix(i / 4, i % 4) = string::stof<ScalarFloat>(entries[i]);
+                has_transform = true;
+            } else {
+                Throw("Batch mode: unknown key \"%s\" (expected \"output\", "
+                      "\"seed\" or \"to_world\")!", key);
+            }
+        }
+
+        if (filename.empty())
+            Throw("Batch mode: every frame requires an \"output\" entry!");
+
+        if (has_transform) {
+            TransformSetter setter;
+            setter.value = Transform4f(Matrix4f(matrix));
+            sensor->traverse(&setter);
+            if (!setter.applied)
+                Throw("Batch mode: the sensor does not expose a 'to_world' "
+                      "parameter!");
+            sensor->parameters_changed({ "to_world" });
+        }
+
+        Log(Info, "Batch mode: rendering frame %zu -> \"%s\"", frame,
+            filename.string());
+
+        /* critical section */ {
+            std::lock_guard<std::mutex> guard(develop_callback_mutex);
+            develop_callback = [&]() { film->write(filename); };
+        }
+
+        integrator->render(scene, (uint32_t) sensor_i, seed, 0 /* spp */,
+                           false /* develop */, true /* evaluate */);
+
+        /* critical section */ {
+            std::lock_guard<std::mutex> guard(develop_callback_mutex);
+            develop_callback = nullptr;
+        }
+
+        film->write(filename);
+        frame++;
+    }
+
+    Log(Info, "Batch mode: finished rendering %zu frame%s.", frame,
+        frame == 1 ? "" : "s");
+}
+
 #if !defined(_WIN32)
 // Handle the hang-up signal and write a partially rendered image to disk
 void hup_signal_handler(int signal) {
@@ -166,6 +305,8 @@ int main(int argc, char *argv[]) {
     auto arg_define    = parser.add(StringVec{ "-D", "--define" }, true);
     auto arg_sensor_i  = parser.add(StringVec{ "-s", "--sensor" }, true);
     auto arg_output    = parser.add(StringVec{ "-o", "--output" }, true);
+    auto arg_batch     = parser.add(StringVec{ "-b", "--batch" }, true);
+    auto arg_trace     = parser.add(StringVec{ "-T", "--trace" }, true);
     auto arg_update    = parser.add(StringVec{ "-u", "--update" }, false);
     auto arg_help      = parser.add(StringVec{ "-h", "--help" });
     auto arg_mode      = parser.add(StringVec{ "-m", "--mode" }, true);
@@ -306,6 +447,8 @@ int main(int argc, char *argv[]) {
             Throw("Specified an argument that only makes sense in a JIT (LLVM/CUDA) mode!");
 
         Profiler::static_initialization();
+        if (*arg_trace)
+            Profiler::set_trace_enabled(true);
         color_management_static_initialization(cuda, llvm);
 
         MI_INVOKE_VARIANT(mode, scene_static_accel_initialization);
@@ -362,9 +505,29 @@ int main(int argc, char *argv[]) {
                 Throw("Root element of the input file is expanded into "
                       "multiple objects, only a single object is expected!");
 
-            MI_INVOKE_VARIANT(mode, render, parsed[0].get(), sensor_i, filename);
+            if (*arg_batch) {
+                std::string job_file = arg_batch->as_string();
+                if (job_file == "-") {
+                    MI_INVOKE_VARIANT(mode, render_batch, parsed[0].get(),
+                                      sensor_i, std::cin);
+                } else {
+                    std::ifstream jobs(job_file);
+                    if (!jobs.good())
+                        Throw("Could not open batch job file \"%s\"!", job_file);
+                    MI_INVOKE_VARIANT(mode, render_batch, parsed[0].get(),
+                                      sensor_i, jobs);
+                }
+            } else {
+                MI_INVOKE_VARIANT(mode, render, parsed[0].get(), sensor_i,
+                                  filename);
+            }
             arg_extra = arg_extra->next();
         }
+
+        if (*arg_trace) {
+            Profiler::set_trace_enabled(false);
+            Profiler::write_trace(arg_trace->as_string());
+        }
     } catch (const std::exception &e) {
         error_msg = std::string("Caught a critical exception: ") + e.what();
     } catch (...) {
@@ -66,18 +66,80 @@ public:
         m_flags =
             PhaseFunctionFlags::Anisotropic | PhaseFunctionFlags::Microflake;
         dr::set_attr(this, "flags", m_flags);
+
+        update_parameter_cache();
     }
 
     void traverse(TraversalCallback *callback) override {
         callback->put_parameter("S", m_ndf_params, +ParamFlags::Differentiable);
     }
 
+    void parameters_changed(const std::vector<std::string> & /*keys*/) override {
+        update_parameter_cache();
+    }
+
+    /**
+     * \brief Cache the SGGX parameters along with derived quantities when the
+     * underlying volume is spatially uniform
+     *
+     * Cloth/fiber media scatter dozens of times per path, and every event
+     * evaluates the NDF and projected area. For a uniform matrix \c S, the
+     * volume lookup, the determinant and the adjugate entries appearing in
+     * the NDF denominator are loop invariants, so they are computed once
+     * here instead of once per scattering event.
+     */
+    void update_parameter_cache() {
+        m_uniform =
+            dr::all(m_ndf_params->resolution() == ScalarVector3i(1, 1, 1));
+        if (!m_uniform)
+            return;
+
+        constexpr size_t XX = 0, YY = 1, ZZ = 2, XY = 3, XZ = 4, YZ = 5;
+
+        // Probe the (constant) parameters at the volume's center
+        Interaction3f it = dr::zeros<Interaction3f>();
+        it.p = Point3f(m_ndf_params->bbox().center());
+        dr::Array<Float, 6> s = m_ndf_params->eval_6(it, true);
+
+        // Adjugate of S, i.e. the cofactors forming the NDF denominator
+        m_adj_cache = dr::Array<Float, 6>(
+            s[YY] * s[ZZ] - s[YZ] * s[YZ],
+            s[XX] * s[ZZ] - s[XZ] * s[XZ],
+            s[XX] * s[YY] - s[XY] * s[XY],
+            s[XZ] * s[YZ] - s[ZZ] * s[XY],
+            s[XY] * s[YZ] - s[YY] * s[XZ],
+            s[XY] * s[XZ] - s[XX] * s[YZ]);
+
+        Float det_s = dr::abs(s[XX] * m_adj_cache[XX] +
+                              s[XY] * m_adj_cache[XY] +
+                              s[XZ] * m_adj_cache[XZ]);
+        m_ndf_norm_cache = dr::maximum(det_s, 0.f) * dr::safe_sqrt(det_s);
+        m_s_cache = s;
+
+        dr::make_opaque(m_s_cache, m_adj_cache, m_ndf_norm_cache);
+    }
+
     MI_INLINE
     dr::Array<Float, 6> eval_ndf_params(const MediumInteraction3f &mi,
                                         Mask active) const {
+        if (m_uniform)
+            return m_s_cache;
         return m_ndf_params->eval_6(mi, active);
     }
 
+    /// Evaluate the NDF using the cached determinant/adjugate (uniform case)
+    MI_INLINE Float ndf_pdf_cached(const Vector3f &wm) const {
+        constexpr size_t XX = 0, YY = 1, ZZ = 2, XY = 3, XZ = 4, YZ = 5;
+        const dr::Array<Float, 6> &a = m_adj_cache;
+
+        Float den = wm.x() * wm.x() * a[XX] + wm.y() * wm.y() * a[YY] +
+                    wm.z() * wm.z() * a[ZZ] +
+                    2.f * (wm.x() * wm.y() * a[XY] +
+                           wm.x() * wm.z() * a[XZ] +
+                           wm.y() * wm.z() * a[YZ]);
+        return m_ndf_norm_cache / (dr::Pi<Float> * dr::sqr(den));
+    }
+
     std::pair<Vector3f, Float> sample(const PhaseFunctionContext & /* ctx */,
                                       const MediumInteraction3f &mi,
                                       const Float /* sample1 */,
@@ -98,8 +160,9 @@ public:
            wo = frame.to_world(wo);
            return {wo, pdf};
            } else { */
-        Float pdf = 0.25f * sggx_ndf_pdf(Vector3f(sampled_n), s) /
-                    sggx_projected_area(mi.wi, s);
+        Float ndf = m_uniform ? ndf_pdf_cached(Vector3f(sampled_n))
+                              : sggx_ndf_pdf(Vector3f(sampled_n), s);
+        Float pdf = 0.25f * ndf / sggx_projected_area(mi.wi, s);
         Vector3f wo = dr::normalize(reflect(mi.wi, sampled_n));
         return { wo, pdf };
         // }
@@ -114,8 +177,9 @@ public:
            auto sampled_n = sggx_sample_vndf(mi.sh_frame,
            ctx.sampler->next_2d(active), s); return dr::InvPi<Float> *
            dr::maximum(dr::dot(wo, sampled_n), 0.f); } else { */
-        return 0.25f * sggx_ndf_pdf(dr::normalize(wo + mi.wi), s) /
-               sggx_projected_area(mi.wi, s);
+        Float ndf = m_uniform ? ndf_pdf_cached(dr::normalize(wo + mi.wi))
+                              : sggx_ndf_pdf(dr::normalize(wo + mi.wi), s);
+        return 0.25f * ndf / sggx_projected_area(mi.wi, s);
         // }
     }
 
@@ -138,6 +202,11 @@ public:
 private:
     // bool m_diffuse;
     ref<Volume> m_ndf_params;
+
+    /// Derived quantities cached for spatially uniform parameter volumes
+    bool m_uniform = false;
+    dr::Array<Float, 6> m_s_cache, m_adj_cache;
+    Float m_ndf_norm_cache;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(SGGXPhaseFunction, PhaseFunction)
@@ -20,6 +20,15 @@ Lookup table phase function (:monosp:`tabphase`)
      cosine of the scattering angle.
    - |exposed|, |differentiable|, |discontinuous|
 
+ * - inv_cdf_resolution
+   - |int|
+   - Resolution of the precomputed equal-probability inverse CDF table that
+     is used to importance sample the scattering angle. Sampling then only
+     requires two table fetches and a linear interpolation instead of a
+     binary search over the CDF. The table is exact at its nodes, so the
+     residual approximation error decreases quadratically with the
+     resolution. (Default: 1024)
+
 This plugin implements a generic phase function model for isotropic media
 parametrized by a lookup table giving values of the phase function as a
 function of the cosine of the scattering angle.
@@ -62,6 +71,11 @@ public:
             Throw("'values' must be a string");
         }
 
+        m_inv_cdf_res = (uint32_t) props.get<int>("inv_cdf_resolution", 1024);
+        if (m_inv_cdf_res < 2)
+            Throw("'inv_cdf_resolution' must be at least 2!");
+        update_inverse_cdf();
+
         m_flags = +PhaseFunctionFlags::Anisotropic;
         dr::set_attr(this, "flags", m_flags);
         m_components.push_back(m_flags);
@@ -73,6 +87,7 @@ public:
 
     void parameters_changed(const std::vector<std::string> & /*keys*/) override {
         m_distr.update();
+        update_inverse_cdf();
     }
 
     std::pair<Vector3f, Float> sample(const PhaseFunctionContext & /* ctx */,
@@ -84,7 +99,13 @@ public:
 
         // Sample a direction in physics convention.
         // We sample cos θ' = cos(π - θ) = -cos θ.
-        Float cos_theta_prime = m_distr.sample(sample2.x());
+        // The equal-probability inverse CDF table turns this into two
+        // fetches and a linear interpolation (see \ref update_inverse_cdf()).
+        Float u = sample2.x() * (ScalarFloat) (m_inv_cdf_res - 1);
+        UInt32 idx = dr::minimum(UInt32(u), m_inv_cdf_res - 2);
+        Float x0 = dr::gather<Float>(m_inv_cdf, idx, active),
+              x1 = dr::gather<Float>(m_inv_cdf, idx + 1u, active);
+        Float cos_theta_prime = dr::fmadd(x1 - x0, u - Float(idx), x0);
         Float sin_theta_prime =
             dr::safe_sqrt(1.f - cos_theta_prime * cos_theta_prime);
         auto [sin_phi, cos_phi] =
@@ -126,8 +147,34 @@ public:
     }
 
     MI_DECLARE_CLASS()
+private:
+    /**
+     * \brief Tabulate the inverse CDF at equispaced positions in [0, 1]
+     *
+     * This replaces the binary search over the CDF in \ref sample() with two
+     * fetches and a linear interpolation, which also avoids divergence in
+     * wavefront-style evaluation. The PDF reported alongside the sampled
+     * direction still comes from the exact tabulated distribution, whose
+     * regular spacing permits direct indexing.
+     */
+    void update_inverse_cdf() {
+        if constexpr (dr::is_jit_v<Float>) {
+            m_inv_cdf = m_distr.sample(
+                dr::linspace<Float>(0.f, 1.f, m_inv_cdf_res));
+        } else {
+            std::vector<ScalarFloat> table(m_inv_cdf_res);
+            for (uint32_t i = 0; i < m_inv_cdf_res; ++i)
+                table[i] =
+                    m_distr.sample(i / (ScalarFloat) (m_inv_cdf_res - 1));
+            m_inv_cdf =
+                dr::load<DynamicBuffer<Float>>(table.data(), m_inv_cdf_res);
+        }
+    }
+
 private:
     ContinuousDistribution<Float> m_distr;
+    DynamicBuffer<Float> m_inv_cdf;
+    uint32_t m_inv_cdf_res;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(TabulatedPhaseFunction, PhaseFunction)
@@ -23,6 +23,7 @@ MI_PY_DECLARE(Stream);
 MI_PY_DECLARE(DummyStream);
 MI_PY_DECLARE(FileStream);
 MI_PY_DECLARE(MemoryStream);
+MI_PY_DECLARE(TevClient);
 MI_PY_DECLARE(ZStream);
 MI_PY_DECLARE(ProgressReporter);
 MI_PY_DECLARE(rfilter);
@@ -37,6 +38,7 @@ MI_PY_DECLARE(RayFlags);
 MI_PY_DECLARE(MicrofacetType);
 MI_PY_DECLARE(PhaseFunctionExtras);
 MI_PY_DECLARE(Spiral);
+MI_PY_DECLARE(BlockScheduler);
 MI_PY_DECLARE(Sensor);
 MI_PY_DECLARE(VolumeGrid);
 MI_PY_DECLARE(FilmFlags);
@@ -112,6 +114,7 @@ PYBIND11_MODULE(mitsuba_ext, m) {
     MI_PY_IMPORT(DummyStream);
     MI_PY_IMPORT(FileStream);
     MI_PY_IMPORT(MemoryStream);
+    MI_PY_IMPORT(TevClient);
     MI_PY_IMPORT(ZStream);
     MI_PY_IMPORT(ProgressReporter);
     MI_PY_IMPORT(Thread);
@@ -124,6 +127,7 @@ PYBIND11_MODULE(mitsuba_ext, m) {
     MI_PY_IMPORT(MicrofacetType);
     MI_PY_IMPORT(PhaseFunctionExtras);
     MI_PY_IMPORT(Spiral);
+    MI_PY_IMPORT(BlockScheduler);
     MI_PY_IMPORT(Sensor);
     MI_PY_IMPORT(FilmFlags);
 
@@ -1,4 +1,4 @@
-from .util import traverse, SceneParameters, render, cornell_box, variant_context
+from .util import traverse, SceneParameters, render, render_async, render_multi_gpu, cornell_box, variant_context
 from . import chi2
 from . import xml
 from . import ad
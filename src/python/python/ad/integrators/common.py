@@ -328,6 +328,9 @@ class ADIntegrator(mi.CppADIntegrator):
 
         pos += mi.Vector2i(film.crop_offset())
 
+        # Provide the pixel positions (used by blue-noise dithered sampling)
+        sampler.set_pixel_position(mi.Point2u(pos))
+
         # Cast to floating point and add random offset
         pos_f = mi.Vector2f(pos) + sampler.next_2d()
 
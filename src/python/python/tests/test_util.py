@@ -312,3 +312,17 @@ def test06_variant_context():
     except RuntimeError:
         pass
     assert mi.variant() == "scalar_rgb"
+
+
+def test07_render_async(variants_all_ad_rgb):
+    scene = mi.load_dict(mi.cornell_box())
+
+    image = mi.render(scene, spp=2)
+    future = mi.render_async(scene, spp=2)
+    image_async = future.result()
+
+    assert dr.allclose(image, image_async)
+
+    # Exceptions must propagate through the future
+    with pytest.raises(Exception):
+        mi.render_async(scene, params=[]).result()
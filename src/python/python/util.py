@@ -522,6 +522,271 @@ def render(scene: mi.Scene,
     return dr.custom(_RenderOp, scene, sensor, params, integrator,
                      (seed, seed_grad), (spp, spp_grad))
 
+
+_render_executor = None
+
+def render_async(scene: mi.Scene,
+                 params: Any = None,
+                 sensor: Union[int, mi.Sensor] = 0,
+                 integrator: mi.Integrator = None,
+                 seed: int = 0,
+                 seed_grad: int = 0,
+                 spp: int = 0,
+                 spp_grad: int = 0,
+                 executor: Any = None) -> 'concurrent.futures.Future':
+    """
+    Asynchronous variant of :py:func:`mitsuba.render()` that immediately
+    returns a ``concurrent.futures.Future`` and performs the rendering on a
+    background thread. This makes it possible to orchestrate many renders from
+    a single Python process: the underlying ``render()`` call releases the GIL
+    for its entire duration, so pending renders execute concurrently and the
+    main thread remains responsive.
+
+    The returned future resolves to the rendered image (``mi.TensorXf``); the
+    image is fully evaluated on the worker thread before the future completes.
+    Use ``future.result()`` to block, or ``asyncio.wrap_future(future)`` to
+    await it from asynchronous code. Exceptions raised during rendering are
+    re-raised when the result is retrieved.
+
+    All parameters have the same meaning as in :py:func:`mitsuba.render()`. The
+    additional ``executor`` parameter optionally specifies a
+    ``concurrent.futures.ThreadPoolExecutor`` to submit the job to; by default,
+    a lazily created executor shared by all ``render_async()`` calls is used.
+    Note that each render already parallelizes internally over the native
+    thread pool, so a dedicated executor is only needed to control how many
+    renders may be in flight simultaneously.
+    """
+    global _render_executor
+
+    if executor is None:
+        if _render_executor is None:
+            from concurrent.futures import ThreadPoolExecutor
+            _render_executor = ThreadPoolExecutor(thread_name_prefix='mi-render')
+        executor = _render_executor
+
+    # Capture the caller's logger/file resolver for use on the worker thread
+    env = mi.ThreadEnvironment()
+
+    def task():
+        with mi.ScopedSetThreadEnvironment(env):
+            image = render(scene, params=params, sensor=sensor,
+                           integrator=integrator, seed=seed,
+                           seed_grad=seed_grad, spp=spp, spp_grad=spp_grad)
+            # Ensure all rendering work happens here rather than on whichever
+            # thread first touches the result
+            dr.eval(image)
+            return image
+
+    return executor.submit(task)
+
+
+def render_multi_gpu(scene: Union[dict, str],
+                     sensor: int = 0,
+                     seed: int = 0,
+                     spp: int = 0,
+                     devices: Optional[list[int]] = None) -> mi.TensorXf:
+    """
+    Render a scene on multiple GPUs within a single process by partitioning the
+    sample batch across devices, and return the merged image.
+
+    Each participating device receives its own replica of the scene (Dr.Jit
+    arrays are bound to the device that was active when they were created, so
+    per-device replicas are mandatory) and renders ``spp / len(devices)``
+    samples per pixel with a decorrelated seed. The per-device images are
+    subsequently combined into a single spp-weighted average on the first
+    device. This avoids the overhead of running one full process per GPU while
+    providing near-linear scaling for sample-bound workloads, since the
+    per-image merge is negligible compared to the rendering itself.
+
+    This function only performs primal rendering--use one process per device
+    (or a single device) when derivatives are needed.
+
+    Parameter ``scene`` (``dict``, ``str``):
+        Scene *description* (a dictionary suitable for
+        :py:func:`mitsuba.load_dict()` or a filename passed to
+        :py:func:`mitsuba.load_file()`). A description rather than a loaded
+        ``mi.Scene`` is required so that the scene can be instantiated once on
+        every device.
+
+    Parameter ``sensor`` (``int``):
+        Index of the sensor to render from. Sensor *objects* cannot be passed
+        here since they are bound to a single device.
+
+    Parameter ``seed`` (``int``):
+        Seed value for the primal rendering step. Per-device seeds are derived
+        from it so that the partial images are statistically independent.
+
+    Parameter ``spp`` (``int``):
+        Total number of samples per pixel across all devices. If ``spp=0``, the
+        sample count of the scene's sampler takes precedence.
+
+    Parameter ``devices`` (``list[int]``):
+        Indices of the CUDA devices to use. All available devices are used when
+        unspecified.
+    """
+    import numpy as np
+
+    if not mi.variant().startswith('cuda'):
+        raise Exception('render_multi_gpu(): only CUDA variants can target '
+                        'multiple devices!')
+
+    if isinstance(scene, mi.Scene):
+        raise Exception('render_multi_gpu(): a scene *description* (dict or '
+                        'filename) is required, as the scene must be '
+                        'instantiated separately on each device!')
+
+    set_device = getattr(dr, 'set_device', None)
+    device_count = getattr(dr, 'device_count', None)
+    if set_device is None:
+        raise Exception('render_multi_gpu(): this Dr.Jit build does not '
+                        'expose device management (dr.set_device)!')
+
+    if devices is None:
+        devices = list(range(device_count())) if device_count else [0]
+
+    def load_scene():
+        if isinstance(scene, Mapping):
+            return mi.load_dict(scene)
+        return mi.load_file(str(scene))
+
+    if len(devices) == 1:
+        set_device(devices[0])
+        return render(load_scene(), sensor=sensor, seed=seed, spp=spp)
+
+    if spp == 0:
+        # Take the sample count from the scene description on the first device
+        set_device(devices[0])
+        spp = load_scene().sensors()[sensor].sampler().sample_count()
+
+    # Distribute the sample budget as evenly as possible
+    n = len(devices)
+    spp_chunks = [spp // n + (1 if i < spp % n else 0) for i in range(n)]
+
+    env = mi.ThreadEnvironment()
+
+    def task(i):
+        with mi.ScopedSetThreadEnvironment(env):
+            set_device(devices[i])
+            image = render(load_scene(), sensor=sensor,
+                           seed=mi.sample_tea_32(seed, i)[0],
+                           spp=spp_chunks[i])
+            dr.eval(image)
+            # Partial results cross device boundaries through host memory
+            return np.array(image)
+
+    from concurrent.futures import ThreadPoolExecutor
+    with ThreadPoolExecutor(max_workers=n,
+                            thread_name_prefix='mi-render-gpu') as executor:
+        partial = list(executor.map(task, range(n)))
+
+    result = sum(p * (c / spp) for p, c in zip(partial, spp_chunks))
+
+    set_device(devices[0])
+    return mi.TensorXf(result)
+
+
+def render_shard(scene: mi.Scene,
+                 shard: int,
+                 num_shards: int,
+                 sensor: Union[int, mi.Sensor] = 0,
+                 seed: int = 0,
+                 spp: int = 0) -> mi.ImageBlock:
+    """
+    Render one shard of a frame that is being distributed across several
+    workers, and return the partially accumulated image as an
+    ``mi.ImageBlock``.
+
+    The total sample budget is partitioned deterministically: shard ``i`` of
+    ``num_shards`` renders its share of ``spp`` with a seed derived via
+    ``mi.sample_tea_32(seed, i)``, so the union of all shards is statistically
+    equivalent to a single render with ``spp`` samples and the same partition
+    is produced on every invocation. The returned block holds the *raw*
+    (weight-carrying) film storage rather than a developed image; merging the
+    blocks of all shards with :py:func:`merge_shards` therefore performs the
+    correct reconstruction-filter-weighted average, exactly as if the frame
+    had been rendered on a single machine.
+
+    To move a block between machines, serialize it with
+    ``block.write(stream)`` (e.g. into a ``mi.MemoryStream``) and reconstruct
+    it on the coordinator with ``mi.ImageBlock(stream)``; the transport
+    itself (sockets, files on shared storage, a job queue) is left to the
+    caller.
+
+    Parameter ``scene`` (``mi.Scene``):
+        Scene to render.
+
+    Parameter ``shard`` (``int``):
+        Index of this worker's shard (``0 <= shard < num_shards``).
+
+    Parameter ``num_shards`` (``int``):
+        Total number of shards the frame is split into.
+
+    Parameter ``sensor`` (``int``, ``mi.Sensor``):
+        Sensor or sensor index to render from.
+
+    Parameter ``seed`` (``int``):
+        Base seed of the frame. All workers must pass the same value; the
+        per-shard seeds are derived from it.
+
+    Parameter ``spp`` (``int``):
+        Total number of samples per pixel across all shards. If ``spp=0``,
+        the sample count of the scene's sampler takes precedence.
+    """
+    if num_shards <= 0 or not 0 <= shard < num_shards:
+        raise Exception('render_shard(): requires 0 <= shard < num_shards!')
+
+    if isinstance(sensor, int):
+        sensor = scene.sensors()[sensor]
+
+    if spp == 0:
+        spp = sensor.sampler().sample_count()
+
+    # Distribute the sample budget as evenly as possible
+    spp_shard = spp // num_shards + (1 if shard < spp % num_shards else 0)
+    if spp_shard == 0:
+        raise Exception('render_shard(): the sample budget (spp=%i) is too '
+                        'small to be split into %i shards!' % (spp, num_shards))
+
+    render(scene, sensor=sensor, seed=mi.sample_tea_32(seed, shard)[0],
+           spp=spp_shard)
+
+    film = sensor.film()
+    block = mi.ImageBlock(film.develop(raw=True),
+                          offset=mi.ScalarPoint2i(film.crop_offset()),
+                          border=False)
+    dr.eval(block.tensor())
+    return block
+
+
+def merge_shards(blocks: list,
+                 film: mi.Film,
+                 aovs: list = []) -> mi.TensorXf:
+    """
+    Merge the partially accumulated shard blocks produced by
+    :py:func:`render_shard` into ``film`` and return the developed image.
+
+    Each block carries the per-pixel reconstruction filter weights of its
+    shard, so the merge computes the exact weighted average that a
+    single-machine render would have produced. The film is re-prepared (i.e.
+    cleared) before the blocks are accumulated.
+
+    Parameter ``blocks`` (``list[mi.ImageBlock]``):
+        Blocks of all shards, e.g. deserialized from ``mi.ImageBlock(stream)``.
+
+    Parameter ``film`` (``mi.Film``):
+        Coordinator-side film that defines the output size and channel
+        configuration. It must match the film that the shards were rendered
+        with.
+
+    Parameter ``aovs`` (``list[str]``):
+        Names of the AOV channels of the shards' integrator, if any.
+    """
+    film.prepare(aovs)
+    for block in blocks:
+        film.put_block(block)
+    return film.develop()
+
+
 # ------------------------------------------------------------------------------
 
 def convert_to_bitmap(data, uint8_srgb=True):
@@ -558,6 +823,101 @@ def write_bitmap(filename, data, write_async=True, quality=-1):
     else:
         bitmap.write(filename, quality=quality)
 
+# ------------------------------------------------------------------------------
+#                         JIT kernel cache management
+# ------------------------------------------------------------------------------
+
+def kernel_cache_path() -> str:
+    """
+    Returns the directory in which Dr.Jit persists compiled kernels across
+    processes. Kernel binaries are stored under content-addressed file names
+    (a hash of the generated IR), so the directory can safely be merged with,
+    or pre-populated from, the cache of another machine.
+    """
+    import os
+    if os.name == 'nt':
+        base = os.environ.get('APPDATA', os.path.expanduser('~'))
+        return os.path.join(base, 'drjit')
+    return os.path.join(os.path.expanduser('~'), '.drjit')
+
+
+def _sync_kernel_cache(source: str, target: str, overwrite: bool) -> int:
+    import os, shutil, tempfile
+
+    if not os.path.isdir(source):
+        return 0
+    os.makedirs(target, exist_ok=True)
+
+    count = 0
+    for entry in os.scandir(source):
+        if not entry.is_file():
+            continue
+        dst = os.path.join(target, entry.name)
+        if not overwrite and os.path.exists(dst):
+            continue
+
+        # Copy via a temporary file and an atomic rename so that concurrent
+        # render jobs never observe a partially written kernel
+        fd, tmp = tempfile.mkstemp(dir=target)
+        os.close(fd)
+        try:
+            shutil.copy2(entry.path, tmp)
+            os.replace(tmp, dst)
+        except OSError:
+            os.remove(tmp)
+            raise
+        count += 1
+    return count
+
+
+def import_kernel_cache(source: str, overwrite: bool = False) -> int:
+    """
+    Pre-warm the local Dr.Jit kernel cache from the named directory ``source``
+    (e.g. a location shared by all nodes of a render farm). Kernels imported
+    here are picked up instead of being recompiled the next time a matching
+    computation is traced, so the compilation cost of a recurring job is paid
+    once per cluster rather than once per process.
+
+    Returns the number of newly imported kernels. Since entries are
+    content-addressed, merging caches is always safe; pass ``overwrite=True``
+    to replace existing local entries anyway.
+    """
+    return _sync_kernel_cache(source, kernel_cache_path(), overwrite)
+
+
+def export_kernel_cache(target: str, overwrite: bool = False) -> int:
+    """
+    Publish the kernels compiled by this machine to the named directory
+    ``target``. This is the counterpart of :py:func:`import_kernel_cache`:
+    run a representative job (or :py:func:`warm_up`) once, export the cache to
+    a shared location, and import it at the start of every subsequent job.
+
+    Returns the number of newly exported kernels.
+    """
+    return _sync_kernel_cache(kernel_cache_path(), target, overwrite)
+
+
+def warm_up(scene: mi.Scene, sensor: Union[int, mi.Sensor] = 0,
+            spp: int = 1, seed: int = 0) -> None:
+    """
+    Trigger tracing and kernel compilation for ``scene`` ahead of time.
+
+    This renders a single frame at a low sample count and discards the result.
+    Dr.Jit kernels do not depend on the number of samples/lanes launched, so
+    the kernels compiled here are exactly the ones that subsequent full
+    renders of the same scene will reuse -- from the in-memory cache within
+    this process (including across scene reloads with an identical plugin
+    set), and from the on-disk cache (see :py:func:`kernel_cache_path`) in
+    later processes. On scalar variants this function is a no-op.
+    """
+    if not dr.is_jit_v(mi.Float):
+        return
+
+    image = render(scene, sensor=sensor, spp=spp, seed=seed)
+    dr.eval(image)
+    dr.sync_thread()
+
+
 # ------------------------------------------------------------------------------
 #                            Cornell Box scene
 # ------------------------------------------------------------------------------
@@ -33,6 +33,11 @@ MI_VARIANT Spectrum BSDF<Float, Spectrum>::eval_null_transmission(
     return 0.f;
 }
 
+MI_VARIANT Float BSDF<Float, Spectrum>::eval_opacity(
+    const SurfaceInteraction3f & /* si */, Mask /* active */) const {
+    return 1.f;
+}
+
 MI_VARIANT Spectrum BSDF<Float, Spectrum>::eval_diffuse_reflectance(
     const SurfaceInteraction3f &si, Mask active) const {
     Vector3f wo = Vector3f(0.0f, 0.0f, 1.0f);
@@ -1,5 +1,6 @@
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/endpoint.h>
 
@@ -18,7 +19,12 @@ void Emitter<Float, Spectrum>::traverse(TraversalCallback *callback) {
 
 MI_VARIANT
 void Emitter<Float, Spectrum>::parameters_changed(const std::vector<std::string> &keys) {
-    set_dirty(true);
+    /* The dirty flag tells the scene that its emitter sampling distribution
+       must be rebuilt. Only raise it for parameters that actually feed into
+       that distribution, so that e.g. radiance or scale edits don't trigger
+       scene-level work on every update. */
+    if (keys.empty() || string::contains(keys, "sampling_weight"))
+        set_dirty(true);
     Base::parameters_changed(keys);
 }
 
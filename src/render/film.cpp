@@ -83,6 +83,189 @@ Film<Float, Spectrum>::prepare_sample(const UnpolarizedSpectrum & /* spec */,
     NotImplementedError("prepare_sample");
 }
 
+MI_VARIANT void
+Film<Float, Spectrum>::develop_preview(uint8_t * /* buf */,
+                                       ScalarFloat /* exposure */) const {
+    NotImplementedError("develop_preview");
+}
+
+MI_VARIANT typename Film<Float, Spectrum>::TensorXf
+Film<Float, Spectrum>::develop_fast() const {
+    if constexpr (dr::is_diff_v<Float>) {
+        dr::suspend_grad<Float> scope;
+        return develop();
+    } else {
+        return develop();
+    }
+}
+
+MI_VARIANT void
+Film<Float, Spectrum>::write_streaming(const fs::path &path,
+                                       uint32_t /* band_height */) const {
+    write(path);
+}
+
+MI_VARIANT void
+Film<Float, Spectrum>::write_async(const fs::path &path) const {
+    write(path);
+}
+
+MI_VARIANT void
+Film<Float, Spectrum>::save_state(Stream * /* stream */) const {
+    NotImplementedError("save_state");
+}
+
+MI_VARIANT void Film<Float, Spectrum>::load_state(Stream * /* stream */) {
+    NotImplementedError("load_state");
+}
+
+MI_VARIANT typename Film<Float, Spectrum>::TensorXf
+Film<Float, Spectrum>::statistics(const ScalarPoint2u &offset,
+                                  const ScalarVector2u &size_) const {
+    TensorXf image = develop();
+
+    uint32_t height = (uint32_t) image.shape(0),
+             width  = (uint32_t) image.shape(1),
+             ch     = (uint32_t) image.shape(2);
+
+    ScalarVector2u size = size_;
+    if (size.x() == 0)
+        size.x() = width - offset.x();
+    if (size.y() == 0)
+        size.y() = height - offset.y();
+
+    if (offset.x() + size.x() > width || offset.y() + size.y() > height)
+        Throw("Film::statistics(): region (offset=%s, size=%s) lies outside "
+              "of the %ux%u image!", offset, size, width, height);
+
+    uint32_t n = size.x() * size.y();
+    size_t shape[2] = { (size_t) ch, 3 };
+
+    if constexpr (dr::is_jit_v<Float>) {
+        // Linearized indices of the pixels covered by the region
+        UInt32 idx = dr::arange<UInt32>(n),
+               py  = idx / size.x(),
+               px  = idx - py * size.x();
+        UInt32 pixel = (py + offset.y()) * width + (px + offset.x());
+
+        Float result = dr::zeros<Float>(ch * 3);
+        for (uint32_t c = 0; c < ch; ++c) {
+            Float values = dr::gather<Float>(image.array(), pixel * ch + c);
+
+            /* Device-side horizontal reductions; the 'values' buffer never
+               leaves the GPU */
+            Float mean     = dr::sum(values) / (ScalarFloat) n,
+                  maximum  = dr::max(values),
+                  variance = dr::fnmadd(mean, mean,
+                                        dr::sum(dr::sqr(values)) /
+                                            (ScalarFloat) n);
+
+            UInt32 out = UInt32(c * 3);
+            dr::scatter(result, mean,     out);
+            dr::scatter(result, maximum,  out + 1);
+            dr::scatter(result, variance, out + 2);
+        }
+
+        return TensorXf(result, 2, shape);
+    } else {
+        const ScalarFloat *data = image.array().data();
+
+        std::unique_ptr<ScalarFloat[]> result(new ScalarFloat[ch * 3]);
+        for (uint32_t c = 0; c < ch; ++c) {
+            double sum = 0.0, sum_sqr = 0.0;
+            ScalarFloat maximum = -dr::Infinity<ScalarFloat>;
+
+            for (uint32_t y = 0; y < size.y(); ++y) {
+                for (uint32_t x = 0; x < size.x(); ++x) {
+                    ScalarFloat value =
+                        data[((y + offset.y()) * width + x + offset.x()) * ch + c];
+                    sum     += value;
+                    sum_sqr += (double) value * value;
+                    maximum  = std::max(maximum, value);
+                }
+            }
+
+            double mean = sum / n;
+            result[c * 3 + 0] = (ScalarFloat) mean;
+            result[c * 3 + 1] = maximum;
+            result[c * 3 + 2] = (ScalarFloat) (sum_sqr / n - mean * mean);
+        }
+
+        auto data_buf = dr::load<DynamicBuffer<Float>>(result.get(), ch * 3);
+        return TensorXf(data_buf, 2, shape);
+    }
+}
+
+MI_VARIANT typename Film<Float, Spectrum>::TensorXf
+Film<Float, Spectrum>::develop_region(const ScalarPoint2u &offset,
+                                      const ScalarVector2u &size_,
+                                      uint32_t channel_offset,
+                                      uint32_t channel_count) const {
+    TensorXf image = develop();
+
+    uint32_t height = (uint32_t) image.shape(0),
+             width  = (uint32_t) image.shape(1),
+             ch     = (uint32_t) image.shape(2);
+
+    ScalarVector2u size = size_;
+    if (size.x() == 0)
+        size.x() = width - offset.x();
+    if (size.y() == 0)
+        size.y() = height - offset.y();
+    if (channel_count == 0)
+        channel_count = ch - channel_offset;
+
+    if (offset.x() + size.x() > width || offset.y() + size.y() > height)
+        Throw("Film::develop_region(): region (offset=%s, size=%s) lies "
+              "outside of the %ux%u image!", offset, size, width, height);
+
+    if (channel_offset + channel_count > ch)
+        Throw("Film::develop_region(): channel range [%u, %u) lies outside "
+              "of the %u image channels!", channel_offset,
+              channel_offset + channel_count, ch);
+
+    size_t shape[3] = { (size_t) size.y(), (size_t) size.x(),
+                        (size_t) channel_count };
+
+    if constexpr (dr::is_jit_v<Float>) {
+        uint32_t n = size.x() * size.y() * channel_count;
+
+        // Map output indices to their source locations in the channel stack
+        UInt32 idx = dr::arange<UInt32>(n),
+               p   = idx / channel_count,
+               c   = idx - p * channel_count,
+               py  = p / size.x(),
+               px  = p - py * size.x();
+        UInt32 source = ((py + offset.y()) * width + px + offset.x()) * ch +
+                        channel_offset + c;
+
+        /* The gather below is recorded lazily; the sliced values are only
+           materialized once the caller evaluates the result */
+        Float values = dr::gather<Float>(image.array(), source);
+
+        return TensorXf(values, 3, shape);
+    } else {
+        const ScalarFloat *data = image.array().data();
+
+        size_t n = (size_t) size.x() * size.y() * channel_count;
+        std::unique_ptr<ScalarFloat[]> result(new ScalarFloat[n]);
+
+        ScalarFloat *ptr = result.get();
+        for (uint32_t y = 0; y < size.y(); ++y) {
+            for (uint32_t x = 0; x < size.x(); ++x) {
+                const ScalarFloat *source =
+                    data + ((y + offset.y()) * width + x + offset.x()) * ch +
+                    channel_offset;
+                for (uint32_t c = 0; c < channel_count; ++c)
+                    *ptr++ = source[c];
+            }
+        }
+
+        auto data_buf = dr::load<DynamicBuffer<Float>>(result.get(), n);
+        return TensorXf(data_buf, 3, shape);
+    }
+}
+
 MI_VARIANT const typename Film<Float, Spectrum>::Texture *
 Film<Float, Spectrum>::sensor_response_function() {
     return m_srf.get();
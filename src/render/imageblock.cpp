@@ -1,10 +1,69 @@
 #include <mitsuba/render/imageblock.h>
 #include <mitsuba/core/bitmap.h>
 #include <mitsuba/core/profiler.h>
+#include <mitsuba/core/stream.h>
 #include <drjit/loop.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(mitsuba)
 
+NAMESPACE_BEGIN(detail)
+
+/* Bit-level IEEE 754 binary32 <-> binary16 conversions operating on whole
+   arrays, using the usual branch-free algorithms (round-to-nearest-even on
+   the way down, correct denormal/Inf/NaN handling in both directions).
+   drjit exposes no half-precision array type, hence the half-precision
+   image storage (see \ref ImageBlock::set_half_precision()) packs two
+   16-bit values per 32-bit word and converts manually. */
+template <typename UInt32, typename Float32 = dr::float32_array_t<UInt32>>
+Float32 float16_to_float32(const UInt32 &h) {
+    const uint32_t shifted_exp = 0x7c00u << 13;
+
+    UInt32 o   = (h & 0x7fffu) << 13,
+           exp = o & shifted_exp;
+
+    // Adjust the exponent bias (15 -> 127)
+    o += (127u - 15u) << 23;
+
+    // Inf/NaN: extend the exponent to its maximum value
+    o = dr::select(dr::eq(exp, shifted_exp), o + ((128u - 16u) << 23), o);
+
+    // Denormals: renormalize via floating point arithmetic
+    Float32 denorm = dr::reinterpret_array<Float32>(o + (1u << 23)) -
+                     dr::reinterpret_array<Float32>(UInt32(113u << 23));
+    o = dr::select(dr::eq(exp, 0u),
+                   dr::reinterpret_array<UInt32>(denorm), o);
+
+    return dr::reinterpret_array<Float32>(o | ((h & 0x8000u) << 16));
+}
+
+template <typename UInt32, typename Float32 = dr::float32_array_t<UInt32>>
+UInt32 float32_to_float16(const Float32 &value) {
+    UInt32 f    = dr::reinterpret_array<UInt32>(value),
+           sign = f & 0x80000000u;
+    f = f ^ sign;
+
+    // Values mapping to subnormal halves (or zero): renormalize via FP math
+    Float32 denorm_magic =
+        dr::reinterpret_array<Float32>(UInt32(126u << 23)); // 2^-1
+    UInt32 o_tiny =
+        dr::reinterpret_array<UInt32>(dr::reinterpret_array<Float32>(f) +
+                                      denorm_magic) - (126u << 23);
+
+    // Normal range: shift into place with round-to-nearest-even
+    UInt32 mant_odd = (f >> 13) & 1u,
+           o_norm   = (f + (UInt32(15u - 127u) << 23) + 0xfffu + mant_odd) >> 13;
+
+    UInt32 o = dr::select(
+        f >= ((127u + 16u) << 23), // overflow, Inf, or NaN
+        dr::select(f > (255u << 23), UInt32(0x7e00u), UInt32(0x7c00u)),
+        dr::select(f < (113u << 23), o_tiny, o_norm));
+
+    return o | (sign >> 16);
+}
+
+NAMESPACE_END(detail)
+
 MI_VARIANT
 ImageBlock<Float, Spectrum>::ImageBlock(const ScalarVector2u &size,
                                         const ScalarPoint2i &offset,
@@ -65,6 +124,79 @@ ImageBlock<Float, Spectrum>::ImageBlock(const TensorXf &tensor,
         m_tensor = TensorXf(tensor.array(), 3, tensor.shape().data());
 }
 
+MI_VARIANT
+ImageBlock<Float, Spectrum>::ImageBlock(Stream *stream)
+    : m_rfilter(nullptr), m_normalize(false), m_coalesce(dr::is_jit_v<Float>),
+      m_compensate(false), m_warn_negative(false), m_warn_invalid(false) {
+    using Array = typename TensorXf::Array;
+
+    char header[3];
+    stream->read(header, 3);
+    if (header[0] != 'B' || header[1] != 'L' || header[2] != 'K')
+        Throw("ImageBlock(Stream*): invalid serialized image block!");
+
+    uint8_t version;
+    stream->read(version);
+    if (version != 1)
+        Throw("ImageBlock(Stream*): unsupported version %d!", (int) version);
+
+    int32_t offset_x, offset_y;
+    stream->read(offset_x);
+    stream->read(offset_y);
+    m_offset = ScalarPoint2i(offset_x, offset_y);
+
+    stream->read(m_size.x());
+    stream->read(m_size.y());
+    stream->read(m_channel_count);
+    stream->read(m_border_size);
+
+    ScalarVector2u size_ext = m_size + 2 * m_border_size;
+    size_t size_flat = m_channel_count * dr::prod(size_ext),
+           shape[3]  = { size_ext.y(), size_ext.x(), m_channel_count };
+
+    std::unique_ptr<float[]> buf(new float[size_flat]);
+    stream->read_array(buf.get(), size_flat);
+
+    if constexpr (std::is_same<ScalarFloat, float>::value) {
+        m_tensor = TensorXf(dr::load<Array>(buf.get(), size_flat), 3, shape);
+    } else {
+        // Convert the single precision wire data to double precision
+        std::unique_ptr<ScalarFloat[]> data(new ScalarFloat[size_flat]);
+        for (size_t i = 0; i < size_flat; ++i)
+            data[i] = buf[i];
+        m_tensor = TensorXf(dr::load<Array>(data.get(), size_flat), 3, shape);
+    }
+}
+
+MI_VARIANT
+void ImageBlock<Float, Spectrum>::write(Stream *stream) const {
+    stream->write("BLK", 3);
+    stream->write(uint8_t(1)); // wire format version
+    stream->write(int32_t(m_offset.x()));
+    stream->write(int32_t(m_offset.y()));
+    stream->write(uint32_t(m_size.x()));
+    stream->write(uint32_t(m_size.y()));
+    stream->write(uint32_t(m_channel_count));
+    stream->write(uint32_t(m_border_size));
+
+    // Flushes any pending error compensation and fetches the tensor
+    auto &&data = dr::migrate(tensor().array(), AllocType::Host);
+
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    size_t size_flat = data.size();
+    if constexpr (std::is_same<ScalarFloat, float>::value) {
+        stream->write_array(data.data(), size_flat);
+    } else {
+        // Need to convert data to single precision before serialization
+        std::unique_ptr<float[]> buf(new float[size_flat]);
+        for (size_t i = 0; i < size_flat; ++i)
+            buf[i] = (float) data[i];
+        stream->write_array(buf.get(), size_flat);
+    }
+}
+
 MI_VARIANT ImageBlock<Float, Spectrum>::~ImageBlock() { }
 
 MI_VARIANT void ImageBlock<Float, Spectrum>::clear() {
@@ -72,8 +204,20 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::clear() {
 
     ScalarVector2u size_ext = m_size + 2 * m_border_size;
 
-    size_t size_flat = m_channel_count * dr::prod(size_ext),
-           shape[3]  = { size_ext.y(), size_ext.x(), m_channel_count };
+    size_t size_flat = m_slot_count * m_channel_count * dr::prod(size_ext),
+           shape[3]  = { m_slot_count * size_ext.y(), size_ext.x(),
+                         m_channel_count };
+
+    if constexpr (dr::is_jit_v<Float>) {
+        if (m_half_precision) {
+            // Two packed half-precision channel values per 32-bit word
+            m_data_half = dr::zeros<UInt32>((size_flat + 1) / 2);
+            m_tensor = TensorXf();
+            return;
+        } else {
+            m_data_half = UInt32();
+        }
+    }
 
     m_tensor = TensorXf(dr::zeros<Array>(size_flat), 3, shape);
 
@@ -81,6 +225,115 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::clear() {
         m_tensor_compensation = TensorXf(dr::zeros<Array>(size_flat), 3, shape);
 }
 
+MI_VARIANT void ImageBlock<Float, Spectrum>::set_slot_count(uint32_t slots) {
+    slots = std::max(slots, 1u);
+
+    // Scalar modes use per-thread image blocks, which are already private
+    if constexpr (!dr::is_jit_v<Float>)
+        slots = 1;
+
+    if (slots == m_slot_count)
+        return;
+
+    if (slots > 1 && m_half_precision)
+        Throw("ImageBlock::set_slot_count(): incompatible with "
+              "half-precision storage!");
+
+    m_slot_count = slots;
+    clear();
+}
+
+MI_VARIANT void ImageBlock<Float, Spectrum>::set_half_precision(bool value) {
+    if constexpr (!dr::is_jit_v<Float>) {
+        if (value)
+            Log(Warn, "ImageBlock::set_half_precision(): half-precision "
+                      "storage is only available in JIT variants -- ignoring.");
+    } else {
+        if (value == m_half_precision)
+            return;
+
+        if (value && m_compensate)
+            Throw("ImageBlock::set_half_precision(): incompatible with "
+                  "error-compensated accumulation!");
+        if (value && m_slot_count > 1)
+            Throw("ImageBlock::set_half_precision(): incompatible with "
+                  "slot-privatized accumulation!");
+
+        m_half_precision = value;
+
+        // Reallocate the storage in the new representation
+        clear();
+    }
+}
+
+MI_VARIANT void ImageBlock<Float, Spectrum>::reduce_slots() {
+    if (m_slot_count == 1)
+        return;
+
+    if constexpr (dr::is_jit_v<Float>) {
+        ScalarVector2u size_ext = m_size + 2 * m_border_size;
+
+        uint32_t n = m_channel_count * dr::prod(size_ext);
+        size_t shape[3] = { size_ext.y(), size_ext.x(), m_channel_count };
+
+        UInt32 idx = dr::arange<UInt32>(n);
+
+        Float value = dr::gather<Float>(m_tensor.array(), idx);
+        for (uint32_t s = 1; s < m_slot_count; ++s)
+            value += dr::gather<Float>(m_tensor.array(), idx + s * n);
+        m_tensor = TensorXf(value, 3, shape);
+
+        if (m_compensate) {
+            Float comp = dr::gather<Float>(m_tensor_compensation.array(), idx);
+            for (uint32_t s = 1; s < m_slot_count; ++s)
+                comp += dr::gather<Float>(m_tensor_compensation.array(),
+                                          idx + s * n);
+            m_tensor_compensation = TensorXf(comp, 3, shape);
+        }
+    }
+
+    m_slot_count = 1;
+}
+
+MI_VARIANT void
+ImageBlock<Float, Spectrum>::clear_region(const ScalarPoint2u &offset,
+                                          const ScalarVector2u &size) {
+    ScalarVector2u size_ext = m_size + 2 * m_border_size;
+
+    if (dr::any(offset + size > size_ext))
+        Throw("ImageBlock::clear_region(): region (offset=%s, size=%s) lies "
+              "outside of the %ux%u block!", offset, size, size_ext.x(),
+              size_ext.y());
+
+    if (unlikely(m_half_precision))
+        Throw("ImageBlock::clear_region(): unsupported in half-precision "
+              "storage mode -- use clear() to reset the entire block!");
+
+    if constexpr (dr::is_jit_v<Float>) {
+        uint32_t n = size.x() * size.y() * m_channel_count;
+
+        // Map region entries to their locations in the channel stack
+        UInt32 idx = dr::arange<UInt32>(n),
+               p   = idx / m_channel_count,
+               c   = idx - p * m_channel_count,
+               py  = p / size.x(),
+               px  = p - py * size.x();
+        UInt32 target = ((py + offset.y()) * size_ext.x() + px + offset.x()) *
+                            m_channel_count + c;
+
+        dr::scatter(m_tensor.array(), dr::zeros<Float>(n), target);
+        if (m_compensate)
+            dr::scatter(m_tensor_compensation.array(), dr::zeros<Float>(n),
+                        target);
+    } else {
+        ScalarFloat *data = m_tensor.array().data();
+        for (uint32_t y = 0; y < size.y(); ++y)
+            memset(data + ((y + offset.y()) * size_ext.x() + offset.x()) *
+                       m_channel_count,
+                   0, sizeof(ScalarFloat) * size.x() * m_channel_count);
+    }
+}
+
 MI_VARIANT void
 ImageBlock<Float, Spectrum>::set_size(const ScalarVector2u &size) {
     using Array = typename TensorXf::Array;
@@ -90,8 +343,18 @@ ImageBlock<Float, Spectrum>::set_size(const ScalarVector2u &size) {
 
     ScalarVector2u size_ext = size + 2 * m_border_size;
 
-    size_t size_flat = m_channel_count * dr::prod(size_ext),
-           shape[3]  = { size_ext.y(), size_ext.x(), m_channel_count };
+    size_t size_flat = m_slot_count * m_channel_count * dr::prod(size_ext),
+           shape[3]  = { m_slot_count * size_ext.y(), size_ext.x(),
+                         m_channel_count };
+
+    if constexpr (dr::is_jit_v<Float>) {
+        if (m_half_precision) {
+            m_data_half = dr::zeros<UInt32>((size_flat + 1) / 2);
+            m_tensor = TensorXf();
+            m_size = size;
+            return;
+        }
+    }
 
     m_tensor = TensorXf(dr::zeros<Array>(size_flat), 3, shape);
 
@@ -102,7 +365,30 @@ ImageBlock<Float, Spectrum>::set_size(const ScalarVector2u &size) {
 }
 
 MI_VARIANT typename ImageBlock<Float, Spectrum>::TensorXf &ImageBlock<Float, Spectrum>::tensor() {
+    if (m_slot_count > 1)
+        Throw("ImageBlock::tensor(): slot-privatized accumulation is active, "
+              "reduce_slots() must be called first!");
+
     if constexpr (dr::is_jit_v<Float>) {
+        if (m_half_precision) {
+            /* Transiently materialize a single precision copy. The packed
+               representation remains authoritative: the copy is replaced on
+               the next call and dropped by the next clear()/set_size(), and
+               writes through the returned reference are not supported. */
+            ScalarVector2u size_ext = m_size + 2 * m_border_size;
+            uint32_t size_flat = m_channel_count * dr::prod(size_ext);
+            size_t shape[3] = { size_ext.y(), size_ext.x(), m_channel_count };
+
+            UInt32 idx  = dr::arange<UInt32>(size_flat),
+                   word = dr::gather<UInt32>(m_data_half, idx >> 1),
+                   bits = dr::select(dr::eq(idx & 1u, 0u), word & 0xffffu,
+                                     word >> 16);
+
+            m_tensor =
+                TensorXf(Float(detail::float16_to_float32(bits)), 3, shape);
+            return m_tensor;
+        }
+
         if (m_compensate) {
             Float &comp = m_tensor_compensation.array();
             m_tensor.array() += comp;
@@ -118,6 +404,16 @@ MI_VARIANT const typename ImageBlock<Float, Spectrum>::TensorXf &ImageBlock<Floa
 
 MI_VARIANT void ImageBlock<Float, Spectrum>::accum(Float value, UInt32 index, Bool active) {
     if constexpr (dr::is_jit_v<Float>) {
+        if (m_slot_count > 1) {
+            /* Distribute lanes over the privatized copies of the image so
+               that atomics issued by a warp spread over 'm_slot_count'
+               distinct memory regions (see \ref set_slot_count) */
+            ScalarVector2u size_ext = m_size + 2 * m_border_size;
+            uint32_t stride = m_channel_count * size_ext.x() * size_ext.y();
+            index += (dr::arange<UInt32>(dr::width(index)) % m_slot_count) *
+                     stride;
+        }
+
         if (m_compensate)
             dr::scatter_reduce_kahan(m_tensor.array(),
                                      m_tensor_compensation.array(),
@@ -132,8 +428,38 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::accum(Float value, UInt32 index, Bo
     }
 }
 
-MI_VARIANT void ImageBlock<Float, Spectrum>::put_block(const ImageBlock *block) {
+MI_VARIANT void ImageBlock<Float, Spectrum>::accum_half(const Float &values) {
+    if constexpr (dr::is_jit_v<Float>) {
+        /* Unpack both halves of every word to single precision, add the
+           matching entries of 'values', and round back to nearest even.
+           Accumulating in single precision bounds the error of each merge
+           by half a unit in the last place of the stored half value. */
+        using Float32 = dr::float32_array_t<Float>;
+
+        ScalarVector2u size_ext = m_size + 2 * m_border_size;
+        uint32_t size_flat = m_channel_count * dr::prod(size_ext),
+                 n_words   = (size_flat + 1) / 2;
+
+        UInt32 idx = dr::arange<UInt32>(n_words);
+
+        Float32 lo = detail::float16_to_float32(m_data_half & 0xffffu),
+                hi = detail::float16_to_float32(m_data_half >> 16);
+
+        lo += Float32(dr::gather<Float>(values, 2u * idx));
+        hi += Float32(dr::gather<Float>(values, 2u * idx + 1u,
+                                        2u * idx + 1u < size_flat));
+
+        m_data_half = detail::float32_to_float16<UInt32>(lo) |
+                      (detail::float32_to_float16<UInt32>(hi) << 16);
+    } else {
+        DRJIT_MARK_USED(values);
+    }
+}
+
+MI_VARIANT void ImageBlock<Float, Spectrum>::put_block(const ImageBlock *block,
+                                                       bool atomic) {
     ScopedPhase sp(ProfilerPhase::ImageBlockPut);
+    DRJIT_MARK_USED(atomic);
 
     if (unlikely(block->channel_count() != channel_count()))
         Throw("ImageBlock::put_block(): mismatched channel counts! (%u, "
@@ -146,6 +472,16 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::put_block(const ImageBlock *block)
                    target_offset =        offset() -        border_size();
 
     if constexpr (dr::is_jit_v<Float>) {
+        if (m_half_precision) {
+            if (m_size != block->size() || m_offset != block->offset() ||
+                m_border_size != block->border_size())
+                Throw("ImageBlock::put_block(): half-precision storage "
+                      "requires the source block to exactly match the target "
+                      "block's size, offset, and border size!");
+            accum_half(block->tensor().array());
+            return;
+        }
+
         // If target block is cleared and match size, directly copy data
         if (m_size == block->size() && m_offset == block->offset() &&
             m_border_size == block->border_size()) {
@@ -162,21 +498,67 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::put_block(const ImageBlock *block)
             );
         }
     } else {
-        accumulate_2d(
-            block->tensor().data(), source_size,
-            m_tensor.data(), target_size,
-            ScalarVector2i(0), source_offset - target_offset,
-            source_size, channel_count()
-        );
+        if (unlikely(atomic))
+            accumulate_2d<Float *, const Float *, true>(
+                block->tensor().data(), source_size,
+                m_tensor.data(), target_size,
+                ScalarVector2i(0), source_offset - target_offset,
+                source_size, channel_count()
+            );
+        else
+            accumulate_2d(
+                block->tensor().data(), source_size,
+                m_tensor.data(), target_size,
+                ScalarVector2i(0), source_offset - target_offset,
+                source_size, channel_count()
+            );
     }
 }
 
 MI_VARIANT void ImageBlock<Float, Spectrum>::put(const Point2f &pos,
                                                  const Float *values,
                                                  Mask active) {
+    if (likely(m_clamp_threshold == 0 || m_clamp_channels == 0))
+        return put_impl(pos, values, active);
+
+    // Rescale outliers so that the largest value channel equals the threshold
+    Float vmax = values[0];
+    for (uint32_t k = 1; k < m_clamp_channels; ++k)
+        vmax = dr::maximum(vmax, values[k]);
+
+    Float factor = dr::select(vmax > m_clamp_threshold,
+                              m_clamp_threshold / vmax, 1.f);
+
+    Float *clamped = (Float *) alloca(sizeof(Float) * m_channel_count);
+    for (uint32_t k = 0; k < m_channel_count; ++k)
+        new (clamped + k)
+            Float(k < m_clamp_channels ? values[k] * factor : values[k]);
+
+    // Optionally retain the removed energy in a dedicated channel
+    if (m_clamp_excess < m_channel_count) {
+        Float excess = 0.f;
+        for (uint32_t k = 0; k < m_clamp_channels; ++k)
+            excess += values[k] - clamped[k];
+        clamped[m_clamp_excess] = excess;
+    }
+
+    put_impl(pos, clamped, active);
+
+    for (uint32_t k = 0; k < m_channel_count; ++k)
+        clamped[k].~Float();
+}
+
+MI_VARIANT void ImageBlock<Float, Spectrum>::put_impl(const Point2f &pos,
+                                                      const Float *values,
+                                                      Mask active) {
     ScopedPhase sp(ProfilerPhase::ImageBlockPut);
     constexpr bool JIT = dr::is_jit_v<Float>;
 
+    if (unlikely(m_half_precision))
+        Throw("ImageBlock::put(): unsupported in half-precision storage mode "
+              "-- accumulate into a single precision block and merge it via "
+              "put_block()!");
+
     // Check if all sample values are valid
     if (m_warn_negative || m_warn_invalid) {
         Mask is_valid = true;
@@ -318,13 +700,30 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::put(const Point2f &pos,
             if (unlikely(m_normalize)) {
                 Float wx = 0.f, wy = 0.f;
 
-                Point2f rel_f2 = dr::ceil(pos_0_f) - pos_f;
-                for (uint32_t i = 0; i < count_max; ++i) {
-                    wx += JIT ? m_rfilter->eval(rel_f2.x())
-                              : m_rfilter->eval_discretized(rel_f2.x());
-                    wy += JIT ? m_rfilter->eval(rel_f2.y())
-                              : m_rfilter->eval_discretized(rel_f2.y());
-                    rel_f2 += 1.f;
+                /* In scalar mode, the weights computed above already cover
+                   the full filter footprint unless it was clamped against
+                   the image boundaries. Sum them up directly in that case
+                   instead of evaluating the filter a second time. */
+                bool reuse = false;
+                if constexpr (!JIT)
+                    reuse = dr::all(Point2i(pos_0_u) ==
+                                    dr::ceil2int<Point2i>(pos_0_f)) &&
+                            dr::all(count_u >= count_max);
+
+                if (reuse) {
+                    for (uint32_t i = 0; i < count_max; ++i) {
+                        wx += weights_x[i];
+                        wy += weights_y[i];
+                    }
+                } else {
+                    Point2f rel_f2 = dr::ceil(pos_0_f) - pos_f;
+                    for (uint32_t i = 0; i < count_max; ++i) {
+                        wx += JIT ? m_rfilter->eval(rel_f2.x())
+                                  : m_rfilter->eval_discretized(rel_f2.x());
+                        wy += JIT ? m_rfilter->eval(rel_f2.y())
+                                  : m_rfilter->eval_discretized(rel_f2.y());
+                        rel_f2 += 1.f;
+                    }
                 }
 
                 Float factor = dr::detach(wx * wy);
@@ -353,10 +752,9 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::put(const Point2f &pos,
 
                 for (uint32_t x = 0; x < count.x(); ++x) {
                     Mask active_2 = active_1 && x < count_u.x();
+                    Float weight = weights_x[x] * weights_y[y];
 
                     for (uint32_t k = 0; k < m_channel_count; ++k) {
-                        Float weight = weights_x[x] * weights_y[y];
-
                         if constexpr (!JIT) {
                             DRJIT_MARK_USED(active_2);
                             ptr[index] = dr::fmadd(values[k], weight, ptr[index]);
@@ -536,6 +934,10 @@ MI_VARIANT void ImageBlock<Float, Spectrum>::read(const Point2f &pos_,
                                                    Mask active) const {
     constexpr bool JIT = dr::is_jit_v<Float>;
 
+    if (unlikely(m_half_precision))
+        Throw("ImageBlock::read(): unsupported in half-precision storage "
+              "mode -- use tensor() to obtain a single precision copy!");
+
     // Account for image block offset
     Point2f pos = pos_ - ScalarVector2f(m_offset);
 
@@ -1,16 +1,25 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <mutex>
+#include <unordered_set>
 
 #include <drjit/morton.h>
+#include <mitsuba/core/arena.h>
 #include <mitsuba/core/fwd.h>
 #include <mitsuba/core/profiler.h>
 #include <mitsuba/core/progress.h>
 #include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/sampler.h>
+#include <mitsuba/render/scheduler.h>
 #include <mitsuba/render/sensor.h>
 #include <mitsuba/render/spiral.h>
 #include <nanothread/nanothread.h>
@@ -19,9 +28,59 @@ NAMESPACE_BEGIN(mitsuba)
 
 // -----------------------------------------------------------------------------
 
+/// JIT-typed parameters that plugins expose via traverse() (see object_v.cpp)
+#define MI_OPAQUE_APPLY_FOR_EACH(T)                                            \
+    T(Float32); T(Float64); T(Int32); T(UInt32);                               \
+    T(DynamicBuffer<Float32>); T(DynamicBuffer<Float64>);                      \
+    T(DynamicBuffer<Int32>); T(DynamicBuffer<UInt32>);                         \
+    T(Color1f); T(Color3f); T(Color1d); T(Color3d); T(Vector2i); T(Vector2u); \
+    T(Vector3i); T(Vector3u); T(Point2u); T(Point3u); T(Point2f); T(Point3f);  \
+    T(Vector2f); T(Vector3f); T(Vector4f); T(Normal3f); T(Frame3f); T(Mask);   \
+    T(Matrix3f); T(Matrix4f); T(Transform3f); T(Transform4f); T(Transform4d);  \
+    T(TensorXf)
+
+#define MI_MAKE_OPAQUE_T(T)                                                    \
+    if (strcmp(type.name(), typeid(T).name()) == 0) {                          \
+        dr::make_opaque(*(T *) ptr);                                           \
+        return;                                                                \
+    }
+
+/* Traversal callback that makes every exposed JIT-typed scene parameter
+   opaque (see \ref Integrator::render_frozen()). Parameters of unsupported
+   types (e.g. plain scalars) are left alone -- they are necessarily baked
+   into the trace as literals. */
+template <typename Float, typename Spectrum>
+class OpaqueTraversalCallback final : public TraversalCallback {
+public:
+    MI_IMPORT_TYPES()
+
+    void put_object(const std::string & /* name */, Object *obj,
+                    uint32_t /* flags */) override {
+        // Shared objects (e.g. BSDFs) are reachable through multiple paths
+        if (obj && m_visited.insert(obj).second)
+            obj->traverse(this);
+    }
+
+protected:
+    void put_parameter_impl(const std::string & /* name */, void *ptr,
+                            uint32_t /* flags */,
+                            const std::type_info &type) override {
+        MI_OPAQUE_APPLY_FOR_EACH(MI_MAKE_OPAQUE_T);
+    }
+
+private:
+    std::unordered_set<const Object *> m_visited;
+};
+
+#undef MI_OPAQUE_APPLY_FOR_EACH
+#undef MI_MAKE_OPAQUE_T
+
+// -----------------------------------------------------------------------------
+
 MI_VARIANT Integrator<Float, Spectrum>::Integrator(const Properties & props)
     : m_stop(false) {
     m_timeout = props.get<ScalarFloat>("timeout", -1.f);
+    m_deadline = props.get<ScalarFloat>("deadline", -1.f);
 
     // Disable direct visibility of emitters if needed
     m_hide_emitters = props.get<bool>("hide_emitters", false);
@@ -41,6 +100,67 @@ Integrator<Float, Spectrum>::render(Scene *scene,
                   seed, spp, develop, evaluate);
 }
 
+MI_VARIANT std::vector<typename Integrator<Float, Spectrum>::TensorXf>
+Integrator<Float, Spectrum>::render_batch(Scene *scene,
+                                          const std::vector<Sensor *> &sensors,
+                                          uint32_t seed,
+                                          uint32_t spp,
+                                          bool develop,
+                                          bool evaluate) {
+    if (sensors.empty())
+        Throw("render_batch(): at least one sensor must be specified!");
+
+    std::vector<TensorXf> result;
+    result.reserve(sensors.size());
+
+    /* Advance the seed between sensors so that the per-sensor renders
+       remain statistically independent */
+    for (size_t i = 0; i < sensors.size(); ++i)
+        result.push_back(render(scene, sensors[i], seed + (uint32_t) i, spp,
+                                develop, evaluate));
+
+    return result;
+}
+
+MI_VARIANT typename Integrator<Float, Spectrum>::TensorXf
+Integrator<Float, Spectrum>::render_frozen(Scene *scene,
+                                           Sensor *sensor,
+                                           uint32_t seed,
+                                           uint32_t spp,
+                                           bool develop,
+                                           bool evaluate) {
+    if constexpr (dr::is_jit_v<Float>) {
+        /* Turn all exposed parameters into opaque kernel inputs so that the
+           subsequent trace is identical to that of previous iterations and
+           replays the machine code cached by the JIT backend. Parameters
+           that are already opaque or evaluated are unaffected, hence
+           repeated calls only pay for the (cheap) scene graph walk plus the
+           evaluation of parameters that actually changed. */
+        OpaqueTraversalCallback<Float, Spectrum> cb;
+        scene->traverse(&cb);
+
+        // The sensor is not necessarily part of the scene graph
+        cb.put_object("sensor", sensor, +ParamFlags::Differentiable);
+    }
+
+    return render(scene, sensor, seed, spp, develop, evaluate);
+}
+
+MI_VARIANT typename Integrator<Float, Spectrum>::TensorXf
+Integrator<Float, Spectrum>::render_frozen(Scene *scene,
+                                           uint32_t sensor_index,
+                                           uint32_t seed,
+                                           uint32_t spp,
+                                           bool develop,
+                                           bool evaluate) {
+    if (sensor_index >= scene->sensors().size())
+        Throw("Scene::render_frozen(): sensor index %i is out of bounds!",
+              sensor_index);
+
+    return render_frozen(scene, scene->sensors()[sensor_index].get(),
+                         seed, spp, develop, evaluate);
+}
+
 MI_VARIANT std::vector<std::string> Integrator<Float, Spectrum>::aov_names() const {
     return { };
 }
@@ -71,10 +191,147 @@ MI_VARIANT SamplingIntegrator<Float, Spectrum>::SamplingIntegrator(const Propert
                   "Please leave it undefined; Mitsuba will then automatically "
                   "choose the necessary number of passes.");
     }
+
+    m_pass_time_budget = props.get<ScalarFloat>("pass_time_budget", -1.f);
+    m_pin_threads = props.get<bool>("pin_threads", false);
+    m_batch_shadow_rays = props.get<bool>("batch_shadow_rays", false);
+    m_batch_primary_rays = props.get<bool>("batch_primary_rays", false);
+
+    m_adaptive_threshold = props.get<ScalarFloat>("adaptive_threshold", 0.f);
+    if (m_adaptive_threshold < 0.f)
+        Throw("'adaptive_threshold' must be >= 0!");
+    m_adaptive_min_samples = props.get<uint32_t>("adaptive_min_samples", 16);
+    if (m_adaptive_min_samples < 2)
+        Throw("'adaptive_min_samples' must be >= 2!");
+    m_wavefront = props.get<bool>("wavefront", false);
+    m_block_callback_interval = 0.5f;
+
+    m_checkpoint = props.string("checkpoint", "");
+    m_checkpoint_interval = props.get<ScalarFloat>("checkpoint_interval", 300.f);
+    if (m_checkpoint_interval <= 0.f)
+        Throw("The 'checkpoint_interval' parameter must be positive!");
 }
 
 MI_VARIANT SamplingIntegrator<Float, Spectrum>::~SamplingIntegrator() { }
 
+MI_VARIANT void SamplingIntegrator<Float, Spectrum>::set_block_callback(
+    BlockCallback callback, ScalarFloat min_interval) {
+    if (min_interval < 0.f)
+        Throw("set_block_callback(): 'min_interval' must be non-negative!");
+    m_block_callback = std::move(callback);
+    m_block_callback_interval = min_interval;
+}
+
+/// Magic bytes and version number identifying a render checkpoint file
+static const char checkpoint_magic[4] = { 'M', 'C', 'K', 'P' };
+static const uint32_t checkpoint_version = 1;
+
+/**
+ * \brief Scoped switch to wavefront-style execution (see the 'wavefront'
+ * integrator parameter)
+ *
+ * Disables Dr.Jit loop recording for the lifetime of the guard so that the
+ * integrator's sampling loop is split into separate per-stage kernel
+ * launches instead of one fused megakernel. A no-op in scalar variants and
+ * when loop recording is already disabled (e.g. via the '-W' flag).
+ */
+template <typename Float> struct ScopedWavefrontMode {
+    ScopedWavefrontMode(bool enable) {
+        if constexpr (dr::is_jit_v<Float>) {
+            m_restore = enable && jit_flag(JitFlag::LoopRecord);
+            if (m_restore)
+                jit_set_flag(JitFlag::LoopRecord, false);
+        } else {
+            DRJIT_MARK_USED(enable);
+        }
+    }
+
+    ~ScopedWavefrontMode() {
+        if constexpr (dr::is_jit_v<Float>) {
+            if (m_restore)
+                jit_set_flag(JitFlag::LoopRecord, true);
+        }
+    }
+
+    bool m_restore = false;
+};
+
+MI_VARIANT void SamplingIntegrator<Float, Spectrum>::write_checkpoint(
+    const Film *film, uint32_t seed, uint32_t spp, uint32_t spp_per_pass,
+    uint32_t passes_done) const {
+    fs::path path(m_checkpoint),
+             path_tmp(m_checkpoint + ".tmp");
+
+    try {
+        ref<FileStream> stream =
+            new FileStream(path_tmp, FileStream::ETruncReadWrite);
+        stream->write_array(checkpoint_magic, 4);
+        stream->write(checkpoint_version);
+        stream->write(seed);
+        stream->write(spp);
+        stream->write(spp_per_pass);
+        stream->write(passes_done);
+        film->save_state(stream);
+        stream->close();
+
+        /* Rename into place so that the previous checkpoint remains intact
+           if the machine disappears mid-write */
+        if (!fs::rename(path_tmp, path))
+            Throw("could not rename \"%s\"", path_tmp.string());
+
+        Log(Debug, "Wrote render checkpoint (%u/%u passes) to \"%s\".",
+            passes_done, spp / spp_per_pass, m_checkpoint);
+    } catch (const std::exception &e) {
+        Log(Warn, "Failed to write render checkpoint \"%s\": %s",
+            m_checkpoint, e.what());
+    }
+}
+
+MI_VARIANT uint32_t SamplingIntegrator<Float, Spectrum>::resume_checkpoint(
+    Film *film, uint32_t seed, uint32_t spp, uint32_t spp_per_pass) const {
+    fs::path path(m_checkpoint);
+    if (!fs::exists(path))
+        return 0;
+
+    try {
+        ref<FileStream> stream = new FileStream(path, FileStream::ERead);
+
+        char magic[4];
+        uint32_t version, c_seed, c_spp, c_spp_per_pass, passes_done;
+        stream->read_array(magic, 4);
+        if (memcmp(magic, checkpoint_magic, 4) != 0)
+            Throw("not a render checkpoint file");
+        stream->read(version);
+        if (version != checkpoint_version)
+            Throw("unsupported version %u", version);
+        stream->read(c_seed);
+        stream->read(c_spp);
+        stream->read(c_spp_per_pass);
+        stream->read(passes_done);
+
+        if (c_seed != seed || c_spp != spp ||
+            c_spp_per_pass != spp_per_pass) {
+            Log(Warn, "Checkpoint \"%s\" was created by a different render "
+                      "configuration (seed=%u, spp=%u, spp_per_pass=%u vs. "
+                      "seed=%u, spp=%u, spp_per_pass=%u); starting from "
+                      "scratch.", m_checkpoint, c_seed, c_spp, c_spp_per_pass,
+                seed, spp, spp_per_pass);
+            return 0;
+        }
+
+        film->load_state(stream);
+
+        Log(Info, "Resuming render from checkpoint \"%s\" (%u/%u passes "
+                  "complete).", m_checkpoint, passes_done,
+            spp / spp_per_pass);
+        return passes_done;
+    } catch (const std::exception &e) {
+        Log(Warn, "Failed to resume from render checkpoint \"%s\": %s; "
+                  "starting from scratch.", m_checkpoint, e.what());
+        return 0;
+    }
+}
+
 MI_VARIANT typename SamplingIntegrator<Float, Spectrum>::TensorXf
 SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
                                             Sensor *sensor,
@@ -84,6 +341,7 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
                                             bool evaluate) {
     ScopedPhase sp(ProfilerPhase::Render);
     m_stop = false;
+    render_stats::clear();
 
     // Render on a larger film if the 'high quality edges' feature is enabled
     Film *film = sensor->film();
@@ -113,9 +371,16 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
     // Start the render timer (used for timeouts & log messages)
     m_render_timer.reset();
 
+    // Optionally split the rendering megakernel into per-stage launches
+    ScopedWavefrontMode<Float> wavefront_mode(m_wavefront);
+
+    const bool checkpointing = !m_checkpoint.empty();
+    const uint32_t seed_orig = seed;
+    bool completed = false;
+
     TensorXf result;
     if constexpr (!dr::is_jit_v<Float>) {
-        // Render on the CPU using a spiral pattern
+        // Render on the CPU using spiral-seeded work-stealing deques
         uint32_t n_threads = (uint32_t) Thread::thread_count();
 
         Log(Info, "Starting render job (%ux%u, %u sample%s,%s %u thread%s)",
@@ -125,6 +390,8 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
 
         if (m_timeout > 0.f)
             Log(Info, "Timeout specified: %.2f seconds.", m_timeout);
+        if (m_deadline > 0.f)
+            Log(Info, "Deadline specified: %.2f seconds.", m_deadline);
 
         // If no block size was specified, find size that is good for parallelization
         uint32_t block_size = m_block_size;
@@ -139,65 +406,231 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
             }
         }
 
-        Spiral spiral(film_size, film->crop_offset(), block_size, n_passes);
+        /* With checkpointing enabled, the image blocks are scheduled one
+           pass at a time, so that the film between passes is a complete,
+           resumable snapshot of the first few passes */
+        uint32_t pass_begin = 0, scheduler_passes = n_passes;
+        if (checkpointing) {
+            if (n_passes == 1 && spp > 1)
+                Log(Warn, "Checkpoints are only written at pass boundaries; "
+                          "set 'samples_per_pass' to enable intermediate "
+                          "checkpoints.");
+            scheduler_passes = 1;
+            pass_begin = resume_checkpoint(film, seed_orig, spp, spp_per_pass);
+        }
+
+        /* Adaptive sampling: allocate the per-pixel statistics shared by
+           all workers. Pixels are terminated individually inside
+           render_block() once their estimate converges, so blocks whose
+           region has converged cost almost nothing when the scheduler
+           passes over them again. */
+        bool adaptive = m_adaptive_threshold > 0.f &&
+                        spp > m_adaptive_min_samples;
+        if (adaptive && has_flag(film->flags(), FilmFlags::Special)) {
+            Log(Warn, "Adaptive sampling requires a film with an ordinary "
+                      "RGB(A) output; ignoring 'adaptive_threshold'.");
+            adaptive = false;
+        }
+        if (adaptive) {
+            ScalarVector2i border(0);
+            if (film->sample_border())
+                border = ScalarVector2i(film->rfilter()->border_size());
+            m_adaptive_offset = ScalarPoint2i(film->crop_offset()) - border;
+            m_adaptive_stride = film_size.x();
+            size_t n_stats = (size_t) film_size.x() * film_size.y() * 3;
+            m_adaptive_stats.reset(new double[n_stats]);
+            std::memset(m_adaptive_stats.get(), 0, n_stats * sizeof(double));
+
+            /* Schedule the image blocks one pass at a time (as with
+               checkpointing): if all passes were placed in a single
+               scheduling round, two workers could render different passes
+               of the same pixel concurrently and race on the unsynchronized
+               Welford updates in render_block(). */
+            scheduler_passes = 1;
+        }
+
+        /* Work-stealing block scheduler: per-worker deques seeded in spiral
+           order, with scanline splitting when a thread runs out of work */
+        ref<BlockScheduler> scheduler = new BlockScheduler(
+            film_size, film->crop_offset(), block_size, scheduler_passes,
+            n_threads);
 
-        std::mutex mutex;
         ref<ProgressReporter> progress;
         Logger* logger = mitsuba::Thread::thread()->logger();
-        if (logger && Info >= logger->log_level())
-            progress = new ProgressReporter("Rendering");
 
-        // Total number of blocks to be handled, including multiple passes.
-        uint32_t total_blocks = spiral.block_count() * n_passes,
-                 blocks_done = 0;
-
-        // Grain size for parallelization
-        uint32_t grain_size = std::max(total_blocks / (4 * n_threads), 1u);
+        if (logger && Info >= logger->log_level()) {
+            progress = new ProgressReporter("Rendering");
+            // Progress is tracked in scanline units since blocks may split
+            progress->start_async((size_t) scheduler->row_count() *
+                                  (n_passes - pass_begin) / scheduler_passes);
+        }
 
         // Avoid overlaps in RNG seeding RNG when a seed is manually specified
         seed *= dr::prod(film_size);
-
-        ThreadEnvironment env;
-        dr::parallel_for(
-            dr::blocked_range<uint32_t>(0, total_blocks, grain_size),
-            [&](const dr::blocked_range<uint32_t> &range) {
-                ScopedSetThreadEnvironment set_env(env);
-                // Fork a non-overlapping sampler for the current worker
-                ref<Sampler> sampler = sensor->sampler()->fork();
-
-                ref<ImageBlock> block = film->create_block(
-                    ScalarVector2u(block_size) /* size */,
-                    false /* normalize */,
-                    true /* border */);
-
-                std::unique_ptr<Float[]> aovs(new Float[n_channels]);
-
-                // Render up to 'grain_size' image blocks
-                for (uint32_t i = range.begin();
-                     i != range.end() && !should_stop(); ++i) {
-                    auto [offset, size, block_id] = spiral.next_block();
-                    Assert(dr::prod(size) != 0);
-
-                    if (film->sample_border())
-                        offset -= film->rfilter()->border_size();
-
-                    block->set_size(size);
-                    block->set_offset(offset);
-
-                    render_block(scene, sensor, sampler, block, aovs.get(),
-                                 spp_per_pass, seed, block_id, block_size);
-
-                    film->put_block(block);
-
-                    /* Critical section: update progress bar */
-                    if (progress) {
-                        std::lock_guard<std::mutex> lock(mutex);
-                        blocks_done++;
-                        progress->update(blocks_done / (float) total_blocks);
+        uint32_t seed_pass = seed;
+
+        /* Deadline enforcement: stop handing out blocks once the aggregate
+           throughput predicts that rendering another one would overshoot.
+           Blocks always run to completion, hence the film weights of the
+           pixels they cover remain exact. */
+        std::atomic<uint32_t> blocks_done(0);
+        auto past_deadline = [&]() {
+            if (m_deadline <= 0.f)
+                return false;
+            uint32_t done = blocks_done.load(std::memory_order_relaxed);
+            if (done == 0)
+                return false;
+            ScalarFloat elapsed = (ScalarFloat) m_render_timer.value() * 1e-3f;
+            return elapsed + elapsed / done > m_deadline;
+        };
+
+        /* State of the progressive preview callback: worker threads grow a
+           pending dirty region, which is periodically developed and handed
+           to the callback (see set_block_callback()) */
+        std::mutex cb_mutex;
+        ScalarPoint2i cb_min(std::numeric_limits<int32_t>::max()),
+                      cb_max(std::numeric_limits<int32_t>::min());
+        ScalarFloat cb_last = 0.f;
+
+        // Develop the pending region and invoke the callback ('cb_mutex' held)
+        auto cb_flush = [&]() {
+            ScalarPoint2i lo = dr::maximum(
+                              cb_min - ScalarPoint2i(film->crop_offset()), 0),
+                          hi = dr::minimum(
+                              cb_max - ScalarPoint2i(film->crop_offset()),
+                              ScalarPoint2i(film->crop_size()));
+
+            cb_min = ScalarPoint2i(std::numeric_limits<int32_t>::max());
+            cb_max = ScalarPoint2i(std::numeric_limits<int32_t>::min());
+
+            if (dr::any(hi - lo <= 0))
+                return;
+
+            ScalarPoint2u region_offset(lo);
+            ScalarVector2u region_size(hi - lo);
+            m_block_callback(region_offset, region_size,
+                             film->develop_region(region_offset, region_size));
+        };
+
+        /* With thread pinning enabled, workers spread round-robin across the
+           machine's NUMA nodes; the per-worker image block below is then
+           allocated and cleared (i.e. first touched) by its worker, which
+           keeps the buffer local to that worker's node. */
+        ThreadEnvironment env(m_pin_threads);
+
+        ScalarFloat ckpt_last = 0.f;
+        uint32_t pass = pass_begin;
+        while (pass < n_passes) {
+            if (pass != pass_begin)
+                scheduler = new BlockScheduler(film_size, film->crop_offset(),
+                                               block_size, scheduler_passes,
+                                               n_threads);
+
+            /* Per-pass schedulers restart their block enumeration at zero;
+               offset the base seed so that every pass continues the seed
+               sequence with fresh, non-overlapping per-block streams */
+            seed_pass = seed + pass * scheduler->block_count() *
+                                   block_size * block_size;
+
+            dr::parallel_for(
+                dr::blocked_range<uint32_t>(0, n_threads, 1),
+                [&](const dr::blocked_range<uint32_t> &range) {
+                    ScopedSetThreadEnvironment set_env(env);
+                    // Fork a non-overlapping sampler for the current worker
+                    ref<Sampler> sampler = sensor->sampler()->fork();
+
+                    ref<ImageBlock> block = film->create_block(
+                        ScalarVector2u(block_size) /* size */,
+                        false /* normalize */,
+                        true /* border */);
+
+                    std::unique_ptr<Float[]> aovs(new Float[n_channels]);
+
+                    /* Drain the worker's deque, stealing (and splitting) other
+                       workers' blocks once it runs empty */
+                    for (uint32_t worker = range.begin(); worker != range.end();
+                         ++worker) {
+                        BlockScheduler::BlockDescriptor desc;
+                        while (!should_stop() && !past_deadline() &&
+                               scheduler->next_block(worker, desc)) {
+                            BlockScheduler::Vector2i offset = desc.offset;
+                            BlockScheduler::Vector2u size = desc.size;
+                            uint32_t block_id = desc.block_id;
+
+                            if (film->sample_border())
+                                offset -= film->rfilter()->border_size();
+
+                            block->set_size(size);
+                            block->set_offset(offset);
+
+                            render_block(scene, sensor, sampler, block,
+                                         aovs.get(), spp_per_pass, seed_pass,
+                                         block_id, block_size,
+                                         desc.row_begin, desc.row_end);
+
+                            film->put_block(block);
+
+                            if (unlikely(m_block_callback)) {
+                                /* Grow the pending dirty region by the completed
+                                   block and flush it at the throttled rate */
+                                std::lock_guard<std::mutex> guard(cb_mutex);
+                                cb_min = dr::minimum(cb_min, ScalarPoint2i(offset));
+                                cb_max = dr::maximum(
+                                    cb_max, ScalarPoint2i(offset) + ScalarPoint2i(size));
+
+                                ScalarFloat now =
+                                    (ScalarFloat) m_render_timer.value() * 1e-3f;
+                                if (now - cb_last >= m_block_callback_interval) {
+                                    cb_last = now;
+                                    cb_flush();
+                                }
+                            }
+
+                            blocks_done.fetch_add(1, std::memory_order_relaxed);
+
+                            /* A single relaxed atomic addition; the display is
+                               refreshed by the reporter thread */
+                            if (progress)
+                                progress->advance(desc.row_end - desc.row_begin);
+                        }
                     }
                 }
+            );
+
+            if (should_stop() || past_deadline())
+                break;
+            pass += scheduler_passes;
+
+            /* The film now holds an integer number of fully weighted
+               passes -- a consistent snapshot to resume from */
+            if (checkpointing && pass < n_passes) {
+                ScalarFloat now = (ScalarFloat) m_render_timer.value() * 1e-3f;
+                if (now - ckpt_last >= m_checkpoint_interval) {
+                    ckpt_last = now;
+                    write_checkpoint(film, seed_orig, spp, spp_per_pass, pass);
+                }
             }
-        );
+        }
+        completed = pass >= n_passes;
+
+        if (progress)
+            progress->finish();
+
+        // Deliver any blocks that the throttling withheld
+        if (m_block_callback) {
+            std::lock_guard<std::mutex> guard(cb_mutex);
+            cb_flush();
+        }
+
+        if (adaptive) {
+            double total = 0.0;
+            size_t n_pixels = (size_t) film_size.x() * film_size.y();
+            for (size_t i = 0; i < n_pixels; ++i)
+                total += m_adaptive_stats[3 * i + 2];
+            Log(Info, "Adaptive sampling: %.1f/%u samples per pixel on "
+                      "average.", total / (double) n_pixels, spp);
+            m_adaptive_stats.reset();
+        }
 
         if (develop)
             result = film->develop();
@@ -222,6 +655,17 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
                 wavefront_size, n_passes);
         }
 
+        if (m_pass_time_budget > 0.f || m_deadline > 0.f || checkpointing) {
+            /* Low-latency cancellation, deadline prediction, and render
+               checkpoints: the image block must be evaluated in between
+               kernel launches, so render one sample per pixel at a time.
+               The number of passes fused into each launch is then adjusted
+               on the fly (see below). */
+            spp_per_pass   = 1;
+            n_passes       = spp;
+            wavefront_size = (size_t) film_size.x() * (size_t) film_size.y();
+        }
+
         dr::sync_thread(); // Separate from scene initialization (for timings)
 
         Log(Info, "Starting render job (%ux%u, %u sample%s%s)",
@@ -240,6 +684,17 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
         // Seed the underlying random number generators, if applicable
         sampler->seed(seed, (uint32_t) wavefront_size);
 
+        uint32_t pass_begin = 0;
+        if (checkpointing) {
+            pass_begin = resume_checkpoint(film, seed_orig, spp, spp_per_pass);
+
+            /* Fast-forward the sampler past the checkpointed passes so that
+               the resumed render continues the sample sequence exactly
+               where the interrupted one left off */
+            for (uint32_t i = 0; i < pass_begin; ++i)
+                sampler->advance();
+        }
+
         // Allocate a large image block that will receive the entire rendering
         ref<ImageBlock> block = film->create_block();
         block->set_offset(film->crop_offset());
@@ -267,6 +722,9 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
 
         pos += film->crop_offset();
 
+        // Provide the pixel positions (used by blue-noise dithered sampling)
+        sampler->set_pixel_position(Point2u(pos));
+
         // Scale factor that will be applied to ray differentials
         ScalarFloat diff_scale_factor = dr::rsqrt((ScalarFloat) spp);
 
@@ -274,15 +732,108 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
         std::unique_ptr<Float[]> aovs(new Float[n_channels]);
 
         // Potentially render multiple passes
-        for (size_t i = 0; i < n_passes; i++) {
-            render_sample(scene, sensor, sampler, block, aovs.get(), pos,
-                          diff_scale_factor);
+        if (m_pass_time_budget > 0.f || m_deadline > 0.f || checkpointing) {
+            /* Group passes into chunks that are evaluated synchronously and
+               re-size each chunk so that kernels stay close to the time
+               budget, checking for cancellation in between. Every completed
+               pass is fully accumulated into the image block, hence stopping
+               early keeps the film weights exact. */
+            uint32_t passes_per_chunk = 1, pass = pass_begin;
+            Timer chunk_timer;
+            ScalarFloat ckpt_last = 0.f;
+
+            while (pass < n_passes && !should_stop()) {
+                uint32_t chunk =
+                    std::min(passes_per_chunk, n_passes - pass);
+
+                /* Predictive deadline: size the remaining work using the
+                   measured per-pass throughput so that rendering finishes
+                   just under the limit with fully weighted passes */
+                if (m_deadline > 0.f && pass > 0) {
+                    ScalarFloat elapsed =
+                        (ScalarFloat) m_render_timer.value() * 1e-3f;
+                    ScalarFloat per_pass = elapsed / pass,
+                                slack    = m_deadline - elapsed;
+                    if (slack < per_pass)
+                        break;
+                    chunk = std::min(chunk, (uint32_t) (slack / per_pass));
+                }
 
+                chunk_timer.reset();
+                for (uint32_t j = 0; j < chunk; ++j) {
+                    render_sample(scene, sensor, sampler, block, aovs.get(),
+                                  pos, diff_scale_factor);
+                    sampler->advance(); // Will trigger a kernel launch of size 1
+                    sampler->schedule_state();
+                    dr::eval(block->tensor());
+                }
+                dr::sync_thread();
+                pass += chunk;
+
+                /* Grow/shrink the chunk size by at most 2x per step to remain
+                   responsive to noisy timings */
+                ScalarFloat elapsed = (ScalarFloat) chunk_timer.value() * 1e-3f;
+                if (m_pass_time_budget > 0.f) {
+                    if (elapsed < .5f * m_pass_time_budget)
+                        passes_per_chunk = std::min(2 * passes_per_chunk, 4096u);
+                    else if (elapsed > m_pass_time_budget && passes_per_chunk > 1)
+                        passes_per_chunk /= 2;
+                } else {
+                    /* Deadline/checkpoint mode: grow chunks to amortize
+                       launch overheads while keeping throughput samples
+                       frequent */
+                    passes_per_chunk = std::min(2 * passes_per_chunk, 4096u);
+                }
+
+                if (checkpointing && pass < n_passes && !should_stop()) {
+                    ScalarFloat now =
+                        (ScalarFloat) m_render_timer.value() * 1e-3f;
+                    if (now - ckpt_last >= m_checkpoint_interval) {
+                        ckpt_last = now;
+
+                        /* Fold the pending accumulation block into the film
+                           so that the saved state covers every completed
+                           pass, then restart from an empty block */
+                        film->put_block(block);
+                        block->clear();
+                        write_checkpoint(film, seed_orig, spp, spp_per_pass,
+                                         pass);
+                    }
+                }
+            }
+            completed = pass >= n_passes;
+        } else {
+            /* Double-buffered pass pipelining: consecutive passes alternate
+               between two image blocks, so the accumulation (scatter-reduce)
+               kernel of one pass forms no data dependency with the ray
+               tracing kernel of the next. The backend is then free to overlap
+               the two, hiding the accumulation latency that otherwise
+               serializes high pass counts. The blocks are merged on the film
+               at the end, hence the result is unchanged. */
+            ref<ImageBlock> block_2;
             if (n_passes > 1) {
-                sampler->advance(); // Will trigger a kernel launch of size 1
-                sampler->schedule_state();
-                dr::eval(block->tensor());
+                block_2 = film->create_block();
+                block_2->set_offset(film->crop_offset());
+                block_2->set_coalesce(block->coalesce());
             }
+
+            for (size_t i = 0; i < n_passes; i++) {
+                ImageBlock *target =
+                    (i & 1) ? block_2.get() : block.get();
+
+                render_sample(scene, sensor, sampler, target, aovs.get(), pos,
+                              diff_scale_factor);
+
+                if (n_passes > 1) {
+                    sampler->advance(); // Will trigger a kernel launch of size 1
+                    sampler->schedule_state();
+                    dr::eval(target->tensor());
+                }
+            }
+
+            if (block_2)
+                film->put_block(block_2);
+            completed = true;
         }
 
         film->put_block(block);
@@ -317,13 +868,467 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
         }
     }
 
-    if (!m_stop && (evaluate || !dr::is_jit_v<Float>))
+    if (checkpointing && completed && !m_stop) {
+        // The full sample budget was rendered; the checkpoint is obsolete
+        fs::path path(m_checkpoint);
+        if (fs::exists(path) && !fs::remove(path))
+            Log(Warn, "Could not remove completed render checkpoint \"%s\".",
+                m_checkpoint);
+    }
+
+    if (!m_stop && (evaluate || !dr::is_jit_v<Float>)) {
         Log(Info, "Rendering finished. (took %s)",
             util::time_string((float) m_render_timer.value(), true));
+        Log(Info, "%s", render_stats::report());
+    }
 
     return result;
 }
 
+MI_VARIANT std::vector<typename SamplingIntegrator<Float, Spectrum>::TensorXf>
+SamplingIntegrator<Float, Spectrum>::render_batch(
+    Scene *scene, const std::vector<Sensor *> &sensors, uint32_t seed,
+    uint32_t spp, bool develop, bool evaluate) {
+    if (sensors.empty())
+        Throw("render_batch(): at least one sensor must be specified!");
+
+    if constexpr (!dr::is_jit_v<Float>) {
+        /* Scalar variants share no kernel compilation or launch overheads
+           between sensors, hence there is nothing to amortize */
+        return Base::render_batch(scene, sensors, seed, spp, develop,
+                                  evaluate);
+    } else {
+        if (sensors.size() == 1)
+            return { render(scene, sensors[0], seed, spp, develop, evaluate) };
+
+        uint32_t n_sensors = (uint32_t) sensors.size();
+
+        /* Configurations that the fused wavefront cannot express render
+           sequentially through the base class implementation instead */
+        auto fallback = [&](const char *reason) {
+            Log(Debug, "render_batch(): %s, falling back to sequential "
+                       "per-sensor rendering.", reason);
+            return Base::render_batch(scene, sensors, seed, spp, develop,
+                                      evaluate);
+        };
+
+        if (m_pass_time_budget > 0.f || m_deadline > 0.f)
+            return fallback("the 'pass_time_budget'/'deadline' features "
+                            "schedule passes per sensor");
+
+        Film *film_0 = sensors[0]->film();
+        for (uint32_t i = 1; i < n_sensors; ++i) {
+            Film *film_i = sensors[i]->film();
+            if (dr::any(film_i->crop_size() != film_0->crop_size()) ||
+                film_i->sample_border() != film_0->sample_border() ||
+                film_i->rfilter()->border_size() !=
+                    film_0->rfilter()->border_size())
+                return fallback("the sensor films disagree on size or "
+                                "border settings");
+            if (has_flag(film_i->flags(), FilmFlags::Alpha) !=
+                has_flag(film_0->flags(), FilmFlags::Alpha))
+                return fallback("the sensor films disagree on their channel "
+                                "configuration");
+            if (sensors[i]->medium() != sensors[0]->medium())
+                return fallback("the sensors are embedded in different media");
+        }
+
+        for (uint32_t i = 0; i < n_sensors; ++i) {
+            if (has_flag(sensors[i]->film()->flags(), FilmFlags::Special))
+                return fallback("special films accumulate samples through "
+                                "per-sensor state");
+        }
+
+        ScopedPhase sp(ProfilerPhase::Render);
+        m_stop = false;
+        render_stats::clear();
+
+        ScalarVector2u film_size = film_0->crop_size();
+        if (film_0->sample_border())
+            film_size += 2 * film_0->rfilter()->border_size();
+
+        /* The first sensor's sampler supplies the random number stream of
+           the entire combined wavefront */
+        Sampler *sampler = sensors[0]->sampler();
+        if (spp)
+            sampler->set_sample_count(spp);
+        spp = sampler->sample_count();
+
+        uint32_t spp_per_pass = (m_samples_per_pass == (uint32_t) -1)
+                                        ? spp
+                                        : std::min(m_samples_per_pass, spp);
+
+        if ((spp % spp_per_pass) != 0)
+            Throw("sample_count (%d) must be a multiple of spp_per_pass (%d).",
+                  spp, spp_per_pass);
+
+        uint32_t n_passes = spp / spp_per_pass;
+
+        // Determine output channels and prepare the films with this information
+        size_t n_channels = film_0->prepare(aov_names());
+        for (uint32_t i = 1; i < n_sensors; ++i) {
+            if (sensors[i]->film()->prepare(aov_names()) != n_channels)
+                return fallback("the sensor films disagree on their channel "
+                                "count");
+        }
+
+        // Start the render timer (used for timeouts & log messages)
+        m_render_timer.reset();
+
+        // Optionally split the rendering megakernel into per-stage launches
+        ScopedWavefrontMode<Float> wavefront_mode(m_wavefront);
+
+        size_t wavefront_size = (size_t) film_size.x() *
+                                (size_t) film_size.y() *
+                                (size_t) spp_per_pass * (size_t) n_sensors,
+               wavefront_size_limit = 0xffffffffu;
+
+        if (wavefront_size > wavefront_size_limit) {
+            spp_per_pass /=
+                (uint32_t)((wavefront_size + wavefront_size_limit - 1) /
+                           wavefront_size_limit);
+            if (spp_per_pass == 0)
+                Throw("render_batch(): the combined wavefront of %zu sensors "
+                      "exceeds the upper limit of 2^32 = 4294967296 samples "
+                      "even at one sample per pixel. Please render the "
+                      "sensors in smaller groups.", (size_t) n_sensors);
+
+            n_passes       = spp / spp_per_pass;
+            wavefront_size = (size_t) film_size.x() * (size_t) film_size.y() *
+                             (size_t) spp_per_pass * (size_t) n_sensors;
+
+            Log(Warn,
+                "The requested rendering task involves %zu Monte Carlo "
+                "samples, which exceeds the upper limit of 2^32 = 4294967296 "
+                "for this variant. Mitsuba will instead split the rendering "
+                "task into %zu smaller passes to avoid exceeding the limits.",
+                wavefront_size, n_passes);
+        }
+
+        dr::sync_thread(); // Separate from scene initialization (for timings)
+
+        Log(Info, "Starting batch render job (%u sensors, %ux%u, %u sample%s%s)",
+            n_sensors, film_size.x(), film_size.y(), spp, spp == 1 ? "" : "s",
+            n_passes > 1 ? tfm::format(", %u passes", n_passes) : "");
+
+        if (n_passes > 1 && !evaluate) {
+            Log(Warn, "render_batch(): forcing 'evaluate=true' since "
+                      "multi-pass rendering was requested.");
+            evaluate = true;
+        }
+
+        // Inform the sampler about the passes (needed in vectorized modes)
+        sampler->set_samples_per_wavefront(spp_per_pass);
+
+        // Seed the underlying random number generators, if applicable
+        sampler->seed(seed, (uint32_t) wavefront_size);
+
+        // Allocate one image block per sensor
+        std::vector<ref<ImageBlock>> blocks;
+        blocks.reserve(n_sensors);
+        for (uint32_t i = 0; i < n_sensors; ++i) {
+            Film *film = sensors[i]->film();
+            ref<ImageBlock> block = film->create_block();
+            block->set_offset(film->crop_offset());
+            block->set_coalesce(block->coalesce() && spp_per_pass >= 4);
+            blocks.push_back(std::move(block));
+        }
+
+        // Compute discrete sample position
+        UInt32 idx = dr::arange<UInt32>((uint32_t) wavefront_size);
+
+        // Try to avoid a division by an unknown constant if we can help it
+        uint32_t log_spp_per_pass = dr::log2i(spp_per_pass);
+        if ((1u << log_spp_per_pass) == spp_per_pass)
+            idx >>= dr::opaque<UInt32>(log_spp_per_pass);
+        else
+            idx /= dr::opaque<UInt32>(spp_per_pass);
+
+        /* Partition the lanes among the sensors (sensor-major, i.e. each
+           sensor owns a contiguous range of pixels) */
+        uint32_t n_pixels = film_size.x() * film_size.y();
+        UInt32 sensor_idx = idx / dr::opaque<UInt32>(n_pixels);
+        idx = dr::fnmadd(dr::opaque<UInt32>(n_pixels), sensor_idx, idx);
+
+        // Compute the position on the image plane
+        Vector2u pos;
+        pos.y() = idx / film_size[0];
+        pos.x() = dr::fnmadd(film_size[0], pos.y(), idx);
+
+        if (film_0->sample_border())
+            pos -= film_0->rfilter()->border_size();
+
+        // Account for per-sensor crop offsets
+        for (uint32_t i = 0; i < n_sensors; ++i) {
+            ScalarPoint2u crop_offset = sensors[i]->film()->crop_offset();
+            if (dr::any(crop_offset != 0u))
+                dr::masked(pos, dr::eq(sensor_idx, i)) =
+                    pos + Vector2u(crop_offset);
+        }
+
+        // Provide the pixel positions (used by blue-noise dithered sampling)
+        sampler->set_pixel_position(Point2u(pos));
+
+        // Scale factor that will be applied to ray differentials
+        ScalarFloat diff_scale_factor = dr::rsqrt((ScalarFloat) spp);
+
+        Timer timer;
+        std::unique_ptr<Float[]> aovs(new Float[n_channels]);
+
+        // Potentially render multiple passes
+        for (uint32_t i = 0; i < n_passes; ++i) {
+            render_sample_batch(scene, sensors, sampler, blocks, aovs.get(),
+                                pos, sensor_idx, diff_scale_factor);
+
+            if (n_passes > 1) {
+                sampler->advance(); // Will trigger a kernel launch of size 1
+                sampler->schedule_state();
+                for (uint32_t j = 0; j < n_sensors; ++j)
+                    dr::schedule(blocks[j]->tensor());
+                dr::eval();
+            }
+        }
+
+        for (uint32_t i = 0; i < n_sensors; ++i)
+            sensors[i]->film()->put_block(blocks[i]);
+
+        if (n_passes == 1 && jit_flag(JitFlag::VCallRecord) &&
+            jit_flag(JitFlag::LoopRecord)) {
+            Log(Info, "Computation graph recorded. (took %s)",
+                util::time_string((float) timer.reset(), true));
+        }
+
+        std::vector<TensorXf> result(n_sensors);
+        if (develop) {
+            for (uint32_t i = 0; i < n_sensors; ++i) {
+                result[i] = sensors[i]->film()->develop();
+                dr::schedule(result[i]);
+            }
+        } else {
+            for (uint32_t i = 0; i < n_sensors; ++i)
+                sensors[i]->film()->schedule_storage();
+        }
+
+        if (evaluate) {
+            dr::eval();
+
+            if (n_passes == 1 && jit_flag(JitFlag::VCallRecord) &&
+                jit_flag(JitFlag::LoopRecord)) {
+                Log(Info, "Code generation finished. (took %s)",
+                    util::time_string((float) timer.value(), true));
+
+                /* Separate computation graph recording from the actual
+                   rendering time in single-pass mode */
+                m_render_timer.reset();
+            }
+
+            dr::sync_thread();
+        }
+
+        if (!m_stop && evaluate) {
+            Log(Info, "Rendering finished. (took %s)",
+                util::time_string((float) m_render_timer.value(), true));
+            Log(Info, "%s", render_stats::report());
+        }
+
+        return result;
+    }
+}
+
+MI_VARIANT typename SamplingIntegrator<Float, Spectrum>::TensorXf
+SamplingIntegrator<Float, Spectrum>::render_region(Scene *scene,
+                                                   Sensor *sensor,
+                                                   const ScalarPoint2u &offset,
+                                                   const ScalarVector2u &size,
+                                                   uint32_t seed,
+                                                   uint32_t spp) {
+    ScopedPhase sp(ProfilerPhase::Render);
+    m_stop = false;
+
+    Film *film = sensor->film();
+    ScalarVector2u crop_size = film->crop_size();
+
+    if (dr::any(size == 0u) || dr::any(offset + size > crop_size))
+        Throw("render_region(): region (offset=%s, size=%s) lies outside of "
+              "the %ux%u crop window!", offset, size, crop_size.x(),
+              crop_size.y());
+
+    // Potentially adjust the number of samples per pixel if spp != 0
+    Sampler *sampler = sensor->sampler();
+    if (spp)
+        sampler->set_sample_count(spp);
+    spp = sampler->sample_count();
+
+    uint32_t spp_per_pass = (m_samples_per_pass == (uint32_t) -1)
+                                    ? spp
+                                    : std::min(m_samples_per_pass, spp);
+
+    if ((spp % spp_per_pass) != 0)
+        Throw("sample_count (%d) must be a multiple of spp_per_pass (%d).",
+              spp, spp_per_pass);
+
+    uint32_t n_passes = spp / spp_per_pass;
+
+    /* Expand the region by the reconstruction filter radius so that filter
+       taps crossing its boundary are regenerated consistently, then drop
+       the stale sample contributions */
+    uint32_t border = film->rfilter()->border_size();
+    ScalarPoint2i lo = dr::maximum(ScalarPoint2i(offset) -
+                                   (int32_t) border, 0),
+                  hi = dr::minimum(ScalarPoint2i(offset + size) +
+                                   (int32_t) border, ScalarPoint2i(crop_size));
+
+    ScalarPoint2u region_offset(lo);
+    ScalarVector2u region_size(hi - lo);
+
+    film->clear_region(region_offset, region_size);
+
+    // Start the render timer (used for timeouts & log messages)
+    m_render_timer.reset();
+
+    // Optionally split the rendering megakernel into per-stage launches
+    ScopedWavefrontMode<Float> wavefront_mode(m_wavefront);
+
+    Log(Debug, "Re-rendering %ux%u region at %s (%u sample%s)",
+        region_size.x(), region_size.y(), region_offset, spp,
+        spp == 1 ? "" : "s");
+
+    if constexpr (!dr::is_jit_v<Float>) {
+        // Only schedule image blocks that intersect the region
+        uint32_t n_threads = (uint32_t) Thread::thread_count();
+
+        uint32_t block_size = m_block_size;
+        if (block_size == 0) {
+            block_size = MI_BLOCK_SIZE; // 32x32
+            while (true) {
+                // Ensure that there is a block for every thread
+                if (block_size == 1 || dr::prod((region_size + block_size - 1) /
+                                                 block_size) >= n_threads)
+                    break;
+                block_size /= 2;
+            }
+        }
+
+        ref<BlockScheduler> scheduler = new BlockScheduler(
+            region_size,
+            ScalarVector2u(film->crop_offset()) +
+                ScalarVector2u(region_offset),
+            block_size, n_passes, n_threads);
+
+        // Avoid overlaps in RNG seeding RNG when a seed is manually specified
+        seed *= dr::prod(crop_size);
+
+        ThreadEnvironment env(m_pin_threads);
+        dr::parallel_for(
+            dr::blocked_range<uint32_t>(0, n_threads, 1),
+            [&](const dr::blocked_range<uint32_t> &range) {
+                ScopedSetThreadEnvironment set_env(env);
+                // Fork a non-overlapping sampler for the current worker
+                ref<Sampler> sampler = sensor->sampler()->fork();
+
+                ref<ImageBlock> block = film->create_block(
+                    ScalarVector2u(block_size) /* size */,
+                    false /* normalize */,
+                    true /* border */);
+
+                std::unique_ptr<Float[]> aovs(
+                    new Float[block->channel_count()]);
+
+                for (uint32_t worker = range.begin(); worker != range.end();
+                     ++worker) {
+                    BlockScheduler::BlockDescriptor desc;
+                    while (!should_stop() &&
+                           scheduler->next_block(worker, desc)) {
+                        block->set_size(desc.size);
+                        block->set_offset(desc.offset);
+
+                        render_block(scene, sensor, sampler, block, aovs.get(),
+                                     spp_per_pass, seed, desc.block_id,
+                                     block_size, desc.row_begin, desc.row_end);
+
+                        film->put_block(block);
+                    }
+                }
+            }
+        );
+    } else {
+        size_t wavefront_size = (size_t) region_size.x() *
+                                (size_t) region_size.y() *
+                                (size_t) spp_per_pass,
+               wavefront_size_limit = 0xffffffffu;
+
+        if (wavefront_size > wavefront_size_limit) {
+            spp_per_pass /=
+                (uint32_t) ((wavefront_size + wavefront_size_limit - 1) /
+                            wavefront_size_limit);
+            n_passes       = spp / spp_per_pass;
+            wavefront_size = (size_t) region_size.x() *
+                             (size_t) region_size.y() * (size_t) spp_per_pass;
+        }
+
+        // Inform the sampler about the passes (needed in vectorized modes)
+        sampler->set_samples_per_wavefront(spp_per_pass);
+
+        // Seed the underlying random number generators, if applicable
+        sampler->seed(seed, (uint32_t) wavefront_size);
+
+        /* Allocate an image block covering the (expanded) region; filter
+           taps that extend past its boundary land in the block's border
+           and are merged into the surrounding film pixels at the end */
+        ref<ImageBlock> block = film->create_block(
+            region_size /* size */,
+            false /* normalize */,
+            true /* border */);
+        block->set_offset(ScalarPoint2i(film->crop_offset()) +
+                          ScalarPoint2i(region_offset));
+
+        // Only use the ImageBlock coalescing feature when rendering enough samples
+        block->set_coalesce(block->coalesce() && spp_per_pass >= 4);
+
+        std::unique_ptr<Float[]> aovs(new Float[block->channel_count()]);
+
+        // Compute discrete sample position
+        UInt32 idx = dr::arange<UInt32>((uint32_t) wavefront_size);
+
+        // Try to avoid a division by an unknown constant if we can help it
+        uint32_t log_spp_per_pass = dr::log2i(spp_per_pass);
+        if ((1u << log_spp_per_pass) == spp_per_pass)
+            idx >>= dr::opaque<UInt32>(log_spp_per_pass);
+        else
+            idx /= dr::opaque<UInt32>(spp_per_pass);
+
+        // Compute the position on the image plane
+        Vector2u pos;
+        pos.y() = idx / region_size[0];
+        pos.x() = dr::fnmadd(region_size[0], pos.y(), idx);
+        pos += ScalarVector2u(film->crop_offset()) +
+               ScalarVector2u(region_offset);
+
+        // Scale factor that will be applied to ray differentials
+        ScalarFloat diff_scale_factor = dr::rsqrt((ScalarFloat) spp);
+
+        for (size_t i = 0; i < n_passes; i++) {
+            render_sample(scene, sensor, sampler, block, aovs.get(), pos,
+                          diff_scale_factor);
+
+            if (n_passes > 1) {
+                sampler->advance(); // Will trigger a kernel launch of size 1
+                sampler->schedule_state();
+                dr::eval(block->tensor());
+            }
+        }
+
+        film->put_block(block);
+    }
+
+    return film->develop_region(offset, size);
+}
+
+/* Per-thread shadow ray batch installed by render_block() while it renders a
+   block with deferred NEE batching enabled (see \ref ShadowRayBatch). Stored
+   as a type-erased pointer since the actual type depends on the variant. */
+static thread_local void *active_shadow_batch = nullptr;
+
 MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *scene,
                                                                    const Sensor *sensor,
                                                                    Sampler *sampler,
@@ -332,7 +1337,9 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
                                                                    uint32_t sample_count,
                                                                    uint32_t seed,
                                                                    uint32_t block_id,
-                                                                   uint32_t block_size) const {
+                                                                   uint32_t block_size,
+                                                                   uint32_t row_begin,
+                                                                   uint32_t row_end) const {
 
     if constexpr (!dr::is_array_v<Float>) {
         uint32_t pixel_count = block_size * block_size;
@@ -346,20 +1353,159 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
         // Clear block (it's being reused)
         block->clear();
 
-        for (uint32_t i = 0; i < pixel_count && !should_stop(); ++i) {
-            sampler->seed(seed + i);
+        /* Defer NEE shadow rays of cooperating integrators so that the whole
+           block can be occlusion-tested as one sorted batch (special films
+           accumulate through prepare_sample() and are left alone). Disabled
+           in adaptive renders: the deferred NEE contributions would be
+           missing from the per-pixel statistics at the termination test,
+           understating the mean and variance of NEE-dominated pixels. */
+        ShadowRayBatch shadow_batch;
+        bool batch_shadow = m_batch_shadow_rays && !m_adaptive_stats &&
+            !has_flag(sensor->film()->flags(), FilmFlags::Special);
+        if (batch_shadow)
+            active_shadow_batch = &shadow_batch;
+
+        // Restrict rendering to the scanlines assigned by the scheduler
+        uint32_t y_end = std::min(row_end, (uint32_t) block->size().y());
+
+        /* Per-pixel adaptive termination (see \ref m_adaptive_threshold) */
+        double *adaptive_stats = m_adaptive_stats.get();
+        auto adaptive_converged = [this](const double *s) {
+            double n = s[2];
+            if (n < (double) m_adaptive_min_samples)
+                return false;
+            /* 95% confidence interval of the estimate vs. the relative
+               error threshold (guarded against black pixels) */
+            double var = s[1] / (n - 1.0),
+                   err = 1.96 * std::sqrt(var / n);
+            return err <= (double) m_adaptive_threshold *
+                          std::max(s[0], 1e-3);
+        };
+
+        /* Batched primary visibility: pre-intersect the camera rays of a
+           chunk of pixels through the backend's intersection stream before
+           invoking the integrator (see \ref m_batch_primary_rays). Skipped
+           for integrators whose \ref sample_with_interaction() would merely
+           re-trace the rays, and in adaptive renders, where the number of
+           samples a pixel will take is not known ahead of time. */
+        bool batch_primary = m_batch_primary_rays &&
+                             reuses_primary_interaction() && !adaptive_stats;
+
+        if (batch_primary) {
+            /* Number of primary rays to intersect per stream call. Bounds
+               the temporary ray/interaction storage of this worker. */
+            constexpr uint32_t MaxPrimaryBatch = 4096;
+
+            std::vector<Ray3f> rays;
+            std::vector<SurfaceInteraction3f> sis;
+
+            uint32_t i = 0;
+            while (i < pixel_count && !should_stop()) {
+                /* Pass 1: generate the camera rays of a chunk of pixels.
+                   Each pixel re-seeds the sampler, so the same rays can be
+                   regenerated below. */
+                uint32_t chunk_begin = i;
+                rays.clear();
+                for (; i < pixel_count &&
+                       (uint32_t) rays.size() < MaxPrimaryBatch &&
+                       !should_stop(); ++i) {
+                    sampler->seed(seed + i);
+
+                    Point2u pos = dr::morton_decode<Point2u>(i);
+                    if (dr::any(pos >= block->size()) || pos.y() < row_begin ||
+                        pos.y() >= y_end)
+                        continue;
+
+                    Point2i pos_i = Point2i(pos) + block->offset();
+                    sampler->set_pixel_position(Point2u(pos_i));
+
+                    Point2f pos_f = Point2f(pos_i);
+                    for (uint32_t j = 0; j < sample_count; ++j) {
+                        rays.push_back(std::get<0>(sample_camera_ray(
+                            sensor, sampler, pos_f, diff_scale_factor)));
+                        sampler->advance();
+                    }
+                }
 
-            Point2u pos = dr::morton_decode<Point2u>(i);
-            if (dr::any(pos >= block->size()))
-                continue;
+                sis.resize(rays.size());
+                scene->ray_intersect_many(
+                    rays.data(), sis.data(), rays.size(),
+                    RayFlags::All | RayFlags::BoundaryTest, true);
+
+                /* Pass 2: re-seed and run the integrator with the
+                   pre-computed interactions */
+                size_t k = 0;
+                for (uint32_t p = chunk_begin; p < i && !should_stop(); ++p) {
+                    sampler->seed(seed + p);
+
+                    Point2u pos = dr::morton_decode<Point2u>(p);
+                    if (dr::any(pos >= block->size()) || pos.y() < row_begin ||
+                        pos.y() >= y_end)
+                        continue;
+
+                    Point2i pos_i = Point2i(pos) + block->offset();
+                    sampler->set_pixel_position(Point2u(pos_i));
+
+                    Point2f pos_f = Point2f(pos_i);
+                    for (uint32_t j = 0; j < sample_count && !should_stop(); ++j) {
+                        render_sample(scene, sensor, sampler, block, aovs,
+                                      pos_f, diff_scale_factor, true,
+                                      &sis[k++]);
+                        sampler->advance();
+                    }
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < pixel_count && !should_stop(); ++i) {
+                sampler->seed(seed + i);
+
+                Point2u pos = dr::morton_decode<Point2u>(i);
+                if (dr::any(pos >= block->size()) || pos.y() < row_begin ||
+                    pos.y() >= y_end)
+                    continue;
+
+                Point2i pos_i = Point2i(pos) + block->offset();
+
+                double *stats = nullptr;
+                if (adaptive_stats) {
+                    stats = adaptive_stats +
+                            3 * ((size_t) (pos_i.y() - m_adaptive_offset.y()) *
+                                     m_adaptive_stride +
+                                 (size_t) (pos_i.x() - m_adaptive_offset.x()));
+                    if (adaptive_converged(stats))
+                        continue;
+                }
 
-            Point2f pos_f = Point2f(Point2i(pos) + block->offset());
-            for (uint32_t j = 0; j < sample_count && !should_stop(); ++j) {
-                render_sample(scene, sensor, sampler, block, aovs, pos_f,
-                              diff_scale_factor);
-                sampler->advance();
+                sampler->set_pixel_position(Point2u(pos_i));
+
+                Point2f pos_f = Point2f(pos_i);
+                for (uint32_t j = 0; j < sample_count && !should_stop(); ++j) {
+                    render_sample(scene, sensor, sampler, block, aovs, pos_f,
+                                  diff_scale_factor);
+                    sampler->advance();
+
+                    if (stats) {
+                        /* Welford update with the sample's luminance
+                           (render_sample() left the RGB values in 'aovs') */
+                        double x = (double) luminance(
+                                       Color3f(aovs[0], aovs[1], aovs[2])),
+                               n = stats[2] + 1.0,
+                               delta = x - stats[0];
+                        stats[0] += delta / n;
+                        stats[1] += delta * (x - stats[0]);
+                        stats[2] = n;
+
+                        if (adaptive_converged(stats))
+                            break;
+                    }
+                }
             }
         }
+
+        if (batch_shadow) {
+            active_shadow_batch = nullptr;
+            resolve_shadow_rays(scene, sensor, block, shadow_batch);
+        }
     } else {
         DRJIT_MARK_USED(scene);
         DRJIT_MARK_USED(sensor);
@@ -370,22 +1516,20 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
         DRJIT_MARK_USED(seed);
         DRJIT_MARK_USED(block_id);
         DRJIT_MARK_USED(block_size);
+        DRJIT_MARK_USED(row_begin);
+        DRJIT_MARK_USED(row_end);
         Throw("Not implemented for JIT arrays.");
     }
 }
 
-MI_VARIANT void
-SamplingIntegrator<Float, Spectrum>::render_sample(const Scene *scene,
-                                                   const Sensor *sensor,
-                                                   Sampler *sampler,
-                                                   ImageBlock *block,
-                                                   Float *aovs,
-                                                   const Vector2f &pos,
-                                                   ScalarFloat diff_scale_factor,
-                                                   Mask active) const {
+MI_VARIANT
+std::tuple<typename SamplingIntegrator<Float, Spectrum>::RayDifferential3f,
+           Spectrum,
+           typename SamplingIntegrator<Float, Spectrum>::Vector2f>
+SamplingIntegrator<Float, Spectrum>::sample_camera_ray(
+    const Sensor *sensor, Sampler *sampler, const Vector2f &pos,
+    ScalarFloat diff_scale_factor, Mask active) const {
     const Film *film = sensor->film();
-    const bool has_alpha = has_flag(film->flags(), FilmFlags::Alpha);
-    const bool box_filter = film->rfilter()->is_box_filter();
 
     ScalarVector2f scale = 1.f / ScalarVector2f(film->crop_size()),
                    offset = -ScalarVector2f(film->crop_offset()) * scale;
@@ -411,10 +1555,49 @@ SamplingIntegrator<Float, Spectrum>::render_sample(const Scene *scene,
     if (ray.has_differentials)
         ray.scale_differential(diff_scale_factor);
 
+    return { ray, ray_weight, sample_pos };
+}
+
+MI_VARIANT void
+SamplingIntegrator<Float, Spectrum>::render_sample(const Scene *scene,
+                                                   const Sensor *sensor,
+                                                   Sampler *sampler,
+                                                   ImageBlock *block,
+                                                   Float *aovs,
+                                                   const Vector2f &pos,
+                                                   ScalarFloat diff_scale_factor,
+                                                   Mask active,
+                                                   const SurfaceInteraction3f *pre_si) const {
+    /* In scalar modes, reclaim all per-sample scratch storage (see
+       \ref scratch_arena()) handed out during the previous sample */
+    if constexpr (!dr::is_jit_v<Float>)
+        scratch_arena().reset();
+
+    const Film *film = sensor->film();
+    const bool has_alpha = has_flag(film->flags(), FilmFlags::Alpha);
+    const bool box_filter = film->rfilter()->is_box_filter();
+
+    auto [ray, ray_weight, sample_pos] =
+        sample_camera_ray(sensor, sampler, pos, diff_scale_factor, active);
+
     const Medium *medium = sensor->medium();
 
-    auto [spec, valid] = sample(scene, sampler, ray, medium,
-               aovs + (has_alpha ? 5 : 4) /* skip R,G,B,[A],W */, active);
+    /* Register this sample with the block's shadow ray batch (if any) so
+       that deferred NEE contributions can be splatted at the same position
+       with the same camera ray weight */
+    if constexpr (!dr::is_jit_v<Float>) {
+        if (ShadowRayBatch *batch = (ShadowRayBatch *) active_shadow_batch)
+            batch->samples.push_back(
+                { ray_weight, ray.wavelengths, box_filter ? pos : sample_pos });
+    }
+
+    Float *aovs_inner = aovs + (has_alpha ? 5 : 4); /* skip R,G,B,[A],W */
+
+    auto [spec, valid] =
+        pre_si ? sample_with_interaction(scene, sampler, ray, *pre_si,
+                                         active && pre_si->is_valid(),
+                                         medium, aovs_inner, active)
+               : sample(scene, sampler, ray, medium, aovs_inner, active);
 
     UnpolarizedSpectrum spec_u = unpolarized_spectrum(ray_weight * spec);
 
@@ -448,6 +1631,212 @@ SamplingIntegrator<Float, Spectrum>::render_sample(const Scene *scene,
     block->put(box_filter ? pos : sample_pos, aovs, active);
 }
 
+MI_VARIANT void
+SamplingIntegrator<Float, Spectrum>::render_sample_batch(
+    const Scene *scene, const std::vector<Sensor *> &sensors,
+    Sampler *sampler, const std::vector<ref<ImageBlock>> &blocks, Float *aovs,
+    const Vector2u &pos, const UInt32 &sensor_idx,
+    ScalarFloat diff_scale_factor) const {
+    uint32_t n_sensors = (uint32_t) sensors.size();
+
+    // render_batch() ensures that this flag agrees across all films
+    const bool has_alpha =
+        has_flag(sensors[0]->film()->flags(), FilmFlags::Alpha);
+
+    /* Draw all sample dimensions unconditionally so that every lane consumes
+       the same random number stream regardless of its owning sensor */
+    Point2f jitter = sampler->next_2d();
+
+    Point2f aperture_sample(.5f);
+    bool needs_aperture = false;
+    for (uint32_t i = 0; i < n_sensors; ++i)
+        needs_aperture |= sensors[i]->needs_aperture_sample();
+    if (needs_aperture)
+        aperture_sample = sampler->next_2d();
+
+    Float time_sample = 0.f;
+    bool needs_time = false;
+    for (uint32_t i = 0; i < n_sensors; ++i)
+        needs_time |= sensors[i]->shutter_open_time() > 0.f;
+    if (needs_time)
+        time_sample = sampler->next_1d();
+
+    Float wavelength_sample = 0.f;
+    if constexpr (is_spectral_v<Spectrum>)
+        wavelength_sample = sampler->next_1d();
+
+    Vector2f sample_pos = Point2f(pos) + jitter;
+
+    /* Generate camera rays by dispatching each lane to its owning sensor
+       (analogous to the 'batch' sensor plugin). Ray differentials are only
+       usable when every sensor provides them, since 'has_differentials' is
+       a scalar property of the merged ray. */
+    RayDifferential3f ray = dr::zeros<RayDifferential3f>();
+    Spectrum ray_weight = dr::zeros<Spectrum>();
+    bool has_differentials = true;
+
+    for (uint32_t i = 0; i < n_sensors; ++i) {
+        Mask active_i = dr::eq(sensor_idx, i);
+
+        const Film *film = sensors[i]->film();
+        ScalarVector2f scale  = 1.f / ScalarVector2f(film->crop_size()),
+                       offset = -ScalarVector2f(film->crop_offset()) * scale;
+        Vector2f adjusted_pos = dr::fmadd(sample_pos, scale, offset);
+
+        Float time = sensors[i]->shutter_open();
+        if (sensors[i]->shutter_open_time() > 0.f)
+            time += time_sample * sensors[i]->shutter_open_time();
+
+        auto [ray_i, ray_weight_i] = sensors[i]->sample_ray_differential(
+            time, wavelength_sample, adjusted_pos, aperture_sample, active_i);
+
+        ray[active_i]        = ray_i;
+        ray_weight[active_i] = ray_weight_i;
+        has_differentials &= ray_i.has_differentials;
+    }
+
+    ray.has_differentials = has_differentials;
+    if (ray.has_differentials)
+        ray.scale_differential(diff_scale_factor);
+
+    const Medium *medium = sensors[0]->medium();
+
+    auto [spec, valid] = sample(scene, sampler, ray, medium,
+               aovs + (has_alpha ? 5 : 4) /* skip R,G,B,[A],W */, true);
+
+    UnpolarizedSpectrum spec_u = unpolarized_spectrum(ray_weight * spec);
+
+    Color3f rgb;
+    if constexpr (is_spectral_v<Spectrum>)
+        rgb = spectrum_to_srgb(spec_u, ray.wavelengths, true);
+    else if constexpr (is_monochromatic_v<Spectrum>)
+        rgb = spec_u.x();
+    else
+        rgb = spec_u;
+
+    aovs[0] = rgb.x();
+    aovs[1] = rgb.y();
+    aovs[2] = rgb.z();
+
+    if (likely(has_alpha)) {
+        aovs[3] = dr::select(valid, Float(1.f), Float(0.f));
+        aovs[4] = 1.f;
+    } else {
+        aovs[3] = 1.f;
+    }
+
+    // Accumulate each lane into the image block of its owning sensor
+    Vector2f pos_f = Vector2f(Point2f(pos));
+    for (uint32_t i = 0; i < n_sensors; ++i) {
+        Mask active_i = dr::eq(sensor_idx, i);
+        bool box_filter = sensors[i]->film()->rfilter()->is_box_filter();
+
+        // With box filter, ignore random offset to prevent numerical instabilities
+        blocks[i]->put(box_filter ? pos_f : sample_pos, aovs, active_i);
+    }
+}
+
+MI_VARIANT bool SamplingIntegrator<Float, Spectrum>::shadow_batching_active() const {
+    if constexpr (!dr::is_jit_v<Float>)
+        return active_shadow_batch != nullptr;
+    else
+        return false;
+}
+
+MI_VARIANT bool
+SamplingIntegrator<Float, Spectrum>::defer_shadow_ray(const Ray3f &ray,
+                                                      const Spectrum &value) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        ShadowRayBatch *batch = (ShadowRayBatch *) active_shadow_batch;
+        if (!batch || batch->samples.empty())
+            return false;
+        batch->candidates.push_back(
+            { ray, value, (uint32_t) (batch->samples.size() - 1) });
+        return true;
+    } else {
+        DRJIT_MARK_USED(ray);
+        DRJIT_MARK_USED(value);
+        return false;
+    }
+}
+
+MI_VARIANT void
+SamplingIntegrator<Float, Spectrum>::resolve_shadow_rays(const Scene *scene,
+                                                         const Sensor *sensor,
+                                                         ImageBlock *block,
+                                                         ShadowRayBatch &batch) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        size_t n = batch.candidates.size();
+        if (n == 0)
+            return;
+
+        /* Sort the rays by direction octant and 32^3-quantized origin so
+           that the backend's occlusion stream traverses coherent packets */
+        ScalarBoundingBox3f bbox = scene->bbox();
+        ScalarVector3f extents = bbox.extents();
+        ScalarVector3f inv_extents = dr::select(
+            extents > 0.f, dr::rcp(dr::maximum(extents, 1e-20f)), 0.f);
+
+        std::vector<std::pair<uint32_t, uint32_t>> order(n);
+        for (size_t i = 0; i < n; ++i) {
+            const Ray3f &ray = batch.candidates[i].ray;
+            Vector3f rel = (ray.o - bbox.min) * inv_extents;
+            uint32_t key = 0;
+            for (int k = 0; k < 3; ++k) {
+                key = (key << 1) | (ray.d[k] < 0.f ? 1u : 0u);
+                key = (key << 5) |
+                      dr::minimum((uint32_t) dr::maximum(rel[k] * 32.f, 0.f), 31u);
+            }
+            order[i] = { key, (uint32_t) i };
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<Ray3f> rays;
+        rays.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            rays.push_back(batch.candidates[order[i].second].ray);
+
+        std::unique_ptr<Mask[]> occluded(new Mask[n]);
+        scene->ray_test_many(rays.data(), occluded.get(), n);
+
+        /* Splat unoccluded contributions with zero sample weight: the
+           originating camera sample was already counted by render_sample(),
+           so the reconstruction filter normalization must not change */
+        DRJIT_MARK_USED(sensor);
+        std::vector<Float> aovs(block->channel_count(), 0.f);
+
+        for (size_t i = 0; i < n; ++i) {
+            if (occluded[i])
+                continue;
+
+            const auto &c = batch.candidates[order[i].second];
+            const auto &s = batch.samples[c.sample];
+
+            UnpolarizedSpectrum spec_u = unpolarized_spectrum(s.weight * c.value);
+
+            Color3f rgb;
+            if constexpr (is_spectral_v<Spectrum>)
+                rgb = spectrum_to_srgb(spec_u, s.wavelengths, true);
+            else if constexpr (is_monochromatic_v<Spectrum>)
+                rgb = spec_u.x();
+            else
+                rgb = spec_u;
+
+            aovs[0] = rgb.x();
+            aovs[1] = rgb.y();
+            aovs[2] = rgb.z();
+
+            block->put(s.pos, aovs.data());
+        }
+    } else {
+        DRJIT_MARK_USED(scene);
+        DRJIT_MARK_USED(sensor);
+        DRJIT_MARK_USED(block);
+        DRJIT_MARK_USED(batch);
+        Throw("resolve_shadow_rays() is only available in scalar variants.");
+    }
+}
+
 MI_VARIANT std::pair<Spectrum, typename SamplingIntegrator<Float, Spectrum>::Mask>
 SamplingIntegrator<Float, Spectrum>::sample(const Scene * /* scene */,
                                             Sampler * /* sampler */,
@@ -458,6 +1847,16 @@ SamplingIntegrator<Float, Spectrum>::sample(const Scene * /* scene */,
     NotImplementedError("sample");
 }
 
+MI_VARIANT std::pair<Spectrum, typename SamplingIntegrator<Float, Spectrum>::Mask>
+SamplingIntegrator<Float, Spectrum>::sample_with_interaction(
+    const Scene *scene, Sampler *sampler, const RayDifferential3f &ray,
+    const SurfaceInteraction3f & /* si */, Mask /* si_valid */,
+    const Medium *medium, Float *aovs, Mask active) const {
+    /* Integrators that cannot consume a precomputed primary intersection
+       simply redo the (now redundant) scene traversal */
+    return sample(scene, sampler, ray, medium, aovs, active);
+}
+
 // -----------------------------------------------------------------------------
 
 MI_VARIANT MonteCarloIntegrator<Float, Spectrum>::MonteCarloIntegrator(const Properties &props)
@@ -477,10 +1876,93 @@ MI_VARIANT MonteCarloIntegrator<Float, Spectrum>::MonteCarloIntegrator(const Pro
         Throw("\"rr_depth\" must be set to a value greater than zero!");
 
     m_rr_depth = (uint32_t) rr_depth;
+
+    m_reorder_rays = props.get<bool>("reorder_rays", false);
 }
 
 MI_VARIANT MonteCarloIntegrator<Float, Spectrum>::~MonteCarloIntegrator() { }
 
+MI_VARIANT typename MonteCarloIntegrator<Float, Spectrum>::SurfaceInteraction3f
+MonteCarloIntegrator<Float, Spectrum>::reordered_ray_intersect(
+    const Scene *scene, const Ray3f &ray, uint32_t ray_flags, Mask coherent,
+    Mask active) const {
+    if constexpr (dr::is_jit_v<Float>) {
+        /* Compaction and reordering require evaluated arrays and are
+           therefore limited to wavefront-style execution; a recorded loop
+           traces the rays in their original order. Small batches aren't
+           worth the extra permutation passes, and coherent (camera) rays
+           are both well-ordered and fully alive already. */
+        uint32_t n = (uint32_t) dr::width(ray.o);
+        if (!jit_flag(JitFlag::LoopRecord) && n >= 1024 &&
+            dr::none(coherent)) {
+            /* Wavefront compaction: enumerate the lanes whose paths are
+               still alive. Launching the traversal kernel over the
+               compacted batch (rather than masking dead lanes inside a
+               full-width launch) restores SM occupancy on deep-bounce
+               scenes, but is only worthwhile once a significant fraction
+               of the wavefront has died. */
+            UInt32 order = dr::compress(active);
+            uint32_t n_active = (uint32_t) dr::width(order);
+
+            bool compact = n_active <= n - n / 4,
+                 reorder = m_reorder_rays && n_active >= 1024;
+
+            if (!compact && !reorder)
+                return scene->ray_intersect(ray, ray_flags, coherent, active);
+
+            if (n_active == 0)
+                return dr::zeros<SurfaceInteraction3f>(n);
+
+            if (reorder) {
+                /* Quantized traversal-coherence key: the direction octant
+                   in bits 1..3 and, below it, the ray origin's position
+                   relative to the scene midpoint along the dominant
+                   bounding box axis. The key is deliberately coarse: the
+                   permutation below is built via mask compression, whose
+                   cost grows linearly with the number of buckets (Dr.Jit
+                   does not expose a device radix sort). The direction
+                   octant captures the bulk of the traversal divergence
+                   between the lanes of a warp/packet. */
+                ScalarBoundingBox3f bbox = scene->bbox();
+                uint32_t axis = bbox.major_axis();
+                ScalarFloat split = .5f * (bbox.min[axis] + bbox.max[axis]);
+
+                UInt32 key = dr::select(ray.d.x() < 0.f, 8u, 0u) |
+                             dr::select(ray.d.y() < 0.f, 4u, 0u) |
+                             dr::select(ray.d.z() < 0.f, 2u, 0u) |
+                             dr::select(ray.o[axis] > split, 1u, 0u);
+
+                /* Build a permutation that groups the active lanes by key;
+                   inactive lanes are compacted out as a side effect */
+                order = dr::zeros<UInt32>(n_active);
+                uint32_t offset = 0;
+                for (uint32_t bucket = 0; bucket < 16; ++bucket) {
+                    UInt32 idx = dr::compress(active && dr::eq(key, bucket));
+                    uint32_t count = (uint32_t) dr::width(idx);
+                    if (count == 0)
+                        continue;
+                    dr::scatter(order, idx, dr::arange<UInt32>(count) + offset);
+                    offset += count;
+                }
+            }
+
+            Ray3f ray_c = dr::gather<Ray3f>(ray, order);
+
+            SurfaceInteraction3f si_c = scene->ray_intersect(
+                ray_c, ray_flags, /* coherent = */ false, Mask(true));
+
+            /* Scatter the intersections back to their original lanes;
+               compacted-out lanes keep the zero-initialized record that a
+               masked ray_intersect() would have produced for them */
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>(n);
+            dr::scatter(si, si_c, order);
+            return si;
+        }
+    }
+
+    return scene->ray_intersect(ray, ray_flags, coherent, active);
+}
+
 // -----------------------------------------------------------------------------
 
 MI_VARIANT AdjointIntegrator<Float, Spectrum>::AdjointIntegrator(const Properties &props)
@@ -495,6 +1977,8 @@ MI_VARIANT AdjointIntegrator<Float, Spectrum>::AdjointIntegrator(const Propertie
     m_max_depth = props.get<int>("max_depth", -1);
     if (m_max_depth < 0 && m_max_depth != -1)
         Throw("\"max_depth\" must be set to -1 (infinite) or a value >= 0");
+
+    m_accum_slots = props.get<uint32_t>("accumulation_slots", 0);
 }
 
 MI_VARIANT AdjointIntegrator<Float, Spectrum>::~AdjointIntegrator() { }
@@ -508,6 +1992,7 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
                                            bool evaluate) {
     ScopedPhase sp(ProfilerPhase::Render);
     m_stop = false;
+    render_stats::clear();
 
     Film *film = sensor->film();
     ScalarVector2u film_size = film->size(),
@@ -574,9 +2059,9 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
         ref<ProgressReporter> progress = new ProgressReporter("Rendering");
 
         size_t total_samples = samples_per_pass * n_passes;
+        progress->start_async(total_samples);
 
         seed *= (uint32_t) total_samples / (uint32_t) grain_size;
-        std::atomic<size_t> samples_done(0);
 
         // Start the render timer (used for timeouts & log messages)
         m_render_timer.reset();
@@ -610,23 +2095,22 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
 
                     ctr++;
                     if (ctr > 10000) {
-                        std::lock_guard<std::mutex> lock(mutex);
-                        samples_done += ctr;
+                        progress->advance(ctr);
                         ctr = 0;
-                        progress->update(samples_done / (ScalarFloat) total_samples);
                     }
                 }
-                total_samples += ctr;
+                progress->advance(ctr);
 
                 // When all samples are done for this range, commit to the film
                 /* locked */ {
                     std::lock_guard<std::mutex> lock(mutex);
-                    progress->update(samples_done / (ScalarFloat) total_samples);
                     film->put_block(block);
                 }
             }
         );
 
+        progress->finish();
+
         if (develop)
             result = film->develop();
     } else {
@@ -674,6 +2158,15 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
            (they are highly irregular in any particle tracing-based method) */
         block->set_coalesce(false);
 
+        /* Accumulate into privatized copies of the image to reduce atomic
+           contention when splats concentrate in a few pixels. On CUDA
+           backends, contended global atomics serialize badly enough that a
+           handful of copies is worthwhile by default. */
+        uint32_t slots = m_accum_slots != 0
+                             ? m_accum_slots
+                             : (dr::is_cuda_v<Float> ? 8u : 1u);
+        block->set_slot_count(slots);
+
         Timer timer;
         for (size_t i = 0; i < n_passes; i++) {
             sample(scene, sensor, sampler, block, sample_scale);
@@ -681,10 +2174,14 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
             if (n_passes > 1) {
                 sampler->advance(); // Will trigger a kernel launch of size 1
                 sampler->schedule_state();
-                dr::eval(block->tensor());
+                if (block->slot_count() > 1)
+                    dr::eval(); // Flush the scatters into the slotted image
+                else
+                    dr::eval(block->tensor());
             }
         }
 
+        block->reduce_slots();
         film->put_block(block);
 
         if (develop) {
@@ -711,9 +2208,11 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
         }
     }
 
-    if (!m_stop && (evaluate || !dr::is_jit_v<Float>))
+    if (!m_stop && (evaluate || !dr::is_jit_v<Float>)) {
         Log(Info, "Rendering finished. (took %s)",
             util::time_string((float) m_render_timer.value(), true));
+        Log(Info, "%s", render_stats::report());
+    }
 
     return result;
 }
@@ -28,6 +28,7 @@ MI_VARIANT Medium<Float, Spectrum>::Medium(const Properties &props) : m_id(props
 
     m_sample_emitters = props.get<bool>("sample_emitters", true);
     dr::set_attr(this, "use_emitter_sampling", m_sample_emitters);
+    dr::set_attr(this, "is_emitter", m_is_emitter);
     dr::set_attr(this, "phase_function", m_phase_function.get());
 }
 
@@ -37,10 +38,65 @@ MI_VARIANT void Medium<Float, Spectrum>::traverse(TraversalCallback *callback) {
     callback->put_object("phase_function", m_phase_function.get(), +ParamFlags::Differentiable);
 }
 
+MI_VARIANT
+std::tuple<typename Medium<Float, Spectrum>::UnpolarizedSpectrum,
+           typename Medium<Float, Spectrum>::UnpolarizedSpectrum,
+           typename Medium<Float, Spectrum>::UnpolarizedSpectrum>
+Medium<Float, Spectrum>::get_scattering_coefficients_tr(
+    const MediumInteraction3f &mi, Mask active) const {
+    return get_scattering_coefficients(mi, active);
+}
+
+MI_VARIANT
+typename Medium<Float, Spectrum>::UnpolarizedSpectrum
+Medium<Float, Spectrum>::get_emission(const MediumInteraction3f & /* mi */,
+                                      Mask /* active */) const {
+    return dr::zeros<UnpolarizedSpectrum>();
+}
+
+MI_VARIANT
+std::pair<typename Medium<Float, Spectrum>::Point3f, Float>
+Medium<Float, Spectrum>::sample_emission_point(const Point3f & /* sample */,
+                                               Mask /* active */) const {
+    return { dr::zeros<Point3f>(), 0.f };
+}
+
+MI_VARIANT Float Medium<Float, Spectrum>::pdf_emission_point(
+    const Point3f & /* p */, Mask /* active */) const {
+    return 0.f;
+}
+
+MI_VARIANT
+std::pair<typename Medium<Float, Spectrum>::UnpolarizedSpectrum, Float>
+Medium<Float, Spectrum>::get_majorant_segment(const Ray3f &ray, Float mint,
+                                              Float /* maxt */,
+                                              Mask active) const {
+    MediumInteraction3f mei = dr::zeros<MediumInteraction3f>();
+    mei.p           = ray(mint);
+    mei.time        = ray.time;
+    mei.wavelengths = ray.wavelengths;
+    return { get_majorant(mei, active), dr::Infinity<Float> };
+}
+
 MI_VARIANT
 typename Medium<Float, Spectrum>::MediumInteraction3f
 Medium<Float, Spectrum>::sample_interaction(const Ray3f &ray, Float sample,
                                             UInt32 channel, Mask active) const {
+    return sample_interaction_impl(ray, sample, channel, active, false);
+}
+
+MI_VARIANT
+typename Medium<Float, Spectrum>::MediumInteraction3f
+Medium<Float, Spectrum>::sample_interaction_tr(const Ray3f &ray, Float sample,
+                                               UInt32 channel, Mask active) const {
+    return sample_interaction_impl(ray, sample, channel, active, true);
+}
+
+MI_VARIANT
+typename Medium<Float, Spectrum>::MediumInteraction3f
+Medium<Float, Spectrum>::sample_interaction_impl(const Ray3f &ray, Float sample,
+                                                 UInt32 channel, Mask active,
+                                                 bool tr_only) const {
     MI_MASKED_FUNCTION(ProfilerPhase::MediumSample, active);
 
     // initialize basic medium interaction fields
@@ -59,8 +115,23 @@ Medium<Float, Spectrum>::sample_interaction(const Ray3f &ray, Float sample,
     mint = dr::maximum(0.f, mint);
     maxt = dr::minimum(ray.maxt, maxt);
 
-    auto combined_extinction = get_majorant(mei, active);
-    Float m                  = combined_extinction[0];
+    /* Cull lanes whose overlap with the medium's bounds is empty (e.g. the
+       segment ends before reaching the volume). Together with a ray whose
+       ``maxt`` was clamped to the nearest surface by the caller, this skips
+       the majorant and density lookups for rays that never touch the
+       medium, and returns early when this is the case for every lane. */
+    active &= mint < maxt;
+    dr::masked(mint, !active) = 0.f;
+    if (dr::none_or<false>(active)) {
+        mei.t      = dr::Infinity<Float>;
+        mei.medium = this;
+        mei.mint   = mint;
+        return mei;
+    }
+
+    auto [combined_extinction, majorant_end] =
+        get_majorant_segment(ray, mint, maxt, active);
+    Float m = combined_extinction[0];
     if constexpr (is_rgb_v<Spectrum>) { // Handle RGB rendering
         dr::masked(m, dr::eq(channel, 1u)) = combined_extinction[1];
         dr::masked(m, dr::eq(channel, 2u)) = combined_extinction[2];
@@ -69,6 +140,18 @@ Medium<Float, Spectrum>::sample_interaction(const Ray3f &ray, Float sample,
     }
 
     Float sampled_t = mint + (-dr::log(1 - sample) / m);
+
+    /* When the majorant expires before both the tentative collision and the
+       end of the segment, emit a forced null collision at the expiry point
+       instead: the integrator's null-scattering loop then resumes sampling
+       from there with the next cell's majorant. The coefficients assigned
+       below make the existing transmittance and throughput weights reduce
+       to the correct survival ratio for this event (exactly one for media
+       without spectrally varying extinction). */
+    Mask forced_null = active && sampled_t > majorant_end &&
+                       majorant_end < maxt;
+    dr::masked(sampled_t, forced_null) = majorant_end;
+
     Mask valid_mi   = active && (sampled_t <= maxt);
     mei.t           = dr::select(valid_mi, sampled_t, dr::Infinity<Float>);
     mei.p           = ray(sampled_t);
@@ -76,7 +159,13 @@ Medium<Float, Spectrum>::sample_interaction(const Ray3f &ray, Float sample,
     mei.mint        = mint;
 
     std::tie(mei.sigma_s, mei.sigma_n, mei.sigma_t) =
-        get_scattering_coefficients(mei, valid_mi);
+        tr_only ? get_scattering_coefficients_tr(mei, valid_mi && !forced_null)
+                : get_scattering_coefficients(mei, valid_mi && !forced_null);
+    if (dr::any_or<true>(forced_null)) {
+        dr::masked(mei.sigma_s, forced_null) = 0.f;
+        dr::masked(mei.sigma_t, forced_null) = 0.f;
+        dr::masked(mei.sigma_n, forced_null) = UnpolarizedSpectrum(m);
+    }
     mei.combined_extinction = combined_extinction;
     return mei;
 }
@@ -1,4 +1,6 @@
 #include <mitsuba/core/fstream.h>
+#include <mitsuba/core/hash.h>
+#include <mitsuba/core/mmap.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/util.h>
@@ -8,6 +10,9 @@
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/records.h>
 #include <mitsuba/render/scene.h>
+#include <nanothread/nanothread.h>
+#include <drjit/half.h>
+#include <algorithm>
 
 #if defined(MI_ENABLE_EMBREE)
     #include <embree3/rtcore.h>
@@ -27,8 +32,16 @@ MI_VARIANT Mesh<Float, Spectrum>::Mesh(const Properties &props) : Base(props) {
        normals when rendering the object, which will give it a faceted
        appearance. Default: ``false`` */
 
-    m_face_normals = props.get<bool>("face_normals", false);
-    m_flip_normals = props.get<bool>("flip_normals", false);
+    m_face_normals        = props.get<bool>("face_normals", false);
+    m_flip_normals        = props.get<bool>("flip_normals", false);
+    m_reorder             = props.get<bool>("reorder", false);
+    m_compress_attributes = props.get<bool>("compress_attributes", false);
+
+    if (props.has_property("displacement")) {
+        m_displacement        = props.texture<Texture>("displacement");
+        m_displacement_scale  = props.get<ScalarFloat>("displacement_scale", 1.f);
+        m_displacement_levels = props.get<uint32_t>("displacement_levels", 0);
+    }
 }
 
 MI_VARIANT
@@ -52,6 +65,15 @@ Mesh<Float, Spectrum>::Mesh(const std::string &name, ScalarSize vertex_count,
 
 MI_VARIANT
 void Mesh<Float, Spectrum>::initialize() {
+    if (m_displacement && !m_displacement_applied &&
+        m_face_count > 0 && m_vertex_count > 0) {
+        m_displacement_applied = true;
+        displace();
+    }
+    if (m_reorder && m_face_count > 0 && m_vertex_count > 0)
+        reorder_morton();
+    if (m_compress_attributes && m_face_count > 0 && m_vertex_count > 0)
+        compress_vertex_attributes();
 #if defined(MI_ENABLE_LLVM) && !defined(MI_ENABLE_EMBREE)
     m_vertex_positions_ptr = m_vertex_positions.data();
     m_faces_ptr = m_faces.data();
@@ -92,12 +114,14 @@ MI_VARIANT void Mesh<Float, Spectrum>::parameters_changed(const std::vector<std:
         mesh_attributes_changed = true;
         m_face_count = m_faces.size() / 3;
     }
-    if (has_vertex_normals() && m_vertex_normals.size() != m_vertex_count * 3) {
+    if (dr::width(m_vertex_normals) != 0 &&
+        m_vertex_normals.size() != m_vertex_count * 3) {
         Log(Debug, "parameters_changed(): Vertex normal count changed, updating it.");
         mesh_attributes_changed = true;
         m_vertex_normals = dr::zeros<FloatStorage>(m_vertex_count * 3);
     }
-    if (has_vertex_texcoords() && m_vertex_texcoords.size() != m_vertex_count * 2) {
+    if (dr::width(m_vertex_texcoords) != 0 &&
+        m_vertex_texcoords.size() != m_vertex_count * 2) {
         Log(Debug, "parameters_changed(): Vertex count has changed, but no UVs were specified, resetting them.");
         mesh_attributes_changed = true;
         m_vertex_texcoords = dr::zeros<FloatStorage>(m_vertex_count * 2);
@@ -121,6 +145,9 @@ MI_VARIANT void Mesh<Float, Spectrum>::parameters_changed(const std::vector<std:
         if (!m_area_pmf.empty())
             m_area_pmf = DiscreteDistribution<Float>();
 
+        if (m_sample_cache.valid)
+            m_sample_cache = PositionSampleCache();
+
         if (m_parameterization)
             m_parameterization = nullptr;
 
@@ -175,9 +202,11 @@ MI_VARIANT void Mesh<Float, Spectrum>::write_ply(const std::string &filename) co
 }
 
 MI_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
+    FloatStorage normals_buf   = decoded_vertex_normals(),
+                 texcoords_buf = decoded_vertex_texcoords();
     auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
-    auto&& vertex_normals   = dr::migrate(m_vertex_normals, AllocType::Host);
-    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(normals_buf, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(texcoords_buf, AllocType::Host);
     auto&& faces = dr::migrate(m_faces, AllocType::Host);
 
     std::vector<std::pair<std::string, MeshAttribute>> vertex_attributes;
@@ -234,7 +263,12 @@ MI_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
 
     stream->write_line("end_header");
 
-    // Write vertices data
+    /* Rather than issuing one small Stream write per element (very slow for
+       large meshes), interleaved records are assembled in a large scratch
+       buffer and flushed chunk by chunk. The per-record format conversion is
+       embarrassingly parallel and runs over the thread pool, while stream
+       writes remain sequential. */
+
     const InputFloat* position_ptr = vertex_positions.data();
     const InputFloat* normal_ptr   = vertex_normals.data();
     const InputFloat* texcoord_ptr = vertex_texcoords.data();
@@ -243,26 +277,57 @@ MI_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
     for (const auto&[name, attribute]: vertex_attributes)
         vertex_attributes_ptr.push_back(attribute.buf.data());
 
-    for (size_t i = 0; i < m_vertex_count; i++) {
-        // Write positions
-        stream->write(position_ptr, 3 * sizeof(InputFloat));
-        position_ptr += 3;
-        // Write normals
-        if (has_vertex_normals()) {
-            stream->write(normal_ptr, 3 * sizeof(InputFloat));
-            normal_ptr += 3;
-        }
-        // Write texture coordinates
-        if (has_vertex_texcoords()) {
-            stream->write(texcoord_ptr, 2 * sizeof(InputFloat));
-            texcoord_ptr += 2;
-        }
+    size_t vertex_attributes_size = 0;
+    for (const auto&[name, attribute]: vertex_attributes)
+        vertex_attributes_size += attribute.size;
 
-        for (size_t j = 0; j < vertex_attributes_ptr.size(); ++j) {
-            const auto&[name, attribute] = vertex_attributes[j];
-            stream->write(vertex_attributes_ptr[j], attribute.size * sizeof(InputFloat));
-            vertex_attributes_ptr[j] += attribute.size;
-        }
+    // Size of an interleaved vertex record in the output file
+    const size_t vertex_stride =
+        (3 + (has_vertex_normals() ? 3 : 0) +
+             (has_vertex_texcoords() ? 2 : 0) +
+         vertex_attributes_size) * sizeof(InputFloat);
+
+    // Target chunk size of 16 MiB, rounded to a whole number of records
+    const size_t chunk_bytes = 16 * 1024 * 1024;
+
+    std::unique_ptr<uint8_t[]> chunk(new uint8_t[chunk_bytes + vertex_stride]);
+
+    // Write vertices data
+    size_t vertices_per_chunk = dr::maximum((size_t) 1, chunk_bytes / vertex_stride);
+    for (size_t start = 0; start < m_vertex_count; start += vertices_per_chunk) {
+        size_t end = dr::minimum((size_t) m_vertex_count, start + vertices_per_chunk);
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(start, end, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    uint8_t *dst = chunk.get() + (i - start) * vertex_stride;
+
+                    // Write positions
+                    memcpy(dst, position_ptr + 3 * i, 3 * sizeof(InputFloat));
+                    dst += 3 * sizeof(InputFloat);
+                    // Write normals
+                    if (has_vertex_normals()) {
+                        memcpy(dst, normal_ptr + 3 * i, 3 * sizeof(InputFloat));
+                        dst += 3 * sizeof(InputFloat);
+                    }
+                    // Write texture coordinates
+                    if (has_vertex_texcoords()) {
+                        memcpy(dst, texcoord_ptr + 2 * i, 2 * sizeof(InputFloat));
+                        dst += 2 * sizeof(InputFloat);
+                    }
+
+                    for (size_t j = 0; j < vertex_attributes_ptr.size(); ++j) {
+                        size_t size = vertex_attributes[j].second.size;
+                        memcpy(dst, vertex_attributes_ptr[j] + size * i,
+                               size * sizeof(InputFloat));
+                        dst += size * sizeof(InputFloat);
+                    }
+                }
+            }
+        );
+
+        stream->write(chunk.get(), (end - start) * vertex_stride);
     }
 
     const ScalarIndex* face_ptr = faces.data();
@@ -271,79 +336,398 @@ MI_VARIANT void Mesh<Float, Spectrum>::write_ply(Stream *stream) const {
     for (const auto&[name, attribute]: face_attributes)
         face_attributes_ptr.push_back(attribute.buf.data());
 
+    size_t face_attributes_size = 0;
+    for (const auto&[name, attribute]: face_attributes)
+        face_attributes_size += attribute.size;
+
+    // Size of an interleaved face record (vertex count + indices + attributes)
+    const size_t face_stride = sizeof(uint8_t) + 3 * sizeof(ScalarIndex) +
+                               face_attributes_size * sizeof(InputFloat);
+
+    if (face_stride > vertex_stride)
+        chunk.reset(new uint8_t[chunk_bytes + face_stride]);
+
     // Write faces data
-    uint8_t vertex_indices_count = 3;
-    for (size_t i = 0; i < m_face_count; i++) {
-        // Write vertex count
-        stream->write(&vertex_indices_count, sizeof(uint8_t));
-
-        // Write positions
-        stream->write(face_ptr, 3 * sizeof(ScalarIndex));
-        face_ptr += 3;
-
-        for (size_t j = 0; j < face_attributes_ptr.size(); ++j) {
-            const auto&[name, attribute] = face_attributes[j];
-            stream->write(face_attributes_ptr[j], attribute.size * sizeof(InputFloat));
-            face_attributes_ptr[j] += attribute.size;
-        }
+    size_t faces_per_chunk = dr::maximum((size_t) 1, chunk_bytes / face_stride);
+    for (size_t start = 0; start < m_face_count; start += faces_per_chunk) {
+        size_t end = dr::minimum((size_t) m_face_count, start + faces_per_chunk);
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(start, end, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    uint8_t *dst = chunk.get() + (i - start) * face_stride;
+
+                    // Write vertex count
+                    *dst++ = 3;
+
+                    // Write indices
+                    memcpy(dst, face_ptr + 3 * i, 3 * sizeof(ScalarIndex));
+                    dst += 3 * sizeof(ScalarIndex);
+
+                    for (size_t j = 0; j < face_attributes_ptr.size(); ++j) {
+                        size_t size = face_attributes[j].second.size;
+                        memcpy(dst, face_attributes_ptr[j] + size * i,
+                               size * sizeof(InputFloat));
+                        dst += size * sizeof(InputFloat);
+                    }
+                }
+            }
+        );
+
+        stream->write(chunk.get(), (end - start) * face_stride);
     }
 }
 
+MI_VARIANT void Mesh<Float, Spectrum>::write_serialized(const std::string &filename) const {
+    FloatStorage normals_buf   = decoded_vertex_normals(),
+                 texcoords_buf = decoded_vertex_texcoords();
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(normals_buf, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(texcoords_buf, AllocType::Host);
+    auto&& faces = dr::migrate(m_faces, AllocType::Host);
+
+    // Evaluate buffers if necessary
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    if (has_mesh_attributes())
+        Log(Warn, "write_serialized(): the Serialized format does not store "
+                  "mesh attributes -- they will be omitted from \"%s\".",
+            filename);
+
+    Timer timer;
+    Log(Info, "Writing mesh to \"%s\" ..", filename);
+
+    ref<FileStream> stream =
+        new FileStream(filename, FileStream::ETruncReadWrite);
+    stream->set_byte_order(Stream::ELittleEndian);
+
+    stream->write((uint16_t) 0x041C);  // format magic
+    stream->write((uint16_t) 0x0005);  // V5: uncompressed, 64-byte aligned
+
+    uint32_t mesh_flags = 0x1000;      // single precision
+    if (has_vertex_normals())
+        mesh_flags |= 0x0001;
+    if (has_vertex_texcoords())
+        mesh_flags |= 0x0002;
+    if (has_face_normals())
+        mesh_flags |= 0x0010;
+
+    stream->write(mesh_flags);
+    stream->write(m_name.c_str(), m_name.length() + 1);
+    stream->write((uint64_t) m_vertex_count);
+    stream->write((uint64_t) m_face_count);
+
+    // Zero-pad the file up to the next 64-byte boundary
+    auto pad64 = [&stream]() {
+        const uint8_t zero[64] = { };
+        size_t rem = stream->tell() % 64;
+        if (rem != 0)
+            stream->write(zero, 64 - rem);
+    };
+
+    pad64();
+    stream->write(vertex_positions.data(),
+                  m_vertex_count * 3 * sizeof(InputFloat));
+
+    if (has_vertex_normals()) {
+        pad64();
+        stream->write(vertex_normals.data(),
+                      m_vertex_count * 3 * sizeof(InputFloat));
+    }
+
+    if (has_vertex_texcoords()) {
+        pad64();
+        stream->write(vertex_texcoords.data(),
+                      m_vertex_count * 2 * sizeof(InputFloat));
+    }
+
+    pad64();
+    stream->write(faces.data(), m_face_count * 3 * sizeof(ScalarIndex));
+
+    // End-of-file dictionary: a single mesh starting at offset zero
+    stream->write((uint64_t) 0);
+    stream->write((uint32_t) 1);
+    stream->close();
+
+    Log(Info, "\"%s\": wrote %i faces, %i vertices (%s in %s)", filename,
+        m_face_count, m_vertex_count,
+        util::mem_string(m_face_count * face_data_bytes() +
+                         m_vertex_count * vertex_data_bytes()),
+        util::time_string((float) timer.value()));
+}
+
+namespace {
+    /* Header of the binary geometry snapshots (see Mesh::write_cache()).
+       The field order avoids any implicit padding, so the struct can be
+       copied to/from disk directly (host endianness). */
+    struct MeshCacheHeader {
+        uint32_t magic;         // 'MSHC'
+        uint32_t version;
+        uint64_t hash;          // source content/parameter hash
+        uint32_t vertex_count;
+        uint32_t face_count;
+        uint32_t flags;         // bit 0: normals, bit 1: texcoords
+        uint32_t reserved;
+        float bbox[6];          // min.xyz, max.xyz
+    };
+
+    constexpr uint32_t MeshCacheMagic   = 0x4348534Du,
+                       MeshCacheVersion = 1u;
+}
+
+MI_VARIANT uint64_t Mesh<Float, Spectrum>::content_hash(const void *data,
+                                                        size_t size,
+                                                        uint64_t hash) {
+    const uint8_t *ptr = (const uint8_t *) data;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ ptr[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+MI_VARIANT void Mesh<Float, Spectrum>::write_cache(const fs::path &filename,
+                                                   uint64_t hash) const {
+    if (has_mesh_attributes())
+        Throw("Mesh::write_cache(): mesh attributes are not supported!");
+
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(m_vertex_normals, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    auto&& faces            = dr::migrate(m_faces, AllocType::Host);
+
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    MeshCacheHeader header = {};
+    header.magic        = MeshCacheMagic;
+    header.version      = MeshCacheVersion;
+    header.hash         = hash;
+    header.vertex_count = m_vertex_count;
+    header.face_count   = m_face_count;
+    if (dr::width(m_vertex_normals) != 0)
+        header.flags |= 1u;
+    if (dr::width(m_vertex_texcoords) != 0)
+        header.flags |= 2u;
+    for (size_t i = 0; i < 3; ++i) {
+        header.bbox[i]     = (float) m_bbox.min[i];
+        header.bbox[i + 3] = (float) m_bbox.max[i];
+    }
+
+    /* Write to a temporary name and rename into place, so that concurrent
+       loads of the same source never observe a partial snapshot */
+    fs::path tmp_filename = fs::path(filename.string() + ".tmp");
+    ref<FileStream> stream =
+        new FileStream(tmp_filename, FileStream::ETruncReadWrite);
+    stream->write(&header, sizeof(MeshCacheHeader));
+    stream->write(vertex_positions.data(),
+                  m_vertex_count * 3 * sizeof(InputFloat));
+    if (header.flags & 1u)
+        stream->write(vertex_normals.data(),
+                      m_vertex_count * 3 * sizeof(InputFloat));
+    if (header.flags & 2u)
+        stream->write(vertex_texcoords.data(),
+                      m_vertex_count * 2 * sizeof(InputFloat));
+    stream->write(faces.data(), m_face_count * 3 * sizeof(ScalarIndex));
+    stream->close();
+
+    if (fs::exists(filename))
+        fs::remove(filename); // Windows cannot rename over an existing file
+    if (!fs::rename(tmp_filename, filename))
+        Throw("Mesh::write_cache(): could not rename \"%s\" to \"%s\"!",
+              tmp_filename.string(), filename.string());
+}
+
+MI_VARIANT bool Mesh<Float, Spectrum>::read_cache(const fs::path &filename,
+                                                  uint64_t hash) {
+    if (!fs::exists(filename))
+        return false;
+
+    ref<MemoryMappedFile> mmap;
+    try {
+        mmap = new MemoryMappedFile(filename);
+    } catch (...) {
+        return false;
+    }
+
+    if (mmap->size() < sizeof(MeshCacheHeader))
+        return false;
+
+    MeshCacheHeader header;
+    memcpy(&header, mmap->data(), sizeof(MeshCacheHeader));
+
+    if (header.magic != MeshCacheMagic || header.version != MeshCacheVersion ||
+        header.hash != hash)
+        return false;
+
+    bool has_normals   = header.flags & 1u,
+         has_texcoords = header.flags & 2u;
+
+    size_t expected = sizeof(MeshCacheHeader) +
+        (size_t) header.vertex_count * (3 + (has_normals ? 3 : 0) +
+            (has_texcoords ? 2 : 0)) * sizeof(InputFloat) +
+        (size_t) header.face_count * 3 * sizeof(ScalarIndex);
+    if (mmap->size() != expected)
+        return false;
+
+    m_vertex_count = header.vertex_count;
+    m_face_count   = header.face_count;
+    for (size_t i = 0; i < 3; ++i) {
+        m_bbox.min[i] = header.bbox[i];
+        m_bbox.max[i] = header.bbox[i + 3];
+    }
+
+    const InputFloat *ptr = (const InputFloat *)
+        ((const uint8_t *) mmap->data() + sizeof(MeshCacheHeader));
+
+    m_vertex_positions =
+        dr::load<FloatStorage>(ptr, (size_t) m_vertex_count * 3);
+    ptr += (size_t) m_vertex_count * 3;
+
+    if (has_normals) {
+        m_vertex_normals =
+            dr::load<FloatStorage>(ptr, (size_t) m_vertex_count * 3);
+        ptr += (size_t) m_vertex_count * 3;
+    }
+
+    if (has_texcoords) {
+        m_vertex_texcoords =
+            dr::load<FloatStorage>(ptr, (size_t) m_vertex_count * 2);
+        ptr += (size_t) m_vertex_count * 2;
+    }
+
+    m_faces = dr::load<DynamicBuffer<UInt32>>(
+        (const ScalarIndex *) ptr, (size_t) m_face_count * 3);
+
+    return true;
+}
+
 MI_VARIANT void Mesh<Float, Spectrum>::recompute_vertex_normals() {
     if (!has_vertex_normals())
         Throw("Storing new normals in a Mesh that didn't have normals at "
               "construction time is not implemented yet.");
 
+    /* If the normals are stored in compressed form, recompute them into a
+       temporary float buffer and re-encode at the end */
+    bool packed_normals = dr::width(m_vertex_normals_packed) != 0;
+    if (packed_normals)
+        m_vertex_normals = dr::zeros<FloatStorage>(m_vertex_count * 3);
+
     /* Weighting scheme based on "Computing Vertex Normals from Polygonal Facets"
        by Grit Thuermer and Charles A. Wuethrich, JGT 1998, Vol 3 */
 
     if constexpr (!dr::is_dynamic_v<Float>) {
-        size_t invalid_counter = 0;
+        /* Fused post-processing: the expensive per-face pass below already
+           computes the edge cross product of every triangle, whose length is
+           twice the face area. When the surface-area sampling table will be
+           needed later on (emitter/sensor meshes), it is therefore built as a
+           by-product rather than in a separate traversal of the index buffer
+           (see \ref build_pmf()). Likewise, the vertex pass refreshes the
+           bounding box for free while the positions are loaded anyway. */
+        bool fuse_pmf = (m_emitter || m_sensor) && m_area_pmf.empty() &&
+                        m_face_count > 0;
+        std::vector<ScalarFloat> areas;
+        if (fuse_pmf)
+            areas.resize(m_face_count);
+
+        /* Per-face normals and angle weights, written in a face-major layout
+           so that the parallel face pass is race-free */
+        std::vector<InputFloat> face_data(m_face_count * 6);
+
+        // Pass 1: per-face quantities, parallel over the index buffer
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_face_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    auto fi = face_indices((ScalarSize) i);
+                    Assert(fi[0] < m_vertex_count &&
+                           fi[1] < m_vertex_count &&
+                           fi[2] < m_vertex_count);
+
+                    InputPoint3f v[3] = { vertex_position(fi[0]),
+                                          vertex_position(fi[1]),
+                                          vertex_position(fi[2]) };
+
+                    InputVector3f side_0 = v[1] - v[0],
+                                  side_1 = v[2] - v[0];
+                    InputNormal3f n = dr::cross(side_0, side_1);
+                    InputFloat length_sqr = dr::squared_norm(n);
+
+                    if (fuse_pmf)
+                        areas[i] = .5f * dr::sqrt(length_sqr);
+
+                    InputVector3f face_angles = dr::zeros<InputVector3f>();
+                    if (likely(length_sqr > 0)) {
+                        n *= dr::rsqrt(length_sqr);
+
+                        // Use DrJit to compute the face angles at the same time
+                        auto side1 = transpose(dr::Array<dr::Packet<InputFloat, 3>, 3>{ side_0, v[2] - v[1], v[0] - v[2] });
+                        auto side2 = transpose(dr::Array<dr::Packet<InputFloat, 3>, 3>{ side_1, v[0] - v[1], v[1] - v[2] });
+                        face_angles = unit_angle(dr::normalize(side1), dr::normalize(side2));
+                    } else {
+                        n = dr::zeros<InputNormal3f>();
+                    }
+
+                    InputFloat *fd = face_data.data() + 6 * i;
+                    dr::store(fd, n);
+                    dr::store(fd + 3, face_angles);
+                }
+            });
+
+        /* Pass 2: scatter the weighted face normals to the vertices. Serial:
+           the adds race on shared vertices, but this pass is a trivial
+           memory-bound accumulation compared to the math above */
         std::vector<InputNormal3f> normals(m_vertex_count, dr::zeros<InputNormal3f>());
-
         for (ScalarSize i = 0; i < m_face_count; ++i) {
             auto fi = face_indices(i);
-            Assert(fi[0] < m_vertex_count &&
-                   fi[1] < m_vertex_count &&
-                   fi[2] < m_vertex_count);
-
-            InputPoint3f v[3] = { vertex_position(fi[0]),
-                                  vertex_position(fi[1]),
-                                  vertex_position(fi[2]) };
-
-            InputVector3f side_0 = v[1] - v[0],
-                          side_1 = v[2] - v[0];
-            InputNormal3f n = dr::cross(side_0, side_1);
-            InputFloat length_sqr = dr::squared_norm(n);
-            if (likely(length_sqr > 0)) {
-                n *= dr::rsqrt(length_sqr);
-
-                // Use DrJit to compute the face angles at the same time
-                auto side1 = transpose(dr::Array<dr::Packet<InputFloat, 3>, 3>{ side_0, v[2] - v[1], v[0] - v[2] });
-                auto side2 = transpose(dr::Array<dr::Packet<InputFloat, 3>, 3>{ side_1, v[0] - v[1], v[1] - v[2] });
-                InputVector3f face_angles = unit_angle(dr::normalize(side1), dr::normalize(side2));
-
-                for (size_t j = 0; j < 3; ++j)
-                    normals[fi[j]] += n * face_angles[j];
-            }
+            const InputFloat *fd = face_data.data() + 6 * i;
+            InputNormal3f n(fd[0], fd[1], fd[2]);
+            for (size_t j = 0; j < 3; ++j)
+                normals[fi[j]] += n * fd[3 + j];
         }
 
-        for (ScalarSize i = 0; i < m_vertex_count; i++) {
-            InputNormal3f n = normals[i];
-            InputFloat length = dr::norm(n);
-            if (likely(length != 0.f)) {
-                n /= length;
-            } else {
-                n = InputNormal3f(1, 0, 0); // Choose some bogus value
-                invalid_counter++;
-            }
-
-            dr::store(m_vertex_normals.data() + 3 * i, n);
-        }
+        // Pass 3: normalize and refresh the bounding box, parallel over vertices
+        m_bbox.reset();
+        size_t invalid_counter = 0;
+        std::mutex merge_mutex;
+        const InputFloat *pos_p = m_vertex_positions.data();
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                ScalarBoundingBox3f bbox_local;
+                size_t invalid_local = 0;
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    bbox_local.expand(ScalarPoint3f(pos_p[3 * i + 0],
+                                                    pos_p[3 * i + 1],
+                                                    pos_p[3 * i + 2]));
+
+                    InputNormal3f n = normals[i];
+                    InputFloat length = dr::norm(n);
+                    if (likely(length != 0.f)) {
+                        n /= length;
+                    } else {
+                        n = InputNormal3f(1, 0, 0); // Choose some bogus value
+                        invalid_local++;
+                    }
+
+                    dr::store(m_vertex_normals.data() + 3 * i, n);
+                }
+
+                std::lock_guard<std::mutex> lock(merge_mutex);
+                m_bbox.expand(bbox_local);
+                invalid_counter += invalid_local;
+            });
 
         if (invalid_counter > 0)
             Log(Warn, "\"%s\": computed vertex normals (%i invalid vertices!)",
                 m_name, invalid_counter);
+
+        if (fuse_pmf) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_area_pmf.empty())
+                m_area_pmf =
+                    DiscreteDistribution<Float>(areas.data(), m_face_count);
+        }
     } else {
         // The following is JITed into two separate kernel launches
 
@@ -383,6 +767,9 @@ MI_VARIANT void Mesh<Float, Spectrum>::recompute_vertex_normals() {
 
         dr::eval(m_vertex_normals);
     }
+
+    if (packed_normals)
+        compress_vertex_attributes();
 }
 
 MI_VARIANT void Mesh<Float, Spectrum>::recompute_bbox() {
@@ -393,9 +780,499 @@ MI_VARIANT void Mesh<Float, Spectrum>::recompute_bbox() {
     const InputFloat *ptr = vertex_positions.data();
 
     m_bbox.reset();
+    std::mutex merge_mutex;
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+        [&](const dr::blocked_range<size_t> &range) {
+            ScalarBoundingBox3f bbox_local;
+            for (auto i = range.begin(); i != range.end(); ++i)
+                bbox_local.expand(ScalarPoint3f(
+                    ptr[3 * i + 0], ptr[3 * i + 1], ptr[3 * i + 2]));
+
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            m_bbox.expand(bbox_local);
+        });
+}
+
+namespace {
+    /// Interleave the lowest 10 bits of 'v' with two zero bits each
+    inline uint32_t morton_expand_bits(uint32_t v) {
+        v = (v * 0x00010001u) & 0xFF0000FFu;
+        v = (v * 0x00000101u) & 0x0F00F00Fu;
+        v = (v * 0x00000011u) & 0xC30C30C3u;
+        v = (v * 0x00000005u) & 0x49249249u;
+        return v;
+    }
+
+    /// 30-bit Morton code from 10-bit per-axis grid coordinates
+    inline uint32_t morton_encode(uint32_t x, uint32_t y, uint32_t z) {
+        return (morton_expand_bits(z) << 2) | (morton_expand_bits(y) << 1) |
+               morton_expand_bits(x);
+    }
+}
+
+MI_VARIANT void Mesh<Float, Spectrum>::reorder_morton() {
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(m_vertex_normals, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    auto&& faces            = dr::migrate(m_faces, AllocType::Host);
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    const InputFloat *pos_p = vertex_positions.data();
+    const ScalarIndex *idx_p = faces.data();
+
+    /* Compute the vertex bounding box locally: reordering runs from
+       initialize(), where m_bbox may not have been set yet */
+    ScalarBoundingBox3f bbox;
     for (ScalarSize i = 0; i < m_vertex_count; ++i)
-        m_bbox.expand(
-            ScalarPoint3f(ptr[3 * i + 0], ptr[3 * i + 1], ptr[3 * i + 2]));
+        bbox.expand(
+            ScalarPoint3f(pos_p[3 * i + 0], pos_p[3 * i + 1], pos_p[3 * i + 2]));
+
+    ScalarVector3f extents = bbox.extents();
+    ScalarVector3f scale(
+        extents.x() > 0.f ? 1024.f / extents.x() : 0.f,
+        extents.y() > 0.f ? 1024.f / extents.y() : 0.f,
+        extents.z() > 0.f ? 1024.f / extents.z() : 0.f);
+
+    // Sort the faces along a Morton curve over their quantized centroids
+    std::vector<std::pair<uint32_t, ScalarIndex>> order(m_face_count);
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, m_face_count, 4096),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                ScalarPoint3u idx = dr::load<ScalarPoint3u>(idx_p + 3 * i);
+                ScalarPoint3f p0 = dr::load<InputPoint3f>(pos_p + 3 * idx.x()),
+                              p1 = dr::load<InputPoint3f>(pos_p + 3 * idx.y()),
+                              p2 = dr::load<InputPoint3f>(pos_p + 3 * idx.z());
+                ScalarVector3f rel =
+                    ((p0 + p1 + p2) * (1.f / 3.f) - bbox.min) * scale;
+                uint32_t x = (uint32_t) dr::clamp(rel.x(), 0.f, 1023.f),
+                         y = (uint32_t) dr::clamp(rel.y(), 0.f, 1023.f),
+                         z = (uint32_t) dr::clamp(rel.z(), 0.f, 1023.f);
+                order[i] = { morton_encode(x, y, z), (ScalarIndex) i };
+            }
+        });
+    std::sort(order.begin(), order.end());
+
+    /* Walk the faces in sorted order and assign each vertex its first-use
+       position; unreferenced vertices keep their relative order at the end
+       so that all per-vertex buffers stay aligned */
+    constexpr ScalarIndex unmapped = (ScalarIndex) -1;
+    std::vector<ScalarIndex> vertex_remap(m_vertex_count, unmapped);
+    std::vector<ScalarIndex> new_faces(m_face_count * 3);
+    ScalarIndex next = 0;
+    for (size_t k = 0; k < m_face_count; ++k) {
+        ScalarIndex f = order[k].second;
+        for (size_t c = 0; c < 3; ++c) {
+            ScalarIndex v = idx_p[f * 3 + c];
+            if (vertex_remap[v] == unmapped)
+                vertex_remap[v] = next++;
+            new_faces[k * 3 + c] = vertex_remap[v];
+        }
+    }
+    for (ScalarSize v = 0; v < m_vertex_count; ++v)
+        if (vertex_remap[v] == unmapped)
+            vertex_remap[v] = next++;
+
+    auto permute_vertex_data = [&](const InputFloat *src, size_t dim) {
+        std::vector<InputFloat> out(m_vertex_count * dim);
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto v = range.begin(); v != range.end(); ++v)
+                    memcpy(out.data() + vertex_remap[v] * dim, src + v * dim,
+                           dim * sizeof(InputFloat));
+            });
+        return out;
+    };
+
+    auto permute_face_data = [&](const InputFloat *src, size_t dim) {
+        std::vector<InputFloat> out(m_face_count * dim);
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_face_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto k = range.begin(); k != range.end(); ++k)
+                    memcpy(out.data() + k * dim,
+                           src + order[k].second * dim,
+                           dim * sizeof(InputFloat));
+            });
+        return out;
+    };
+
+    std::vector<InputFloat> out = permute_vertex_data(pos_p, 3);
+    m_vertex_positions = dr::load<FloatStorage>(out.data(), out.size());
+
+    if (has_vertex_normals()) {
+        out = permute_vertex_data(vertex_normals.data(), 3);
+        m_vertex_normals = dr::load<FloatStorage>(out.data(), out.size());
+    }
+    if (has_vertex_texcoords()) {
+        out = permute_vertex_data(vertex_texcoords.data(), 2);
+        m_vertex_texcoords = dr::load<FloatStorage>(out.data(), out.size());
+    }
+    for (auto &[name, attribute] : m_mesh_attributes) {
+        auto&& buf = dr::migrate(attribute.buf, AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+        out = attribute.type == MeshAttributeType::Vertex
+                  ? permute_vertex_data(buf.data(), attribute.size)
+                  : permute_face_data(buf.data(), attribute.size);
+        attribute.buf = dr::load<FloatStorage>(out.data(), out.size());
+    }
+
+    m_faces = dr::load<DynamicBuffer<UInt32>>(new_faces.data(), new_faces.size());
+}
+
+MI_VARIANT void Mesh<Float, Spectrum>::compress_vertex_attributes() {
+    if (dr::width(m_vertex_normals) != 0) {
+        auto&& vertex_normals = dr::migrate(m_vertex_normals, AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        const InputFloat *src = vertex_normals.data();
+        std::vector<uint32_t> packed(m_vertex_count);
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    InputNormal3f n = dr::load<InputNormal3f>(src + 3 * i);
+                    InputFloat l1 =
+                        dr::abs(n.x()) + dr::abs(n.y()) + dr::abs(n.z());
+
+                    // Map the unit vector onto the octahedron
+                    InputVector2f o(0.f);
+                    if (likely(l1 > 0.f)) {
+                        o = InputVector2f(n.x(), n.y()) / l1;
+                        if (n.z() < 0.f)
+                            o = InputVector2f(
+                                (1.f - dr::abs(o.y())) * dr::copysign(1.f, o.x()),
+                                (1.f - dr::abs(o.x())) * dr::copysign(1.f, o.y()));
+                    }
+
+                    uint32_t u = (uint32_t) dr::round(
+                                     dr::fmadd(o.x(), .5f, .5f) * 65535.f),
+                             v = (uint32_t) dr::round(
+                                     dr::fmadd(o.y(), .5f, .5f) * 65535.f);
+                    packed[i] = (v << 16) | u;
+                }
+            });
+
+        m_vertex_normals_packed =
+            dr::load<DynamicBuffer<UInt32>>(packed.data(), packed.size());
+        m_vertex_normals = FloatStorage();
+    }
+
+    if (dr::width(m_vertex_texcoords) != 0) {
+        auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+
+        const InputFloat *src = vertex_texcoords.data();
+        std::vector<uint32_t> packed(m_vertex_count);
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    uint32_t lo = dr::half::float32_to_float16(src[2 * i + 0]),
+                             hi = dr::half::float32_to_float16(src[2 * i + 1]);
+                    packed[i] = (hi << 16) | lo;
+                }
+            });
+
+        m_vertex_texcoords_packed =
+            dr::load<DynamicBuffer<UInt32>>(packed.data(), packed.size());
+        m_vertex_texcoords = FloatStorage();
+    }
+}
+
+MI_VARIANT typename Mesh<Float, Spectrum>::FloatStorage
+Mesh<Float, Spectrum>::decoded_vertex_normals() const {
+    if (dr::width(m_vertex_normals_packed) == 0)
+        return m_vertex_normals;
+
+    auto&& packed = dr::migrate(m_vertex_normals_packed, AllocType::Host);
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    const uint32_t *src = packed.data();
+    std::vector<InputFloat> out(m_vertex_count * 3);
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+                dr::store(out.data() + 3 * i,
+                          oct_decode<InputNormal3f>(src[i]));
+        });
+
+    return dr::load<FloatStorage>(out.data(), out.size());
+}
+
+MI_VARIANT typename Mesh<Float, Spectrum>::FloatStorage
+Mesh<Float, Spectrum>::decoded_vertex_texcoords() const {
+    if (dr::width(m_vertex_texcoords_packed) == 0)
+        return m_vertex_texcoords;
+
+    auto&& packed = dr::migrate(m_vertex_texcoords_packed, AllocType::Host);
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    const uint32_t *src = packed.data();
+    std::vector<InputFloat> out(m_vertex_count * 2);
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, m_vertex_count, 4096),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+                dr::store(out.data() + 2 * i,
+                          half2_decode<InputVector2f>(src[i]));
+        });
+
+    return dr::load<FloatStorage>(out.data(), out.size());
+}
+
+MI_VARIANT void Mesh<Float, Spectrum>::displace() {
+    if (!has_vertex_texcoords()) {
+        Log(Warn, "\"%s\": displacement mapping requires texture coordinates, "
+                  "ignoring the \"displacement\" parameter.", m_name);
+        return;
+    }
+
+    Timer timer;
+    ScalarSize orig_faces = m_face_count;
+
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(m_vertex_normals, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    auto&& faces            = dr::migrate(m_faces, AllocType::Host);
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    /* Collect all per-vertex and per-face buffers so that the subdivision
+       below can treat them uniformly. Midpoint vertices average the data of
+       their edge endpoints; face data is replicated to the four children. */
+    struct HostBuffer {
+        std::vector<InputFloat> data;
+        size_t dim;
+    };
+    std::vector<HostBuffer> vbufs, fbufs;
+
+    vbufs.push_back({ { vertex_positions.data(),
+                        vertex_positions.data() + m_vertex_count * 3 }, 3 });
+    vbufs.push_back({ { vertex_texcoords.data(),
+                        vertex_texcoords.data() + m_vertex_count * 2 }, 2 });
+    if (has_vertex_normals())
+        vbufs.push_back({ { vertex_normals.data(),
+                            vertex_normals.data() + m_vertex_count * 3 }, 3 });
+
+    std::vector<std::string> vattr_names, fattr_names;
+    for (auto &[name, attribute] : m_mesh_attributes) {
+        auto&& buf = dr::migrate(attribute.buf, AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+        if (attribute.type == MeshAttributeType::Vertex) {
+            vbufs.push_back({ { buf.data(),
+                                buf.data() + m_vertex_count * attribute.size },
+                              attribute.size });
+            vattr_names.push_back(name);
+        } else {
+            fbufs.push_back({ { buf.data(),
+                                buf.data() + m_face_count * attribute.size },
+                              attribute.size });
+            fattr_names.push_back(name);
+        }
+    }
+
+    std::vector<ScalarIndex> indices(faces.data(),
+                                     faces.data() + m_face_count * 3);
+    size_t vertex_count = m_vertex_count;
+
+    for (uint32_t level = 0; level < m_displacement_levels; ++level) {
+        size_t face_count = indices.size() / 3;
+
+        /* Pass 1 (serial): assign an index to the midpoint of every edge and
+           emit the four child faces. Shared edges are deduplicated so that
+           the subdivided mesh remains watertight. */
+        std::unordered_map<uint64_t, ScalarIndex> midpoint_map;
+        midpoint_map.reserve(face_count * 3 / 2);
+        std::vector<std::pair<ScalarIndex, ScalarIndex>> edges;
+        edges.reserve(face_count * 3 / 2);
+
+        auto midpoint = [&](ScalarIndex a, ScalarIndex b) -> ScalarIndex {
+            uint64_t key = a < b ? ((uint64_t) a << 32) | b
+                                 : ((uint64_t) b << 32) | a;
+            auto [it, created] = midpoint_map.try_emplace(
+                key, (ScalarIndex) (vertex_count + edges.size()));
+            if (created)
+                edges.emplace_back(a, b);
+            return it->second;
+        };
+
+        std::vector<ScalarIndex> new_indices(face_count * 12);
+        for (size_t f = 0; f < face_count; ++f) {
+            ScalarIndex v0 = indices[f * 3 + 0],
+                        v1 = indices[f * 3 + 1],
+                        v2 = indices[f * 3 + 2],
+                        m01 = midpoint(v0, v1),
+                        m12 = midpoint(v1, v2),
+                        m20 = midpoint(v2, v0);
+
+            ScalarIndex *out = new_indices.data() + f * 12;
+            ScalarIndex child[12] = { v0,  m01, m20,   v1,  m12, m01,
+                                      v2,  m20, m12,   m01, m12, m20 };
+            memcpy(out, child, sizeof(child));
+        }
+
+        // Pass 2 (parallel): average the endpoint data of every new vertex
+        for (HostBuffer &vb : vbufs) {
+            size_t dim = vb.dim;
+            vb.data.resize((vertex_count + edges.size()) * dim);
+            InputFloat *ptr = vb.data.data();
+            dr::parallel_for(
+                dr::blocked_range<size_t>(0, edges.size(), 4096),
+                [&](const dr::blocked_range<size_t> &range) {
+                    for (auto e = range.begin(); e != range.end(); ++e) {
+                        const InputFloat *a = ptr + edges[e].first * dim,
+                                         *b = ptr + edges[e].second * dim;
+                        InputFloat *o = ptr + (vertex_count + e) * dim;
+                        for (size_t c = 0; c < dim; ++c)
+                            o[c] = .5f * (a[c] + b[c]);
+                    }
+                });
+        }
+
+        // Replicate per-face data to the four children
+        for (HostBuffer &fb : fbufs) {
+            size_t dim = fb.dim;
+            std::vector<InputFloat> out(face_count * 4 * dim);
+            dr::parallel_for(
+                dr::blocked_range<size_t>(0, face_count, 4096),
+                [&](const dr::blocked_range<size_t> &range) {
+                    for (auto f = range.begin(); f != range.end(); ++f)
+                        for (size_t k = 0; k < 4; ++k)
+                            memcpy(out.data() + (f * 4 + k) * dim,
+                                   fb.data.data() + f * dim,
+                                   dim * sizeof(InputFloat));
+                });
+            fb.data = std::move(out);
+        }
+
+        vertex_count += edges.size();
+        indices = std::move(new_indices);
+    }
+
+    /* Displacement directions: use the (subdivided) shading normals when
+       available, and area/angle-weighted face normals otherwise */
+    std::vector<InputFloat> directions;
+    if (has_vertex_normals()) {
+        directions = vbufs[2].data;
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto v = range.begin(); v != range.end(); ++v) {
+                    InputNormal3f n =
+                        dr::load<InputNormal3f>(directions.data() + 3 * v);
+                    dr::store(directions.data() + 3 * v, dr::normalize(n));
+                }
+            });
+    } else {
+        directions.assign(vertex_count * 3, 0.f);
+        const InputFloat *pos_p = vbufs[0].data.data();
+        for (size_t f = 0; f < indices.size() / 3; ++f) {
+            InputPoint3f v0 = dr::load<InputPoint3f>(pos_p + 3 * indices[f * 3 + 0]),
+                         v1 = dr::load<InputPoint3f>(pos_p + 3 * indices[f * 3 + 1]),
+                         v2 = dr::load<InputPoint3f>(pos_p + 3 * indices[f * 3 + 2]);
+            InputNormal3f n = dr::cross(v1 - v0, v2 - v0);
+            for (size_t c = 0; c < 3; ++c) {
+                InputNormal3f o = dr::load<InputNormal3f>(
+                    directions.data() + 3 * indices[f * 3 + c]);
+                dr::store(directions.data() + 3 * indices[f * 3 + c], o + n);
+            }
+        }
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto v = range.begin(); v != range.end(); ++v) {
+                    InputNormal3f n =
+                        dr::load<InputNormal3f>(directions.data() + 3 * v);
+                    dr::store(directions.data() + 3 * v,
+                              dr::normalize(n));
+                }
+            });
+    }
+
+    if constexpr (!dr::is_jit_v<Float>) {
+        /* Scalar modes: evaluate the displacement texture at every vertex
+           over the thread pool and offset along the shading normal */
+        InputFloat *pos_p = vbufs[0].data.data();
+        const InputFloat *uv_p = vbufs[1].data.data(),
+                         *dir_p = directions.data();
+        ScalarFloat scale = m_displacement_scale;
+        const Texture *displacement = m_displacement.get();
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, vertex_count, 1024),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto v = range.begin(); v != range.end(); ++v) {
+                    SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+                    si.uv = Point2f(uv_p[2 * v], uv_p[2 * v + 1]);
+                    Float height = displacement->eval_1(si, true);
+                    InputPoint3f p = dr::load<InputPoint3f>(pos_p + 3 * v);
+                    InputNormal3f d = dr::load<InputNormal3f>(dir_p + 3 * v);
+                    dr::store(pos_p + 3 * v,
+                              InputPoint3f(p + d * (height * scale)));
+                }
+            });
+    }
+
+    // Upload the subdivided buffers
+    m_vertex_count = (ScalarSize) vertex_count;
+    m_face_count   = (ScalarSize) (indices.size() / 3);
+    m_faces = dr::load<DynamicBuffer<UInt32>>(indices.data(), indices.size());
+    m_vertex_positions =
+        dr::load<FloatStorage>(vbufs[0].data.data(), vbufs[0].data.size());
+    m_vertex_texcoords =
+        dr::load<FloatStorage>(vbufs[1].data.data(), vbufs[1].data.size());
+    if (has_vertex_normals())
+        m_vertex_normals =
+            dr::load<FloatStorage>(vbufs[2].data.data(), vbufs[2].data.size());
+    for (size_t i = 0; i < vattr_names.size(); ++i) {
+        HostBuffer &vb = vbufs[(has_vertex_normals() ? 3 : 2) + i];
+        m_mesh_attributes[vattr_names[i]].buf =
+            dr::load<FloatStorage>(vb.data.data(), vb.data.size());
+    }
+    for (size_t i = 0; i < fattr_names.size(); ++i)
+        m_mesh_attributes[fattr_names[i]].buf = dr::load<FloatStorage>(
+            fbufs[i].data.data(), fbufs[i].data.size());
+
+    if constexpr (dr::is_jit_v<Float>) {
+        /* JIT modes: evaluate the displacement texture for all vertices in a
+           single vectorized kernel and scatter the offset positions */
+        FloatStorage dir_buf =
+            dr::load<FloatStorage>(directions.data(), directions.size());
+
+        UInt32 vi = dr::arange<UInt32>(m_vertex_count);
+        SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+        si.uv = Point2f(vertex_texcoord(vi));
+        Float height = m_displacement->eval_1(si, true) * m_displacement_scale;
+
+        using InputVector = Vector<dr::replace_scalar_t<UInt32, InputFloat>, 3>;
+        Point3f p = Point3f(vertex_position(vi)) +
+                    Vector3f(dr::gather<InputVector>(dir_buf, vi)) * height;
+
+        dr::disable_grad(m_vertex_positions);
+        UInt32 pi = vi * 3;
+        for (size_t i = 0; i < 3; ++i)
+            dr::scatter(m_vertex_positions,
+                        dr::float32_array_t<Float>(p[i]), pi + i);
+        dr::eval(m_vertex_positions);
+    }
+
+    recompute_bbox();
+    if (has_vertex_normals())
+        recompute_vertex_normals();
+
+    Log(Debug, "\"%s\": displacement mapping (%i -> %i faces, took %s)",
+        m_name, orig_faces, m_face_count,
+        util::time_string((float) timer.value(), true));
 }
 
 MI_VARIANT void Mesh<Float, Spectrum>::build_pmf() {
@@ -416,15 +1293,19 @@ MI_VARIANT void Mesh<Float, Spectrum>::build_pmf() {
     const ScalarIndex *idx_p = faces.data();
 
     std::vector<ScalarFloat> table(m_face_count);
-    for (ScalarIndex i = 0; i < m_face_count; i++) {
-        ScalarPoint3u idx = dr::load<ScalarPoint3u>(idx_p + 3 * i);
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, m_face_count, 4096),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                ScalarPoint3u idx = dr::load<ScalarPoint3u>(idx_p + 3 * i);
 
-        ScalarPoint3f p0 = dr::load<InputPoint3f>(pos_p + 3 * idx.x()),
-                      p1 = dr::load<InputPoint3f>(pos_p + 3 * idx.y()),
-                      p2 = dr::load<InputPoint3f>(pos_p + 3 * idx.z());
+                ScalarPoint3f p0 = dr::load<InputPoint3f>(pos_p + 3 * idx.x()),
+                              p1 = dr::load<InputPoint3f>(pos_p + 3 * idx.y()),
+                              p2 = dr::load<InputPoint3f>(pos_p + 3 * idx.z());
 
-        table[i] = .5f * dr::norm(dr::cross(p1 - p0, p2 - p0));
-    }
+                table[i] = .5f * dr::norm(dr::cross(p1 - p0, p2 - p0));
+            }
+        });
 
     m_area_pmf = DiscreteDistribution<Float>(
         table.data(),
@@ -432,6 +1313,94 @@ MI_VARIANT void Mesh<Float, Spectrum>::build_pmf() {
     );
 }
 
+MI_VARIANT void Mesh<Float, Spectrum>::build_sample_cache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_sample_cache.valid)
+        return; // already built!
+
+    if (m_face_count == 0)
+        Throw("Cannot create sampling cache for an empty mesh: %s", to_string());
+
+    bool normals   = has_vertex_normals(),
+         texcoords = has_vertex_texcoords();
+
+    FloatStorage normals_buf   = decoded_vertex_normals(),
+                 texcoords_buf = decoded_vertex_texcoords();
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(normals_buf, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(texcoords_buf, AllocType::Host);
+    auto&& faces = dr::migrate(m_faces, AllocType::Host);
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    const InputFloat *pos_p  = vertex_positions.data(),
+                     *nrm_p  = vertex_normals.data(),
+                     *tex_p  = vertex_texcoords.data();
+    const ScalarIndex *idx_p = faces.data();
+
+    size_t n = m_face_count;
+    std::unique_ptr<InputFloat[]> p0(new InputFloat[n * 3]),
+                                  e0(new InputFloat[n * 3]),
+                                  e1(new InputFloat[n * 3]),
+                                  n0, n1, n2, uv0, uv1, uv2;
+    if (normals) {
+        n0 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 3]);
+        n1 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 3]);
+        n2 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 3]);
+    }
+    if (texcoords) {
+        uv0 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 2]);
+        uv1 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 2]);
+        uv2 = std::unique_ptr<InputFloat[]>(new InputFloat[n * 2]);
+    }
+
+    for (ScalarIndex i = 0; i < m_face_count; i++) {
+        ScalarPoint3u idx = dr::load<ScalarPoint3u>(idx_p + 3 * i);
+
+        InputPoint3f v0 = dr::load<InputPoint3f>(pos_p + 3 * idx.x()),
+                     v1 = dr::load<InputPoint3f>(pos_p + 3 * idx.y()),
+                     v2 = dr::load<InputPoint3f>(pos_p + 3 * idx.z());
+
+        dr::store(p0.get() + 3 * i, v0);
+        dr::store(e0.get() + 3 * i, v1 - v0);
+        dr::store(e1.get() + 3 * i, v2 - v0);
+
+        if (normals) {
+            dr::store(n0.get() + 3 * i,
+                      dr::load<InputNormal3f>(nrm_p + 3 * idx.x()));
+            dr::store(n1.get() + 3 * i,
+                      dr::load<InputNormal3f>(nrm_p + 3 * idx.y()));
+            dr::store(n2.get() + 3 * i,
+                      dr::load<InputNormal3f>(nrm_p + 3 * idx.z()));
+        }
+
+        if (texcoords) {
+            dr::store(uv0.get() + 2 * i,
+                      dr::load<InputVector2f>(tex_p + 2 * idx.x()));
+            dr::store(uv1.get() + 2 * i,
+                      dr::load<InputVector2f>(tex_p + 2 * idx.y()));
+            dr::store(uv2.get() + 2 * i,
+                      dr::load<InputVector2f>(tex_p + 2 * idx.z()));
+        }
+    }
+
+    m_sample_cache.p0 = dr::load<FloatStorage>(p0.get(), n * 3);
+    m_sample_cache.e0 = dr::load<FloatStorage>(e0.get(), n * 3);
+    m_sample_cache.e1 = dr::load<FloatStorage>(e1.get(), n * 3);
+    if (normals) {
+        m_sample_cache.n0 = dr::load<FloatStorage>(n0.get(), n * 3);
+        m_sample_cache.n1 = dr::load<FloatStorage>(n1.get(), n * 3);
+        m_sample_cache.n2 = dr::load<FloatStorage>(n2.get(), n * 3);
+    }
+    if (texcoords) {
+        m_sample_cache.uv0 = dr::load<FloatStorage>(uv0.get(), n * 2);
+        m_sample_cache.uv1 = dr::load<FloatStorage>(uv1.get(), n * 2);
+        m_sample_cache.uv2 = dr::load<FloatStorage>(uv2.get(), n * 2);
+    }
+    m_sample_cache.valid = true;
+}
+
 MI_VARIANT
 ref<Mesh<Float, Spectrum>>
 Mesh<Float, Spectrum>::merge(const Mesh *other) const {
@@ -468,12 +1437,12 @@ Mesh<Float, Spectrum>::merge(const Mesh *other) const {
         dr::concat(m_vertex_positions, other->m_vertex_positions);
 
     if (has_vertex_normals())
-        result->m_vertex_normals =
-            dr::concat(m_vertex_normals, other->m_vertex_normals);
+        result->m_vertex_normals = dr::concat(
+            decoded_vertex_normals(), other->decoded_vertex_normals());
 
     if (has_vertex_texcoords())
-        result->m_vertex_texcoords =
-            dr::concat(m_vertex_texcoords, other->m_vertex_texcoords);
+        result->m_vertex_texcoords = dr::concat(
+            decoded_vertex_texcoords(), other->decoded_vertex_texcoords());
 
     result->m_faces = dr::concat(m_faces, other->m_faces);
     result->m_bbox = m_bbox;
@@ -501,6 +1470,217 @@ Mesh<Float, Spectrum>::merge(const Mesh *other) const {
     return result;
 }
 
+MI_VARIANT
+ref<Mesh<Float, Spectrum>>
+Mesh<Float, Spectrum>::merge_many(const std::vector<const Mesh *> &meshes,
+                                  bool weld) {
+    if (meshes.empty())
+        return nullptr;
+
+    const Mesh *first = meshes[0];
+    if (meshes.size() == 1 && !weld)
+        return ref<Mesh>(const_cast<Mesh *>(first));
+
+    bool vertex_normals   = first->has_vertex_normals(),
+         vertex_texcoords = first->has_vertex_texcoords();
+
+    // Validate compatibility and precompute per-input offsets
+    size_t n = meshes.size();
+    std::vector<size_t> v_off(n + 1, 0), f_off(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const Mesh *m = meshes[i];
+        if (m->emitter() != first->emitter() ||
+            m->sensor() != first->sensor() ||
+            m->bsdf() != first->bsdf() ||
+            m->interior_medium() != first->interior_medium() ||
+            m->exterior_medium() != first->exterior_medium() ||
+            m->has_vertex_normals() != vertex_normals ||
+            m->has_vertex_texcoords() != vertex_texcoords ||
+            m->has_face_normals() != first->has_face_normals() ||
+            m->has_mesh_attributes())
+            Throw("Mesh::merge_many(): the two meshes are incompatible "
+                  "(%s and %s)!", first->to_string(), m->to_string());
+        v_off[i + 1] = v_off[i] + m->vertex_count();
+        f_off[i + 1] = f_off[i] + m->face_count();
+    }
+    size_t vertex_count = v_off[n], face_count = f_off[n];
+
+    /* Fetch all source buffers on the host. The migrations are issued
+       asynchronously in JIT variants and overlap; one barrier follows. */
+    std::vector<FloatStorage> pos_h(n), nrm_h(n), tex_h(n);
+    std::vector<DynamicBuffer<UInt32>> faces_h(n);
+    for (size_t i = 0; i < n; ++i) {
+        pos_h[i] = dr::migrate(meshes[i]->m_vertex_positions, AllocType::Host);
+        if (vertex_normals)
+            nrm_h[i] = dr::migrate(meshes[i]->decoded_vertex_normals(),
+                                   AllocType::Host);
+        if (vertex_texcoords)
+            tex_h[i] = dr::migrate(meshes[i]->decoded_vertex_texcoords(),
+                                   AllocType::Host);
+        faces_h[i] = dr::migrate(meshes[i]->m_faces, AllocType::Host);
+    }
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    std::vector<InputFloat> positions(vertex_count * 3),
+                            normals(vertex_normals ? vertex_count * 3 : 0),
+                            texcoords(vertex_texcoords ? vertex_count * 2 : 0);
+    std::vector<ScalarIndex> faces(face_count * 3);
+
+    // Concurrent blits into the single output allocation
+    dr::parallel_for(
+        dr::blocked_range<size_t>(0, n, 1),
+        [&](const dr::blocked_range<size_t> &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                const Mesh *m = meshes[i];
+                memcpy(positions.data() + v_off[i] * 3, pos_h[i].data(),
+                       m->vertex_count() * 3 * sizeof(InputFloat));
+                if (vertex_normals)
+                    memcpy(normals.data() + v_off[i] * 3, nrm_h[i].data(),
+                           m->vertex_count() * 3 * sizeof(InputFloat));
+                if (vertex_texcoords)
+                    memcpy(texcoords.data() + v_off[i] * 2, tex_h[i].data(),
+                           m->vertex_count() * 2 * sizeof(InputFloat));
+
+                const ScalarIndex *src = faces_h[i].data();
+                ScalarIndex *dst = faces.data() + f_off[i] * 3,
+                            off  = (ScalarIndex) v_off[i];
+                for (size_t j = 0, c = m->face_count() * 3; j < c; ++j)
+                    dst[j] = src[j] + off;
+            }
+        });
+
+    if (weld && vertex_count > 0) {
+        /* Collapse bit-identical vertex records. Hashing (phase 1) and index
+           remapping (phase 3) run over the thread pool; only the unique-record
+           insertion in between is sequential. */
+        auto hash_floats = [](const InputFloat *p, size_t count, size_t seed) {
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t bits;
+                memcpy(&bits, p + i, sizeof(uint32_t));
+                seed = hash_combine(seed, (size_t) bits);
+            }
+            return seed;
+        };
+
+        std::vector<size_t> hashes(vertex_count);
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, vertex_count, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (auto i = range.begin(); i != range.end(); ++i) {
+                    size_t h = hash_floats(positions.data() + i * 3, 3, 0);
+                    if (vertex_normals)
+                        h = hash_floats(normals.data() + i * 3, 3, h);
+                    if (vertex_texcoords)
+                        h = hash_floats(texcoords.data() + i * 2, 2, h);
+                    hashes[i] = h;
+                }
+            });
+
+        auto record_eq = [&](size_t a, size_t b) {
+            if (memcmp(positions.data() + a * 3, positions.data() + b * 3,
+                       3 * sizeof(InputFloat)) != 0)
+                return false;
+            if (vertex_normals &&
+                memcmp(normals.data() + a * 3, normals.data() + b * 3,
+                       3 * sizeof(InputFloat)) != 0)
+                return false;
+            if (vertex_texcoords &&
+                memcmp(texcoords.data() + a * 2, texcoords.data() + b * 2,
+                       2 * sizeof(InputFloat)) != 0)
+                return false;
+            return true;
+        };
+
+        std::vector<ScalarIndex> remap(vertex_count);
+        std::unordered_map<size_t, std::vector<ScalarIndex>> buckets;
+        buckets.reserve(vertex_count);
+
+        std::vector<InputFloat> w_positions, w_normals, w_texcoords;
+        w_positions.reserve(positions.size());
+        w_normals.reserve(normals.size());
+        w_texcoords.reserve(texcoords.size());
+
+        for (size_t i = 0; i < vertex_count; ++i) {
+            std::vector<ScalarIndex> &bucket = buckets[hashes[i]];
+            bool found = false;
+            for (ScalarIndex j : bucket) {
+                if (record_eq(i, j)) {
+                    remap[i] = remap[j];
+                    found = true;
+                    break;
+                }
+            }
+            if (found)
+                continue;
+
+            remap[i] = (ScalarIndex) (w_positions.size() / 3);
+            bucket.push_back((ScalarIndex) i);
+            w_positions.insert(w_positions.end(), positions.begin() + i * 3,
+                               positions.begin() + i * 3 + 3);
+            if (vertex_normals)
+                w_normals.insert(w_normals.end(), normals.begin() + i * 3,
+                                 normals.begin() + i * 3 + 3);
+            if (vertex_texcoords)
+                w_texcoords.insert(w_texcoords.end(), texcoords.begin() + i * 2,
+                                   texcoords.begin() + i * 2 + 2);
+        }
+
+        if (w_positions.size() != positions.size()) {
+            dr::parallel_for(
+                dr::blocked_range<size_t>(0, face_count * 3, 4096),
+                [&](const dr::blocked_range<size_t> &range) {
+                    for (auto j = range.begin(); j != range.end(); ++j)
+                        faces[j] = remap[faces[j]];
+                });
+
+            Log(Debug, "Mesh::merge_many(): welded %zu vertices down to %zu.",
+                vertex_count, w_positions.size() / 3);
+
+            positions = std::move(w_positions);
+            normals   = std::move(w_normals);
+            texcoords = std::move(w_texcoords);
+            vertex_count = positions.size() / 3;
+        }
+    }
+
+    Properties props;
+    if (first->m_bsdf)
+        props.set_object("bsdf", (Object *) first->m_bsdf.get());
+    if (first->m_interior_medium)
+        props.set_object("interior", (Object *) first->m_interior_medium.get());
+    if (first->m_exterior_medium)
+        props.set_object("exterior", (Object *) first->m_exterior_medium.get());
+    if (first->m_sensor)
+        props.set_object("sensor", (Object *) first->m_sensor.get());
+    if (first->m_emitter)
+        props.set_object("emitter", (Object *) first->m_emitter.get());
+    props.set_bool("face_normals", first->m_face_normals);
+
+    ref<Mesh> result = new Mesh(
+        first->m_name + " + " + std::to_string(n - 1) + " others",
+        (ScalarSize) vertex_count, (ScalarSize) face_count, props,
+        vertex_normals, vertex_texcoords);
+
+    result->m_vertex_positions =
+        dr::load<FloatStorage>(positions.data(), positions.size());
+    if (vertex_normals)
+        result->m_vertex_normals =
+            dr::load<FloatStorage>(normals.data(), normals.size());
+    if (vertex_texcoords)
+        result->m_vertex_texcoords =
+            dr::load<FloatStorage>(texcoords.data(), texcoords.size());
+    result->m_faces = dr::load<DynamicBuffer<UInt32>>(faces.data(), faces.size());
+
+    result->m_bbox.reset();
+    for (const Mesh *m : meshes)
+        result->m_bbox.expand(m->m_bbox);
+
+    result->initialize();
+
+    return result;
+}
+
 MI_VARIANT void Mesh<Float, Spectrum>::build_parameterization() {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (m_parameterization)
@@ -515,7 +1695,8 @@ MI_VARIANT void Mesh<Float, Spectrum>::build_parameterization() {
                  props, false, false);
     mesh->m_faces = m_faces;
 
-    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    FloatStorage texcoords_buf = decoded_vertex_texcoords();
+    auto&& vertex_texcoords = dr::migrate(texcoords_buf, AllocType::Host);
     if constexpr (dr::is_jit_v<Float>)
         dr::sync_thread();
 
@@ -557,21 +1738,22 @@ MI_VARIANT Float Mesh<Float, Spectrum>::surface_area() const {
 MI_VARIANT typename Mesh<Float, Spectrum>::PositionSample3f
 Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask active) const {
     ensure_pmf_built();
+    ensure_sample_cache_built();
 
     using Index = dr::replace_scalar_t<Float, ScalarIndex>;
+    using FloatI = dr::replace_scalar_t<Index, InputFloat>;
     Index face_idx;
     Point2f sample = sample_;
 
     std::tie(face_idx, sample.y()) =
         m_area_pmf.sample_reuse(sample.y(), active);
 
-    Vector3u fi = face_indices(face_idx, active);
-
-    Point3f p0 = vertex_position(fi[0], active),
-            p1 = vertex_position(fi[1], active),
-            p2 = vertex_position(fi[2], active);
+    /* All per-triangle data was packed into contiguous per-face arrays by
+       \ref build_sample_cache(), so each attribute is a single gather */
+    Point3f  p0 = dr::gather<Point<FloatI, 3>>(m_sample_cache.p0, face_idx, active);
+    Vector3f e0 = dr::gather<Vector<FloatI, 3>>(m_sample_cache.e0, face_idx, active),
+             e1 = dr::gather<Vector<FloatI, 3>>(m_sample_cache.e1, face_idx, active);
 
-    Vector3f e0 = p1 - p0, e1 = p2 - p0;
     Point2f b = warp::square_to_uniform_triangle(sample);
 
     PositionSample3f ps;
@@ -581,9 +1763,9 @@ Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask
     ps.delta = false;
 
     if (has_vertex_texcoords()) {
-        Point2f uv0 = vertex_texcoord(fi[0], active),
-                uv1 = vertex_texcoord(fi[1], active),
-                uv2 = vertex_texcoord(fi[2], active);
+        Point2f uv0 = dr::gather<Point<FloatI, 2>>(m_sample_cache.uv0, face_idx, active),
+                uv1 = dr::gather<Point<FloatI, 2>>(m_sample_cache.uv1, face_idx, active),
+                uv2 = dr::gather<Point<FloatI, 2>>(m_sample_cache.uv2, face_idx, active);
 
         ps.uv = dr::fmadd(uv0, (1.f - b.x() - b.y()),
                           dr::fmadd(uv1, b.x(), uv2 * b.y()));
@@ -592,9 +1774,9 @@ Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask
     }
 
     if (has_vertex_normals()) {
-        Normal3f n0 = vertex_normal(fi[0], active),
-                 n1 = vertex_normal(fi[1], active),
-                 n2 = vertex_normal(fi[2], active);
+        Normal3f n0 = dr::gather<Normal<FloatI, 3>>(m_sample_cache.n0, face_idx, active),
+                 n1 = dr::gather<Normal<FloatI, 3>>(m_sample_cache.n1, face_idx, active),
+                 n2 = dr::gather<Normal<FloatI, 3>>(m_sample_cache.n2, face_idx, active);
 
         ps.n = dr::fmadd(n0, (1.f - b.x() - b.y()),
                          dr::fmadd(n1, b.x(), n2 * b.y()));
@@ -944,11 +2126,20 @@ MI_VARIANT typename Mesh<Float, Spectrum>::UnpolarizedSpectrum
 Mesh<Float, Spectrum>::eval_attribute(const std::string& name,
                                       const SurfaceInteraction3f &si,
                                       Mask active) const {
-    const auto& it = m_mesh_attributes.find(name);
-    if (it == m_mesh_attributes.end())
+    const MeshAttribute *attr = find_attribute(name);
+    if (!attr)
         return Base::eval_attribute(name, si, active);
 
-    const auto& attr = it->second;
+    if (attr->size != 1 && attr->size != 3 && !dr::is_jit_v<Float>)
+        Throw("eval_attribute(): Attribute \"%s\" requested but had size %u.", name, attr->size);
+
+    return eval_attribute(*attr, si, active);
+}
+
+MI_VARIANT typename Mesh<Float, Spectrum>::UnpolarizedSpectrum
+Mesh<Float, Spectrum>::eval_attribute(const MeshAttribute &attr,
+                                      const SurfaceInteraction3f &si,
+                                      Mask active) const {
     if (attr.size == 1)
         return interpolate_attribute<1, false>(attr.type, attr.buf, si, active);
     else if (attr.size == 3) {
@@ -961,7 +2152,7 @@ Mesh<Float, Spectrum>::eval_attribute(const std::string& name,
         if constexpr (dr::is_jit_v<Float>)
             return 0.f;
         else
-            Throw("eval_attribute(): Attribute \"%s\" requested but had size %u.", name, attr.size);
+            Throw("eval_attribute(): Unsupported attribute size %u.", attr.size);
     }
 }
 
@@ -969,18 +2160,27 @@ MI_VARIANT Float
 Mesh<Float, Spectrum>::eval_attribute_1(const std::string& name,
                                         const SurfaceInteraction3f &si,
                                         Mask active) const {
-    const auto& it = m_mesh_attributes.find(name);
-    if (it == m_mesh_attributes.end())
+    const MeshAttribute *attr = find_attribute(name);
+    if (!attr)
         return Base::eval_attribute_1(name, si, active);
 
-    const auto& attr = it->second;
+    if (attr->size != 1 && !dr::is_jit_v<Float>)
+        Throw("eval_attribute_1(): Attribute \"%s\" requested but had size %u.", name, attr->size);
+
+    return eval_attribute_1(*attr, si, active);
+}
+
+MI_VARIANT Float
+Mesh<Float, Spectrum>::eval_attribute_1(const MeshAttribute &attr,
+                                        const SurfaceInteraction3f &si,
+                                        Mask active) const {
     if (attr.size == 1) {
         return interpolate_attribute<1, true>(attr.type, attr.buf, si, active);
     } else {
         if constexpr (dr::is_jit_v<Float>)
             return 0.f;
         else
-            Throw("eval_attribute_1(): Attribute \"%s\" requested but had size %u.", name, attr.size);
+            Throw("eval_attribute_1(): Unsupported attribute size %u.", attr.size);
     }
 }
 
@@ -988,18 +2188,27 @@ MI_VARIANT typename Mesh<Float, Spectrum>::Color3f
 Mesh<Float, Spectrum>::eval_attribute_3(const std::string& name,
                                         const SurfaceInteraction3f &si,
                                         Mask active) const {
-    const auto& it = m_mesh_attributes.find(name);
-    if (it == m_mesh_attributes.end())
+    const MeshAttribute *attr = find_attribute(name);
+    if (!attr)
         return Base::eval_attribute_3(name, si, active);
 
-    const auto& attr = it->second;
+    if (attr->size != 3 && !dr::is_jit_v<Float>)
+        Throw("eval_attribute_3(): Attribute \"%s\" requested but had size %u.", name, attr->size);
+
+    return eval_attribute_3(*attr, si, active);
+}
+
+MI_VARIANT typename Mesh<Float, Spectrum>::Color3f
+Mesh<Float, Spectrum>::eval_attribute_3(const MeshAttribute &attr,
+                                        const SurfaceInteraction3f &si,
+                                        Mask active) const {
     if (attr.size == 3) {
         return interpolate_attribute<3, true>(attr.type, attr.buf, si, active);
     } else {
         if constexpr (dr::is_jit_v<Float>)
             return 0.f;
         else
-            Throw("eval_attribute_3(): Attribute \"%s\" requested but had size %u.", name, attr.size);
+            Throw("eval_attribute_3(): Unsupported attribute size %u.", attr.size);
     }
 }
 
@@ -1139,9 +2348,13 @@ MI_VARIANT size_t Mesh<Float, Spectrum>::vertex_data_bytes() const {
     size_t vertex_data_bytes = 3 * sizeof(InputFloat);
 
     if (has_vertex_normals())
-        vertex_data_bytes += 3 * sizeof(InputFloat);
+        vertex_data_bytes += dr::width(m_vertex_normals_packed) != 0
+                                 ? sizeof(uint32_t)
+                                 : 3 * sizeof(InputFloat);
     if (has_vertex_texcoords())
-        vertex_data_bytes += 2 * sizeof(InputFloat);
+        vertex_data_bytes += dr::width(m_vertex_texcoords_packed) != 0
+                                 ? sizeof(uint32_t)
+                                 : 2 * sizeof(InputFloat);
 
     for (const auto&[name, attribute]: m_mesh_attributes)
         if (attribute.type == MeshAttributeType::Vertex)
@@ -1174,6 +2387,19 @@ MI_VARIANT RTCGeometry Mesh<Float, Spectrum>::embree_geometry(RTCDevice device)
     rtcCommitGeometry(geom);
     return geom;
 }
+
+MI_VARIANT bool Mesh<Float, Spectrum>::embree_refit(RTCGeometry geom) const {
+    /* Re-register the (potentially reallocated) shared vertex buffer and
+       refit the BVH over the deformed triangles. The topology must remain
+       unchanged for this to be valid. */
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3,
+                               m_vertex_positions.data(), 0, 3 * sizeof(InputFloat),
+                               m_vertex_count);
+
+    rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+    rtcCommitGeometry(geom);
+    return true;
+}
 #endif
 
 #if defined(MI_ENABLE_CUDA)
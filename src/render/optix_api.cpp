@@ -20,6 +20,9 @@ void optix_initialize() {
     L(optixAccelComputeMemoryUsage);
     L(optixAccelBuild);
     L(optixAccelCompact);
+    L(optixAccelGetRelocationInfo);
+    L(optixAccelCheckRelocationCompatibility);
+    L(optixAccelRelocate);
     L(optixBuiltinISModuleGet);
     L(optixDenoiserCreate);
     L(optixDenoiserDestroy);
@@ -1,6 +1,8 @@
+#include <mitsuba/core/thread.h>
 #include <mitsuba/render/optixdenoiser.h>
 #include <mitsuba/render/optix_api.h>
 #include <drjit-core/optix.h>
+#include <nanothread/nanothread.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -54,6 +56,16 @@ MI_VARIANT OptixDenoiser<Float, Spectrum>::OptixDenoiser(
 }
 
 MI_VARIANT OptixDenoiser<Float, Spectrum>::~OptixDenoiser() {
+    /* The denoiser state and scratch buffers below are still in use while an
+       asynchronous denoise is in flight. Errors can no longer propagate to a
+       caller at this point, so only log them. */
+    try {
+        wait();
+    } catch (const std::exception &e) {
+        Log(Warn, "~OptixDenoiser(): asynchronous denoise failed: %s",
+            e.what());
+    }
+
     if (m_denoiser != nullptr)
         jit_optix_check(optixDenoiserDestroy(m_denoiser));
     jit_free(m_hdr_intensity);
@@ -263,6 +275,51 @@ ref<Bitmap> OptixDenoiser<Float, Spectrum>::operator()(
     return output;
 }
 
+MI_VARIANT
+void OptixDenoiser<Float, Spectrum>::denoise_async(
+    const ref<Bitmap> &noisy, bool denoise_alpha, const std::string &albedo_ch,
+    const std::string &normals_ch, const Transform4f &to_sensor,
+    const std::string &flow_ch, const std::string &previous_denoised_ch,
+    const std::string &noisy_ch) {
+    // The denoiser state/scratch buffers only support one frame in flight
+    wait();
+    m_async_output = nullptr;
+
+    /* The worker owns a separate JIT thread state and with it a separate CUDA
+       stream: uploads, the denoise itself and the readback all execute
+       concurrently with kernels launched by the caller. The input bitmap
+       resides in host memory, so no synchronization with the caller's stream
+       is needed. */
+    m_task = dr::do_async([this, noisy, denoise_alpha, albedo_ch, normals_ch,
+                           to_sensor, flow_ch, previous_denoised_ch, noisy_ch,
+                           env = ThreadEnvironment()]() {
+        ScopedSetThreadEnvironment set_env(env);
+        m_async_output =
+            (*this)(noisy, denoise_alpha, albedo_ch, normals_ch, to_sensor,
+                    flow_ch, previous_denoised_ch, noisy_ch);
+    });
+}
+
+MI_VARIANT
+ref<Bitmap> OptixDenoiser<Float, Spectrum>::wait() {
+    if (m_task) {
+        Task *task = m_task;
+        m_task = nullptr;
+
+        std::exception_ptr eptr;
+        try {
+            task_wait(task);
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        task_release(task);
+        if (eptr)
+            std::rethrow_exception(eptr);
+    }
+
+    return m_async_output;
+}
+
 MI_VARIANT
 std::string OptixDenoiser<Float, Spectrum>::to_string() const {
     std::ostringstream oss;
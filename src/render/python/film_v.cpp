@@ -1,10 +1,12 @@
 #include <mitsuba/core/bitmap.h>
 #include <mitsuba/core/filesystem.h>
+#include <mitsuba/core/stream.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/imageblock.h>
 #include <mitsuba/core/rfilter.h>
 #include <mitsuba/render/scene.h>
 #include <mitsuba/render/spiral.h>
+#include <pybind11/numpy.h>
 #include <mitsuba/python/python.h>
 
 /// Trampoline for derived types implemented in Python
@@ -26,10 +28,19 @@ public:
         PYBIND11_OVERRIDE_PURE(void, Film, clear);
     }
 
+    void clear_region(const ScalarPoint2u &offset,
+                      const ScalarVector2u &size) override {
+        PYBIND11_OVERRIDE_PURE(void, Film, clear_region, offset, size);
+    }
+
     TensorXf develop(bool raw = false) const override {
         PYBIND11_OVERRIDE_PURE(TensorXf, Film, develop, raw);
     }
 
+    TensorXf develop_fast() const override {
+        PYBIND11_OVERRIDE(TensorXf, Film, develop_fast);
+    }
+
     ref<Bitmap> bitmap(bool raw = false) const override {
         PYBIND11_OVERRIDE_PURE(ref<Bitmap>, Film, bitmap, raw);
     }
@@ -38,6 +49,23 @@ public:
         PYBIND11_OVERRIDE_PURE(void, Film, write, path);
     }
 
+    void write_streaming(const fs::path &path,
+                         uint32_t band_height = 0) const override {
+        PYBIND11_OVERRIDE(void, Film, write_streaming, path, band_height);
+    }
+
+    void write_async(const fs::path &path) const override {
+        PYBIND11_OVERRIDE(void, Film, write_async, path);
+    }
+
+    void save_state(Stream *stream) const override {
+        PYBIND11_OVERRIDE(void, Film, save_state, stream);
+    }
+
+    void load_state(Stream *stream) override {
+        PYBIND11_OVERRIDE(void, Film, load_state, stream);
+    }
+
     void schedule_storage() override {
         PYBIND11_OVERRIDE_PURE(void, Film, schedule_storage,);
     }
@@ -81,9 +109,30 @@ MI_PY_EXPORT(Film) {
         .def_method(Film, prepare, "aovs"_a)
         .def_method(Film, put_block, "block"_a)
         .def_method(Film, clear)
+        .def_method(Film, clear_region, "offset"_a, "size"_a)
         .def_method(Film, develop, "raw"_a = false)
+        .def_method(Film, develop_fast)
+        .def("develop_preview",
+             [] (const Film *film, ScalarFloat exposure) {
+                 ScalarVector2u size = film->crop_size();
+                 py::array_t<uint8_t> result(
+                     { (size_t) size.y(), (size_t) size.x(), (size_t) 4 });
+                 film->develop_preview((uint8_t *) result.mutable_data(),
+                                       exposure);
+                 return result;
+             },
+             "exposure"_a = 0.f, D(Film, develop_preview))
         .def_method(Film, bitmap, "raw"_a = false)
+        .def_method(Film, statistics, "offset"_a = ScalarPoint2u(0),
+                    "size"_a = ScalarVector2u(0))
+        .def_method(Film, develop_region, "offset"_a = ScalarPoint2u(0),
+                    "size"_a = ScalarVector2u(0), "channel_offset"_a = 0,
+                    "channel_count"_a = 0)
         .def_method(Film, write, "path"_a)
+        .def_method(Film, write_streaming, "path"_a, "band_height"_a = 0)
+        .def_method(Film, write_async, "path"_a)
+        .def_method(Film, save_state, "stream"_a)
+        .def_method(Film, load_state, "stream"_a)
         .def_method(Film, sample_border)
         // Make sure to return a copy of those members as they might also be
         // exposed by-references via `mi.traverse`. In which case the return
@@ -1,11 +1,12 @@
 #include <mitsuba/core/bitmap.h>
+#include <mitsuba/core/stream.h>
 #include <mitsuba/render/imageblock.h>
 #include <mitsuba/python/python.h>
 
 MI_PY_EXPORT(ImageBlock) {
     MI_PY_IMPORT_TYPES(ImageBlock, ReconstructionFilter)
-    MI_PY_CLASS(ImageBlock, Object)
-        .def(py::init<const ScalarVector2u &, const ScalarPoint2i &, uint32_t,
+    auto ib = MI_PY_CLASS(ImageBlock, Object);
+    ib.def(py::init<const ScalarVector2u &, const ScalarPoint2i &, uint32_t,
                       const ReconstructionFilter *, bool, bool, bool,
                       bool, bool, bool>(),
              "size"_a, "offset"_a, "channel_count"_a, "rfilter"_a = nullptr,
@@ -21,7 +22,10 @@ MI_PY_EXPORT(ImageBlock) {
              "coalesce"_a = dr::is_jit_v<Float>, "compensate"_a = false,
              "warn_negative"_a = std::is_scalar_v<Float>,
              "warn_invalid"_a  = std::is_scalar_v<Float>)
-        .def("put_block", &ImageBlock::put_block, D(ImageBlock, put), "block"_a)
+        .def(py::init<Stream *>(), "stream"_a)
+        .def_method(ImageBlock, write, "stream"_a)
+        .def("put_block", &ImageBlock::put_block, D(ImageBlock, put),
+             "block"_a, "atomic"_a = false)
         .def("put",
              py::overload_cast<const Point2f &, const wavelength_t<Spectrum> &,
                                const Spectrum &, Float, Float,
@@ -50,6 +54,14 @@ MI_PY_EXPORT(ImageBlock) {
         .def_method(ImageBlock, set_coalesce)
         .def_method(ImageBlock, compensate)
         .def_method(ImageBlock, set_compensate)
+        .def_method(ImageBlock, half_precision)
+        .def_method(ImageBlock, set_half_precision, "value"_a)
+        .def_method(ImageBlock, slot_count)
+        .def_method(ImageBlock, set_slot_count, "slots"_a)
+        .def_method(ImageBlock, reduce_slots)
+        .def_method(ImageBlock, outlier_clamp)
+        .def_method(ImageBlock, set_outlier_clamp, "threshold"_a,
+                    "value_channels"_a, "excess_channel"_a = (uint32_t) -1)
         .def_method(ImageBlock, width)
         .def_method(ImageBlock, height)
         .def_method(ImageBlock, rfilter)
@@ -65,4 +77,43 @@ MI_PY_EXPORT(ImageBlock) {
         .def("tensor", py::overload_cast<>(&ImageBlock::tensor),
              py::return_value_policy::reference_internal,
              D(ImageBlock, tensor));
+
+    /* Zero-copy interop: expose the image block's tensor storage via the
+       (CUDA) array interface protocol so that NumPy/PyTorch can alias the
+       renderer's memory instead of copying it. The underlying storage is
+       owned by the block's tensor, hence the Python-side consumer must keep
+       the ImageBlock object alive (NumPy records it as the array base).
+       Views are invalidated by operations that reallocate the tensor, such
+       as \ref clear() and \ref set_size(). */
+    auto array_interface = [](ImageBlock &block) {
+        auto &tensor = block.tensor();
+
+        if constexpr (dr::is_jit_v<Float>) {
+            dr::eval(tensor.array());
+            dr::sync_thread();
+        }
+
+        py::dict result;
+        result["shape"] = py::make_tuple(tensor.shape(0), tensor.shape(1),
+                                         tensor.shape(2));
+
+        std::string code(3, '\0');
+        #if defined(LITTLE_ENDIAN)
+            code[0] = '<';
+        #else
+            code[0] = '>';
+        #endif
+        code[1] = 'f';
+        code[2] = (char) ('0' + sizeof(ScalarFloat));
+        result["typestr"] = code;
+
+        result["data"] = py::make_tuple(size_t(tensor.array().data()), false);
+        result["version"] = dr::is_cuda_v<Float> ? 2 : 3;
+        return result;
+    };
+
+    if constexpr (dr::is_cuda_v<Float>)
+        ib.def_property_readonly("__cuda_array_interface__", array_interface);
+    else
+        ib.def_property_readonly("__array_interface__", array_interface);
 }
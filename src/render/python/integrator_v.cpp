@@ -279,6 +279,56 @@ MI_PY_EXPORT(Integrator) {
             },
             D(Integrator, render, 2), "scene"_a, "sensor"_a = 0,
             "seed"_a = 0, "spp"_a = 0, "develop"_a = true, "evaluate"_a = true)
+
+        .def(
+            "render_batch",
+            [&](Integrator *integrator, Scene *scene,
+                const std::vector<Sensor *> &sensors, uint32_t seed,
+                uint32_t spp, bool develop, bool evaluate) {
+                py::gil_scoped_release release;
+                ScopedSignalHandler sh(integrator);
+                return integrator->render_batch(scene, sensors, seed, spp,
+                                                develop, evaluate);
+            },
+            "scene"_a, "sensors"_a, "seed"_a = 0, "spp"_a = 0,
+            "develop"_a = true, "evaluate"_a = true,
+            "Render the scene from multiple viewpoints at once, returning "
+            "one image per sensor. Every sensor renders into its own film. "
+            "JIT variants of compatible sensors are traced in a single "
+            "combined wavefront, amortizing kernel compilation and launch "
+            "overheads over all viewpoints; other configurations render "
+            "sequentially with decorrelated seeds.")
+
+        .def(
+            "render_frozen",
+            [&](Integrator *integrator, Scene *scene, Sensor *sensor,
+                uint32_t seed, uint32_t spp, bool develop, bool evaluate) {
+                py::gil_scoped_release release;
+                ScopedSignalHandler sh(integrator);
+                return integrator->render_frozen(scene, sensor, seed, spp,
+                                                 develop, evaluate);
+            },
+            "scene"_a, "sensor"_a, "seed"_a = 0, "spp"_a = 0,
+            "develop"_a = true, "evaluate"_a = true,
+            "Render the scene while reusing previously compiled kernels: all "
+            "scene parameters are first made opaque (dr.make_opaque()), so "
+            "that re-renders after parameter updates via traverse() trace "
+            "identical programs and replay the cached kernels instead of "
+            "recompiling. Intended for iterative applications such as "
+            "lightmap baking or optimization loops.")
+
+        .def(
+            "render_frozen",
+            [&](Integrator *integrator, Scene *scene, uint32_t sensor,
+                uint32_t seed, uint32_t spp, bool develop, bool evaluate) {
+                py::gil_scoped_release release;
+                ScopedSignalHandler sh(integrator);
+                return integrator->render_frozen(scene, sensor, seed, spp,
+                                                 develop, evaluate);
+            },
+            "scene"_a, "sensor"_a = 0, "seed"_a = 0, "spp"_a = 0,
+            "develop"_a = true, "evaluate"_a = true,
+            "Variant of render_frozen() that accepts a sensor index.")
         .def_method(Integrator, cancel)
         .def_method(Integrator, should_stop)
         .def_method(Integrator, aov_names);
@@ -298,6 +348,30 @@ MI_PY_EXPORT(Integrator) {
             },
             "scene"_a, "sampler"_a, "ray"_a, "medium"_a = nullptr,
             "active"_a = true, D(SamplingIntegrator, sample))
+        .def(
+            "render_region",
+            [&](SamplingIntegrator *integrator, Scene *scene, Sensor *sensor,
+                const ScalarPoint2u &offset, const ScalarVector2u &size,
+                uint32_t seed, uint32_t spp) {
+                py::gil_scoped_release release;
+                ScopedSignalHandler sh(integrator);
+                return integrator->render_region(scene, sensor, offset, size,
+                                                 seed, spp);
+            },
+            "scene"_a, "sensor"_a, "offset"_a, "size"_a, "seed"_a = 0,
+            "spp"_a = 0,
+            "Re-render a rectangular sub-region of the film (relative to the "
+            "crop window) into the existing film storage and return its "
+            "developed image. The film must have been prepared by a prior "
+            "call to render().")
+        .def("set_block_callback", &SamplingIntegrator::set_block_callback,
+             "callback"_a, "min_interval"_a = 0.5f,
+             "Register a callback that receives progressively developed "
+             "image regions while render() runs (scalar variants only). The "
+             "callback is invoked with the offset and size of the updated "
+             "region relative to the crop window and its developed pixel "
+             "data; invocations are throttled to at most one per "
+             "'min_interval' seconds. Pass None to remove the callback.")
         .def_readwrite("hide_emitters", &PySamplingIntegrator::m_hide_emitters);
 
     MI_PY_REGISTER_OBJECT("register_integrator", Integrator)
@@ -65,6 +65,11 @@ template <typename Ptr, typename Cls> void bind_medium_generic(Cls &cls) {
                 return ptr->sample_interaction(ray, sample, channel, active); },
             "ray"_a, "sample"_a, "channel"_a, "active"_a,
             D(Medium, sample_interaction))
+       .def("sample_interaction_tr",
+            [](Ptr ptr, const Ray3f &ray, Float sample, UInt32 channel, Mask active) {
+                return ptr->sample_interaction_tr(ray, sample, channel, active); },
+            "ray"_a, "sample"_a, "channel"_a, "active"_a,
+            D(Medium, sample_interaction_tr))
        .def("eval_tr_and_pdf",
             [](Ptr ptr, const MediumInteraction3f &mi,
                const SurfaceInteraction3f &si, Mask active) {
@@ -75,7 +80,12 @@ template <typename Ptr, typename Cls> void bind_medium_generic(Cls &cls) {
             [](Ptr ptr, const MediumInteraction3f &mi, Mask active = true) {
                 return ptr->get_scattering_coefficients(mi, active); },
             "mi"_a, "active"_a=true,
-            D(Medium, get_scattering_coefficients));
+            D(Medium, get_scattering_coefficients))
+       .def("get_scattering_coefficients_tr",
+            [](Ptr ptr, const MediumInteraction3f &mi, Mask active = true) {
+                return ptr->get_scattering_coefficients_tr(mi, active); },
+            "mi"_a, "active"_a=true,
+            D(Medium, get_scattering_coefficients_tr));
 
     if constexpr (dr::is_array_v<Ptr>)
         bind_drjit_ptr_array(cls);
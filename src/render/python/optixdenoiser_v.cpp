@@ -45,7 +45,38 @@ MI_PY_EXPORT(OptixDenoiser) {
             "noisy"_a, "denoise_alpha"_a = true, "albedo_ch"_a = "",
             "normals_ch"_a = "", "to_sensor"_a = py::none(), "flow_ch"_a = "",
             "previous_denoised_ch"_a = "", "noisy_ch"_a = "<root>",
-            D(OptixDenoiser, operator_call, 2));
+            D(OptixDenoiser, operator_call, 2))
+        .def(
+            "denoise_async",
+            [](OptixDenoiser &denoiser, const ref<Bitmap> &noisy,
+               bool denoise_alpha, const std::string &albedo_ch,
+               const std::string &normals_ch, const py::object &transform,
+               const std::string &flow_ch,
+               const std::string &previous_denoised_ch,
+               const std::string &noisy_ch) {
+                Transform4f to_sensor;
+                if (!transform.is(py::none()))
+                    to_sensor = transform.cast<Transform4f>();
+
+                py::gil_scoped_release release;
+                denoiser.denoise_async(noisy, denoise_alpha, albedo_ch,
+                                       normals_ch, to_sensor, flow_ch,
+                                       previous_denoised_ch, noisy_ch);
+            },
+            "noisy"_a, "denoise_alpha"_a = true, "albedo_ch"_a = "",
+            "normals_ch"_a = "", "to_sensor"_a = py::none(), "flow_ch"_a = "",
+            "previous_denoised_ch"_a = "", "noisy_ch"_a = "<root>",
+            "Asynchronous variant of the Bitmap denoising operator. The "
+            "denoise runs on a thread pool worker with its own CUDA stream "
+            "and can therefore overlap with the rendering of the next frame. "
+            "Use wait() to retrieve the result.")
+        .def("wait",
+            [](OptixDenoiser &denoiser) {
+                py::gil_scoped_release release;
+                return denoiser.wait();
+            },
+            "Block until the denoise submitted via denoise_async() has "
+            "finished and return its result.");
 }
 
 #endif // defined(MI_ENABLE_CUDA)
@@ -34,6 +34,10 @@ MI_PY_EXPORT(DirectionSample) {
             "emitter"_a, "Element-by-element constructor")
         .def(py::init<const Scene *, const SurfaceInteraction3f &, const Interaction3f &>(),
             "scene"_a, "si"_a, "ref"_a, D(PositionSample, PositionSample))
+        .def(py::init<const Scene *, const SurfaceInteraction3f &, const Ray3f &>(),
+            "scene"_a, "si"_a, "ray"_a,
+            "Construct from a ray and the surface interaction it produced, "
+            "reusing the cached direction and distance")
         .def_readwrite("d",     &DirectionSample3f::d,     D(DirectionSample, d))
         .def_readwrite("dist",  &DirectionSample3f::dist,  D(DirectionSample, dist))
         .def_readwrite("emitter", &DirectionSample3f::emitter, D(DirectionSample, emitter))
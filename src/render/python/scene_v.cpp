@@ -68,6 +68,11 @@ MI_PY_EXPORT(Scene) {
              "sample"_a, "active"_a = true, D(Scene, sample_emitter))
         .def("pdf_emitter", &Scene::pdf_emitter,
              "index"_a, "active"_a = true, D(Scene, pdf_emitter))
+        .def("sample_emitter_tree", &Scene::sample_emitter_tree,
+             "p"_a, "sample"_a, "active"_a = true,
+             D(Scene, sample_emitter_tree))
+        .def("pdf_emitter_tree", &Scene::pdf_emitter_tree,
+             "p"_a, "index"_a, "active"_a = true, D(Scene, pdf_emitter_tree))
         .def("sample_emitter_direction", &Scene::sample_emitter_direction,
              "ref"_a, "sample"_a, "test_visibility"_a = true, "active"_a = true,
              D(Scene, sample_emitter_direction))
@@ -126,5 +131,6 @@ MI_PY_EXPORT(Scene) {
              },
              D(Scene, integrator))
         .def_method(Scene, shapes_grad_enabled)
+        .def_method(Scene, minimal_ray_flags)
         .def("__repr__", &Scene::to_string);
 }
@@ -0,0 +1,25 @@
+#include <mitsuba/render/scheduler.h>
+#include <mitsuba/python/python.h>
+
+MI_PY_EXPORT(BlockScheduler) {
+    using Vector2u = typename BlockScheduler::Vector2u;
+    using BlockDescriptor = typename BlockScheduler::BlockDescriptor;
+
+    MI_PY_CLASS(BlockScheduler, Object)
+        .def(py::init<Vector2u, Vector2u, uint32_t, uint32_t, uint32_t>(),
+            "size"_a, "offset"_a, "block_size"_a = MI_BLOCK_SIZE,
+            "passes"_a = 1, "worker_count"_a = 1,
+            D(BlockScheduler, BlockScheduler))
+        .def_method(BlockScheduler, max_block_size)
+        .def_method(BlockScheduler, block_count)
+        .def_method(BlockScheduler, worker_count)
+        .def_method(BlockScheduler, row_count)
+        .def("next_block",
+            [](BlockScheduler &s, uint32_t worker) -> py::object {
+                BlockDescriptor desc;
+                if (!s.next_block(worker, desc))
+                    return py::none();
+                return py::make_tuple(desc.offset, desc.size, desc.block_id,
+                                      desc.row_begin, desc.row_end);
+            }, "worker"_a, D(BlockScheduler, next_block));
+}
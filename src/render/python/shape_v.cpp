@@ -185,6 +185,8 @@ MI_PY_EXPORT(Shape) {
         .def("write_ply",
              py::overload_cast<Stream *>(&Mesh::write_ply, py::const_),
              "stream"_a, D(Mesh, write_ply, 2))
+        .def("write_serialized", &Mesh::write_serialized,
+             "filename"_a, D(Mesh, write_serialized))
         .def("add_attribute", &Mesh::add_attribute, "name"_a, "size"_a, "buffer"_a,
              D(Mesh, add_attribute), py::return_value_policy::reference_internal)
         .def("vertex_position", [](const Mesh &m, UInt32 index, Mask active) {
@@ -73,6 +73,10 @@ public:
         PYBIND11_OVERRIDE(bool, Texture, is_spatially_varying);
     }
 
+    bool uses_ray_differentials() const override {
+        PYBIND11_OVERRIDE(bool, Texture, uses_ray_differentials);
+    }
+
     std::string to_string() const override {
         PYBIND11_OVERRIDE(std::string, Texture, to_string);
     }
@@ -88,6 +92,7 @@ MI_PY_EXPORT(Texture) {
         .def_method(Texture, mean, D(Texture, mean))
         .def_method(Texture, max, D(Texture, max))
         .def_method(Texture, is_spatially_varying)
+        .def_method(Texture, uses_ray_differentials)
         .def_method(Texture, eval, "si"_a, "active"_a = true)
         .def_method(Texture, eval_1, "si"_a, "active"_a = true)
         .def_method(Texture, eval_1_grad, "si"_a, "active"_a = true)
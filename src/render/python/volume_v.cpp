@@ -65,7 +65,9 @@ MI_PY_EXPORT(Volume) {
                 return max_values;
             },
             D(Volume, max_per_channel))
+        .def_method(Volume, mip_level_count)
         .def_method(Volume, eval, "it"_a, "active"_a = true)
+        .def_method(Volume, eval_lod, "it"_a, "level"_a, "active"_a = true)
         .def_method(Volume, eval_1, "it"_a, "active"_a = true)
         .def_method(Volume, eval_3, "it"_a, "active"_a = true)
         .def("eval_6",
@@ -1,6 +1,7 @@
 #include <mitsuba/render/sampler.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/profiler.h>
+#include <mitsuba/core/qmc.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -12,11 +13,13 @@ MI_VARIANT Sampler<Float, Spectrum>::Sampler(const Properties &props)
     : Object() {
     m_sample_count = props.get<uint32_t>("sample_count", 4);
     m_base_seed = props.get<uint32_t>("seed", 0);
+    m_blue_noise = props.get<bool>("blue_noise", false);
 
     m_dimension_index = dr::opaque<UInt32>(0);
     m_sample_index = dr::opaque<UInt32>(0);
     m_samples_per_wavefront = 1;
     m_wavefront_size = 0;
+    m_dither_shift = 0.f;
 }
 
 MI_VARIANT Sampler<Float, Spectrum>::Sampler(const Sampler &sampler)
@@ -27,6 +30,8 @@ MI_VARIANT Sampler<Float, Spectrum>::Sampler(const Sampler &sampler)
     m_samples_per_wavefront = sampler.m_samples_per_wavefront;
     m_dimension_index       = sampler.m_dimension_index;
     m_sample_index          = sampler.m_sample_index;
+    m_blue_noise            = sampler.m_blue_noise;
+    m_dither_shift          = sampler.m_dither_shift;
 }
 
 MI_VARIANT Sampler<Float, Spectrum>::~Sampler() { }
@@ -64,7 +69,7 @@ Sampler<Float, Spectrum>::next_2d(Mask) {
 }
 
 MI_VARIANT void Sampler<Float, Spectrum>::schedule_state() {
-    dr::schedule(m_sample_index, m_dimension_index);
+    dr::schedule(m_sample_index, m_dimension_index, m_dither_shift);
 }
 
 MI_VARIANT
@@ -84,6 +89,16 @@ Sampler<Float, Spectrum>::set_samples_per_wavefront(uint32_t samples_per_wavefro
 
 MI_VARIANT typename Sampler<Float, Spectrum>::UInt32
 Sampler<Float, Spectrum>::compute_per_sequence_seed(uint32_t seed) const {
+    /* Blue-noise dithered sampling requires all pixels to draw from a single
+       shared point set -- decorrelation across the image plane then comes
+       from the toroidal dither shift (see set_pixel_position()) instead of
+       per-sequence scrambling. Only the sampler's own seed parameter enters
+       the hash below so that the scalar and wavefront rendering paths (which
+       perturb the seed argument per block/pixel) agree on the shared set. */
+    if (m_blue_noise)
+        return dr::opaque<UInt32>(
+            sample_tea_32(m_base_seed, 0xa511e9b3u).first, 1);
+
     UInt32 indices      = dr::arange<UInt32>(m_wavefront_size),
            sequence_idx = m_samples_per_wavefront * (indices / m_samples_per_wavefront);
 
@@ -102,6 +117,42 @@ Sampler<Float, Spectrum>::current_sample_index() const {
                      wavefront_sample_offsets);
 }
 
+MI_VARIANT void Sampler<Float, Spectrum>::set_pixel_position(const Point2u &pos) {
+    if (!m_blue_noise)
+        return;
+
+    // Tileable lookup into the 256x256 forced-random dither matrix
+    UInt32 index = (pos.y() % 256u) * 256u + (pos.x() % 256u);
+
+    if constexpr (dr::is_array_v<Float>) {
+        using Float32        = dr::float32_array_t<Float>;
+        using Float32Storage = DynamicBuffer<Float32>;
+
+        Float32Storage matrix = dr::load<Float32Storage>(dither_matrix256, 65536);
+        m_dither_shift = Float(dr::gather<Float32>(matrix, index)) + .5f;
+    } else {
+        m_dither_shift = dither_matrix256[index] + .5f;
+    }
+}
+
+MI_VARIANT Float Sampler<Float, Spectrum>::dither(const Float &sample) const {
+    if (!m_blue_noise)
+        return sample;
+
+    // Toroidal shift by the mask value of the current pixel
+    Float value = sample + m_dither_shift;
+    return dr::select(value < 1.f, value, value - 1.f);
+}
+
+MI_VARIANT typename Sampler<Float, Spectrum>::Point2f
+Sampler<Float, Spectrum>::dither(const Point2f &sample) const {
+    if (!m_blue_noise)
+        return sample;
+
+    Point2f value = sample + m_dither_shift;
+    return dr::select(value < 1.f, value, value - 1.f);
+}
+
 //! @}
 // =======================================================================
 
@@ -110,7 +161,15 @@ Sampler<Float, Spectrum>::current_sample_index() const {
 // =======================================================================
 
 MI_VARIANT PCG32Sampler<Float, Spectrum>::PCG32Sampler(const Properties &props)
-    : Base(props) { }
+    : Base(props) {
+    if (m_blue_noise) {
+        /* Blue-noise dithering relies on a shared deterministic point set,
+           which is incompatible with per-pixel pseudorandom sequences */
+        Log(Warn, "The 'blue_noise' parameter is not supported by "
+                  "pseudorandom samplers and will be ignored.");
+        m_blue_noise = false;
+    }
+}
 
 MI_VARIANT void PCG32Sampler<Float, Spectrum>::seed(uint32_t seed,
                                                     uint32_t wavefront_size) {
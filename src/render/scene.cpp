@@ -1,15 +1,23 @@
+#include <algorithm>
+#include <functional>
+
+#include <mitsuba/core/loadtimer.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/statistics.h>
 #include <mitsuba/core/plugin.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/medium.h>
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/scene.h>
 #include <mitsuba/render/integrator.h>
+#include <drjit/loop.h>
 
 #if defined(MI_ENABLE_EMBREE)
 #  include "scene_embree.inl"
 #else
 #  include <mitsuba/render/kdtree.h>
+#  include <mitsuba/render/shapegroup.h>
 #  include "scene_native.inl"
 #endif
 
@@ -67,10 +75,13 @@ MI_VARIANT Scene<Float, Spectrum>::Scene(const Properties &props) {
     for (Sensor *sensor: m_sensors)
         sensor->set_scene(this);
 
-    if constexpr (dr::is_cuda_v<Float>)
-        accel_init_gpu(props);
-    else
-        accel_init_cpu(props);
+    {
+        load_stats::ScopedLoadTimer lt("Acceleration structure build");
+        if constexpr (dr::is_cuda_v<Float>)
+            accel_init_gpu(props);
+        else
+            accel_init_cpu(props);
+    }
 
     if (!m_emitters.empty()) {
         // Inform environment emitters etc. about the scene bounds
@@ -78,17 +89,77 @@ MI_VARIANT Scene<Float, Spectrum>::Scene(const Properties &props) {
             emitter->set_scene(this);
     }
 
+    /* Detect scenes that use a single BSDF instance everywhere; integrators
+       may then bypass the vcall dispatch machinery (see \ref unique_bsdf()) */
+    if (m_shapegroups.empty()) {
+        for (size_t i = 0; i < m_shapes.size(); ++i) {
+            const BSDF *bsdf = m_shapes[i]->bsdf();
+            if (i == 0) {
+                m_unique_bsdf = bsdf;
+            } else if (m_unique_bsdf != bsdf) {
+                m_unique_bsdf = nullptr;
+                break;
+            }
+        }
+    }
+
+    /* Collect emissive participating media so that integrators supporting
+       direct sampling of volumetric emission (see \ref emissive_media()) can
+       enumerate them without touching the shape list */
+    for (Shape *shape : m_shapes) {
+        Medium *interior = const_cast<Medium *>(shape->interior_medium());
+        if (interior && interior->is_emitter() &&
+            std::find(m_emissive_media.begin(), m_emissive_media.end(),
+                      interior) == m_emissive_media.end())
+            m_emissive_media.push_back(interior);
+    }
+
     m_shapes_dr = dr::load<DynamicBuffer<ShapePtr>>(
         m_shapes.data(), m_shapes.size());
 
+    m_emissive_media_dr = dr::load<DynamicBuffer<MediumPtr>>(
+        m_emissive_media.data(), m_emissive_media.size());
+
     m_emitters_dr = dr::load<DynamicBuffer<EmitterPtr>>(
         m_emitters.data(), m_emitters.size());
 
+    // Record list positions so that emitters can be mapped back to indices
+    for (size_t i = 0; i < m_emitters.size(); ++i)
+        m_emitters[i]->set_scene_index((uint32_t) i);
+
+    m_use_light_tree = props.get<bool>("light_tree", false);
+
     update_emitter_sampling_distribution();
+    update_minimal_ray_flags();
 
     m_shapes_grad_enabled = false;
 }
 
+MI_VARIANT
+void Scene<Float, Spectrum>::update_minimal_ray_flags() {
+    uint32_t flags = (uint32_t) (RayFlags::UV | RayFlags::ShadingFrame);
+
+    /* Position partials are only observable through BSDFs that depend on the
+       orientation of the tangent frame or request texture-space
+       differentials. Scenes containing shape groups are analyzed
+       conservatively, since the instanced shapes are not part of the shape
+       list below. */
+    if (!m_shapegroups.empty()) {
+        flags |= (uint32_t) RayFlags::dPdUV;
+    } else {
+        for (Shape *shape : m_shapes) {
+            const BSDF *bsdf = shape->bsdf();
+            if (bsdf && (has_flag(bsdf->flags(), BSDFFlags::Anisotropic) ||
+                         has_flag(bsdf->flags(), BSDFFlags::NeedsDifferentials))) {
+                flags |= (uint32_t) RayFlags::dPdUV;
+                break;
+            }
+        }
+    }
+
+    m_minimal_ray_flags = flags;
+}
+
 MI_VARIANT
 void Scene<Float, Spectrum>::update_emitter_sampling_distribution() {
     // Check if we need to use non-uniform emitter sampling.
@@ -110,11 +181,141 @@ void Scene<Float, Spectrum>::update_emitter_sampling_distribution() {
         // By default use uniform sampling with constant PMF
         m_emitter_pmf = m_emitters.empty() ? 0.f : (1.f / n_emitters);
     }
+    if (m_use_light_tree)
+        build_light_tree();
+
     // Clear emitter's dirty flag
     for (auto &e : m_emitters)
         e->set_dirty(false);
 }
 
+MI_VARIANT
+void Scene<Float, Spectrum>::build_light_tree() {
+    constexpr uint32_t leaf_flag = 0x80000000u,
+                       no_leaf   = 0xffffffffu;
+
+    uint32_t n_emitters = (uint32_t) m_emitters.size();
+
+    /* Partition the emitters: spatially bounded ones enter the tree, while
+       emitters at infinity (e.g. environment maps) form a separate group
+       that is sampled in proportion to its sampling weights */
+    std::vector<uint32_t> bounded, infinite;
+    std::vector<ScalarBoundingBox3f> bboxes(n_emitters);
+    double weight_bounded = 0.0, weight_inf = 0.0;
+
+    for (uint32_t i = 0; i < n_emitters; ++i) {
+        const Emitter *e = m_emitters[i];
+        bboxes[i] = e->bbox();
+        if (has_flag(e->flags(), EmitterFlags::Infinite) || !bboxes[i].valid()) {
+            infinite.push_back(i);
+            weight_inf += e->sampling_weight();
+        } else {
+            bounded.push_back(i);
+            weight_bounded += e->sampling_weight();
+        }
+    }
+
+    double weight_sum = weight_bounded + weight_inf;
+    m_light_tree_p_inf =
+        weight_sum > 0.0 ? (ScalarFloat) (weight_inf / weight_sum) : 0.f;
+
+    std::vector<uint32_t> leaf_of(n_emitters, no_leaf);
+    std::vector<ScalarFloat> const_pmf(n_emitters, 0.f);
+
+    if (!infinite.empty()) {
+        std::unique_ptr<ScalarFloat[]> weights(new ScalarFloat[infinite.size()]);
+        for (size_t i = 0; i < infinite.size(); ++i) {
+            ScalarFloat w = m_emitters[infinite[i]]->sampling_weight();
+            weights[i] = w;
+            const_pmf[infinite[i]] =
+                (ScalarFloat) (m_light_tree_p_inf * w / weight_inf);
+        }
+        m_light_tree_inf_distr = std::make_unique<DiscreteDistribution<Float>>(
+            weights.get(), infinite.size());
+        m_light_tree_inf_indices = dr::load<DynamicBuffer<UInt32>>(
+            infinite.data(), infinite.size());
+    } else {
+        m_light_tree_inf_distr = nullptr;
+    }
+
+    /* Flat node storage; non-leaf children are always allocated as adjacent
+       pairs, hence only the left child index needs to be stored */
+    std::vector<ScalarFloat> data;
+    std::vector<uint32_t> child, parent;
+
+    std::function<void (uint32_t *, uint32_t, uint32_t)> build =
+            [&](uint32_t *elems, uint32_t count, uint32_t self) {
+        ScalarBoundingBox3f bbox;
+        ScalarFloat weight = 0.f;
+        for (uint32_t i = 0; i < count; ++i) {
+            bbox.expand(bboxes[elems[i]]);
+            weight += m_emitters[elems[i]]->sampling_weight();
+        }
+
+        ScalarPoint3f center = bbox.center();
+        data[self * 5 + 0] = center.x();
+        data[self * 5 + 1] = center.y();
+        data[self * 5 + 2] = center.z();
+        data[self * 5 + 3] = .25f * dr::squared_norm(bbox.extents());
+        data[self * 5 + 4] = weight;
+
+        if (count == 1) {
+            child[self] = elems[0] | leaf_flag;
+            leaf_of[elems[0]] = self;
+            return;
+        }
+
+        // Median split along the dominant axis of the centroid bounds
+        ScalarBoundingBox3f centroids;
+        for (uint32_t i = 0; i < count; ++i)
+            centroids.expand(bboxes[elems[i]].center());
+        uint32_t axis = (uint32_t) centroids.major_axis(),
+                 half = count / 2,
+                 c    = (uint32_t) child.size();
+
+        std::nth_element(elems, elems + half, elems + count,
+                         [&](uint32_t a, uint32_t b) {
+                             return bboxes[a].center()[axis] <
+                                    bboxes[b].center()[axis];
+                         });
+
+        child[self] = c;
+        data.insert(data.end(), 10, 0.f);
+        child.insert(child.end(), 2, 0u);
+        parent.insert(parent.end(), 2, self);
+
+        build(elems, half, c);
+        build(elems + half, count - half, c + 1);
+    };
+
+    if (!bounded.empty()) {
+        data.insert(data.end(), 5, 0.f);
+        child.push_back(0);
+        parent.push_back(0);
+        build(bounded.data(), (uint32_t) bounded.size(), 0);
+
+        m_light_tree_data =
+            dr::load<DynamicBuffer<Float>>(data.data(), data.size());
+        m_light_tree_child =
+            dr::load<DynamicBuffer<UInt32>>(child.data(), child.size());
+        m_light_tree_parent =
+            dr::load<DynamicBuffer<UInt32>>(parent.data(), parent.size());
+    } else {
+        m_light_tree_data = DynamicBuffer<Float>();
+        m_light_tree_child = DynamicBuffer<UInt32>();
+        m_light_tree_parent = DynamicBuffer<UInt32>();
+        if (!infinite.empty())
+            m_light_tree_p_inf = 1.f;
+    }
+
+    if (n_emitters > 0) {
+        m_light_tree_leaf =
+            dr::load<DynamicBuffer<UInt32>>(leaf_of.data(), n_emitters);
+        m_light_tree_const_pmf =
+            dr::load<DynamicBuffer<Float>>(const_pmf.data(), n_emitters);
+    }
+}
+
 MI_VARIANT Scene<Float, Spectrum>::~Scene() {
     if constexpr (dr::is_cuda_v<Float>)
         accel_release_gpu();
@@ -142,6 +343,7 @@ MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect(const Ray3f &ray, uint32_t ray_flags, Mask coherent, Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::RayIntersect, active);
     DRJIT_MARK_USED(coherent);
+    render_stats::increment(render_stats::Counter::RaysTraced, dr::width(ray));
 
     if constexpr (dr::is_cuda_v<Float>)
         return ray_intersect_gpu(ray, ray_flags, active);
@@ -152,6 +354,7 @@ Scene<Float, Spectrum>::ray_intersect(const Ray3f &ray, uint32_t ray_flags, Mask
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
 Scene<Float, Spectrum>::ray_intersect_preliminary(const Ray3f &ray, Mask coherent, Mask active) const {
     DRJIT_MARK_USED(coherent);
+    render_stats::increment(render_stats::Counter::RaysTraced, dr::width(ray));
     if constexpr (dr::is_cuda_v<Float>)
         return ray_intersect_preliminary_gpu(ray, active);
     else
@@ -162,6 +365,8 @@ MI_VARIANT typename Scene<Float, Spectrum>::Mask
 Scene<Float, Spectrum>::ray_test(const Ray3f &ray, Mask coherent, Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::RayTest, active);
     DRJIT_MARK_USED(coherent);
+    render_stats::increment(render_stats::Counter::ShadowRaysTraced,
+                            dr::width(ray));
 
     if constexpr (dr::is_cuda_v<Float>)
         return ray_test_gpu(ray, active);
@@ -169,6 +374,40 @@ Scene<Float, Spectrum>::ray_test(const Ray3f &ray, Mask coherent, Mask active) c
         return ray_test_cpu(ray, coherent, active);
 }
 
+MI_VARIANT void Scene<Float, Spectrum>::ray_test_many(const Ray3f *rays,
+                                                      Mask *occluded,
+                                                      size_t count) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        ScopedPhase sp(ProfilerPhase::RayTest);
+        render_stats::increment(render_stats::Counter::ShadowRaysTraced, count);
+        ray_test_many_cpu(rays, occluded, count);
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(occluded);
+        DRJIT_MARK_USED(count);
+        Throw("ray_test_many() is only available in scalar variants; use a "
+              "wide ray_test() call instead.");
+    }
+}
+
+MI_VARIANT void Scene<Float, Spectrum>::ray_intersect_many(
+    const Ray3f *rays, SurfaceInteraction3f *si, size_t count,
+    uint32_t ray_flags, bool coherent) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        ScopedPhase sp(ProfilerPhase::RayIntersect);
+        render_stats::increment(render_stats::Counter::RaysTraced, count);
+        ray_intersect_many_cpu(rays, si, count, ray_flags, coherent);
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(si);
+        DRJIT_MARK_USED(count);
+        DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(coherent);
+        Throw("ray_intersect_many() is only available in scalar variants; "
+              "use a wide ray_intersect() call instead.");
+    }
+}
+
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_naive(const Ray3f &ray, Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::RayIntersect, active);
@@ -217,6 +456,140 @@ MI_VARIANT Float Scene<Float, Spectrum>::pdf_emitter(UInt32 index,
         return m_emitter_distr->eval_pmf_normalized(index, active);
 }
 
+MI_VARIANT Float Scene<Float, Spectrum>::light_tree_importance(
+        const Point3f &p, const UInt32 &node, const Mask &active) const {
+    UInt32 o = node * 5u;
+    Point3f center(dr::gather<Float>(m_light_tree_data, o, active),
+                   dr::gather<Float>(m_light_tree_data, o + 1u, active),
+                   dr::gather<Float>(m_light_tree_data, o + 2u, active));
+    Float radius_2 = dr::gather<Float>(m_light_tree_data, o + 3u, active),
+          weight   = dr::gather<Float>(m_light_tree_data, o + 4u, active);
+
+    /* Clamping the squared distance to the squared cluster radius bounds
+       the importance of clusters containing the reference point; the
+       epsilon keeps coincident point emitters finite */
+    Float dist_2 = dr::maximum(dr::squared_norm(p - center),
+                               dr::maximum(radius_2, ScalarFloat(1e-9)));
+
+    return weight * dr::rcp(dist_2);
+}
+
+MI_VARIANT std::tuple<typename Scene<Float, Spectrum>::UInt32, Float, Float>
+Scene<Float, Spectrum>::sample_emitter_tree(const Point3f &p,
+                                            Float index_sample,
+                                            Mask active) const {
+    MI_MASKED_FUNCTION(ProfilerPhase::SampleEmitter, active);
+
+    if (unlikely(m_emitters.size() < 2)) {
+        if (m_emitters.size() == 1)
+            return { UInt32(0), 1.f, index_sample };
+        else
+            return { UInt32(-1), 0.f, index_sample };
+    }
+
+    if (unlikely(!m_use_light_tree))
+        return sample_emitter(index_sample, active);
+
+    constexpr uint32_t leaf_flag = 0x80000000u;
+    ScalarFloat p_inf = m_light_tree_p_inf;
+
+    UInt32 index(0);
+    Float pmf(0.f), sample(index_sample);
+
+    // Choose between the group of emitters at infinity and the tree
+    Mask pick_inf = active && (index_sample < p_inf);
+
+    if (m_light_tree_inf_distr) {
+        auto [local, reused, local_pmf] =
+            m_light_tree_inf_distr->sample_reuse_pmf(
+                dr::minimum(index_sample / p_inf,
+                            dr::OneMinusEpsilon<Float>), pick_inf);
+        dr::masked(index, pick_inf) =
+            dr::gather<UInt32>(m_light_tree_inf_indices, local, pick_inf);
+        dr::masked(pmf, pick_inf) = local_pmf * p_inf;
+        dr::masked(sample, pick_inf) = reused;
+    }
+
+    if (dr::width(m_light_tree_child) > 0) {
+        /* Descend into the tree, picking children with probability
+           proportional to their approximate contribution at p */
+        Mask active_t = active && !pick_inf;
+        Float s = (index_sample - p_inf) / (1.f - p_inf),
+              pmf_t = 1.f - p_inf;
+        UInt32 child =
+            dr::gather<UInt32>(m_light_tree_child, UInt32(0), active_t);
+
+        dr::Loop<Mask> loop("Scene::sample_emitter_tree", s, pmf_t, child);
+        while (loop(active_t && dr::eq(child & leaf_flag, 0u))) {
+            Mask m = active_t && dr::eq(child & leaf_flag, 0u);
+
+            Float i_left  = light_tree_importance(p, child, m),
+                  i_right = light_tree_importance(p, child + 1u, m),
+                  i_sum   = i_left + i_right;
+            Float w_left = dr::select(i_sum > 0.f, i_left / i_sum, 0.5f);
+
+            Mask go_left = s < w_left;
+            s = dr::clamp(dr::select(go_left, s / w_left,
+                                     (s - w_left) / (1.f - w_left)),
+                          0.f, dr::OneMinusEpsilon<Float>);
+            pmf_t *= dr::select(go_left, w_left, 1.f - w_left);
+
+            UInt32 next = dr::select(go_left, child, child + 1u);
+            child = dr::gather<UInt32>(m_light_tree_child, next, m);
+        }
+
+        dr::masked(index, active_t) = child & ~leaf_flag;
+        dr::masked(pmf, active_t) = pmf_t;
+        dr::masked(sample, active_t) = s;
+    }
+
+    return { index, dr::select(pmf > 0.f, dr::rcp(pmf), 0.f), sample };
+}
+
+MI_VARIANT Float Scene<Float, Spectrum>::pdf_emitter_tree(const Point3f &p,
+                                                          UInt32 index,
+                                                          Mask active) const {
+    if (unlikely(m_emitters.size() < 2))
+        return m_emitters.empty() ? 0.f : 1.f;
+
+    if (unlikely(!m_use_light_tree))
+        return pdf_emitter(index, active);
+
+    UInt32 leaf = dr::gather<UInt32>(m_light_tree_leaf, index, active);
+    Mask in_tree = active && dr::neq(leaf, 0xffffffffu);
+
+    // Fixed group PMF of the emitters sampled outside of the tree
+    Float pmf =
+        dr::gather<Float>(m_light_tree_const_pmf, index, active && !in_tree);
+
+    if (dr::width(m_light_tree_child) > 0) {
+        /* Walk from the leaf up to the root, reconstructing the branch
+           probabilities that sample_emitter_tree() would have used */
+        Float pmf_t = 1.f - m_light_tree_p_inf;
+        UInt32 node = leaf;
+        Mask running = in_tree && dr::neq(node, 0u);
+
+        dr::Loop<Mask> loop("Scene::pdf_emitter_tree", node, pmf_t, running);
+        while (loop(running)) {
+            UInt32 par  = dr::gather<UInt32>(m_light_tree_parent, node, running),
+                   left = dr::gather<UInt32>(m_light_tree_child, par, running);
+
+            Float i_left  = light_tree_importance(p, left, running),
+                  i_right = light_tree_importance(p, left + 1u, running),
+                  i_sum   = i_left + i_right;
+            Float w = dr::select(dr::eq(node, left), i_left, i_right);
+
+            pmf_t *= dr::select(i_sum > 0.f, w / i_sum, 0.5f);
+            node = par;
+            running &= dr::neq(node, 0u);
+        }
+
+        pmf = dr::select(in_tree, pmf_t, pmf);
+    }
+
+    return pmf;
+}
+
 MI_VARIANT std::tuple<typename Scene<Float, Spectrum>::Ray3f, Spectrum,
                        const typename Scene<Float, Spectrum>::EmitterPtr>
 Scene<Float, Spectrum>::sample_emitter_ray(Float time, Float sample1,
@@ -224,7 +597,8 @@ Scene<Float, Spectrum>::sample_emitter_ray(Float time, Float sample1,
                                            const Point2f &sample3,
                                            Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::SampleEmitterRay, active);
-
+    render_stats::increment(render_stats::Counter::EmitterRaySamples,
+                            dr::width(sample2));
 
     Ray3f ray;
     Spectrum weight;
@@ -260,6 +634,8 @@ MI_VARIANT std::pair<typename Scene<Float, Spectrum>::DirectionSample3f, Spectru
 Scene<Float, Spectrum>::sample_emitter_direction(const Interaction3f &ref, const Point2f &sample_,
                                                  bool test_visibility, Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::SampleEmitterDirection, active);
+    render_stats::increment(render_stats::Counter::EmitterSamples,
+                            dr::width(sample_));
 
     Point2f sample(sample_);
     DirectionSample3f ds;
@@ -273,7 +649,14 @@ Scene<Float, Spectrum>::sample_emitter_direction(const Interaction3f &ref, const
     size_t emitter_count = m_emitters.size();
     if (emitter_count > 1 || (emitter_count == 1 && !vcall_inline)) {
         // Randomly pick an emitter
-        auto [index, emitter_weight, sample_x_re] = sample_emitter(sample.x(), active);
+        UInt32 index;
+        Float emitter_weight, sample_x_re;
+        if (m_use_light_tree)
+            std::tie(index, emitter_weight, sample_x_re) =
+                sample_emitter_tree(ref.p, sample.x(), active);
+        else
+            std::tie(index, emitter_weight, sample_x_re) =
+                sample_emitter(sample.x(), active);
         sample.x() = sample_x_re;
 
         // Sample a direction towards the emitter
@@ -281,7 +664,8 @@ Scene<Float, Spectrum>::sample_emitter_direction(const Interaction3f &ref, const
         std::tie(ds, spec) = emitter->sample_direction(ref, sample, active);
 
         // Account for the discrete probability of sampling this emitter
-        ds.pdf *= pdf_emitter(index, active);
+        ds.pdf *= m_use_light_tree ? dr::rcp(emitter_weight)
+                                   : pdf_emitter(index, active);
         spec *= emitter_weight;
 
         active &= dr::neq(ds.pdf, 0.f);
@@ -318,7 +702,9 @@ Scene<Float, Spectrum>::pdf_emitter_direction(const Interaction3f &ref,
                                               Mask active) const {
     MI_MASK_ARGUMENT(active);
     Float emitter_pmf;
-    if (m_emitter_distr == nullptr)
+    if (m_use_light_tree)
+        emitter_pmf = pdf_emitter_tree(ref.p, ds.emitter->scene_index(), active);
+    else if (m_emitter_distr == nullptr)
         emitter_pmf = m_emitter_pmf;
     else
         emitter_pmf = ds.emitter->sampling_weight() * m_emitter_distr->normalization();
@@ -340,10 +726,7 @@ MI_VARIANT void Scene<Float, Spectrum>::traverse(TraversalCallback *callback) {
     }
 }
 
-MI_VARIANT void Scene<Float, Spectrum>::parameters_changed(const std::vector<std::string> &/*keys*/) {
-    if (m_environment)
-        m_environment->set_scene(this); // TODO use parameters_changed({"scene"})
-
+MI_VARIANT void Scene<Float, Spectrum>::parameters_changed(const std::vector<std::string> &keys) {
     bool accel_is_dirty = false;
     for (auto &s : m_shapes) {
         if (s->dirty()) {
@@ -359,6 +742,11 @@ MI_VARIANT void Scene<Float, Spectrum>::parameters_changed(const std::vector<std
         }
     }
 
+    /* The environment emitter caches the scene's bounding sphere, which can
+       only have changed if some shape was modified */
+    if (m_environment && (accel_is_dirty || keys.empty()))
+        m_environment->set_scene(this); // TODO use parameters_changed({"scene"})
+
     if (accel_is_dirty) {
         if constexpr (dr::is_cuda_v<Float>)
             accel_parameters_changed_gpu();
@@ -374,14 +762,22 @@ MI_VARIANT void Scene<Float, Spectrum>::parameters_changed(const std::vector<std
             break;
     }
 
-    // Check if emitters were modified and we potentially need to update
-    // the emitter sampling distribution.
+    /* BSDF updates may toggle flags that determine whether position partials
+       are needed (e.g. anisotropic roughness values) */
+    update_minimal_ray_flags();
+
+    /* Check if emitters were modified and we potentially need to update the
+       emitter sampling distribution. The light tree additionally depends on
+       the shape bounding boxes and must follow any geometry update. */
+    bool emitters_dirty = accel_is_dirty && m_use_light_tree;
     for (auto &e : m_emitters) {
         if (e->dirty()) {
-            update_emitter_sampling_distribution();
+            emitters_dirty = true;
             break;
         }
     }
+    if (emitters_dirty)
+        update_emitter_sampling_distribution();
 }
 
 MI_VARIANT std::string Scene<Float, Spectrum>::to_string() const {
@@ -1,5 +1,6 @@
 #include <embree3/rtcore.h>
 #include <nanothread/nanothread.h>
+#include <mitsuba/core/random.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -15,6 +16,8 @@ struct EmbreeState {
     std::vector<int> geometries;
     DynamicBuffer<UInt32> shapes_registry_ids;
     bool is_nested_scene = false;
+    bool stochastic_alpha_test = false;
+    bool refit = false;
 };
 
 static void embree_error_callback(void * /*user_ptr */, RTCError code, const char *str) {
@@ -82,6 +85,11 @@ void rtcIntersect32(const int *valid, RTCScene scene,
 
 MI_VARIANT void
 Scene<Float, Spectrum>::accel_init_cpu(const Properties &props) {
+    /* Only used by the OptiX backend -- Embree's public API provides no way
+       to serialize or relocate a finished BVH, so there is nothing to cache
+       on the CPU path. */
+    props.mark_queried("accel_cache");
+
     if (!embree_device) {
         embree_threads = std::max((uint32_t) 1, pool_size());
         std::string config_str = tfm::format(
@@ -103,9 +111,48 @@ Scene<Float, Spectrum>::accel_init_cpu(const Properties &props) {
         }
     }
 
+    /* Scene-wide BVH build quality. The default ('high') maximizes ray
+       tracing performance. Interactive editing sessions can request much
+       cheaper builds ('medium'/'low'), optionally combined with
+       'accel_dynamic', which makes Embree favor fast incremental rebuilds
+       when the geometry changes between frames. */
+    std::string quality_str =
+        string::to_lower(props.string("accel_build_quality", "high"));
+    RTCBuildQuality quality;
+    if (quality_str == "low")
+        quality = RTC_BUILD_QUALITY_LOW;
+    else if (quality_str == "medium")
+        quality = RTC_BUILD_QUALITY_MEDIUM;
+    else if (quality_str == "high")
+        quality = RTC_BUILD_QUALITY_HIGH;
+    else
+        Throw("Invalid BVH build quality \"%s\", must be one of \"low\", "
+              "\"medium\" or \"high\"!", quality_str);
+
+    /* Opt-in stochastic alpha test: opacity-masked shapes (see the 'mask'
+       plugin) are resolved during shadow ray traversal instead of as a chain
+       of null BSDF samples. Only available in scalar variants, where shape
+       code can run inside an Embree filter callback. */
+    s.stochastic_alpha_test =
+        props.get<bool>("stochastic_alpha_test", false);
+    if (s.stochastic_alpha_test && dr::is_jit_v<Float>) {
+        Log(Warn, "The \"stochastic_alpha_test\" scene property is only "
+                  "supported in scalar variants and will be ignored.");
+        s.stochastic_alpha_test = false;
+    }
+
+    /* Opt-in BVH refitting: when shape parameters change after the initial
+       build (e.g. animated rigid transforms driving a turntable), update
+       the existing BVH in place instead of rebuilding it from scratch.
+       Refitting costs milliseconds but degrades traversal performance if
+       the geometry moves far from its original configuration. */
+    s.refit = props.get<bool>("accel_refit", false);
+
     s.accel = rtcNewScene(embree_device);
-    rtcSetSceneBuildQuality(s.accel, RTC_BUILD_QUALITY_HIGH);
-    rtcSetSceneFlags(s.accel, RTC_SCENE_FLAG_NONE);
+    rtcSetSceneBuildQuality(s.accel, quality);
+    rtcSetSceneFlags(s.accel, props.get<bool>("accel_dynamic", false)
+                                  ? RTC_SCENE_FLAG_DYNAMIC
+                                  : RTC_SCENE_FLAG_NONE);
 
     ScopedPhase phase(ProfilerPhase::InitAccel);
     accel_parameters_changed_cpu();
@@ -127,20 +174,108 @@ Scene<Float, Spectrum>::accel_init_cpu(const Properties &props) {
     }
 }
 
+/* Occlusion filter implementing a stochastic alpha test for opacity-masked
+   shapes (see \ref Shape::eval_opacity()). Transparent hits are
+   probabilistically rejected during traversal so that shadow rays through
+   masked geometry (e.g. foliage) cost a single traversal instead of a chain
+   of null BSDF samples. */
+template <typename Float, typename Spectrum>
+static void embree_opacity_filter(const RTCFilterFunctionNArguments *args) {
+    if constexpr (!dr::is_jit_v<Float>) {
+        MI_IMPORT_TYPES(Shape)
+
+        const Shape *shape = (const Shape *) args->geometryUserPtr;
+
+        for (unsigned int i = 0; i < args->N; ++i) {
+            if (args->valid[i] == 0)
+                continue;
+
+            float t_hit = RTCRayN_tfar(args->ray, args->N, i);
+
+            Ray3f ray = dr::zeros<Ray3f>();
+            ray.o = Point3f(RTCRayN_org_x(args->ray, args->N, i),
+                            RTCRayN_org_y(args->ray, args->N, i),
+                            RTCRayN_org_z(args->ray, args->N, i));
+            ray.d = Vector3f(RTCRayN_dir_x(args->ray, args->N, i),
+                             RTCRayN_dir_y(args->ray, args->N, i),
+                             RTCRayN_dir_z(args->ray, args->N, i));
+            ray.time = RTCRayN_time(args->ray, args->N, i);
+            ray.maxt = t_hit;
+
+            PreliminaryIntersection3f pi = dr::zeros<PreliminaryIntersection3f>();
+            pi.t          = t_hit;
+            pi.prim_uv    = Point2f(RTCHitN_u(args->hit, args->N, i),
+                                    RTCHitN_v(args->hit, args->N, i));
+            pi.prim_index = RTCHitN_primID(args->hit, args->N, i);
+            pi.shape      = shape;
+
+            SurfaceInteraction3f si =
+                pi.compute_surface_interaction(ray, +RayFlags::UV, true);
+
+            Float opacity = shape->eval_opacity(si, true);
+            if (opacity >= 1.f)
+                continue;
+
+            /* Deterministic variate hashed from the primitive index and the
+               hit distance, which keeps renders reproducible */
+            uint32_t t_bits;
+            memcpy(&t_bits, &t_hit, sizeof(uint32_t));
+            float sample = sample_tea_float32((uint32_t) pi.prim_index, t_bits);
+
+            // Transparent: reject the hit and keep traversing
+            if (Float(sample) >= opacity)
+                args->valid[i] = 0;
+        }
+    } else {
+        DRJIT_MARK_USED(args);
+    }
+}
+
 MI_VARIANT void Scene<Float, Spectrum>::accel_parameters_changed_cpu() {
     if constexpr (dr::is_llvm_v<Float>)
         dr::sync_thread();
 
     EmbreeState<Float> &s = *(EmbreeState<Float> *) m_accel;
 
-    for (int geo : s.geometries)
-        rtcDetachGeometry(s.accel, geo);
-    s.geometries.clear();
+    /* Refit path: when requested via the 'accel_refit' scene property, push
+       the updated state of dirty shapes into their already attached Embree
+       geometries, so that committing the scene below refits the BVH instead
+       of rebuilding it. Shapes that cannot be updated in place (as well as
+       any change inside a shape group) fall back to a full rebuild. */
+    bool refit = s.refit && !s.geometries.empty() &&
+                 s.geometries.size() == m_shapes.size();
+
+    for (auto &sg : m_shapegroups)
+        refit &= !sg->dirty();
+
+    for (size_t i = 0; i < m_shapes.size() && refit; ++i) {
+        if (!m_shapes[i]->dirty())
+            continue;
+        refit = m_shapes[i]->embree_refit(
+            rtcGetGeometry(s.accel, s.geometries[i]));
+    }
 
-    for (Shape *shape : m_shapes) {
-        RTCGeometry geom = shape->embree_geometry(embree_device);
-        s.geometries.push_back(rtcAttachGeometry(s.accel, geom));
-        rtcReleaseGeometry(geom);
+    if (!refit) {
+        for (int geo : s.geometries)
+            rtcDetachGeometry(s.accel, geo);
+        s.geometries.clear();
+
+        for (Shape *shape : m_shapes) {
+            RTCGeometry geom = shape->embree_geometry(embree_device);
+            if (shape->bvh_build_quality() != -1) {
+                rtcSetGeometryBuildQuality(
+                    geom, (RTCBuildQuality) shape->bvh_build_quality());
+                rtcCommitGeometry(geom);
+            }
+            if (s.stochastic_alpha_test && shape->has_opacity_query()) {
+                rtcSetGeometryUserData(geom, (void *) shape);
+                rtcSetGeometryOccludedFilterFunction(
+                    geom, embree_opacity_filter<Float, Spectrum>);
+                rtcCommitGeometry(geom);
+            }
+            s.geometries.push_back(rtcAttachGeometry(s.accel, geom));
+            rtcReleaseGeometry(geom);
+        }
     }
 
     // Ensure shape data pointers are fully evaluated before building the BVH
@@ -425,6 +560,141 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
     }
 }
 
+MI_VARIANT void Scene<Float, Spectrum>::ray_test_many_cpu(const Ray3f *rays,
+                                                          Mask *occluded,
+                                                          size_t count) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        using Single = dr::float32_array_t<Float>;
+        using Vector3s = Vector<Single, 3>;
+        EmbreeState<Float> &s = *(EmbreeState<Float> *) m_accel;
+
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        context.flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+
+        constexpr size_t ChunkSize = 1024;
+        std::unique_ptr<RTCRay[]> chunk(new RTCRay[std::min(count, ChunkSize)]);
+        std::unique_ptr<float[]> maxt(new float[std::min(count, ChunkSize)]);
+
+        for (size_t start = 0; start < count; start += ChunkSize) {
+            size_t n = std::min(count - start, ChunkSize);
+
+            for (size_t i = 0; i < n; ++i) {
+                const Ray3f &ray = rays[start + i];
+
+                // Be careful with 'ray.maxt' in double precision variants
+                Single ray_maxt = Single(ray.maxt);
+                if constexpr (!std::is_same_v<Single, Float>)
+                    ray_maxt = dr::minimum(ray_maxt, dr::Largest<Single>);
+
+                RTCRay &ray2 = chunk[i];
+                dr::store(&ray2.org_x, dr::concat(Vector3s(ray.o), float(0.f)));
+                dr::store(&ray2.dir_x, dr::concat(Vector3s(ray.d), float(ray.time)));
+                ray2.tfar = (float) ray_maxt;
+                ray2.mask = 0;
+                ray2.id = 0;
+                ray2.flags = 0;
+                maxt[i] = (float) ray_maxt;
+            }
+
+            rtcOccluded1M(s.accel, &context, chunk.get(), (unsigned int) n,
+                          sizeof(RTCRay));
+
+            for (size_t i = 0; i < n; ++i)
+                occluded[start + i] = chunk[i].tfar != maxt[i];
+        }
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(occluded);
+        DRJIT_MARK_USED(count);
+        Throw("ray_test_many_cpu() is only available in scalar variants.");
+    }
+}
+
+MI_VARIANT void Scene<Float, Spectrum>::ray_intersect_many_cpu(
+    const Ray3f *rays, SurfaceInteraction3f *si, size_t count,
+    uint32_t ray_flags, bool coherent) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        using Single = dr::float32_array_t<Float>;
+        using Vector3s = Vector<Single, 3>;
+        EmbreeState<Float> &s = *(EmbreeState<Float> *) m_accel;
+
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        context.flags = coherent ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT
+                                 : RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+
+        constexpr size_t ChunkSize = 1024;
+        std::unique_ptr<RTCRayHit[]> chunk(new RTCRayHit[std::min(count, ChunkSize)]);
+        std::unique_ptr<float[]> maxt(new float[std::min(count, ChunkSize)]);
+
+        for (size_t start = 0; start < count; start += ChunkSize) {
+            size_t n = std::min(count - start, ChunkSize);
+
+            for (size_t i = 0; i < n; ++i) {
+                const Ray3f &ray = rays[start + i];
+
+                // Be careful with 'ray.maxt' in double precision variants
+                Single ray_maxt = Single(ray.maxt);
+                if constexpr (!std::is_same_v<Single, Float>)
+                    ray_maxt = dr::minimum(ray_maxt, dr::Largest<Single>);
+
+                RTCRayHit &rh = chunk[i];
+                dr::store(&rh.ray.org_x, dr::concat(Vector3s(ray.o), float(0.f)));
+                dr::store(&rh.ray.dir_x, dr::concat(Vector3s(ray.d), float(ray.time)));
+                rh.ray.tfar = (float) ray_maxt;
+                rh.ray.mask = 0;
+                rh.ray.id = 0;
+                rh.ray.flags = 0;
+                rh.hit.geomID = (uint32_t) -1;
+                maxt[i] = (float) ray_maxt;
+            }
+
+            rtcIntersect1M(s.accel, &context, chunk.get(), (unsigned int) n,
+                           sizeof(RTCRayHit));
+
+            for (size_t i = 0; i < n; ++i) {
+                const RTCRayHit &rh = chunk[i];
+                PreliminaryIntersection3f pi = dr::zeros<PreliminaryIntersection3f>();
+
+                if (rh.ray.tfar != maxt[i]) {
+                    uint32_t shape_index = rh.hit.geomID;
+                    uint32_t prim_index  = rh.hit.primID;
+
+                    // We get level 0 because we only support one level of instancing
+                    uint32_t inst_index = rh.hit.instID[0];
+
+                    // If the hit is not on an instance
+                    bool hit_instance = inst_index != RTC_INVALID_GEOMETRY_ID;
+                    uint32_t index = hit_instance ? inst_index : shape_index;
+
+                    ShapePtr shape = m_shapes[index];
+                    if (hit_instance)
+                        pi.instance = shape;
+                    else
+                        pi.shape = shape;
+
+                    pi.shape_index = shape_index;
+
+                    pi.t = rh.ray.tfar;
+                    pi.prim_index = prim_index;
+                    pi.prim_uv = Point2f(rh.hit.u, rh.hit.v);
+                }
+
+                si[start + i] = pi.compute_surface_interaction(
+                    rays[start + i], ray_flags, true);
+            }
+        }
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(si);
+        DRJIT_MARK_USED(count);
+        DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(coherent);
+        Throw("ray_intersect_many_cpu() is only available in scalar variants.");
+    }
+}
+
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_naive_cpu(const Ray3f &ray,
                                                 Mask active) const {
@@ -8,6 +8,12 @@ struct NativeState {
 };
 
 MI_VARIANT void Scene<Float, Spectrum>::accel_init_cpu(const Properties &props) {
+    /* Only used by the Embree backend -- the kd-tree exposes its own set
+       of build-related properties (see kdtree.h) */
+    props.mark_queried("accel_build_quality");
+    props.mark_queried("accel_dynamic");
+    props.mark_queried("accel_cache"); // Only used by the OptiX backend
+
     ShapeKDTree *kdtree = new ShapeKDTree(props);
     kdtree->inc_ref();
 
@@ -44,6 +50,13 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_parameters_changed_cpu() {
     else
         kdtree = (ShapeKDTree *) m_accel;
 
+    /* Rebuild the shared kd-trees of modified shape groups first, so that
+       instances report up-to-date bounding boxes when the top-level tree is
+       rebuilt below (the sub-trees are shared between all instances of a
+       group, hence memory use stays proportional to the unique geometry) */
+    for (auto &group : m_shapegroups)
+        group->accel_parameters_changed();
+
     kdtree->clear();
     for (Shape *shape : m_shapes)
         kdtree->add_shape(shape);
@@ -119,7 +132,7 @@ template <typename ScalarFloat> struct RayHitT {
 template <typename Float, typename Spectrum, bool ShadowRay, size_t Width>
 void kdtree_trace_func_wrapper(const int *valid, void *ptr,
                                void* /* context */, uint8_t *args) {
-    MI_IMPORT_TYPES()
+    MI_IMPORT_TYPES(Shape)
     using ScalarRay3f = Ray<ScalarPoint3f, Spectrum>;
     using ShapeKDTree = ShapeKDTree<Float, Spectrum>;
 
@@ -127,6 +140,67 @@ void kdtree_trace_func_wrapper(const int *valid, void *ptr,
     const ShapeKDTree *kdtree = s->accel;
     using RayHit = RayHitT<ScalarFloat>;
 
+    /* Fully occupied packets -- the common case for coherent camera rays --
+       are traced together: the kd-tree's packet traversal (see \ref
+       ShapeKDTree::ray_intersect_packet()) shares node fetches and interval
+       tests across all lanes. Partially filled packets (incoherent
+       wavefronts) take the per-lane path below. */
+    if constexpr (Width >= 4) {
+        bool full = true;
+        for (size_t i = 0; i < Width; ++i)
+            full &= valid[i] != 0;
+
+        if (full) {
+            using FloatP = dr::Packet<ScalarFloat, Width>;
+            using Ray3fP = Ray<Point<FloatP, 3>, Spectrum>;
+
+            auto field = [&](size_t offset) -> ScalarFloat * {
+                return (ScalarFloat *) &args[offset * Width];
+            };
+
+            Ray3fP ray;
+            ray.o.x() = dr::load_aligned<FloatP>(field(offsetof(RayHit, o_x)));
+            ray.o.y() = dr::load_aligned<FloatP>(field(offsetof(RayHit, o_y)));
+            ray.o.z() = dr::load_aligned<FloatP>(field(offsetof(RayHit, o_z)));
+            ray.d.x() = dr::load_aligned<FloatP>(field(offsetof(RayHit, d_x)));
+            ray.d.y() = dr::load_aligned<FloatP>(field(offsetof(RayHit, d_y)));
+            ray.d.z() = dr::load_aligned<FloatP>(field(offsetof(RayHit, d_z)));
+            ray.time  = dr::load_aligned<FloatP>(field(offsetof(RayHit, time)));
+            ray.maxt  = dr::load_aligned<FloatP>(field(offsetof(RayHit, tfar)));
+
+            PreliminaryIntersection<ScalarFloat, Shape> pis[Width];
+            kdtree->template ray_intersect_packet<ShadowRay, Width>(ray, pis);
+
+            ScalarFloat *ray_maxt = field(offsetof(RayHit, tfar));
+            if constexpr (ShadowRay) {
+                for (size_t i = 0; i < Width; ++i)
+                    if (pis[i].is_valid())
+                        ray_maxt[i] = 0.f;
+            } else {
+                ScalarFloat *prim_u = field(offsetof(RayHit, u)),
+                            *prim_v = field(offsetof(RayHit, v));
+                uint32_t *prim_id = (uint32_t *) &args[offsetof(RayHit, prim_id) * Width],
+                         *geom_id = (uint32_t *) &args[offsetof(RayHit, geom_id) * Width],
+                         *inst_id = (uint32_t *) &args[offsetof(RayHit, inst_id) * Width];
+
+                for (size_t i = 0; i < Width; ++i) {
+                    const auto &pi = pis[i];
+                    if (!pi.is_valid())
+                        continue;
+
+                    ray_maxt[i] = pi.t;
+                    prim_u[i]   = pi.prim_uv[0];
+                    prim_v[i]   = pi.prim_uv[1];
+                    prim_id[i]  = pi.prim_index;
+                    geom_id[i]  = pi.shape_index;
+                    inst_id[i]  = pi.instance ? (uint32_t) (size_t) pi.shape // shape_index
+                                              : (uint32_t) -1;
+                }
+            }
+            return;
+        }
+    }
+
     for (size_t i = 0; i < Width; i++) {
         if (valid[i] == 0)
             continue;
@@ -267,7 +341,37 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray,
     if constexpr (!dr::is_jit_v<Float>) {
         DRJIT_MARK_USED(coherent);
         const ShapeKDTree *kdtree = (const ShapeKDTree *) m_accel;
-        return kdtree->template ray_intersect_preliminary<true>(ray, active).is_valid();
+
+        /* Consecutive shadow rays from nearby shading points tend to be
+           blocked by the same primitive. Re-test the last occluder seen by
+           this thread first -- if it still blocks the ray, the full tree
+           traversal can be skipped. */
+        struct OccluderCache {
+            const void *scene = nullptr;
+            uint32_t prim_index = 0;
+            bool valid = false;
+        };
+        static thread_local OccluderCache cache;
+
+        /* The primitive index is revalidated on every lookup: geometry
+           updates rebuild the kd-tree in place (see
+           accel_parameters_changed_cpu()), which can shrink the tree while
+           the scene address stays the same. A stale-but-in-range index
+           merely re-tests the wrong primitive; a miss falls through to the
+           full traversal either way. */
+        if (cache.valid && cache.scene == this &&
+            cache.prim_index < kdtree->primitive_count() &&
+            kdtree->ray_test_prim(cache.prim_index, ray))
+            return true;
+
+        PreliminaryIntersection3f pi =
+            kdtree->template ray_intersect_preliminary<true>(ray, active);
+
+        cache.scene = this;
+        cache.prim_index = pi.prim_index;
+        cache.valid = pi.is_valid();
+
+        return pi.is_valid();
     } else {
         void *func_ptr = nullptr, *scene_ptr = m_accel;
 
@@ -306,6 +410,40 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray,
     }
 }
 
+MI_VARIANT void Scene<Float, Spectrum>::ray_test_many_cpu(const Ray3f *rays,
+                                                          Mask *occluded,
+                                                          size_t count) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        /* The kd-tree backend has no dedicated stream interface; a sorted
+           batch still benefits from the per-thread occluder cache in
+           ray_test_cpu() above. */
+        for (size_t i = 0; i < count; ++i)
+            occluded[i] = ray_test_cpu(rays[i], false, true);
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(occluded);
+        DRJIT_MARK_USED(count);
+        Throw("ray_test_many_cpu() is only available in scalar variants.");
+    }
+}
+
+MI_VARIANT void Scene<Float, Spectrum>::ray_intersect_many_cpu(
+    const Ray3f *rays, SurfaceInteraction3f *si, size_t count,
+    uint32_t ray_flags, bool coherent) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        // The kd-tree backend has no dedicated stream interface
+        for (size_t i = 0; i < count; ++i)
+            si[i] = ray_intersect_cpu(rays[i], ray_flags, coherent, true);
+    } else {
+        DRJIT_MARK_USED(rays);
+        DRJIT_MARK_USED(si);
+        DRJIT_MARK_USED(count);
+        DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(coherent);
+        Throw("ray_intersect_many_cpu() is only available in scalar variants.");
+    }
+}
+
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_naive_cpu(const Ray3f &ray, Mask active) const {
     const ShapeKDTree *kdtree;
@@ -33,8 +33,18 @@ struct OptixSceneState {
     size_t config_index;
     uint32_t sbt_jit_index;
     bool own_sbt;
+    std::string accel_cache_dir;
 };
 
+/// Incremental FNV-1a used to key the on-disk GAS cache by geometry content
+static uint64_t accel_cache_hash(const void *data, size_t size,
+                                 uint64_t hash = 0xcbf29ce484222325ull) {
+    const uint8_t *ptr = (const uint8_t *) data;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ ptr[i]) * 0x100000001b3ull;
+    return hash;
+}
+
 /**
  * \brief Optix configuration data structure
  *
@@ -283,6 +293,19 @@ size_t init_optix_config(bool has_meshes, bool has_others, bool has_instances,
             config.program_groups
         ));
 
+        /* Note on shader execution reordering (SER): on Ada and newer GPUs,
+           OptiX 8 can re-sort divergent rays between traversal and shading
+           (optixTraverse() + optixReorder() + optixInvoke()), which pays off
+           handsomely for the incoherent bounces produced by the integrators in
+           this codebase. These intrinsics are only legal inside the raygen
+           program, and Mitsuba's raygen is synthesized by Dr.Jit-core as part
+           of each megakernel (see the jit_optix_ray_trace() calls below); the
+           function table loaded in optix_api.cpp moreover predates the OptiX 8
+           ABI. Once Dr.Jit-core emits the split traverse/invoke sequence, the
+           natural coherence hint to pass to optixReorder() from here is the
+           hit shape pointer (payload 4), which keys shading work by material.
+           Until then there is nothing this file can enable on its own. */
+
         // Create this variable in the JIT scope 0 to ensure a consistent
         // ordering in the generated PTX kernel (e.g. for other scenes).
         uint32_t scope = jit_scope(JitBackend::CUDA);
@@ -300,6 +323,12 @@ size_t init_optix_config(bool has_meshes, bool has_others, bool has_instances,
 
 MI_VARIANT void Scene<Float, Spectrum>::accel_init_gpu(const Properties &props) {
     DRJIT_MARK_USED(props);
+
+    /* Only used by the Embree backend -- the OptiX build flags must match
+       the ones baked into the built-in intersection modules (shapes.h) and
+       can therefore not vary per scene. */
+    props.mark_queried("accel_build_quality");
+    props.mark_queried("accel_dynamic");
     if constexpr (dr::is_cuda_v<Float>) {
         ScopedPhase phase(ProfilerPhase::InitAccel);
         Log(Info, "Building scene in OptiX ..");
@@ -309,6 +338,13 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_init_gpu(const Properties &props)
         m_accel = new OptixSceneState();
         OptixSceneState &s = *(OptixSceneState *) m_accel;
 
+        /* Opt-in on-disk GAS cache: when set to a directory, the compacted
+           geometry acceleration structures are serialized there under a
+           content hash of the scene geometry, and repeated renders of the
+           same scene upload the prebuilt structures instead of rebuilding
+           them from scratch (see build_gas() in optix/shapes.h). */
+        s.accel_cache_dir = props.string("accel_cache", "");
+
         // Check if another scene was passed to the constructor
         Scene *other_scene = nullptr;
         for (auto &[k, v] : props.objects()) {
@@ -440,8 +476,48 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_parameters_changed_gpu() {
         const OptixConfig &config = optix_configs[s.config_index];
 
         if (!m_shapes.empty()) {
+            /* Key the GAS cache by a content hash of the scene geometry:
+               mesh vertex/face buffers dominate the build time and are
+               hashed in full, other shapes contribute their type and
+               world-space bounds. Hashing requires a host readback of the
+               mesh buffers, which is orders of magnitude cheaper than the
+               BVH build it stands to replace. */
+            std::string cache_file;
+            if (!s.accel_cache_dir.empty()) {
+                uint64_t key = accel_cache_hash(&gas_cache_version,
+                                                sizeof(gas_cache_version));
+                for (Shape *shape : m_shapes) {
+                    const std::string &name = shape->class_()->name();
+                    key = accel_cache_hash(name.data(), name.size(), key);
+
+                    if (shape->is_mesh()) {
+                        auto *mesh =
+                            static_cast<Mesh<Float, Spectrum> *>(shape);
+                        auto &&vertices = dr::migrate(
+                            mesh->vertex_positions_buffer(), AllocType::Host);
+                        auto &&faces = dr::migrate(
+                            mesh->faces_buffer(), AllocType::Host);
+                        dr::sync_thread();
+                        key = accel_cache_hash(
+                            vertices.data(),
+                            vertices.size() * sizeof(float), key);
+                        key = accel_cache_hash(
+                            faces.data(),
+                            faces.size() * sizeof(uint32_t), key);
+                    } else {
+                        ScalarBoundingBox3f bbox = shape->bbox();
+                        key = accel_cache_hash(&bbox, sizeof(bbox), key);
+                    }
+                }
+                cache_file = (fs::path(s.accel_cache_dir) /
+                              tfm::format("%016llx.gas", key)).string();
+            }
+
             // Build geometry acceleration structures for all the shapes
-            build_gas(config.context, m_shapes, s.accel);
+            build_gas(config.context, m_shapes, s.accel, cache_file);
+
+            /* Shape group GAS are owned by the shapegroup plugin and always
+               rebuilt; only the top-level geometry participates in the cache */
             for (auto& shapegroup: m_shapegroups)
                 shapegroup->optix_build_gas(config.context);
 
@@ -0,0 +1,77 @@
+#include <mitsuba/render/scheduler.h>
+#include <mitsuba/mitsuba.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+BlockScheduler::BlockScheduler(const Vector2u &size, const Vector2u &offset,
+                               uint32_t block_size, uint32_t passes,
+                               uint32_t worker_count)
+    : m_block_size(block_size), m_worker_count(std::max(worker_count, 1u)),
+      m_row_count(0) {
+
+    m_queues.reset(new Queue[m_worker_count]);
+
+    /* Enumerate the blocks of every pass in spiral order and deal them out
+       round-robin, seeding each worker's deque with a spatially spread
+       subset that still renders roughly inside-out */
+    Spiral spiral(size, offset, block_size, passes);
+    m_block_count = spiral.block_count();
+
+    uint32_t i = 0;
+    while (true) {
+        auto [b_offset, b_size, block_id] = spiral.next_block();
+        if (block_id == (uint32_t) -1)
+            break;
+
+        m_queues[i % m_worker_count].blocks.push_back(
+            { b_offset, b_size, block_id, 0u, b_size.y() });
+        m_row_count += b_size.y();
+        ++i;
+    }
+}
+
+bool BlockScheduler::next_block(uint32_t worker, BlockDescriptor &block) {
+    Assert(worker < m_worker_count);
+
+    // Fast path: pop the oldest block off the worker's own deque
+    {
+        Queue &own = m_queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.blocks.empty()) {
+            block = own.blocks.front();
+            own.blocks.pop_front();
+            return true;
+        }
+    }
+
+    /* Slow path: scan the other deques for work. Stealing takes the *most
+       recently* queued block (i.e. the outermost part of the spiral), which
+       interferes least with the victim's own inside-out progress. */
+    for (uint32_t i = 1; i < m_worker_count; ++i) {
+        Queue &victim = m_queues[(worker + i) % m_worker_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.blocks.empty())
+            continue;
+
+        block = victim.blocks.back();
+        victim.blocks.pop_back();
+
+        /* Subdivide the stolen block's remaining scanlines: the thief takes
+           the upper half of the row range and leaves the lower half behind,
+           so that both threads continue on half-sized work items */
+        uint32_t rows = block.row_end - block.row_begin;
+        if (rows >= 2) {
+            BlockDescriptor rest = block;
+            rest.row_end = block.row_begin + rows / 2;
+            victim.blocks.push_back(rest);
+            block.row_begin = rest.row_end;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+MI_IMPLEMENT_CLASS(BlockScheduler, Object)
+NAMESPACE_END(mitsuba)
@@ -1,5 +1,6 @@
 
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/bsdf.h>
@@ -24,6 +25,18 @@ MI_VARIANT Shape<Float, Spectrum>::Shape(const Properties &props) : m_id(props.i
         (ScalarTransform4f) props.get<ScalarTransform4f>("to_world", ScalarTransform4f());
     m_to_object = m_to_world.scalar().inverse();
 
+    // Optional per-shape BVH build quality override
+    std::string quality = string::to_lower(props.string("build_quality", ""));
+    if (quality == "low")
+        m_bvh_build_quality = 0;
+    else if (quality == "medium")
+        m_bvh_build_quality = 1;
+    else if (quality == "high")
+        m_bvh_build_quality = 2;
+    else if (!quality.empty())
+        Throw("Invalid BVH build quality \"%s\", must be one of \"low\", "
+              "\"medium\" or \"high\"!", quality);
+
     for (auto &[name, obj] : props.objects(false)) {
         Emitter *emitter = dynamic_cast<Emitter *>(obj.get());
         Sensor *sensor   = dynamic_cast<Sensor *>(obj.get());
@@ -317,6 +330,12 @@ MI_VARIANT RTCGeometry Shape<Float, Spectrum>::embree_geometry(RTCDevice device)
         Throw("embree_geometry() should only be called in CPU mode.");
     }
 }
+
+MI_VARIANT bool Shape<Float, Spectrum>::embree_refit(RTCGeometry geom) const {
+    // Conservative default: shapes must opt into in-place BVH updates
+    DRJIT_MARK_USED(geom);
+    return false;
+}
 #endif
 
 #if defined(MI_ENABLE_CUDA)
@@ -569,6 +588,17 @@ MI_VARIANT bool Shape<Float, Spectrum>::parameters_grad_enabled() const {
     return false;
 }
 
+MI_VARIANT Float Shape<Float, Spectrum>::eval_opacity(
+    const SurfaceInteraction3f &si, Mask active) const {
+    if (!m_bsdf)
+        return 1.f;
+    return m_bsdf->eval_opacity(si, active);
+}
+
+MI_VARIANT bool Shape<Float, Spectrum>::has_opacity_query() const {
+    return m_bsdf && m_bsdf->has_opacity_query();
+}
+
 MI_VARIANT void Shape<Float, Spectrum>::initialize() {
     if constexpr (dr::is_jit_v<Float>) {
         if (!is_mesh() && !is_bspline_curve() && !is_linear_curve()) // to_world/to_object is not used
@@ -1,6 +1,7 @@
 #include <mitsuba/core/properties.h>
 #include <mitsuba/render/shapegroup.h>
 #include <mitsuba/render/optix_api.h>
+#include <functional>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -17,15 +18,23 @@ MI_VARIANT ShapeGroup<Float, Spectrum>::ShapeGroup(const Properties &props) {
     m_has_linear_curves = false;
 
     // Add children to the underlying data structure
-    for (auto &kv : props.objects()) {
-        const Class *c_class = kv.second->class_();
+    std::function<void(Object *)> add_object = [&](Object *object) {
+        const Class *c_class = object->class_();
         if (c_class->name() == "Instance") {
-            Throw("Nested instancing is not permitted");
+            Throw("Nested instancing is not permitted (the intersection data "
+                  "structures track a single level of instance transforms). "
+                  "Shape groups can however be nested within each other");
         } else if (c_class->derives_from(MI_CLASS(Base))) {
-            Base *shape = static_cast<Base *>(kv.second.get());
-            ShapeGroup *shapegroup = dynamic_cast<ShapeGroup *>(kv.second.get());
-            if (shapegroup)
-                Throw("Nested ShapeGroup is not permitted");
+            Base *shape = static_cast<Base *>(object);
+            ShapeGroup *shapegroup = dynamic_cast<ShapeGroup *>(object);
+            if (shapegroup) {
+                /* Merge nested groups into this one. The contained shapes are
+                   shared rather than copied, hence memory use remains
+                   proportional to the amount of unique geometry. */
+                for (auto &s : shapegroup->m_shapes)
+                    add_object(s.get());
+                return;
+            }
             if (shape->is_emitter())
                 Throw("Instancing of emitters is not supported");
             if (shape->is_sensor())
@@ -55,9 +64,12 @@ MI_VARIANT ShapeGroup<Float, Spectrum>::ShapeGroup(const Properties &props) {
                 m_has_others |= is_other;
             }
         } else {
-            Throw("Tried to add an unsupported object of type \"%s\"", kv.second);
+            Throw("Tried to add an unsupported object of type \"%s\"", object);
         }
-    }
+    };
+
+    for (auto &kv : props.objects())
+        add_object(kv.second.get());
 #if !defined(MI_ENABLE_EMBREE)
     if constexpr (!dr::is_cuda_v<Float>) {
         if (!m_kdtree->ready())
@@ -234,6 +246,26 @@ MI_VARIANT
 bool ShapeGroup<Float, Spectrum>::ray_test_scalar(const ScalarRay3f &ray) const {
     return m_kdtree->template ray_intersect_scalar<true>(ray).is_valid();
 }
+
+MI_VARIANT void ShapeGroup<Float, Spectrum>::accel_parameters_changed() {
+    if constexpr (!dr::is_cuda_v<Float>) {
+        if (!m_dirty)
+            return;
+
+        m_kdtree->clear();
+        for (auto &s : m_shapes)
+            m_kdtree->add_shape(s.get());
+        m_kdtree->build();
+        m_bbox = m_kdtree->bbox();
+
+        for (auto &s : m_shapes)
+            s->m_dirty = false;
+
+        /* This method is called once per referencing instance, hence make
+           sure we only rebuild the kd-tree once per update. */
+        m_dirty = false;
+    }
+}
 #endif
 
 MI_VARIANT bool ShapeGroup<Float, Spectrum>::parameters_grad_enabled() const {
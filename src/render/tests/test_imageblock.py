@@ -257,3 +257,154 @@ def test06_error_compensation(variants_any_cuda, compensate):
         print(2**24 + 1024)
         print(2**24)
         assert ib.tensor().array[0] ==  2**24 + (1024 if compensate else 0)
+
+def test07_serialization_roundtrip(variants_all_rgb):
+    import numpy as np
+
+    rng = np.random.default_rng(seed=12345)
+    data = rng.random((7, 5, 4)).astype(np.float32)
+
+    ib = mi.ImageBlock(mi.TensorXf(data), offset=[3, -2])
+
+    stream = mi.MemoryStream()
+    ib.write(stream)
+    stream.seek(0)
+
+    ib2 = mi.ImageBlock(stream)
+    assert dr.all(ib2.offset() == ib.offset())
+    assert dr.all(ib2.size() == ib.size())
+    assert ib2.channel_count() == ib.channel_count()
+    assert ib2.border_size() == ib.border_size()
+    assert dr.allclose(ib2.tensor(), ib.tensor())
+
+    # Merging a deserialized block accumulates at the stored offset
+    target = mi.ImageBlock([10, 10], [0, 0], 4)
+    target.put_block(ib2)
+    result = np.array(target.tensor())
+    assert dr.allclose(result[0:5, 3:8], data[2:, :, :], atol=1e-6)
+
+    # Garbage input is rejected
+    bad = mi.MemoryStream()
+    bad.write_string('not an image block')
+    bad.seek(0)
+    with pytest.raises(RuntimeError):
+        mi.ImageBlock(bad)
+
+
+def test08_array_interface(variants_all_rgb):
+    import numpy as np
+
+    block = mi.ImageBlock([4, 3], [0, 0], 5)
+
+    if 'cuda' in mi.variant():
+        # Device memory is exposed via the CUDA array interface instead
+        iface = block.__cuda_array_interface__
+        assert iface['shape'] == (3, 4, 5)
+        assert not hasattr(block, '__array_interface__')
+        return
+
+    block.put([0.5, 0.5], [1, 2, 3, 4, 5])
+
+    # NumPy aliases the block's tensor storage instead of copying it
+    view = np.asarray(block)
+    assert view.shape == (3, 4, 5)
+    assert view.base is block
+    assert dr.allclose(view[0, 0, :], [1, 2, 3, 4, 5])
+
+
+def test09_slot_privatization(variants_vec_rgb):
+    import numpy as np
+
+    block = mi.ImageBlock([4, 3], [0, 0], 5)
+    block.set_slot_count(4)
+    assert block.slot_count() == 4
+
+    # The slotted tensor must not be observable directly
+    with pytest.raises(RuntimeError, match='reduce_slots'):
+        block.tensor()
+
+    # Accumulate many samples into a single pixel across a wide wavefront
+    n = 64
+    pos = mi.Point2f(dr.full(mi.Float, 1.5, n), dr.full(mi.Float, 1.5, n))
+    block.put(pos, [mi.Float(1)] * 5)
+
+    block.reduce_slots()
+    assert block.slot_count() == 1
+
+    result = np.array(block.tensor())
+    assert result.shape == (3, 4, 5)
+    assert dr.allclose(result[1, 1, :], [n] * 5)
+
+    # Reducing twice is a no-op
+    block.reduce_slots()
+    assert dr.allclose(np.array(block.tensor())[1, 1, :], [n] * 5)
+
+
+def test10_half_precision_storage(variants_vec_rgb):
+    import numpy as np
+
+    # Accumulate a known image into a single precision block
+    rng = np.random.default_rng(seed=0)
+    data = rng.uniform(size=(3, 4, 5)).astype(np.float32)
+
+    source = mi.ImageBlock([4, 3], [0, 0], 5)
+    idx = dr.arange(mi.UInt32, 12)
+    pos = mi.Point2f(mi.Float(idx % 4) + 0.5, mi.Float(idx // 4) + 0.5)
+    source.put(pos, [mi.Float(np.ascontiguousarray(data[..., k].ravel()))
+                     for k in range(5)])
+
+    target = mi.ImageBlock([4, 3], [0, 0], 5)
+    target.set_half_precision(True)
+    assert target.half_precision()
+
+    # Direct sample accumulation must go through a single precision block
+    with pytest.raises(RuntimeError, match='put_block'):
+        target.put([0.5, 0.5], [mi.Float(1)] * 5)
+    with pytest.raises(RuntimeError, match='half-precision'):
+        target.set_slot_count(4)
+
+    # A full-frame merge materializes within half precision tolerance
+    target.put_block(source)
+    result = np.array(target.tensor())
+    assert result.shape == (3, 4, 5)
+    assert dr.allclose(result, data, rtol=1e-3)
+
+    # Merging twice accumulates
+    target.put_block(source)
+    assert dr.allclose(np.array(target.tensor()), 2 * data, rtol=1e-3)
+
+    # clear() resets the packed representation
+    target.clear()
+    assert np.all(np.array(target.tensor()) == 0)
+
+    # Partial merges are rejected
+    small = mi.ImageBlock([2, 2], [0, 0], 5)
+    with pytest.raises(RuntimeError, match='exactly match'):
+        target.put_block(small)
+
+    # Incompatible with error-compensated accumulation
+    comp = mi.ImageBlock([4, 3], [0, 0], 5)
+    comp.set_compensate(True)
+    with pytest.raises(RuntimeError, match='compensated'):
+        comp.set_half_precision(True)
+
+
+def test11_atomic_put_block(variant_scalar_rgb):
+    import numpy as np
+
+    rng = np.random.default_rng(seed=0)
+    data = rng.random((3, 4, 2)).astype(np.float32)
+
+    source = mi.ImageBlock(mi.TensorXf(data), [1, 1])
+
+    # Atomic and plain merges must accumulate identically
+    target_ref = mi.ImageBlock([8, 8], [0, 0], 2)
+    target_ref.put_block(source)
+    target_ref.put_block(source)
+
+    target = mi.ImageBlock([8, 8], [0, 0], 2)
+    target.put_block(source, atomic=True)
+    target.put_block(source, atomic=True)
+
+    assert dr.allclose(np.array(target.tensor()),
+                       np.array(target_ref.tensor()))
@@ -1008,3 +1008,75 @@ def test24_texture_attributes(variants_all_rgb):
 
 
 
+
+
+@fresolver_append_path
+def test25_sample_position_cache(variants_all_rgb):
+    mesh = mi.load_dict({
+        'type': 'ply',
+        'filename': 'resources/data/tests/ply/rectangle_normals_uv.ply'
+    })
+
+    # The test rectangle lies in the XZ plane
+    ps = mesh.sample_position(0.0, [0.4, 0.6])
+    assert dr.allclose(ps.pdf, 1.0 / mesh.surface_area())
+    assert dr.allclose(ps.p.y, 0.0)
+    assert dr.allclose(dr.abs(ps.n.y), 1.0)
+
+    # Moving the vertices must invalidate the packed sampling cache
+    params = mi.traverse(mesh)
+    positions = dr.unravel(mi.Point3f, params['vertex_positions'])
+    params['vertex_positions'] = dr.ravel(positions + mi.Vector3f(0, 5, 0))
+    params.update()
+
+    ps = mesh.sample_position(0.0, [0.4, 0.6])
+    assert dr.allclose(ps.p.y, 5.0)
+
+
+@fresolver_append_path
+def test26_displacement(variants_all_rgb):
+    mesh = mi.load_dict({
+        'type': 'ply',
+        'filename': 'resources/data/tests/ply/rectangle_normals_uv.ply',
+        'displacement': 2.0,
+        'displacement_levels': 1
+    })
+
+    # One subdivision level: 2 -> 8 faces, 4 + 5 edge midpoints -> 9 vertices
+    assert mesh.face_count() == 8
+    assert mesh.vertex_count() == 9
+
+    # The rectangle lies in the XZ plane with +Y normals: a constant
+    # displacement of 2 must translate every vertex to y == 2
+    params = mi.traverse(mesh)
+    positions = dr.unravel(mi.Point3f, params['vertex_positions'])
+    assert dr.allclose(positions.y, 2.0)
+
+    # Recomputed shading normals still point along +Y
+    normals = dr.unravel(mi.Normal3f, params['vertex_normals'])
+    assert dr.allclose(normals.y, 1.0)
+
+
+@fresolver_append_path
+def test27_compress_attributes(variants_all_rgb):
+    mesh_dict = {
+        'type': 'ply',
+        'filename': 'resources/data/tests/ply/rectangle_normals_uv.ply',
+    }
+    scene_ref = mi.load_dict({'type': 'scene', 'mesh': dict(mesh_dict)})
+
+    mesh_dict['compress_attributes'] = True
+    scene = mi.load_dict({'type': 'scene', 'mesh': dict(mesh_dict)})
+
+    mesh = scene.shapes()[0]
+    assert mesh.has_vertex_normals()
+    assert mesh.has_vertex_texcoords()
+
+    # Normals and UVs decoded on the fly must match the uncompressed mesh
+    ray = mi.Ray3f([0, 2, -3], [0, -1, 0])
+    si_ref = scene_ref.ray_intersect(ray)
+    si = scene.ray_intersect(ray)
+
+    assert dr.allclose(si.t, si_ref.t, atol=1e-4)
+    assert dr.allclose(si.sh_frame.n, si_ref.sh_frame.n, atol=1e-3)
+    assert dr.allclose(si.uv, si_ref.uv, atol=1e-3)
@@ -193,3 +193,29 @@ def test09_circular(variant_scalar_rgb):
     # Light that is already circularly polarized is unchanged.
     dr.allclose(L @ Array4f([1, 0, 0, -1]), Array4f([0.5, 0, 0, -1]))
     dr.allclose(R @ Array4f([1, 0, 0, +1]), Array4f([0.5, 0, 0, +1]))
+
+
+def test10_rotate_mueller_basis_sparse(variant_scalar_rgb):
+    import numpy as np
+
+    # The sparse rotator expansion must agree with the dense matrix sandwich
+    w = [0, 0, 1]
+    b_in_c,  b_in_t  = [1, 0, 0], [0.70710678, 0.70710678, 0]
+    b_out_c, b_out_t = [0, 1, 0], [-0.70710678, 0.70710678, 0]
+
+    rng = np.random.default_rng(seed=0)
+    M = mi.Matrix4f(rng.uniform(-1, 1, (4, 4)))
+
+    R_in  = mi.mueller.rotate_stokes_basis(w, b_in_c, b_in_t)
+    R_out = mi.mueller.rotate_stokes_basis(w, b_out_c, b_out_t)
+    dense = R_out @ M @ dr.transpose(R_in)
+
+    sparse = mi.mueller.rotate_mueller_basis(M, w, b_in_c, b_in_t,
+                                             w, b_out_c, b_out_t)
+    assert dr.allclose(dense, sparse, atol=1e-6)
+
+    # Rotating a depolarizer leaves it unchanged
+    D = mi.mueller.depolarizer(0.7)
+    assert dr.allclose(D, mi.mueller.rotate_mueller_basis(D, w, b_in_c, b_in_t,
+                                                          w, b_out_c, b_out_t),
+                       atol=1e-6)
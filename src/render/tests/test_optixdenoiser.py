@@ -241,3 +241,20 @@ def test05_denoiser_denoise_multichannel_bitmap_runs(variant_cuda_ad_rgb):
     dr.eval(denoised)
 
     assert True
+
+def test06_denoiser_denoise_async(variant_cuda_ad_rgb):
+    scene = mi.load_file(find_resource("resources/data/scenes/cbox/cbox-rgb.xml"), res=64)
+    sensor = scene.sensors()[0]
+    mi.render(scene, spp=2, sensor=sensor)
+    noisy = sensor.film().bitmap()
+
+    denoiser = mi.OptixDenoiser(noisy.size())
+    reference = denoiser(noisy)
+
+    assert denoiser.wait() is None
+
+    denoiser.denoise_async(noisy)
+    # Rendering of the next frame would overlap with the denoise here
+    denoised = denoiser.wait()
+
+    assert dr.allclose(mi.TensorXf(denoised).array, mi.TensorXf(reference).array)
@@ -142,3 +142,26 @@ def test05_direction_sample_construction_vec(variants_vec_backends_once, np_rng)
     assert dr.allclose(records_batch.d, directions)
     assert dr.allclose(records_batch.pdf, pdfs)
 
+
+
+def test06_direction_sample_construction_ray(variant_scalar_rgb):
+    # The ray-based constructor must agree with the reference-based one when
+    # the reference point is the ray origin
+    shape = mi.load_dict({
+        'type': 'sphere',
+        'emitter': { 'type' : 'area' }
+    })
+    its = dr.zeros(mi.SurfaceInteraction3f)
+    its.p = [20, 3, 40.02]
+    its.t = dr.norm(mi.Point3f(20, 3, 40.02) - mi.Point3f(1.6, -2, 35))
+    its.shape = shape
+    ref = dr.zeros(mi.Interaction3f)
+    ref.p = [1.6, -2, 35]
+
+    ray = mi.Ray3f(ref.p, dr.normalize(its.p - ref.p))
+    rec_ray = mi.DirectionSample3f(None, its, ray)
+    rec_ref = mi.DirectionSample3f(None, its, ref)
+
+    assert dr.allclose(rec_ray.d, rec_ref.d)
+    assert dr.allclose(rec_ray.dist, rec_ref.dist)
+    assert dr.allclose(rec_ray.p, rec_ref.p)
@@ -246,3 +246,280 @@ def test09_test_emitter_sampling_weight_update(variants_all_backends_once):
     assert dr.allclose(scene.pdf_emitter(0), pdf[0])
     assert dr.allclose(scene.pdf_emitter(1), pdf[1])
     assert dr.allclose(scene.pdf_emitter(2), pdf[2])
+
+
+def test07_accel_build_quality(variants_all_rgb):
+    """The build quality knobs should be accepted (and validated) on scenes and shapes"""
+    for quality in ['low', 'medium', 'high']:
+        scene = mi.load_dict({
+            "type": "scene",
+            "accel_build_quality": quality,
+            "accel_dynamic": quality != 'high',
+            "sphere": { "type": "sphere", "build_quality": quality }
+        })
+        si = scene.ray_intersect(mi.Ray3f([0, 0, -5], [0, 0, 1]))
+        assert dr.all(si.is_valid())
+
+    with pytest.raises(RuntimeError, match='build quality'):
+        mi.load_dict({
+            "type": "scene",
+            "sphere": { "type": "sphere", "build_quality": "fastest" }
+        })
+
+
+def test08_stochastic_alpha_test(variant_scalar_rgb):
+    """Opacity-masked shapes should not occlude shadow rays when the
+       stochastic alpha test is enabled"""
+    if not mi.MI_ENABLE_EMBREE:
+        pytest.skip('Stochastic alpha testing requires Embree')
+
+    def make_scene(alpha_test, opacity):
+        return mi.load_dict({
+            "type": "scene",
+            "stochastic_alpha_test": alpha_test,
+            "rect": {
+                "type": "rectangle",
+                "bsdf": {
+                    "type": "mask",
+                    "opacity": opacity,
+                    "material": { "type": "diffuse" }
+                }
+            }
+        })
+
+    ray = mi.Ray3f([0, 0, -5], [0, 0, 1])
+
+    # Fully transparent: the hit is always rejected during traversal
+    assert not make_scene(True, 0.0).ray_test(ray)
+    # Fully opaque surfaces continue to occlude
+    assert make_scene(True, 1.0).ray_test(ray)
+    # Without the opt-in flag, masked geometry occludes as before
+    assert make_scene(False, 0.0).ray_test(ray)
+
+
+def test09_render_statistics(variant_scalar_rgb):
+    """Rendering should populate the event counter registry"""
+    scene_dict = mi.cornell_box()
+    scene_dict['sensor']['film']['width'] = 8
+    scene_dict['sensor']['film']['height'] = 8
+    scene = mi.load_dict(scene_dict)
+
+    mi.util.clear_render_statistics()
+    assert all(v == 0 for v in mi.util.render_statistics().values())
+
+    mi.render(scene, spp=1)
+
+    stats = mi.util.render_statistics()
+    # 8x8 pixels at 1 spp -> at least one camera ray per sample
+    assert stats['Rays traced'] >= 8 * 8
+    assert stats['BSDF samples'] > 0
+    assert stats['Emitter samples'] > 0
+    assert stats['Shadow rays traced'] > 0
+    assert 'Rays traced' in mi.util.render_statistics_report()
+
+
+def test10_accel_refit(variants_all_rgb):
+    """Moving an instance with BVH refitting enabled must update intersections"""
+    from mitsuba import ScalarTransform4f as T
+
+    scene = mi.load_dict({
+        "type": "scene",
+        "accel_refit": True,
+        "group_0": {
+            "type": "shapegroup",
+            "sphere": { "type": "sphere" }
+        },
+        "instance": {
+            "type": "instance",
+            "group": { "type": "ref", "id": "group_0" }
+        }
+    })
+
+    si = scene.ray_intersect(mi.Ray3f([0, 0, -5], [0, 0, 1]))
+    assert dr.all(si.is_valid())
+    assert dr.allclose(si.t, 4)
+
+    params = mi.traverse(scene)
+    params['instance.to_world'] = mi.Transform4f(T.translate([0, 0, 2]))
+    params.update()
+
+    si = scene.ray_intersect(mi.Ray3f([0, 0, -5], [0, 0, 1]))
+    assert dr.all(si.is_valid())
+    assert dr.allclose(si.t, 6)
+
+
+def test11_trace_timeline(variant_scalar_rgb):
+    """Timeline recording should produce valid chrome://tracing JSON"""
+    import json
+
+    scene_dict = mi.cornell_box()
+    scene_dict['sensor']['film']['width'] = 4
+    scene_dict['sensor']['film']['height'] = 4
+    scene = mi.load_dict(scene_dict)
+
+    mi.util.clear_trace()
+    mi.util.set_trace_enabled(True)
+    try:
+        mi.render(scene, spp=1)
+    finally:
+        mi.util.set_trace_enabled(False)
+
+    trace = json.loads(mi.util.trace_json())
+    events = trace['traceEvents']
+
+    names = set(ev['name'] for ev in events if ev['ph'] == 'X')
+    assert 'Integrator::render()' in names
+    assert 'Scene::ray_intersect()' in names
+
+    # Begin/end timestamps must nest correctly within each thread
+    for ev in events:
+        if ev['ph'] == 'X':
+            assert ev['dur'] >= 0
+
+    mi.util.clear_trace()
+    trace = json.loads(mi.util.trace_json())
+    assert all(ev['ph'] != 'X' for ev in trace['traceEvents'])
+
+
+def test12_render_batch(variants_all_rgb):
+    """Batch rendering must produce one valid image per sensor"""
+    import numpy as np
+
+    def make_sensor(origin):
+        return mi.load_dict({
+            'type': 'perspective',
+            'fov': 39.3077,
+            'to_world': mi.ScalarTransform4f.look_at(
+                origin=origin, target=[0, 0, 0], up=[0, 1, 0]),
+            'film': {
+                'type': 'hdrfilm',
+                'width': 16,
+                'height': 16,
+                'rfilter': {'type': 'box'},
+                'pixel_format': 'rgb'
+            },
+            'sampler': {'type': 'independent', 'sample_count': 32}
+        })
+
+    scene = mi.load_dict(mi.cornell_box())
+    integrator = scene.integrator()
+
+    sensor_a = make_sensor([0, 0, 3.9])
+    sensor_b = make_sensor([0.5, 0.5, 3.5])
+
+    imgs = integrator.render_batch(scene, [sensor_a, sensor_b], seed=0)
+    assert len(imgs) == 2
+
+    for img in imgs:
+        img = np.array(img)
+        assert img.shape == (16, 16, 3)
+        assert np.all(np.isfinite(img))
+        assert img.sum() > 0
+
+    # The two viewpoints must produce different images
+    assert not np.allclose(np.array(imgs[0]), np.array(imgs[1]))
+
+    # Batch rendering must agree with individual renders up to MC noise
+    for i, sensor in enumerate([sensor_a, sensor_b]):
+        ref = integrator.render(scene, sensor, seed=17 + i)
+        assert np.allclose(np.array(imgs[i]).mean(),
+                           np.array(ref).mean(), rtol=0.1)
+
+
+def test13_render_frozen(variants_all_rgb):
+    """Frozen rendering must match render() and track parameter updates"""
+    import numpy as np
+
+    scene_dict = mi.cornell_box()
+    scene_dict['sensor']['film']['width'] = 8
+    scene_dict['sensor']['film']['height'] = 8
+    scene = mi.load_dict(scene_dict)
+    integrator = scene.integrator()
+
+    ref = np.array(integrator.render(scene, seed=0, spp=4))
+    img = np.array(integrator.render_frozen(scene, seed=0, spp=4))
+
+    # Making parameters opaque must not alter the rendered image
+    assert np.allclose(img, ref)
+
+    # Parameter updates must be visible in subsequent frozen renders
+    params = mi.traverse(scene)
+    params['red.reflectance.value'] = mi.Color3f(0.1, 0.1, 0.8)
+    params.update()
+
+    img2 = np.array(integrator.render_frozen(scene, seed=0, spp=4))
+    assert not np.allclose(img2, img)
+
+
+def test14_light_tree(variants_all_rgb):
+    import numpy as np
+
+    def scalar(x):
+        return float(np.asarray(x).ravel()[0])
+
+    # Cornell box with additional point lights, using hierarchical sampling
+    scene_dict = mi.cornell_box()
+    scene_dict['light_tree'] = True
+    for i in range(4):
+        scene_dict[f'point_{i}'] = {
+            'type': 'point',
+            'position': [-0.45 + 0.3 * i, 0.0, 0.2],
+            'intensity': {'type': 'rgb', 'value': [0.2, 0.2, 0.2]}
+        }
+    scene = mi.load_dict(scene_dict)
+
+    n_emitters = len(scene.emitters())
+    assert n_emitters == 5
+
+    # Sampling weight and PMF are mutually consistent
+    p = mi.Point3f(0, 0, 0)
+    for u in [0.05, 0.3, 0.7, 0.95]:
+        index, weight, reused = scene.sample_emitter_tree(p, u)
+        pmf = scene.pdf_emitter_tree(p, index)
+        assert dr.allclose(weight, dr.rcp(pmf), rtol=1e-4)
+        assert dr.all((reused >= 0) & (reused < 1))
+
+    # The selection PMF is normalized and every emitter is reachable
+    total = 0.0
+    for i in range(n_emitters):
+        pmf_i = scalar(scene.pdf_emitter_tree(p, mi.UInt32(i)))
+        assert pmf_i > 0
+        total += pmf_i
+    assert dr.allclose(total, 1.0, rtol=1e-4)
+
+    # Consistency over a whole wavefront of samples
+    if dr.is_jit_v(mi.Float):
+        u = mi.Float(np.random.default_rng(0).uniform(size=1024))
+        index, weight, _ = scene.sample_emitter_tree(p, u)
+        pmf = scene.pdf_emitter_tree(p, index)
+        assert dr.allclose(weight * pmf, 1.0, rtol=1e-4)
+
+    # End-to-end: light tree NEE agrees with uniform emitter sampling
+    def render(use_tree):
+        d = mi.cornell_box()
+        d['light_tree'] = use_tree
+        d['sensor']['film']['width'] = 16
+        d['sensor']['film']['height'] = 16
+        return np.array(mi.render(mi.load_dict(d), seed=0, spp=128))
+
+    uniform = render(False)
+    tree = render(True)
+    assert np.allclose(uniform.mean(), tree.mean(), rtol=0.05)
+
+
+def test15_minimal_ray_flags(variants_all_rgb):
+    # A purely diffuse scene does not need position partials
+    scene = mi.load_dict(mi.cornell_box())
+    flags = scene.minimal_ray_flags()
+    assert flags & mi.RayFlags.UV
+    assert flags & mi.RayFlags.ShadingFrame
+    assert not (flags & mi.RayFlags.dPdUV)
+
+    # Anisotropic materials depend on the UV tangent directions
+    d = mi.cornell_box()
+    d['white']['type'] = 'roughconductor'
+    del d['white']['reflectance']
+    d['white']['alpha_u'] = 0.1
+    d['white']['alpha_v'] = 0.3
+    scene = mi.load_dict(d)
+    assert scene.minimal_ray_flags() & mi.RayFlags.dPdUV
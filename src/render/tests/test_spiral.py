@@ -77,3 +77,51 @@ def test03_normal_film(variant_scalar_rgb):
     # Resetting and re-querying the blocks should yield the exact same results.
     s.reset()
     check_first_blocks(extract_blocks(s), expected, n_total=110)
+
+
+def test04_scheduler_coverage(variant_scalar_rgb):
+    f = make_film()
+    n_workers = 4
+    sched = mi.BlockScheduler(f.size(), f.crop_offset(),
+                              worker_count=n_workers)
+
+    # Drain the scheduler from alternating workers so that some of them
+    # run dry and have to steal (and split) blocks of the others
+    fragments = []
+    active = list(range(n_workers))
+    while active:
+        w = active[len(fragments) % len(active)]
+        b = sched.next_block(w)
+        if b is None:
+            active.remove(w)
+        else:
+            fragments.append(b)
+
+    # Every scanline of every block must be handed out exactly once
+    rows = {}
+    for (bo, bs, bi, r0, r1) in fragments:
+        assert 0 <= r0 < r1 <= bs[1]
+        key = (bi, tuple(bo))
+        rows.setdefault(key, []).extend(range(r0, r1))
+
+    assert len(rows) == sched.block_count()
+    n_rows = 0
+    for (_, bo), r in rows.items():
+        assert sorted(r) == list(range(min(r), max(r) + 1))
+        n_rows += len(r)
+    assert n_rows == sched.row_count()
+
+
+def test05_scheduler_matches_spiral(variant_scalar_rgb):
+    # With a single worker, blocks come out whole and in spiral order
+    f = make_film(318, 322)
+    spiral = mi.Spiral(f.size(), f.crop_offset())
+    sched = mi.BlockScheduler(f.size(), f.crop_offset())
+    assert sched.block_count() == 110
+
+    for (bo, bs, bi) in extract_blocks(spiral):
+        b = sched.next_block(0)
+        assert b is not None
+        assert dr.all(b[0] == bo) and dr.all(b[1] == bs) and b[2] == bi
+        assert b[3] == 0 and b[4] == bs[1]
+    assert sched.next_block(0) is None
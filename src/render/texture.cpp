@@ -20,6 +20,14 @@ Texture<Float, Spectrum>::eval(const SurfaceInteraction3f &, Mask) const {
     NotImplementedError("eval");
 }
 
+MI_VARIANT void
+Texture<Float, Spectrum>::eval_batch(const SurfaceInteraction3f *si,
+                                     UnpolarizedSpectrum *out, size_t count,
+                                     Mask active) const {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = eval(si[i], active);
+}
+
 MI_VARIANT std::pair<typename Texture<Float, Spectrum>::Wavelength,
                       typename Texture<Float, Spectrum>::UnpolarizedSpectrum>
 Texture<Float, Spectrum>::sample_spectrum(const SurfaceInteraction3f &,
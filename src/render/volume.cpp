@@ -48,6 +48,16 @@ Volume<Float, Spectrum>::eval_gradient(const Interaction3f & /*it*/, Mask /*acti
     NotImplementedError("eval_gradient");
 }
 
+MI_VARIANT typename Volume<Float, Spectrum>::UnpolarizedSpectrum
+Volume<Float, Spectrum>::eval_lod(const Interaction3f &it, uint32_t /*level*/,
+                                  Mask active) const {
+    return eval(it, active);
+}
+
+MI_VARIANT uint32_t Volume<Float, Spectrum>::mip_level_count() const {
+    return 1;
+}
+
 MI_VARIANT typename Volume<Float, Spectrum>::ScalarFloat
 Volume<Float, Spectrum>::max() const { NotImplementedError("max"); }
 
@@ -56,6 +66,14 @@ Volume<Float, Spectrum>::max_per_channel(ScalarFloat * /*out*/) const {
     NotImplementedError("max_per_channel");
 }
 
+MI_VARIANT void
+Volume<Float, Spectrum>::max_per_cell(const ScalarVector3u &res,
+                                      ScalarFloat *out) const {
+    ScalarFloat m = max();
+    for (size_t i = 0, n = (size_t) dr::prod(res); i < n; ++i)
+        out[i] = m;
+}
+
 MI_VARIANT typename Volume<Float, Spectrum>::ScalarVector3i
 Volume<Float, Spectrum>::resolution() const {
     return ScalarVector3i(1, 1, 1);
@@ -3,6 +3,7 @@
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/util.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -11,8 +12,92 @@ VolumeGrid<Float, Spectrum>::VolumeGrid(Stream *stream) { read(stream); }
 
 MI_VARIANT
 VolumeGrid<Float, Spectrum>::VolumeGrid(const fs::path &filename) {
-    ref<FileStream> fs = new FileStream(filename);
-    read(fs);
+    if (!read_mmap(filename)) {
+        ref<FileStream> fs = new FileStream(filename);
+        read(fs);
+    }
+}
+
+MI_VARIANT
+VolumeGrid<Float, Spectrum>::~VolumeGrid() {
+    // The voxel data of memory-mapped grids is owned by the mapping
+    if (m_mmap)
+        m_data.release();
+}
+
+MI_VARIANT
+bool VolumeGrid<Float, Spectrum>::read_mmap(const fs::path &filename) {
+    /* The in-place fast path requires that the file layout (little-endian
+       Float32 voxels) matches the in-memory representation; otherwise, fall
+       back to the converting Stream-based loader. */
+    if constexpr (!std::is_same<ScalarFloat, float>::value) {
+        (void) filename;
+        return false;
+    } else {
+        if (Stream::host_byte_order() != Stream::EByteOrder::ELittleEndian)
+            return false;
+
+        ref<MemoryMappedFile> mmap = new MemoryMappedFile(filename);
+
+        const size_t header_size = 48;
+        if (mmap->size() < header_size)
+            Throw("Invalid volume file \"%s\": too small to contain a "
+                  "header!", filename);
+
+        const uint8_t *ptr = (const uint8_t *) mmap->data();
+        if (ptr[0] != 'V' || ptr[1] != 'O' || ptr[2] != 'L')
+            Throw("Invalid volume file!");
+
+        if (ptr[3] != 3)
+            Throw("Invalid version, currently only version 3 is supported "
+                  "(found %d)", (int) ptr[3]);
+
+        int32_t fields[5]; // data type, resolution (x, y, z), channel count
+        memcpy(fields, ptr + 4, sizeof(fields));
+
+        if (fields[0] != 1)
+            Throw("Wrong type, currently only type == 1 (Float32) data is "
+                  "supported (found type = %d)", fields[0]);
+
+        m_size.x() = uint32_t(fields[1]);
+        m_size.y() = uint32_t(fields[2]);
+        m_size.z() = uint32_t(fields[3]);
+        m_channel_count = fields[4];
+
+        // Transform specified in the volume file
+        float dims[6];
+        memcpy(dims, ptr + 24, sizeof(dims));
+        m_bbox = ScalarBoundingBox3f(ScalarPoint3f(dims[0], dims[1], dims[2]),
+                                     ScalarPoint3f(dims[3], dims[4], dims[5]));
+
+        size_t count = dr::prod(m_size) * (size_t) m_channel_count;
+        if (mmap->size() < header_size + count * sizeof(float))
+            Throw("Invalid volume file \"%s\": file too small to contain "
+                  "the specified %zu voxel entries!", filename, count);
+
+        /* Alias the voxel data in place. The mapping (kept alive via
+           'm_mmap') owns the storage; the destructor releases 'm_data'
+           without deallocating. */
+        const float *data = (const float *) (ptr + header_size);
+        m_data = std::unique_ptr<ScalarFloat[]>(
+            const_cast<ScalarFloat *>(data));
+        m_mmap = std::move(mmap);
+
+        // Single sequential pass over the mapped data for the majorants
+        m_max = -dr::Infinity<ScalarFloat>;
+        m_max_per_channel.assign(m_channel_count,
+                                 -dr::Infinity<ScalarFloat>);
+        for (size_t i = 0; i < count; ++i) {
+            ScalarFloat val = data[i];
+            m_max = dr::maximum(m_max, val);
+            m_max_per_channel[i % m_channel_count] =
+                dr::maximum(m_max_per_channel[i % m_channel_count], val);
+        }
+
+        Log(Debug, "Mapped grid volume data from file: dimensions %s, max "
+            "value %f", m_size, m_max);
+        return true;
+    }
 }
 
 MI_VARIANT
@@ -66,16 +151,30 @@ void VolumeGrid<Float, Spectrum>::read(Stream *stream) {
     m_max = -dr::Infinity<ScalarFloat>;
     m_max_per_channel.resize(m_channel_count, -dr::Infinity<ScalarFloat>);
 
-    m_data = std::unique_ptr<ScalarFloat[]>(new ScalarFloat[size * m_channel_count]);
+    size_t count = size * m_channel_count;
+    m_data = std::unique_ptr<ScalarFloat[]>(new ScalarFloat[count]);
+
+    if constexpr (std::is_same<ScalarFloat, float>::value) {
+        // Fetch the entire payload with a single bulk read
+        stream->read_array(m_data.get(), count);
+    } else {
+        // Need to convert data from single precision after reading from disk
+        constexpr size_t chunk = 1024 * 1024;
+        std::unique_ptr<float[]> buf(new float[std::min(count, chunk)]);
+        for (size_t offset = 0; offset < count; offset += chunk) {
+            size_t n = std::min(chunk, count - offset);
+            stream->read_array(buf.get(), n);
+            for (size_t i = 0; i < n; ++i)
+                m_data[offset + i] = ScalarFloat(buf[i]);
+        }
+    }
+
     size_t k = 0;
     for (size_t i = 0; i < size; ++i) {
         for (size_t j = 0; j < m_channel_count; ++j) {
-            float val;
-            stream->read(val);
-            m_data[k] = val;
+            ScalarFloat val = m_data[k++];
             m_max     = dr::maximum(m_max, val);
             m_max_per_channel[j] = dr::maximum(m_max_per_channel[j], val);
-            ++k;
         }
     }
     Log(Debug, "Loaded grid volume data from file: dimensions %s, max value %f",
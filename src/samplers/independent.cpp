@@ -1,5 +1,7 @@
+#include <drjit/packet.h>
 #include <mitsuba/core/profiler.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/random.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/render/sampler.h>
 
@@ -72,6 +74,16 @@ public:
                    schedule_state)
     MI_IMPORT_TYPES()
 
+    /// Number of PCG32 streams advanced in lockstep when refilling the cache
+    static constexpr uint32_t BatchSize = 8;
+
+    /// Number of dimensions generated per cache refill in scalar mode
+    static constexpr uint32_t CacheSize = 64;
+
+    using UInt32P = dr::Packet<uint32_t, BatchSize>;
+    using FloatP  = dr::Packet<ScalarFloat, BatchSize>;
+    using PCG32P  = mitsuba::PCG32<UInt32P>;
+
     IndependentSampler(const Properties &props) : Base(props) { }
 
     ref<Sampler<Float, Spectrum>> fork() override {
@@ -85,9 +97,49 @@ public:
         return new IndependentSampler(*this);
     }
 
+    void seed(uint32_t seed, uint32_t wavefront_size = (uint32_t) -1) override {
+        Base::seed(seed, wavefront_size);
+
+        if constexpr (!dr::is_array_v<Float>) {
+            /* Derive a set of decorrelated PCG32 streams that are advanced
+               in lockstep to refill the dimension cache (see next_1d()). As
+               in the vectorized seeding path of PCG32Sampler::seed(), the
+               stream indices are scrambled using the Tiny Encryption
+               Algorithm. */
+            mitsuba::PCG32<uint32_t> lane_rng;
+            for (uint32_t i = 0; i < BatchSize; ++i) {
+                auto [v0, v1] = sample_tea_32(m_base_seed + seed, i);
+                lane_rng.seed(1, v0, v1);
+                m_batch_rng.state.entry(i) = lane_rng.state;
+                m_batch_rng.inc.entry(i)   = lane_rng.inc;
+            }
+
+            m_cache_pos = CacheSize;
+        }
+    }
+
     Float next_1d(Mask active = true) override {
         Assert(seeded());
-        return m_rng.template next_float<Float>(active);
+
+        if constexpr (!dr::is_array_v<Float>) {
+            DRJIT_MARK_USED(active);
+
+            /* In scalar mode, the per-call overhead of generating a single
+               variate dwarfs the actual RNG math. Generate 'CacheSize'
+               dimensions at once by advancing 'BatchSize' PCG32 streams in
+               lockstep using packet arithmetic; subsequent calls then reduce
+               to an array read. */
+            if (unlikely(m_cache_pos == CacheSize)) {
+                for (uint32_t i = 0; i < CacheSize; i += BatchSize)
+                    dr::store(m_cache + i,
+                              m_batch_rng.template next_float<FloatP>());
+                m_cache_pos = 0;
+            }
+
+            return m_cache[m_cache_pos++];
+        } else {
+            return m_rng.template next_float<Float>(active);
+        }
     }
 
     Point2f next_2d(Mask active = true) override {
@@ -110,7 +162,20 @@ public:
     MI_DECLARE_CLASS()
 
 private:
-    IndependentSampler(const IndependentSampler &sampler) : Base(sampler) {}
+    IndependentSampler(const IndependentSampler &sampler) : Base(sampler) {
+        m_batch_rng = sampler.m_batch_rng;
+        m_cache_pos = sampler.m_cache_pos;
+        for (uint32_t i = 0; i < CacheSize; ++i)
+            m_cache[i] = sampler.m_cache[i];
+    }
+
+private:
+    /// Batched RNG streams backing the dimension cache (scalar mode only)
+    PCG32P m_batch_rng;
+
+    /// Precomputed dimensions and read position within them
+    ScalarFloat m_cache[CacheSize];
+    uint32_t m_cache_pos = CacheSize;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(IndependentSampler, Sampler)
@@ -27,6 +27,14 @@ shuffle network. The name of this plugin stems from the fact that, by constructi
 `star discrepancy <https://en.wikipedia.org/wiki/Low-discrepancy_sequence>`_,
 which is a quality criterion on their spatial distribution.
 
+Setting the :monosp:`blue_noise` parameter to :monosp:`true` additionally
+dithers the sample sequences over the image plane with a tileable blue-noise
+mask following the approach of Georgiev and Fajardo :cite:`Georgiev2016Blue`:
+all pixels then share a single point set that is decorrelated by per-pixel
+toroidal shifts drawn from the mask. This does not reduce the error in any
+single pixel, but redistributes it as high-frequency noise across the image,
+which is perceptually much less objectionable at preview sample counts.
+
 .. subfigstart::
 .. subfigure:: ../../resources/data/docs/images/render/sampler_independent_16spp.jpg
    :caption: Independent sampler - 16 samples per pixel
@@ -74,9 +82,9 @@ which is a quality criterion on their spatial distribution.
 template <typename Float, typename Spectrum>
 class LowDiscrepancySampler  final : public Sampler<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(Sampler, m_sample_count, m_base_seed, seeded,
+    MI_IMPORT_BASE(Sampler, m_sample_count, m_base_seed, m_blue_noise, seeded,
                     m_samples_per_wavefront, m_dimension_index,
-                    current_sample_index, compute_per_sequence_seed)
+                    current_sample_index, compute_per_sequence_seed, dither)
     MI_IMPORT_TYPES()
 
     LowDiscrepancySampler (const Properties &props) : Base(props) {
@@ -100,6 +108,7 @@ public:
         sampler->m_sample_count          = m_sample_count;
         sampler->m_samples_per_wavefront = m_samples_per_wavefront;
         sampler->m_base_seed             = m_base_seed;
+        sampler->m_blue_noise            = m_blue_noise;
         return sampler;
     }
 
@@ -110,6 +119,12 @@ public:
     void seed(uint32_t seed, uint32_t wavefront_size) override {
         Base::seed(seed, wavefront_size);
         m_scramble_seed = compute_per_sequence_seed(seed);
+
+        /* The scramble values only depend on the per-sequence seed -- derive
+           them once here instead of in every next_1d()/next_2d() call */
+        m_scramble_1d = sample_tea_32(m_scramble_seed, UInt32(0x48bc48eb)).first;
+        std::tie(m_scramble_2d_x, m_scramble_2d_y) =
+            sample_tea_32(m_scramble_seed, UInt32(0x98bc51ab));
     }
 
     Float next_1d(Mask /*active*/ = true) override {
@@ -121,10 +136,7 @@ public:
         // Shuffle the samples order
         UInt32 i = permute(sample_indices, m_sample_count, perm_seed);
 
-        // Compute scramble value (unique per sequence)
-        UInt32 scramble = sample_tea_32(m_scramble_seed, UInt32(0x48bc48eb)).first;
-
-        return radical_inverse_2(i, scramble);
+        return dither(radical_inverse_2(i, m_scramble_1d));
     }
 
     Point2f next_2d(Mask /*active*/ = true) override {
@@ -136,19 +148,16 @@ public:
         // Shuffle the samples order
         UInt32 i = permute(sample_indices, m_sample_count, perm_seed);
 
-        // Compute scramble values (unique per sequence) for both axis
-        auto [scramble_x, scramble_y] =
-            sample_tea_32(m_scramble_seed, UInt32(0x98bc51ab));
-
-        Float x = radical_inverse_2(i, scramble_x),
-              y = sobol_2(i, scramble_y);
+        Float x = radical_inverse_2(i, m_scramble_2d_x),
+              y = sobol_2(i, m_scramble_2d_y);
 
-        return Point2f(x, y);
+        return dither(Point2f(x, y));
     }
 
     void schedule_state() override {
         Base::schedule_state();
-        dr::schedule(m_scramble_seed);
+        dr::schedule(m_scramble_seed, m_scramble_1d,
+                     m_scramble_2d_x, m_scramble_2d_y);
     }
 
     std::string to_string() const override {
@@ -164,10 +173,16 @@ public:
 private:
     LowDiscrepancySampler(const LowDiscrepancySampler &sampler) : Base(sampler) {
         m_scramble_seed = sampler.m_scramble_seed;
+        m_scramble_1d   = sampler.m_scramble_1d;
+        m_scramble_2d_x = sampler.m_scramble_2d_x;
+        m_scramble_2d_y = sampler.m_scramble_2d_y;
     }
 
     /// Per-sequence scramble seed
     UInt32 m_scramble_seed;
+
+    /// Scramble values derived from \ref m_scramble_seed at seed time
+    UInt32 m_scramble_1d, m_scramble_2d_x, m_scramble_2d_y;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(LowDiscrepancySampler , Sampler)
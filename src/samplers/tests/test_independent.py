@@ -20,11 +20,23 @@ def test02_sample_vs_pcg32(variant_scalar_rgb):
     })
     sampler.seed(0)
 
-    # IndependentSampler uses the default-constructed PCG if no seed is provided.
-    rng = dr.scalar.PCG32(initstate=0)
+    # In scalar mode, the sampler interleaves the output of eight
+    # TEA-scrambled PCG32 streams advanced in lockstep (see
+    # IndependentSampler::next_1d)
+    rngs = []
+    for lane in range(8):
+        v0, v1 = mi.sample_tea_32(0, lane)
+        rngs.append(dr.scalar.PCG32(initstate=v0, initseq=v1))
+
+    ref = []
+    while len(ref) < 30:
+        ref += [rng.next_float32() for rng in rngs]
+
+    pos = 0
     for i in range(10):
-        assert dr.all(sampler.next_1d() == rng.next_float32())
-        assert dr.all(sampler.next_2d() == [rng.next_float32(), rng.next_float32()])
+        assert sampler.next_1d() == ref[pos]
+        assert dr.all(sampler.next_2d() == [ref[pos + 1], ref[pos + 2]])
+        pos += 3
 
 
 def test03_copy_sampler_scalar(variants_any_scalar):
@@ -0,0 +1,116 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+from .utils import ( check_uniform_scalar_sampler, check_uniform_wavefront_sampler,
+                     check_deep_copy_sampler_scalar, check_deep_copy_sampler_wavefront )
+
+def test01_sobol_scalar(variant_scalar_rgb):
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 1024,
+    })
+    sampler.seed(0)
+
+    check_uniform_scalar_sampler(sampler)
+
+
+def test02_sobol_wavefront(variants_vec_backends_once):
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 1024,
+    })
+    sampler.seed(0, 1024)
+
+    check_uniform_wavefront_sampler(sampler)
+
+
+def test03_sobol_sample_count_rounding(variant_scalar_rgb):
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 24,
+    })
+
+    # Rounded up to the next power of two
+    assert sampler.sample_count() == 32
+
+
+def test04_sobol_stratification(variant_scalar_rgb):
+    """
+    With Owen scrambling, any power-of-two prefix of a base-2 sequence
+    dimension remains stratified: each of the first n samples must land
+    in a different interval of width 1/n.
+    """
+    import numpy as np
+
+    n = 64
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : n,
+    })
+    sampler.seed(0)
+
+    samples_1d = np.zeros(n)
+    samples_2d = np.zeros((n, 2))
+    for i in range(n):
+        samples_1d[i] = sampler.next_1d()
+        samples_2d[i] = sampler.next_2d()
+        sampler.advance()
+
+    assert len(np.unique((samples_1d * n).astype(int))) == n
+    assert len(np.unique((samples_2d[:, 0] * n).astype(int))) == n
+    assert len(np.unique((samples_2d[:, 1] * n).astype(int))) == n
+
+
+def test05_blue_noise_dithering(variant_scalar_rgb):
+    """
+    In blue-noise mode, all pixels draw from a single shared point set that
+    is decorrelated by per-pixel toroidal shifts: the samples of any two
+    pixels must differ by a constant offset modulo 1.
+    """
+    import numpy as np
+
+    def collect(sampler, pos):
+        sampler.seed(0)
+        sampler.set_pixel_position(pos)
+        return np.array([sampler.next_1d() for _ in range(10)])
+
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 16,
+        "blue_noise" : True,
+    })
+
+    a = collect(sampler, [3, 5])
+    b = collect(sampler, [200, 131])
+
+    assert np.all((a >= 0) & (a < 1))
+    assert not np.allclose(a, b)
+
+    # Same point set up to a per-pixel toroidal shift
+    shift = (a - b) % 1.0
+    dist = np.abs(shift - shift[0])
+    assert np.all(np.minimum(dist, 1 - dist) < 1e-5)
+
+    # Re-supplying the same pixel position reproduces the samples
+    assert np.allclose(collect(sampler, [3, 5]), a)
+
+
+def test06_copy_sampler_scalar(variants_any_scalar):
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 1024,
+    })
+    sampler.seed(0)
+
+    check_deep_copy_sampler_scalar(sampler)
+
+
+def test07_copy_sampler_wavefront(variants_vec_backends_once):
+    sampler = mi.load_dict({
+        "type" : "sobol",
+        "sample_count" : 1024,
+    })
+    sampler.seed(0, 1024)
+
+    check_deep_copy_sampler_wavefront(sampler)
@@ -2,6 +2,7 @@
 #include <mitsuba/core/bsphere.h>
 #include <mitsuba/core/math.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/warp.h>
 #include <mitsuba/render/scene.h>
@@ -34,6 +35,13 @@ Distant radiancemeter sensor (:monosp:`distant`)
    - Alternative (and exclusive) to ``to_world``. Direction orienting the
      sensor's reference hemisphere.
 
+ * - directions
+   - |string|
+   - Comma-separated list of world-space measurement directions (``x, y, z``
+     triplets). When specified, the sensor records one measurement per film
+     pixel column, rendering an entire directional capture session in a
+     single pass instead of one render per direction.
+
  * - target
    - |point| or nested :paramtype:`shape` plugin
    - *Optional.* Define the ray target sampling strategy.
@@ -60,6 +68,12 @@ over the targeted geometry.
 
 Ray origins are positioned outside of the scene's geometry.
 
+When many directions must be measured (e.g. BRDF or illumination capture),
+the :monosp:`directions` parameter maps each measurement to a film pixel,
+which amortizes kernel launches, scene traversal warm-up and film develop
+across the whole batch. In this mode, the film must have a resolution of
+N by 1 pixels, where N is the number of directions.
+
 .. warning::
 
    If this sensor is used with a targeting strategy leading to rays not hitting
@@ -93,6 +107,7 @@ public:
         }
 
         props.mark_queried("direction");
+        props.mark_queried("directions");
         props.mark_queried("to_world");
         props.mark_queried("target");
     }
@@ -140,9 +155,55 @@ public:
     MI_IMPORT_TYPES(Scene, Shape)
 
     DistantSensorImpl(const Properties &props) : Base(props) {
+        // Parse measurement direction batch, if present
+        if (props.has_property("directions")) {
+            if (props.has_property("direction") || props.has_property("to_world"))
+                Throw("Only one of the parameters 'directions', 'direction' "
+                      "and 'to_world' can be specified at the same time!'");
+
+            std::vector<std::string> directions_str =
+                string::tokenize(props.string("directions"), " ,");
+
+            if (directions_str.size() == 0 || directions_str.size() % 3 != 0)
+                Throw("DistantSensor: 'directions' parameter must contain a "
+                      "nonzero number of 'x, y, z' triplets!");
+
+            m_measurement_count = (uint32_t) (directions_str.size() / 3);
+
+            std::vector<ScalarFloat> directions;
+            directions.reserve(directions_str.size());
+            for (size_t i = 0; i < directions_str.size(); ++i) {
+                try {
+                    directions.push_back(
+                        string::stof<ScalarFloat>(directions_str[i]));
+                } catch (...) {
+                    Throw("Could not parse floating point value '%s'",
+                          directions_str[i]);
+                }
+            }
+
+            // Normalize measurement directions
+            for (size_t i = 0; i < directions.size(); i += 3) {
+                ScalarVector3f d(directions[i], directions[i + 1],
+                                 directions[i + 2]);
+                d = dr::normalize(d);
+                directions[i] = d.x(); directions[i + 1] = d.y();
+                directions[i + 2] = d.z();
+            }
+
+            m_directions =
+                dr::load<FloatStorage>(directions.data(), directions.size());
+        }
+
         // Check film size
-        if (m_film->size() != ScalarPoint2i(1, 1))
+        if (m_measurement_count > 0) {
+            if (m_film->size() != ScalarPoint2i((int) m_measurement_count, 1))
+                Throw("In measurement batch mode, the film size (currently "
+                      "%s) must match the number of measurements (%ux1)!",
+                      m_film->size(), m_measurement_count);
+        } else if (m_film->size() != ScalarPoint2i(1, 1)) {
             Throw("This sensor only supports films of size 1x1 Pixels!");
+        }
 
         // Check reconstruction filter radius
         if (m_film->rfilter()->radius() >
@@ -191,7 +252,7 @@ public:
 
     std::pair<Ray3f, Spectrum>
     sample_ray(Float time, Float wavelength_sample,
-                    const Point2f & /*film_sample*/,
+                    const Point2f &film_sample,
                     const Point2f &aperture_sample, Mask active) const override {
         MI_MASK_ARGUMENT(active);
 
@@ -209,7 +270,15 @@ public:
         Spectrum ray_weight = 0.f;
 
         // Set ray direction
-        ray.d = m_to_world.value().transform_affine(Vector3f{ 0.f, 0.f, 1.f });
+        if (m_measurement_count > 0) {
+            // The horizontal film position selects the measurement record
+            UInt32 index = dr::minimum(
+                UInt32(film_sample.x() * (ScalarFloat) m_measurement_count),
+                m_measurement_count - 1);
+            ray.d = dr::gather<Vector3f>(m_directions, index);
+        } else {
+            ray.d = m_to_world.value().transform_affine(Vector3f{ 0.f, 0.f, 1.f });
+        }
 
         // Sample target point and position ray origin
         if constexpr (TargetType == RayTargetType::Point) {
@@ -276,9 +345,15 @@ public:
     MI_DECLARE_CLASS()
 
 protected:
+    using FloatStorage = DynamicBuffer<Float>;
+
     ScalarBoundingSphere3f m_bsphere;
     ref<Shape> m_target_shape;
     Point3f m_target_point;
+
+    /// Measurement batch (empty unless 'directions' was specified)
+    FloatStorage m_directions;
+    uint32_t m_measurement_count = 0;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(DistantSensor, Sensor)
@@ -0,0 +1,159 @@
+#include <mitsuba/core/fwd.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/transform.h>
+#include <mitsuba/core/warp.h>
+#include <mitsuba/render/fwd.h>
+#include <mitsuba/render/sensor.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _sensor-lightmap:
+
+Lightmap baking sensor (:monosp:`lightmap`)
+-------------------------------------------
+
+.. pluginparameters::
+
+ * - flip_v
+   - |bool|
+   - Flip the vertical film axis so that the first image row corresponds to
+     :monosp:`v=1`. Most texturing conventions place the UV origin at the
+     bottom-left corner, whereas films place pixel :monosp:`(0, 0)` at the
+     top-left corner. (Default: |true|)
+
+ * - srf
+   - |spectrum|
+   - Sensor Response Function that defines the :ref:`spectral sensitivity <explanation_srf_sensor>`
+     of the sensor (Default: :monosp:`none`)
+
+This sensor bakes a lightmap for the shape that it is attached to: every film
+pixel is interpreted as a texel in the shape's UV parameterization. For each
+sample, the sensor maps the texel's UV coordinates onto the surface (using the
+mesh's texture coordinates) and emits a cosine-weighted ray over the
+hemisphere around the shading normal, so that the film accumulates the
+irradiance arriving at each texel. An entire lightmap is thus baked in a
+single rendering pass instead of launching one tiny render per texel with an
+:ref:`irradiance meter <sensor-irradiancemeter>`.
+
+Texels that do not map to any UV chart of the shape produce rays with zero
+associated importance and remain black in the output image. The sensor should
+be used with a reconstruction filter of radius 0.5 or lower (e.g. the default
+:monosp:`box` filter), since wider filters bleed energy across chart
+boundaries.
+
+This sensor is not instantiated on its own but must be defined as a child
+object of a shape with a UV parameterization (e.g. a mesh with texture
+coordinates):
+
+.. tabs::
+    .. code-tab:: xml
+        :name: lightmap-sensor
+
+        <shape type="obj">
+            <string name="filename" value="scene.obj"/>
+            <sensor type="lightmap">
+                <!-- film resolution = lightmap resolution -->
+            </sensor>
+        </shape>
+
+    .. code-tab:: python
+
+        'type': 'obj',
+        'filename': 'scene.obj',
+        'sensor': {
+            'type': 'lightmap',
+            'film': {
+                'type': 'hdrfilm',
+                'width': 1024,
+                'height': 1024,
+                'rfilter': {'type': 'box'}
+            }
+        }
+*/
+
+MI_VARIANT class LightmapSensor final : public Sensor<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(Sensor, m_film, m_shape, sample_wavelengths)
+    MI_IMPORT_TYPES(Shape)
+
+    LightmapSensor(const Properties &props) : Base(props) {
+        if (props.has_property("to_world"))
+            Throw("Found a 'to_world' transformation -- this is not allowed. "
+                  "The lightmap sensor inherits this transformation from its parent "
+                  "shape.");
+
+        m_flip_v = props.get<bool>("flip_v", true);
+
+        if (m_film->rfilter()->radius() > .5f + math::RayEpsilon<Float>)
+            Log(Warn, "This sensor should only be used with a reconstruction filter"
+               "of radius 0.5 or lower (e.g. default 'box' filter)");
+    }
+
+    std::pair<RayDifferential3f, Spectrum>
+    sample_ray_differential(Float time, Float wavelength_sample,
+                            const Point2f & sample2,
+                            const Point2f & sample3,
+                            Mask active) const override {
+
+        MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleRay, active);
+
+        // 1. Map the film position onto the surface via the UV parameterization
+        Point2f uv(sample2.x(),
+                   m_flip_v ? 1.f - sample2.y() : sample2.y());
+
+        SurfaceInteraction3f si =
+            m_shape->eval_parameterization(uv, +RayFlags::All, active);
+
+        // Texels outside of all UV charts carry no importance
+        active &= si.is_valid();
+
+        // 2. Sample directional component
+        Vector3f local = warp::square_to_cosine_hemisphere(sample3);
+
+        // 3. Sample spectrum
+        auto [wavelengths, wav_weight] =
+            sample_wavelengths(dr::zeros<SurfaceInteraction3f>(),
+                               wavelength_sample,
+                               active);
+
+        Vector3f d = si.to_world(local);
+        Point3f o = si.p + d * math::RayEpsilon<Float>;
+
+        return {
+            RayDifferential3f(o, d, time, wavelengths),
+            dr::select(active,
+                       depolarizer<Spectrum>(wav_weight) * dr::Pi<ScalarFloat>,
+                       dr::zeros<Spectrum>())
+        };
+    }
+
+    ScalarBoundingBox3f bbox() const override { return m_shape->bbox(); }
+
+    std::string to_string() const override {
+        using string::indent;
+
+        std::ostringstream oss;
+        oss << "LightmapSensor[" << std::endl
+            << "  shape = ";
+
+        if (m_shape)
+            oss << indent(m_shape);
+        else
+            oss << " <no shape attached!>";
+        oss << "," << std::endl;
+
+        oss << "  flip_v = " << m_flip_v << "," << std::endl
+            << "  film = " << indent(m_film) << "," << std::endl << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+private:
+    bool m_flip_v;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(LightmapSensor, Sensor)
+MI_EXPORT_PLUGIN(LightmapSensor, "LightmapSensor");
+NAMESPACE_END(mitsuba)
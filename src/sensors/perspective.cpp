@@ -174,6 +174,18 @@ public:
 
         m_sample_to_camera = m_camera_to_sample.inverse();
 
+        /* Fold the scaled principal point offset into the sample-to-camera
+           transform so that sample_ray() does not have to re-derive it (and
+           apply it separately) for every generated ray */
+        m_scaled_principal_point_offset =
+            m_film->size() * m_principal_point_offset / m_film->crop_size();
+
+        m_sample_to_camera_pp =
+            m_sample_to_camera *
+            Transform4f::translate(Vector3f(m_scaled_principal_point_offset.x(),
+                                            m_scaled_principal_point_offset.y(),
+                                            0.f));
+
         // Position differentials on the near plane
         m_dx = m_sample_to_camera * Point3f(1.f / m_resolution.x(), 0.f, 0.f) -
                m_sample_to_camera * Point3f(0.f);
@@ -191,8 +203,10 @@ public:
         m_normalization = 1.f / m_image_rect.volume();
         m_needs_sample_3 = false;
 
-        dr::make_opaque(m_camera_to_sample, m_sample_to_camera, m_dx, m_dy, m_x_fov,
-                        m_image_rect, m_normalization, m_principal_point_offset);
+        dr::make_opaque(m_camera_to_sample, m_sample_to_camera,
+                        m_sample_to_camera_pp, m_dx, m_dy, m_x_fov,
+                        m_image_rect, m_normalization, m_principal_point_offset,
+                        m_scaled_principal_point_offset);
     }
 
     std::pair<Ray3f, Spectrum> sample_ray(Float time, Float wavelength_sample,
@@ -209,14 +223,9 @@ public:
         ray.time = time;
         ray.wavelengths = wavelengths;
 
-        Vector2f scaled_principal_point_offset =
-            m_film->size() * m_principal_point_offset / m_film->crop_size();
-
         // Compute the sample position on the near plane (local camera space).
-        Point3f near_p = m_sample_to_camera *
-                         Point3f(position_sample.x() + scaled_principal_point_offset.x(),
-                                 position_sample.y() + scaled_principal_point_offset.y(),
-                                 0.f);
+        Point3f near_p = m_sample_to_camera_pp *
+                         Point3f(position_sample.x(), position_sample.y(), 0.f);
 
         // Convert into a normalized ray direction; adjust the ray interval accordingly.
         Vector3f d = dr::normalize(Vector3f(near_p));
@@ -246,14 +255,9 @@ public:
         ray.time = time;
         ray.wavelengths = wavelengths;
 
-        Vector2f scaled_principal_point_offset =
-            m_film->size() * m_principal_point_offset / m_film->crop_size();
-
         // Compute the sample position on the near plane (local camera space).
-        Point3f near_p = m_sample_to_camera *
-                         Point3f(position_sample.x() + scaled_principal_point_offset.x(),
-                                 position_sample.y() + scaled_principal_point_offset.y(),
-                                 0.f);
+        Point3f near_p = m_sample_to_camera_pp *
+                         Point3f(position_sample.x(), position_sample.y(), 0.f);
 
         // Convert into a normalized ray direction; adjust the ray interval accordingly.
         Vector3f d = dr::normalize(Vector3f(near_p));
@@ -290,12 +294,9 @@ public:
         if (dr::none_or<false>(active))
             return { ds, dr::zeros<Spectrum>() };
 
-        Vector2f scaled_principal_point_offset =
-            m_film->size() * m_principal_point_offset / m_film->crop_size();
-
         Point3f screen_sample = m_camera_to_sample * ref_p;
-        ds.uv = Point2f(screen_sample.x() - scaled_principal_point_offset.x(),
-                        screen_sample.y() - scaled_principal_point_offset.y());
+        ds.uv = Point2f(screen_sample.x() - m_scaled_principal_point_offset.x(),
+                        screen_sample.y() - m_scaled_principal_point_offset.y());
         active &= (ds.uv.x() >= 0) && (ds.uv.x() <= 1) && (ds.uv.y() >= 0) &&
                   (ds.uv.y() <= 1);
         if (dr::none_or<false>(active))
@@ -404,11 +405,14 @@ public:
 private:
     Transform4f m_camera_to_sample;
     Transform4f m_sample_to_camera;
+    /// Sample-to-camera transform with the principal point offset folded in
+    Transform4f m_sample_to_camera_pp;
     BoundingBox2f m_image_rect;
     Float m_normalization;
     Float m_x_fov;
     Vector3f m_dx, m_dy;
     Vector2f m_principal_point_offset;
+    Vector2f m_scaled_principal_point_offset;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(PerspectiveCamera, ProjectiveCamera)
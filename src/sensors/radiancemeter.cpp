@@ -1,5 +1,6 @@
 #include <mitsuba/core/fwd.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/render/fwd.h>
 #include <mitsuba/render/sensor.h>
@@ -30,6 +31,18 @@ Radiance meter (:monosp:`radiancemeter`)
    - Alternative (and exclusive) to `to_world`. Direction in which the
      sensor is pointing in world coordinates. Must be used with `origin`.
 
+ * - origins
+   - |string|
+   - Comma-separated list of measurement origins (``x, y, z`` triplets) for
+     batched captures. Must be used with `directions`.
+
+ * - directions
+   - |string|
+   - Comma-separated list of measurement directions matching `origins`. When
+     both parameters are specified, the sensor records one measurement per
+     film pixel column, allowing an entire capture session to be rendered in
+     a single pass.
+
  * - srf
    - |spectrum|
    - Sensor Response Function that defines the :ref:`spectral sensitivity <explanation_srf_sensor>`
@@ -51,6 +64,13 @@ of :monosp:`origin` and :monosp:`direction` values. If both types of
 transformation are specified, the :monosp:`to_world` transformation has higher
 priority.
 
+Alternatively, a whole batch of measurements can be specified at once using
+the :monosp:`origins` and :monosp:`directions` parameters. In this mode, the
+film must have a resolution of N by 1 pixels, where N is the number of
+measurements: measurement ``i`` is recorded in pixel ``i``. Compared to one
+render per measurement, this amortizes kernel launches and scene traversal
+warm-up over the entire capture session.
+
 */
 
 MI_VARIANT class RadianceMeter final : public Sensor<Float, Spectrum> {
@@ -83,20 +103,94 @@ public:
             }
         }
 
-        if (m_film->size() != ScalarPoint2i(1, 1))
+        if (props.has_property("origins") != props.has_property("directions")) {
+            Throw("If a measurement batch is specified through origins and "
+                  "directions, both values must be set!");
+        }
+
+        if (props.has_property("origins")) {
+            std::vector<std::string> origins_str =
+                string::tokenize(props.string("origins"), " ,");
+            std::vector<std::string> directions_str =
+                string::tokenize(props.string("directions"), " ,");
+
+            if (origins_str.size() != directions_str.size() ||
+                origins_str.size() == 0 || origins_str.size() % 3 != 0)
+                Throw("RadianceMeter: 'origins' and 'directions' parameters "
+                      "must contain the same, nonzero number of 'x, y, z' "
+                      "triplets!");
+
+            m_measurement_count = (uint32_t) (origins_str.size() / 3);
+
+            std::vector<ScalarFloat> origins, directions;
+            origins.reserve(origins_str.size());
+            directions.reserve(directions_str.size());
+
+            for (size_t i = 0; i < origins_str.size(); ++i) {
+                try {
+                    origins.push_back(string::stof<ScalarFloat>(origins_str[i]));
+                    directions.push_back(string::stof<ScalarFloat>(directions_str[i]));
+                } catch (...) {
+                    Throw("Could not parse floating point value '%s'",
+                          origins_str[i]);
+                }
+            }
+
+            // Normalize measurement directions
+            for (size_t i = 0; i < directions.size(); i += 3) {
+                ScalarVector3f d(directions[i], directions[i + 1],
+                                 directions[i + 2]);
+                d = dr::normalize(d);
+                directions[i] = d.x(); directions[i + 1] = d.y();
+                directions[i + 2] = d.z();
+            }
+
+            m_origins    = dr::load<FloatStorage>(origins.data(), origins.size());
+            m_directions = dr::load<FloatStorage>(directions.data(), directions.size());
+        }
+
+        if (m_measurement_count > 0) {
+            if (m_film->size() != ScalarPoint2i((int) m_measurement_count, 1))
+                Throw("In measurement batch mode, the film size (currently "
+                      "%s) must match the number of measurements (%ux1)!",
+                      m_film->size(), m_measurement_count);
+        } else if (m_film->size() != ScalarPoint2i(1, 1)) {
             Throw("This sensor only supports films of size 1x1 Pixels!");
+        }
 
         if (m_film->rfilter()->radius() >
             0.5f + math::RayEpsilon<Float>)
             Log(Warn, "This sensor should be used with a reconstruction filter "
                       "with a radius of 0.5 or lower (e.g. default box)");
 
-        m_needs_sample_2 = false;
+        m_needs_sample_2 = m_measurement_count > 0;
         m_needs_sample_3 = false;
     }
 
+    /**
+     * Compute the origin and direction associated with a measurement. In
+     * batch mode, the horizontal position sample selects the measurement
+     * record; otherwise both quantities derive from \c to_world.
+     */
+    std::pair<Point3f, Vector3f>
+    measurement_ray(const Point2f &position_sample) const {
+        if (m_measurement_count == 0) {
+            return {
+                m_to_world.value().transform_affine(Point3f(0.f, 0.f, 0.f)),
+                m_to_world.value().transform_affine(Vector3f(0.f, 0.f, 1.f))
+            };
+        }
+
+        UInt32 index = dr::minimum(
+            UInt32(position_sample.x() * (ScalarFloat) m_measurement_count),
+            m_measurement_count - 1);
+
+        return { dr::gather<Point3f>(m_origins, index),
+                 dr::gather<Vector3f>(m_directions, index) };
+    }
+
     std::pair<Ray3f, Spectrum> sample_ray(Float time, Float wavelength_sample,
-                                          const Point2f & /*position_sample*/,
+                                          const Point2f &position_sample,
                                           const Point2f & /*aperture_sample*/,
                                           Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleRay, active);
@@ -111,8 +205,7 @@ public:
         ray.wavelengths = wavelengths;
 
         // 2. Set ray origin and direction
-        ray.o = m_to_world.value().transform_affine(Point3f(0.f, 0.f, 0.f));
-        ray.d = m_to_world.value().transform_affine(Vector3f(0.f, 0.f, 1.f));
+        std::tie(ray.o, ray.d) = measurement_ray(position_sample);
         ray.o += ray.d * math::RayEpsilon<Float>;
 
         return { ray, wav_weight };
@@ -120,7 +213,7 @@ public:
 
     std::pair<RayDifferential3f, Spectrum>
     sample_ray_differential(Float time, Float wavelength_sample,
-                            const Point2f & /*position_sample*/,
+                            const Point2f &position_sample,
                             const Point2f & /*aperture_sample*/,
                             Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleRay, active);
@@ -135,8 +228,7 @@ public:
         ray.wavelengths = wavelengths;
 
         // 2. Set ray origin and direction
-        ray.o = m_to_world.value().transform_affine(Point3f(0.f, 0.f, 0.f));
-        ray.d = m_to_world.value().transform_affine(Vector3f(0.f, 0.f, 1.f));
+        std::tie(ray.o, ray.d) = measurement_ray(position_sample);
         ray.o += ray.d * math::RayEpsilon<Float>;
 
         // 3. Set differentials; since the film size is always 1x1, we don't
@@ -156,11 +248,18 @@ public:
         oss << "RadianceMeter[" << std::endl
             << "  to_world = " << m_to_world << "," << std::endl
             << "  film = " << m_film << "," << std::endl
+            << "  measurement_count = " << m_measurement_count << std::endl
             << "]";
         return oss.str();
     }
 
     MI_DECLARE_CLASS()
+private:
+    using FloatStorage = DynamicBuffer<Float>;
+
+    /// Measurement batch (empty unless 'origins'/'directions' was specified)
+    FloatStorage m_origins, m_directions;
+    uint32_t m_measurement_count = 0;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(RadianceMeter, Sensor)
@@ -0,0 +1,75 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def sensor_shape_dict(flip_v=True, width=4, height=4):
+    return {
+        'type': 'rectangle',
+        'sensor': {
+            'type': 'lightmap',
+            'flip_v': flip_v,
+            'film': {
+                'type': 'hdrfilm',
+                'width': width,
+                'height': height,
+                'rfilter': {'type': 'box'}
+            },
+        }
+    }
+
+
+def test_construct(variant_scalar_rgb):
+    """
+    We construct a lightmap sensor attached to a rectangle and assert that
+    the associated shape and film get set correctly
+    """
+    rect = mi.load_dict(sensor_shape_dict())
+    sensor = rect.sensor()
+
+    assert sensor.shape() == rect
+    assert dr.allclose(sensor.film().size(), [4, 4])
+
+    # A to_world transformation on the sensor itself is not allowed
+    d = sensor_shape_dict()
+    d['sensor']['to_world'] = mi.ScalarTransform4f.translate([1, 0, 0])
+    with pytest.raises(RuntimeError):
+        mi.load_dict(d)
+
+
+def test_sampling(variant_scalar_rgb, np_rng):
+    """
+    Sampled rays must originate on the surface point that corresponds to the
+    sampled texel and point into the hemisphere around the surface normal
+    """
+    rect = mi.load_dict(sensor_shape_dict())
+    sensor = rect.sensor()
+    num_samples = 100
+
+    wav_samples = np_rng.random((num_samples,))
+    pos_samples = np_rng.random((num_samples, 2))
+    dir_samples = np_rng.random((num_samples, 2))
+
+    for i in range(num_samples):
+        ray = sensor.sample_ray_differential(
+            0.0, wav_samples[i], pos_samples[i], dir_samples[i])[0]
+
+        # The rectangle spans [-1, 1]^2 at z=0; position_sample.y is flipped
+        u, v = pos_samples[i]
+        p = mi.Point2f(u * 2.0 - 1.0, (1.0 - v) * 2.0 - 1.0)
+
+        assert dr.allclose(mi.Point2f(ray.o.x, ray.o.y), p, atol=1e-4)
+        assert dr.allclose(ray.o.z, 0.0, atol=1e-4)
+        assert ray.d.z > 0.0
+
+
+def test_flip_v(variant_scalar_rgb):
+    """
+    With flip_v disabled, the film's vertical axis directly follows the
+    v coordinate of the parameterization
+    """
+    rect = mi.load_dict(sensor_shape_dict(flip_v=False))
+    sensor = rect.sensor()
+
+    ray = sensor.sample_ray_differential(0.0, 0.5, [0.25, 0.25], [0.5, 0.5])[0]
+    assert dr.allclose(mi.Point2f(ray.o.x, ray.o.y), [-0.5, -0.5], atol=1e-4)
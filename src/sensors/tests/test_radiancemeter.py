@@ -142,3 +142,28 @@ def test_render(variant_scalar_rgb, radiance):
     scene = mi.load_dict(scene_dict)
     img = mi.render(scene)
     assert dr.allclose(img, radiance)
+
+
+def test_sample_ray_batch(variant_scalar_rgb):
+    """Check that batched measurements map position samples to the
+    corresponding origin/direction records"""
+    origins = [[0, 0, 0], [1, 0, 0], [0, 2, 0]]
+    directions = [[0, 1, 0], [0, 0, 1], [1, 0, 0]]
+
+    sensor = mi.load_dict({
+        "type": "radiancemeter",
+        "origins": ", ".join(", ".join(str(v) for v in o) for o in origins),
+        "directions": ", ".join(", ".join(str(v) for v in d) for d in directions),
+        "film": {
+            "type": "hdrfilm",
+            "width": len(origins),
+            "height": 1,
+            "rfilter": {"type": "box"}
+        }
+    })
+
+    for i, (origin, direction) in enumerate(zip(origins, directions)):
+        position_sample = [(i + 0.5) / len(origins), 0.5]
+        ray, _ = sensor.sample_ray(1.0, 1.0, position_sample, [0.5, 0.5])
+        assert dr.allclose(ray.o, origin, atol=1e-4)
+        assert dr.allclose(ray.d, direction)
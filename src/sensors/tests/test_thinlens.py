@@ -261,3 +261,43 @@ def test05_spectrum_sampling(variants_vec_spectral):
                 }
             }
         })
+
+
+def test06_aperture_texture(variant_scalar_rgb):
+    import numpy as np
+
+    # Mask that only transmits on the right-hand side of the aperture square
+    mask = np.zeros((16, 16), dtype=np.float32)
+    mask[:, 10:] = 1.0
+
+    camera = mi.load_dict({
+        "type": "thinlens",
+        "aperture_radius": 0.5,
+        "focus_distance": 15,
+        "aperture_texture": {
+            "type": "bitmap",
+            "bitmap": mi.Bitmap(mask),
+            "raw": True,
+            "wrap_mode": "clamp",
+        },
+        "film": {
+            "type": "hdrfilm",
+            "width": 32,
+            "height": 32,
+        }
+    })
+
+    rng = np.random.default_rng(seed=0)
+    weights = []
+    for _ in range(100):
+        pos_sample = mi.Point2f(rng.random(), rng.random())
+        ap_sample = mi.Point2f(rng.random(), rng.random())
+        ray, weight = camera.sample_ray(0.0, 0.5, pos_sample, ap_sample)
+
+        # All sampled aperture positions lie in the transmitting half
+        assert ray.o.x > 0
+        weights.append(weight[0])
+
+    # The ray weight is the (constant) overall aperture transmission
+    assert dr.allclose(weights, weights[0])
+    assert 0 < weights[0] < 1
@@ -1,6 +1,8 @@
 #include <mitsuba/render/sensor.h>
+#include <mitsuba/render/texture.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/transform.h>
+#include <mitsuba/core/distr_2d.h>
 #include <mitsuba/core/bbox.h>
 #include <mitsuba/core/warp.h>
 
@@ -33,6 +35,18 @@ Perspective camera with a thin lens (:monosp:`thinlens`)
      (Default: :monosp:`0`)
    - |exposed|
 
+ * - aperture_texture
+   - |texture|
+   - Optional texture specifying the shape of the aperture (e.g. a bladed
+     iris). The texture covers the square circumscribing the aperture disk,
+     and its value is interpreted as a monochromatic transmission (for color
+     textures, the luminance is used). Aperture positions are importance
+     sampled from a precomputed hierarchical warp over this texture, so
+     arbitrary bokeh shapes render at the same per-ray cost as the default
+     uniform disk. When rendering in spectral mode, specify the texture with
+     :monosp:`raw=true`. (Default: none, i.e. a uniform circular aperture)
+   - |exposed|
+
  * - focal_length
    - |string|
    - Denotes the camera's focal length specified using *35mm* film equivalent units.
@@ -147,7 +161,9 @@ public:
     MI_IMPORT_BASE(ProjectiveCamera, m_to_world, m_needs_sample_3, m_film, m_sampler,
                     m_resolution, m_shutter_open, m_shutter_open_time, m_near_clip,
                     m_far_clip, m_focus_distance, sample_wavelengths)
-    MI_IMPORT_TYPES()
+    MI_IMPORT_TYPES(Texture)
+
+    using Warp = Hierarchical2D<Float, 0>;
 
     ThinLensCamera(const Properties &props) : Base(props) {
         ScalarVector2i size = m_film->size();
@@ -163,7 +179,11 @@ public:
         if (m_to_world.scalar().has_scale())
             Throw("Scale factors in the camera-to-world transformation are not allowed!");
 
+        if (props.has_property("aperture_texture"))
+            m_aperture_texture = props.texture<Texture>("aperture_texture");
+
         update_camera_transforms();
+        update_aperture_warp();
 
         m_needs_sample_3 = true;
     }
@@ -174,6 +194,9 @@ public:
         callback->put_parameter("focus_distance",  m_focus_distance,  +ParamFlags::NonDifferentiable);
         callback->put_parameter("x_fov",           m_x_fov,           +ParamFlags::NonDifferentiable);
         callback->put_parameter("to_world",       *m_to_world.ptr(),  +ParamFlags::NonDifferentiable);
+        if (m_aperture_texture)
+            callback->put_object("aperture_texture", m_aperture_texture.get(),
+                                 +ParamFlags::NonDifferentiable);
     }
 
     void parameters_changed(const std::vector<std::string> &keys) override {
@@ -184,6 +207,9 @@ public:
         }
 
         update_camera_transforms();
+
+        if (keys.empty() || string::contains(keys, "aperture_texture"))
+            update_aperture_warp();
     }
 
     void update_camera_transforms() {
@@ -213,6 +239,69 @@ public:
                         m_x_fov, m_image_rect, m_normalization);
     }
 
+    void update_aperture_warp() {
+        if (!m_aperture_texture)
+            return;
+
+        /* Tabulate the aperture transmission on a regular grid and build a
+           hierarchical warp over it, so that \ref sample_ray() draws aperture
+           positions proportional to the transmission without rejection. */
+        ScalarVector2i size = m_aperture_texture->resolution();
+        ScalarVector2u res(dr::maximum(size.x(), 2),
+                           dr::maximum(size.y(), 2));
+        size_t n = (size_t) res.x() * (size_t) res.y();
+        std::unique_ptr<ScalarFloat[]> transmission(new ScalarFloat[n]);
+
+        if constexpr (!dr::is_jit_v<Float>) {
+            ScalarFloat *ptr = transmission.get();
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            for (uint32_t y = 0; y < res.y(); ++y) {
+                for (uint32_t x = 0; x < res.x(); ++x) {
+                    si.uv = Point2f(x / ScalarFloat(res.x() - 1),
+                                    y / ScalarFloat(res.y() - 1));
+                    *ptr++ = dr::maximum(m_aperture_texture->eval_1(si), 0.f);
+                }
+            }
+        } else {
+            UInt32 idx = dr::arange<UInt32>((uint32_t) n);
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            si.uv = Point2f(Float(idx % res.x()) / ScalarFloat(res.x() - 1),
+                            Float(idx / res.x()) / ScalarFloat(res.y() - 1));
+            Float value = dr::maximum(m_aperture_texture->eval_1(si), 0.f);
+            value = dr::migrate(value, AllocType::Host);
+            dr::sync_thread();
+            memcpy(transmission.get(), value.data(), n * sizeof(ScalarFloat));
+        }
+
+        double integral = 0.0;
+        for (size_t i = 0; i < n; ++i)
+            integral += (double) transmission[i];
+
+        if (integral == 0.0)
+            Throw("The aperture texture is completely opaque!");
+
+        /* Light transmitted relative to the default uniform disk: the texture
+           covers the circumscribing square (area 4 r^2), whereas the
+           reference aperture is the inscribed disk (area pi r^2). With this
+           factor, a texture containing the inscribed disk matches the
+           untextured camera exactly. */
+        m_aperture_scale = dr::opaque<Float>(ScalarFloat(
+            integral / (double) n * (4.0 / dr::Pi<double>)));
+
+        m_aperture_warp = Warp(transmission.get(), res);
+    }
+
+    /// Sample a position on the aperture plane (local coordinates)
+    Point2f sample_aperture(const Point2f &sample, Mask active) const {
+        if (m_aperture_texture) {
+            Point2f uv = m_aperture_warp.sample(sample, nullptr, active).first;
+            return m_aperture_radius * (2.f * uv - 1.f);
+        } else {
+            return m_aperture_radius *
+                   warp::square_to_uniform_disk_concentric(sample);
+        }
+    }
+
     std::pair<Ray3f, Spectrum> sample_ray(Float time, Float wavelength_sample,
                                           const Point2f &position_sample,
                                           const Point2f &aperture_sample,
@@ -232,9 +321,13 @@ public:
                         Point3f(position_sample.x(), position_sample.y(), 0.f);
 
         // Aperture position
-        Point2f tmp = m_aperture_radius * warp::square_to_uniform_disk_concentric(aperture_sample);
+        Point2f tmp = sample_aperture(aperture_sample, active);
         Point3f aperture_p(tmp.x(), tmp.y(), 0.f);
 
+        // Account for the overall transmission of a textured aperture
+        if (m_aperture_texture)
+            wav_weight *= m_aperture_scale;
+
         // Sampled position on the focal plane
         Point3f focus_p = near_p * (m_focus_distance / near_p.z());
 
@@ -272,9 +365,13 @@ public:
                         Point3f(position_sample.x(), position_sample.y(), 0.f);
 
         // Aperture position
-        Point2f tmp = m_aperture_radius * warp::square_to_uniform_disk_concentric(aperture_sample);
+        Point2f tmp = sample_aperture(aperture_sample, active);
         Point3f aperture_p(tmp.x(), tmp.y(), 0.f);
 
+        // Account for the overall transmission of a textured aperture
+        if (m_aperture_texture)
+            wav_weight *= m_aperture_scale;
+
         // Sampled position on the focal plane
         Float f_dist = m_focus_distance / near_p.z();
         Point3f focus_p   = near_p          * f_dist,
@@ -320,6 +417,15 @@ public:
         Point2f tmp = warp::square_to_uniform_disk_concentric(sample) * m_aperture_radius;
         Point3f aperture_p(tmp.x(), tmp.y(), 0);
 
+        /* A textured aperture scales the importance by the local transmission;
+           the sampled position remains uniform over the disk */
+        Float transmission = 1.f;
+        if (m_aperture_texture) {
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            si.uv = tmp / (2.f * m_aperture_radius) + Point2f(.5f);
+            transmission = m_aperture_texture->eval_1(si, active);
+        }
+
         // Compute the normalized direction vector from the aperture position to the referent point
         Vector3f local_d = ref_p - aperture_p;
         Float dist     = dr::norm(local_d);
@@ -332,7 +438,9 @@ public:
         Point3f scr = m_camera_to_sample.transform_affine(
             aperture_p + local_d * (m_focus_distance * inv_ct));
         Mask valid = dr::all(scr >= 0.f) && dr::all(scr <= 1.f);
-        Float value = dr::select(valid, m_normalization * inv_ct * inv_ct * inv_ct, 0.f);
+        Float value = dr::select(
+            valid, m_normalization * transmission * inv_ct * inv_ct * inv_ct,
+            0.f);
 
         if (dr::none_or<false>(valid))
             return { ds, dr::zeros<Spectrum>() };
@@ -369,6 +477,7 @@ public:
             << "  resolution = " << m_resolution << "," << std::endl
             << "  shutter_open = " << m_shutter_open << "," << std::endl
             << "  shutter_open_time = " << m_shutter_open_time << "," << std::endl
+            << "  aperture_texture = " << (m_aperture_texture ? indent(m_aperture_texture) : std::string("none")) << "," << std::endl
             << "  to_world = " << indent(m_to_world)  << std::endl
             << "]";
         return oss.str();
@@ -383,6 +492,9 @@ private:
     Float m_normalization;
     Float m_x_fov;
     Vector3f m_dx, m_dy;
+    ref<Texture> m_aperture_texture;
+    Warp m_aperture_warp;
+    Float m_aperture_scale;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(ThinLensCamera, ProjectiveCamera)
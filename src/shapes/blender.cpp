@@ -1,6 +1,8 @@
 #include <mitsuba/render/mesh.h>
 #include <drjit/color.h>
+#include <nanothread/nanothread.h>
 #include <array>
+#include <atomic>
 
 // Blender Mesh format types for the exporter
 NAMESPACE_BEGIN(blender)
@@ -168,30 +170,6 @@ public:
             }
         }
 
-        // Temporary buffers for vertices, normals, etc.
-        std::vector<std::array<InputFloat, 3>> tmp_vertices; // Store as vector for alignment issues
-        std::vector<std::array<InputFloat, 3>> tmp_normals; // Same here
-        std::vector<InputVector2f> tmp_uvs;
-        std::vector<std::vector<InputFloat>> tmp_cols; // And same here
-        std::vector<ScalarIndex3> tmp_triangles;
-
-        tmp_vertices.reserve(vertex_count);
-        if (!m_face_normals)
-            tmp_normals.reserve(vertex_count);
-        tmp_triangles.reserve(loop_tri_count);
-
-        if (has_uvs)
-            tmp_uvs.reserve(vertex_count);
-        if (has_cols) {
-            tmp_cols.reserve(cols.size());
-            for (size_t p = 0; p < cols.size(); p++) {
-                tmp_cols.push_back(std::vector<InputFloat>());
-                tmp_cols[p].reserve(3 * vertex_count);
-            }
-        }
-
-        ScalarIndex vertex_ctr = 0;
-
         // Hash map key to define a unique vertex
         struct Key {
             InputNormal3f normal;
@@ -219,59 +197,80 @@ public:
             bool is_init{ false };
         };
 
-        // Hash Map to avoid adding duplicate vertices
-        std::vector<VertexBinding> vertex_map(vertex_count);
+        // Per-corner dedup keys of an emitted triangle, computed in parallel
+        struct TriRecord {
+            size_t tri_loop_id;
+            Key keys[3];
+        };
 
-        size_t duplicates_ctr = 0;
-        for (size_t tri_loop_id = 0; tri_loop_id < loop_tri_count; tri_loop_id++) {
+        /* The conversion runs in four passes so that the expensive work
+           (triangulation, normal transforms, UV flips, color conversion) can
+           be parallelized over ranges of loop triangles:
+
+             1. count the triangles each range emits for this material
+             2. prefix-sum the counts into per-range output offsets and fill
+                in the per-corner dedup keys concurrently at those offsets
+             3. walk the precomputed keys through the dedup hash map serially,
+                assigning vertex indices in a deterministic order
+             4. blit position/normal/UV/color data of every unique vertex in
+                parallel
+
+           Only pass 3 is serial, and it performs no arithmetic on the
+           vertex data itself. */
+
+        std::atomic<size_t> invalid_vertex{ (size_t) -1 };
+        std::atomic<bool> invalid_normal{ false };
+
+        /* Convert a single loop triangle. Returns whether it is part of this
+           material's mesh; when \c keys is non-null, also computes the three
+           per-corner dedup keys (normal, polygon, UV). */
+        auto convert_tri = [&](size_t tri_loop_id, Key *keys) -> bool {
             const blender::MLoopTri &tri_loop = tri_loops[tri_loop_id];
             const blender::MPoly &face        = polygons[tri_loop.poly];
 
             // We only export the part of the mesh corresponding to the given
             // material id
             if (face.mat_nr != mat_nr)
-                continue;
+                return false;
 
-            ScalarIndex3 triangle;
-
-            const float *co_0, *co_1, *co_2;
-            if (blender_3) {
-                co_0 = verts_blender3[loops[tri_loop.tri[0]].v].co;
-                co_1 = verts_blender3[loops[tri_loop.tri[1]].v].co;
-                co_2 = verts_blender3[loops[tri_loop.tri[2]].v].co;
-            } else {
-                co_0 = verts_blender2[loops[tri_loop.tri[0]].v].co;
-                co_1 = verts_blender2[loops[tri_loop.tri[1]].v].co;
-                co_2 = verts_blender2[loops[tri_loop.tri[2]].v].co;
+            for (int i = 0; i < 3; i++) {
+                const size_t vert_index = loops[tri_loop.tri[i]].v;
+                if (unlikely(vert_index >= vertex_count)) {
+                    invalid_vertex = vert_index;
+                    return false;
+                }
             }
 
-            dr::Array<InputPoint3f, 3> face_points;
-            face_points[0] = InputPoint3f(co_0[0], co_0[1], co_0[2]);
-            face_points[1] = InputPoint3f(co_1[0], co_1[1], co_1[2]);
-            face_points[2] = InputPoint3f(co_2[0], co_2[1], co_2[2]);
+            bool smooth = (blender::ME_SMOOTH & face.flag) || m_face_normals;
 
             InputNormal3f normal(0.f);
-            if (!(blender::ME_SMOOTH & face.flag) && !m_face_normals) {
+            if (!smooth) {
                 // Flat shading, use per face normals (only if the mesh is not globally flat)
+                dr::Array<InputPoint3f, 3> face_points;
+                for (int i = 0; i < 3; i++) {
+                    const float *co = blender_3
+                        ? verts_blender3[loops[tri_loop.tri[i]].v].co
+                        : verts_blender2[loops[tri_loop.tri[i]].v].co;
+                    face_points[i] = InputPoint3f(co[0], co[1], co[2]);
+                }
                 const InputVector3f e1 = face_points[1] - face_points[0];
                 const InputVector3f e2 = face_points[2] - face_points[0];
                 normal = m_to_world.scalar().transform_affine(dr::cross(e1, e2));
-                if(unlikely(dr::all(dr::eq(normal, 0.f))))
-                    continue; // Degenerate triangle, ignore it
+                if (unlikely(dr::all(dr::eq(normal, 0.f))))
+                    return false; // Degenerate triangle, ignore it
                 else
                     normal = dr::normalize(normal);
             }
 
-            InputFloat color_factor = dr::rcp(255.f);
+            if (!keys)
+                return true; // Counting pass, the keys are not needed yet
 
             for (int i = 0; i < 3; i++) {
                 const size_t loop_index = tri_loop.tri[i];
                 const size_t vert_index = loops[loop_index].v;
-                if (unlikely((vert_index >= vertex_count)))
-                    fail("reference to invalid vertex %i!", vert_index);
 
-                Key vert_key;
-                if (blender::ME_SMOOTH & face.flag || m_face_normals) {
+                Key &vert_key = keys[i];
+                if (smooth) {
                     if (!blender_3) {
                         const short *no = verts_blender2[vert_index].no;
                         // Store per vertex normals if the face is smooth or if the mesh is globally flat
@@ -282,8 +281,8 @@ public:
                         normal = m_to_world.scalar().transform_affine(InputNormal3f(no[0], no[1], no[2]));
                     }
 
-                    if(unlikely(dr::all(dr::eq(normal, 0.f))))
-                        fail("invalid normals!");
+                    if (unlikely(dr::all(dr::eq(normal, 0.f))))
+                        invalid_normal = true;
                     else
                         normal = dr::normalize(normal);
                     vert_key.smooth = true;
@@ -297,9 +296,86 @@ public:
 
                 if (has_uvs) {
                     const blender::MLoopUV &loop_uv = uvs[loop_index];
-                    const InputVector2f uv(loop_uv.uv[0], 1.0f - loop_uv.uv[1]);
-                    vert_key.uv = uv;
+                    vert_key.uv = InputVector2f(loop_uv.uv[0], 1.0f - loop_uv.uv[1]);
                 }
+            }
+
+            return true;
+        };
+
+        // Pass 1: per-range triangle counts
+        size_t chunk_size  = 16384,
+               chunk_count = (loop_tri_count + chunk_size - 1) / chunk_size;
+
+        std::vector<size_t> chunk_offset(chunk_count + 1, 0);
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, chunk_count, 1),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (size_t c = range.begin(); c != range.end(); ++c) {
+                    size_t begin = c * chunk_size,
+                           end   = dr::minimum(begin + chunk_size, loop_tri_count),
+                           count = 0;
+                    for (size_t t = begin; t != end; ++t)
+                        count += convert_tri(t, nullptr) ? 1 : 0;
+                    chunk_offset[c + 1] = count;
+                }
+            });
+
+        if (invalid_vertex != (size_t) -1)
+            fail("reference to invalid vertex %i!", invalid_vertex.load());
+
+        for (size_t c = 0; c < chunk_count; ++c)
+            chunk_offset[c + 1] += chunk_offset[c];
+
+        // Pass 2: triangulation and key computation at the prefix-summed offsets
+        size_t tri_count = chunk_offset[chunk_count];
+        std::vector<TriRecord> tri_records(tri_count);
+        std::vector<ScalarIndex3> tmp_triangles(tri_count);
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, chunk_count, 1),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (size_t c = range.begin(); c != range.end(); ++c) {
+                    size_t begin  = c * chunk_size,
+                           end    = dr::minimum(begin + chunk_size, loop_tri_count),
+                           offset = chunk_offset[c];
+                    for (size_t t = begin; t != end; ++t) {
+                        TriRecord &rec = tri_records[offset];
+                        if (convert_tri(t, rec.keys)) {
+                            rec.tri_loop_id = t;
+                            offset++;
+                        }
+                    }
+                }
+            });
+
+        if (invalid_normal)
+            fail("invalid normals!");
+
+        // Hash Map to avoid adding duplicate vertices
+        std::vector<VertexBinding> vertex_map(vertex_count);
+
+        // Source loop/vertex of every unique output vertex, in output order
+        struct NewVertex {
+            size_t loop_index, vert_index;
+            const Key *key;
+        };
+        std::vector<NewVertex> new_vertices;
+        new_vertices.reserve(vertex_count);
+
+        // Pass 3: serial vertex deduplication over the precomputed keys
+        ScalarIndex vertex_ctr = 0;
+        size_t duplicates_ctr = 0;
+        for (size_t t = 0; t < tri_count; t++) {
+            const TriRecord &rec = tri_records[t];
+            const blender::MLoopTri &tri_loop = tri_loops[rec.tri_loop_id];
+
+            ScalarIndex3 triangle;
+            for (int i = 0; i < 3; i++) {
+                const size_t loop_index = tri_loop.tri[i];
+                const size_t vert_index = loops[loop_index].v;
+                const Key &vert_key     = rec.keys[i];
 
                 // Vertex index in the blender mesh is the map index
                 VertexBinding *map_entry = &vertex_map[vert_index];
@@ -319,33 +395,56 @@ public:
                     map_entry->key     = vert_key;
                     map_entry->value   = vert_id;
                     map_entry->is_init = true;
-                    // Add stuff to the temporary buffers
-                    InputPoint3f pt = m_to_world.scalar().transform_affine(face_points[i]);
-                    tmp_vertices.push_back({pt.x(), pt.y(), pt.z()});
-                    if (!m_face_normals)
-                        tmp_normals.push_back({normal.x(), normal.y(), normal.z()});
-                    if (has_uvs)
-                        tmp_uvs.push_back(vert_key.uv);
-                    if (has_cols) {
-                        for (size_t p = 0; p < cols.size(); p++) {
-                            const blender::MLoopCol &loop_col = cols[p].second[loop_index];
-                            // Blender stores vertex colors in sRGB space
-                            tmp_cols[p].push_back(dr::srgb_to_linear(loop_col.r * color_factor));
-                            tmp_cols[p].push_back(dr::srgb_to_linear(loop_col.g * color_factor));
-                            tmp_cols[p].push_back(dr::srgb_to_linear(loop_col.b * color_factor));
-                        }
-                    }
+                    new_vertices.push_back({ loop_index, vert_index, &rec.keys[i] });
                     triangle[i] = vert_id;
                 }
             }
-            tmp_triangles.push_back(triangle);
+            tmp_triangles[t] = triangle;
         }
         Log(Info, "%s: Removed %i duplicates", m_name, duplicates_ctr);
 
         if (vertex_ctr == 0)
             return;
 
-        m_face_count = (ScalarSize) tmp_triangles.size();
+        // Pass 4: blit the vertex data of every unique vertex in parallel
+        std::vector<std::array<InputFloat, 3>> tmp_vertices(vertex_ctr); // Store as vector for alignment issues
+        std::vector<std::array<InputFloat, 3>> tmp_normals(m_face_normals ? 0 : vertex_ctr); // Same here
+        std::vector<InputVector2f> tmp_uvs(has_uvs ? vertex_ctr : 0);
+        std::vector<std::vector<InputFloat>> tmp_cols(cols.size()); // And same here
+        for (size_t p = 0; p < cols.size(); p++)
+            tmp_cols[p].resize(3 * (size_t) vertex_ctr);
+
+        InputFloat color_factor = dr::rcp(255.f);
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, vertex_ctr, 4096),
+            [&](const dr::blocked_range<size_t> &range) {
+                for (size_t v = range.begin(); v != range.end(); ++v) {
+                    const NewVertex &nv = new_vertices[v];
+
+                    const float *co = blender_3 ? verts_blender3[nv.vert_index].co
+                                                : verts_blender2[nv.vert_index].co;
+                    InputPoint3f pt = m_to_world.scalar().transform_affine(
+                        InputPoint3f(co[0], co[1], co[2]));
+                    tmp_vertices[v] = { pt.x(), pt.y(), pt.z() };
+
+                    if (!m_face_normals)
+                        tmp_normals[v] = { nv.key->normal.x(), nv.key->normal.y(),
+                                           nv.key->normal.z() };
+                    if (has_uvs)
+                        tmp_uvs[v] = nv.key->uv;
+
+                    for (size_t p = 0; p < cols.size(); p++) {
+                        const blender::MLoopCol &loop_col = cols[p].second[nv.loop_index];
+                        // Blender stores vertex colors in sRGB space
+                        tmp_cols[p][3 * v + 0] = dr::srgb_to_linear(loop_col.r * color_factor);
+                        tmp_cols[p][3 * v + 1] = dr::srgb_to_linear(loop_col.g * color_factor);
+                        tmp_cols[p][3 * v + 2] = dr::srgb_to_linear(loop_col.b * color_factor);
+                    }
+                }
+            });
+
+        m_face_count = (ScalarSize) tri_count;
         m_faces = dr::load<DynamicBuffer<UInt32>>(tmp_triangles.data(), m_face_count * 3);
 
         m_vertex_count = vertex_ctr;
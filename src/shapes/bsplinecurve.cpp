@@ -55,6 +55,17 @@ B-spline curve (:monosp:`bsplinecurve`)
      Each control point in the buffer is structured as follows: position_x, position_y, position_z, radius
    - |exposed|, |differentiable|, |discontinuous|
 
+ * - lod
+   - |int|
+   - Level-of-detail selector: a value of :math:`L > 0` decimates every curve
+     at load time, keeping roughly every :math:`2^L`-th control point (curve
+     endpoints always survive, and curves that are already too short are kept
+     verbatim). Each retained control point assumes the maximum radius of the
+     points it replaces so that silhouettes stay conservative. Decimation
+     shrinks the acceleration data structure and its traversal depth, which
+     is useful for distant grooms whose strands are subpixel-sized anyway.
+     (Default: 0, i.e. full resolution)
+
 .. subfigstart::
 .. subfigure:: ../../resources/data/docs/images/render/shape_bsplinecurve_basic.jpg
    :caption: Basic example
@@ -146,6 +157,10 @@ public:
                   "variants!");
 #endif
 
+        m_lod = props.get<uint32_t>("lod", 0);
+        if (m_lod > 16)
+            Throw("Level-of-detail values above 16 are not supported!");
+
         auto fs = Thread::thread()->file_resolver();
         fs::path file_path = fs->resolve(props.string("filename"));
         std::string m_name = file_path.filename().string();
@@ -253,6 +268,65 @@ public:
             fail("Empty B-spline file: no control points were read!");
         finish_curve();
 
+        /* Level-of-detail decimation: resample each curve's control polygon
+           with a power-of-two stride. Endpoints always survive, curves that
+           would drop below the four points required by a cubic B-spline are
+           kept verbatim, and each retained control point assumes the maximum
+           radius of the points it replaces to keep silhouettes conservative. */
+        if (m_lod > 0) {
+            size_t stride = (size_t) 1 << m_lod;
+            std::vector<InputPoint3f> lod_vertices;
+            std::vector<InputFloat> lod_radius;
+            std::vector<size_t> lod_1st_idx;
+            lod_vertices.reserve(vertices.size() / stride + 4 * curve_1st_idx.size());
+            lod_radius.reserve(lod_vertices.capacity());
+            lod_1st_idx.reserve(curve_1st_idx.size());
+            segment_count = 0;
+
+            for (size_t i = 0; i < curve_1st_idx.size(); ++i) {
+                size_t begin = curve_1st_idx[i],
+                       end   = i + 1 < curve_1st_idx.size() ? curve_1st_idx[i + 1]
+                                                            : vertices.size(),
+                       count = end - begin;
+
+                size_t kept = (count - 1) / stride + 1;
+                if ((count - 1) % stride != 0)
+                    ++kept; // the final control point is appended separately
+
+                lod_1st_idx.push_back(lod_vertices.size());
+                if (kept < 4) {
+                    for (size_t j = begin; j < end; ++j) {
+                        lod_vertices.push_back(vertices[j]);
+                        lod_radius.push_back(radius[j]);
+                    }
+                    segment_count += count - 3;
+                    continue;
+                }
+
+                for (size_t j = 0; j < count; j += stride) {
+                    size_t window_end = j + stride < count ? j + stride : count;
+                    InputFloat r = radius[begin + j];
+                    for (size_t k = j + 1; k < window_end; ++k)
+                        r = dr::maximum(r, radius[begin + k]);
+                    lod_vertices.push_back(vertices[begin + j]);
+                    lod_radius.push_back(r);
+                }
+                if ((count - 1) % stride != 0) {
+                    lod_vertices.push_back(vertices[begin + count - 1]);
+                    lod_radius.push_back(radius[begin + count - 1]);
+                }
+                segment_count += kept - 3;
+            }
+
+            Log(Debug, "\"%s\": level-of-detail %i decimation kept %i of %i "
+                "control points", m_name, m_lod,
+                (ScalarSize) lod_vertices.size(), (ScalarSize) vertices.size());
+
+            vertices      = std::move(lod_vertices);
+            radius        = std::move(lod_radius);
+            curve_1st_idx = std::move(lod_1st_idx);
+        }
+
         m_control_point_count = (ScalarSize) vertices.size();
 
         std::unique_ptr<ScalarIndex[]> indices = std::make_unique<ScalarIndex[]>(segment_count);
@@ -313,6 +387,8 @@ public:
             util::time_string((float) timer.value())
         );
 
+        rebuild_segment_cache();
+
         initialize();
     }
 
@@ -527,6 +603,7 @@ public:
     void parameters_changed(const std::vector<std::string> &keys) override {
         if (keys.empty() || string::contains(keys, "control_points")) {
             recompute_bbox();
+            rebuild_segment_cache();
             mark_dirty();
         }
         Base::parameters_changed();
@@ -639,8 +716,100 @@ private:
         }
     }
 
+    /**
+     * \brief Precompute power-basis coefficients for every curve segment
+     *
+     * Shading-side queries (\ref compute_surface_interaction, \ref partials,
+     * \ref eval_parameterization) repeatedly evaluate the cubic B-spline
+     * basis from the four control points of a segment. This routine converts
+     * each segment into the monomial coefficients of its position and radius
+     * cubics once at load time, packed per segment as four (x, y, z, r)
+     * records in ascending power order. \ref cubic_interpolation then reduces
+     * to a single indexed gather and Horner evaluations, without the extra
+     * indirection through the segment index buffer. The cache is detached
+     * from the AD graph and costs 16 floats per segment.
+     */
+    void rebuild_segment_cache() {
+        ScalarSize segment_count = (ScalarSize) dr::width(m_indices);
+        m_segment_coefs = dr::empty<FloatStorage>(segment_count * 16);
+
+        if constexpr (dr::is_jit_v<Float>) {
+            FloatStorage cp = dr::detach(m_control_points);
+            UInt32Storage sid = dr::arange<UInt32Storage>(segment_count);
+            UInt32Storage idx = dr::gather<UInt32Storage>(m_indices, sid);
+            for (uint32_t ch = 0; ch < 4; ++ch) {
+                FloatStorage
+                    p0 = dr::gather<FloatStorage>(cp, (idx + 0u) * 4u + ch),
+                    p1 = dr::gather<FloatStorage>(cp, (idx + 1u) * 4u + ch),
+                    p2 = dr::gather<FloatStorage>(cp, (idx + 2u) * 4u + ch),
+                    p3 = dr::gather<FloatStorage>(cp, (idx + 3u) * 4u + ch);
+                dr::scatter(m_segment_coefs,
+                            (p0 + 4.f * p1 + p2) * (1.f / 6.f),
+                            sid * 16u + (0u * 4u + ch));
+                dr::scatter(m_segment_coefs,
+                            (p2 - p0) * .5f,
+                            sid * 16u + (1u * 4u + ch));
+                dr::scatter(m_segment_coefs,
+                            (p0 - 2.f * p1 + p2) * .5f,
+                            sid * 16u + (2u * 4u + ch));
+                dr::scatter(m_segment_coefs,
+                            (p3 - p0 + 3.f * (p1 - p2)) * (1.f / 6.f),
+                            sid * 16u + (3u * 4u + ch));
+            }
+        } else {
+            for (ScalarSize s = 0; s < segment_count; ++s) {
+                uint32_t idx = (uint32_t) m_indices[s];
+                for (uint32_t ch = 0; ch < 4; ++ch) {
+                    InputFloat p0 = m_control_points[(idx + 0) * 4 + ch],
+                               p1 = m_control_points[(idx + 1) * 4 + ch],
+                               p2 = m_control_points[(idx + 2) * 4 + ch],
+                               p3 = m_control_points[(idx + 3) * 4 + ch];
+                    m_segment_coefs[s * 16 + 0 * 4 + ch] =
+                        (p0 + 4.f * p1 + p2) * (1.f / 6.f);
+                    m_segment_coefs[s * 16 + 1 * 4 + ch] = (p2 - p0) * .5f;
+                    m_segment_coefs[s * 16 + 2 * 4 + ch] =
+                        (p0 - 2.f * p1 + p2) * .5f;
+                    m_segment_coefs[s * 16 + 3 * 4 + ch] =
+                        (p3 - p0 + 3.f * (p1 - p2)) * (1.f / 6.f);
+                }
+            }
+        }
+    }
+
     std::tuple<Point3f, Vector3f, Vector3f, Vector3f, Float, Float, Float>
     cubic_interpolation(const Float v, const UInt32 prim_idx, Mask active) const {
+        if constexpr (dr::is_diff_v<Float>) {
+            /* The coefficient cache is detached; gradient computations must
+               evaluate the spline basis from the control points directly */
+            if (dr::grad_enabled(m_control_points))
+                return cubic_interpolation_ref(v, prim_idx, active);
+        }
+
+        // Fast path: Horner evaluation of the cached monomial coefficients
+        UInt32 base = prim_idx * 4u;
+        Point4f k0 = dr::gather<Point4f>(m_segment_coefs, base + 0u, active),
+                k1 = dr::gather<Point4f>(m_segment_coefs, base + 1u, active),
+                k2 = dr::gather<Point4f>(m_segment_coefs, base + 2u, active),
+                k3 = dr::gather<Point4f>(m_segment_coefs, base + 3u, active);
+        Point3f q0 = Point3f(k0.x(), k0.y(), k0.z()),
+                q1 = Point3f(k1.x(), k1.y(), k1.z()),
+                q2 = Point3f(k2.x(), k2.y(), k2.z()),
+                q3 = Point3f(k3.x(), k3.y(), k3.z());
+        Float s0 = k0.w(), s1 = k1.w(), s2 = k2.w(), s3 = k3.w();
+
+        Point3f  c       = ((q3 * v + q2) * v + q1) * v + q0;
+        Vector3f dc_dv   = (3.f * q3 * v + 2.f * q2) * v + q1,
+                 dc_dvv  = 6.f * q3 * v + 2.f * q2,
+                 dc_dvvv = 6.f * q3;
+        Float radius = ((s3 * v + s2) * v + s1) * v + s0,
+              dr_dv  = (3.f * s3 * v + 2.f * s2) * v + s1,
+              dr_dvv = 6.f * s3 * v + 2.f * s2;
+
+        return { c, dc_dv, dc_dvv, dc_dvvv, radius, dr_dv, dr_dvv };
+    }
+
+    std::tuple<Point3f, Vector3f, Vector3f, Vector3f, Float, Float, Float>
+    cubic_interpolation_ref(const Float v, const UInt32 prim_idx, Mask active) const {
         UInt32 idx = dr::gather<UInt32>(m_indices, prim_idx, active);
         Point4f c0 = dr::gather<Point4f>(m_control_points, idx + 0, active),
                 c1 = dr::gather<Point4f>(m_control_points, idx + 1, active),
@@ -808,9 +977,15 @@ private:
 
     ScalarSize m_control_point_count = 0;
 
+    /// Level-of-detail decimation stride exponent (0 = full resolution)
+    uint32_t m_lod = 0;
+
     mutable UInt32Storage m_indices;
     mutable FloatStorage m_control_points;
 
+    /// Per-segment monomial coefficients (see \ref rebuild_segment_cache)
+    mutable FloatStorage m_segment_coefs;
+
 #if defined(MI_ENABLE_CUDA)
     // For OptiX build input
     mutable CUdeviceptr* m_vertex_buffer_ptr = nullptr;
@@ -479,9 +479,12 @@ public:
         si.t = dr::select(active, si.t, dr::Infinity<Float>);
 
         // si.uv
-        Float phi = dr::atan2(local.y(), local.x());
-        dr::masked(phi, phi < 0.f) += dr::TwoPi<Float>;
-        si.uv = Point2f(phi * dr::InvTwoPi<Float>, local.z());
+        if (likely(has_flag(ray_flags, RayFlags::UV) ||
+                   has_flag(ray_flags, RayFlags::BoundaryTest))) {
+            Float phi = dr::atan2(local.y(), local.x());
+            dr::masked(phi, phi < 0.f) += dr::TwoPi<Float>;
+            si.uv = Point2f(phi * dr::InvTwoPi<Float>, local.z());
+        }
         // si.dp_duv & si.n
         Vector3f dp_du = dr::TwoPi<Float> * Vector3f(-local.y(), local.x(), 0.f);
         Vector3f dp_dv = Vector3f(0.f, 0.f, 1.f);
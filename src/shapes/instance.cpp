@@ -31,6 +31,13 @@ Instance (:monosp:`instance`)
    - Specifies a linear object-to-world transformation. (Default: none (i.e. object space = world space))
    - |exposed|, |differentiable|, |discontinuous|
 
+ * - to_world_end
+   - |transform|
+   - Optional object-to-world transformation at the end of the shutter interval. When specified,
+     the instance undergoes rigid linear motion between the two transforms and rays intersect it
+     at their sampled time value, producing transformation motion blur without duplicating the
+     geometry. Currently only supported on the Embree (CPU) backend. (Default: none)
+
 This plugin implements a geometry instance used to efficiently replicate geometry many times. For
 details on how to create instances, refer to the :ref:`shape-shapegroup` plugin.
 
@@ -74,6 +81,18 @@ public:
         if (!m_shapegroup)
             Throw("A reference to a 'shapegroup' must be specified!");
 
+        if (props.has_property("to_world_end")) {
+            m_to_world_end = props.get<ScalarTransform4f>("to_world_end");
+            m_animated = true;
+#if !defined(MI_ENABLE_EMBREE)
+            Throw("Motion blur instancing (\"to_world_end\") requires Embree "
+                  "support!");
+#endif
+            if constexpr (dr::is_cuda_v<Float>)
+                Throw("Motion blur instancing (\"to_world_end\") is currently "
+                      "only supported on the Embree (CPU) backend!");
+        }
+
         dr::make_opaque(m_to_world, m_to_object);
     }
 
@@ -98,9 +117,15 @@ public:
         if (!bbox.valid())
             return bbox;
 
+        /* With matrix motion, positions at intermediate times are convex
+           combinations of the two endpoint transforms, so expanding the
+           bounds over both endpoints is sufficient */
         ScalarBoundingBox3f result;
-        for (int i = 0; i < 8; ++i)
+        for (int i = 0; i < 8; ++i) {
             result.expand(m_to_world.scalar() * bbox.corner(i));
+            if (m_animated)
+                result.expand(m_to_world_end * bbox.corner(i));
+        }
         return result;
     }
 
@@ -117,6 +142,21 @@ public:
     //! @{ \name Ray tracing routines
     // =============================================================
 
+    /// Interpolate the instance-to-world transform at the given time (linear
+    /// matrix motion over [0, 1], matching Embree's convention)
+    Transform4f eval_transform(const Float &time) const {
+        Matrix4f m0 = m_to_world.value().matrix,
+                 m1(m_to_world_end.matrix);
+        return Transform4f(dr::lerp(m0, m1, dr::clamp(time, 0.f, 1.f)));
+    }
+
+    /// Scalar version of \ref eval_transform()
+    ScalarTransform4f eval_transform_scalar(ScalarFloat time) const {
+        return ScalarTransform4f(dr::lerp(m_to_world.scalar().matrix,
+                                          m_to_world_end.matrix,
+                                          dr::clamp(time, 0.f, 1.f)));
+    }
+
     template <typename FloatP, typename Ray3fP>
     std::tuple<FloatP, Point<FloatP, 2>, dr::uint32_array_t<FloatP>,
                dr::uint32_array_t<FloatP>>
@@ -124,6 +164,9 @@ public:
                                    dr::mask_t<FloatP> active) const {
         MI_MASK_ARGUMENT(active);
         if constexpr (!dr::is_array_v<FloatP>) {
+            if (unlikely(m_animated))
+                return m_shapegroup->ray_intersect_preliminary_scalar(
+                    eval_transform_scalar(ray.time).inverse().transform_affine(ray));
             return m_shapegroup->ray_intersect_preliminary_scalar(m_to_object.scalar().transform_affine(ray));
         } else {
             Throw("Instance::ray_intersect_preliminary() should only be called with scalar types.");
@@ -135,6 +178,9 @@ public:
         MI_MASK_ARGUMENT(active);
 
         if constexpr (!dr::is_array_v<FloatP>) {
+            if (unlikely(m_animated))
+                return m_shapegroup->ray_test_scalar(
+                    eval_transform_scalar(ray.time).inverse().transform_affine(ray));
             return m_shapegroup->ray_test_scalar(m_to_object.scalar().transform_affine(ray));
         } else {
             Throw("Instance::ray_test_impl() should only be called with scalar types.");
@@ -150,8 +196,12 @@ public:
                                                      Mask active) const override {
         MI_MASK_ARGUMENT(active);
 
-        const Transform4f& to_world  = m_to_world.value();
-        const Transform4f& to_object = m_to_object.value();
+        Transform4f to_world  = m_to_world.value(),
+                    to_object = m_to_object.value();
+        if (unlikely(m_animated)) {
+            to_world  = eval_transform(ray.time);
+            to_object = to_world.inverse();
+        }
 
         constexpr bool IsDiff = dr::is_diff_v<Float>;
         bool grad_enabled = dr::grad_enabled(to_world);
@@ -255,15 +305,44 @@ public:
         DRJIT_MARK_USED(device);
         if constexpr (!dr::is_cuda_v<Float>) {
             RTCGeometry instance = m_shapegroup->embree_geometry(device);
-            rtcSetGeometryTimeStepCount(instance, 1);
-            dr::Matrix<ScalarFloat32, 4> matrix(m_to_world.scalar().matrix);
-            rtcSetGeometryTransform(instance, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, &matrix);
+            if (unlikely(m_animated)) {
+                /* Two-timestep rigid motion: Embree interpolates the matrices
+                   at the ray's time value and builds a MSMBLUR BVH over the
+                   swept instance */
+                rtcSetGeometryTimeStepCount(instance, 2);
+                dr::Matrix<ScalarFloat32, 4> m0(m_to_world.scalar().matrix),
+                                             m1(m_to_world_end.matrix);
+                rtcSetGeometryTransform(instance, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, &m0);
+                rtcSetGeometryTransform(instance, 1, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, &m1);
+            } else {
+                rtcSetGeometryTimeStepCount(instance, 1);
+                dr::Matrix<ScalarFloat32, 4> matrix(m_to_world.scalar().matrix);
+                rtcSetGeometryTransform(instance, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, &matrix);
+            }
             rtcCommitGeometry(instance);
             return instance;
         } else {
             Throw("embree_geometry() should only be called in CPU mode.");
         }
     }
+
+    bool embree_refit(RTCGeometry instance) const override {
+        if constexpr (!dr::is_cuda_v<Float>) {
+            /* Animated instances sweep two matrices into a MSMBLUR BVH,
+               which Embree cannot refit in place */
+            if (unlikely(m_animated))
+                return false;
+
+            dr::Matrix<ScalarFloat32, 4> matrix(m_to_world.scalar().matrix);
+            rtcSetGeometryTransform(instance, 0,
+                                    RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, &matrix);
+            rtcCommitGeometry(instance);
+            return true;
+        } else {
+            DRJIT_MARK_USED(instance);
+            return false;
+        }
+    }
 #endif
 
 #if defined(MI_ENABLE_CUDA)
@@ -292,6 +371,9 @@ public:
     MI_DECLARE_CLASS()
 private:
    ref<ShapeGroup_> m_shapegroup;
+   /// Transformation at the end of the shutter interval (motion blur)
+   ScalarTransform4f m_to_world_end;
+   bool m_animated = false;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(Instance, Shape)
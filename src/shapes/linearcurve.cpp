@@ -54,6 +54,16 @@ Linear curve (:monosp:`linearcurve`)
      Each control point in the buffer is structured as follows: position_x, position_y, position_z, radius
    - |exposed|
 
+ * - lod
+   - |int|
+   - Level-of-detail selector: a value of :math:`L > 0` decimates every curve
+     at load time, keeping roughly every :math:`2^L`-th control point (curve
+     endpoints always survive). Each retained control point assumes the
+     maximum radius of the points it replaces so that silhouettes stay
+     conservative. Decimation shrinks the acceleration data structure and its
+     traversal depth, which is useful for distant grooms whose strands are
+     subpixel-sized anyway. (Default: 0, i.e. full resolution)
+
 .. subfigstart::
 .. subfigure:: ../../resources/data/docs/images/render/shape_linearcurve_basic.jpg
    :caption: Basic example
@@ -134,6 +144,10 @@ public:
                   "variants!");
 #endif
 
+        m_lod = props.get<uint32_t>("lod", 0);
+        if (m_lod > 16)
+            Throw("Level-of-detail values above 16 are not supported!");
+
         auto fs = Thread::thread()->file_resolver();
         fs::path file_path = fs->resolve(props.string("filename"));
         std::string m_name = file_path.filename().string();
@@ -241,6 +255,55 @@ public:
             fail("Empty curve file: no control points were read!");
         finish_curve();
 
+        /* Level-of-detail decimation: resample each curve's control polygon
+           with a power-of-two stride. Endpoints always survive, and each
+           retained control point assumes the maximum radius of the points it
+           replaces to keep silhouettes conservative. */
+        if (m_lod > 0) {
+            size_t stride = (size_t) 1 << m_lod;
+            std::vector<InputPoint3f> lod_vertices;
+            std::vector<InputFloat> lod_radius;
+            std::vector<size_t> lod_1st_idx;
+            lod_vertices.reserve(vertices.size() / stride + 2 * curve_1st_idx.size());
+            lod_radius.reserve(lod_vertices.capacity());
+            lod_1st_idx.reserve(curve_1st_idx.size());
+            segment_count = 0;
+
+            for (size_t i = 0; i < curve_1st_idx.size(); ++i) {
+                size_t begin = curve_1st_idx[i],
+                       end   = i + 1 < curve_1st_idx.size() ? curve_1st_idx[i + 1]
+                                                            : vertices.size(),
+                       count = end - begin;
+
+                size_t kept = (count - 1) / stride + 1;
+                if ((count - 1) % stride != 0)
+                    ++kept; // the final control point is appended separately
+
+                lod_1st_idx.push_back(lod_vertices.size());
+                for (size_t j = 0; j < count; j += stride) {
+                    size_t window_end = j + stride < count ? j + stride : count;
+                    InputFloat r = radius[begin + j];
+                    for (size_t k = j + 1; k < window_end; ++k)
+                        r = dr::maximum(r, radius[begin + k]);
+                    lod_vertices.push_back(vertices[begin + j]);
+                    lod_radius.push_back(r);
+                }
+                if ((count - 1) % stride != 0) {
+                    lod_vertices.push_back(vertices[begin + count - 1]);
+                    lod_radius.push_back(radius[begin + count - 1]);
+                }
+                segment_count += kept - 1;
+            }
+
+            Log(Debug, "\"%s\": level-of-detail %i decimation kept %i of %i "
+                "control points", m_name, m_lod,
+                (ScalarSize) lod_vertices.size(), (ScalarSize) vertices.size());
+
+            vertices      = std::move(lod_vertices);
+            radius        = std::move(lod_radius);
+            curve_1st_idx = std::move(lod_1st_idx);
+        }
+
         m_control_point_count = (ScalarSize) vertices.size();
 
         std::unique_ptr<ScalarIndex[]> indices = std::make_unique<ScalarIndex[]>(segment_count);
@@ -507,6 +570,9 @@ private:
 
     ScalarSize m_control_point_count = 0;
 
+    /// Level-of-detail decimation stride exponent (0 = full resolution)
+    uint32_t m_lod = 0;
+
     mutable UInt32Storage m_indices;
     mutable FloatStorage m_control_points;
 
@@ -11,12 +11,16 @@ public:
     MI_IMPORT_TYPES(BSDF, Medium, Emitter, Sensor, Mesh)
 
     MergeShape(const Properties &props) {
-        std::unordered_map<Key, ref<Mesh>, key_hasher> tbl;
+        std::unordered_map<Key, std::vector<const Mesh *>, key_hasher> tbl;
         size_t visited = 0, ignored = 0;
+        bool weld = props.get<bool>("weld", false);
         Timer timer;
 
+        /* Group the compatible children first; each group is then merged in
+           one pass (offset precomputation followed by concurrent blits into a
+           single allocation) instead of a quadratic chain of pairwise copies */
         for (auto [unused, shape] : props.objects()) {
-            ref<Mesh> mesh(dynamic_cast<Mesh *>(shape.get()));
+            const Mesh *mesh = dynamic_cast<const Mesh *>(shape.get());
 
             if (!mesh || mesh->has_mesh_attributes()) {
                 m_objects.push_back(shape);
@@ -34,17 +38,16 @@ public:
             key.has_texcoords = mesh->has_vertex_texcoords();
             key.has_face_normals = mesh->has_face_normals();
 
-            auto [it, success] = tbl.try_emplace(key, mesh);
-            if (!success)
-                it->second = it->second->merge(mesh);
+            tbl[key].push_back(mesh);
 
             visited++;
         }
 
         for (auto &kv : tbl) {
+            ref<Mesh> merged = Mesh::merge_many(kv.second, weld);
             if (tbl.size() == 1)
-                kv.second->set_id(props.id());
-            m_objects.push_back(kv.second);
+                merged->set_id(props.id());
+            m_objects.push_back(merged);
         }
 
         Log(Info, "Collapsed %zu into %zu meshes. (took %s, %zu objects ignored)",
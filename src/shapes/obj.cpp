@@ -3,11 +3,14 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/mmap.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/profiler.h>
+#include <nanothread/nanothread.h>
 
 #include <array>
+#include <cstring>
 
 
 NAMESPACE_BEGIN(mitsuba)
@@ -41,6 +44,47 @@ Wavefront OBJ mesh loader (:monosp:`obj`)
    - Is the mesh inverted, i.e. should the normal vectors be flipped? (Default:|false|, i.e.
      the normals point outside)
 
+ * - cache
+   - |bool|
+   - When set to |true|, the loader writes a binary snapshot of the parsed
+     geometry to :monosp:`<filename>.cache` on the first load and restores it
+     via memory mapping on subsequent loads, bypassing the text parsing below
+     entirely. The snapshot is invalidated automatically when the contents of
+     the OBJ file or a parameter that affects the generated buffers changes.
+     (Default: |false|)
+
+ * - reorder
+   - |bool|
+   - When set to |true|, the faces are sorted along a Morton curve over their
+     centroids and the vertices are remapped to first-use order after loading,
+     which improves memory locality when shading incoherent hits.
+     (Default: |false|)
+
+ * - compress_attributes
+   - |bool|
+   - Store vertex normals in an octahedral-mapped 2x16 bit encoding and
+     texture coordinates as half precision floats, decoded on the fly during
+     rendering. This halves the memory footprint of these two buffers at a
+     precision loss that is invisible at typical tolerances. Compressed
+     buffers are not editable through ``mi.traverse()``. (Default: |false|)
+
+ * - displacement
+   - |texture|
+   - Optional displacement map. When specified, every face is subdivided
+     ``displacement_levels`` times after loading and each vertex is offset
+     along its shading normal by the texture value at its UV coordinates,
+     scaled by ``displacement_scale``. Requires texture coordinates.
+     (Default: none)
+
+ * - displacement_scale
+   - |float|
+   - Scale factor applied to the displacement map values. (Default: 1)
+
+ * - displacement_levels
+   - |int|
+   - Number of 1:4 subdivision iterations applied before displacing, allowing
+     coarse input meshes to be refined by the renderer. (Default: 0)
+
  * - to_world
    - |transform|
    - Specifies an optional linear object-to-world transformation.
@@ -110,30 +154,14 @@ Loading an ordinary OBJ file is as simple as writing:
 
  */
 
-template <bool Negate, size_t N>
-void advance(const char **start_, const char *end, const char (&delim)[N]) {
-    const char *start = *start_;
-
-    while (true) {
-        bool is_delim = false;
-        for (size_t i = 0; i < N; ++i)
-            if (*start == delim[i])
-                is_delim = true;
-        if ((is_delim ^ Negate) || start == end)
-            break;
-        ++start;
-    }
-
-    *start_ = start;
-}
-
 template <typename Float, typename Spectrum>
 class OBJMesh final : public Mesh<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(Mesh, m_name, m_bbox, m_to_world, m_vertex_count,
                     m_face_count, m_vertex_positions, m_vertex_normals,
                     m_vertex_texcoords, m_faces, m_face_normals,
-                    recompute_vertex_normals, has_vertex_normals, initialize)
+                    recompute_vertex_normals, has_vertex_normals, initialize,
+                    read_cache, write_cache, content_hash)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarSize;
@@ -168,19 +196,6 @@ public:
 
         using ScalarIndex3 = std::array<ScalarIndex, 3>;
 
-        struct VertexBinding {
-            ScalarIndex3 key {{ 0, 0, 0 }};
-            ScalarIndex value { 0 };
-            VertexBinding *next { nullptr };
-        };
-
-        /// Temporary buffers for vertices, normals, and texture coordinates
-        std::vector<InputVector3f> vertices;
-        std::vector<InputNormal3f> normals;
-        std::vector<InputVector2f> texcoords;
-        std::vector<ScalarIndex3> triangles;
-        std::vector<VertexBinding> vertex_map;
-
  #if !defined(_WIN32)
         ref<MemoryMappedFile> mmap = new MemoryMappedFile(file_path);
         size_t file_size           = mmap->size();
@@ -194,152 +209,317 @@ public:
         const char *ptr = tmp.get();
 #endif
 
-        size_t vertex_guess = file_size / 100;
-        const char *eof     = ptr + file_size;
-        char buf[1025];
-
-        vertices.reserve(vertex_guess);
-        normals.reserve(vertex_guess);
-        texcoords.reserve(vertex_guess);
-        triangles.reserve(vertex_guess * 2);
-        vertex_map.resize(vertex_guess);
-
-        ScalarIndex vertex_ctr = 0;
+        const char *eof = ptr + file_size;
 
         Timer timer;
 
-        while (ptr < eof) {
-            // Determine the offset of the next newline
-            const char *next = ptr;
-            advance<false>(&next, eof, "\n");
+        /* An optional binary snapshot of the parsed geometry bypasses the
+           text parsing below on repeated loads. It is keyed by a hash of the
+           file contents and of the parameters that affect the generated
+           buffers; anything applied in initialize() (reordering, attribute
+           compression, displacement, ...) re-runs on the restored data and
+           hence needs no key. */
+        bool cache = props.get<bool>("cache", false);
+        fs::path cache_path;
+        uint64_t cache_hash = 0;
+        if (cache) {
+            cache_path = fs::path(file_path.string() + ".cache");
+            cache_hash = content_hash(ptr, file_size);
+            auto to_world_matrix = m_to_world.scalar().matrix;
+            cache_hash = content_hash(&to_world_matrix,
+                                      sizeof(to_world_matrix), cache_hash);
+            uint8_t param_bits = (flip_tex_coords ? 1 : 0) |
+                                 (m_face_normals ? 2 : 0);
+            cache_hash = content_hash(&param_bits, 1, cache_hash);
+
+            if (read_cache(cache_path, cache_hash)) {
+                Log(Debug, "\"%s\": restored %i faces, %i vertices from "
+                    "geometry snapshot (took %s)", m_name, m_face_count,
+                    m_vertex_count, util::time_string((float) timer.value()));
+                initialize();
+                return;
+            }
+        }
+
+        /* The file is parsed in two phases: the expensive text scanning
+           (dominated by floating point parsing) runs in parallel over chunks
+           that are aligned to line boundaries, with each chunk emitting
+           vertex data and triangulated corner references into local buffers.
+           A brief serial pass then deduplicates the corner references, which
+           must observe them in file order to assign stable vertex indices. */
+
+        struct Chunk {
+            const char *begin = nullptr;
+            const char *end = nullptr;
+            std::vector<InputVector3f> vertices;
+            std::vector<InputNormal3f> normals;
+            std::vector<InputVector2f> texcoords;
+            /// Three (position, texcoord, normal) index triplets per triangle
+            std::vector<ScalarIndex3> corners;
+            ScalarBoundingBox3f bbox;
+            std::string error;
+        };
 
-            // Copy buf into a 0-terminated buffer
-            size_t size = next - ptr;
-            if (size >= sizeof(buf) - 1)
-                fail("file contains an excessively long line! (%i characters)", size);
-            memcpy(buf, ptr, size);
-            buf[size] = '\0';
+        size_t chunk_size  = 4 * 1024 * 1024,
+               chunk_count = file_size == 0 ? 0
+                           : (file_size + chunk_size - 1) / chunk_size;
+
+        std::vector<Chunk> chunks(chunk_count);
+        for (size_t i = 0; i < chunk_count; ++i) {
+            // Nominal chunk boundaries, moved forward to the next line start
+            const char *p = ptr + i * chunk_size;
+            if (i > 0) {
+                p = (const char *) memchr(p, '\n', eof - p);
+                p = p ? p + 1 : eof;
+            }
+            chunks[i].begin = p;
+            if (i > 0)
+                chunks[i - 1].end = p;
+        }
+        if (chunk_count > 0)
+            chunks[chunk_count - 1].end = eof;
 
-            // Skip whitespace
-            const char *cur = buf, *eol = buf + size;
-            advance<true>(&cur, eol, " \t\r");
+        auto to_world = m_to_world.scalar();
 
-            bool parse_error = false;
-            if (cur[0] == 'v' && (cur[1] == ' ' || cur[1] == '\t')) {
+        auto parse_line = [&](Chunk &chunk, const char *cur,
+                              const char *eol) -> bool {
+            if (cur + 1 < eol && cur[0] == 'v' &&
+                (cur[1] == ' ' || cur[1] == '\t')) {
                 // Vertex position
                 InputPoint3f p;
                 cur += 2;
-                for (size_t i = 0; i < 3; ++i) {
-                    const char *orig = cur;
-                    p[i] = string::strtof<InputFloat>(cur, (char **) &cur);
-                    parse_error |= cur == orig;
+                for (size_t i = 0; i < 3; ++i)
+                    p[i] = string::parse_float<InputFloat>(cur, eol,
+                                                           (char **) &cur);
+                p = to_world.transform_affine(p);
+                if (unlikely(!all(dr::isfinite(p)))) {
+                    chunk.error = "mesh contains invalid vertex position data";
+                    return false;
                 }
-                p = m_to_world.scalar().transform_affine(p);
-                if (unlikely(!all(dr::isfinite(p))))
-                    fail("mesh contains invalid vertex position data");
-                m_bbox.expand(p);
-                vertices.push_back(p);
-            } else if (cur[0] == 'v' && cur[1] == 'n' && (cur[2] == ' ' || cur[2] == '\t')) {
+                chunk.bbox.expand(p);
+                chunk.vertices.push_back(p);
+            } else if (cur + 2 < eol && cur[0] == 'v' && cur[1] == 'n' &&
+                       (cur[2] == ' ' || cur[2] == '\t')) {
                 if (!m_face_normals) {
-                    cur += 3;
                     // Vertex normal
                     InputNormal3f n;
-                    for (size_t i = 0; i < 3; ++i) {
-                        const char *orig = cur;
-                        n[i] = string::strtof<InputFloat>(cur, (char **) &cur);
-                        parse_error |= cur == orig;
+                    cur += 3;
+                    for (size_t i = 0; i < 3; ++i)
+                        n[i] = string::parse_float<InputFloat>(cur, eol,
+                                                               (char **) &cur);
+                    n = dr::normalize(to_world.transform_affine(n));
+                    if (unlikely(!all(dr::isfinite(n)))) {
+                        chunk.error =
+                            "mesh contains invalid vertex normal data";
+                        return false;
                     }
-                    n = dr::normalize(m_to_world.scalar().transform_affine(n));
-                    if (unlikely(!all(dr::isfinite(n))))
-                        fail("mesh contains invalid vertex normal data");
-                    normals.push_back(n);
+                    chunk.normals.push_back(n);
                 }
-            } else if (cur[0] == 'v' && cur[1] == 't' && (cur[2] == ' ' || cur[2] == '\t')) {
+            } else if (cur + 2 < eol && cur[0] == 'v' && cur[1] == 't' &&
+                       (cur[2] == ' ' || cur[2] == '\t')) {
                 // Texture coordinate
                 InputVector2f uv;
                 cur += 3;
-                for (size_t i = 0; i < 2; ++i) {
-                    const char *orig = cur;
-                    uv[i] = string::strtof<InputFloat>(cur, (char **) &cur);
-                    parse_error |= cur == orig;
-                }
+                for (size_t i = 0; i < 2; ++i)
+                    uv[i] = string::parse_float<InputFloat>(cur, eol,
+                                                            (char **) &cur);
                 if (flip_tex_coords)
                     uv.y() = 1.f - uv.y();
 
-                texcoords.push_back(uv);
-            } else if (cur[0] == 'f' && (cur[1] == ' ' || cur[1] == '\t')) {
+                chunk.texcoords.push_back(uv);
+            } else if (cur + 1 < eol && cur[0] == 'f' &&
+                       (cur[1] == ' ' || cur[1] == '\t')) {
                 // Face specification
                 cur += 2;
                 size_t vertex_index = 0;
                 size_t type_index = 0;
-                ScalarIndex3 key {{ (ScalarIndex) 0, (ScalarIndex) 0, (ScalarIndex) 0 }};
-                ScalarIndex3 tri;
+                ScalarIndex3 key {{ 0, 0, 0 }}, first {{ 0, 0, 0 }},
+                             prev {{ 0, 0, 0 }};
 
                 while (true) {
-                    const char *next2;
-                    ScalarIndex value = (ScalarIndex) strtoul(cur, (char **) &next2, 10);
-                    if (cur == next2)
+                    while (cur < eol &&
+                           (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+                        ++cur;
+
+                    // Branch-light unsigned integer parsing
+                    const char *orig = cur;
+                    ScalarIndex value = 0;
+                    while (cur < eol && *cur >= '0' && *cur <= '9')
+                        value = value * 10 + ScalarIndex(*cur++ - '0');
+                    if (cur == orig)
                         break;
 
-                    if (type_index < 3) {
+                    if (type_index < 3)
                         key[type_index] = value;
-                    } else {
-                        parse_error = true;
-                        break;
-                    }
+                    else
+                        return false;
 
-                    while (*next2 == '/') {
+                    while (cur < eol && *cur == '/') {
                         type_index++;
-                        next2++;
+                        cur++;
                     }
 
-                    if (*next2 == ' ' || *next2 == '\t' || *next2 == '\0' || *next2 == '\r') {
+                    if (cur == eol || *cur == ' ' || *cur == '\t' ||
+                        *cur == '\r') {
                         type_index = 0;
-                        size_t map_index = key[0] - 1;
-
-                        if (unlikely(map_index >= vertices.size()))
-                            fail("reference to invalid vertex %i!", key[0]);
-                        if (unlikely(vertex_map.size() < vertices.size()))
-                            vertex_map.resize(vertices.size());
-
-                        // Hash table lookup
-                        VertexBinding *entry = &vertex_map[map_index];
-                        while (entry->key != key && entry->next != nullptr)
-                            entry = entry->next;
-
-                        ScalarIndex id;
-                        if (entry->key == key) {
-                            // Hit
-                            id = entry->value;
-                        } else {
-                            // Miss
-                            if (entry->key != ScalarIndex3{{0, 0, 0}}) {
-                                entry->next = new VertexBinding();
-                                entry = entry->next;
-                            }
-                            entry->key = key;
-                            id = entry->value = vertex_ctr++;
-                        }
 
-                        if (vertex_index < 3) {
-                            tri[vertex_index] = id;
-                        } else {
-                            tri[1] = tri[2];
-                            tri[2] = id;
+                        // Corner complete; fan-triangulate polygons
+                        if (vertex_index == 0)
+                            first = key;
+                        if (vertex_index >= 2) {
+                            chunk.corners.push_back(first);
+                            chunk.corners.push_back(prev);
+                            chunk.corners.push_back(key);
                         }
+                        prev = key;
                         vertex_index++;
+                    }
+                }
 
-                        if (vertex_index >= 3)
-                            triangles.push_back(tri);
+                /* The corner loop stops at the first character that is
+                   neither a digit nor part of a valid 'v/vt/vn' triplet.
+                   Anything left over is a parse error rather than a face to
+                   drop silently -- notably negative (relative) OBJ indices,
+                   which this parser does not support. */
+                if (cur != eol) {
+                    if (*cur == '-')
+                        chunk.error = "negative (relative) face indices "
+                                      "are not supported";
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        dr::parallel_for(
+            dr::blocked_range<size_t>(0, chunk_count, 1),
+            [&](const dr::blocked_range<size_t> &range) {
+            for (size_t ci = range.begin(); ci != range.end(); ++ci) {
+                Chunk &chunk = chunks[ci];
+                const char *ptr2 = chunk.begin;
+                std::string last_line;
+
+                while (ptr2 < chunk.end) {
+                    const char *nl = (const char *) memchr(
+                        ptr2, '\n', chunk.end - ptr2);
+                    const char *line = ptr2, *eol = nl ? nl : chunk.end;
+
+                    if (unlikely(!nl && eof == chunk.end)) {
+                        /* The final line lacks a trailing newline: parse a
+                           copy so that the float parser (which skips leading
+                           whitespace before checking bounds) can never touch
+                           memory past the mapped file */
+                        last_line = std::string(ptr2, eol);
+                        line = last_line.data();
+                        eol  = line + last_line.size();
+                    }
+
+                    // Skip whitespace
+                    const char *cur = line;
+                    while (cur < eol &&
+                           (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+                        ++cur;
+
+                    bool parse_error;
+                    try {
+                        parse_error = !parse_line(chunk, cur, eol);
+                    } catch (const std::exception &) {
+                        parse_error = true;
                     }
 
-                    cur = next2;
+                    if (unlikely(parse_error)) {
+                        if (chunk.error.empty())
+                            chunk.error = tfm::format(
+                                "could not parse line \"%s\"",
+                                std::string(line, eol));
+                        return;
+                    }
+
+                    ptr2 = (nl ? nl : chunk.end) + 1;
                 }
             }
+        });
+
+        size_t total_vertices = 0, total_normals = 0,
+               total_texcoords = 0, total_corners = 0;
+        for (Chunk &chunk : chunks) {
+            if (unlikely(!chunk.error.empty()))
+                fail("%s", chunk.error);
+            m_bbox.expand(chunk.bbox);
+            total_vertices  += chunk.vertices.size();
+            total_normals   += chunk.normals.size();
+            total_texcoords += chunk.texcoords.size();
+            total_corners   += chunk.corners.size();
+        }
+
+        // Concatenate the per-chunk buffers (in file order)
+        std::vector<InputVector3f> vertices;
+        std::vector<InputNormal3f> normals;
+        std::vector<InputVector2f> texcoords;
+        vertices.reserve(total_vertices);
+        normals.reserve(total_normals);
+        texcoords.reserve(total_texcoords);
+        for (Chunk &chunk : chunks) {
+            vertices.insert(vertices.end(), chunk.vertices.begin(),
+                            chunk.vertices.end());
+            normals.insert(normals.end(), chunk.normals.begin(),
+                           chunk.normals.end());
+            texcoords.insert(texcoords.end(), chunk.texcoords.begin(),
+                             chunk.texcoords.end());
+        }
+
+        /* Deduplicate (position, texcoord, normal) triplets via a hash table
+           with exactly one head slot per referenced position and an
+           index-linked overflow arena for positions that are used with
+           several texcoord/normal combinations */
+        struct VertexBinding {
+            ScalarIndex3 key {{ 0, 0, 0 }};
+            ScalarIndex value { 0 };
+            uint32_t next { 0 }; // 1-based index into 'overflow', 0 = none
+        };
+
+        std::vector<VertexBinding> vertex_map(vertices.size());
+        std::vector<VertexBinding> overflow;
+        std::vector<ScalarIndex3> triangles;
+        triangles.reserve(total_corners / 3);
+
+        ScalarIndex vertex_ctr = 0;
+
+        auto lookup = [&](const ScalarIndex3 &key) -> ScalarIndex {
+            size_t map_index = key[0] - 1;
+            if (unlikely(key[0] == 0 || map_index >= vertices.size()))
+                fail("reference to invalid vertex %i!", key[0]);
+
+            uint32_t parent = 0; // overflow slot of 'entry' if nonzero
+            VertexBinding *entry = &vertex_map[map_index];
+            while (entry->key != key && entry->next != 0) {
+                parent = entry->next;
+                entry  = &overflow[parent - 1];
+            }
+
+            if (entry->key == key) // Hit
+                return entry->value;
 
-            if (unlikely(parse_error))
-                fail("could not parse line \"%s\"", buf);
-            ptr = next + 1;
+            // Miss
+            if (entry->key != ScalarIndex3{{0, 0, 0}}) {
+                overflow.push_back(VertexBinding());
+                // Re-resolve: push_back may have reallocated 'overflow'
+                entry = parent ? &overflow[parent - 1] : &vertex_map[map_index];
+                entry->next = (uint32_t) overflow.size();
+                entry = &overflow.back();
+            }
+            entry->key = key;
+            return entry->value = vertex_ctr++;
+        };
+
+        ScalarIndex3 tri;
+        for (Chunk &chunk : chunks) {
+            for (size_t i = 0; i < chunk.corners.size(); i += 3) {
+                tri[0] = lookup(chunk.corners[i]);
+                tri[1] = lookup(chunk.corners[i + 1]);
+                tri[2] = lookup(chunk.corners[i + 2]);
+                triangles.push_back(tri);
+            }
         }
 
         m_vertex_count = vertex_ctr;
@@ -349,34 +529,36 @@ public:
         std::unique_ptr<float[]> vertex_normals(new float[m_vertex_count * 3]);
         std::unique_ptr<float[]> vertex_texcoords(new float[m_vertex_count * 2]);
 
-        for (const auto& v_ : vertex_map) {
-            const VertexBinding *v = &v_;
-
-            while (v && v->key != ScalarIndex3{{0, 0, 0}}) {
-                InputFloat* position_ptr = vertex_positions.get() + v->value * 3;
-                InputFloat* normal_ptr   = vertex_normals.get() + v->value * 3;
-                InputFloat* texcoord_ptr = vertex_texcoords.get() + v->value * 2;
-                auto key = v->key;
+        auto store_vertex = [&](const VertexBinding &v) {
+            InputFloat* position_ptr = vertex_positions.get() + v.value * 3;
+            InputFloat* normal_ptr   = vertex_normals.get() + v.value * 3;
+            InputFloat* texcoord_ptr = vertex_texcoords.get() + v.value * 2;
+            auto key = v.key;
 
-                dr::store(position_ptr, vertices[key[0] - 1]);
+            dr::store(position_ptr, vertices[key[0] - 1]);
 
-                if (key[1]) {
-                    size_t map_index = key[1] - 1;
-                    if (unlikely(map_index >= texcoords.size()))
-                        fail("reference to invalid texture coordinate %i!", key[1]);
-                    dr::store(texcoord_ptr, texcoords[map_index]);
-                }
-
-                if (!m_face_normals && key[2]) {
-                    size_t map_index = key[2] - 1;
-                    if (unlikely(map_index >= normals.size()))
-                        fail("reference to invalid normal %i!", key[2]);
-                    dr::store(normal_ptr, normals[key[2] - 1]);
-                }
+            if (key[1]) {
+                size_t map_index = key[1] - 1;
+                if (unlikely(map_index >= texcoords.size()))
+                    fail("reference to invalid texture coordinate %i!", key[1]);
+                dr::store(texcoord_ptr, texcoords[map_index]);
+            }
 
-                v = v->next;
+            if (!m_face_normals && key[2]) {
+                size_t map_index = key[2] - 1;
+                if (unlikely(map_index >= normals.size()))
+                    fail("reference to invalid normal %i!", key[2]);
+                dr::store(normal_ptr, normals[key[2] - 1]);
             }
-        }
+        };
+
+        /* Every deduplicated vertex occurs exactly once in the hash table
+           heads or in the overflow arena, so a flat sweep suffices */
+        for (const auto &v : vertex_map)
+            if (v.key != ScalarIndex3{{0, 0, 0}})
+                store_vertex(v);
+        for (const auto &v : overflow)
+            store_vertex(v);
 
         m_faces = dr::load<DynamicBuffer<UInt32>>(triangles.data(), m_face_count * 3);
         m_vertex_positions = dr::load<FloatStorage>(vertex_positions.get(), m_vertex_count * 3);
@@ -405,6 +587,17 @@ public:
                 util::time_string((float) timer2.value()));
         }
 
+        if (cache) {
+            try {
+                write_cache(cache_path, cache_hash);
+                Log(Debug, "\"%s\": wrote geometry snapshot to \"%s\"", m_name,
+                    cache_path.string());
+            } catch (const std::exception &e) {
+                Log(Warn, "\"%s\": could not write geometry snapshot: %s",
+                    m_name, e.what());
+            }
+        }
+
         initialize();
     }
 
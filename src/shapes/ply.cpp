@@ -3,13 +3,17 @@
 #include <mitsuba/core/mstream.h>
 #include <mitsuba/core/fresolver.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/profiler.h>
 #include <drjit/half.h>
+#include <nanothread/nanothread.h>
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
 #include <fstream>
+#include <mutex>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -38,6 +42,38 @@ PLY (Stanford Triangle Format) mesh loader (:monosp:`ply`)
    - Is the mesh inverted, i.e. should the normal vectors be flipped? (Default:|false|, i.e.
      the normals point outside)
 
+ * - reorder
+   - |bool|
+   - When set to |true|, the faces are sorted along a Morton curve over their
+     centroids and the vertices are remapped to first-use order after loading,
+     which improves memory locality when shading incoherent hits.
+     (Default: |false|)
+
+ * - compress_attributes
+   - |bool|
+   - Store vertex normals in an octahedral-mapped 2x16 bit encoding and
+     texture coordinates as half precision floats, decoded on the fly during
+     rendering. This halves the memory footprint of these two buffers at a
+     precision loss that is invisible at typical tolerances. Compressed
+     buffers are not editable through ``mi.traverse()``. (Default: |false|)
+
+ * - displacement
+   - |texture|
+   - Optional displacement map. When specified, every face is subdivided
+     ``displacement_levels`` times after loading and each vertex is offset
+     along its shading normal by the texture value at its UV coordinates,
+     scaled by ``displacement_scale``. Requires texture coordinates.
+     (Default: none)
+
+ * - displacement_scale
+   - |float|
+   - Scale factor applied to the displacement map values. (Default: 1)
+
+ * - displacement_levels
+   - |int|
+   - Number of 1:4 subdivision iterations applied before displacing, allowing
+     coarse input meshes to be refined by the renderer. (Default: 0)
+
  * - to_world
    - |transform|
    - Specifies an optional linear object-to-world transformation.
@@ -162,7 +198,7 @@ public:
     };
 
     PLYMesh(const Properties &props) : Base(props) {
-        /// Process vertex/index records in large batches
+        /// Granularity of the chunk-parallel record conversion
         constexpr size_t elements_per_packet = 1024;
 
         auto fs = Thread::thread()->file_resolver();
@@ -190,7 +226,19 @@ public:
                         "\"%s\": performance warning -- this file uses the ASCII PLY format, which "
                         "is slow to parse. Consider converting it to the binary PLY format.",
                         m_name);
-                stream = parse_ascii((FileStream *) stream.get(), header.elements);
+
+                /* Try the chunk-parallel decoder first; it requires the
+                   customary one-record-per-line layout. Files that wrap
+                   records across lines fall back to the serial token
+                   parser. */
+                size_t body_offset = stream->tell();
+                ref<Stream> decoded =
+                    parse_ascii_parallel((FileStream *) stream.get(), header.elements);
+                if (!decoded) {
+                    stream->seek(body_offset);
+                    decoded = parse_ascii((FileStream *) stream.get(), header.elements);
+                }
+                stream = decoded;
             }
         } catch (const std::exception &e) {
             fail(e.what());
@@ -262,70 +310,89 @@ public:
                 std::unique_ptr<float[]> vertex_normals(new float[m_vertex_count * 3]);
                 std::unique_ptr<float[]> vertex_texcoords(new float[m_vertex_count * 2]);
 
-                InputFloat* position_ptr = vertex_positions.get();
-                InputFloat *normal_ptr   = vertex_normals.get();
-                InputFloat *texcoord_ptr = vertex_texcoords.get();
-
-                size_t packet_count     = el.count / elements_per_packet;
-                size_t remainder_count  = el.count % elements_per_packet;
-                size_t i_packet_size    = i_struct_size * elements_per_packet;
-                size_t i_remainder_size = i_struct_size * remainder_count;
-                size_t o_packet_size    = o_struct_size * elements_per_packet;
-
-                std::unique_ptr<uint8_t[]> buf(new uint8_t[i_packet_size]);
-                std::unique_ptr<uint8_t[]> buf_o(new uint8_t[o_packet_size]);
-
-                for (size_t i = 0; i <= packet_count; ++i) {
-                    uint8_t *target = (uint8_t *) buf_o.get();
-                    size_t psize = (i != packet_count) ? i_packet_size : i_remainder_size;
-                    size_t count = (i != packet_count) ? elements_per_packet : remainder_count;
-                    stream->read(buf.get(), psize);
-                    if (unlikely(!conv->convert(count, buf.get(), buf_o.get())))
-                        fail("incompatible contents -- is this a triangle mesh?");
-
-                    for (size_t j = 0; j < count; ++j) {
-                        InputPoint3f p = dr::load<InputPoint3f>(target);
-                        p = m_to_world.scalar().transform_affine(p);
-                        if (unlikely(!all(dr::isfinite(p))))
-                            fail("mesh contains invalid vertex position data");
-                        m_bbox.expand(p);
-                        dr::store(position_ptr, p);
-                        position_ptr += 3;
-
-                        if (has_vertex_normals) {
-                            InputNormal3f n = dr::load<InputNormal3f>(
-                                target + sizeof(InputFloat) * 3);
-                            n = dr::normalize(m_to_world.scalar().transform_affine(n));
-                            dr::store(normal_ptr, n);
-                            normal_ptr += 3;
+                /* The element body has a fixed record size, so after one
+                   bulk read it can be converted and post-processed
+                   chunk-parallel: every range runs the struct converter
+                   into a local scratch buffer and writes its records at
+                   their global offsets. Only the bounding box (and a
+                   potential error) need synchronization. */
+                size_t body_size = i_struct_size * el.count;
+                std::unique_ptr<uint8_t[]> body(new uint8_t[body_size]);
+                stream->read(body.get(), body_size);
+
+                std::mutex mutex;
+                std::string error;
+                auto to_world = m_to_world.scalar();
+
+                dr::parallel_for(
+                    dr::blocked_range<size_t>(0, el.count, elements_per_packet),
+                    [&](const dr::blocked_range<size_t> &range) {
+                        size_t count = range.end() - range.begin();
+                        std::unique_ptr<uint8_t[]> buf_o(
+                            new uint8_t[o_struct_size * count]);
+
+                        if (unlikely(!conv->convert(
+                                count, body.get() + range.begin() * i_struct_size,
+                                buf_o.get()))) {
+                            std::lock_guard<std::mutex> guard(mutex);
+                            if (error.empty())
+                                error = "incompatible contents -- is this a triangle mesh?";
+                            return;
                         }
 
-                        if (has_vertex_texcoords) {
-                            InputVector2f uv = dr::load<InputVector2f>(
-                                target + (m_face_normals
-                                              ? sizeof(InputFloat) * 3
-                                              : sizeof(InputFloat) * 6));
-                            dr::store(texcoord_ptr, uv);
-                            texcoord_ptr += 2;
-                        }
+                        ScalarBoundingBox3f bbox;
+                        const uint8_t *target = buf_o.get();
+
+                        for (size_t j = range.begin(); j != range.end(); ++j) {
+                            InputPoint3f p = dr::load<InputPoint3f>(target);
+                            p = to_world.transform_affine(p);
+                            if (unlikely(!all(dr::isfinite(p)))) {
+                                std::lock_guard<std::mutex> guard(mutex);
+                                if (error.empty())
+                                    error = "mesh contains invalid vertex position data";
+                                return;
+                            }
+                            bbox.expand(p);
+                            dr::store(vertex_positions.get() + j * 3, p);
+
+                            if (has_vertex_normals) {
+                                InputNormal3f n = dr::load<InputNormal3f>(
+                                    target + sizeof(InputFloat) * 3);
+                                n = dr::normalize(to_world.transform_affine(n));
+                                dr::store(vertex_normals.get() + j * 3, n);
+                            }
+
+                            if (has_vertex_texcoords) {
+                                InputVector2f uv = dr::load<InputVector2f>(
+                                    target + (m_face_normals
+                                                  ? sizeof(InputFloat) * 3
+                                                  : sizeof(InputFloat) * 6));
+                                dr::store(vertex_texcoords.get() + j * 2, uv);
+                            }
+
+                            size_t target_offset =
+                                sizeof(InputFloat) *
+                                (!m_face_normals
+                                     ? (has_vertex_texcoords ? 8 : 6)
+                                     : (has_vertex_texcoords ? 5 : 3));
+
+                            for (size_t k = 0; k < vertex_attributes_descriptors.size(); ++k) {
+                                auto& descr = vertex_attributes_descriptors[k];
+                                memcpy(descr.buf.data() + j * descr.dim,
+                                       target + target_offset,
+                                       descr.dim * sizeof(InputFloat));
+                                target_offset += descr.dim * sizeof(InputFloat);
+                            }
 
-                        size_t target_offset =
-                            sizeof(InputFloat) *
-                            (!m_face_normals
-                                 ? (has_vertex_texcoords ? 8 : 6)
-                                 : (has_vertex_texcoords ? 5 : 3));
-
-                        for (size_t k = 0; k < vertex_attributes_descriptors.size(); ++k) {
-                            auto& descr = vertex_attributes_descriptors[k];
-                            memcpy(descr.buf.data() + (i * elements_per_packet + j) * descr.dim,
-                                   target + target_offset,
-                                   descr.dim * sizeof(InputFloat));
-                            target_offset += descr.dim * sizeof(InputFloat);
+                            target += o_struct_size;
                         }
 
-                        target += o_struct_size;
-                    }
-                }
+                        std::lock_guard<std::mutex> guard(mutex);
+                        m_bbox.expand(bbox);
+                    });
+
+                if (unlikely(!error.empty()))
+                    fail(error.c_str());
 
                 for (auto& descr: vertex_attributes_descriptors)
                     add_attribute(descr.name, descr.dim, descr.buf);
@@ -374,43 +441,52 @@ public:
                     descr.buf.resize(m_face_count * descr.dim);
 
                 std::unique_ptr<uint32_t[]> faces(new uint32_t[m_face_count * 3]);
-                ScalarIndex* face_ptr = faces.get();
-
-                size_t packet_count     = el.count / elements_per_packet;
-                size_t remainder_count  = el.count % elements_per_packet;
-                size_t i_packet_size    = i_struct_size * elements_per_packet;
-                size_t i_remainder_size = i_struct_size * remainder_count;
-                size_t o_packet_size    = o_struct_size * elements_per_packet;
-
-                std::unique_ptr<uint8_t[]> buf(new uint8_t[i_packet_size]);
-                std::unique_ptr<uint8_t[]> buf_o(new uint8_t[o_packet_size]);
-
-                for (size_t i = 0; i <= packet_count; ++i) {
-                    uint8_t *target = (uint8_t *) buf_o.get();
-                    size_t psize = (i != packet_count) ? i_packet_size : i_remainder_size;
-                    size_t count = (i != packet_count) ? elements_per_packet : remainder_count;
-
-                    stream->read(buf.get(), psize);
-                    if (unlikely(!conv->convert(count, buf.get(), buf_o.get())))
-                        fail("incompatible contents -- is this a triangle mesh?");
-
-                    for (size_t j = 0; j < count; ++j) {
-                        ScalarIndex3 fi = dr::load<ScalarIndex3>(target);
-                        dr::store(face_ptr, fi);
-                        face_ptr += 3;
-
-                        size_t target_offset = sizeof(InputFloat) * 3;
-                        for (size_t k = 0; k < face_attributes_descriptors.size(); ++k) {
-                            auto& descr = face_attributes_descriptors[k];
-                            memcpy(descr.buf.data() + (i * elements_per_packet + j) * descr.dim,
-                                   target + target_offset,
-                                   descr.dim * sizeof(InputFloat));
-                            target_offset += descr.dim * sizeof(InputFloat);
+
+                // Bulk read followed by a chunk-parallel conversion, as above
+                size_t body_size = i_struct_size * el.count;
+                std::unique_ptr<uint8_t[]> body(new uint8_t[body_size]);
+                stream->read(body.get(), body_size);
+
+                std::mutex mutex;
+                std::string error;
+
+                dr::parallel_for(
+                    dr::blocked_range<size_t>(0, el.count, elements_per_packet),
+                    [&](const dr::blocked_range<size_t> &range) {
+                        size_t count = range.end() - range.begin();
+                        std::unique_ptr<uint8_t[]> buf_o(
+                            new uint8_t[o_struct_size * count]);
+
+                        if (unlikely(!conv->convert(
+                                count, body.get() + range.begin() * i_struct_size,
+                                buf_o.get()))) {
+                            std::lock_guard<std::mutex> guard(mutex);
+                            if (error.empty())
+                                error = "incompatible contents -- is this a triangle mesh?";
+                            return;
                         }
 
-                        target += o_struct_size;
-                    }
-                }
+                        const uint8_t *target = buf_o.get();
+
+                        for (size_t j = range.begin(); j != range.end(); ++j) {
+                            ScalarIndex3 fi = dr::load<ScalarIndex3>(target);
+                            dr::store(faces.get() + j * 3, fi);
+
+                            size_t target_offset = sizeof(InputFloat) * 3;
+                            for (size_t k = 0; k < face_attributes_descriptors.size(); ++k) {
+                                auto& descr = face_attributes_descriptors[k];
+                                memcpy(descr.buf.data() + j * descr.dim,
+                                       target + target_offset,
+                                       descr.dim * sizeof(InputFloat));
+                                target_offset += descr.dim * sizeof(InputFloat);
+                            }
+
+                            target += o_struct_size;
+                        }
+                    });
+
+                if (unlikely(!error.empty()))
+                    fail(error.c_str());
 
                 for (auto& descr: face_attributes_descriptors)
                     add_attribute(descr.name, descr.dim, descr.buf);
@@ -579,6 +655,182 @@ private:
         return header;
     }
 
+    /// Decode a single whitespace-separated ASCII record into its binary form
+    bool parse_record(const Struct &layout, const char *cur, const char *eol,
+                      uint8_t *dst) {
+        auto skip_ws = [&]() {
+            while (cur < eol && (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+                ++cur;
+        };
+
+        auto parse_int = [&](int64_t &value) -> bool {
+            skip_ws();
+            bool negative = false;
+            if (cur < eol && (*cur == '-' || *cur == '+')) {
+                negative = *cur == '-';
+                ++cur;
+            }
+            const char *orig = cur;
+            uint64_t mag = 0;
+            while (cur < eol && *cur >= '0' && *cur <= '9')
+                mag = mag * 10 + uint64_t(*cur++ - '0');
+            if (cur == orig)
+                return false;
+            value = negative ? -(int64_t) mag : (int64_t) mag;
+            return true;
+        };
+
+        for (const Struct::Field &field : layout) {
+            uint8_t *p = dst + field.offset;
+            int64_t iv = 0;
+
+            switch (field.type) {
+                case Struct::Type::Int8:
+                    if (!parse_int(iv) || iv < -128 || iv > 127)
+                        return false;
+                    *((int8_t *) p) = (int8_t) iv;
+                    break;
+
+                case Struct::Type::UInt8:
+                    if (!parse_int(iv) || iv < 0 || iv > 255)
+                        return false;
+                    *((uint8_t *) p) = (uint8_t) iv;
+                    break;
+
+                case Struct::Type::Int16:
+                case Struct::Type::UInt16:
+                    if (!parse_int(iv))
+                        return false;
+                    *((uint16_t *) p) = (uint16_t) iv;
+                    break;
+
+                case Struct::Type::Int32:
+                case Struct::Type::UInt32:
+                    if (!parse_int(iv))
+                        return false;
+                    *((uint32_t *) p) = (uint32_t) iv;
+                    break;
+
+                case Struct::Type::Int64:
+                case Struct::Type::UInt64:
+                    if (!parse_int(iv))
+                        return false;
+                    *((uint64_t *) p) = (uint64_t) iv;
+                    break;
+
+                case Struct::Type::Float16:
+                    *((uint16_t *) p) = dr::half::float32_to_float16(
+                        string::parse_float<float>(cur, eol, (char **) &cur));
+                    break;
+
+                case Struct::Type::Float32:
+                    *((float *) p) =
+                        string::parse_float<float>(cur, eol, (char **) &cur);
+                    break;
+
+                case Struct::Type::Float64:
+                    *((double *) p) =
+                        string::parse_float<double>(cur, eol, (char **) &cur);
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        // The line must hold exactly one record
+        skip_ws();
+        return cur == eol;
+    }
+
+    /**
+     * \brief Chunk-parallel replacement for \ref parse_ascii()
+     *
+     * Decodes the ASCII element bodies into the equivalent binary record
+     * stream using all cores. The fast path relies on the customary
+     * one-record-per-line layout; when the file deviates from it (e.g.
+     * records wrapped across several lines), this method returns \c nullptr
+     * and the caller falls back to the serial token parser.
+     */
+    ref<Stream> parse_ascii_parallel(FileStream *in,
+                                     const std::vector<PLYElement> &elements) {
+        size_t body_size = in->size() - in->tell();
+
+        /* One extra zero byte so that the float parser (which skips leading
+           whitespace before checking bounds) can never touch memory past a
+           final line lacking a trailing newline */
+        std::unique_ptr<char[]> text(new char[body_size + 1]);
+        in->read(text.get(), body_size);
+        text[body_size] = '\0';
+
+        size_t record_count = 0, out_size = 0;
+        for (auto const &el : elements) {
+            record_count += el.count;
+            out_size     += el.count * el.struct_->size();
+        }
+
+        // Record the extents of all non-blank lines
+        std::vector<std::pair<const char *, const char *>> lines;
+        lines.reserve(record_count);
+
+        const char *ptr = text.get(), *eof = ptr + body_size;
+        while (ptr < eof) {
+            const char *nl  = (const char *) memchr(ptr, '\n', eof - ptr);
+            const char *eol = nl ? nl : eof;
+            const char *cur = ptr;
+            while (cur < eol && (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+                ++cur;
+            if (cur < eol)
+                lines.push_back({ ptr, eol });
+            ptr = eol + 1;
+        }
+
+        // Also covers trailing content, which the serial parser reports
+        if (lines.size() != record_count)
+            return nullptr;
+
+        std::unique_ptr<uint8_t[]> out(new uint8_t[out_size]);
+        std::atomic<bool> failed(false);
+
+        size_t line_base = 0, out_base = 0;
+        for (auto const &el : elements) {
+            size_t struct_size = el.struct_->size();
+            const Struct *layout = el.struct_.get();
+
+            dr::parallel_for(
+                dr::blocked_range<size_t>(0, el.count, 4096),
+                [&, line_base, out_base, struct_size,
+                 layout](const dr::blocked_range<size_t> &range) {
+                    for (size_t i = range.begin(); i != range.end(); ++i) {
+                        auto [cur, eol] = lines[line_base + i];
+                        bool ok;
+                        try {
+                            ok = parse_record(*layout, cur, eol,
+                                              out.get() + out_base +
+                                                  i * struct_size);
+                        } catch (const std::exception &) {
+                            ok = false;
+                        }
+                        if (unlikely(!ok)) {
+                            failed.store(true, std::memory_order_relaxed);
+                            return;
+                        }
+                    }
+                });
+
+            if (failed.load())
+                return nullptr;
+
+            line_base += el.count;
+            out_base  += el.count * struct_size;
+        }
+
+        ref<Stream> result = new MemoryStream(out_size);
+        result->write(out.get(), out_size);
+        result->seek(0);
+        return result;
+    }
+
     ref<Stream> parse_ascii(FileStream *in, const std::vector<PLYElement> &elements) {
         ref<Stream> out = new MemoryStream();
         std::fstream &is = *in->native();
@@ -307,10 +307,16 @@ public:
 
         si.n          = m_frame.n;
         si.sh_frame.n = m_frame.n;
-        si.dp_du      = m_frame.s;
-        si.dp_dv      = m_frame.t;
-        si.uv         = Point2f(dr::fmadd(prim_uv.x(), 0.5f, 0.5f),
-                                dr::fmadd(prim_uv.y(), 0.5f, 0.5f));
+
+        if (likely(has_flag(ray_flags, RayFlags::UV) ||
+                   has_flag(ray_flags, RayFlags::BoundaryTest)))
+            si.uv = Point2f(dr::fmadd(prim_uv.x(), 0.5f, 0.5f),
+                            dr::fmadd(prim_uv.y(), 0.5f, 0.5f));
+
+        if (likely(has_flag(ray_flags, RayFlags::dPdUV))) {
+            si.dp_du = m_frame.s;
+            si.dp_dv = m_frame.t;
+        }
 
         si.dn_du = si.dn_dv = dr::zeros<Vector3f>();
         si.shape    = this;
@@ -1,5 +1,6 @@
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/core/fstream.h>
+#include <mitsuba/core/mmap.h>
 #include <mitsuba/core/zstream.h>
 #include <mitsuba/core/fresolver.h>
 #include <mitsuba/core/properties.h>
@@ -38,6 +39,38 @@ Serialized mesh loader (:monosp:`serialized`)
    - Is the mesh inverted, i.e. should the normal vectors be flipped? (Default:|false|, i.e.
      the normals point outside)
 
+ * - reorder
+   - |bool|
+   - When set to |true|, the faces are sorted along a Morton curve over their
+     centroids and the vertices are remapped to first-use order after loading,
+     which improves memory locality when shading incoherent hits.
+     (Default: |false|)
+
+ * - compress_attributes
+   - |bool|
+   - Store vertex normals in an octahedral-mapped 2x16 bit encoding and
+     texture coordinates as half precision floats, decoded on the fly during
+     rendering. This halves the memory footprint of these two buffers at a
+     precision loss that is invisible at typical tolerances. Compressed
+     buffers are not editable through ``mi.traverse()``. (Default: |false|)
+
+ * - displacement
+   - |texture|
+   - Optional displacement map. When specified, every face is subdivided
+     ``displacement_levels`` times after loading and each vertex is offset
+     along its shading normal by the texture value at its UV coordinates,
+     scaled by ``displacement_scale``. Requires texture coordinates.
+     (Default: none)
+
+ * - displacement_scale
+   - |float|
+   - Scale factor applied to the displacement map values. (Default: 1)
+
+ * - displacement_levels
+   - |int|
+   - Number of 1:4 subdivision iterations applied before displacing, allowing
+     coarse input meshes to be refined by the renderer. (Default: 0)
+
  * - to_world
    - |transform|
    - Specifies an optional linear object-to-world transformation.
@@ -104,7 +137,8 @@ follows:
         * - :monosp:`uint16`
           - File format identifier: :code:`0x041C`
         * - :monosp:`uint16`
-          - File version identifier. Currently set to :code:`0x0004`
+          - File version identifier. Currently set to :code:`0x0004` (compressed)
+            or :code:`0x0005` (uncompressed, see below)
         * - :math:`\rightarrow`
           - From this point on, the stream is compressed by the :monosp:`DEFLATE` algorithm.
         * - :math:`\rightarrow`
@@ -142,6 +176,21 @@ follows:
             :monosp:`uint32` or in :monosp:`uint64` format (the latter is used when the number of
             vertices exceeds :code:`0xFFFFFFFF`).
 
+Uncompressed files (version 5)
+******************************
+
+Version 5 files store the very same header fields and arrays, but without the
+:monosp:`DEFLATE` compression and with every array preceded by zero padding up
+to the next 64-byte file offset. The contents must be stored in single
+precision, normals must be unit length, and vertex colors are not supported.
+This layout allows the plugin to reference the vertex and face buffers
+directly through a read-only memory mapping: in scalar variants (and when no
+:monosp:`to_world` transformation is specified), loading performs no
+decompression and no copy at all, so even multi-gigabyte scenes open at the
+speed of the operating system's page cache. JIT variants, or files loaded
+with a :monosp:`to_world` transformation, are copied out of the mapping once.
+Version 5 files can be produced with :monosp:`Mesh.write_serialized()`.
+
 Multiple shapes
 ***************
 
@@ -198,6 +247,7 @@ at the end of the file, which specifies the starting position of each sub-mesh:
 #define MI_FILEFORMAT_HEADER     0x041C
 #define MI_FILEFORMAT_VERSION_V3 0x0003
 #define MI_FILEFORMAT_VERSION_V4 0x0004
+#define MI_FILEFORMAT_VERSION_V5 0x0005
 
 template <typename Float, typename Spectrum>
 class SerializedMesh final : public Mesh<Float, Spectrum> {
@@ -267,7 +317,8 @@ public:
             fail("encountered an invalid file format!");
 
         if (version != MI_FILEFORMAT_VERSION_V3 &&
-            version != MI_FILEFORMAT_VERSION_V4)
+            version != MI_FILEFORMAT_VERSION_V4 &&
+            version != MI_FILEFORMAT_VERSION_V5)
             fail("encountered an incompatible file version!");
 
         if (shape_index != 0) {
@@ -286,7 +337,7 @@ public:
                                  shape_index, count - 1));
 
             // Seek to the correct position
-            if (version == MI_FILEFORMAT_VERSION_V4) {
+            if (version != MI_FILEFORMAT_VERSION_V3) {
                 stream->seek(file_size -
                              sizeof(uint64_t) * (count - shape_index) -
                              sizeof(uint32_t));
@@ -304,6 +355,13 @@ public:
             stream->skip(sizeof(short) * 2); // Skip the header
         }
 
+        if (version == MI_FILEFORMAT_VERSION_V5) {
+            /* V5 files are uncompressed and 64-byte aligned, so their
+               arrays can be referenced through a memory mapping */
+            load_uncompressed(stream, file_path, timer);
+            return;
+        }
+
         stream = new ZStream(stream);
         stream->set_byte_order(Stream::ELittleEndian);
 
@@ -431,7 +489,179 @@ public:
         }
     }
 
+    /**
+     * \brief Load an uncompressed (V5) mesh by referencing the file through
+     * a memory mapping
+     *
+     * \c stream must be positioned right after the four-byte header of the
+     * selected sub-mesh. In scalar variants without a \c to_world
+     * transformation, the vertex and face buffers alias the read-only
+     * mapping directly and loading copies no geometry at all; otherwise,
+     * the data is copied out of the mapping once and the mapping is
+     * released.
+     */
+    void load_uncompressed(Stream *stream, const fs::path &file_path,
+                           Timer &timer) {
+        auto fail = [&](const std::string &descr) {
+            Throw("Error while loading serialized file \"%s\": %s!", m_name, descr);
+        };
+
+        uint32_t flags = 0;
+        stream->read(flags);
+
+        char ch = 0;
+        m_name = "";
+        do {
+            stream->read(ch);
+            if (ch == 0)
+                break;
+            m_name += ch;
+        } while (true);
+
+        size_t vertex_count, face_count;
+        stream->read(vertex_count);
+        stream->read(face_count);
+
+        m_vertex_count = (ScalarSize) vertex_count;
+        m_face_count   = (ScalarSize) face_count;
+
+        if (!has_flag(flags, TriMeshFlags::SinglePrecision))
+            fail("version 5 files must store their contents in single precision");
+
+        bool has_normals   = has_flag(flags, TriMeshFlags::HasNormals),
+             has_texcoords = has_flag(flags, TriMeshFlags::HasTexcoords),
+             has_colors    = has_flag(flags, TriMeshFlags::HasColors),
+             use_normals   = has_normals && !m_face_normals;
+
+        /* Each array begins at the next 64-byte file offset following the
+           header (resp. the preceding array) */
+        auto align64 = [](size_t offset) { return (offset + 63) / 64 * 64; };
+
+        size_t position_offset = align64(stream->tell()),
+               offset          = align64(position_offset +
+                                         vertex_count * 3 * sizeof(InputFloat)),
+               normal_offset   = 0,
+               texcoord_offset = 0;
+
+        if (has_normals) {
+            normal_offset = offset;
+            offset = align64(offset + vertex_count * 3 * sizeof(InputFloat));
+        }
+
+        if (has_texcoords) {
+            texcoord_offset = offset;
+            offset = align64(offset + vertex_count * 2 * sizeof(InputFloat));
+        }
+
+        if (has_colors) // Vertex colors are not used and skipped over
+            offset = align64(offset + vertex_count * 3 * sizeof(InputFloat));
+
+        size_t face_offset = offset,
+               end_offset  = face_offset + face_count * 3 * sizeof(ScalarIndex);
+
+        m_mmap = new MemoryMappedFile(file_path);
+        if (end_offset > m_mmap->size())
+            fail("file is truncated");
+
+        const uint8_t *base = (const uint8_t *) m_mmap->data();
+        const InputFloat *positions =
+            (const InputFloat *) (base + position_offset);
+        const InputFloat *normals = use_normals
+            ? (const InputFloat *) (base + normal_offset) : nullptr;
+        const InputFloat *texcoords = has_texcoords
+            ? (const InputFloat *) (base + texcoord_offset) : nullptr;
+        const ScalarIndex *faces = (const ScalarIndex *) (base + face_offset);
+
+        bool zero_copy = false;
+
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (m_to_world.scalar() == ScalarTransform4f()) {
+                /* Reference the mapped arrays in place. The mapping is
+                   read-only, which is safe: rendering never writes to the
+                   geometry buffers, and features that rebuild them (e.g.
+                   reordering or displacement) allocate fresh storage. */
+                m_vertex_positions = FloatStorage::map_(
+                    (void *) positions, vertex_count * 3);
+                if (use_normals)
+                    m_vertex_normals = FloatStorage::map_(
+                        (void *) normals, vertex_count * 3);
+                if (has_texcoords)
+                    m_vertex_texcoords = FloatStorage::map_(
+                        (void *) texcoords, vertex_count * 2);
+                m_faces = DynamicBuffer<UInt32>::map_(
+                    (void *) faces, face_count * 3);
+
+                for (size_t i = 0; i < vertex_count; ++i)
+                    m_bbox.expand(dr::load<InputPoint3f>(positions + 3 * i));
+
+                zero_copy = true;
+            }
+        }
+
+        if (!zero_copy) {
+            /* JIT variants (which upload to the device anyway) and meshes
+               with a to_world transformation copy the data out of the
+               mapping once */
+            std::unique_ptr<InputFloat[]> positions_out(
+                new InputFloat[vertex_count * 3]);
+            std::unique_ptr<InputFloat[]> normals_out(
+                use_normals ? new InputFloat[vertex_count * 3] : nullptr);
+
+            for (size_t i = 0; i < vertex_count; ++i) {
+                InputPoint3f p = m_to_world.scalar().transform_affine(
+                    dr::load<InputPoint3f>(positions + 3 * i));
+                dr::store(positions_out.get() + 3 * i, p);
+                m_bbox.expand(p);
+
+                if (use_normals) {
+                    InputNormal3f n = dr::load<InputNormal3f>(normals + 3 * i);
+                    n = dr::normalize(m_to_world.scalar().transform_affine(n));
+                    dr::store(normals_out.get() + 3 * i, n);
+                }
+            }
+
+            m_vertex_positions =
+                dr::load<FloatStorage>(positions_out.get(), vertex_count * 3);
+            if (use_normals)
+                m_vertex_normals =
+                    dr::load<FloatStorage>(normals_out.get(), vertex_count * 3);
+            if (has_texcoords)
+                m_vertex_texcoords =
+                    dr::load<FloatStorage>(texcoords, vertex_count * 2);
+            m_faces = dr::load<DynamicBuffer<UInt32>>(faces, face_count * 3);
+
+            m_mmap = nullptr; // All data has been copied
+        }
+
+        size_t vertex_data_bytes = 3 * sizeof(InputFloat);
+        if (use_normals)
+            vertex_data_bytes += 3 * sizeof(InputFloat);
+        if (has_texcoords)
+            vertex_data_bytes += 2 * sizeof(InputFloat);
+
+        Log(Debug, "\"%s\": %s %i faces, %i vertices (%s in %s)",
+            m_name, zero_copy ? "mapped" : "read", m_face_count, m_vertex_count,
+            util::mem_string(m_face_count * 3 * sizeof(ScalarIndex) +
+                             m_vertex_count * vertex_data_bytes),
+            util::time_string((float) timer.value())
+        );
+
+        if (!m_face_normals && !has_normals) {
+            Timer timer2;
+            recompute_vertex_normals();
+            Log(Debug, "\"%s\": computed vertex normals (took %s)", m_name,
+                util::time_string((float) timer2.value()));
+        }
+
+        initialize();
+    }
+
     MI_DECLARE_CLASS()
+
+private:
+    /// Keeps the file mapping of an uncompressed mesh alive while the
+    /// geometry buffers reference it (unused for compressed files)
+    ref<MemoryMappedFile> m_mmap;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(SerializedMesh, Mesh)
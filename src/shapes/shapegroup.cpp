@@ -95,6 +95,13 @@ where only a few distinct types of trees have to be kept in memory. An example i
             }
         }
 
+Shape groups may reference other shape groups, which makes it possible to
+assemble complex assets from reusable parts without duplicating geometry:
+the nested group's shapes are shared with the enclosing group, hence memory
+use remains proportional to the amount of unique geometry. Note that
+:ref:`instances <shape-instance>` (i.e. transformed uses of a group) cannot
+be nested within another group.
+
  */
 
 template <typename Float, typename Spectrum>
@@ -216,3 +216,49 @@ def test03_ray_intersect_instance(variants_all_rgb, width):
         assert 'instance = nullptr' in str(pi)
     else:
         assert ('instance = [' + '0x0, ' * (width - 1) + '0x0]') in str(pi)
+
+
+@fresolver_append_path
+def test04_update_instanced_geometry(variants_all_rgb):
+    """Modifying geometry inside a shape group must be picked up by the
+    acceleration data structures of all backends"""
+
+    from mitsuba import ScalarTransform4f as T
+
+    scene = mi.load_dict({
+        'type' : 'scene',
+
+        'group_0' : {
+            'type' : 'shapegroup',
+            'shape' : {
+                'type' : 'obj',
+                'filename' : 'resources/data/common/meshes/rectangle.obj'
+            }
+        },
+
+        'instance' : {
+            'type' : 'instance',
+            "group" : {
+                "type" : "ref",
+                "id" : "group_0"
+            },
+            'to_world' : T.translate([0, 0, 1.0])
+        }
+    })
+
+    ray = mi.Ray3f([0, 0, -12], [0.0, 0.0, 1.0])
+    si = scene.ray_intersect(ray)
+    assert dr.all(si.is_valid())
+    assert dr.allclose(si.t, 13.0)
+
+    # Shift the instanced rectangle by one unit along z
+    params = mi.traverse(scene)
+    key = 'group_0.rectangle.vertex_positions'
+    positions = dr.unravel(mi.Point3f, params[key])
+    positions.z += 1.0
+    params[key] = dr.ravel(positions)
+    params.update()
+
+    si = scene.ray_intersect(ray)
+    assert dr.all(si.is_valid())
+    assert dr.allclose(si.t, 14.0)
@@ -0,0 +1,137 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def load_obj(content, tmp_path, **kwargs):
+    filepath = str(tmp_path / 'test_obj.obj')
+    with open(filepath, 'w', newline='') as f:
+        f.write(content)
+    return mi.load_dict({ 'type': 'obj', 'filename': filepath, **kwargs })
+
+
+def test01_triangle(variant_scalar_rgb, tmp_path):
+    mesh = load_obj("""v 0 0 0
+v 1 0 0
+v 0 1 0
+f 1 2 3
+""", tmp_path)
+
+    assert mesh.vertex_count() == 3
+    assert mesh.face_count() == 1
+    params = mi.traverse(mesh)
+    assert dr.allclose(params['vertex_positions'],
+                       [0, 0, 0, 1, 0, 0, 0, 1, 0])
+    assert dr.allclose(params['faces'], [0, 1, 2])
+
+
+def test02_quad_triangulation(variant_scalar_rgb, tmp_path):
+    mesh = load_obj("""v 0 0 0
+v 1 0 0
+v 1 1 0
+v 0 1 0
+f 1 2 3 4
+""", tmp_path)
+
+    # The quad is fan-triangulated into (0, 1, 2) and (0, 2, 3)
+    assert mesh.vertex_count() == 4
+    assert mesh.face_count() == 2
+    params = mi.traverse(mesh)
+    assert dr.allclose(params['faces'], [0, 1, 2, 0, 2, 3])
+
+
+def test03_vertex_deduplication(variant_scalar_rgb, tmp_path):
+    # A position used with two different texture coordinates must be split
+    mesh = load_obj("""v 0 0 0
+v 1 0 0
+v 0 1 0
+vt 0 0
+vt 1 0
+vt 0 1
+vt 1 1
+f 1/1 2/2 3/3
+f 1/4 2/2 3/3
+""", tmp_path)
+
+    assert mesh.face_count() == 2
+    assert mesh.vertex_count() == 4
+
+
+def test04_normals_and_texcoords(variant_scalar_rgb, tmp_path):
+    mesh = load_obj("""v 0 0 0
+v 1 0 0
+v 0 1 0
+vn 0 0 1
+vt 0.5 0.25
+f 1/1/1 2/1/1 3/1/1
+""", tmp_path)
+
+    assert mesh.has_vertex_normals()
+    assert mesh.has_vertex_texcoords()
+    params = mi.traverse(mesh)
+    assert dr.allclose(params['vertex_normals'], [0, 0, 1] * 3)
+    # Texture coordinates are vertically flipped by default
+    assert dr.allclose(params['vertex_texcoords'], [0.5, 0.75] * 3)
+
+
+def test05_no_trailing_newline(variant_scalar_rgb, tmp_path):
+    mesh = load_obj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3", tmp_path)
+    assert mesh.vertex_count() == 3
+    assert mesh.face_count() == 1
+
+
+def test06_parse_errors(variant_scalar_rgb, tmp_path):
+    with pytest.raises(RuntimeError, match='could not parse'):
+        load_obj("v 0 zero 0\n", tmp_path)
+
+    with pytest.raises(RuntimeError, match='invalid vertex'):
+        load_obj("v 0 0 0\nf 1 2 3\n", tmp_path)
+
+    # Negative (relative) indices are valid OBJ, but unsupported: they must
+    # fail loudly instead of silently dropping the face
+    with pytest.raises(RuntimeError, match='negative'):
+        load_obj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\n", tmp_path)
+
+
+def test07_geometry_cache(variant_scalar_rgb, tmp_path):
+    import os
+
+    content = """v 0 0 0
+v 1 0 0
+v 0 1 0
+vt 0 0
+vt 1 0
+vt 0 1
+f 1/1 2/2 3/3
+"""
+    filepath = str(tmp_path / 'test_obj.obj')
+    cachepath = filepath + '.cache'
+
+    # First load writes the snapshot
+    mesh = load_obj(content, tmp_path, cache=True)
+    assert os.path.exists(cachepath)
+    params = mi.traverse(mesh)
+    positions, texcoords = params['vertex_positions'], params['vertex_texcoords']
+
+    # Second load restores identical geometry from the snapshot
+    mesh2 = load_obj(content, tmp_path, cache=True)
+    params2 = mi.traverse(mesh2)
+    assert mesh2.vertex_count() == mesh.vertex_count()
+    assert mesh2.face_count() == mesh.face_count()
+    assert dr.allclose(params2['vertex_positions'], positions)
+    assert dr.allclose(params2['vertex_texcoords'], texcoords)
+    assert dr.allclose(params2['faces'], params['faces'])
+    assert dr.allclose(mesh2.bbox().min, mesh.bbox().min)
+    assert dr.allclose(mesh2.bbox().max, mesh.bbox().max)
+
+    # Changing the source file invalidates the snapshot
+    mesh3 = load_obj(content.replace('v 1 0 0', 'v 2 0 0'), tmp_path,
+                     cache=True)
+    params3 = mi.traverse(mesh3)
+    assert dr.allclose(params3['vertex_positions'],
+                       [0, 0, 0, 2, 0, 0, 0, 1, 0])
+
+    # So does changing a parameter that affects the generated buffers
+    mesh4 = load_obj(content, tmp_path, cache=True, flip_tex_coords=False)
+    params4 = mi.traverse(mesh4)
+    assert not dr.allclose(params4['vertex_texcoords'], texcoords)
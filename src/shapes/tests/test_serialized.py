@@ -0,0 +1,53 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def make_mesh(tmp_path):
+    # A small mesh with normals and texture coordinates, written out as an
+    # uncompressed (V5) serialized file
+    obj_path = str(tmp_path / 'test_serialized.obj')
+    with open(obj_path, 'w', newline='') as f:
+        f.write("""v 0 0 0
+v 1 0 0
+v 0 1 0
+vn 0 0 1
+vt 0 0
+vt 1 0
+vt 0 1
+f 1/1/1 2/2/1 3/3/1
+""")
+    mesh = mi.load_dict({ 'type': 'obj', 'filename': obj_path })
+    filepath = str(tmp_path / 'test_serialized.serialized')
+    mesh.write_serialized(filepath)
+    return mesh, filepath
+
+
+def test01_roundtrip(variant_scalar_rgb, tmp_path):
+    mesh_ref, filepath = make_mesh(tmp_path)
+    mesh = mi.load_dict({ 'type': 'serialized', 'filename': filepath })
+
+    assert mesh.vertex_count() == mesh_ref.vertex_count()
+    assert mesh.face_count() == mesh_ref.face_count()
+    assert mesh.has_vertex_normals()
+    assert mesh.has_vertex_texcoords()
+
+    params, params_ref = mi.traverse(mesh), mi.traverse(mesh_ref)
+    for key in ['vertex_positions', 'vertex_normals',
+                'vertex_texcoords', 'faces']:
+        assert dr.allclose(params[key], params_ref[key])
+
+
+def test02_to_world(variant_scalar_rgb, tmp_path):
+    # A to_world transformation forces the copying (non-mapped) code path
+    _, filepath = make_mesh(tmp_path)
+    mesh = mi.load_dict({
+        'type': 'serialized',
+        'filename': filepath,
+        'to_world': mi.ScalarTransform4f().translate([1, 2, 3]),
+    })
+
+    params = mi.traverse(mesh)
+    assert dr.allclose(params['vertex_positions'],
+                       [1, 2, 3, 2, 2, 3, 1, 3, 3])
+    assert dr.allclose(params['vertex_normals'], [0, 0, 1] * 3)
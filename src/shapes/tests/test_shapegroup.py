@@ -42,32 +42,98 @@ def test02_error(variant_scalar_rgb):
             },
         })
 
-    error = "Nested ShapeGroup is not permitted"
+    error = "Instancing of emitters is not supported"
     with pytest.raises(RuntimeError, match='.*{}.*'.format(error)):
         mi.load_dict({
             'type' : 'shapegroup',
             'shape_01' : {
-                'type' : 'shapegroup',
-                'shape' : { 'type' : 'sphere' },
+                'type' : 'sphere',
+                'emitter' : { 'type' : 'area' }
             },
         })
 
-    error = "Instancing of emitters is not supported"
+    error = "Instancing of sensors is not supported"
     with pytest.raises(RuntimeError, match='.*{}.*'.format(error)):
         mi.load_dict({
             'type' : 'shapegroup',
             'shape_01' : {
                 'type' : 'sphere',
-                'emitter' : { 'type' : 'area' }
+                'sensor' : { 'type' : 'perspective' }
             },
         })
 
-    error = "Instancing of sensors is not supported"
-    with pytest.raises(RuntimeError, match='.*{}.*'.format(error)):
-        mi.load_dict({
+
+def test03_nested(variant_scalar_rgb):
+    # Nested shape groups are merged into the enclosing group
+    s = mi.load_dict({
+        'type' : 'shapegroup',
+        'shape_01' : {
+            'type' : 'sphere',
+            'radius' : 1.0,
+            'to_world' : mi.ScalarTransform4f.translate([-2, 0, 0])
+        },
+        'nested' : {
             'type' : 'shapegroup',
             'shape_01' : {
                 'type' : 'sphere',
-                'sensor' : { 'type' : 'perspective' }
+                'radius' : 1.0,
+                'to_world' : mi.ScalarTransform4f.translate([2, 0, 0])
+            },
+            'deeper' : {
+                'type' : 'shapegroup',
+                'shape_01' : {
+                    'type' : 'sphere',
+                    'radius' : 1.0,
+                    'to_world' : mi.ScalarTransform4f.translate([0, 4, 0])
+                },
+            },
+        },
+    })
+
+    b = s.bbox()
+    assert s.primitive_count() == 3
+    assert dr.allclose(b.min, [-3, -1, -1])
+    assert dr.allclose(b.max, [3, 5, 1])
+
+
+def test04_nested_instance(variant_scalar_rgb):
+    # Instancing a hierarchically assembled group must give the same result
+    # as instancing a flat group with the same content
+    def make_scene(nested):
+        inner = {
+            'type' : 'sphere',
+            'radius' : 1.0,
+            'to_world' : mi.ScalarTransform4f.translate([2, 0, 0])
+        }
+        group = {
+            'type' : 'shapegroup',
+            'shape_01' : {
+                'type' : 'sphere',
+                'radius' : 1.0,
+            },
+        }
+        if nested:
+            group['nested'] = { 'type' : 'shapegroup', 'shape_01' : inner }
+        else:
+            group['shape_02'] = inner
+        return mi.load_dict({
+            'type' : 'scene',
+            'group' : group,
+            'instance' : {
+                'type' : 'instance',
+                'shapegroup' : { 'type' : 'ref', 'id' : 'group' },
+                'to_world' : mi.ScalarTransform4f.translate([0, 0, 5])
             },
         })
+
+    scene_nested = make_scene(True)
+    scene_flat = make_scene(False)
+
+    for origin in [[0, 0, 0], [2, 0, 0], [1, 1, 0]]:
+        ray = mi.Ray3f(mi.Point3f(origin), mi.Vector3f(0, 0, 1))
+        si_n = scene_nested.ray_intersect(ray)
+        si_f = scene_flat.ray_intersect(ray)
+        assert si_n.is_valid() == si_f.is_valid()
+        if si_n.is_valid():
+            assert dr.allclose(si_n.t, si_f.t)
+            assert dr.allclose(si_n.p, si_f.p)
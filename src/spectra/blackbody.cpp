@@ -1,5 +1,6 @@
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/interaction.h>
+#include <mitsuba/core/distr_1d.h>
 #include <mitsuba/core/properties.h>
 
 NAMESPACE_BEGIN(mitsuba)
@@ -94,148 +95,76 @@ public:
     }
 
     void parameters_changed(const std::vector<std::string> &/*keys*/ = {}) override {
-        m_integral_min = cdf_and_pdf(ScalarFloat(m_wavelength_range.x())).first;
-        m_integral = cdf_and_pdf(ScalarFloat(m_wavelength_range.y())).first - m_integral_min;
-    }
-
-    UnpolarizedSpectrum eval_impl(const Wavelength &wavelengths, Mask active_) const {
-        if constexpr (is_spectral_v<Spectrum>) {
-            /* The scale factors of 1e-9f are needed to perform a conversion between
-               densities per unit nanometer and per unit meter. */
-            Wavelength lambda  = wavelengths * 1e-9f,
-                       lambda2 = dr::sqr(lambda),
-                       lambda5 = dr::sqr(lambda2) * lambda;
-
-            dr::mask_t<Wavelength> active = active_;
-            active &= wavelengths >= m_wavelength_range.x()
-                   && wavelengths <= m_wavelength_range.y();
+        /* Planck's formula is extremely smooth, hence a regularly spaced
+           table at 1 nm resolution is indistinguishable from the analytic
+           expression after linear interpolation. Tabulating it once here
+           replaces the per-sample transcendentals of the previous
+           implementation with a table lookup and turns wavelength sampling
+           into an inverse CDF search instead of a Newton-bisection solve. */
+        uint32_t size = (uint32_t) dr::maximum(
+            2.f, dr::ceil(m_wavelength_range.y() - m_wavelength_range.x()) + 1.f);
+
+        double step = (double) (m_wavelength_range.y() - m_wavelength_range.x())
+                      / (size - 1);
+
+        std::vector<ScalarFloat> values(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            double lambda  = ((double) m_wavelength_range.x() + i * step) * 1e-9,
+                   lambda2 = lambda * lambda,
+                   lambda5 = lambda2 * lambda2 * lambda;
 
             /* Watts per unit surface area (m^-2)
                      per unit wavelength (nm^-1)
                      per unit steradian (sr^-1) */
-            UnpolarizedSpectrum P = 1e-9f * c0 / (lambda5 *
-                    (dr::exp(c1 / (lambda * m_temperature)) - 1.f));
-
-            return P & active;
-        } else {
-            DRJIT_MARK_USED(wavelengths);
-            DRJIT_MARK_USED(active_);
-            /// TODO : implement reasonable thing to do in mono/RGB mode
-            Throw("Not implemented for non-spectral modes");
+            values[i] = ScalarFloat(1e-9 * (double) c0 /
+                (lambda5 * (std::exp((double) c1 /
+                                     (lambda * (double) m_temperature)) - 1.0)));
         }
+
+        m_distr = ContinuousDistribution<Wavelength>(m_wavelength_range,
+                                                     values.data(), size);
     }
 
     UnpolarizedSpectrum eval(const SurfaceInteraction3f &si, Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
-        return eval_impl(si.wavelengths, active);
-    }
 
-    Wavelength pdf_spectrum(const SurfaceInteraction3f &si, Mask active_) const override {
         if constexpr (is_spectral_v<Spectrum>) {
-            Wavelength lambda  = si.wavelengths * 1e-9f,
-                       lambda2 = dr::sqr(lambda),
-                       lambda5 = dr::sqr(lambda2) * lambda;
-
-            dr::mask_t<Wavelength> active = active_;
-            active &= si.wavelengths >= m_wavelength_range.x()
-                   && si.wavelengths <= m_wavelength_range.y();
-
-            // Wien's approximation to Planck's law
-            Wavelength pdf = 1e-9f * c0 * dr::exp(-c1 / (lambda * m_temperature))
-                / (lambda5 * m_integral);
-
-            return pdf & active;
+            return m_distr.eval_pdf(si.wavelengths, active);
         } else {
-            DRJIT_MARK_USED(active_);
+            DRJIT_MARK_USED(si);
             /// TODO : implement reasonable thing to do in mono/RGB mode
             Throw("Not implemented for non-spectral modes");
         }
     }
 
-    template <typename Value>
-    std::pair<Value, Value> cdf_and_pdf(Value lambda) const {
-        Value c1_2 = dr::sqr(c1),
-              c1_3 = c1_2 * c1,
-              c1_4 = dr::sqr(c1_2);
-
-        const Value K  = m_temperature,
-                    K2 = dr::sqr(K),
-                    K3 = K2*K;
-
-        lambda *= 1e-9f;
-
-        Value lambda2 = dr::sqr(lambda),
-              lambda3 = lambda2 * lambda,
-              lambda5 = lambda2 * lambda3;
-
-        Value expval = dr::exp(-c1 / (K * lambda));
-
-        Value cdf = c0 * K * expval *
-                (c1_3 + 3 * c1_2 * K * lambda + 6 * c1 * K2 * lambda2 +
-                 6 * K3 * lambda3) / (c1_4 * lambda3);
-
-        Value pdf = 1e-9f * c0 * expval / lambda5;
-
-        return { cdf, pdf };
+    Wavelength pdf_spectrum(const SurfaceInteraction3f &si, Mask active) const override {
+        if constexpr (is_spectral_v<Spectrum>) {
+            return m_distr.eval_pdf_normalized(si.wavelengths, active);
+        } else {
+            DRJIT_MARK_USED(si);
+            DRJIT_MARK_USED(active);
+            /// TODO : implement reasonable thing to do in mono/RGB mode
+            Throw("Not implemented for non-spectral modes");
+        }
     }
 
     std::pair<Wavelength, UnpolarizedSpectrum>
     sample_spectrum(const SurfaceInteraction3f & /* si */,
-                    const Wavelength &sample_, Mask active_) const override {
-        MI_MASKED_FUNCTION(ProfilerPhase::TextureSample, active_);
-
-        using WavelengthMask = dr::mask_t<Wavelength>;
+                    const Wavelength &sample, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureSample, active);
 
         if constexpr (is_spectral_v<Spectrum>) {
-            WavelengthMask active = active_;
-
-            Wavelength sample = dr::fmadd(sample_, Wavelength(m_integral), Wavelength(m_integral_min));
-
-            const ScalarFloat eps        = 1e-5f,
-                              eps_domain = eps * (m_wavelength_range.y() - m_wavelength_range.x()),
-                              eps_value  = eps * m_integral;
-
-            Wavelength a = m_wavelength_range.x(),
-                       b = m_wavelength_range.y(),
-                       t = .5f * (m_wavelength_range.x() + m_wavelength_range.y()),
-                       value, deriv;
-
-            do {
-                // Fall back to a bisection step when t is out of bounds
-                WavelengthMask bisect_mask = !((t > a) && (t < b));
-                dr::masked(t, bisect_mask && active) = .5f * (a + b);
-
-                // Evaluate the definite integral and its derivative (i.e. the spline)
-                std::tie(value, deriv) = cdf_and_pdf(t);
-                value -= sample;
-
-                // Update which lanes are still active
-                active = active && (dr::abs(value) > eps_value) && (b - a > eps_domain);
-
-                // Stop the iteration if converged
-                if (dr::none_nested(active))
-                    break;
-
-                // Update the bisection bounds
-                WavelengthMask update_mask = value <= 0.f;
-                dr::masked(a,  update_mask) = t;
-                dr::masked(b, !update_mask) = t;
-
-                // Perform a Newton step
-                dr::masked(t, active) = t - value / deriv;
-            } while (true);
-
-            Wavelength pdf = deriv / m_integral;
-
-            return { t, eval_impl(t, active_) / pdf };
+            return { m_distr.sample(sample, active),
+                     m_distr.integral() };
         } else {
-            DRJIT_MARK_USED(sample_);
+            DRJIT_MARK_USED(sample);
             Throw("Not implemented for non-spectral modes");
         }
     }
 
     Float mean() const override {
-        return m_integral / (m_wavelength_range.y() - m_wavelength_range.x());
+        ScalarVector2f range = m_distr.range();
+        return m_distr.integral() / (range[1] - range[0]);
     }
 
     ScalarVector2f wavelength_range() const override {
@@ -271,9 +200,8 @@ public:
     MI_DECLARE_CLASS()
 private:
     ScalarFloat m_temperature;
-    ScalarFloat m_integral_min;
-    ScalarFloat m_integral;
     ScalarVector2f m_wavelength_range;
+    ContinuousDistribution<Wavelength> m_distr;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(BlackBodySpectrum, Texture)
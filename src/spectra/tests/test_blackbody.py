@@ -0,0 +1,48 @@
+# The tabulated evaluation/sampling machinery is covered in depth via
+# 'src/libcore/tests/test_distr.py'; this checks the Planck tabulation itself.
+
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+@pytest.fixture()
+def obj():
+    return mi.load_dict({
+        "type" : "blackbody",
+        "temperature" : 5000
+    })
+
+
+def planck(wav, temperature):
+    c = 2.99792458e+8
+    h = 6.62607004e-34
+    k = 1.38064852e-23
+    lam = wav * 1e-9
+    return 1e-9 * (2 * h * c * c) / (lam**5 * (dr.exp(h * c / (k * lam * temperature)) - 1))
+
+
+def test01_eval(variant_scalar_spectral, obj):
+    si = mi.SurfaceInteraction3f()
+
+    # The linearly interpolated table should closely match the analytic formula
+    for wav in [400, 512.3, 666.7, 800]:
+        si.wavelengths = wav
+        assert dr.allclose(obj.eval(si), planck(wav, 5000), rtol=1e-3)
+
+    # Wavelengths outside of the covered range evaluate to zero
+    si.wavelengths = 300
+    assert dr.allclose(obj.eval(si), 0)
+    si.wavelengths = 900
+    assert dr.allclose(obj.eval(si), 0)
+
+
+def test02_sample_spectrum(variant_scalar_spectral, obj):
+    si = mi.SurfaceInteraction3f()
+
+    # Importance sampling is consistent with eval() and pdf_spectrum()
+    for sample in [0.1, 0.5, 0.9]:
+        wav, weight = obj.sample_spectrum(si, sample)
+        si.wavelengths = wav
+        pdf = obj.pdf_spectrum(si)
+        assert dr.allclose(weight, obj.eval(si) / pdf, rtol=1e-4)
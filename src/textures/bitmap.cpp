@@ -3,12 +3,17 @@
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/random.h>
 #include <mitsuba/core/distr_2d.h>
+#include <mitsuba/core/thread.h>
+#include <mitsuba/core/xml.h>
 #include <mitsuba/render/interaction.h>
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/srgb.h>
 #include <drjit/tensor.h>
 #include <drjit/texture.h>
+#include <nanothread/nanothread.h>
+#include <atomic>
 #include <mutex>
 
 NAMESPACE_BEGIN(mitsuba)
@@ -40,9 +45,24 @@ Bitmap texture (:monosp:`bitmap`)
 
      - ``bilinear`` (default): perform bilinear interpolation, but no filtering.
 
+     - ``trilinear``: in addition to bilinear interpolation, blend between the
+       two levels of a mip pyramid that bracket the pixel footprint. The
+       footprint is derived from the UV partials of the queried interaction,
+       so this mode only differs from ``bilinear`` when the integrator
+       computes ray differentials. Minified lookups then read from a
+       resolution-matched pyramid level, which removes aliasing and avoids
+       cache-unfriendly fetches from the full-resolution image.
+
      - ``nearest``: disable filtering and interpolation. In this mode, the plugin
        performs nearest neighbor lookups of texture values.
 
+     - ``stochastic``: fetch a single texel per lookup, chosen randomly with a
+       probability equal to its bilinear interpolation weight. Individual
+       lookups are noisy, but they match bilinear filtering in expectation, so
+       the noise averages out at higher sample counts. This reduces the
+       bandwidth and arithmetic cost of texture evaluations to that of a
+       nearest neighbor lookup.
+
  * - wrap_mode
    - |string|
    - Controls the behavior of texture evaluations that fall outside of the
@@ -69,9 +89,11 @@ Bitmap texture (:monosp:`bitmap`)
 
  * - accel
    - |bool|
-   - Hardware acceleration features can be used in CUDA mode. These features can
-     cause small differences as hardware interpolation methods typically have a
-     loss of precision (not exactly 32-bit arithmetic). (Default: true)
+   - Hardware acceleration features can be used in CUDA mode. When enabled,
+     lookups are backed by a CUDA texture object, i.e. filtering, caching and
+     boundary handling run on the texture units rather than in software. This
+     can cause small differences as hardware interpolation methods typically
+     have a loss of precision (not exactly 32-bit arithmetic). (Default: true)
 
  * - data
    - |tensor|
@@ -122,6 +144,47 @@ public:
         if (m_transform != ScalarTransform3f())
             dr::make_opaque(m_transform);
 
+        std::string filter_mode_str = props.string("filter_type", "bilinear");
+        dr::FilterMode filter_mode;
+        m_stochastic = false;
+        m_trilinear = false;
+        if (filter_mode_str == "nearest") {
+            filter_mode = dr::FilterMode::Nearest;
+        } else if (filter_mode_str == "bilinear") {
+            filter_mode = dr::FilterMode::Linear;
+        } else if (filter_mode_str == "trilinear") {
+            /* Trilinear filtering additionally blends between the two mip
+               levels that bracket the pixel footprint (see \ref build_pyramid) */
+            filter_mode = dr::FilterMode::Linear;
+            m_trilinear = true;
+        } else if (filter_mode_str == "stochastic") {
+            /* Stochastic filtering jitters the lookup position and then
+               performs a nearest neighbor fetch (see \ref jitter_uv) */
+            filter_mode = dr::FilterMode::Nearest;
+            m_stochastic = true;
+        } else {
+            Throw("Invalid filter type \"%s\", must be one of: \"nearest\", "
+                  "\"bilinear\", \"trilinear\", or \"stochastic\"!",
+                  filter_mode_str);
+        }
+
+        std::string wrap_mode_str = props.string("wrap_mode", "repeat");
+        typename dr::WrapMode wrap_mode;
+        if (wrap_mode_str == "repeat")
+            wrap_mode = dr::WrapMode::Repeat;
+        else if (wrap_mode_str == "mirror")
+            wrap_mode = dr::WrapMode::Mirror;
+        else if (wrap_mode_str == "clamp")
+            wrap_mode = dr::WrapMode::Clamp;
+        else
+            Throw("Invalid wrap mode \"%s\", must be one of: \"repeat\", "
+                  "\"mirror\", or \"clamp\"!", wrap_mode_str);
+
+        /* Should Mitsuba disable transformations to the stored color data?
+           (e.g. sRGB to linear, spectral upsampling, etc.) */
+        m_raw = props.get<bool>("raw", false);
+        m_accel = props.get<bool>("accel", true);
+
         if (props.has_property("bitmap")) {
             // Creates a Bitmap texture directly from an existing Bitmap object
             if (props.has_property("filename"))
@@ -133,37 +196,62 @@ public:
             if (!b)
                 Throw("Property \"bitmap\" must be a Bitmap instance.");
             m_bitmap = b;
+            init_from_bitmap(filter_mode, wrap_mode);
         } else {
             // Creates a Bitmap texture by loading an image from the filesystem
             FileResolver* fs = Thread::thread()->file_resolver();
             fs::path file_path = fs->resolve(props.string("filename"));
             m_name = file_path.filename().string();
             Log(Debug, "Loading bitmap texture from \"%s\" ..", m_name);
-            m_bitmap = new Bitmap(file_path);
-        }
 
-        std::string filter_mode_str = props.string("filter_type", "bilinear");
-        dr::FilterMode filter_mode;
-        if (filter_mode_str == "nearest")
-            filter_mode = dr::FilterMode::Nearest;
-        else if (filter_mode_str == "bilinear")
-            filter_mode = dr::FilterMode::Linear;
-        else
-            Throw("Invalid filter type \"%s\", must be one of: \"nearest\", or "
-                  "\"bilinear\"!", filter_mode_str);
+            /* Decode and preprocess the image asynchronously on the global
+               thread pool so that texture I/O overlaps with the remainder of
+               the scene loading process (geometry parsing, kd-tree/BVH
+               construction, etc.). The first query or parameter traversal
+               blocks until the result is available (see \ref ensure_loaded).
+               The JIT scope assigned to this object by the XML loader is
+               propagated into the task to keep kernel caching intact. */
+            uint32_t backend = 0, scope = 0;
+            if constexpr (dr::is_jit_v<Float>) {
+                backend = (uint32_t) dr::backend_v<Float>;
+                scope = jit_scope((JitBackend) backend);
+            }
 
-        std::string wrap_mode_str = props.string("wrap_mode", "repeat");
-        typename dr::WrapMode wrap_mode;
-        if (wrap_mode_str == "repeat")
-            wrap_mode = dr::WrapMode::Repeat;
-        else if (wrap_mode_str == "mirror")
-            wrap_mode = dr::WrapMode::Mirror;
-        else if (wrap_mode_str == "clamp")
-            wrap_mode = dr::WrapMode::Clamp;
-        else
-            Throw("Invalid wrap mode \"%s\", must be one of: \"repeat\", "
-                  "\"mirror\", or \"clamp\"!", wrap_mode_str);
+            auto decode = [this, file_path, filter_mode, wrap_mode, backend,
+                           scope, env = ThreadEnvironment()]() {
+                ScopedSetThreadEnvironment set_env(env);
+                xml::ScopedSetJITScope set_scope(backend, scope);
+                m_bitmap = new Bitmap(file_path);
+                init_from_bitmap(filter_mode, wrap_mode);
+            };
 
+            if (pool_size() > 0)
+                m_decode_task = dr::do_async(decode);
+            else
+                decode();
+        }
+    }
+
+    ~BitmapTexture() {
+        /* Don't let a pending decode task outlive the texture. Errors can no
+           longer propagate to a caller at this point, so only log them. */
+        try {
+            ensure_loaded();
+        } catch (const std::exception &e) {
+            Log(Warn, "~BitmapTexture(): asynchronous decode of \"%s\" "
+                "failed: %s", m_name, e.what());
+        }
+    }
+
+protected:
+    /**
+     * \brief Convert the freshly decoded bitmap in \ref m_bitmap into the
+     * working floating point representation and upload it into \ref m_texture
+     *
+     * Runs on a thread pool worker when the image is loaded from a file (see
+     * the constructor) and synchronously otherwise.
+     */
+    void init_from_bitmap(dr::FilterMode filter_mode, dr::WrapMode wrap_mode) {
         /* Convert to linear RGB float bitmap, will be converted
            into spectral profile coefficients below (in place) */
         Bitmap::PixelFormat pixel_format = m_bitmap->pixel_format();
@@ -185,17 +273,12 @@ public:
                       "format (Y[A], RGB[A], XYZ[A] are supported).");
         }
 
-        /* Should Mitsuba disable transformations to the stored color data?
-           (e.g. sRGB to linear, spectral upsampling, etc.) */
-        m_raw = props.get<bool>("raw", false);
         if (m_raw) {
             /* Don't undo gamma correction in the conversion below.
                This is needed, e.g., for normal maps. */
             m_bitmap->set_srgb_gamma(false);
         }
 
-        m_accel = props.get<bool>("accel", true);
-
         // Convert the image into the working floating point representation
         m_bitmap =
             m_bitmap->convert(pixel_format, struct_type_v<ScalarFloat>, false);
@@ -218,15 +301,49 @@ public:
         double mean = 0.0;
         if (m_bitmap->channel_count() == 3) {
             if (is_spectral_v<Spectrum> && !m_raw) {
-                for (size_t i = 0; i < pixel_count; ++i) {
-                    ScalarColor3f value = dr::load<ScalarColor3f>(ptr);
-                    if (!all(value >= 0 && value <= 1))
-                        exceed_unit_range = true;
-                    value = srgb_model_fetch(value);
-                    mean += (double) srgb_model_mean(value);
-                    dr::store(ptr, value);
-                    ptr += 3;
-                }
+                /* Replace each RGB pixel by its spectral upsampling
+                   coefficients, so that spectral texture evaluation later
+                   amounts to a single fetch. The per-pixel coefficient
+                   table search dominates load time for large textures and
+                   therefore runs chunk-parallel, with fixed chunks so that
+                   the mean reduction stays deterministic. */
+                srgb_model_fetch(ScalarColor3f(0.f)); // Load the model up front
+
+                size_t chunk_size  = 16384,
+                       chunk_count = (pixel_count + chunk_size - 1) / chunk_size;
+                std::vector<double> partial_mean(chunk_count, 0.0);
+                std::atomic<bool> exceed(false);
+
+                dr::parallel_for(
+                    dr::blocked_range<size_t>(0, chunk_count, 1),
+                    [&](const dr::blocked_range<size_t> &range) {
+                        for (size_t ci = range.begin(); ci != range.end(); ++ci) {
+                            size_t begin = ci * chunk_size,
+                                   end   = dr::minimum(begin + chunk_size,
+                                                       pixel_count);
+                            ScalarFloat *p = ptr + begin * 3;
+                            double mean_local = 0.0;
+                            bool exceed_local = false;
+
+                            for (size_t i = begin; i != end; ++i) {
+                                ScalarColor3f value = dr::load<ScalarColor3f>(p);
+                                if (!all(value >= 0 && value <= 1))
+                                    exceed_local = true;
+                                value = srgb_model_fetch(value);
+                                mean_local += (double) srgb_model_mean(value);
+                                dr::store(p, value);
+                                p += 3;
+                            }
+
+                            partial_mean[ci] = mean_local;
+                            if (exceed_local)
+                                exceed.store(true, std::memory_order_relaxed);
+                        }
+                    });
+
+                for (double value : partial_mean)
+                    mean += value;
+                exceed_unit_range = exceed.load();
             } else {
                 for (size_t i = 0; i < pixel_count; ++i) {
                     ScalarColor3f value = dr::load<ScalarColor3f>(ptr);
@@ -261,15 +378,56 @@ public:
         size_t shape[3] = { (size_t) res.y(), (size_t) res.x(), channels };
         m_texture = Texture2f(TensorXf(m_bitmap->data(), 3, shape), m_accel,
                               m_accel, filter_mode, wrap_mode);
+
+        /* The pyramid is derived from the converted representation, i.e. in
+           spectral variants the coarser levels average the upsampling
+           coefficients of the base image. */
+        if (m_trilinear)
+            build_pyramid(m_bitmap.get());
+
+        /* All queries are served by m_texture (and the mip pyramid) from
+           here on. Release the decoded staging bitmap rather than keeping a
+           second copy of the texel data resident for the lifetime of the
+           plugin -- with large texture sets, that copy alone can double the
+           host memory footprint of a scene. */
+        m_bitmap = nullptr;
+    }
+
+    /// Block until a pending asynchronous decode task (if any) has finished
+    MI_INLINE void ensure_loaded() const {
+        if (unlikely(m_decode_task.load(std::memory_order_acquire) != nullptr))
+            wait_for_decode();
     }
 
+    /// Slow path of \ref ensure_loaded(), rethrows decode errors (if any)
+    void wait_for_decode() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Task *task = m_decode_task.load(std::memory_order_relaxed);
+        if (!task)
+            return; // Another thread waited for the task in the meantime
+
+        std::exception_ptr eptr;
+        try {
+            task_wait(task);
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        task_release(task);
+        m_decode_task.store(nullptr, std::memory_order_release);
+        if (eptr)
+            std::rethrow_exception(eptr);
+    }
+
+public:
     void traverse(TraversalCallback *callback) override {
+        ensure_loaded();
         callback->put_parameter("data",  m_texture.tensor(), +ParamFlags::Differentiable);
         callback->put_parameter("to_uv", m_transform,        +ParamFlags::NonDifferentiable);
     }
 
     void
     parameters_changed(const std::vector<std::string> &keys = {}) override {
+        ensure_loaded();
         if (keys.empty() || string::contains(keys, "data")) {
             const size_t channels = m_texture.shape()[2];
             if (channels != 1 && channels != 3)
@@ -290,6 +448,7 @@ public:
     UnpolarizedSpectrum eval(const SurfaceInteraction3f &si,
                              Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        ensure_loaded();
 
         const size_t channels = m_texture.shape()[2];
         if (channels == 3 && is_spectral_v<Spectrum> && m_raw) {
@@ -321,9 +480,142 @@ public:
         }
     }
 
+    void eval_batch(const SurfaceInteraction3f *si, UnpolarizedSpectrum *out,
+                    size_t count, Mask active = true) const override {
+        if constexpr (!dr::is_jit_v<Float>) {
+            MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+            ensure_loaded();
+
+            if (dr::none_or<false>(active)) {
+                for (size_t i = 0; i < count; ++i)
+                    out[i] = dr::zeros<UnpolarizedSpectrum>();
+                return;
+            }
+
+            const size_t channels = m_texture.shape()[2];
+
+            /* The packetized fetch below covers lookups that directly return
+               (interpolated) texel data. Spectral upsampling additionally
+               evaluates a spectral model per lookup, and trilinear filtering
+               touches a per-lookup mip level, hence those cases take the
+               generic code path. */
+            if ((channels == 1 || !is_spectral_v<Spectrum>) && !m_trilinear) {
+                using FloatP = dr::Packet<ScalarFloat>;
+                using Int32P = dr::int32_array_t<FloatP>;
+                using Color3fP = Color<FloatP, 3>;
+
+                const ScalarFloat *ptr = m_texture.value().data();
+                int32_t width  = (int32_t) m_texture.shape()[1],
+                        height = (int32_t) m_texture.shape()[0];
+
+                bool bilinear =
+                    m_texture.filter_mode() == dr::FilterMode::Linear;
+                dr::WrapMode wrap_mode = m_texture.wrap_mode();
+
+                auto wrap = [wrap_mode](Int32P x, int32_t n) -> Int32P {
+                    switch (wrap_mode) {
+                        case dr::WrapMode::Repeat: {
+                            Int32P r = x % n;
+                            return r + dr::select(r < 0, Int32P(n), Int32P(0));
+                        }
+                        case dr::WrapMode::Mirror: {
+                            Int32P r = x % (2 * n);
+                            r += dr::select(r < 0, Int32P(2 * n), Int32P(0));
+                            return dr::select(r < n, r, 2 * n - 1 - r);
+                        }
+                        default:
+                            return dr::clamp(x, 0, n - 1);
+                    }
+                };
+
+                auto fetch = [&](const Int32P &index) -> Color3fP {
+                    if (channels == 1)
+                        return Color3fP(dr::gather<FloatP>(ptr, index));
+                    Int32P offset = index * 3;
+                    return Color3fP(dr::gather<FloatP>(ptr, offset),
+                                    dr::gather<FloatP>(ptr, offset + 1),
+                                    dr::gather<FloatP>(ptr, offset + 2));
+                };
+
+                ScalarFloat u[FloatP::Size], v[FloatP::Size];
+
+                size_t i = 0;
+                for (; i + FloatP::Size <= count; i += FloatP::Size) {
+                    for (size_t l = 0; l < FloatP::Size; ++l) {
+                        Point2f uv = m_transform.transform_affine(si[i + l].uv);
+                        if (unlikely(m_stochastic))
+                            uv = jitter_uv(uv);
+                        u[l] = uv.x();
+                        v[l] = uv.y();
+                    }
+
+                    FloatP fu = dr::load<FloatP>(u) * (ScalarFloat) width,
+                           fv = dr::load<FloatP>(v) * (ScalarFloat) height;
+
+                    Color3fP value;
+                    if (likely(bilinear)) {
+                        fu -= .5f;
+                        fv -= .5f;
+
+                        Int32P u0 = dr::floor2int<Int32P>(fu),
+                               v0 = dr::floor2int<Int32P>(fv);
+
+                        FloatP wu1 = fu - FloatP(u0),
+                               wv1 = fv - FloatP(v0);
+
+                        Int32P x0 = wrap(u0, width),  x1 = wrap(u0 + 1, width),
+                               y0 = wrap(v0, height), y1 = wrap(v0 + 1, height);
+
+                        Color3fP v00 = fetch(y0 * width + x0),
+                                 v10 = fetch(y0 * width + x1),
+                                 v01 = fetch(y1 * width + x0),
+                                 v11 = fetch(y1 * width + x1);
+
+                        value = dr::lerp(dr::lerp(v00, v10, wu1),
+                                         dr::lerp(v01, v11, wu1), wv1);
+                    } else {
+                        Int32P x = wrap(dr::floor2int<Int32P>(fu), width),
+                               y = wrap(dr::floor2int<Int32P>(fv), height);
+                        value = fetch(y * width + x);
+                    }
+
+                    for (size_t l = 0; l < FloatP::Size; ++l) {
+                        if constexpr (is_spectral_v<Spectrum>) {
+                            // Only reachable for single-channel textures
+                            out[i + l] = UnpolarizedSpectrum(value.x()[l]);
+                        } else if constexpr (is_monochromatic_v<Spectrum>) {
+                            out[i + l] = UnpolarizedSpectrum(
+                                channels == 1
+                                    ? value.x()[l]
+                                    : luminance(Color3f(value.x()[l],
+                                                        value.y()[l],
+                                                        value.z()[l])));
+                        } else {
+                            out[i + l] =
+                                channels == 1
+                                    ? UnpolarizedSpectrum(value.x()[l])
+                                    : UnpolarizedSpectrum(Color3f(
+                                          value.x()[l], value.y()[l],
+                                          value.z()[l]));
+                        }
+                    }
+                }
+
+                // Remainder that does not fill a whole packet
+                for (; i < count; ++i)
+                    out[i] = eval(si[i], active);
+
+                return;
+            }
+        }
+
+        Texture::eval_batch(si, out, count, active);
+    }
+
     Float eval_1(const SurfaceInteraction3f &si,
                  Mask active = true) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        ensure_loaded();
 
         const size_t channels = m_texture.shape()[2];
         if (channels == 3 && is_spectral_v<Spectrum> && !m_raw) {
@@ -346,6 +638,7 @@ public:
     Vector2f eval_1_grad(const SurfaceInteraction3f &si,
                          Mask active = true) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        ensure_loaded();
 
         const size_t channels = m_texture.shape()[2];
         if (channels == 3 && is_spectral_v<Spectrum> && !m_raw) {
@@ -425,6 +718,7 @@ public:
     Color3f eval_3(const SurfaceInteraction3f &si,
                    Mask active = true) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        ensure_loaded();
 
         const size_t channels = m_texture.shape()[2];
         if (channels != 3) {
@@ -451,6 +745,7 @@ public:
         if (dr::none_or<false>(active))
             return { dr::zeros<Point2f>(), dr::zeros<Float>() };
 
+        ensure_loaded();
         if (!m_distr2d)
             init_distr();
 
@@ -490,6 +785,7 @@ public:
         if (dr::none_or<false>(active))
             return dr::zeros<Float>();
 
+        ensure_loaded();
         if (!m_distr2d)
             init_distr();
 
@@ -550,15 +846,23 @@ public:
     }
 
     ScalarVector2i resolution() const override {
+        ensure_loaded();
         const size_t *shape = m_texture.shape();
         return { (int) shape[1], (int) shape[0] };
     }
 
-    Float mean() const override { return m_mean; }
+    Float mean() const override {
+        ensure_loaded();
+        return m_mean;
+    }
 
     bool is_spatially_varying() const override { return true; }
 
+    /// The trilinear filter selects its mip level from the UV partials
+    bool uses_ray_differentials() const override { return m_trilinear; }
+
     std::string to_string() const override {
+        ensure_loaded();
         std::ostringstream oss;
         oss << "BitmapTexture[" << std::endl
             << "  name = \"" << m_name << "\"," << std::endl
@@ -583,6 +887,18 @@ protected:
             active = true;
 
         Point2f uv = m_transform.transform_affine(si.uv);
+        if (unlikely(m_stochastic))
+            uv = jitter_uv(uv);
+
+        if (unlikely(m_trilinear)) {
+            /* In contrast to the single-level case below, the model
+               coefficients are interpolated before evaluating the spectral
+               model once per level */
+            auto [f0, f1, w1] = eval_mip_pair(si, uv, active);
+            return dr::lerp(
+                srgb_model_eval<UnpolarizedSpectrum>(f0, si.wavelengths),
+                srgb_model_eval<UnpolarizedSpectrum>(f1, si.wavelengths), w1);
+        }
 
         if (m_texture.filter_mode() == dr::FilterMode::Linear) {
             Color3f v00, v10, v01, v11;
@@ -636,6 +952,13 @@ protected:
             active = true;
 
         Point2f uv = m_transform.transform_affine(si.uv);
+        if (unlikely(m_stochastic))
+            uv = jitter_uv(uv);
+
+        if (unlikely(m_trilinear)) {
+            auto [f0, f1, w1] = eval_mip_pair(si, uv, active);
+            return dr::lerp(f0.x(), f1.x(), w1);
+        }
 
         Float out;
         if (m_accel)
@@ -657,6 +980,13 @@ protected:
             active = true;
 
         Point2f uv = m_transform.transform_affine(si.uv);
+        if (unlikely(m_stochastic))
+            uv = jitter_uv(uv);
+
+        if (unlikely(m_trilinear)) {
+            auto [f0, f1, w1] = eval_mip_pair(si, uv, active);
+            return dr::lerp(f0, f1, w1);
+        }
 
         Color3f out;
         if (m_accel)
@@ -667,6 +997,216 @@ protected:
         return out;
     }
 
+    /**
+     * \brief Stochastically round the lookup position to one of the four
+     * texels of its bilinear footprint
+     *
+     * The returned position is offset by up to half a texel along each axis
+     * so that a subsequent nearest neighbor fetch selects each neighboring
+     * texel with a probability that equals its bilinear interpolation weight.
+     * A single fetch thus matches bilinear filtering in expectation, and the
+     * selection noise averages out over many samples per pixel. The random
+     * variates are derived by hashing the bits of the lookup position, which
+     * keeps renders deterministic and relies on the position jitter of the
+     * underlying sample generator to decorrelate repeated lookups.
+     */
+    MI_INLINE Point2f jitter_uv(const Point2f &uv) const {
+        using Float32 = dr::float32_array_t<Float>;
+        using UInt32f = dr::uint32_array_t<Float>;
+
+        UInt32f v0 = dr::reinterpret_array<UInt32f>(Float32(uv.x())),
+                v1 = dr::reinterpret_array<UInt32f>(Float32(uv.y()));
+        auto [r0, r1] = sample_tea_32(v0, v1);
+
+        // Map both TEA outputs to [0, 1) (see \ref sample_tea_float32)
+        Point2f xi(
+            Float(dr::reinterpret_array<Float32>(dr::sr<9>(r0) | 0x3f800000u) - 1.f),
+            Float(dr::reinterpret_array<Float32>(dr::sr<9>(r1) | 0x3f800000u) - 1.f));
+
+        return uv + (xi - .5f) * dr::rcp(ScalarVector2f(resolution()));
+    }
+
+    /**
+     * \brief Build the mip pyramid used by trilinear filtering
+     *
+     * Stores successively halved copies of the base image, each computed
+     * from its predecessor with a box reconstruction filter via \ref
+     * Bitmap::resample(). The levels are concatenated into a single flat
+     * array so that lookups can gather texels from a per-lane level index
+     * (see \ref fetch_mip). The finest level is not duplicated; it remains
+     * in \ref m_texture.
+     */
+    void build_pyramid(const Bitmap *base) {
+        using ReconstructionFilter = Bitmap::ReconstructionFilter;
+        ref<ReconstructionFilter> rfilter =
+            PluginManager::instance()->create_object<ReconstructionFilter>(
+                Properties("box"));
+
+        size_t channels = base->channel_count();
+        std::vector<ScalarFloat> data;
+        std::vector<uint32_t> meta;
+        m_mip_res.clear();
+
+        ref<const Bitmap> level = base;
+        while (dr::any(level->size() > 1u)) {
+            ScalarVector2u size = dr::maximum(level->size() / 2u, 1u);
+            ref<Bitmap> next = level->resample(size, rfilter.get());
+
+            meta.push_back((uint32_t) data.size());
+            meta.push_back(size.x());
+            meta.push_back(size.y());
+            m_mip_res.push_back(size);
+
+            const ScalarFloat *p = (const ScalarFloat *) next->data();
+            data.insert(data.end(), p, p + dr::prod(size) * channels);
+            level = next;
+        }
+
+        m_mip_data = dr::load<DynamicBuffer<Float>>(data.data(), data.size());
+        m_mip_meta = dr::load<DynamicBuffer<UInt32>>(meta.data(), meta.size());
+    }
+
+    /**
+     * \brief Map the UV partials of a surface interaction to a fractional
+     * mip level
+     *
+     * The level is chosen so that the major axis of the pixel footprint
+     * covers roughly one texel of the selected level. Lookups without ray
+     * differentials (zero partials) resolve to the finest level.
+     */
+    MI_INLINE Float mip_level(const SurfaceInteraction3f &si) const {
+        // Apply the linear part of the UV transform to the partials
+        Matrix3f uv_tm = m_transform.matrix;
+        Vector2f dx(dr::fmadd(uv_tm.entry(0, 0), si.duv_dx.x(),
+                              uv_tm.entry(0, 1) * si.duv_dx.y()),
+                    dr::fmadd(uv_tm.entry(1, 0), si.duv_dx.x(),
+                              uv_tm.entry(1, 1) * si.duv_dx.y())),
+                 dy(dr::fmadd(uv_tm.entry(0, 0), si.duv_dy.x(),
+                              uv_tm.entry(0, 1) * si.duv_dy.y()),
+                    dr::fmadd(uv_tm.entry(1, 0), si.duv_dy.x(),
+                              uv_tm.entry(1, 1) * si.duv_dy.y()));
+
+        ScalarVector2f res(resolution());
+        Float rho_2 = dr::maximum(dr::squared_norm(dx * res),
+                                  dr::squared_norm(dy * res));
+
+        // Footprints below one texel map to level 0 via the inner clamp
+        Float level = .5f * dr::log2(dr::maximum(rho_2, 1.f));
+        return dr::minimum(level, ScalarFloat(m_mip_res.size()));
+    }
+
+    /// Wrap a lookup position into [0, 1] following the texture's wrap mode
+    MI_INLINE Point2f wrap_unit(const Point2f &uv) const {
+        switch (m_texture.wrap_mode()) {
+            case dr::WrapMode::Repeat:
+                return uv - dr::floor(uv);
+
+            case dr::WrapMode::Mirror: {
+                Point2f t = uv * .5f;
+                t -= dr::floor(t);
+                t *= 2.f; // Position within a mirrored period of [0, 2)
+                return dr::select(t <= 1.f, t, 2.f - t);
+            }
+
+            default: // dr::WrapMode::Clamp
+                return dr::clamp(uv, 0.f, 1.f);
+        }
+    }
+
+    /**
+     * \brief Perform a bilinearly interpolated lookup from mip level
+     * \c level (in 1 .. level count), whose value may differ per lane
+     *
+     * In contrast to lookups from \ref m_texture, the level resolution is
+     * only known at runtime, hence the interpolation gathers directly from
+     * the flat pyramid storage. Single-channel lookups broadcast the value
+     * to all three output components.
+     */
+    Color3f fetch_mip(const Point2f &uv_, const UInt32 &level,
+                      Mask active) const {
+        const uint32_t channels = (uint32_t) m_texture.shape()[2];
+
+        UInt32 meta = (level - 1u) * 3u;
+        UInt32 offset = dr::gather<UInt32>(m_mip_meta, meta, active),
+               width  = dr::gather<UInt32>(m_mip_meta, meta + 1u, active),
+               height = dr::gather<UInt32>(m_mip_meta, meta + 2u, active);
+
+        /* Wrap the position into [0, 1] up front so that texel coordinates
+           overrun the level by at most one row/column below */
+        Point2f uv = wrap_unit(uv_);
+
+        Float fu = dr::fmadd(uv.x(), Float(width), -.5f),
+              fv = dr::fmadd(uv.y(), Float(height), -.5f);
+
+        Int32 u0 = dr::floor2int<Int32>(fu),
+              v0 = dr::floor2int<Int32>(fv);
+
+        Float wu1 = fu - Float(u0),
+              wv1 = fv - Float(v0);
+
+        /* Clamping handles the single-texel overrun exactly for both the
+           clamp and mirror modes (the mirrored neighbor of a boundary texel
+           is the texel itself) */
+        bool repeat = m_texture.wrap_mode() == dr::WrapMode::Repeat;
+        auto wrap = [repeat](const Int32 &x, const UInt32 &n) -> UInt32 {
+            Int32 n_i = Int32(n);
+            Int32 r = dr::select(x < 0, repeat ? x + n_i : Int32(0), x);
+            return UInt32(dr::select(r >= n_i, repeat ? r - n_i : n_i - 1, r));
+        };
+
+        UInt32 x0 = wrap(u0, width),  x1 = wrap(u0 + 1, width),
+               y0 = wrap(v0, height), y1 = wrap(v0 + 1, height);
+
+        auto fetch = [&](const UInt32 &x, const UInt32 &y) -> Color3f {
+            UInt32 index = offset + (y * width + x) * channels;
+            if (channels == 1)
+                return Color3f(dr::gather<Float>(m_mip_data, index, active));
+            return Color3f(dr::gather<Float>(m_mip_data, index, active),
+                           dr::gather<Float>(m_mip_data, index + 1u, active),
+                           dr::gather<Float>(m_mip_data, index + 2u, active));
+        };
+
+        Color3f v00 = fetch(x0, y0), v10 = fetch(x1, y0),
+                v01 = fetch(x0, y1), v11 = fetch(x1, y1);
+
+        return dr::lerp(dr::lerp(v00, v10, wu1),
+                        dr::lerp(v01, v11, wu1), wv1);
+    }
+
+    /**
+     * \brief Evaluate the two mip levels that bracket the footprint of the
+     * given surface interaction
+     *
+     * Returns bilinearly interpolated texel values from both levels along
+     * with the blend weight of the coarser one. The finest level is served
+     * by \ref m_texture (including hardware acceleration, if enabled),
+     * coarser levels by \ref fetch_mip.
+     */
+    std::tuple<Color3f, Color3f, Float>
+    eval_mip_pair(const SurfaceInteraction3f &si, const Point2f &uv,
+                  Mask active) const {
+        if constexpr (!dr::is_array_v<Mask>)
+            active = true;
+
+        Float level = mip_level(si);
+        UInt32 l0 = UInt32(level),
+               l1 = dr::minimum(l0 + 1u, (uint32_t) m_mip_res.size());
+        Float w1 = level - Float(l0);
+
+        Mask base = active && dr::eq(l0, 0u);
+        Color3f f0 = dr::zeros<Color3f>();
+        if (m_accel)
+            m_texture.eval(uv, f0.data(), base);
+        else
+            m_texture.eval_nonaccel(uv, f0.data(), base);
+        if (dr::any_or<true>(!base))
+            f0 = dr::select(base, f0, fetch_mip(uv, l0, active && !base));
+
+        Color3f f1 = fetch_mip(uv, l1, active);
+
+        return { f0, f1, w1 };
+    }
+
     /**
      * \brief Recompute mean and 2D sampling distribution (if requested)
      * following an update
@@ -723,6 +1263,16 @@ protected:
                     ptr, resolution());
         }
 
+        if (m_trilinear) {
+            // The updated base data invalidates all coarser pyramid levels
+            ref<Bitmap> base = new Bitmap(
+                channels == 3 ? Bitmap::PixelFormat::RGB
+                              : Bitmap::PixelFormat::Y,
+                struct_type_v<ScalarFloat>, ScalarVector2u(resolution()),
+                channels, {}, (uint8_t *) data.data());
+            build_pyramid(base.get());
+        }
+
         if (init_mean)
             m_mean = dr::opaque<Float>(ScalarFloat(mean / pixel_count));
 
@@ -746,13 +1296,26 @@ protected:
     Texture2f m_texture;
     ScalarTransform3f m_transform;
     bool m_accel;
+    bool m_stochastic;
+    bool m_trilinear;
     bool m_raw;
     Float m_mean;
     ref<Bitmap> m_bitmap;
     std::string m_name;
 
-    // Optional: distribution for importance sampling
+    /// Flattened mip pyramid for trilinear filtering (see \ref build_pyramid)
+    DynamicBuffer<Float> m_mip_data;
+    /// Per mip level: element offset into \ref m_mip_data, width and height
+    DynamicBuffer<UInt32> m_mip_meta;
+    std::vector<ScalarVector2u> m_mip_res;
+
+    /// Pending asynchronous decode task (or \c nullptr, see \ref ensure_loaded)
+    mutable std::atomic<Task *> m_decode_task { nullptr };
+
+    /// Guards \ref m_distr2d construction and \ref wait_for_decode()
     mutable std::mutex m_mutex;
+
+    // Optional: distribution for importance sampling
     std::unique_ptr<DiscreteDistribution2D<Float>> m_distr2d;
 };
 
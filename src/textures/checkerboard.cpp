@@ -59,6 +59,7 @@ public:
         m_color0 = props.texture<Texture>("color0", .4f);
         m_color1 = props.texture<Texture>("color1", .2f);
         m_transform = props.get<ScalarTransform4f>("to_uv", ScalarTransform4f()).extract();
+        update_cached_colors();
     }
 
     void traverse(TraversalCallback *callback) override {
@@ -67,16 +68,26 @@ public:
         callback->put_object("color1",   m_color1.get(), +ParamFlags::Differentiable);
     }
 
+    void parameters_changed(const std::vector<std::string> &/*keys*/ = {}) override {
+        update_cached_colors();
+    }
+
     UnpolarizedSpectrum eval(const SurfaceInteraction3f &it, Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
 
         Point2f uv = m_transform.transform_affine(it.uv);
         dr::mask_t<Point2f> mask = uv - dr::floor(uv) > .5f;
-        UnpolarizedSpectrum result = dr::zeros<UnpolarizedSpectrum>();
 
         Mask m0 = dr::eq(mask.x(), mask.y()),
              m1 = !m0;
 
+        if (m_folded)
+            return dr::select(active,
+                              dr::select(m0, m_value0, m_value1),
+                              dr::zeros<UnpolarizedSpectrum>());
+
+        UnpolarizedSpectrum result = dr::zeros<UnpolarizedSpectrum>();
+
         m0 &= active; m1 &= active;
 
         if (dr::any_or<true>(m0))
@@ -93,11 +104,16 @@ public:
 
         Point2f uv = m_transform.transform_affine(it.uv);
         dr::mask_t<Point2f> mask = (uv - dr::floor(uv)) > .5f;
-        Float result = 0.f;
 
         Mask m0 = dr::neq(mask.x(), mask.y()),
              m1 = !m0;
 
+        if (m_folded)
+            return dr::select(active,
+                              dr::select(m0, m_value0_1, m_value1_1), 0.f);
+
+        Float result = 0.f;
+
         m0 &= active; m1 &= active;
 
         if (dr::any_or<true>(m0))
@@ -127,9 +143,40 @@ public:
 
     MI_DECLARE_CLASS()
 protected:
+    /**
+     * \brief Cache the nested colors when they cannot vary per-interaction
+     *
+     * When both nested textures are uniform (e.g. \c srgb or \c uniform
+     * instances) their evaluation does not depend on the surface
+     * interaction, so \ref eval() can collapse into a single select between
+     * two precomputed values instead of dispatching two nested texture
+     * calls per query. Spectral variants are excluded since even a constant
+     * sRGB value still depends on the wavelengths being queried. The cache
+     * is refreshed in \ref parameters_changed() so that differentiable
+     * optimization of the nested colors keeps working.
+     */
+    void update_cached_colors() {
+        if constexpr (!is_spectral_v<Spectrum>)
+            m_folded = !m_color0->is_spatially_varying() &&
+                       !m_color1->is_spatially_varying();
+
+        if (m_folded) {
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+            m_value0   = m_color0->eval(si);
+            m_value1   = m_color1->eval(si);
+            m_value0_1 = m_color0->eval_1(si);
+            m_value1_1 = m_color1->eval_1(si);
+        }
+    }
+
     ref<Texture> m_color0;
     ref<Texture> m_color1;
     ScalarTransform3f m_transform;
+
+    /// Inlined values for constant nested textures (see \ref update_cached_colors())
+    UnpolarizedSpectrum m_value0, m_value1;
+    Float m_value0_1, m_value1_1;
+    bool m_folded = false;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(Checkerboard, Texture)
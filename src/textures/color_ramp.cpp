@@ -162,6 +162,8 @@ public:
         else {
             Throw("Color Ramp should at least have a factor or bitmap as the input!");
         }
+
+        bake_lut();
     }
 
     ~ColorRamp() {}
@@ -401,6 +403,87 @@ protected:
         else
             fac = luminance(factor);
 
+        if (m_lut_baked)
+            return lut_lookup<color>(fac, active);
+
+        return ramp_interpolation<color>(fac, si, active);
+    }
+    /**
+     * \brief Bake the ramp into a fixed-resolution lookup table
+     *
+     * Every interpolation mode below performs a binary search over the band
+     * positions followed by up to four nested texture evaluations per lookup.
+     * When all color bands are uniform, the ramp only depends on the scalar
+     * interpolation factor and can be tabulated once at construction, turning
+     * each evaluation into a single fetch + lerp. The exact code path is kept
+     * for spatially varying bands and for differentiable variants, where
+     * gradients with respect to the band colors must flow through the
+     * original expression.
+     */
+    void bake_lut() {
+        if constexpr (dr::is_diff_v<Float> || is_spectral_v<Spectrum>) {
+            return;
+        } else {
+            for (const ref<Texture> &tex : m_color_band)
+                if (tex->is_spatially_varying())
+                    return;
+
+            using color = std::conditional_t<is_monochromatic_v<Spectrum>,
+                                             Color1f, Color3f>;
+            constexpr uint32_t Channels = (uint32_t) color::Size;
+
+            SurfaceInteraction3f si = dr::zeros<SurfaceInteraction3f>();
+
+            if constexpr (dr::is_jit_v<Float>) {
+                Float fac = dr::linspace<Float>(0.f, 1.f, LUTSize);
+                color value = ramp_interpolation<color>(fac, si, true);
+
+                UInt32 idx = dr::arange<UInt32>(LUTSize);
+                m_lut = dr::zeros<DynamicBuffer<Float>>(LUTSize * Channels);
+                for (uint32_t c = 0; c < Channels; ++c)
+                    dr::scatter(m_lut, value.entry(c), idx * Channels + c);
+                dr::eval(m_lut);
+            } else {
+                std::unique_ptr<ScalarFloat[]> lut(new ScalarFloat[LUTSize * Channels]);
+                for (uint32_t i = 0; i < LUTSize; ++i) {
+                    color value = ramp_interpolation<color>(
+                        ScalarFloat(i) / ScalarFloat(LUTSize - 1), si, true);
+                    for (uint32_t c = 0; c < Channels; ++c)
+                        lut[i * Channels + c] = value.entry(c);
+                }
+                m_lut = dr::load<DynamicBuffer<Float>>(lut.get(), LUTSize * Channels);
+            }
+
+            m_lut_baked = true;
+        }
+    }
+
+    /// Single fetch + lerp into the table produced by \ref bake_lut()
+    template<typename color>
+    MI_INLINE color lut_lookup(Float fac, Mask active) const {
+        if constexpr (!dr::is_array_v<Mask>)
+            active = true;
+
+        fac = dr::clamp(fac, 0.f, 1.f) * ScalarFloat(LUTSize - 1);
+        UInt32 idx = dr::minimum(UInt32(fac), LUTSize - 2);
+
+        color v0 = dr::gather<color>(m_lut, idx, active),
+              v1 = dr::gather<color>(m_lut, idx + 1, active);
+
+        return dr::lerp(v0, v1, fac - Float(idx));
+    }
+
+    /**
+     * \brief Exact per-mode evaluation of the ramp at interpolation factor \c fac
+     *
+     * Shared by the bitmap-driven and single-factor code paths; also used by
+     * \ref bake_lut() to tabulate the ramp at construction time.
+     */
+    template<typename color>
+    MI_INLINE color ramp_interpolation(Float fac, const SurfaceInteraction3f &si, Mask active) const {
+        if constexpr (!dr::is_array_v<Mask>)
+            active = true;
+
         if (m_mode == "linear") {
             UInt32 higher_boundary = dr::binary_search<UInt32>(
                 0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
@@ -470,6 +553,7 @@ protected:
                     return dr::gather<Float>(m_pos_dr, idx, active) <= fac;
                 }
             );
+
             higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
 
             UInt32 lower_boundary = dr::select(
@@ -478,6 +562,7 @@ protected:
                 higher_boundary,
                 higher_boundary - 1
             );
+
             lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
 
             return dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active)->eval(si, active);
@@ -580,183 +665,11 @@ protected:
      * Should only be used when there is only single factor for interpolation
      */
     template<typename color>
-    MI_INLINE color single_factor_interpolation(const SurfaceInteraction3f &si,Mask active) const {
-        if constexpr (!dr::is_array_v<Mask>)
-            active = true;
-
-        if (m_mode == "linear") {
-            UInt32 higher_boundary = dr::binary_search<UInt32>(
-                0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
-                    return dr::gather<Float>(m_pos_dr, idx, active) <= m_factor;
-                }
-            );
-
-            higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
-            TexturePtr tex1= dr::gather<TexturePtr>(m_color_band_dr, higher_boundary, active);
-            Float pos1 = dr::gather<Float>(m_pos_dr, higher_boundary, active);
-
-            UInt32 lower_boundary = dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                higher_boundary,
-                higher_boundary - 1
-            );
-
-            lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
-            TexturePtr tex0 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active);
-            Float pos0 = dr::gather<Float>(m_pos_dr, lower_boundary, active);
+    MI_INLINE color single_factor_interpolation(const SurfaceInteraction3f &si, Mask active) const {
+        if (m_lut_baked)
+            return lut_lookup<color>(m_factor, active);
 
-            Float relative_pos = dr::select(dr::neq(pos0, pos1), (m_factor - pos0) / (pos1 - pos0), 0.);
-
-            return dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                tex0->eval(si, active),
-                tex0->eval(si, active) * (1 - relative_pos) + tex1->eval(si, active) * relative_pos
-            );
-        }
-        else if (m_mode == "ease") {
-            UInt32 higher_boundary = dr::binary_search<UInt32>(
-                0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
-                    return dr::gather<Float>(m_pos_dr, idx, active) <= m_factor;
-                }
-            );
-
-            higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
-            TexturePtr tex1= dr::gather<TexturePtr>(m_color_band_dr, higher_boundary, active);
-            Float pos1 = dr::gather<Float>(m_pos_dr, higher_boundary, active);
-
-            UInt32 lower_boundary = dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                higher_boundary,
-                higher_boundary - 1
-            );
-
-            lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
-            TexturePtr tex0 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active);
-            Float pos0 = dr::gather<Float>(m_pos_dr, lower_boundary, active);
-
-            Float relative_pos = dr::select(dr::neq(pos1, pos0), (m_factor - pos0) / (pos1 - pos0), 0.0);
-            Float ease_fac = relative_pos * relative_pos * (3.0f - 2.0f * relative_pos);
-
-            return dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) < m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) > m_factor,
-                tex0->eval(si, active),
-                tex0->eval(si, active) * (1 - ease_fac) + tex1->eval(si, active) * ease_fac
-            );
-        }
-        else if (m_mode == "constant") {
-            UInt32 higher_boundary = dr::binary_search<UInt32>(
-                0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
-                    return dr::gather<Float>(m_pos_dr, idx, active) <= m_factor;
-                }
-            );
-
-            higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
-
-            UInt32 lower_boundary = dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                higher_boundary,
-                higher_boundary - 1
-            );
-
-            lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
-
-            return dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active)->eval(si, active);
-        }
-        else if (m_mode == "cardinal") {
-            UInt32 higher_boundary = dr::binary_search<UInt32>(
-                0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
-                    return dr::gather<Float>(m_pos_dr, idx, active) <= m_factor;
-                }
-            );
-
-            higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
-            TexturePtr tex2= dr::gather<TexturePtr>(m_color_band_dr, higher_boundary, active);
-            Float pos2 = dr::gather<Float>(m_pos_dr, higher_boundary, active);
-
-            UInt32 lower_boundary = dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                higher_boundary,
-                higher_boundary - 1
-            );
-
-            lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
-            TexturePtr tex1 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active);
-            Float pos1 = dr::gather<Float>(m_pos_dr, lower_boundary, active);
-
-            Float relative_pos = (m_factor - pos1) / (pos2 - pos1);
-            Float weight[4];
-            key_curve_position_weights(relative_pos, weight, m_mode);
-
-            UInt32 lower_boundary_left = dr::select(lower_boundary > 0, lower_boundary - 1, lower_boundary);
-            lower_boundary_left = dr::clamp(lower_boundary_left, 0, m_num_band - 1);
-            TexturePtr tex0 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary_left, active);
-
-            UInt32 higher_boundary_right = dr::select(higher_boundary < UInt32(m_num_band - 1), higher_boundary + 1, higher_boundary);
-            higher_boundary_right = dr::clamp(higher_boundary_right, 0, m_num_band - 1);
-            TexturePtr tex3 = dr::gather<TexturePtr>(m_color_band_dr, higher_boundary_right, active);
-
-            return dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                tex1->eval(si, active),
-                tex0->eval(si, active) * weight[0] +
-                    tex1->eval(si, active) * weight[1] +
-                    tex2->eval(si, active) * weight[2] +
-                    tex3->eval(si, active) * weight[3]
-            );
-        }
-        else if (m_mode == "b_spline") {
-            UInt32 higher_boundary = dr::binary_search<UInt32>(
-                0, m_num_band - 1, [&](UInt32 idx) DRJIT_INLINE_LAMBDA {
-                    return dr::gather<Float>(m_pos_dr, idx, active) <= m_factor;
-                }
-            );
-
-            higher_boundary = dr::clamp(higher_boundary, 0, m_num_band - 1);
-            TexturePtr tex2= dr::gather<TexturePtr>(m_color_band_dr, higher_boundary, active);
-            Float pos2 = dr::gather<Float>(m_pos_dr, higher_boundary, active);
-
-            UInt32 lower_boundary = dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                higher_boundary,
-                higher_boundary - 1
-            );
-
-            lower_boundary = dr::clamp(lower_boundary, 0, m_num_band - 1);
-            TexturePtr tex1 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary, active);
-            Float pos1 = dr::gather<Float>(m_pos_dr, lower_boundary, active);
-
-            Float relative_pos = (m_factor - pos1) / (pos2 - pos1);
-            Float weight[4];
-            key_curve_position_weights(relative_pos, weight, m_mode);
-
-            UInt32 lower_boundary_left = dr::select(lower_boundary > 0, lower_boundary - 1, lower_boundary);
-            lower_boundary_left = dr::clamp(lower_boundary_left, 0, m_num_band - 1);
-            TexturePtr tex0 = dr::gather<TexturePtr>(m_color_band_dr, lower_boundary_left, active);
-
-            UInt32 higher_boundary_right = dr::select(higher_boundary < UInt32(m_num_band - 1), higher_boundary + 1, higher_boundary);
-            higher_boundary_right = dr::clamp(higher_boundary_right, 0, m_num_band - 1);
-            TexturePtr tex3 = dr::gather<TexturePtr>(m_color_band_dr, higher_boundary_right, active);
-
-            return dr::select(
-                dr::gather<Float>(m_pos_dr, UInt32(m_num_band - 1), active) <= m_factor ||
-                    dr::gather<Float>(m_pos_dr, UInt32(0), active) >= m_factor,
-                tex1->eval(si, active),
-                tex0->eval(si, active) * weight[0] +
-                    tex1->eval(si, active) * weight[1] +
-                    tex2->eval(si, active) * weight[2] +
-                    tex3->eval(si, active) * weight[3]
-            );
-        }
-        else
-            Throw("Unknown interpolation type. Please specific interpolation mode (linear, ease, constant, cardinal, b_spline) in ColorRamp!");
+        return ramp_interpolation<color>(m_factor, si, active);
     }
 
 protected:
@@ -775,6 +688,11 @@ protected:
     std::vector<ref<Texture>> m_color_band;
     DynamicBuffer<TexturePtr> m_color_band_dr;
     DynamicBuffer<Float> m_pos_dr;
+
+    /// Baked ramp table with interleaved channels (see \ref bake_lut())
+    static constexpr uint32_t LUTSize = 256;
+    DynamicBuffer<Float> m_lut;
+    bool m_lut_baked = false;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(ColorRamp, Texture)
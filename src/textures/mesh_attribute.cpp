@@ -1,7 +1,9 @@
 #include <mitsuba/render/texture.h>
 #include <mitsuba/render/interaction.h>
+#include <mitsuba/render/mesh.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/transform.h>
+#include <atomic>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -74,7 +76,7 @@ whose reflectance is specified using the ``vertex_color`` attribute of that mesh
 template <typename Float, typename Spectrum>
 class MeshAttribute final : public Texture<Float, Spectrum> {
 public:
-    MI_IMPORT_TYPES(Texture)
+    MI_IMPORT_TYPES(Texture, Mesh)
 
     MeshAttribute(const Properties &props)
     : Texture(props) {
@@ -93,16 +95,28 @@ public:
 
     UnpolarizedSpectrum eval(const SurfaceInteraction3f &si, Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (const CacheEntry *entry = resolve(si))
+                return entry->mesh->eval_attribute(*entry->attr, si, active) * m_scale;
+        }
         return si.shape->eval_attribute(m_name, si, active) * m_scale;
     }
 
     Float eval_1(const SurfaceInteraction3f &si, Mask active = true) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (const CacheEntry *entry = resolve(si))
+                return entry->mesh->eval_attribute_1(*entry->attr, si, active) * m_scale;
+        }
         return si.shape->eval_attribute_1(m_name, si, active) * m_scale;
     }
 
     Color3f eval_3(const SurfaceInteraction3f &si, Mask active = true) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (const CacheEntry *entry = resolve(si))
+                return entry->mesh->eval_attribute_3(*entry->attr, si, active) * m_scale;
+        }
         return si.shape->eval_attribute_3(m_name, si, active) * m_scale;
     }
 
@@ -117,8 +131,46 @@ public:
 
     MI_DECLARE_CLASS()
 protected:
+    ~MeshAttribute() {
+        delete m_cache.load(std::memory_order_relaxed);
+    }
+
+    /* One-entry cache binding the texture to the resolved attribute record
+       of the first mesh it is evaluated on. Only used in scalar variants,
+       where the name-based interface would otherwise hash the attribute
+       name on every hit -- in JIT variants, that lookup runs just once
+       while tracing. The entry is installed at most once and published
+       atomically, since scalar rendering evaluates textures concurrently. */
+    struct CacheEntry {
+        const Mesh *mesh;
+        const typename Mesh::MeshAttribute *attr;
+    };
+
+    const CacheEntry *resolve(const SurfaceInteraction3f &si) const {
+        const Mesh *mesh = dynamic_cast<const Mesh *>(si.shape);
+        if (!mesh)
+            return nullptr;
+
+        CacheEntry *entry = m_cache.load(std::memory_order_acquire);
+        if (!entry) {
+            const typename Mesh::MeshAttribute *attr = mesh->find_attribute(m_name);
+            if (!attr)
+                return nullptr;
+
+            CacheEntry *fresh = new CacheEntry { mesh, attr };
+            if (m_cache.compare_exchange_strong(entry, fresh,
+                                                std::memory_order_release,
+                                                std::memory_order_acquire))
+                return fresh;
+            delete fresh;
+        }
+
+        return entry->mesh == mesh && entry->attr ? entry : nullptr;
+    }
+
     std::string m_name;
     float m_scale;
+    mutable std::atomic<CacheEntry *> m_cache { nullptr };
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(MeshAttribute, Texture)
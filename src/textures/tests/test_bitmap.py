@@ -230,3 +230,135 @@ def test05_eval_spectral(variants_vec_backends_once_spectral):
     expected = 0.5394
     assert dr.allclose(expected, spec, atol=1e-04)
     assert dr.allclose(expected, mono, atol=1e-04)
+
+
+@fresolver_append_path
+def test06_stochastic_filter(variants_vec_backends_once_rgb, np_rng):
+    import numpy as np
+
+    kwargs = {
+        'type' : 'bitmap',
+        'filename' : 'resources/data/common/textures/noise_8x8.png'
+    }
+    bilinear   = mi.load_dict({**kwargs, 'filter_type': 'bilinear'})
+    nearest    = mi.load_dict({**kwargs, 'filter_type': 'nearest'})
+    stochastic = mi.load_dict({**kwargs, 'filter_type': 'stochastic'})
+
+    # Each stochastic lookup fetches a single texel, i.e. it returns one of
+    # the values that nearest neighbor lookups at texel centers produce
+    x_res, y_res = stochastic.resolution()
+    gx, gy = np.meshgrid((np.arange(x_res) + 0.5) / x_res,
+                         (np.arange(y_res) + 0.5) / y_res)
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    si.uv = mi.Point2f(gx.ravel(), gy.ravel())
+    texels = np.array(nearest.eval_1(si))
+
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    si.uv = mi.Point2f(np_rng.uniform(size=1024), np_rng.uniform(size=1024))
+    values = np.array(stochastic.eval_1(si))
+    dist = np.abs(values[:, None] - texels[None, :]).min(axis=1)
+    assert np.all(dist < 1e-6)
+
+    # Averaged over many lookups, stochastic filtering matches bilinear
+    # filtering in expectation
+    n = 1 << 18
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    si.uv = mi.Point2f(np_rng.uniform(low=0.2, high=0.45, size=n),
+                       np_rng.uniform(low=0.55, high=0.8, size=n))
+    mean_stochastic = np.mean(np.array(stochastic.eval_1(si)))
+    mean_bilinear = np.mean(np.array(bilinear.eval_1(si)))
+    assert np.abs(mean_stochastic - mean_bilinear) < 5e-3
+
+
+@fresolver_append_path
+def test07_trilinear_filter(variants_vec_backends_once_rgb, np_rng):
+    import numpy as np
+
+    kwargs = {
+        'type' : 'bitmap',
+        'filename' : 'resources/data/common/textures/noise_8x8.png'
+    }
+    bilinear  = mi.load_dict({**kwargs, 'filter_type': 'bilinear'})
+    trilinear = mi.load_dict({**kwargs, 'filter_type': 'trilinear'})
+
+    # Only the trilinear mode requests UV partials from its consumers
+    assert not bilinear.uses_ray_differentials()
+    assert trilinear.uses_ray_differentials()
+
+    # Without ray differentials, trilinear lookups read the finest mip
+    # level and exactly match bilinear filtering
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    si.uv = mi.Point2f(np_rng.uniform(size=1024), np_rng.uniform(size=1024))
+    assert dr.allclose(trilinear.eval_3(si), bilinear.eval_3(si))
+
+    # A footprint covering the whole texture resolves to the coarsest
+    # (1x1) level, whose single texel stores the per-channel image mean
+    x_res, y_res = trilinear.resolution()
+    gx, gy = np.meshgrid((np.arange(x_res) + 0.5) / x_res,
+                         (np.arange(y_res) + 0.5) / y_res)
+    si_grid = dr.zeros(mi.SurfaceInteraction3f)
+    si_grid.uv = mi.Point2f(gx.ravel(), gy.ravel())
+    texels = bilinear.eval_3(si_grid)
+
+    si.duv_dx = mi.Vector2f(1.0, 0.0)
+    si.duv_dy = mi.Vector2f(0.0, 1.0)
+    coarsest = trilinear.eval_3(si)
+    for i in range(3):
+        assert dr.allclose(coarsest[i], dr.mean(texels[i]), atol=1e-3)
+
+    # Intermediate footprints blend neighboring pyramid levels
+    si.duv_dx = mi.Vector2f(0.5, 0.0)
+    si.duv_dy = mi.Vector2f(0.0, 0.5)
+    blurred = trilinear.eval_3(si)
+    assert not dr.allclose(blurred, bilinear.eval_3(si), atol=1e-3)
+    assert not dr.allclose(blurred, coarsest, atol=1e-3)
+
+
+def test08_trilinear_render(variant_scalar_rgb, np_rng, tmp_path):
+    """
+    End-to-end check of the ray differential wiring: a BSDF holding a
+    trilinear-filtered texture advertises NeedsDifferentials, so the
+    integrator computes UV partials and the mip pyramid engages when a
+    distant surface is minified -- smoothing the result relative to
+    bilinear point sampling.
+    """
+    import numpy as np
+
+    tex = np_rng.uniform(size=(64, 64, 3)).astype(np.float32)
+    fname = str(tmp_path / 'noise.exr')
+    mi.Bitmap(tex).write(fname)
+
+    def make_scene(filter_type):
+        return mi.load_dict({
+            'type': 'scene',
+            'integrator': {'type': 'direct'},
+            'sensor': {
+                'type': 'perspective',
+                'fov': 10,
+                'to_world': mi.ScalarTransform4f().look_at(
+                    origin=[0, 0, 50], target=[0, 0, 0], up=[0, 1, 0]),
+                'film': {'type': 'hdrfilm', 'width': 32, 'height': 32,
+                         'rfilter': {'type': 'box'}},
+                'sampler': {'type': 'independent', 'sample_count': 16}
+            },
+            'emitter': {'type': 'constant'},
+            'shape': {
+                'type': 'rectangle',
+                'to_world': mi.ScalarTransform4f().scale(5),
+                'bsdf': {
+                    'type': 'diffuse',
+                    'reflectance': {'type': 'bitmap', 'filename': fname,
+                                    'filter_type': filter_type}
+                }
+            }
+        })
+
+    scene = make_scene('trilinear')
+    bsdf = scene.shapes()[0].bsdf()
+    assert bsdf.flags() & int(mi.BSDFFlags.NeedsDifferentials)
+
+    img_bi  = np.array(mi.render(make_scene('bilinear'),  seed=0))
+    img_tri = np.array(mi.render(make_scene('trilinear'), seed=0))
+
+    assert not np.allclose(img_bi, img_tri, atol=1e-3)
+    assert img_tri.var() < img_bi.var()
@@ -192,4 +192,35 @@ def test05_eval_spectral(variants_vec_backends_once_spectral):
 
     expected = 0.5394
     assert dr.allclose(expected, spec, atol=1e-04)
-    assert dr.allclose(expected, mono, atol=1e-04)
\ No newline at end of file
+    assert dr.allclose(expected, mono, atol=1e-04)
+
+def test06_eval_single_factor(variant_scalar_rgb):
+    # Constant color bands are baked into a LUT at construction; compare the
+    # baked evaluation against analytic references for both a linear and a
+    # curved interpolation mode
+    def make(mode, factor):
+        return mi.load_dict({
+            'type': 'color_ramp',
+            'mode': mode,
+            'factor': factor,
+            'num_band': 2,
+            'pos0': 0.25,
+            'pos1': 0.75,
+            'color0': {
+                'type': 'rgb',
+                'value': [0.0, 0.0, 0.0]
+            },
+            'color1': {
+                'type': 'rgb',
+                'value': [1.0, 1.0, 1.0]
+            },
+        })
+
+    # The tolerance accounts for the quantization of the 256-entry table
+    # around the kinks at pos0/pos1
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    for f in [0.0, 0.25, 0.4, 0.5, 0.6, 0.75, 1.0]:
+        t = min(max((f - 0.25) / 0.5, 0.0), 1.0)
+        assert dr.allclose(make('linear', f).eval(si), t, atol=5e-3)
+        assert dr.allclose(make('ease', f).eval(si),
+                           t * t * (3.0 - 2.0 * t), atol=5e-3)
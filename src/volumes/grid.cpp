@@ -63,11 +63,27 @@ Grid-based volume data source (:monosp:`gridvolume`)
    - |transform|
    - Specifies an optional 4x4 transformation matrix that will be applied to volume coordinates.
 
+ * - mip_levels
+   - |int|
+   - Number of additional box-filtered mip levels that are built at loading
+     time and can subsequently be accessed via :py:meth:`mitsuba.Volume.eval_lod`.
+     Each level halves the resolution along every axis. This is mainly useful
+     for density grids, where coarse lookups on transmittance-only (shadow
+     ray) queries trade a small amount of bias for a substantially cheaper
+     estimator (see the :paramtype:`shadow_mip_level` parameter of the
+     :ref:`heterogeneous <medium-heterogeneous>` medium). Since each mip level
+     is produced by averaging, the maximum of the full-resolution grid remains
+     a valid majorant at every level. Only supported for single-channel grids.
+     (Default: 0, i.e. no mip hierarchy)
+
  * - accel
    - |bool|
-   - Hardware acceleration features can be used in CUDA mode. These features can
-     cause small differences as hardware interpolation methods typically have a
-     loss of precision (not exactly 32-bit arithmetic). (Default: true)
+   - Hardware acceleration features can be used in CUDA mode. In particular,
+     the grid is then backed by a CUDA 3D texture object, and trilinear
+     lookups use the texture filtering hardware rather than software
+     interpolation with eight separate fetches. This can cause small
+     differences as hardware interpolation methods typically have a loss of
+     precision (not exactly 32-bit arithmetic). (Default: true)
 
  * - data
    - |tensor|
@@ -258,6 +274,64 @@ public:
             m_fixed_max = true;
             m_max = props.get<ScalarFloat>("max_value");
         }
+
+        uint32_t mip_levels = (uint32_t) props.get<int>("mip_levels", 0);
+        if (mip_levels > 0) {
+            if (m_volume_grid->channel_count() != 1)
+                Throw("\"mip_levels\" is currently only supported for "
+                      "single-channel grids (found %d channels)!",
+                      m_volume_grid->channel_count());
+
+            /* Build a chain of box-filtered copies of the grid by repeated
+               2x downsampling. Averaging never increases the maximum, hence
+               'm_max' remains a valid majorant at every level. */
+            std::vector<ScalarFloat> prev(m_volume_grid->data(),
+                                          m_volume_grid->data() + size);
+            ScalarVector3i prev_res = res;
+            for (uint32_t level = 0; level < mip_levels; ++level) {
+                if (dr::all(dr::eq(prev_res, ScalarVector3i(1))))
+                    break; // Grid has collapsed to a single voxel
+
+                ScalarVector3i next_res = dr::maximum((prev_res + 1) / 2, 1);
+                std::vector<ScalarFloat> next((size_t) dr::prod(next_res));
+
+                for (int z = 0; z < next_res.z(); ++z) {
+                    for (int y = 0; y < next_res.y(); ++y) {
+                        for (int x = 0; x < next_res.x(); ++x) {
+                            ScalarFloat accum = 0.f;
+                            for (int d = 0; d < 8; ++d) {
+                                // Clamp source coordinates at odd boundaries
+                                int sx = dr::minimum(2 * x + (d & 1),        prev_res.x() - 1),
+                                    sy = dr::minimum(2 * y + ((d >> 1) & 1), prev_res.y() - 1),
+                                    sz = dr::minimum(2 * z + ((d >> 2) & 1), prev_res.z() - 1);
+                                accum += prev[((size_t) sz * prev_res.y() + sy) *
+                                              prev_res.x() + sx];
+                            }
+                            next[((size_t) z * next_res.y() + y) * next_res.x() + x] =
+                                accum * (1.f / 8.f);
+                        }
+                    }
+                }
+
+                size_t mip_shape[4] = {
+                    (size_t) next_res.z(),
+                    (size_t) next_res.y(),
+                    (size_t) next_res.x(),
+                    1
+                };
+                m_mips.emplace_back(TensorXf(next.data(), 4, mip_shape),
+                                    m_accel, m_accel, filter_mode, wrap_mode);
+
+                prev = std::move(next);
+                prev_res = next_res;
+            }
+        }
+
+        /* Everything needed from the grid (data, extrema, bounds) has been
+           copied into the texture / members above. Drop the reference so
+           that the staging copy of a potentially very large volume does not
+           stay resident for the whole render. */
+        m_volume_grid = nullptr;
     }
 
     void traverse(TraversalCallback *callback) override {
@@ -277,6 +351,12 @@ public:
 
             if (!m_fixed_max)
                 m_max = (float) dr::max_nested(dr::detach(m_texture.value()));
+
+            if (!m_mips.empty())
+                Log(Warn, "GridVolume: the volume data was updated, but the "
+                          "mip hierarchy is only computed at loading time. "
+                          "Level-of-detail queries will continue to see the "
+                          "original data.");
         }
     }
 
@@ -381,6 +461,33 @@ public:
         }
     }
 
+    UnpolarizedSpectrum eval_lod(const Interaction3f &it, uint32_t level,
+                                 Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (level == 0 || m_mips.empty())
+            return eval(it, active);
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<UnpolarizedSpectrum>();
+
+        level = dr::minimum(level, (uint32_t) m_mips.size());
+        const Texture3f &mip = m_mips[level - 1];
+
+        Point3f p = m_to_local * it.p;
+        Float result;
+        if (m_accel)
+            mip.eval(p, &result, active);
+        else
+            mip.eval_nonaccel(p, &result, active);
+
+        return result;
+    }
+
+    uint32_t mip_level_count() const override {
+        return (uint32_t) m_mips.size() + 1;
+    }
+
     ScalarFloat max() const override { return m_max; }
 
     void max_per_channel(ScalarFloat *out) const override {
@@ -388,6 +495,94 @@ public:
             out[i] = m_max_per_channel[i];
     }
 
+    void max_per_cell(const ScalarVector3u &res,
+                      ScalarFloat *out) const override {
+        size_t cell_count = (size_t) dr::prod(res);
+
+        if (m_fixed_max) {
+            /* The user supplied an explicit bound (``max_value``); respect
+               it rather than inspecting the data */
+            for (size_t i = 0; i < cell_count; ++i)
+                out[i] = m_max;
+            return;
+        }
+
+        const size_t *shape = m_texture.shape();
+        size_t nz = shape[0], ny = shape[1], nx = shape[2],
+               channels = shape[3];
+
+        auto &&data = dr::migrate(m_texture.value(), AllocType::Host);
+        if constexpr (dr::is_jit_v<Float>)
+            dr::sync_thread();
+        const ScalarFloat *ptr = data.data();
+
+        for (size_t i = 0; i < cell_count; ++i)
+            out[i] = 0.f;
+
+        /* Trilinear interpolation places the grid nodes at voxel centers,
+           and each node influences lookups up to one voxel away. The loop
+           below therefore splats every node into all cells of the coarse
+           grid that overlap its support, which yields bounds that hold for
+           any interpolated lookup within a cell -- and slightly beyond its
+           boundary, absorbing the epsilon by which ray marching schemes
+           step across cell interfaces. */
+        ScalarTransform4f to_world = m_to_local.inverse();
+        ScalarVector3f extents = m_bbox.extents(),
+                       inv_n(1.f / (ScalarFloat) nx, 1.f / (ScalarFloat) ny,
+                             1.f / (ScalarFloat) nz),
+                       res_f((ScalarFloat) res.x(), (ScalarFloat) res.y(),
+                             (ScalarFloat) res.z());
+
+        // Conservative world-space support radius of one node per axis
+        ScalarVector3f radius(0.f);
+        for (size_t a = 0; a < 3; ++a)
+            for (size_t j = 0; j < 3; ++j)
+                radius[a] += dr::abs(to_world.matrix.entry(a, j)) * inv_n[j];
+        ScalarVector3f dilation = radius / extents;
+
+        for (size_t z = 0; z < nz; ++z) {
+            for (size_t y = 0; y < ny; ++y) {
+                for (size_t x = 0; x < nx; ++x) {
+                    const ScalarFloat *v =
+                        ptr + ((z * ny + y) * nx + x) * channels;
+
+                    ScalarFloat value;
+                    if (is_spectral_v<Spectrum> && channels == 4 && !m_raw) {
+                        // Spectral upsampling: the scale coefficient is the bound
+                        value = v[3];
+                    } else {
+                        value = v[0];
+                        for (size_t c = 1; c < channels; ++c)
+                            value = dr::maximum(value, v[c]);
+                    }
+
+                    ScalarPoint3f local(((ScalarFloat) x + .5f) * inv_n.x(),
+                                        ((ScalarFloat) y + .5f) * inv_n.y(),
+                                        ((ScalarFloat) z + .5f) * inv_n.z());
+                    ScalarVector3f rel =
+                        (to_world * local - m_bbox.min) / extents;
+
+                    ScalarVector3i lo, hi;
+                    for (size_t a = 0; a < 3; ++a) {
+                        lo[a] = dr::maximum(
+                            (int) dr::floor((rel[a] - dilation[a]) * res_f[a]), 0);
+                        hi[a] = dr::minimum(
+                            (int) dr::floor((rel[a] + dilation[a]) * res_f[a]),
+                            (int) res[a] - 1);
+                    }
+
+                    for (int cz = lo.z(); cz <= hi.z(); ++cz)
+                        for (int cy = lo.y(); cy <= hi.y(); ++cy)
+                            for (int cx = lo.x(); cx <= hi.x(); ++cx) {
+                                size_t cell = ((size_t) cz * res.y() + cy) *
+                                              res.x() + cx;
+                                out[cell] = dr::maximum(out[cell], value);
+                            }
+                }
+            }
+        }
+    }
+
     ScalarVector3i resolution() const override {
         const size_t *shape = m_texture.shape();
         return { (int) shape[2], (int) shape[1], (int) shape[0] };
@@ -574,6 +769,8 @@ protected:
 
 protected:
     Texture3f m_texture;
+    /// Optional box-filtered copies of the grid at progressively halved resolutions
+    std::vector<Texture3f> m_mips;
     bool m_accel;
     bool m_raw;
     ref<VolumeGrid> m_volume_grid;
@@ -0,0 +1,400 @@
+#include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/transform.h>
+#include <mitsuba/render/volume.h>
+#include <mitsuba/render/volumegrid.h>
+#include <drjit/dynamic.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+
+/**!
+.. _volume-sparsegridvolume:
+
+Sparse grid-based volume data source (:monosp:`sparsegridvolume`)
+-----------------------------------------------------------------
+
+.. pluginparameters::
+
+ * - filename
+   - |string|
+   - Filename of the volume to be loaded
+
+ * - grid
+   - :monosp:`VolumeGrid object`
+   - When creating a sparse grid volume at runtime, e.g. from Python or C++,
+     an existing ``VolumeGrid`` instance can be passed directly rather than
+     loading it from the filesystem with :paramtype:`filename`.
+
+ * - filter_type
+   - |string|
+   - Specifies how voxel values are interpolated. The following options are
+     currently available:
+
+     - ``trilinear`` (default): perform trilinear interpolation.
+
+     - ``nearest``: disable interpolation. In this mode, the plugin
+       performs nearest neighbor lookups of volume values.
+
+ * - threshold
+   - |float|
+   - Bricks whose voxel values are all less than or equal to this threshold
+     are not stored; lookups inside them return zero. (Default: 0)
+
+ * - to_world
+   - |transform|
+   - Specifies an optional 4x4 transformation matrix that will be applied to
+     volume coordinates.
+
+This plugin provides a sparse counterpart of the dense :ref:`gridvolume
+<volume-gridvolume>` plugin for single-channel data such as density grids
+of smoke or cloud simulations, where the vast majority of voxels is
+typically zero. The volume is read from the same binary ``.vol`` exchange
+format and converted at loading time into a two-level structure in the
+spirit of VDB: the grid is partitioned into bricks of :math:`8^3` voxels,
+a coarse table stores one entry per brick, and only bricks containing
+values above :paramtype:`threshold` are kept in memory as dense blocks.
+This reduces storage by the fraction of empty bricks and improves access
+locality, since the voxels of a brick are contiguous.
+
+Lookups outside of stored bricks evaluate to zero, and lookups outside of
+the :math:`[0, 1]` volume domain are clamped to the boundary (matching the
+default ``clamp`` wrap mode of :ref:`gridvolume <volume-gridvolume>`).
+Unlike its dense counterpart, this plugin does not expose the volume data
+as a differentiable parameter; use :ref:`gridvolume <volume-gridvolume>`
+when gradients with respect to the voxel values are needed.
+
+.. tabs::
+    .. code-tab:: xml
+
+        <medium type="heterogeneous">
+            <volume type="sparsegridvolume" name="sigma_t">
+                <string name="filename" value="smoke_0150.vol"/>
+            </volume>
+        </medium>
+
+    .. code-tab:: python
+
+        'type': 'heterogeneous',
+        'sigma_t': {
+            'type': 'sparsegridvolume',
+            'filename': 'smoke_0150.vol'
+        }
+
+*/
+
+template <typename Float, typename Spectrum>
+class SparseGridVolume final : public Volume<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(Volume, update_bbox, m_to_local, m_bbox, m_channel_count)
+    MI_IMPORT_TYPES(VolumeGrid)
+
+    /// Bricks store 2^BrickShift voxels along each axis
+    static constexpr uint32_t BrickShift  = 3;
+    static constexpr uint32_t BrickRes    = 1 << BrickShift;
+    static constexpr uint32_t BrickVoxels = BrickRes * BrickRes * BrickRes;
+
+    /// Table entry denoting a brick without stored data
+    static constexpr uint32_t EmptyBrick = (uint32_t) -1;
+
+    SparseGridVolume(const Properties &props) : Base(props) {
+        std::string filter_type_str = props.string("filter_type", "trilinear");
+        if (filter_type_str == "nearest")
+            m_nearest = true;
+        else if (filter_type_str == "trilinear")
+            m_nearest = false;
+        else
+            Throw("Invalid filter type \"%s\", must be one of: \"nearest\" or "
+                  "\"trilinear\"!", filter_type_str);
+
+        ref<VolumeGrid> volume_grid;
+        if (props.has_property("grid")) {
+            if (props.has_property("filename"))
+                Throw("Cannot specify both \"grid\" and \"filename\".");
+            Log(Debug, "Loading volume grid from memory...");
+            // Note: ref-counted, so we don't have to worry about lifetime
+            ref<Object> other = props.object("grid");
+            volume_grid = dynamic_cast<VolumeGrid *>(other.get());
+            if (!volume_grid)
+                Throw("Property \"grid\" must be a VolumeGrid instance.");
+        } else {
+            FileResolver *fs = Thread::thread()->file_resolver();
+            fs::path file_path = fs->resolve(props.string("filename"));
+            if (!fs::exists(file_path))
+                Log(Error, "\"%s\": file does not exist!", file_path);
+            volume_grid = new VolumeGrid(file_path);
+        }
+
+        if (volume_grid->channel_count() != 1)
+            Throw("SparseGridVolume: only single-channel grids are supported "
+                  "(found %d channels); use the \"gridvolume\" plugin for "
+                  "multi-channel data.", volume_grid->channel_count());
+        m_channel_count = 1;
+
+        ScalarFloat threshold = props.get<ScalarFloat>("threshold", 0.f);
+
+        if (props.get<bool>("use_grid_bbox", false)) {
+            m_to_local = volume_grid->bbox_transform() * m_to_local;
+            update_bbox();
+        }
+
+        ScalarVector3i res = volume_grid->size();
+        m_res = ScalarVector3u(res.x(), res.y(), res.z());
+        m_bricks = (m_res + BrickRes - 1u) >> BrickShift;
+        m_max = volume_grid->max();
+
+        build_bricks(volume_grid->data(), threshold);
+    }
+
+    Float eval_1(const Interaction3f &it, Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<Float>();
+
+        return interpolate_1(it, active);
+    }
+
+    UnpolarizedSpectrum eval(const Interaction3f &it,
+                             Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<UnpolarizedSpectrum>();
+
+        return interpolate_1(it, active);
+    }
+
+    ScalarFloat max() const override { return m_max; }
+
+    void max_per_channel(ScalarFloat *out) const override { out[0] = m_max; }
+
+    void max_per_cell(const ScalarVector3u &res,
+                      ScalarFloat *out) const override {
+        size_t cell_count = (size_t) dr::prod(res);
+        for (size_t i = 0; i < cell_count; ++i)
+            out[i] = 0.f;
+
+        /* Splat the per-brick maxima computed during construction into the
+           coarse cells overlapping each brick. Bricks are conservative over
+           their voxels' trilinear support (see \ref build_bricks()), so one
+           voxel of dilation accounts for interpolation across boundaries. */
+        ScalarTransform4f to_world = m_to_local.inverse();
+        ScalarVector3f extents = m_bbox.extents(),
+                       inv_n(1.f / (ScalarFloat) m_res.x(),
+                             1.f / (ScalarFloat) m_res.y(),
+                             1.f / (ScalarFloat) m_res.z()),
+                       res_f((ScalarFloat) res.x(), (ScalarFloat) res.y(),
+                             (ScalarFloat) res.z());
+
+        ScalarVector3f radius(0.f);
+        for (size_t a = 0; a < 3; ++a)
+            for (size_t j = 0; j < 3; ++j)
+                radius[a] += dr::abs(to_world.matrix.entry(a, j)) * inv_n[j];
+        ScalarVector3f dilation = radius / extents;
+
+        for (uint32_t bz = 0; bz < m_bricks.z(); ++bz) {
+            for (uint32_t by = 0; by < m_bricks.y(); ++by) {
+                for (uint32_t bx = 0; bx < m_bricks.x(); ++bx) {
+                    size_t brick = ((size_t) bz * m_bricks.y() + by) *
+                                   m_bricks.x() + bx;
+                    ScalarFloat value = m_brick_max[brick];
+                    if (value == 0.f)
+                        continue;
+
+                    // Local-space extents of the brick, voxel nodes at centers
+                    ScalarPoint3f b_min(bx * BrickRes * inv_n.x(),
+                                        by * BrickRes * inv_n.y(),
+                                        bz * BrickRes * inv_n.z()),
+                                  b_max = dr::minimum(
+                                      b_min + BrickRes * inv_n, 1.f);
+
+                    ScalarBoundingBox3f world_bbox;
+                    for (uint32_t d = 0; d < 8; ++d)
+                        world_bbox.expand(to_world * ScalarPoint3f(
+                            d & 1 ? b_max.x() : b_min.x(),
+                            d & 2 ? b_max.y() : b_min.y(),
+                            d & 4 ? b_max.z() : b_min.z()));
+
+                    ScalarVector3f rel_min = (world_bbox.min - m_bbox.min) / extents,
+                                   rel_max = (world_bbox.max - m_bbox.min) / extents;
+                    ScalarVector3i lo, hi;
+                    for (size_t a = 0; a < 3; ++a) {
+                        lo[a] = dr::maximum(
+                            (int) dr::floor((rel_min[a] - dilation[a]) * res_f[a]), 0);
+                        hi[a] = dr::minimum(
+                            (int) dr::floor((rel_max[a] + dilation[a]) * res_f[a]),
+                            (int) res[a] - 1);
+                    }
+
+                    for (int cz = lo.z(); cz <= hi.z(); ++cz)
+                        for (int cy = lo.y(); cy <= hi.y(); ++cy)
+                            for (int cx = lo.x(); cx <= hi.x(); ++cx) {
+                                size_t cell = ((size_t) cz * res.y() + cy) *
+                                              res.x() + cx;
+                                out[cell] = dr::maximum(out[cell], value);
+                            }
+                }
+            }
+        }
+    }
+
+    ScalarVector3i resolution() const override {
+        return ScalarVector3i(m_res.x(), m_res.y(), m_res.z());
+    };
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "SparseGridVolume[" << std::endl
+            << "  to_local = " << string::indent(m_to_local, 13) << "," << std::endl
+            << "  bbox = " << string::indent(m_bbox) << "," << std::endl
+            << "  dimensions = " << resolution() << "," << std::endl
+            << "  max = " << m_max << "," << std::endl
+            << "  bricks = " << m_brick_count << " / "
+            << dr::prod(m_bricks) << " stored" << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+protected:
+    /**
+     * \brief Convert a dense voxel array into the two-level brick structure
+     *
+     * Partitions the grid into bricks of <tt>BrickRes^3</tt> voxels and
+     * stores only those containing values above \c threshold, as contiguous
+     * dense blocks in \ref m_data. The brick table \ref m_table maps each
+     * brick to its block index, or \ref EmptyBrick when nothing is stored.
+     *
+     * A brick is also kept when any of its stored neighbors' boundary
+     * voxels interpolate into it; this is naturally handled by the lookup
+     * logic, which fetches each trilinear tap from the brick that owns the
+     * corresponding voxel.
+     */
+    void build_bricks(const ScalarFloat *ptr, ScalarFloat threshold) {
+        size_t brick_count_total = (size_t) dr::prod(m_bricks);
+        std::unique_ptr<uint32_t[]> table(new uint32_t[brick_count_total]);
+        m_brick_max.resize(brick_count_total, 0.f);
+        std::vector<ScalarFloat> data;
+
+        for (uint32_t bz = 0; bz < m_bricks.z(); ++bz) {
+            for (uint32_t by = 0; by < m_bricks.y(); ++by) {
+                for (uint32_t bx = 0; bx < m_bricks.x(); ++bx) {
+                    size_t brick = ((size_t) bz * m_bricks.y() + by) *
+                                   m_bricks.x() + bx;
+
+                    // Gather the brick's voxels, padding past the boundary
+                    ScalarFloat values[BrickVoxels];
+                    ScalarFloat brick_max = 0.f;
+                    for (uint32_t lz = 0; lz < BrickRes; ++lz) {
+                        for (uint32_t ly = 0; ly < BrickRes; ++ly) {
+                            for (uint32_t lx = 0; lx < BrickRes; ++lx) {
+                                uint32_t x = dr::minimum((bx << BrickShift) + lx, m_res.x() - 1),
+                                         y = dr::minimum((by << BrickShift) + ly, m_res.y() - 1),
+                                         z = dr::minimum((bz << BrickShift) + lz, m_res.z() - 1);
+                                ScalarFloat v =
+                                    ptr[((size_t) z * m_res.y() + y) * m_res.x() + x];
+                                values[(lz * BrickRes + ly) * BrickRes + lx] = v;
+                                brick_max = dr::maximum(brick_max, v);
+                            }
+                        }
+                    }
+
+                    m_brick_max[brick] = brick_max;
+                    if (brick_max <= threshold) {
+                        table[brick] = EmptyBrick;
+                        m_brick_max[brick] = 0.f;
+                    } else {
+                        table[brick] = (uint32_t) (data.size() / BrickVoxels);
+                        data.insert(data.end(), values, values + BrickVoxels);
+                    }
+                }
+            }
+        }
+
+        m_brick_count = (uint32_t) (data.size() / BrickVoxels);
+        Log(Info, "SparseGridVolume: %u/%zu bricks stored (%.1f%% of dense "
+                  "storage)", m_brick_count, brick_count_total,
+            100.0 * (double) (data.size() * sizeof(ScalarFloat)) /
+                (double) ((size_t) dr::prod(m_res) * sizeof(ScalarFloat)));
+
+        if (data.empty())
+            data.resize(1, 0.f); // Avoid gathering from an empty buffer
+
+        m_table = dr::load<DynamicBuffer<UInt32>>(table.get(), brick_count_total);
+        m_data  = dr::load<DynamicBuffer<Float>>(data.data(), data.size());
+    }
+
+    /// Fetch the voxel with the given integer coordinates (two gathers)
+    MI_INLINE Float fetch(const Vector3i &v_, Mask active) const {
+        Vector3i v = dr::clamp(v_, 0, Vector3i(m_res.x() - 1, m_res.y() - 1,
+                                               m_res.z() - 1));
+        UInt32 x = UInt32(v.x()), y = UInt32(v.y()), z = UInt32(v.z());
+
+        UInt32 brick = ((z >> BrickShift) * m_bricks.y() + (y >> BrickShift)) *
+                           m_bricks.x() + (x >> BrickShift);
+        UInt32 block = dr::gather<UInt32>(m_table, brick, active);
+
+        // Lanes hitting an empty brick evaluate to the zero background
+        Mask stored = active && dr::neq(block, EmptyBrick);
+        UInt32 index = block * BrickVoxels +
+                       ((z & (BrickRes - 1u)) * BrickRes + (y & (BrickRes - 1u))) *
+                           BrickRes + (x & (BrickRes - 1u));
+        return dr::gather<Float>(m_data, index, stored);
+    }
+
+    /// Nearest-neighbor or trilinear lookup in the brick structure
+    MI_INLINE Float interpolate_1(const Interaction3f &it, Mask active) const {
+        MI_MASK_ARGUMENT(active);
+
+        Point3f p = (m_to_local * it.p) *
+                    Vector3f(ScalarFloat(m_res.x()), ScalarFloat(m_res.y()),
+                             ScalarFloat(m_res.z()));
+
+        if (m_nearest)
+            return fetch(dr::floor2int<Vector3i>(p), active);
+
+        // Voxel nodes sit at cell centers, matching dr::Texture
+        p -= .5f;
+        Vector3i p_i = dr::floor2int<Vector3i>(p);
+        Point3f w1 = p - Point3f(p_i),
+                w0 = 1.f - w1;
+
+        Float d000 = fetch(p_i + Vector3i(0, 0, 0), active),
+              d100 = fetch(p_i + Vector3i(1, 0, 0), active),
+              d010 = fetch(p_i + Vector3i(0, 1, 0), active),
+              d110 = fetch(p_i + Vector3i(1, 1, 0), active),
+              d001 = fetch(p_i + Vector3i(0, 0, 1), active),
+              d101 = fetch(p_i + Vector3i(1, 0, 1), active),
+              d011 = fetch(p_i + Vector3i(0, 1, 1), active),
+              d111 = fetch(p_i + Vector3i(1, 1, 1), active);
+
+        Float f00 = dr::fmadd(w0.x(), d000, w1.x() * d100),
+              f10 = dr::fmadd(w0.x(), d010, w1.x() * d110),
+              f01 = dr::fmadd(w0.x(), d001, w1.x() * d101),
+              f11 = dr::fmadd(w0.x(), d011, w1.x() * d111);
+        Float f0 = dr::fmadd(w0.y(), f00, w1.y() * f10),
+              f1 = dr::fmadd(w0.y(), f01, w1.y() * f11);
+        return dr::fmadd(w0.z(), f0, w1.z() * f1);
+    }
+
+protected:
+    /// Dense voxel data of all stored bricks, concatenated
+    DynamicBuffer<Float> m_data;
+    /// Per-brick block index into \ref m_data, or \ref EmptyBrick
+    DynamicBuffer<UInt32> m_table;
+    /// Per-brick maxima (kept on the host for \ref max_per_cell())
+    std::vector<ScalarFloat> m_brick_max;
+    ScalarVector3u m_res, m_bricks;
+    uint32_t m_brick_count = 0;
+    ScalarFloat m_max;
+    bool m_nearest;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(SparseGridVolume, Volume)
+MI_EXPORT_PLUGIN(SparseGridVolume, "SparseGridVolume texture")
+
+NAMESPACE_END(mitsuba)
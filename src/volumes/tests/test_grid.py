@@ -114,3 +114,43 @@ def test06_eval_per_channel(variants_all_rgb, tmpdir):
     it.p = mi.Point3f(1.0)
     print(vol.eval_n(it))
     assert dr.allclose(vol.eval_n(it), [1.0, 2.0, 3.0, 4.0, 5.0, 6.0])
+
+
+def test07_mip_levels(variants_all, tmpdir):
+    tmp_file = os.path.join(str(tmpdir), "out.vol")
+    grid = dr.full(mi.TensorXf, 1, [4, 4, 4])
+    grid[0, 0, 0] = 9.0
+    mi.VolumeGrid(grid).write(tmp_file)
+    vol = mi.load_dict({
+        'type' : 'gridvolume',
+        'filename' : tmp_file,
+        'mip_levels' : 2,
+    })
+    assert vol.mip_level_count() == 3
+
+    it = dr.zeros(mi.Interaction3f, 1)
+    it.p = mi.Point3f(0.25)  # Center of the first 2x2x2 block
+
+    # Level 0 forwards to the exact full-resolution lookup
+    assert dr.allclose(vol.eval_lod(it, 0), vol.eval(it))
+    # Level 1 averages each 2x2x2 block: (9 + 7 * 1) / 8
+    assert dr.allclose(vol.eval_lod(it, 1), 2.0)
+    # Level 2 has collapsed to a single voxel; the maximum remains a
+    # valid majorant at every level
+    assert dr.allclose(vol.eval_lod(it, 2), (2.0 + 7 * 1.0) / 8)
+    assert vol.eval_lod(it, 2)[0] <= vol.max()
+
+    # Levels beyond the chain are clamped
+    assert dr.allclose(vol.eval_lod(it, 10), vol.eval_lod(it, 2))
+
+
+def test08_mip_levels_multichannel(variant_scalar_rgb, tmpdir):
+    tmp_file = os.path.join(str(tmpdir), "out.vol")
+    grid = dr.full(mi.TensorXf, 1, [4, 4, 4, 3])
+    mi.VolumeGrid(grid).write(tmp_file)
+    with pytest.raises(RuntimeError, match='.*single-channel.*'):
+        mi.load_dict({
+            'type' : 'gridvolume',
+            'filename' : tmp_file,
+            'mip_levels' : 1,
+        })
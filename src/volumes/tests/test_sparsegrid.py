@@ -0,0 +1,88 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+import os
+
+
+def make_volume(tmpdir, grid, **kwargs):
+    tmp_file = os.path.join(str(tmpdir), "out.vol")
+    mi.VolumeGrid(grid).write(tmp_file)
+    return mi.load_dict({
+        'type': 'sparsegridvolume',
+        'filename': tmp_file,
+        **kwargs
+    })
+
+
+def test01_construct(variant_scalar_rgb, tmpdir):
+    grid = dr.full(mi.TensorXf, 0.0, [16, 16, 16])
+    grid[3, 4, 5] = 2.5
+    vol = make_volume(tmpdir, grid)
+    assert vol is not None
+    assert dr.allclose(vol.max(), 2.5)
+    assert vol.resolution() == mi.ScalarVector3i(16, 16, 16)
+
+    # Multi-channel data is not supported
+    with pytest.raises(RuntimeError, match='single-channel'):
+        make_volume(tmpdir, dr.full(mi.TensorXf, 1, [4, 4, 4, 3]))
+
+
+def test02_matches_dense(variants_all, tmpdir):
+    # A sparse grid must evaluate exactly like its dense counterpart
+    import numpy as np
+    np.random.seed(12345)
+    values = np.float32(np.random.rand(13, 9, 17))
+    values[values < 0.7] = 0.0  # Mostly empty
+    grid = mi.TensorXf(values)
+
+    tmp_file = os.path.join(str(tmpdir), "out.vol")
+    mi.VolumeGrid(grid).write(tmp_file)
+
+    for filter_type in ['trilinear', 'nearest']:
+        dense = mi.load_dict({
+            'type': 'gridvolume',
+            'filename': tmp_file,
+            'filter_type': filter_type,
+            'accel': False
+        })
+        sparse = mi.load_dict({
+            'type': 'sparsegridvolume',
+            'filename': tmp_file,
+            'filter_type': filter_type
+        })
+
+        it = dr.zeros(mi.Interaction3f, 1)
+        for p in [[0.5, 0.5, 0.5], [0.1, 0.7, 0.3], [0.0, 0.0, 0.0],
+                  [0.99, 0.99, 0.99], [0.25, 0.8, 0.6], [1.2, -0.1, 0.5]]:
+            it.p = mi.Point3f(p)
+            assert dr.allclose(dense.eval_1(it), sparse.eval_1(it),
+                               atol=1e-6), (filter_type, p)
+
+
+def test03_empty_bricks(variant_scalar_rgb, tmpdir):
+    # Values inside pruned bricks evaluate to zero
+    grid = dr.full(mi.TensorXf, 0.0, [32, 32, 32])
+    grid[0, 0, 0] = 1.0
+    vol = make_volume(tmpdir, grid)
+
+    it = dr.zeros(mi.Interaction3f, 1)
+    it.p = mi.Point3f(0.9, 0.9, 0.9)
+    assert dr.allclose(vol.eval_1(it), 0.0)
+    it.p = mi.Point3f(1 / 64)
+    assert vol.eval_1(it) > 0.0
+
+
+def test04_threshold(variant_scalar_rgb, tmpdir):
+    # Bricks below the pruning threshold are treated as empty
+    grid = dr.full(mi.TensorXf, 0.01, [16, 16, 16])
+    grid[12, 12, 12] = 1.0  # Keeps the brick at (1, 1, 1)
+
+    vol = make_volume(tmpdir, grid, filter_type='nearest')
+    it = dr.zeros(mi.Interaction3f, 1)
+    it.p = mi.Point3f(1 / 32)
+    assert dr.allclose(vol.eval_1(it), 0.01)
+
+    vol = make_volume(tmpdir, grid, filter_type='nearest', threshold=0.05)
+    assert dr.allclose(vol.eval_1(it), 0.0)
+    it.p = mi.Point3f(25 / 32)
+    assert dr.allclose(vol.eval_1(it), 1.0)